@@ -2,6 +2,8 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <memory>
+
 #include <cubeb/cubeb.h>
 
 #include "AudioCommon/CubebStream.h"
@@ -40,6 +42,18 @@ bool CubebStream::Init()
 
   m_stereo = !SConfig::GetInstance().bDPL2Decoder;
 
+  if (SConfig::GetInstance().m_audio_native_sample_rate)
+  {
+    // Mix straight to the device's own rate, so that it doesn't have to resample a second time.
+    u32 preferred_rate = 0;
+    if (cubeb_get_preferred_sample_rate(m_ctx.get(), &preferred_rate) == CUBEB_OK &&
+        preferred_rate != 0 && preferred_rate != m_mixer->GetSampleRate())
+    {
+      INFO_LOG(AUDIO, "Mixing at the device's preferred rate of %u Hz", preferred_rate);
+      m_mixer = std::make_unique<Mixer>(preferred_rate);
+    }
+  }
+
   cubeb_stream_params params;
   params.rate = m_mixer->GetSampleRate();
   if (m_stereo)
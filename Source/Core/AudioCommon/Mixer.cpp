@@ -4,14 +4,17 @@
 
 #include "AudioCommon/Mixer.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <limits>
 
 #include "AudioCommon/DPL2Decoder.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
+#include "Common/Profiler.h"
 #include "Common/Swap.h"
 #include "Core/ConfigManager.h"
 
@@ -61,6 +64,10 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
 
     u32 low_waterwark = m_input_sample_rate * SConfig::GetInstance().iTimingVariance / 1000;
     low_waterwark = std::min(low_waterwark, MAX_SAMPLES / 2);
+    if (SConfig::GetInstance().m_audio_low_latency)
+      low_waterwark = UpdateTargetFill(static_cast<u32>(numLeft), numSamples, low_waterwark);
+    else
+      m_target_fill.store(low_waterwark);
 
     m_numLeftI = (numLeft + m_numLeftI * (CONTROL_AVG - 1)) / CONTROL_AVG;
     float offset = (m_numLeftI - low_waterwark) * CONTROL_FACTOR;
@@ -103,6 +110,8 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
 
   // Actual number of samples written to the buffer without padding.
   unsigned int actual_sample_count = currentSample / 2;
+  if (consider_framelimit && actual_sample_count < numSamples)
+    m_underrun = true;
 
   // Padding
   short s[2];
@@ -125,11 +134,52 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   return actual_sample_count;
 }
 
+// Adjusts the fill level the rate control aims for in low latency mode. Over each second of
+// output, the smallest fill level seen at the start of a callback shows how much of the buffer
+// jitter actually needed; half of the unused headroom is dropped. An underrun adds one callback's
+// worth of samples back. The target never gets larger than the regular (TimingVariance based) one.
+u32 Mixer::MixerFifo::UpdateTargetFill(u32 available, u32 requested, u32 max_target)
+{
+  const u32 needed = static_cast<u32>(static_cast<u64>(requested) * m_input_sample_rate /
+                                      m_mixer->m_sampleRate) +
+                     1;
+  u32 target = m_target_fill.load();
+  if (target == 0)
+    target = max_target;
+
+  if (m_underrun)
+  {
+    target += needed;
+    m_underrun = false;
+    m_window_min_fill = UINT32_MAX;
+    m_window_length = 0;
+  }
+  else
+  {
+    m_window_min_fill = std::min(m_window_min_fill, available);
+    m_window_length += requested;
+    if (m_window_length >= m_mixer->m_sampleRate)
+    {
+      if (m_window_min_fill > needed)
+        target -= std::min(target, (m_window_min_fill - needed) / 2);
+      m_window_min_fill = UINT32_MAX;
+      m_window_length = 0;
+    }
+  }
+
+  // Always keep at least two callbacks worth of samples around.
+  target = MathUtil::Clamp(target, std::min(needed * 2, max_target), max_target);
+  m_target_fill.store(target);
+  return target;
+}
+
 unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
 {
   if (!samples)
     return 0;
 
+  PROFILE("Mixer::Mix");
+
   memset(samples, 0, num_samples * 2 * sizeof(short));
 
   if (SConfig::GetInstance().m_audio_stretch)
@@ -172,11 +222,10 @@ unsigned int Mixer::MixSurround(float* samples, unsigned int num_samples)
   // Mix() may also use m_scratch_buffer internally, but is safe because it alternates reads and
   // writes.
   unsigned int available_samples = Mix(m_scratch_buffer.data(), num_samples);
+  // Multiplying (rather than dividing) lets the compiler vectorize the conversion.
+  constexpr float scale = 1.0f / std::numeric_limits<short>::max();
   for (size_t i = 0; i < static_cast<size_t>(available_samples) * 2; ++i)
-  {
-    m_float_conversion_buffer[i] =
-        m_scratch_buffer[i] / static_cast<float>(std::numeric_limits<short>::max());
-  }
+    m_float_conversion_buffer[i] = m_scratch_buffer[i] * scale;
 
   DPL2Decode(m_float_conversion_buffer.data(), available_samples, samples);
 
@@ -364,6 +413,16 @@ void Mixer::MixerFifo::SetVolume(unsigned int lvolume, unsigned int rvolume)
   m_RVolume.store(rvolume + (rvolume >> 7));
 }
 
+u32 Mixer::GetLatencyMs() const
+{
+  return m_dma_mixer.AvailableSamples() * 1000 / m_sampleRate;
+}
+
+u32 Mixer::GetTargetLatencyMs() const
+{
+  return m_dma_mixer.GetTargetFill() * 1000 / m_dma_mixer.GetInputSampleRate();
+}
+
 unsigned int Mixer::MixerFifo::AvailableSamples() const
 {
   unsigned int samples_in_fifo = ((m_indexW.load() - m_indexR.load()) & INDEX_MASK) / 2;
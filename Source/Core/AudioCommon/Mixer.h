@@ -6,6 +6,7 @@
 
 #include <array>
 #include <atomic>
+#include <cstdint>
 
 #include "AudioCommon/AudioStretcher.h"
 #include "AudioCommon/WaveFile.h"
@@ -45,6 +46,11 @@ public:
   float GetCurrentSpeed() const { return m_speed.load(); }
   void UpdateSpeed(float val) { m_speed.store(val); }
 
+  // How much DMA audio is currently buffered, and how much the rate control aims to keep
+  // buffered. This is the latency added by the mixer, on top of the backend's own.
+  u32 GetLatencyMs() const;
+  u32 GetTargetLatencyMs() const;
+
 private:
   static constexpr u32 MAX_SAMPLES = 1024 * 4;  // 128 ms
   static constexpr u32 INDEX_MASK = MAX_SAMPLES * 2 - 1;
@@ -65,8 +71,11 @@ private:
     unsigned int GetInputSampleRate() const;
     void SetVolume(unsigned int lvolume, unsigned int rvolume);
     unsigned int AvailableSamples() const;
+    u32 GetTargetFill() const { return m_target_fill.load(); }
 
   private:
+    u32 UpdateTargetFill(u32 available, u32 requested, u32 max_target);
+
     Mixer* m_mixer;
     unsigned m_input_sample_rate;
     std::array<short, MAX_SAMPLES * 2> m_buffer{};
@@ -77,6 +86,13 @@ private:
     std::atomic<s32> m_RVolume{256};
     float m_numLeftI = 0.0f;
     u32 m_frac = 0;
+
+    // Low latency mode state, all in input samples. The target fill level shrinks while the
+    // buffer never runs dry and grows again after an underrun.
+    std::atomic<u32> m_target_fill{0};
+    u32 m_window_min_fill = UINT32_MAX;
+    u32 m_window_length = 0;
+    bool m_underrun = false;
   };
 
   MixerFifo m_dma_mixer{this, 32000};
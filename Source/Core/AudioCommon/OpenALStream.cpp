@@ -5,6 +5,8 @@
 #ifdef _WIN32
 
 #include <windows.h>
+#include <algorithm>
+#include <chrono>
 #include <climits>
 #include <cstring>
 #include <thread>
@@ -14,6 +16,7 @@
 #include "Common/MsgHandler.h"
 #include "Common/Thread.h"
 #include "Core/ConfigManager.h"
+#include "Core/Core.h"
 
 static HMODULE s_openal_dll = nullptr;
 
@@ -218,6 +221,7 @@ static bool IsCreativeXFi()
 void OpenALStream::SoundLoop()
 {
   Common::SetCurrentThreadName("Audio thread - openal");
+  Core::ApplyThreadPlacement(Core::EmulatorThread::Audio);
 
   bool float32_capable = palIsExtensionPresent("AL_EXT_float32") != 0;
   bool surround_capable = palIsExtensionPresent("AL_EXT_MCFORMATS") || IsCreativeXFi();
@@ -281,6 +285,12 @@ void OpenALStream::SoundLoop()
   unsigned int num_buffers_queued = 0;
   ALint state = 0;
 
+  // While every buffer is queued, there is nothing to do until the source consumes one. Sleep
+  // for half a buffer instead of polling every millisecond; the other queued buffers cover the
+  // wakeup jitter.
+  const auto buffer_wait =
+      std::chrono::microseconds(std::max<u64>(u64(frames_per_buffer) * 500000 / frequency, 1000));
+
   while (m_run_thread.IsSet())
   {
     // Block until we have a free buffer
@@ -288,7 +298,7 @@ void OpenALStream::SoundLoop()
     palGetSourcei(m_source, AL_BUFFERS_PROCESSED, &num_buffers_processed);
     if (num_buffers_queued == OAL_BUFFERS && !num_buffers_processed)
     {
-      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      std::this_thread::sleep_for(buffer_wait);
       continue;
     }
 
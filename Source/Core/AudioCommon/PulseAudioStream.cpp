@@ -9,6 +9,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/Thread.h"
 #include "Core/ConfigManager.h"
+#include "Core/Core.h"
 
 namespace
 {
@@ -42,6 +43,7 @@ PulseAudio::~PulseAudio()
 void PulseAudio::SoundLoop()
 {
   Common::SetCurrentThreadName("Audio thread - pulse");
+  Core::ApplyThreadPlacement(Core::EmulatorThread::Audio);
 
   if (PulseInit())
   {
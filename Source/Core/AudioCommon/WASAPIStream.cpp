@@ -19,6 +19,7 @@
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
 #include "Core/ConfigManager.h"
+#include "Core/Core.h"
 #include "VideoCommon/OnScreenDisplay.h"
 
 WASAPIStream::WASAPIStream()
@@ -417,6 +418,7 @@ bool WASAPIStream::SetRunning(bool running)
 void WASAPIStream::SoundLoop()
 {
   Common::SetCurrentThreadName("WASAPI Handler");
+  Core::ApplyThreadPlacement(Core::EmulatorThread::Audio);
   BYTE* data;
 
   if (m_audio_renderer)
@@ -13,6 +13,7 @@
 // - Zero backwards/forwards compatibility
 // - Serialization code for anything complex has to be manually written.
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstring>
@@ -55,6 +56,28 @@ public:
 
 public:
   PointerWrap(u8** ptr_, Mode mode_) : ptr(ptr_), mode(mode_) {}
+
+  // Writes into the given buffer, growing it as needed, so that saving doesn't need a measure
+  // pass before the write pass. The existing size of the buffer is used before growing it, so
+  // reusing a buffer from a previous save usually means no reallocation at all. Call
+  // FinishWrite() afterwards to shrink the buffer to the written data.
+  explicit PointerWrap(std::vector<u8>* buffer)
+      : ptr(&m_buffer_ptr), mode(MODE_WRITE), m_buffer(buffer)
+  {
+    m_buffer->resize(m_buffer->capacity());
+    m_buffer_ptr = m_buffer->data();
+  }
+
+  // Not copyable, since ptr may point into the PointerWrap itself.
+  PointerWrap(const PointerWrap&) = delete;
+  PointerWrap& operator=(const PointerWrap&) = delete;
+
+  void FinishWrite()
+  {
+    DEBUG_ASSERT(m_buffer && mode == MODE_WRITE);
+    m_buffer->resize(*ptr - m_buffer->data());
+  }
+
   void SetMode(Mode mode_) { mode = mode_; }
   Mode GetMode() const { return mode; }
   template <typename K, class V>
@@ -266,6 +289,8 @@ private:
       break;
 
     case MODE_WRITE:
+      if (m_buffer && size > static_cast<size_t>(m_buffer->data() + m_buffer->size() - *ptr))
+        GrowBuffer(size);
       memcpy(*ptr, data, size);
       break;
 
@@ -281,4 +306,14 @@ private:
 
     *ptr += size;
   }
+
+  void GrowBuffer(u32 size)
+  {
+    const size_t offset = *ptr - m_buffer->data();
+    m_buffer->resize(std::max<size_t>(offset + size, m_buffer->size() * 2));
+    *ptr = m_buffer->data() + offset;
+  }
+
+  u8* m_buffer_ptr = nullptr;
+  std::vector<u8>* m_buffer = nullptr;
 };
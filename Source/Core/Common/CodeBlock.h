@@ -37,6 +37,11 @@ protected:
   bool m_is_child = false;
   std::vector<CodeBlock*> m_children;
 
+  // The region can be split into equally sized segments which are filled one after another.
+  // This lets users recycle the oldest segment instead of clearing everything when space runs out.
+  size_t m_segment_count = 1;
+  size_t m_current_segment = 0;
+
 public:
   CodeBlock() = default;
   virtual ~CodeBlock()
@@ -86,7 +91,11 @@ public:
   // Cannot currently be undone. Will write protect the entire code region.
   // Start over if you need to change the code (call FreeCodeSpace(), AllocCodeSpace()).
   void WriteProtect() { Common::WriteProtectMemory(region, region_size, true); }
-  void ResetCodePtr() { T::SetCodePtr(region); }
+  void ResetCodePtr()
+  {
+    m_current_segment = 0;
+    T::SetCodePtr(region);
+  }
   size_t GetSpaceLeft() const
   {
     ASSERT(static_cast<size_t>(T::GetCodePtr() - region) < region_size);
@@ -99,6 +108,31 @@ public:
     return GetSpaceLeft() < 0x10000;
   }
 
+  // Must be called after all child code spaces have been allocated.
+  void SetSegmentCount(size_t count)
+  {
+    ASSERT(count != 0 && region_size / count > 0x10000);
+    m_segment_count = count;
+    ResetCodePtr();
+  }
+  size_t GetSegmentCount() const { return m_segment_count; }
+  size_t GetCurrentSegment() const { return m_current_segment; }
+  size_t GetSegmentSize() const { return region_size / m_segment_count; }
+  u8* GetSegmentStart(size_t segment) const { return region + segment * GetSegmentSize(); }
+  bool IsSegmentAlmostFull() const
+  {
+    const u8* segment_end = GetSegmentStart(m_current_segment) + GetSegmentSize();
+    return static_cast<size_t>(segment_end - T::GetCodePtr()) < 0x10000;
+  }
+  // Continues emitting code at the start of the given segment. The caller is responsible for
+  // making sure nothing can still jump into the code which was previously there.
+  void SwitchToSegment(size_t segment)
+  {
+    ASSERT(segment < m_segment_count);
+    m_current_segment = segment;
+    T::SetCodePtr(GetSegmentStart(segment));
+  }
+
   bool HasChildren() const { return region_size != total_region_size; }
   u8* AllocChildCodeSpace(size_t child_size)
   {
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <atomic>
 #include <list>
 #include <map>
 
@@ -12,6 +13,8 @@ namespace Config
 {
 static Layers s_layers;
 static std::list<ConfigChangedCallback> s_callbacks;
+// Starts above the version of the values cached by a ConfigInfo before its first Get
+static std::atomic<u64> s_config_version{1};
 
 Layers* GetLayers()
 {
@@ -53,10 +56,21 @@ void AddConfigChangedCallback(ConfigChangedCallback func)
 
 void InvokeConfigChangedCallbacks()
 {
+  OnConfigChanged();
   for (const auto& callback : s_callbacks)
     callback();
 }
 
+u64 GetConfigVersion()
+{
+  return s_config_version.load(std::memory_order_acquire);
+}
+
+void OnConfigChanged()
+{
+  s_config_version.fetch_add(1, std::memory_order_acq_rel);
+}
+
 // Explicit load and save of layers
 void Load()
 {
@@ -82,11 +96,13 @@ void Shutdown()
 {
   s_layers.clear();
   s_callbacks.clear();
+  OnConfigChanged();
 }
 
 void ClearCurrentRunLayer()
 {
   s_layers[LayerType::CurrentRun] = std::make_unique<Layer>(LayerType::CurrentRun);
+  OnConfigChanged();
 }
 
 static const std::map<System, std::string> system_to_name = {
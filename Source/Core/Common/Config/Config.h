@@ -30,6 +30,11 @@ bool LayerExists(LayerType layer);
 void AddConfigChangedCallback(ConfigChangedCallback func);
 void InvokeConfigChangedCallbacks();
 
+// The config version is incremented on every change to any layer, which invalidates the values
+// cached by Get.
+u64 GetConfigVersion();
+void OnConfigChanged();
+
 // Explicit load and save of layers
 void Load();
 void Save();
@@ -52,11 +57,25 @@ T Get(LayerType layer, const ConfigInfo<T>& info)
 }
 
 template <typename T>
-T Get(const ConfigInfo<T>& info)
+T GetUncached(const ConfigInfo<T>& info)
 {
   return GetLayer(GetActiveLayerForConfig(info.location))->Get(info);
 }
 
+template <typename T>
+T Get(const ConfigInfo<T>& info)
+{
+  CachedValue<T> cached = info.GetCachedValue();
+  const u64 config_version = GetConfigVersion();
+  if (cached.config_version < config_version)
+  {
+    cached.value = GetUncached(info);
+    cached.config_version = config_version;
+    info.SetCachedValue(cached);
+  }
+  return cached.value;
+}
+
 template <typename T>
 T GetBase(const ConfigInfo<T>& info)
 {
@@ -4,9 +4,12 @@
 
 #pragma once
 
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <type_traits>
 
+#include "Common/CommonTypes.h"
 #include "Common/Config/Enums.h"
 
 namespace Config
@@ -29,11 +32,24 @@ struct ConfigLocation
   bool operator<(const ConfigLocation& other) const;
 };
 
+template <typename T>
+struct CachedValue
+{
+  T value;
+  u64 config_version;
+};
+
 template <typename T>
 struct ConfigInfo
 {
   ConfigInfo(const ConfigLocation& location_, const T& default_value_)
-      : location{location_}, default_value{default_value_}
+      : location{location_}, default_value{default_value_}, m_cached_value{default_value_, 0}
+  {
+  }
+
+  ConfigInfo(const ConfigInfo<T>& other)
+      : location{other.location}, default_value{other.default_value},
+        m_cached_value{other.GetCachedValue()}
   {
   }
 
@@ -43,11 +59,32 @@ struct ConfigInfo
             std::enable_if_t<std::is_same<T, detail::UnderlyingType<Enum>>::value>* = nullptr>
   ConfigInfo(const ConfigInfo<Enum>& other)
       : location{other.location}, default_value{static_cast<detail::UnderlyingType<Enum>>(
-                                      other.default_value)}
+                                      other.default_value)},
+        m_cached_value{default_value, 0}
   {
   }
 
+  CachedValue<T> GetCachedValue() const
+  {
+    std::shared_lock<std::shared_mutex> lock(m_cached_value_mutex);
+    return m_cached_value;
+  }
+
+  // Keeps the newest of the cached values, as another thread may have cached a newer one
+  void SetCachedValue(const CachedValue<T>& cached_value) const
+  {
+    std::unique_lock<std::shared_mutex> lock(m_cached_value_mutex);
+    if (m_cached_value.config_version < cached_value.config_version)
+      m_cached_value = cached_value;
+  }
+
   ConfigLocation location;
   T default_value;
+
+private:
+  // The value of the setting as of a config version, so that Config::Get only has to look it up
+  // in the layers again once the config has changed.
+  mutable CachedValue<T> m_cached_value;
+  mutable std::shared_mutex m_cached_value_mutex;
 };
 }
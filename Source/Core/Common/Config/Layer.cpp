@@ -45,6 +45,7 @@ bool Layer::Exists(const ConfigLocation& location) const
 
 bool Layer::DeleteKey(const ConfigLocation& location)
 {
+  OnConfigChanged();
   m_is_dirty = true;
   bool had_value = m_map[location].has_value();
   m_map[location].reset();
@@ -53,6 +54,7 @@ bool Layer::DeleteKey(const ConfigLocation& location)
 
 void Layer::DeleteAllKeys()
 {
+  OnConfigChanged();
   m_is_dirty = true;
   for (auto& pair : m_map)
   {
@@ -60,6 +62,16 @@ void Layer::DeleteAllKeys()
   }
 }
 
+void Layer::Set(const ConfigLocation& location, const std::string& new_value)
+{
+  std::optional<std::string>& current_value = m_map[location];
+  if (current_value == new_value)
+    return;
+  OnConfigChanged();
+  m_is_dirty = true;
+  current_value = new_value;
+}
+
 Section Layer::GetSection(System system, const std::string& section)
 {
   return Section{m_map.lower_bound(ConfigLocation{system, section, ""}),
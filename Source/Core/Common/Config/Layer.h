@@ -129,14 +129,7 @@ public:
     Set(location, ValueToString(value));
   }
 
-  void Set(const ConfigLocation& location, const std::string& new_value)
-  {
-    std::optional<std::string>& current_value = m_map[location];
-    if (current_value == new_value)
-      return;
-    m_is_dirty = true;
-    current_value = new_value;
-  }
+  void Set(const ConfigLocation& location, const std::string& new_value);
 
   Section GetSection(System system, const std::string& section);
   ConstSection GetSection(System system, const std::string& section) const;
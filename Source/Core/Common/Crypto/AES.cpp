@@ -2,27 +2,179 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <array>
+
 #include <mbedtls/aes.h>
 
+#include "Common/CPUDetect.h"
 #include "Common/Crypto/AES.h"
+#include "Common/Intrinsics.h"
 
 namespace Common
 {
 namespace AES
 {
-std::vector<u8> DecryptEncrypt(const u8* key, u8* iv, const u8* src, size_t size, Mode mode)
+namespace
 {
-  mbedtls_aes_context aes_ctx;
-  std::vector<u8> buffer(size);
+class ContextGeneric final : public Context
+{
+public:
+  ContextGeneric(const u8* key, Mode mode) : m_mode(mode)
+  {
+    mbedtls_aes_init(&m_ctx);
+    if (mode == Mode::Encrypt)
+      mbedtls_aes_setkey_enc(&m_ctx, key, 128);
+    else
+      mbedtls_aes_setkey_dec(&m_ctx, key, 128);
+  }
+
+  ~ContextGeneric() override { mbedtls_aes_free(&m_ctx); }
+
+  void CryptCBC(u8* iv, const u8* src, u8* dst, size_t size) override
+  {
+    const int mode = m_mode == Mode::Encrypt ? MBEDTLS_AES_ENCRYPT : MBEDTLS_AES_DECRYPT;
+    mbedtls_aes_crypt_cbc(&m_ctx, mode, size, iv, src, dst);
+  }
+
+private:
+  mbedtls_aes_context m_ctx;
+  Mode m_mode;
+};
+
+#ifdef _M_X86
+class ContextAESNI final : public Context
+{
+public:
+  static constexpr size_t NUM_ROUND_KEYS = 11;
+
+  // CBC decryption has no dependency between blocks, so several are kept in flight to hide the
+  // latency of the aesdec instruction.
+  static constexpr size_t PARALLEL_BLOCKS = 8;
+
+  FUNCTION_TARGET_AES ContextAESNI(const u8* key, Mode mode) : m_mode(mode)
+  {
+    ExpandKey(key);
+    if (mode == Mode::Encrypt)
+      return;
+
+    // The equivalent inverse cipher uses the encryption keys in reverse, with InvMixColumns
+    // applied to all but the first and last.
+    std::array<__m128i, NUM_ROUND_KEYS> encrypt_keys = m_round_keys;
+    m_round_keys[0] = encrypt_keys[NUM_ROUND_KEYS - 1];
+    for (size_t i = 1; i < NUM_ROUND_KEYS - 1; i++)
+      m_round_keys[i] = _mm_aesimc_si128(encrypt_keys[NUM_ROUND_KEYS - 1 - i]);
+    m_round_keys[NUM_ROUND_KEYS - 1] = encrypt_keys[0];
+  }
 
-  if (mode == Mode::Encrypt)
-    mbedtls_aes_setkey_enc(&aes_ctx, key, 128);
-  else
-    mbedtls_aes_setkey_dec(&aes_ctx, key, 128);
+  void CryptCBC(u8* iv, const u8* src, u8* dst, size_t size) override
+  {
+    if (m_mode == Mode::Encrypt)
+      EncryptCBC(iv, src, dst, size);
+    else
+      DecryptCBC(iv, src, dst, size);
+  }
 
-  mbedtls_aes_crypt_cbc(&aes_ctx, mode == Mode::Encrypt ? MBEDTLS_AES_ENCRYPT : MBEDTLS_AES_DECRYPT,
-                        size, iv, src, buffer.data());
+private:
+  template <int rcon>
+  FUNCTION_TARGET_AES static __m128i ExpandRoundKey(__m128i key)
+  {
+    const __m128i assist = _mm_shuffle_epi32(_mm_aeskeygenassist_si128(key, rcon), 0xff);
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, assist);
+  }
 
+  FUNCTION_TARGET_AES void ExpandKey(const u8* key)
+  {
+    m_round_keys[0] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+    m_round_keys[1] = ExpandRoundKey<0x01>(m_round_keys[0]);
+    m_round_keys[2] = ExpandRoundKey<0x02>(m_round_keys[1]);
+    m_round_keys[3] = ExpandRoundKey<0x04>(m_round_keys[2]);
+    m_round_keys[4] = ExpandRoundKey<0x08>(m_round_keys[3]);
+    m_round_keys[5] = ExpandRoundKey<0x10>(m_round_keys[4]);
+    m_round_keys[6] = ExpandRoundKey<0x20>(m_round_keys[5]);
+    m_round_keys[7] = ExpandRoundKey<0x40>(m_round_keys[6]);
+    m_round_keys[8] = ExpandRoundKey<0x80>(m_round_keys[7]);
+    m_round_keys[9] = ExpandRoundKey<0x1b>(m_round_keys[8]);
+    m_round_keys[10] = ExpandRoundKey<0x36>(m_round_keys[9]);
+  }
+
+  FUNCTION_TARGET_AES void EncryptCBC(u8* iv, const u8* src, u8* dst, size_t size) const
+  {
+    __m128i chain = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iv));
+    for (size_t offset = 0; offset < size; offset += 16)
+    {
+      __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + offset));
+      block = _mm_xor_si128(_mm_xor_si128(block, chain), m_round_keys[0]);
+      for (size_t i = 1; i < NUM_ROUND_KEYS - 1; i++)
+        block = _mm_aesenc_si128(block, m_round_keys[i]);
+      chain = _mm_aesenclast_si128(block, m_round_keys[NUM_ROUND_KEYS - 1]);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + offset), chain);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(iv), chain);
+  }
+
+  FUNCTION_TARGET_AES void DecryptCBC(u8* iv, const u8* src, u8* dst, size_t size) const
+  {
+    __m128i chain = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iv));
+    size_t offset = 0;
+    for (; offset + PARALLEL_BLOCKS * 16 <= size; offset += PARALLEL_BLOCKS * 16)
+    {
+      // All ciphertext is loaded before anything is stored, so decrypting in place is safe.
+      __m128i ciphertext[PARALLEL_BLOCKS];
+      __m128i blocks[PARALLEL_BLOCKS];
+      for (size_t j = 0; j < PARALLEL_BLOCKS; j++)
+      {
+        ciphertext[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + offset + j * 16));
+        blocks[j] = _mm_xor_si128(ciphertext[j], m_round_keys[0]);
+      }
+      for (size_t i = 1; i < NUM_ROUND_KEYS - 1; i++)
+      {
+        for (size_t j = 0; j < PARALLEL_BLOCKS; j++)
+          blocks[j] = _mm_aesdec_si128(blocks[j], m_round_keys[i]);
+      }
+      for (size_t j = 0; j < PARALLEL_BLOCKS; j++)
+      {
+        blocks[j] = _mm_aesdeclast_si128(blocks[j], m_round_keys[NUM_ROUND_KEYS - 1]);
+        blocks[j] = _mm_xor_si128(blocks[j], j == 0 ? chain : ciphertext[j - 1]);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + offset + j * 16), blocks[j]);
+      }
+      chain = ciphertext[PARALLEL_BLOCKS - 1];
+    }
+
+    for (; offset < size; offset += 16)
+    {
+      const __m128i ciphertext = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + offset));
+      __m128i block = _mm_xor_si128(ciphertext, m_round_keys[0]);
+      for (size_t i = 1; i < NUM_ROUND_KEYS - 1; i++)
+        block = _mm_aesdec_si128(block, m_round_keys[i]);
+      block = _mm_aesdeclast_si128(block, m_round_keys[NUM_ROUND_KEYS - 1]);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + offset), _mm_xor_si128(block, chain));
+      chain = ciphertext;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(iv), chain);
+  }
+
+  std::array<__m128i, NUM_ROUND_KEYS> m_round_keys;
+  Mode m_mode;
+};
+#endif
+}  // Anonymous namespace
+
+std::unique_ptr<Context> CreateContext(const u8* key, Mode mode)
+{
+#ifdef _M_X86
+  if (cpu_info.bAES)
+    return std::make_unique<ContextAESNI>(key, mode);
+#endif
+  return std::make_unique<ContextGeneric>(key, mode);
+}
+
+std::vector<u8> DecryptEncrypt(const u8* key, u8* iv, const u8* src, size_t size, Mode mode)
+{
+  std::vector<u8> buffer(size);
+  CreateContext(key, mode)->CryptCBC(iv, src, buffer.data(), size);
   return buffer;
 }
 
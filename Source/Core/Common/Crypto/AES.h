@@ -5,6 +5,7 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -18,6 +19,20 @@ enum class Mode
   Decrypt,
   Encrypt,
 };
+
+// An expanded AES-128 key for one direction. Uses the CPU's AES instructions when available.
+class Context
+{
+public:
+  virtual ~Context() = default;
+
+  // Processes size bytes, which must be a multiple of 16, in CBC mode. iv is updated so that the
+  // chain can be continued with another call. src and dst may be the same buffer.
+  virtual void CryptCBC(u8* iv, const u8* src, u8* dst, size_t size) = 0;
+};
+
+std::unique_ptr<Context> CreateContext(const u8* key, Mode mode);
+
 std::vector<u8> DecryptEncrypt(const u8* key, u8* iv, const u8* src, size_t size, Mode mode);
 
 // Convenience functions
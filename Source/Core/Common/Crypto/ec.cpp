@@ -25,117 +25,154 @@
 
 namespace Common::ec
 {
-static const u8 square[16] = {0x00, 0x01, 0x04, 0x05, 0x10, 0x11, 0x14, 0x15,
-                              0x40, 0x41, 0x44, 0x45, 0x50, 0x51, 0x54, 0x55};
-
-struct Elt;
-static Elt operator*(const Elt& a, const Elt& b);
-
+// Elements of GF(2^233) are stored as four little-endian 64-bit words, while the keys and
+// signatures use 30 byte big-endian numbers.
 struct Elt
 {
-  bool IsZero() const
+  static Elt FromBytes(const u8* bytes)
   {
-    return std::all_of(data.begin(), data.end(), [](u8 b) { return b == 0; });
+    Elt e;
+    for (std::size_t i = 0; i < 30; i++)
+      e.words[i / 8] |= u64(bytes[29 - i]) << (8 * (i % 8));
+    return e;
   }
 
-  void MulX()
+  void ToBytes(u8* bytes) const
   {
-    u8 carry = data[0] & 1;
-    u8 x = 0;
-    for (std::size_t i = 0; i < data.size() - 1; i++)
-    {
-      u8 y = data[i + 1];
-      data[i] = x ^ (y >> 7);
-      x = y << 1;
-    }
-    data[29] = x ^ carry;
-    data[20] ^= carry << 2;
+    for (std::size_t i = 0; i < 30; i++)
+      bytes[29 - i] = static_cast<u8>(words[i / 8] >> (8 * (i % 8)));
   }
 
-  Elt Square() const
+  bool IsZero() const
   {
-    std::array<u8, 60> wide;
-    for (std::size_t i = 0; i < data.size(); i++)
-    {
-      wide[2 * i] = square[data[i] >> 4];
-      wide[2 * i + 1] = square[data[i] & 15];
-    }
-    for (std::size_t i = 0; i < data.size(); i++)
-    {
-      u8 x = wide[i];
+    return std::all_of(words.begin(), words.end(), [](u64 w) { return w == 0; });
+  }
 
-      wide[i + 19] ^= x >> 7;
-      wide[i + 20] ^= x << 1;
+  // Adds 1, which is the constant term of the curve equation
+  void AddOne() { words[0] ^= 1; }
 
-      wide[i + 29] ^= x >> 1;
-      wide[i + 30] ^= x << 7;
-    }
+  Elt Square() const;
+  Elt ItohTsujii(const Elt& b, std::size_t j) const;
+  Elt Inv() const;
 
-    u8 x = wide[30] & ~1;
-    wide[49] ^= x >> 7;
-    wide[50] ^= x << 1;
-    wide[59] ^= x >> 1;
-    wide[30] &= 1;
+  std::array<u64, 4> words{};
+};
 
-    Elt result;
-    std::copy(wide.cbegin() + 30, wide.cend(), result.data.begin());
-    return result;
-  }
+// Product of two elements before the reduction, of up to 465 bits
+using WideElt = std::array<u64, 8>;
 
-  Elt ItohTsujii(const Elt& b, std::size_t j) const
+// Reduces modulo the field polynomial x^233 + x^74 + 1, using x^233 = x^74 + 1
+static Elt Reduce(WideElt c)
+{
+  for (std::size_t i = 7; i >= 4; i--)
   {
-    Elt t = *this;
-    while (j--)
-      t = t.Square();
-    return t * b;
+    const u64 t = c[i];
+    // Bit 64 * i + k moves to bits 64 * i + k - 159 and 64 * i + k - 233
+    c[i - 4] ^= t << 23;
+    c[i - 3] ^= (t >> 41) ^ (t << 33);
+    c[i - 2] ^= t >> 31;
   }
 
-  Elt Inv() const
-  {
-    Elt t = ItohTsujii(*this, 1);
-    Elt s = t.ItohTsujii(*this, 1);
-    t = s.ItohTsujii(s, 3);
-    s = t.ItohTsujii(*this, 1);
-    t = s.ItohTsujii(s, 7);
-    s = t.ItohTsujii(t, 14);
-    t = s.ItohTsujii(*this, 1);
-    s = t.ItohTsujii(t, 29);
-    t = s.ItohTsujii(s, 58);
-    s = t.ItohTsujii(t, 116);
-    return s.Square();
-  }
+  const u64 t = c[3] >> 41;
+  c[0] ^= t;
+  c[1] ^= t << 10;
 
-  std::array<u8, 30> data{};
-};
+  Elt d;
+  std::copy_n(c.begin(), 4, d.words.begin());
+  d.words[3] &= (u64(1) << 41) - 1;
+  return d;
+}
 
 static Elt operator+(const Elt& a, const Elt& b)
 {
   Elt d;
-  for (std::size_t i = 0; i < std::tuple_size<decltype(Elt::data)>{}; i++)
-    d.data[i] = a.data[i] ^ b.data[i];
+  for (std::size_t i = 0; i < d.words.size(); i++)
+    d.words[i] = a.words[i] ^ b.words[i];
   return d;
 }
 
+// Carry-less multiplication with 4 bit windows (the left-to-right comb method): multiples of b by
+// every polynomial of degree < 4 are looked up for each nibble of a, instead of shifting and adding
+// for every bit.
 static Elt operator*(const Elt& a, const Elt& b)
 {
-  Elt d;
-  std::size_t i = 0;
-  u8 mask = 1;
-  for (std::size_t n = 0; n < 233; n++)
+  // The multiples have at most 236 bits, so they fit into the same four words
+  std::array<std::array<u64, 4>, 16> table{};
+  table[1] = b.words;
+  for (std::size_t i = 2; i < table.size(); i += 2)
   {
-    d.MulX();
+    const auto& half = table[i / 2];
+    for (std::size_t w = 0; w < 4; w++)
+    {
+      table[i][w] = (half[w] << 1) | (w != 0 ? half[w - 1] >> 63 : 0);
+      table[i + 1][w] = table[i][w] ^ b.words[w];
+    }
+  }
 
-    if ((a.data[i] & mask) != 0)
-      d = d + b;
+  WideElt c{};
+  for (int shift = 60; shift >= 0; shift -= 4)
+  {
+    for (std::size_t j = 0; j < 4; j++)
+    {
+      const auto& multiple = table[(a.words[j] >> shift) & 15];
+      for (std::size_t w = 0; w < 4; w++)
+        c[j + w] ^= multiple[w];
+    }
 
-    mask >>= 1;
-    if (mask == 0)
+    if (shift != 0)
     {
-      mask = 0x80;
-      i++;
+      for (std::size_t w = c.size() - 1; w > 0; w--)
+        c[w] = (c[w] << 4) | (c[w - 1] >> 60);
+      c[0] <<= 4;
     }
   }
-  return d;
+  return Reduce(c);
+}
+
+// Spreads the bits of x into the even bits of the result, which squares it as a polynomial
+static u64 SpreadBits(u32 x)
+{
+  u64 r = x;
+  r = (r | (r << 16)) & 0x0000FFFF0000FFFFULL;
+  r = (r | (r << 8)) & 0x00FF00FF00FF00FFULL;
+  r = (r | (r << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  r = (r | (r << 2)) & 0x3333333333333333ULL;
+  r = (r | (r << 1)) & 0x5555555555555555ULL;
+  return r;
+}
+
+Elt Elt::Square() const
+{
+  WideElt wide;
+  for (std::size_t i = 0; i < words.size(); i++)
+  {
+    wide[2 * i] = SpreadBits(static_cast<u32>(words[i]));
+    wide[2 * i + 1] = SpreadBits(static_cast<u32>(words[i] >> 32));
+  }
+  return Reduce(wide);
+}
+
+Elt Elt::ItohTsujii(const Elt& b, std::size_t j) const
+{
+  Elt t = *this;
+  while (j--)
+    t = t.Square();
+  return t * b;
+}
+
+Elt Elt::Inv() const
+{
+  Elt t = ItohTsujii(*this, 1);
+  Elt s = t.ItohTsujii(*this, 1);
+  t = s.ItohTsujii(s, 3);
+  s = t.ItohTsujii(*this, 1);
+  t = s.ItohTsujii(s, 7);
+  s = t.ItohTsujii(t, 14);
+  t = s.ItohTsujii(*this, 1);
+  s = t.ItohTsujii(t, 29);
+  t = s.ItohTsujii(s, 58);
+  s = t.ItohTsujii(t, 116);
+  return s.Square();
 }
 
 static Elt operator/(const Elt& dividend, const Elt& divisor)
@@ -146,16 +183,22 @@ static Elt operator/(const Elt& dividend, const Elt& divisor)
 struct Point
 {
   Point() = default;
-  constexpr explicit Point(Elt x, Elt y) : m_data{{std::move(x), std::move(y)}} {}
-  explicit Point(const u8* data) { std::copy_n(data, sizeof(m_data), Data()); }
+  explicit Point(Elt x, Elt y) : m_data{{std::move(x), std::move(y)}} {}
+  explicit Point(const u8* data) : Point(Elt::FromBytes(data), Elt::FromBytes(data + 30)) {}
 
   bool IsZero() const { return X().IsZero() && Y().IsZero(); }
   Elt& X() { return m_data[0]; }
   Elt& Y() { return m_data[1]; }
-  u8* Data() { return m_data[0].data.data(); }
   const Elt& X() const { return m_data[0]; }
   const Elt& Y() const { return m_data[1]; }
-  const u8* Data() const { return m_data[0].data.data(); }
+
+  std::array<u8, 60> ToBytes() const
+  {
+    std::array<u8, 60> bytes;
+    X().ToBytes(bytes.data());
+    Y().ToBytes(bytes.data() + 30);
+    return bytes;
+  }
 
   Point Double() const
   {
@@ -165,14 +208,13 @@ struct Point
 
     const auto s = Y() / X() + X();
     r.X() = s.Square() + s;
-    r.X().data[29] ^= 1;
+    r.X().AddOne();
     r.Y() = s * r.X() + r.X() + X().Square();
     return r;
   }
 
 private:
   std::array<Elt, 2> m_data{};
-  static_assert(sizeof(decltype(m_data)) == 60, "Wrong size for m_data");
 };
 
 // y**2 + x*y = x**3 + x + b
@@ -186,11 +228,11 @@ static const u8 ec_N[30] = {0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
                             0x8a, 0x69, 0x22, 0x03, 0x1d, 0x26, 0x03, 0xcf, 0xe0, 0xd7};
 
 // base point
-constexpr Point ec_G{
-    {{{0x00, 0xfa, 0xc9, 0xdf, 0xcb, 0xac, 0x83, 0x13, 0xbb, 0x21, 0x39, 0xf1, 0xbb, 0x75, 0x5f,
-       0xef, 0x65, 0xbc, 0x39, 0x1f, 0x8b, 0x36, 0xf8, 0xf8, 0xeb, 0x73, 0x71, 0xfd, 0x55, 0x8b}}},
-    {{{0x01, 0x00, 0x6a, 0x08, 0xa4, 0x19, 0x03, 0x35, 0x06, 0x78, 0xe5, 0x85, 0x28, 0xbe, 0xbf,
-       0x8a, 0x0b, 0xef, 0xf8, 0x67, 0xa7, 0xca, 0x36, 0x71, 0x6f, 0x7e, 0x01, 0xf8, 0x10, 0x52}}}};
+static const u8 ec_G_data[60] = {
+    0x00, 0xfa, 0xc9, 0xdf, 0xcb, 0xac, 0x83, 0x13, 0xbb, 0x21, 0x39, 0xf1, 0xbb, 0x75, 0x5f,
+    0xef, 0x65, 0xbc, 0x39, 0x1f, 0x8b, 0x36, 0xf8, 0xf8, 0xeb, 0x73, 0x71, 0xfd, 0x55, 0x8b,
+    0x01, 0x00, 0x6a, 0x08, 0xa4, 0x19, 0x03, 0x35, 0x06, 0x78, 0xe5, 0x85, 0x28, 0xbe, 0xbf,
+    0x8a, 0x0b, 0xef, 0xf8, 0x67, 0xa7, 0xca, 0x36, 0x71, 0x6f, 0x7e, 0x01, 0xf8, 0x10, 0x52};
 
 static Point operator+(const Point& a, const Point& b)
 {
@@ -210,24 +252,64 @@ static Point operator+(const Point& a, const Point& b)
 
   const Elt s = (a.Y() + b.Y()) / u;
   Elt t = s.Square() + s + b.X();
-  t.data[29] ^= 1;
+  t.AddOne();
 
   const Elt rx = t + a.X();
   const Elt ry = s * t + a.Y() + rx;
   return Point{rx, ry};
 }
 
+// Scalars are 30 byte big-endian numbers, which are processed one nibble at a time
+constexpr std::size_t SCALAR_NIBBLES = 60;
+
+static u8 GetNibble(const u8* scalar, std::size_t i)
+{
+  return i % 2 == 0 ? scalar[i / 2] >> 4 : scalar[i / 2] & 15;
+}
+
+// Fixed window scalar multiplication: four doublings and at most one addition per nibble
 static Point operator*(const u8* a, const Point& b)
 {
+  std::array<Point, 16> multiples;
+  multiples[1] = b;
+  for (std::size_t i = 2; i < multiples.size(); i++)
+    multiples[i] = multiples[i - 1] + b;
+
   Point d;
-  for (std::size_t i = 0; i < 30; i++)
+  for (std::size_t i = 0; i < SCALAR_NIBBLES; i++)
   {
-    for (u8 mask = 0x80; mask != 0; mask >>= 1)
+    d = d.Double().Double().Double().Double();
+    if (const u8 nibble = GetNibble(a, i))
+      d = d + multiples[nibble];
+  }
+  return d;
+}
+
+// Multiplies the base point, which signing, key generation and verification all do. The
+// multiples of G by every nibble at every position are computed once, so that this takes no
+// doublings and at most one addition per nibble of the scalar.
+static Point MultiplyBase(const u8* a)
+{
+  using Table = std::array<std::array<Point, 16>, SCALAR_NIBBLES>;
+  static const Table table = [] {
+    // table[i][n] = n * 16^(59 - i) * G, with the most significant nibble first
+    Table t;
+    Point base{ec_G_data};
+    for (std::size_t i = SCALAR_NIBBLES; i-- > 0;)
     {
-      d = d.Double();
-      if ((a[i] & mask) != 0)
-        d = d + b;
+      t[i][1] = base;
+      for (std::size_t n = 2; n < t[i].size(); n++)
+        t[i][n] = t[i][n - 1] + base;
+      base = t[i][15] + base;
     }
+    return t;
+  }();
+
+  Point d;
+  for (std::size_t i = 0; i < SCALAR_NIBBLES; i++)
+  {
+    if (const u8 nibble = GetNibble(a, i))
+      d = d + table[i][nibble];
   }
   return d;
 }
@@ -245,9 +327,10 @@ Signature Sign(const u8* key, const u8* hash)
     m[0] &= 1;
   } while (bn_compare(m, ec_N, sizeof(m)) >= 0);
 
-  Elt r = (m * ec_G).X();
-  if (bn_compare(r.data.data(), ec_N, 30) >= 0)
-    bn_sub_modulus(r.data.data(), ec_N, 30);
+  u8 r[30];
+  MultiplyBase(m).X().ToBytes(r);
+  if (bn_compare(r, ec_N, sizeof(r)) >= 0)
+    bn_sub_modulus(r, ec_N, sizeof(r));
 
   //	S = m**-1*(e + Rk) (mod N)
 
@@ -255,16 +338,16 @@ Signature Sign(const u8* key, const u8* hash)
   std::copy_n(key, sizeof(kk), kk);
   if (bn_compare(kk, ec_N, sizeof(kk)) >= 0)
     bn_sub_modulus(kk, ec_N, sizeof(kk));
-  Elt s;
-  bn_mul(s.data.data(), r.data.data(), kk, ec_N, 30);
-  bn_add(kk, s.data.data(), e, ec_N, sizeof(kk));
+  u8 s[30];
+  bn_mul(s, r, kk, ec_N, sizeof(s));
+  bn_add(kk, s, e, ec_N, sizeof(kk));
   u8 minv[30];
   bn_inv(minv, m, ec_N, sizeof(minv));
-  bn_mul(s.data.data(), minv, kk, ec_N, 30);
+  bn_mul(s, minv, kk, ec_N, sizeof(s));
 
   Signature signature;
-  std::copy(r.data.cbegin(), r.data.cend(), signature.begin());
-  std::copy(s.data.cbegin(), s.data.cend(), signature.begin() + 30);
+  std::copy_n(r, sizeof(r), signature.begin());
+  std::copy_n(s, sizeof(s), signature.begin() + 30);
   return signature;
 }
 
@@ -282,28 +365,23 @@ bool VerifySignature(const u8* public_key, const u8* signature, const u8* hash)
   bn_mul(w1, e, Sinv, ec_N, 30);
   bn_mul(w2, R, Sinv, ec_N, 30);
 
-  Point r1 = w1 * ec_G + w2 * Point{public_key};
-  auto& rx = r1.X().data;
-  if (bn_compare(rx.data(), ec_N, 30) >= 0)
-    bn_sub_modulus(rx.data(), ec_N, 30);
+  const Point r1 = MultiplyBase(w1) + w2 * Point{public_key};
+  u8 rx[30];
+  r1.X().ToBytes(rx);
+  if (bn_compare(rx, ec_N, 30) >= 0)
+    bn_sub_modulus(rx, ec_N, 30);
 
-  return (bn_compare(rx.data(), R, 30) == 0);
+  return (bn_compare(rx, R, 30) == 0);
 }
 
 PublicKey PrivToPub(const u8* key)
 {
-  const Point data = key * ec_G;
-  PublicKey result;
-  std::copy_n(data.Data(), result.size(), result.begin());
-  return result;
+  return MultiplyBase(key).ToBytes();
 }
 
 std::array<u8, 60> ComputeSharedSecret(const u8* private_key, const u8* public_key)
 {
-  std::array<u8, 60> shared_secret;
-  const Point data = private_key * Point{public_key};
-  std::copy_n(data.Data(), shared_secret.size(), shared_secret.begin());
-  return shared_secret;
+  return (private_key * Point{public_key}).ToBytes();
 }
 #ifdef _MSC_VER
 #pragma warning(pop)
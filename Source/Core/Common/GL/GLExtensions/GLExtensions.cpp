@@ -961,6 +961,9 @@ PFNDOLOBJECTPTRLABELPROC dolObjectPtrLabel;
 PFNDOLPOPDEBUGGROUPPROC dolPopDebugGroup;
 PFNDOLPUSHDEBUGGROUPPROC dolPushDebugGroup;
 
+// KHR_parallel_shader_compile
+PFNDOLMAXSHADERCOMPILERTHREADSPROC dolMaxShaderCompilerThreads;
+
 // ARB_buffer_storage
 PFNDOLBUFFERSTORAGEPROC dolBufferStorage;
 
@@ -2098,6 +2101,11 @@ const GLFunc gl_function_array[] = {
     // ARB_clip_control
     GLFUNC_REQUIRES(glClipControl, "GL_ARB_clip_control !VERSION_4_5"),
 
+    // KHR_parallel_shader_compile
+    GLFUNC_SUFFIX(glMaxShaderCompilerThreads, KHR, "GL_KHR_parallel_shader_compile"),
+    GLFUNC_SUFFIX(glMaxShaderCompilerThreads, ARB,
+                  "GL_ARB_parallel_shader_compile !GL_KHR_parallel_shader_compile"),
+
     // ARB_copy_image
     GLFUNC_REQUIRES(glCopyImageSubData, "GL_ARB_copy_image !VERSION_4_3 |VERSION_GLES_3_2"),
 
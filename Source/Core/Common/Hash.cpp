@@ -287,6 +287,89 @@ static u64 GetCRC32(const u8* src, u32 len, u32 samples)
   return h[0] + (h[1] << 10) + (h[2] << 21) + (h[3] << 32);
 }
 
+// Multiply-accumulate hash in the style of XXH3. Each 64-byte stripe is mixed into eight 64-bit
+// accumulators with 32x32->64 multiplies, which runs at several times the speed of CRC32.
+constexpr u32 AVX2_HASH_STRIPE_SIZE = 64;
+
+// The key changes with every stripe, so identical stripes at different offsets don't cancel out.
+FUNCTION_TARGET_AVX2
+static inline void AccumulateStripeAVX2(__m256i* acc, __m256i* stripe_key, const u8* stripe)
+{
+  const __m256i key_step = _mm256_set1_epi64x(0x9E3779B185EBCA87);
+  for (int i = 0; i < 2; ++i)
+  {
+    const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(stripe) + i);
+    const __m256i keyed = _mm256_xor_si256(data, stripe_key[i]);
+    const __m256i product = _mm256_mul_epu32(keyed, _mm256_srli_epi64(keyed, 32));
+    const __m256i swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+    acc[i] = _mm256_add_epi64(acc[i], _mm256_add_epi64(product, swapped));
+    stripe_key[i] = _mm256_add_epi64(stripe_key[i], key_step);
+  }
+}
+
+// Keeps the multiplies from cancelling out the contribution of earlier input.
+FUNCTION_TARGET_AVX2
+static inline void ScrambleAccumulatorsAVX2(__m256i* acc, const __m256i* key)
+{
+  const __m256i prime = _mm256_set1_epi32(0x9E3779B1);
+  for (int i = 0; i < 2; ++i)
+  {
+    const __m256i mixed =
+        _mm256_xor_si256(_mm256_xor_si256(acc[i], _mm256_srli_epi64(acc[i], 47)), key[i]);
+    const __m256i low = _mm256_mul_epu32(mixed, prime);
+    const __m256i high = _mm256_mul_epu32(_mm256_srli_epi64(mixed, 32), prime);
+    acc[i] = _mm256_add_epi64(low, _mm256_slli_epi64(high, 32));
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static u64 GetAVX2Hash(const u8* src, u32 len, u32 samples)
+{
+  constexpr u32 STRIPES_PER_SCRAMBLE = 16;
+  constexpr u64 PRIME64 = 0x9E3779B185EBCA87;
+
+  const __m256i key[2] = {
+      _mm256_set_epi64x(0x1cad21f72c81017c, 0xbe4ba423396cfeb8, 0xdb979083e96dd4de,
+                        0x7c01812cf721ad1c),
+      _mm256_set_epi64x(0x1f67b3b7a4a44072, 0x78e5c0cc4ee679cb, 0x2172ffcc7dd05a82,
+                        0x8e2443f7744608b8)};
+  __m256i stripe_key[2] = {key[0], key[1]};
+  __m256i acc[2] = {_mm256_set1_epi64x(len), _mm256_set1_epi64x(PRIME64)};
+
+  // Sampling reads the same amount of data as the CRC32 hash would, in whole stripes.
+  const u32 num_stripes = len / AVX2_HASH_STRIPE_SIZE;
+  u32 step = 1;
+  if (samples != 0)
+    step = std::max(num_stripes / std::max(samples / (AVX2_HASH_STRIPE_SIZE / 8), 1u), 1u);
+
+  const u32 block_step = step * STRIPES_PER_SCRAMBLE;
+  u32 i = 0;
+  for (; num_stripes >= block_step && i <= num_stripes - block_step; i += block_step)
+  {
+    for (u32 j = 0; j < block_step; j += step)
+      AccumulateStripeAVX2(acc, stripe_key, src + (i + j) * AVX2_HASH_STRIPE_SIZE);
+    ScrambleAccumulatorsAVX2(acc, key);
+  }
+  for (; i < num_stripes; i += step)
+    AccumulateStripeAVX2(acc, stripe_key, src + i * AVX2_HASH_STRIPE_SIZE);
+
+  if (len % AVX2_HASH_STRIPE_SIZE)
+  {
+    u8 tail[AVX2_HASH_STRIPE_SIZE] = {};
+    std::memcpy(tail, src + num_stripes * AVX2_HASH_STRIPE_SIZE, len % AVX2_HASH_STRIPE_SIZE);
+    AccumulateStripeAVX2(acc, stripe_key, tail);
+  }
+  ScrambleAccumulatorsAVX2(acc, key);
+
+  u64 lanes[8];
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc[0]);
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes) + 1, acc[1]);
+  u64 h = len * PRIME64;
+  for (u64 lane : lanes)
+    h = (h ^ fmix64(lane)) * PRIME64;
+  return fmix64(h);
+}
+
 #elif defined(_M_ARM_64)
 
 static u64 GetCRC32(const u8* src, u32 len, u32 samples)
@@ -509,6 +592,13 @@ u64 GetHash64(const u8* src, u32 len, u32 samples)
 // sets the hash function used for the texture cache
 void SetHash64Function()
 {
+#if defined(_M_X86_64)
+  if (cpu_info.bAVX2)
+  {
+    ptrHashFunction = &GetAVX2Hash;
+  }
+  else
+#endif
 #if defined(_M_X86_64) || defined(_M_X86)
   if (cpu_info.bSSE4_2)  // sse crc32 version
   {
@@ -7,8 +7,10 @@
 #include <algorithm>
 #include <cstring>
 #include <fstream>
+#include <mutex>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
@@ -43,6 +45,7 @@ public:
 // Not tuned for extreme performance but should be reasonably fast.
 // Does not support keys or values larger than 2GB, which should be reasonable.
 // Keys must have non-zero length; values can have zero length.
+// Append, Sync and Close may be called concurrently, e.g. from shader compiler threads.
 
 // K and V are some POD type
 // K : the key type
@@ -76,42 +79,53 @@ public:
     m_header.Init();
     if (m_file.is_open() && ValidateHeader())
     {
-      // good header, read some key/value pairs
-      K key;
+      // good header, read some key/value pairs.
+      // The file is read in large chunks rather than one small read per field, which used to
+      // dominate the load time of big caches.
+      ReadBuffer buffer(m_file, file_size - sizeof(Header));
+      std::vector<V> aligned_value;
+      std::streamoff valid_size = sizeof(Header);
 
-      V* value = nullptr;
-      u32 value_size = 0;
-      u32 entry_number = 0;
-
-      std::fstream::pos_type last_pos = m_file.tellg();
-
-      while (Read(&value_size))
+      while (true)
       {
-        std::streamoff next_extent = (last_pos - start_pos) + sizeof(value_size) + value_size;
-        if (next_extent > file_size)
+        u32 value_size;
+        if (!buffer.Read(&value_size))
+          break;
+
+        const size_t entry_size = sizeof(K) + value_size * sizeof(V) + sizeof(u32);
+        if (value_size > static_cast<u64>(file_size) || !buffer.Ensure(entry_size))
           break;
 
-        delete[] value;
-        value = new V[value_size];
+        K key;
+        u32 entry_number;
+        const u8* data = buffer.Consume(entry_size);
+        std::memcpy(&key, data, sizeof(K));
+        std::memcpy(&entry_number, data + entry_size - sizeof(u32), sizeof(u32));
+        if (entry_number != m_num_entries + 1)
+          break;
 
-        // read key/value and pass to reader
-        if (Read(&key) && Read(value, value_size) && Read(&entry_number) &&
-            entry_number == m_num_entries + 1)
+        const u8* value_data = data + sizeof(K);
+        const V* value;
+        if (alignof(V) == 1)
         {
-          reader.Read(key, value, value_size);
+          value = reinterpret_cast<const V*>(value_data);
         }
         else
         {
-          break;
+          aligned_value.resize(value_size);
+          std::memcpy(aligned_value.data(), value_data, value_size * sizeof(V));
+          value = aligned_value.data();
         }
+        reader.Read(key, value, value_size);
 
         m_num_entries++;
-        last_pos = m_file.tellg();
+        valid_size += sizeof(value_size) + entry_size;
       }
-      m_file.seekp(last_pos);
-      m_file.clear();
 
-      delete[] value;
+      // Anything after the last complete entry, e.g. an append cut off by a crash, is overwritten
+      // by the next append.
+      m_file.clear();
+      m_file.seekp(start_pos + valid_size);
       return m_num_entries;
     }
 
@@ -123,9 +137,15 @@ public:
     return 0;
   }
 
-  void Sync() { m_file.flush(); }
+  void Sync()
+  {
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    m_file.flush();
+  }
+
   void Close()
   {
+    std::lock_guard<std::mutex> lock(m_write_mutex);
     if (m_file.is_open())
       m_file.close();
     // clear any error flags
@@ -137,6 +157,7 @@ public:
   {
     // TODO: Should do a check that we don't already have "key"? (I think each caller does that
     // already.)
+    std::lock_guard<std::mutex> lock(m_write_mutex);
     Write(&value_size);
     Write(&key);
     Write(value, value_size);
@@ -166,6 +187,63 @@ private:
     return m_file.read(reinterpret_cast<char*>(data), count * sizeof(D)).good();
   }
 
+  // Reads the file in large chunks, keeping at least the part of it which is being parsed in memory
+  class ReadBuffer
+  {
+  public:
+    ReadBuffer(std::fstream& file, std::streamoff remaining) : m_file(file), m_remaining(remaining)
+    {
+    }
+
+    template <typename D>
+    bool Read(D* data)
+    {
+      if (!Ensure(sizeof(D)))
+        return false;
+      std::memcpy(data, Consume(sizeof(D)), sizeof(D));
+      return true;
+    }
+
+    // Makes sure that the next size bytes of the file are in the buffer
+    bool Ensure(size_t size)
+    {
+      const size_t buffered = m_buffer.size() - m_position;
+      if (buffered >= size)
+        return true;
+      if (static_cast<u64>(m_remaining) < size - buffered)
+        return false;
+
+      m_buffer.erase(m_buffer.begin(), m_buffer.begin() + m_position);
+      m_position = 0;
+      const size_t read_size =
+          static_cast<size_t>(std::min<std::streamoff>(m_remaining, std::max(size, CHUNK_SIZE)));
+      m_buffer.resize(buffered + read_size);
+      if (!m_file.read(reinterpret_cast<char*>(m_buffer.data() + buffered), read_size))
+      {
+        m_remaining = 0;
+        return false;
+      }
+      m_remaining -= read_size;
+      return true;
+    }
+
+    // Returns the next size bytes, which must have been buffered by Ensure
+    const u8* Consume(size_t size)
+    {
+      const u8* data = m_buffer.data() + m_position;
+      m_position += size;
+      return data;
+    }
+
+  private:
+    static constexpr size_t CHUNK_SIZE = 1024 * 1024;
+
+    std::fstream& m_file;
+    std::streamoff m_remaining;
+    std::vector<u8> m_buffer;
+    size_t m_position = 0;
+  };
+
   struct Header
   {
     void Init()
@@ -184,5 +262,6 @@ private:
   } m_header;
 
   std::fstream m_file;
+  std::mutex m_write_mutex;
   u32 m_num_entries;
 };
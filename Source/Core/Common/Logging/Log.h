@@ -72,6 +72,14 @@ enum LOG_LEVELS
 
 static const char LOG_LEVEL_TO_CHAR[7] = "-NEWID";
 
+// The most verbose level at which each log type is currently written, or 0 if it isn't written.
+// This is kept up to date by LogManager, so that log statements can be skipped without a call.
+extern int g_enabled_levels[NUMBER_OF_LOGS];
+
+inline bool IsLogEnabled(LOG_TYPE type, LOG_LEVELS level)
+{
+  return static_cast<int>(level) <= g_enabled_levels[type];
+}
 }  // namespace
 
 void GenericLog(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type, const char* file, int line,
@@ -89,11 +97,12 @@ void GenericLog(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type, const char*
 #endif  // loglevel
 #endif  // logging
 
-// Let the compiler optimize this out
+// Let the compiler optimize this out. The arguments are only evaluated if the message is going
+// to be written, so disabled log statements cost a comparison even when they format strings.
 #define GENERIC_LOG(t, v, ...)                                                                     \
   do                                                                                               \
   {                                                                                                \
-    if (v <= MAX_LOGLEVEL)                                                                         \
+    if (v <= MAX_LOGLEVEL && LogTypes::IsLogEnabled(t, v))                                         \
       GenericLog(v, t, __FILE__, __LINE__, __VA_ARGS__);                                           \
   } while (0)
 
@@ -2,11 +2,15 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cstdarg>
 #include <cstring>
+#include <iterator>
 #include <mutex>
 #include <ostream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "Common/CommonPaths.h"
 #include "Common/Config/Config.h"
@@ -15,10 +19,13 @@
 #include "Common/Logging/Log.h"
 #include "Common/Logging/LogManager.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
 #include "Common/Timer.h"
 
 constexpr size_t MAX_MSGLEN = 1024;
 
+int LogTypes::g_enabled_levels[LogTypes::NUMBER_OF_LOGS];
+
 const Config::ConfigInfo<bool> LOGGER_WRITE_TO_FILE{
     {Config::System::Logger, "Options", "WriteToFile"}, false};
 const Config::ConfigInfo<bool> LOGGER_WRITE_TO_CONSOLE{
@@ -150,10 +157,21 @@ LogManager::LogManager()
         Config::ConfigInfo<bool>{{Config::System::Logger, "Logs", container.m_short_name}, false});
 
   m_path_cutoff_point = DeterminePathCutOffPoint();
+  UpdateEnabledLevels();
+
+  m_writer_running.Set();
+  m_writer_thread = std::thread(&LogManager::WriterThreadFunc, this);
 }
 
 LogManager::~LogManager()
 {
+  std::fill(std::begin(LogTypes::g_enabled_levels), std::end(LogTypes::g_enabled_levels), 0);
+
+  // Write out everything which was logged before shutting down.
+  m_writer_running.Clear();
+  m_queue_event.Set();
+  m_writer_thread.join();
+
   // The log window listener pointer is owned by the GUI code.
   delete m_listeners[LogListener::CONSOLE_LISTENER];
   delete m_listeners[LogListener::FILE_LISTENER];
@@ -197,9 +215,53 @@ void LogManager::LogWithFullPath(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE
       StringFromFormat("%s %s:%u %c[%s]: %s\n", Common::Timer::GetTimeFormatted().c_str(), file,
                        line, LogTypes::LOG_LEVEL_TO_CHAR[(int)level], GetShortName(type), temp);
 
-  for (auto listener_id : m_listener_ids)
-    if (m_listeners[listener_id])
-      m_listeners[listener_id]->Log(level, msg.c_str());
+  {
+    std::lock_guard<std::mutex> lk(m_queue_mutex);
+    if (m_queue.size() >= MAX_QUEUED_MESSAGES)
+    {
+      m_dropped_messages++;
+      return;
+    }
+    m_queue.push_back({level, std::move(msg)});
+  }
+  m_queue_event.Set();
+}
+
+void LogManager::WriterThreadFunc()
+{
+  Common::SetCurrentThreadName("Log writer thread");
+
+  std::vector<LogMessage> messages;
+  bool running = true;
+  while (running)
+  {
+    m_queue_event.Wait();
+    running = m_writer_running.IsSet();
+
+    size_t dropped_messages;
+    {
+      std::lock_guard<std::mutex> lk(m_queue_mutex);
+      messages.swap(m_queue);
+      dropped_messages = std::exchange(m_dropped_messages, 0);
+    }
+
+    std::lock_guard<std::mutex> lk(m_listeners_mutex);
+    if (dropped_messages)
+    {
+      const std::string warning = StringFromFormat(
+          "%s Logging is too slow, dropped %zu messages\n",
+          Common::Timer::GetTimeFormatted().c_str(), dropped_messages);
+      messages.insert(messages.begin(), {LogTypes::LWARNING, warning});
+    }
+
+    for (const LogMessage& message : messages)
+    {
+      for (auto listener_id : m_listener_ids)
+        if (m_listeners[listener_id])
+          m_listeners[listener_id]->Log(message.level, message.text.c_str());
+    }
+    messages.clear();
+  }
 }
 
 LogTypes::LOG_LEVELS LogManager::GetLogLevel() const
@@ -210,11 +272,23 @@ LogTypes::LOG_LEVELS LogManager::GetLogLevel() const
 void LogManager::SetLogLevel(LogTypes::LOG_LEVELS level)
 {
   m_level = level;
+  UpdateEnabledLevels();
 }
 
 void LogManager::SetEnable(LogTypes::LOG_TYPE type, bool enable)
 {
   m_log[type].m_enable = enable;
+  UpdateEnabledLevels();
+}
+
+void LogManager::UpdateEnabledLevels()
+{
+  const bool has_listeners = static_cast<bool>(m_listener_ids);
+  for (size_t i = 0; i < m_log.size(); ++i)
+  {
+    LogTypes::g_enabled_levels[i] =
+        has_listeners && m_log[i].m_enable ? static_cast<int>(m_level) : 0;
+  }
 }
 
 bool LogManager::IsEnabled(LogTypes::LOG_TYPE type, LogTypes::LOG_LEVELS level) const
@@ -234,12 +308,18 @@ const char* LogManager::GetFullName(LogTypes::LOG_TYPE type) const
 
 void LogManager::RegisterListener(LogListener::LISTENER id, LogListener* listener)
 {
+  // Listeners can be unregistered and destroyed right after this, so they mustn't be in use.
+  std::lock_guard<std::mutex> lk(m_listeners_mutex);
   m_listeners[id] = listener;
 }
 
 void LogManager::EnableListener(LogListener::LISTENER id, bool enable)
 {
-  m_listener_ids[id] = enable;
+  {
+    std::lock_guard<std::mutex> lk(m_listeners_mutex);
+    m_listener_ids[id] = enable;
+  }
+  UpdateEnabledLevels();
 }
 
 bool LogManager::IsListenerEnabled(LogListener::LISTENER id) const
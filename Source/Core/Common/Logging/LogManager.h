@@ -6,8 +6,14 @@
 
 #include <array>
 #include <cstdarg>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "Common/BitSet.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
 #include "Common/Logging/Log.h"
 
 // pure virtual interface
@@ -27,6 +33,8 @@ public:
   };
 };
 
+// Messages are formatted by the thread which logs them, but handed to the listeners by a writer
+// thread, so that slow listeners (files, consoles, the log window) don't slow down emulation.
 class LogManager
 {
 public:
@@ -62,6 +70,18 @@ private:
     bool m_enable = false;
   };
 
+  struct LogMessage
+  {
+    LogTypes::LOG_LEVELS level;
+    std::string text;
+  };
+
+  // Messages logged while this many are already waiting to be written are dropped
+  static constexpr size_t MAX_QUEUED_MESSAGES = 0x10000;
+
+  void WriterThreadFunc();
+  void UpdateEnabledLevels();
+
   LogManager();
   ~LogManager();
 
@@ -75,4 +95,13 @@ private:
   std::array<LogListener*, LogListener::NUMBER_OF_LISTENERS> m_listeners{};
   BitSet32 m_listener_ids;
   size_t m_path_cutoff_point = 0;
+  // Held by the writer thread while it calls the listeners
+  std::mutex m_listeners_mutex;
+
+  std::mutex m_queue_mutex;
+  std::vector<LogMessage> m_queue;
+  size_t m_dropped_messages = 0;
+  Common::Event m_queue_event;
+  Common::Flag m_writer_running;
+  std::thread m_writer_thread;
 };
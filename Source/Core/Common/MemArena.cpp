@@ -54,12 +54,15 @@ static int AshmemCreateFileMapping(const char* name, size_t size)
 }
 #endif
 
-void MemArena::GrabSHMSegment(size_t size)
+void MemArena::GrabSHMSegment(size_t size, bool huge_pages, bool shared)
 {
+  m_shared_name.clear();
 #ifdef _WIN32
   const std::string name = "dolphin-emu." + std::to_string(GetCurrentProcessId());
   hMemoryMapping = CreateFileMapping(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0,
                                      static_cast<DWORD>(size), UTF8ToTStr(name).c_str());
+  if (shared && hMemoryMapping)
+    m_shared_name = name;
 #elif defined(ANDROID)
   fd = AshmemCreateFileMapping(("dolphin-emu." + std::to_string(getpid())).c_str(), size);
   if (fd < 0)
@@ -68,14 +71,39 @@ void MemArena::GrabSHMSegment(size_t size)
     return;
   }
 #else
+  m_huge_pages = false;
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+  // Transparent huge pages are controlled by shmem_enabled for memfds, whereas /dev/shm usually
+  // has them disabled through its mount options. memfds can't be opened by name, though.
+  if (huge_pages && !shared)
+  {
+    fd = memfd_create("dolphin-emu", MFD_CLOEXEC);
+    if (fd != -1 && ftruncate(fd, size) == 0)
+    {
+      m_huge_pages = true;
+      return;
+    }
+
+    NOTICE_LOG(MEMMAP, "Falling back to normal pages: %s", strerror(errno));
+    if (fd != -1)
+      close(fd);
+  }
+#endif
+
   const std::string file_name = "/dolphin-emu." + std::to_string(getpid());
+  // A shared segment is left behind if a process crashes, so one with our PID must be stale.
+  if (shared)
+    shm_unlink(file_name.c_str());
   fd = shm_open(file_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
   if (fd == -1)
   {
     ERROR_LOG(MEMMAP, "shm_open failed: %s", strerror(errno));
     return;
   }
-  shm_unlink(file_name.c_str());
+  if (shared)
+    m_shared_name = file_name;
+  else
+    shm_unlink(file_name.c_str());
   if (ftruncate(fd, size) < 0)
     ERROR_LOG(MEMMAP, "Failed to allocate low memory space");
 #endif
@@ -88,7 +116,10 @@ void MemArena::ReleaseSHMSegment()
   hMemoryMapping = 0;
 #else
   close(fd);
+  if (!m_shared_name.empty())
+    shm_unlink(m_shared_name.c_str());
 #endif
+  m_shared_name.clear();
 }
 
 void* MemArena::CreateView(s64 offset, size_t size, void* base)
@@ -104,10 +135,14 @@ void* MemArena::CreateView(s64 offset, size_t size, void* base)
     NOTICE_LOG(MEMMAP, "mmap failed");
     return nullptr;
   }
-  else
-  {
-    return retval;
-  }
+
+#ifdef MADV_HUGEPAGE
+  // Only a hint; the kernel uses huge pages for whichever parts of the view are suitably aligned.
+  if (m_huge_pages)
+    madvise(retval, size, MADV_HUGEPAGE);
+#endif
+
+  return retval;
 #endif
 }
 
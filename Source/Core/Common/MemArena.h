@@ -5,6 +5,7 @@
 #pragma once
 
 #include <cstddef>
+#include <string>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -21,8 +22,14 @@ namespace Common
 class MemArena
 {
 public:
-  void GrabSHMSegment(size_t size);
+  // With huge_pages, the segment is set up so that the kernel can back its views with
+  // transparent huge pages (currently Linux only). This silently falls back to normal pages.
+  // With shared, the segment can be opened by other processes under GetSharedName() until it is
+  // released, which takes precedence over huge pages (not supported on Android).
+  void GrabSHMSegment(size_t size, bool huge_pages = false, bool shared = false);
   void ReleaseSHMSegment();
+  // Empty if the segment isn't shared
+  const std::string& GetSharedName() const { return m_shared_name; }
   void* CreateView(s64 offset, size_t size, void* base = nullptr);
   void ReleaseView(void* view, size_t size);
 
@@ -34,7 +41,9 @@ private:
   HANDLE hMemoryMapping;
 #else
   int fd;
+  bool m_huge_pages = false;
 #endif
+  std::string m_shared_name;
 };
 
 }  // namespace Common
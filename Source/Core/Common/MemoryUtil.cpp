@@ -68,6 +68,25 @@ void* AllocateMemoryPages(size_t size)
   return ptr;
 }
 
+void* AllocateLazyMemoryPages(size_t size)
+{
+#if defined(_WIN32) || !defined(MAP_NORESERVE)
+  // Reserved memory would have to be committed explicitly before the first access
+  return nullptr;
+#else
+  void* ptr =
+      mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE | MAP_NORESERVE, -1, 0);
+
+  if (ptr == MAP_FAILED)
+  {
+    WARN_LOG(MEMMAP, "Failed to reserve %zu bytes of lazily committed memory", size);
+    return nullptr;
+  }
+
+  return ptr;
+#endif
+}
+
 void* AllocateAlignedMemory(size_t size, size_t alignment)
 {
 #ifdef _WIN32
@@ -11,6 +11,9 @@ namespace Common
 {
 void* AllocateExecutableMemory(size_t size);
 void* AllocateMemoryPages(size_t size);
+// Reserves zeroed memory which is only committed when its pages are first touched, so that
+// sparsely used tables can span a large range. Returns nullptr if that isn't supported.
+void* AllocateLazyMemoryPages(size_t size);
 void FreeMemoryPages(void* ptr, size_t size);
 void* AllocateAlignedMemory(size_t size, size_t alignment);
 void FreeAlignedMemory(void* ptr);
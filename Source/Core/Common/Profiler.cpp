@@ -19,6 +19,7 @@ static const u32 PROFILER_FIELD_LENGTH = 8;
 static const u32 PROFILER_FIELD_LENGTH_FP = PROFILER_FIELD_LENGTH + 3;
 static const int PROFILER_LAZY_DELAY = 60;  // in frames
 
+std::atomic<bool> Profiler::s_enabled{false};
 std::list<Profiler*> Profiler::s_all_profilers;
 std::mutex Profiler::s_mutex;
 u32 Profiler::s_max_length = 0;
@@ -52,6 +53,9 @@ bool Profiler::operator<(const Profiler& b) const
 
 std::string Profiler::ToString()
 {
+  if (!IsEnabled())
+    return "";
+
   if (s_lazy_delay > 0)
   {
     s_lazy_delay--;
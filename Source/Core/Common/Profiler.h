@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <list>
 #include <mutex>
 #include <string>
@@ -20,6 +21,10 @@ public:
 
   static std::string ToString();
 
+  // Profilers are free to register, but only take timings while enabled.
+  static void SetEnabled(bool enabled) { s_enabled.store(enabled, std::memory_order_relaxed); }
+  static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
   void Start();
   void Stop();
   std::string Read();
@@ -27,6 +32,7 @@ public:
   bool operator<(const Profiler& b) const;
 
 private:
+  static std::atomic<bool> s_enabled;
   static std::list<Profiler*> s_all_profilers;
   static std::mutex s_mutex;
   static u32 s_max_length;
@@ -49,8 +55,16 @@ private:
 class ProfilerExecuter
 {
 public:
-  ProfilerExecuter(Profiler* _p) : m_p(_p) { m_p->Start(); }
-  ~ProfilerExecuter() { m_p->Stop(); }
+  ProfilerExecuter(Profiler* _p) : m_p(Profiler::IsEnabled() ? _p : nullptr)
+  {
+    if (m_p)
+      m_p->Start();
+  }
+  ~ProfilerExecuter()
+  {
+    if (m_p)
+      m_p->Stop();
+  }
 
 private:
   Profiler* m_p;
@@ -10,6 +10,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -62,7 +63,7 @@ class SymbolDB
 {
 public:
   using XFuncMap = std::map<u32, Symbol>;
-  using XFuncPtrMap = std::map<u32, std::set<Symbol*>>;
+  using XFuncPtrMap = std::unordered_map<u32, std::set<Symbol*>>;
 
   SymbolDB();
   virtual ~SymbolDB();
@@ -3,15 +3,30 @@
 // Refer to the license.txt file included.
 
 #include "Common/Thread.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <string>
+#include <tuple>
+
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
 
 #ifdef _WIN32
 #include <windows.h>
 #else
+#include <pthread.h>
+#include <sched.h>
 #include <unistd.h>
 #endif
 
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
+
 #ifdef __APPLE__
 #include <mach/mach.h>
 #elif defined BSD4_4 || defined __FreeBSD__ || defined __OpenBSD__
@@ -50,6 +65,18 @@ void SetCurrentThreadAffinity(u32 mask)
   SetThreadAffinityMask(GetCurrentThread(), mask);
 }
 
+bool SetCurrentThreadPriority(ThreadPriority priority)
+{
+  int value = THREAD_PRIORITY_NORMAL;
+  if (priority == ThreadPriority::Low)
+    value = THREAD_PRIORITY_LOWEST;
+  else if (priority == ThreadPriority::High)
+    value = THREAD_PRIORITY_HIGHEST;
+  else if (priority == ThreadPriority::Realtime)
+    value = THREAD_PRIORITY_TIME_CRITICAL;
+  return SetThreadPriority(GetCurrentThread(), value) != 0;
+}
+
 // Supporting functions
 void SleepCurrentThread(int ms)
 {
@@ -119,6 +146,36 @@ void SetCurrentThreadAffinity(u32 mask)
   SetThreadAffinity(pthread_self(), mask);
 }
 
+bool SetCurrentThreadPriority(ThreadPriority priority)
+{
+  sched_param param{};
+  if (priority == ThreadPriority::Realtime)
+  {
+    param.sched_priority = sched_get_priority_min(SCHED_RR);
+    return pthread_setschedparam(pthread_self(), SCHED_RR, &param) == 0;
+  }
+
+  if (pthread_setschedparam(pthread_self(), SCHED_OTHER, &param) != 0)
+    return false;
+#ifdef __linux__
+  // Linux ignores the priority of SCHED_OTHER threads, but threads have their own nice values
+  int nice_value = 0;
+  if (priority == ThreadPriority::Low)
+    nice_value = 10;
+  else if (priority == ThreadPriority::High)
+    nice_value = -10;
+  return setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), nice_value) == 0;
+#else
+  if (priority == ThreadPriority::Low || priority == ThreadPriority::High)
+  {
+    param.sched_priority = priority == ThreadPriority::Low ? sched_get_priority_min(SCHED_OTHER) :
+                                                             sched_get_priority_max(SCHED_OTHER);
+    return pthread_setschedparam(pthread_self(), SCHED_OTHER, &param) == 0;
+  }
+  return true;
+#endif
+}
+
 void SleepCurrentThread(int ms)
 {
   usleep(1000 * ms);
@@ -150,4 +207,90 @@ void SetCurrentThreadName(const char* szThreadName)
 
 #endif
 
+#ifdef __linux__
+static std::string ReadCPUAttribute(u32 cpu, const std::string& attribute)
+{
+  std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/" + attribute);
+  std::string value;
+  std::getline(file, value);
+  return value;
+}
+
+std::vector<u32> GetFastestCPUs()
+{
+  struct CPUInfo
+  {
+    u32 cpu;
+    u64 speed;
+    std::string cache;
+    std::tuple<std::string, std::string> core;
+  };
+
+  std::vector<CPUInfo> cpus;
+  const long num_cpus = sysconf(_SC_NPROCESSORS_CONF);
+  for (u32 cpu = 0; cpu < static_cast<u32>(std::max(num_cpus, 0L)); ++cpu)
+  {
+    const std::string core_id = ReadCPUAttribute(cpu, "topology/core_id");
+    if (core_id.empty())
+      continue;
+
+    // The capacity is only reported on CPUs with cores of different kinds, where it's the most
+    // reliable measure. Otherwise the maximum frequency tells the cores apart.
+    std::string speed = ReadCPUAttribute(cpu, "cpu_capacity");
+    if (speed.empty())
+      speed = ReadCPUAttribute(cpu, "cpufreq/cpuinfo_max_freq");
+
+    // Assume that the highest cache level is index3 where it exists, which is the shared one
+    std::string cache = ReadCPUAttribute(cpu, "cache/index3/shared_cpu_list");
+    if (cache.empty())
+      cache = ReadCPUAttribute(cpu, "cache/index2/shared_cpu_list");
+
+    cpus.push_back({cpu, std::strtoull(speed.c_str(), nullptr, 10), cache,
+                    {ReadCPUAttribute(cpu, "topology/physical_package_id"), core_id}});
+  }
+  if (cpus.empty())
+    return {};
+
+  // Boosting makes some cores of the same kind report a slightly higher frequency than the rest
+  const u64 fastest =
+      std::max_element(cpus.begin(), cpus.end(), [](const CPUInfo& a, const CPUInfo& b) {
+        return a.speed < b.speed;
+      })->speed;
+  const auto is_slow = [fastest](const CPUInfo& info) { return info.speed < fastest * 9 / 10; };
+  cpus.erase(std::remove_if(cpus.begin(), cpus.end(), is_slow), cpus.end());
+
+  std::map<std::string, size_t> cpus_per_cache;
+  for (const CPUInfo& info : cpus)
+    cpus_per_cache[info.cache]++;
+  const std::string cache = std::max_element(cpus_per_cache.begin(), cpus_per_cache.end(),
+                                             [](const auto& a, const auto& b) {
+                                               return a.second < b.second;
+                                             })
+                                ->first;
+
+  std::vector<u32> result;
+  std::vector<u32> siblings;
+  std::vector<std::tuple<std::string, std::string>> seen_cores;
+  for (const CPUInfo& info : cpus)
+  {
+    if (info.cache != cache)
+      continue;
+    if (std::find(seen_cores.begin(), seen_cores.end(), info.core) != seen_cores.end())
+    {
+      siblings.push_back(info.cpu);
+      continue;
+    }
+    seen_cores.push_back(info.core);
+    result.push_back(info.cpu);
+  }
+  result.insert(result.end(), siblings.begin(), siblings.end());
+  return result;
+}
+#else
+std::vector<u32> GetFastestCPUs()
+{
+  return {};
+}
+#endif
+
 }  // namespace Common
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <thread>
+#include <vector>
 
 // Don't include Common.h here as it will break LogManager
 #include "Common/CommonTypes.h"
@@ -23,6 +24,23 @@ int CurrentThreadId();
 void SetThreadAffinity(std::thread::native_handle_type thread, u32 mask);
 void SetCurrentThreadAffinity(u32 mask);
 
+// Returns the logical CPUs of the fastest cores of the system, e.g. the performance cores of a
+// hybrid CPU, limited to the ones sharing the last level cache with the most of them. One logical
+// CPU of every physical core comes first, followed by their SMT siblings.
+// Empty if the topology of the system is unknown.
+std::vector<u32> GetFastestCPUs();
+
+enum class ThreadPriority
+{
+  Low,
+  Normal,
+  High,
+  Realtime,
+};
+
+// Raising the priority usually needs privileges, so this can fail. Returns whether it succeeded.
+bool SetCurrentThreadPriority(ThreadPriority priority);
+
 void SleepCurrentThread(int ms);
 void SwitchCurrentThread();  // On Linux, this is equal to sleep 1ms
 
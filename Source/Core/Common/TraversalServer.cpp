@@ -1,7 +1,9 @@
 // This file is public domain, in case it's useful to anyone. -comex
 
 // The central server implementation.
+#include <algorithm>
 #include <arpa/inet.h>
+#include <array>
 #include <cerrno>
 #include <cstdio>
 #include <cstdlib>
@@ -27,8 +29,37 @@
 #define NUMBER_OF_TRIES 5
 #define PORT 6262
 
+// Packets are received and sent in batches of up to this many, with recvmmsg and sendmmsg where
+// they are available.
+#define BATCH_SIZE 64
+// Looking for packets to resend walks all of them, so it isn't done for every batch.
+#define RESEND_CHECK_INTERVAL (50 * 1000)
+#define STATS_INTERVAL (60 * 1000000)
+
 static u64 currentTime;
 
+struct ReceivedPacket
+{
+  TraversalPacket packet;
+  sockaddr_in6 addr;
+  size_t size;
+};
+
+struct QueuedPacket
+{
+  TraversalPacket packet;
+  sockaddr_in6 dest;
+};
+
+// Counted since the last report
+struct Stats
+{
+  u64 received;
+  u64 sent;
+  u64 dropped;
+  u64 sendFailures;
+};
+
 struct OutgoingPacketInfo
 {
   TraversalPacket packet;
@@ -117,6 +148,8 @@ struct hash<TraversalHostId>
 static int sock;
 static std::unordered_map<TraversalRequestId, OutgoingPacketInfo> outgoingPackets;
 static std::unordered_map<TraversalHostId, EvictEntry<TraversalInetAddress>> connectedClients;
+static std::vector<QueuedPacket> queuedPackets;
+static Stats stats;
 
 static TraversalInetAddress MakeInetAddress(const sockaddr_in6& addr)
 {
@@ -183,16 +216,107 @@ static const char* SenderName(sockaddr_in6* addr)
   return buf;
 }
 
-static void TrySend(const void* buffer, size_t size, sockaddr_in6* addr)
+// The packet is sent by the next FlushSends
+static void TrySend(const TraversalPacket& packet, const sockaddr_in6& addr)
+{
+  queuedPackets.push_back({packet, addr});
+}
+
+static void FlushSends()
 {
+  size_t i = 0;
+  while (i < queuedPackets.size())
+  {
 #if DEBUG
-  printf("-> %d %llu %s\n", ((TraversalPacket*)buffer)->type,
-         (long long)((TraversalPacket*)buffer)->requestId, SenderName(addr));
+    sockaddr_in6 debugAddr = queuedPackets[i].dest;
+    printf("-> %d %llu %s\n", queuedPackets[i].packet.type,
+           (long long)queuedPackets[i].packet.requestId, SenderName(&debugAddr));
 #endif
-  if ((size_t)sendto(sock, buffer, size, 0, (sockaddr*)addr, sizeof(*addr)) != size)
-  {
+#ifdef __linux__
+    std::array<mmsghdr, BATCH_SIZE> msgs;
+    std::array<iovec, BATCH_SIZE> iovs;
+    const size_t count = std::min<size_t>(queuedPackets.size() - i, BATCH_SIZE);
+    for (size_t j = 0; j < count; j++)
+    {
+      QueuedPacket& queued = queuedPackets[i + j];
+      iovs[j] = {&queued.packet, sizeof(queued.packet)};
+      msgs[j] = {};
+      msgs[j].msg_hdr.msg_name = &queued.dest;
+      msgs[j].msg_hdr.msg_namelen = sizeof(queued.dest);
+      msgs[j].msg_hdr.msg_iov = &iovs[j];
+      msgs[j].msg_hdr.msg_iovlen = 1;
+    }
+    int rv = sendmmsg(sock, msgs.data(), (unsigned int)count, 0);
+    if (rv > 0)
+    {
+      stats.sent += rv;
+      i += rv;
+      continue;
+    }
+    perror("sendmmsg");
+#else
+    QueuedPacket& queued = queuedPackets[i];
+    if (sendto(sock, &queued.packet, sizeof(queued.packet), 0, (sockaddr*)&queued.dest,
+               sizeof(queued.dest)) == sizeof(queued.packet))
+    {
+      stats.sent++;
+      i++;
+      continue;
+    }
     perror("sendto");
+#endif
+    // Skip the packet which couldn't be sent
+    stats.sendFailures++;
+    i++;
+  }
+  queuedPackets.clear();
+}
+
+// Receives at least one packet, unless the receive times out
+static int ReceivePackets(std::array<ReceivedPacket, BATCH_SIZE>& packets)
+{
+#ifdef __linux__
+  std::array<mmsghdr, BATCH_SIZE> msgs;
+  std::array<iovec, BATCH_SIZE> iovs;
+  for (size_t i = 0; i < BATCH_SIZE; i++)
+  {
+    iovs[i] = {&packets[i].packet, sizeof(packets[i].packet)};
+    msgs[i] = {};
+    msgs[i].msg_hdr.msg_name = &packets[i].addr;
+    msgs[i].msg_hdr.msg_namelen = sizeof(packets[i].addr);
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
   }
+  int rv = recvmmsg(sock, msgs.data(), BATCH_SIZE, MSG_WAITFORONE, nullptr);
+  for (int i = 0; i < rv; i++)
+    packets[i].size = msgs[i].msg_len;
+#else
+  socklen_t addrLen = sizeof(packets[0].addr);
+  int rv = recvfrom(sock, &packets[0].packet, sizeof(packets[0].packet), 0,
+                    (sockaddr*)&packets[0].addr, &addrLen);
+  if (rv >= 0)
+  {
+    packets[0].size = rv;
+    rv = 1;
+  }
+#endif
+  return rv;
+}
+
+static void ReportStats(u64 elapsed)
+{
+  const double seconds = elapsed / 1000000.0;
+  const double dropRate = stats.received ? 100.0 * stats.dropped / stats.received : 0.0;
+  printf("%.1f packets/s in, %.1f packets/s out, %.2f%% dropped, %llu failed sends, "
+         "%zu clients, %zu awaiting ack\n",
+         stats.received / seconds, stats.sent / seconds, dropRate,
+         (unsigned long long)stats.sendFailures, connectedClients.size(), outgoingPackets.size());
+  fflush(stdout);
+#ifdef HAVE_LIBSYSTEMD
+  sd_notifyf(0, "STATUS=Listening on port %d, %.1f packets/s in, %zu clients", PORT,
+             stats.received / seconds, connectedClients.size());
+#endif
+  stats = {};
 }
 
 static TraversalPacket* AllocPacket(const sockaddr_in6& dest, TraversalRequestId misc = 0)
@@ -214,7 +338,7 @@ static void SendPacket(OutgoingPacketInfo* info)
 {
   info->tries++;
   info->sendTime = currentTime;
-  TrySend(&info->packet, sizeof(info->packet), &info->dest);
+  TrySend(info->packet, info->dest);
 }
 
 static void ResendPackets()
@@ -345,6 +469,7 @@ static void HandlePacket(TraversalPacket* packet, sockaddr_in6* addr)
   }
   default:
     fprintf(stderr, "received unknown packet type %d from %s\n", packet->type, SenderName(addr));
+    stats.dropped++;
   }
   if (packet->type != TraversalPacketAck)
   {
@@ -352,7 +477,7 @@ static void HandlePacket(TraversalPacket* packet, sockaddr_in6* addr)
     ack.type = TraversalPacketAck;
     ack.requestId = packet->requestId;
     ack.ack.ok = packetOk;
-    TrySend(&ack, sizeof(ack), addr);
+    TrySend(ack, *addr);
   }
 }
 
@@ -404,14 +529,13 @@ int main()
   sd_notifyf(0, "READY=1\nSTATUS=Listening on port %d", PORT);
 #endif
 
+  static std::array<ReceivedPacket, BATCH_SIZE> packets;
+  queuedPackets.reserve(BATCH_SIZE * 2);
+  u64 lastResendTime = 0;
+  u64 lastStatsTime = 0;
   while (true)
   {
-    sockaddr_in6 raddr;
-    socklen_t addrLen = sizeof(raddr);
-    TraversalPacket packet;
-    // note: switch to recvmmsg (yes, mmsg) if this becomes
-    // expensive
-    rv = recvfrom(sock, &packet, sizeof(packet), 0, (sockaddr*)&raddr, &addrLen);
+    rv = ReceivePackets(packets);
     if (gettimeofday(&tv, nullptr) < 0)
     {
       perror("gettimeofday");
@@ -426,15 +550,34 @@ int main()
         return 1;
       }
     }
-    else if ((size_t)rv < sizeof(packet))
+    for (int i = 0; i < rv; i++)
+    {
+      stats.received++;
+      if (packets[i].size < sizeof(packets[i].packet))
+      {
+        fprintf(stderr, "received short packet from %s\n", SenderName(&packets[i].addr));
+        stats.dropped++;
+      }
+      else
+      {
+        HandlePacket(&packets[i].packet, &packets[i].addr);
+      }
+    }
+    if (currentTime - lastResendTime >= RESEND_CHECK_INTERVAL)
     {
-      fprintf(stderr, "received short packet from %s\n", SenderName(&raddr));
+      ResendPackets();
+      lastResendTime = currentTime;
     }
-    else
+    FlushSends();
+    if (lastStatsTime == 0)
+    {
+      lastStatsTime = currentTime;
+    }
+    else if (currentTime - lastStatsTime >= STATS_INTERVAL)
     {
-      HandlePacket(&packet, &raddr);
+      ReportStats(currentTime - lastStatsTime);
+      lastStatsTime = currentTime;
     }
-    ResendPackets();
 #ifdef HAVE_LIBSYSTEMD
     sd_notify(0, "WATCHDOG=1");
 #endif
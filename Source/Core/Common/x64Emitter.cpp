@@ -117,29 +117,6 @@ u8* XEmitter::GetWritableCodePtr()
   return code;
 }
 
-void XEmitter::Write8(u8 value)
-{
-  *code++ = value;
-}
-
-void XEmitter::Write16(u16 value)
-{
-  std::memcpy(code, &value, sizeof(u16));
-  code += sizeof(u16);
-}
-
-void XEmitter::Write32(u32 value)
-{
-  std::memcpy(code, &value, sizeof(u32));
-  code += sizeof(u32);
-}
-
-void XEmitter::Write64(u64 value)
-{
-  std::memcpy(code, &value, sizeof(u64));
-  code += sizeof(u64);
-}
-
 void XEmitter::ReserveCodeSpace(int bytes)
 {
   for (int i = 0; i < bytes; i++)
@@ -179,16 +156,6 @@ void XEmitter::CheckFlags()
   ASSERT_MSG(DYNA_REC, !flags_locked, "Attempt to modify flags while flags locked!");
 }
 
-void XEmitter::WriteModRM(int mod, int reg, int rm)
-{
-  Write8((u8)((mod << 6) | ((reg & 7) << 3) | (rm & 7)));
-}
-
-void XEmitter::WriteSIB(int scale, int index, int base)
-{
-  Write8((u8)((scale << 6) | ((index & 7) << 3) | (base & 7)));
-}
-
 void OpArg::WriteREX(XEmitter* emit, int opBits, int bits, int customOp) const
 {
   if (customOp == -1)
@@ -342,8 +342,14 @@ private:
   void CheckFlags();
 
   void Rex(int w, int r, int x, int b);
-  void WriteModRM(int mod, int reg, int rm);
-  void WriteSIB(int scale, int index, int base);
+  void WriteModRM(int mod, int reg, int rm)
+  {
+    Write8(static_cast<u8>((mod << 6) | ((reg & 7) << 3) | (rm & 7)));
+  }
+  void WriteSIB(int scale, int index, int base)
+  {
+    Write8(static_cast<u8>((scale << 6) | ((index & 7) << 3) | (base & 7)));
+  }
   void WriteSimple1Byte(int bits, u8 byte, X64Reg reg);
   void WriteSimple2Byte(int bits, u8 byte1, u8 byte2, X64Reg reg);
   void WriteMulDivType(int bits, OpArg src, int ext);
@@ -378,10 +384,23 @@ private:
                               size_t* shadowp, size_t* subtractionp, size_t* xmm_offsetp);
 
 protected:
-  void Write8(u8 value);
-  void Write16(u16 value);
-  void Write32(u32 value);
-  void Write64(u64 value);
+  // These are inline, as the JITs emit every byte through them
+  void Write8(u8 value) { *code++ = value; }
+  void Write16(u16 value)
+  {
+    std::memcpy(code, &value, sizeof(u16));
+    code += sizeof(u16);
+  }
+  void Write32(u32 value)
+  {
+    std::memcpy(code, &value, sizeof(u32));
+    code += sizeof(u32);
+  }
+  void Write64(u64 value)
+  {
+    std::memcpy(code, &value, sizeof(u64));
+    code += sizeof(u64);
+  }
 
 public:
   XEmitter() = default;
@@ -18,6 +18,7 @@ namespace Config
 const ConfigInfo<bool> MAIN_SKIP_IPL{{System::Main, "Core", "SkipIPL"}, true};
 const ConfigInfo<int> MAIN_CPU_CORE{{System::Main, "Core", "CPUCore"}, PowerPC::DefaultCPUCore()};
 const ConfigInfo<bool> MAIN_FASTMEM{{System::Main, "Core", "Fastmem"}, true};
+const ConfigInfo<bool> MAIN_HUGE_PAGES{{System::Main, "Core", "HugePages"}, false};
 const ConfigInfo<bool> MAIN_DSP_HLE{{System::Main, "Core", "DSPHLE"}, true};
 const ConfigInfo<int> MAIN_TIMING_VARIANCE{{System::Main, "Core", "TimingVariance"}, 40};
 const ConfigInfo<bool> MAIN_CPU_THREAD{{System::Main, "Core", "CPUThread"}, true};
@@ -31,6 +32,9 @@ const ConfigInfo<int> MAIN_AUDIO_LATENCY{{System::Main, "Core", "AudioLatency"},
 const ConfigInfo<bool> MAIN_AUDIO_STRETCH{{System::Main, "Core", "AudioStretch"}, false};
 const ConfigInfo<int> MAIN_AUDIO_STRETCH_LATENCY{{System::Main, "Core", "AudioStretchMaxLatency"},
                                                  80};
+const ConfigInfo<bool> MAIN_AUDIO_LOW_LATENCY{{System::Main, "Core", "AudioLowLatency"}, false};
+const ConfigInfo<bool> MAIN_AUDIO_NATIVE_SAMPLE_RATE{
+    {System::Main, "Core", "AudioNativeSampleRate"}, false};
 const ConfigInfo<std::string> MAIN_MEMCARD_A_PATH{{System::Main, "Core", "MemcardAPath"}, ""};
 const ConfigInfo<std::string> MAIN_MEMCARD_B_PATH{{System::Main, "Core", "MemcardBPath"}, ""};
 const ConfigInfo<std::string> MAIN_AGP_CART_A_PATH{{System::Main, "Core", "AgpCartAPath"}, ""};
@@ -67,6 +71,8 @@ const ConfigInfo<bool> MAIN_WIIMOTE_CONTINUOUS_SCANNING{
     {System::Main, "Core", "WiimoteContinuousScanning"}, false};
 const ConfigInfo<bool> MAIN_WIIMOTE_ENABLE_SPEAKER{{System::Main, "Core", "WiimoteEnableSpeaker"},
                                                    false};
+const ConfigInfo<int> MAIN_JIT_RECOMPILE_THRESHOLD{
+    {System::Main, "Core", "JITRecompileThreshold"}, 0};
 const ConfigInfo<bool> MAIN_RUN_COMPARE_SERVER{{System::Main, "Core", "RunCompareServer"}, false};
 const ConfigInfo<bool> MAIN_RUN_COMPARE_CLIENT{{System::Main, "Core", "RunCompareClient"}, false};
 const ConfigInfo<bool> MAIN_MMU{{System::Main, "Core", "MMU"}, false};
@@ -82,6 +88,14 @@ const ConfigInfo<bool> MAIN_DCBZ{{System::Main, "Core", "DCBZ"}, false};
 const ConfigInfo<bool> MAIN_LOW_DCBZ_HACK{{System::Main, "Core", "LowDCBZHack"}, false};
 const ConfigInfo<bool> MAIN_FPRF{{System::Main, "Core", "FPRF"}, false};
 const ConfigInfo<bool> MAIN_ACCURATE_NANS{{System::Main, "Core", "AccurateNaNs"}, false};
+const ConfigInfo<bool> MAIN_JIT_BLOCK_MANIFEST{{System::Main, "Core", "JITBlockManifest"}, false};
+const ConfigInfo<int> MAIN_JIT_TIER_UP_THRESHOLD{{System::Main, "Core", "JITTierUpThreshold"}, 0};
+const ConfigInfo<int> MAIN_JIT_TIER_UP_BUDGET{{System::Main, "Core", "JITTierUpBudget"}, 0};
+const ConfigInfo<int> MAIN_JIT_CODE_SEGMENTS{{System::Main, "Core", "JITCodeSegments"}, 4};
+const ConfigInfo<bool> MAIN_JIT_TRACE_FORMATION{{System::Main, "Core", "JITTraceFormation"},
+                                                false};
+const ConfigInfo<bool> MAIN_JIT_LAZY_INVALIDATION{{System::Main, "Core", "JITLazyInvalidation"},
+                                                  false};
 const ConfigInfo<float> MAIN_EMULATION_SPEED{{System::Main, "Core", "EmulationSpeed"}, 1.0f};
 const ConfigInfo<float> MAIN_OVERCLOCK{{System::Main, "Core", "Overclock"}, 1.0f};
 const ConfigInfo<bool> MAIN_OVERCLOCK_ENABLE{{System::Main, "Core", "OverclockEnable"}, false};
@@ -94,11 +108,23 @@ const ConfigInfo<bool> MAIN_CUSTOM_RTC_ENABLE{{System::Main, "Core", "EnableCust
 const ConfigInfo<u32> MAIN_CUSTOM_RTC_VALUE{{System::Main, "Core", "CustomRTCValue"}, 946684800};
 const ConfigInfo<bool> MAIN_ENABLE_SIGNATURE_CHECKS{{System::Main, "Core", "EnableSignatureChecks"},
                                                     true};
+// In MiB
+const ConfigInfo<int> MAIN_WII_DISC_CLUSTER_CACHE_SIZE{
+    {System::Main, "Core", "WiiDiscClusterCacheSize"}, 2};
+const ConfigInfo<bool> MAIN_REWIND_ENABLE{{System::Main, "Core", "EnableRewind"}, false};
+// In video fields
+const ConfigInfo<int> MAIN_REWIND_INTERVAL{{System::Main, "Core", "RewindInterval"}, 60};
+const ConfigInfo<int> MAIN_REWIND_STATE_COUNT{{System::Main, "Core", "RewindStateCount"}, 30};
+
+// Main.Movie
+
+const ConfigInfo<bool> MAIN_MOVIE_VERIFY_PLAYBACK{{System::Main, "Movie", "VerifyPlayback"}, false};
 
 // Main.DSP
 
 const ConfigInfo<bool> MAIN_DSP_CAPTURE_LOG{{System::Main, "DSP", "CaptureLog"}, false};
 const ConfigInfo<bool> MAIN_DSP_JIT{{System::Main, "DSP", "EnableJIT"}, true};
+const ConfigInfo<int> MAIN_DSP_HLE_VOICE_THREADS{{System::Main, "DSP", "HLEVoiceThreads"}, 0};
 const ConfigInfo<bool> MAIN_DUMP_AUDIO{{System::Main, "DSP", "DumpAudio"}, false};
 const ConfigInfo<bool> MAIN_DUMP_AUDIO_SILENT{{System::Main, "DSP", "DumpAudioSilent"}, false};
 const ConfigInfo<bool> MAIN_DUMP_UCODE{{System::Main, "DSP", "DumpUCode"}, false};
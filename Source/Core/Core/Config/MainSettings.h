@@ -15,6 +15,7 @@ namespace Config
 extern const ConfigInfo<bool> MAIN_SKIP_IPL;
 extern const ConfigInfo<int> MAIN_CPU_CORE;
 extern const ConfigInfo<bool> MAIN_FASTMEM;
+extern const ConfigInfo<bool> MAIN_HUGE_PAGES;
 // Should really be in the DSP section, but we're kind of stuck with bad decisions made in the past.
 extern const ConfigInfo<bool> MAIN_DSP_HLE;
 extern const ConfigInfo<int> MAIN_TIMING_VARIANCE;
@@ -28,6 +29,8 @@ extern const ConfigInfo<bool> MAIN_DPL2_DECODER;
 extern const ConfigInfo<int> MAIN_AUDIO_LATENCY;
 extern const ConfigInfo<bool> MAIN_AUDIO_STRETCH;
 extern const ConfigInfo<int> MAIN_AUDIO_STRETCH_LATENCY;
+extern const ConfigInfo<bool> MAIN_AUDIO_LOW_LATENCY;
+extern const ConfigInfo<bool> MAIN_AUDIO_NATIVE_SAMPLE_RATE;
 extern const ConfigInfo<std::string> MAIN_MEMCARD_A_PATH;
 extern const ConfigInfo<std::string> MAIN_MEMCARD_B_PATH;
 extern const ConfigInfo<std::string> MAIN_AGP_CART_A_PATH;
@@ -57,6 +60,13 @@ extern const ConfigInfo<bool> MAIN_DCBZ;
 extern const ConfigInfo<bool> MAIN_LOW_DCBZ_HACK;
 extern const ConfigInfo<bool> MAIN_FPRF;
 extern const ConfigInfo<bool> MAIN_ACCURATE_NANS;
+extern const ConfigInfo<bool> MAIN_JIT_BLOCK_MANIFEST;
+extern const ConfigInfo<int> MAIN_JIT_TIER_UP_THRESHOLD;
+extern const ConfigInfo<int> MAIN_JIT_TIER_UP_BUDGET;
+extern const ConfigInfo<int> MAIN_JIT_CODE_SEGMENTS;
+extern const ConfigInfo<bool> MAIN_JIT_TRACE_FORMATION;
+extern const ConfigInfo<int> MAIN_JIT_RECOMPILE_THRESHOLD;
+extern const ConfigInfo<bool> MAIN_JIT_LAZY_INVALIDATION;
 extern const ConfigInfo<float> MAIN_EMULATION_SPEED;
 extern const ConfigInfo<float> MAIN_OVERCLOCK;
 extern const ConfigInfo<bool> MAIN_OVERCLOCK_ENABLE;
@@ -67,11 +77,20 @@ extern const ConfigInfo<std::string> MAIN_PERF_MAP_DIR;
 extern const ConfigInfo<bool> MAIN_CUSTOM_RTC_ENABLE;
 extern const ConfigInfo<u32> MAIN_CUSTOM_RTC_VALUE;
 extern const ConfigInfo<bool> MAIN_ENABLE_SIGNATURE_CHECKS;
+extern const ConfigInfo<int> MAIN_WII_DISC_CLUSTER_CACHE_SIZE;
+extern const ConfigInfo<bool> MAIN_REWIND_ENABLE;
+extern const ConfigInfo<int> MAIN_REWIND_INTERVAL;
+extern const ConfigInfo<int> MAIN_REWIND_STATE_COUNT;
+
+// Main.Movie
+
+extern const ConfigInfo<bool> MAIN_MOVIE_VERIFY_PLAYBACK;
 
 // Main.DSP
 
 extern const ConfigInfo<bool> MAIN_DSP_CAPTURE_LOG;
 extern const ConfigInfo<bool> MAIN_DSP_JIT;
+extern const ConfigInfo<int> MAIN_DSP_HLE_VOICE_THREADS;
 extern const ConfigInfo<bool> MAIN_DUMP_AUDIO;
 extern const ConfigInfo<bool> MAIN_DUMP_AUDIO_SILENT;
 extern const ConfigInfo<bool> MAIN_DUMP_UCODE;
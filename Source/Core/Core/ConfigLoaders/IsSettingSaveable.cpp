@@ -27,6 +27,7 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
       // Graphics.Hardware
 
       Config::GFX_VSYNC.location,
+      Config::GFX_LOW_LATENCY_PRESENT.location,
       Config::GFX_ADAPTER.location,
 
       // Graphics.Settings
@@ -41,9 +42,13 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
       Config::GFX_LOG_RENDER_TIME_TO_FILE.location,
       Config::GFX_OVERLAY_STATS.location,
       Config::GFX_OVERLAY_PROJ_STATS.location,
+      Config::GFX_OVERLAY_TIMINGS.location,
       Config::GFX_DUMP_TEXTURES.location,
       Config::GFX_HIRES_TEXTURES.location,
       Config::GFX_CACHE_HIRES_TEXTURES.location,
+      Config::GFX_STREAM_HIRES_TEXTURES.location,
+      Config::GFX_HIRES_TEXTURE_STREAMING_BUDGET.location,
+      Config::GFX_TEXTURE_CACHE_BUDGET.location,
       Config::GFX_DUMP_EFB_TARGET.location,
       Config::GFX_DUMP_FRAMES_AS_IMAGES.location,
       Config::GFX_FREE_LOOK.location,
@@ -53,6 +58,7 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
       Config::GFX_DUMP_ENCODER.location,
       Config::GFX_DUMP_PATH.location,
       Config::GFX_BITRATE_KBPS.location,
+      Config::GFX_PNG_COMPRESSION_LEVEL.location,
       Config::GFX_INTERNAL_RESOLUTION_FRAME_DUMPS.location,
       Config::GFX_ENABLE_GPU_TEXTURE_DECODING.location,
       Config::GFX_ENABLE_PIXEL_LIGHTING.location,
@@ -60,6 +66,7 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
       Config::GFX_MSAA.location,
       Config::GFX_SSAA.location,
       Config::GFX_EFB_SCALE.location,
+      Config::GFX_DYNAMIC_RESOLUTION.location,
       Config::GFX_TEXFMT_OVERLAY_ENABLE.location,
       Config::GFX_TEXFMT_OVERLAY_CENTER.location,
       Config::GFX_ENABLE_WIREFRAME.location,
@@ -73,6 +80,7 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
       Config::GFX_SHADER_COMPILATION_MODE.location,
       Config::GFX_SHADER_COMPILER_THREADS.location,
       Config::GFX_SHADER_PRECOMPILER_THREADS.location,
+      Config::GFX_TEXTURE_DECODING_THREADS.location,
 
       Config::GFX_SW_ZCOMPLOC.location,
       Config::GFX_SW_ZFREEZE.location,
@@ -81,6 +89,7 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
       Config::GFX_SW_DUMP_TEV_TEX_FETCHES.location,
       Config::GFX_SW_DRAW_START.location,
       Config::GFX_SW_DRAW_END.location,
+      Config::GFX_SW_RASTERIZER_THREADS.location,
 
       // Graphics.Enhancements
 
@@ -107,6 +116,7 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
       Config::GFX_HACK_BBOX_PREFER_STENCIL_IMPLEMENTATION.location,
       Config::GFX_HACK_FORCE_PROGRESSIVE.location,
       Config::GFX_HACK_SKIP_EFB_COPY_TO_RAM.location,
+      Config::GFX_HACK_DEFER_EFB_COPIES.location,
       Config::GFX_HACK_SKIP_XFB_COPY_TO_RAM.location,
       Config::GFX_HACK_DISABLE_COPY_TO_VRAM.location,
       Config::GFX_HACK_IMMEDIATE_XFB.location,
@@ -117,6 +127,7 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
       // Graphics.GameSpecific
 
       Config::GFX_PERF_QUERIES_ENABLE.location,
+      Config::GFX_PERF_QUERIES_NON_BLOCKING.location,
 
   };
 
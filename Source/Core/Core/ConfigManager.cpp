@@ -220,7 +220,11 @@ void SConfig::SaveCoreSettings(IniFile& ini)
   core->Set("TimingVariance", iTimingVariance);
   core->Set("CPUCore", iCPUCore);
   core->Set("Fastmem", bFastmem);
+  core->Set("HugePages", bHugePages);
+  core->Set("SharedMemoryExport", bSharedMemoryExport);
   core->Set("CPUThread", bCPUThread);
+  core->Set("PinEmulatorThreads", bPinEmulatorThreads);
+  core->Set("HighThreadPriority", bHighThreadPriority);
   core->Set("DSPHLE", bDSPHLE);
   core->Set("SyncOnSkipIdle", bSyncGPUOnSkipIdleHack);
   core->Set("SyncGPU", bSyncGPU);
@@ -229,6 +233,13 @@ void SConfig::SaveCoreSettings(IniFile& ini)
   core->Set("SyncGpuOverclock", fSyncGpuOverclock);
   core->Set("FPRF", bFPRF);
   core->Set("AccurateNaNs", bAccurateNaNs);
+  core->Set("JITBlockManifest", bJITBlockManifest);
+  core->Set("JITTierUpThreshold", iJITTierUpThreshold);
+  core->Set("JITTierUpBudget", iJITTierUpBudget);
+  core->Set("JITCodeSegments", iJITCodeSegments);
+  core->Set("JITTraceFormation", bJITTraceFormation);
+  core->Set("JITRecompileThreshold", iJITRecompileThreshold);
+  core->Set("JITLazyInvalidation", bJITLazyInvalidation);
   core->Set("DefaultISO", m_strDefaultISO);
   core->Set("EnableCheats", bEnableCheats);
   core->Set("SelectedLanguage", SelectedLanguage);
@@ -237,6 +248,8 @@ void SConfig::SaveCoreSettings(IniFile& ini)
   core->Set("AudioLatency", iLatency);
   core->Set("AudioStretch", m_audio_stretch);
   core->Set("AudioStretchMaxLatency", m_audio_stretch_max_latency);
+  core->Set("AudioLowLatency", m_audio_low_latency);
+  core->Set("AudioNativeSampleRate", m_audio_native_sample_rate);
   core->Set("MemcardAPath", m_strMemoryCardA);
   core->Set("MemcardBPath", m_strMemoryCardB);
   core->Set("AgpCartAPath", m_strGbaCartA);
@@ -292,6 +305,7 @@ void SConfig::SaveDSPSettings(IniFile& ini)
   dsp->Set("Backend", sBackend);
   dsp->Set("Volume", m_Volume);
   dsp->Set("CaptureLog", m_DSPCaptureLog);
+  dsp->Set("HLEVoiceThreads", m_DSPHLEVoiceThreads);
 
 #ifdef _WIN32
   dsp->Set("WASAPIDevice", sWASAPIDevice);
@@ -303,6 +317,7 @@ void SConfig::SaveInputSettings(IniFile& ini)
   IniFile::Section* input = ini.GetOrCreateSection("Input");
 
   input->Set("BackgroundInput", m_BackgroundInput);
+  input->Set("SamplingRate", m_InputSamplingRate);
 }
 
 void SConfig::SaveFifoPlayerSettings(IniFile& ini)
@@ -512,9 +527,13 @@ void SConfig::LoadCoreSettings(IniFile& ini)
   core->Get("CPUCore", &iCPUCore, PowerPC::CORE_INTERPRETER);
 #endif
   core->Get("Fastmem", &bFastmem, true);
+  core->Get("HugePages", &bHugePages, false);
+  core->Get("SharedMemoryExport", &bSharedMemoryExport, false);
   core->Get("DSPHLE", &bDSPHLE, true);
   core->Get("TimingVariance", &iTimingVariance, 40);
   core->Get("CPUThread", &bCPUThread, true);
+  core->Get("PinEmulatorThreads", &bPinEmulatorThreads, false);
+  core->Get("HighThreadPriority", &bHighThreadPriority, false);
   core->Get("SyncOnSkipIdle", &bSyncGPUOnSkipIdleHack, true);
   core->Get("DefaultISO", &m_strDefaultISO);
   core->Get("EnableCheats", &bEnableCheats, false);
@@ -524,6 +543,8 @@ void SConfig::LoadCoreSettings(IniFile& ini)
   core->Get("AudioLatency", &iLatency, 20);
   core->Get("AudioStretch", &m_audio_stretch, false);
   core->Get("AudioStretchMaxLatency", &m_audio_stretch_max_latency, 80);
+  core->Get("AudioLowLatency", &m_audio_low_latency, false);
+  core->Get("AudioNativeSampleRate", &m_audio_native_sample_rate, false);
   core->Get("MemcardAPath", &m_strMemoryCardA);
   core->Get("MemcardBPath", &m_strMemoryCardB);
   core->Get("AgpCartAPath", &m_strGbaCartA);
@@ -556,6 +577,13 @@ void SConfig::LoadCoreSettings(IniFile& ini)
   core->Get("LowDCBZHack", &bLowDCBZHack, false);
   core->Get("FPRF", &bFPRF, false);
   core->Get("AccurateNaNs", &bAccurateNaNs, false);
+  core->Get("JITBlockManifest", &bJITBlockManifest, false);
+  core->Get("JITTierUpThreshold", &iJITTierUpThreshold, 0);
+  core->Get("JITTierUpBudget", &iJITTierUpBudget, 0);
+  core->Get("JITCodeSegments", &iJITCodeSegments, 4);
+  core->Get("JITTraceFormation", &bJITTraceFormation, false);
+  core->Get("JITRecompileThreshold", &iJITRecompileThreshold, 0);
+  core->Get("JITLazyInvalidation", &bJITLazyInvalidation, false);
   core->Get("EmulationSpeed", &m_EmulationSpeed, 1.0f);
   core->Get("Overclock", &m_OCFactor, 1.0f);
   core->Get("OverclockEnable", &m_OCEnable, false);
@@ -592,6 +620,7 @@ void SConfig::LoadDSPSettings(IniFile& ini)
   dsp->Get("Backend", &sBackend, AudioCommon::GetDefaultSoundBackend());
   dsp->Get("Volume", &m_Volume, 100);
   dsp->Get("CaptureLog", &m_DSPCaptureLog, false);
+  dsp->Get("HLEVoiceThreads", &m_DSPHLEVoiceThreads, 0);
 
 #ifdef _WIN32
   dsp->Get("WASAPIDevice", &sWASAPIDevice, "default");
@@ -605,6 +634,7 @@ void SConfig::LoadInputSettings(IniFile& ini)
   IniFile::Section* input = ini.GetOrCreateSection("Input");
 
   input->Get("BackgroundInput", &m_BackgroundInput, false);
+  input->Get("SamplingRate", &m_InputSamplingRate, 0);
 }
 
 void SConfig::LoadFifoPlayerSettings(IniFile& ini)
@@ -790,6 +820,8 @@ void SConfig::LoadDefaults()
   iLatency = 20;
   m_audio_stretch = false;
   m_audio_stretch_max_latency = 80;
+  m_audio_low_latency = false;
+  m_audio_native_sample_rate = false;
   bUsePanicHandlers = true;
   bOnScreenDisplayMessages = true;
 
@@ -91,13 +91,37 @@ struct SConfig
   bool bJITPairedOff = false;
   bool bJITSystemRegistersOff = false;
   bool bJITBranchOff = false;
+  // Remember compiled blocks per game and precompile them on the next boot.
+  bool bJITBlockManifest = false;
+  // Number of cached interpreter runs before a block is fully compiled; 0 disables tiering.
+  int iJITTierUpThreshold = 0;
+  // Maximum number of tier-up compiles per millisecond of emulated time; 0 means unlimited.
+  int iJITTierUpBudget = 0;
+  // Number of segments the JIT code space is split into. Running out of space only recycles the
+  // oldest segment; 1 restores clearing the whole cache.
+  int iJITCodeSegments = 4;
+  // Follow predicted-taken conditional branches into longer blocks with side exits.
+  bool bJITTraceFormation = false;
+  // Number of entries after which a block is recompiled with trace following; 0 disables it.
+  int iJITRecompileThreshold = 0;
+  // Only bump a per-page generation on icache line invalidations and let blocks check it on
+  // entry, instead of destroying the overlapping blocks right away.
+  bool bJITLazyInvalidation = false;
 
   bool bFastmem;
+  // Ask for emulated RAM to be backed by huge pages where the host supports it.
+  bool bHugePages = false;
+  // Let other processes read the emulated memory and the latest frame (see SharedMemoryExport.h)
+  bool bSharedMemoryExport = false;
   bool bFPRF = false;
   bool bAccurateNaNs = false;
 
   int iTimingVariance = 40;  // in milli secounds
   bool bCPUThread = true;
+  // Pin the CPU and GPU threads to the fastest cores, and raise the priority of the CPU, GPU and
+  // audio threads.
+  bool bPinEmulatorThreads = false;
+  bool bHighThreadPriority = false;
   bool bDSPThread = false;
   bool bDSPHLE = true;
   bool bSyncGPUOnSkipIdleHack = true;
@@ -110,6 +134,10 @@ struct SConfig
   int iLatency = 20;
   bool m_audio_stretch = false;
   int m_audio_stretch_max_latency = 80;
+  // Let the mixer shrink its buffer toward the smallest size that avoids underruns.
+  bool m_audio_low_latency = false;
+  // Mix at the output device's preferred rate instead of 48 kHz, where the backend supports it.
+  bool m_audio_native_sample_rate = false;
 
   bool bRunCompareServer = false;
   bool bRunCompareClient = false;
@@ -292,6 +320,8 @@ struct SConfig
   // DSP settings
   bool m_DSPEnableJIT;
   bool m_DSPCaptureLog;
+  // Extra threads the AX HLE ucodes may split voice processing across, 0 to process them inline.
+  int m_DSPHLEVoiceThreads = 0;
   bool m_DumpAudio;
   bool m_DumpAudioSilent;
   bool m_IsMuted;
@@ -306,6 +336,9 @@ struct SConfig
 
   // Input settings
   bool m_BackgroundInput;
+  // How many times per second input devices are updated on their own thread. 0 updates them
+  // whenever the emulated hardware asks for input instead.
+  int m_InputSamplingRate;
   bool m_AdapterRumble[4];
   bool m_AdapterKonga[4];
 
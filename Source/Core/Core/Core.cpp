@@ -4,11 +4,14 @@
 
 #include "Core/Core.h"
 
+#include <algorithm>
 #include <atomic>
+#include <cinttypes>
 #include <cstring>
 #include <locale>
 #include <mutex>
 #include <queue>
+#include <thread>
 #include <utility>
 #include <variant>
 
@@ -41,6 +44,9 @@
 #ifdef USE_MEMORYWATCHER
 #include "Core/MemoryWatcher.h"
 #endif
+#ifdef USE_SHARED_MEMORY_EXPORT
+#include "Core/SharedMemoryExport.h"
+#endif
 #include "Core/Boot/Boot.h"
 #include "Core/FifoPlayer/FifoPlayer.h"
 #include "Core/HLE/HLE.h"
@@ -81,6 +87,9 @@ static bool s_wants_determinism;
 
 // Declarations and definitions
 static Common::Timer s_timer;
+// Measures how long each step of starting the emulation takes, up to the first frame
+static Common::Timer s_startup_timer;
+static Common::Flag s_first_frame_pending;
 static std::atomic<u32> s_drawn_frame;
 static std::atomic<u32> s_drawn_video;
 
@@ -109,6 +118,11 @@ static thread_local bool tls_is_cpu_thread = false;
 
 static void EmuThread(std::unique_ptr<BootParameters> boot);
 
+static void LogStartupStep(const char* step)
+{
+  NOTICE_LOG(BOOT, "Startup: %s after %" PRIu64 " ms", step, s_startup_timer.GetTimeElapsed());
+}
+
 bool GetIsThrottlerTempDisabled()
 {
   return s_is_throttler_temp_disabled;
@@ -282,6 +296,32 @@ void UndeclareAsCPUThread()
   tls_is_cpu_thread = false;
 }
 
+void ApplyThreadPlacement(EmulatorThread thread)
+{
+  const SConfig& config = SConfig::GetInstance();
+  if (config.bPinEmulatorThreads && thread != EmulatorThread::Audio)
+  {
+    static const std::vector<u32> s_fastest_cpus = Common::GetFastestCPUs();
+    const size_t index = thread == EmulatorThread::GPU && s_fastest_cpus.size() > 1 ? 1 : 0;
+    // The affinity masks only cover the first 32 CPUs
+    if (index < s_fastest_cpus.size() && s_fastest_cpus[index] < 32)
+    {
+      Common::SetCurrentThreadAffinity(1u << s_fastest_cpus[index]);
+      INFO_LOG(CORE, "Pinned the %s thread to CPU %u",
+               thread == EmulatorThread::CPU ? "CPU" : "GPU", s_fastest_cpus[index]);
+    }
+  }
+
+  if (config.bHighThreadPriority)
+  {
+    const Common::ThreadPriority priority = thread == EmulatorThread::Audio ?
+                                                Common::ThreadPriority::Realtime :
+                                                Common::ThreadPriority::High;
+    if (!Common::SetCurrentThreadPriority(priority))
+      WARN_LOG(CORE, "Could not raise the priority of an emulator thread");
+  }
+}
+
 // For the CPU Thread only.
 static void CPUSetInitialExecutionState()
 {
@@ -305,6 +345,7 @@ static void CpuThread(const std::optional<std::string>& savestate_path, bool del
     Common::SetCurrentThreadName("CPU thread");
   else
     Common::SetCurrentThreadName("CPU-GPU thread");
+  ApplyThreadPlacement(EmulatorThread::CPU);
 
   // This needs to be delayed until after the video backend is ready.
   DolphinAnalytics::Instance()->ReportGameStart();
@@ -407,6 +448,8 @@ static void EmuThread(std::unique_ptr<BootParameters> boot)
   }};
 
   Common::SetCurrentThreadName("Emuthread - Starting");
+  s_startup_timer.Start();
+  s_first_frame_pending.Clear();
 
   // For a time this acts as the CPU thread...
   DeclareAsCPUThread();
@@ -416,7 +459,14 @@ static void EmuThread(std::unique_ptr<BootParameters> boot)
   Common::ScopeGuard movie_guard{Movie::Shutdown};
 
   HW::Init();
+  LogStartupStep("Hardware initialized");
+#ifdef USE_SHARED_MEMORY_EXPORT
+  SharedMemoryExport::Init();
+#endif
   Common::ScopeGuard hw_guard{[] {
+#ifdef USE_SHARED_MEMORY_EXPORT
+    SharedMemoryExport::Shutdown();
+#endif
     // We must set up this flag before executing HW::Shutdown()
     s_hardware_initialized = false;
     INFO_LOG(CONSOLE, "%s", StopMessage(false, "Shutting down HW").c_str());
@@ -434,56 +484,63 @@ static void EmuThread(std::unique_ptr<BootParameters> boot)
     HLE::Clear();
   }};
 
-  if (!g_video_backend->Initialize(s_window_handle))
-  {
-    PanicAlert("Failed to initialize video backend!");
-    return;
-  }
-  Common::ScopeGuard video_guard{[] { g_video_backend->Shutdown(); }};
-
   if (cpu_info.HTT)
     SConfig::GetInstance().bDSPThread = cpu_info.num_cores > 4;
   else
     SConfig::GetInstance().bDSPThread = cpu_info.num_cores > 2;
 
-  if (!DSP::GetDSPEmulator()->Initialize(core_parameter.bWii, core_parameter.bDSPThread))
-  {
-    PanicAlert("Failed to initialize DSP emulation!");
-    return;
-  }
+  const std::optional<std::string> savestate_path = boot->savestate_path;
+  const bool delete_savestate = boot->delete_savestate;
 
+  // The DSP and the controllers don't depend on the video backend, so they are initialized on
+  // another thread while the video backend starts up and loads its shader caches. The video
+  // backend stays on this thread since it may make its context current here.
+  bool dsp_initialized = false;
   bool init_controllers = false;
-  if (!g_controller_interface.IsInit())
-  {
-    g_controller_interface.Initialize(s_window_handle);
-    Pad::Initialize();
-    Keyboard::Initialize();
-    init_controllers = true;
-  }
-  else
-  {
-    // Update references in case controllers were refreshed
-    Pad::LoadConfig();
-    Keyboard::LoadConfig();
-  }
+  std::thread init_thread([&] {
+    Common::SetCurrentThreadName("Emuthread - Init");
 
-  const std::optional<std::string> savestate_path = boot->savestate_path;
-  const bool delete_savestate = boot->delete_savestate;
+    dsp_initialized =
+        DSP::GetDSPEmulator()->Initialize(core_parameter.bWii, core_parameter.bDSPThread);
+    if (!dsp_initialized)
+      return;
 
-  // Load and Init Wiimotes - only if we are booting in Wii mode
-  if (core_parameter.bWii && !SConfig::GetInstance().m_bt_passthrough_enabled)
-  {
-    if (init_controllers)
+    if (!g_controller_interface.IsInit())
     {
-      Wiimote::Initialize(savestate_path ? Wiimote::InitializeMode::DO_WAIT_FOR_WIIMOTES :
-                                           Wiimote::InitializeMode::DO_NOT_WAIT_FOR_WIIMOTES);
+      g_controller_interface.Initialize(s_window_handle);
+      Pad::Initialize();
+      Keyboard::Initialize();
+      init_controllers = true;
     }
     else
     {
-      Wiimote::LoadConfig();
+      // Update references in case controllers were refreshed
+      Pad::LoadConfig();
+      Keyboard::LoadConfig();
     }
-  }
 
+    // Load and Init Wiimotes - only if we are booting in Wii mode
+    if (core_parameter.bWii && !SConfig::GetInstance().m_bt_passthrough_enabled)
+    {
+      if (init_controllers)
+      {
+        Wiimote::Initialize(savestate_path ? Wiimote::InitializeMode::DO_WAIT_FOR_WIIMOTES :
+                                             Wiimote::InitializeMode::DO_NOT_WAIT_FOR_WIIMOTES);
+      }
+      else
+      {
+        Wiimote::LoadConfig();
+      }
+    }
+    LogStartupStep("DSP and controllers initialized");
+  });
+
+  const bool video_initialized = g_video_backend->Initialize(s_window_handle);
+  if (video_initialized)
+    LogStartupStep("Video backend initialized");
+  init_thread.join();
+
+  Common::ScopeGuard video_guard{[] { g_video_backend->Shutdown(); }};
   Common::ScopeGuard controller_guard{[init_controllers] {
     if (!init_controllers)
       return;
@@ -494,8 +551,26 @@ static void EmuThread(std::unique_ptr<BootParameters> boot)
     g_controller_interface.Shutdown();
   }};
 
+  if (!video_initialized)
+  {
+    video_guard.Dismiss();
+    PanicAlert("Failed to initialize video backend!");
+    return;
+  }
+
+  if (!dsp_initialized)
+  {
+    PanicAlert("Failed to initialize DSP emulation!");
+    return;
+  }
+
+  g_controller_interface.SetBackgroundSamplingRate(
+      static_cast<u32>(std::max(SConfig::GetInstance().m_InputSamplingRate, 0)));
+  Common::ScopeGuard sampling_guard{[] { g_controller_interface.SetBackgroundSamplingRate(0); }};
+
   AudioCommon::InitSoundStream();
   Common::ScopeGuard audio_guard{AudioCommon::ShutdownSoundStream};
+  LogStartupStep("Audio initialized");
 
   // The hardware is initialized.
   s_hardware_initialized = true;
@@ -516,6 +591,8 @@ static void EmuThread(std::unique_ptr<BootParameters> boot)
 
   if (!CBoot::BootUp(std::move(boot)))
     return;
+  LogStartupStep("Booted");
+  s_first_frame_pending.Set();
 
   // Initialise Wii filesystem contents.
   // This is done here after Boot and not in HW to ensure that we operate
@@ -547,6 +624,7 @@ static void EmuThread(std::unique_ptr<BootParameters> boot)
     // thread, and then takes over and becomes the video thread
     Common::SetCurrentThreadName("Video thread");
     UndeclareAsCPUThread();
+    ApplyThreadPlacement(EmulatorThread::GPU);
 
     // Spawn the CPU thread. The CPU thread will signal the event that boot is complete.
     s_cpu_thread = std::thread(cpuThreadFunc, savestate_path, delete_savestate);
@@ -754,6 +832,8 @@ void VideoThrottle()
   }
 
   s_drawn_video++;
+
+  ::State::UpdateRewind();
 }
 
 // Executed from GPU thread
@@ -776,7 +856,11 @@ bool ShouldSkipFrame(int skipped)
 void Callback_VideoCopiedToXFB(bool video_update)
 {
   if (video_update)
+  {
     s_drawn_frame++;
+    if (s_first_frame_pending.TestAndClear())
+      LogStartupStep("First frame");
+  }
 
   Movie::FrameUpdate();
 
@@ -859,6 +943,9 @@ void UpdateTitle()
   {
     Mixer* pMixer = g_sound_stream->GetMixer();
     pMixer->UpdateSpeed((float)Speed / 100);
+
+    if (SConfig::GetInstance().m_audio_low_latency)
+      message += StringFromFormat(" | Audio: %u ms", pMixer->GetLatencyMs());
   }
 
   Host_UpdateTitle(message);
@@ -42,6 +42,17 @@ void Shutdown();
 void DeclareAsCPUThread();
 void UndeclareAsCPUThread();
 
+enum class EmulatorThread
+{
+  CPU,
+  GPU,
+  Audio,
+};
+
+// Applies the affinity and priority chosen by the PinEmulatorThreads and HighThreadPriority
+// settings to the calling thread. The CPU and GPU threads are pinned to separate fast cores.
+void ApplyThreadPlacement(EmulatorThread thread);
+
 std::string StopMessage(bool, const std::string&);
 
 bool IsRunning();
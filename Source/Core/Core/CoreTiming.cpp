@@ -14,6 +14,7 @@
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/Logging/Log.h"
+#include "Common/Profiler.h"
 #include "Common/SPSCQueue.h"
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
@@ -23,6 +24,7 @@
 #include "Core/PowerPC/PowerPC.h"
 
 #include "VideoCommon/Fifo.h"
+#include "VideoCommon/PixelEngine.h"
 #include "VideoCommon/VideoBackendBase.h"
 
 namespace CoreTiming
@@ -42,10 +44,6 @@ struct Event
 };
 
 // Sort by time, unless the times are the same, in which case sort by the order added to the queue
-static bool operator>(const Event& left, const Event& right)
-{
-  return std::tie(left.time, left.fifo_order) > std::tie(right.time, right.fifo_order);
-}
 static bool operator<(const Event& left, const Event& right)
 {
   return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
@@ -56,10 +54,13 @@ static bool operator<(const Event& left, const Event& right)
 static std::unordered_map<std::string, EventType> s_event_types;
 
 // STATE_TO_SAVE
-// The queue is a min-heap using std::make_heap/push_heap/pop_heap.
+// The queue is a 4-ary min-heap, see PushEvent/PopEvent/RebuildQueue.
 // We don't use std::priority_queue because we need to be able to serialize, unserialize and
 // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't accomodated
-// by the standard adaptor class.
+// by the standard adaptor class. A 4-ary heap is half as deep as a binary one and keeps the
+// children of a node next to each other in memory; since audio DMA, SI and VI events are
+// rescheduled constantly, that saves a fair amount of time in Advance().
+static constexpr size_t QUEUE_ARITY = 4;
 static std::vector<Event> s_event_queue;
 static u64 s_event_fifo_id;
 static std::mutex s_ts_write_lock;
@@ -75,6 +76,9 @@ static u64 s_fake_dec_start_ticks;
 // Are we in a function that has been called from Advance()
 static bool s_is_global_timer_sane;
 
+// Whether the "PowerPC" profiler in Advance() is timing the current slice.
+static bool s_is_profiling_slice;
+
 Globals g;
 
 static EventType* s_ev_lost = nullptr;
@@ -83,6 +87,69 @@ static void EmptyTimedCallback(u64 userdata, s64 cyclesLate)
 {
 }
 
+static void SiftUp(size_t index)
+{
+  Event ev = std::move(s_event_queue[index]);
+  while (index > 0)
+  {
+    const size_t parent = (index - 1) / QUEUE_ARITY;
+    if (!(ev < s_event_queue[parent]))
+      break;
+    s_event_queue[index] = std::move(s_event_queue[parent]);
+    index = parent;
+  }
+  s_event_queue[index] = std::move(ev);
+}
+
+static void SiftDown(size_t index)
+{
+  const size_t size = s_event_queue.size();
+  Event ev = std::move(s_event_queue[index]);
+  while (true)
+  {
+    const size_t first_child = index * QUEUE_ARITY + 1;
+    if (first_child >= size)
+      break;
+
+    const size_t last_child = std::min(first_child + QUEUE_ARITY, size);
+    size_t earliest = first_child;
+    for (size_t child = first_child + 1; child < last_child; ++child)
+    {
+      if (s_event_queue[child] < s_event_queue[earliest])
+        earliest = child;
+    }
+    if (!(s_event_queue[earliest] < ev))
+      break;
+
+    s_event_queue[index] = std::move(s_event_queue[earliest]);
+    index = earliest;
+  }
+  s_event_queue[index] = std::move(ev);
+}
+
+static void PushEvent(Event ev)
+{
+  s_event_queue.emplace_back(std::move(ev));
+  SiftUp(s_event_queue.size() - 1);
+}
+
+static void PopEvent()
+{
+  s_event_queue.front() = std::move(s_event_queue.back());
+  s_event_queue.pop_back();
+  if (!s_event_queue.empty())
+    SiftDown(0);
+}
+
+static void RebuildQueue()
+{
+  if (s_event_queue.size() < 2)
+    return;
+
+  for (size_t i = (s_event_queue.size() - 2) / QUEUE_ARITY + 1; i-- > 0;)
+    SiftDown(i);
+}
+
 // Changing the CPU speed in Dolphin isn't actually done by changing the physical clock rate,
 // but by changing the amount of work done in a particular amount of time. This tends to be more
 // compatible because it stops the games from actually knowing directly that the clock rate has
@@ -199,10 +266,10 @@ void DoState(PointerWrap& p)
   p.DoMarker("CoreTimingEvents");
 
   // When loading from a save state, we must assume the Event order is random and meaningless.
-  // The exact layout of the heap in memory is implementation defined, therefore it is platform
-  // and library version specific.
+  // The exact layout of the heap in memory depends on the order in which events were added and
+  // removed, and has changed between versions.
   if (p.GetMode() == PointerWrap::MODE_READ)
-    std::make_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+    RebuildQueue();
 }
 
 // This should only be called from the CPU thread. If you are calling
@@ -253,8 +320,7 @@ void ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
     if (!s_is_global_timer_sane)
       ForceExceptionCheck(cycles_into_future);
 
-    s_event_queue.emplace_back(Event{timeout, s_event_fifo_id++, userdata, event_type});
-    std::push_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+    PushEvent(Event{timeout, s_event_fifo_id++, userdata, event_type});
   }
   else
   {
@@ -280,7 +346,7 @@ void RemoveEvent(EventType* event_type)
   if (itr != s_event_queue.end())
   {
     s_event_queue.erase(itr, s_event_queue.end());
-    std::make_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+    RebuildQueue();
   }
 }
 
@@ -307,13 +373,22 @@ void MoveEvents()
   for (Event ev; s_ts_queue.Pop(ev);)
   {
     ev.fifo_order = s_event_fifo_id++;
-    s_event_queue.emplace_back(std::move(ev));
-    std::push_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+    PushEvent(std::move(ev));
   }
 }
 
 void Advance()
 {
+  // Guest code runs in between calls to Advance(), so that's what this profiler covers.
+  static Common::Profiler ppc_profiler("PowerPC");
+  if (s_is_profiling_slice)
+  {
+    ppc_profiler.Stop();
+    s_is_profiling_slice = false;
+  }
+
+  PROFILE("CoreTiming::Advance");
+
   MoveEvents();
 
   int cyclesExecuted = g.slice_length - DowncountToCycles(PowerPC::ppcState.downcount);
@@ -327,8 +402,7 @@ void Advance()
   while (!s_event_queue.empty() && s_event_queue.front().time <= g.global_timer)
   {
     Event evt = std::move(s_event_queue.front());
-    std::pop_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
-    s_event_queue.pop_back();
+    PopEvent();
     // NOTICE_LOG(POWERPC, "[Scheduler] %-20s (%lld, %lld)", evt.type->name->c_str(),
     //            g.global_timer, evt.time);
     evt.type->callback(evt.userdata, g.global_timer - evt.time);
@@ -350,6 +424,12 @@ void Advance()
   // until the next slice:
   //        Pokemon Box refuses to boot if the first exception from the audio DMA is received late
   PowerPC::CheckExternalExceptions();
+
+  if (Common::Profiler::IsEnabled())
+  {
+    ppc_profiler.Start();
+    s_is_profiling_slice = true;
+  }
 }
 
 void LogPendingEvents()
@@ -375,7 +455,9 @@ void AdjustEventQueueTimes(u32 new_ppc_clock, u32 old_ppc_clock)
 
 void Idle()
 {
-  if (SConfig::GetInstance().bSyncGPUOnSkipIdleHack)
+  // If the GPU has raised a token or finish event, the CPU is likely idling until it is handled,
+  // which happens right away as the downcount is cleared.
+  if (SConfig::GetInstance().bSyncGPUOnSkipIdleHack && !PixelEngine::IsEventPending())
   {
     // When the FIFO is processing data we must not advance because in this way
     // the VI will be desynchronized. So, We are waiting until the FIFO finish and
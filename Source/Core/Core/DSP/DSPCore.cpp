@@ -14,6 +14,7 @@
 #include "Common/Hash.h"
 #include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/Profiler.h"
 
 #include "Core/DSP/DSPAccelerator.h"
 #include "Core/DSP/DSPAnalyzer.h"
@@ -264,6 +265,8 @@ void DSPCore_CheckExceptions()
 // Handle state changes and stepping.
 int DSPCore_RunCycles(int cycles)
 {
+  PROFILE("DSPCore_RunCycles");
+
   if (g_dsp_jit)
   {
     return g_dsp_jit->RunCycles(static_cast<u16>(cycles));
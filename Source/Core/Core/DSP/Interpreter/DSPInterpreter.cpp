@@ -5,6 +5,8 @@
 
 #include "Core/DSP/Interpreter/DSPInterpreter.h"
 
+#include <array>
+
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 
@@ -19,6 +21,17 @@ namespace Interpreter
 {
 namespace
 {
+// The handlers of the instructions in IRAM and IROM, so that steps don't have to look them up in
+// the opcode tables. Each entry remembers the instruction it was decoded from, which makes new
+// ucode uploaded into IRAM get decoded again the first time it runs.
+struct DecodedInstruction
+{
+  UDSPInstruction inst = 0;
+  DSPOPCTemplate::InterpreterFunction main = nullptr;
+  DSPOPCTemplate::InterpreterFunction ext = nullptr;
+};
+std::array<DecodedInstruction, DSP_IRAM_SIZE + DSP_IROM_SIZE> s_decoded;
+
 void ExecuteInstruction(const UDSPInstruction inst)
 {
   const DSPOPCTemplate* opcode_template = GetOpTemplate(inst);
@@ -35,6 +48,48 @@ void ExecuteInstruction(const UDSPInstruction inst)
     applyWriteBackLog();
   }
 }
+
+// Fetches and runs the instruction at pc. Code outside of IRAM and IROM isn't decoded ahead.
+void FetchAndExecute()
+{
+  const u16 pc = g_dsp.pc;
+  UDSPInstruction inst;
+  DecodedInstruction* decoded;
+  switch (pc >> 12)
+  {
+  case 0:
+    inst = g_dsp.iram[pc & DSP_IRAM_MASK];
+    decoded = &s_decoded[pc & DSP_IRAM_MASK];
+    break;
+  case 8:
+    inst = g_dsp.irom[pc & DSP_IROM_MASK];
+    decoded = &s_decoded[DSP_IRAM_SIZE + (pc & DSP_IROM_MASK)];
+    break;
+  default:
+    ExecuteInstruction(UDSPInstruction(dsp_fetch_code()));
+    return;
+  }
+
+  if (decoded->inst != inst || !decoded->main)
+  {
+    const DSPOPCTemplate* opcode_template = GetOpTemplate(inst);
+    decoded->inst = inst;
+    decoded->main = opcode_template->intFunc;
+    decoded->ext = opcode_template->extended ? GetExtOpTemplate(inst)->intFunc : nullptr;
+  }
+  g_dsp.pc++;
+
+  if (decoded->ext)
+  {
+    decoded->ext(inst);
+    decoded->main(inst);
+    applyWriteBackLog();
+  }
+  else
+  {
+    decoded->main(inst);
+  }
+}
 }  // Anonymous namespace
 
 // NOTE: These have nothing to do with g_dsp.r.cr !
@@ -77,7 +132,9 @@ u16 ReadCR()
 
 void Step()
 {
-  DSPCore_CheckExceptions();
+  // Exceptions are rare, so avoid the call in the common case
+  if (g_dsp.exceptions != 0)
+    DSPCore_CheckExceptions();
 
   g_dsp.step_counter++;
 
@@ -96,8 +153,7 @@ void Step()
   }
 #endif
 
-  u16 opc = dsp_fetch_code();
-  ExecuteInstruction(UDSPInstruction(opc));
+  FetchAndExecute();
 
   if (Analyzer::GetCodeFlags(static_cast<u16>(g_dsp.pc - 1u)) & Analyzer::CODE_LOOP_END)
     HandleLoop();
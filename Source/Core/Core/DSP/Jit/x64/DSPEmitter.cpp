@@ -263,6 +263,14 @@ void DSPEmitter::Compile(u16 start_addr)
       }
       else
       {
+        if (!(Analyzer::GetCodeFlags(start_addr) & Analyzer::CODE_IDLE_SKIP))
+        {
+          // Loops usually start over at the beginning of this block, link to it directly.
+          CMP(16, M_SDSP_pc(), Imm16(start_addr));
+          FixupBranch other_block = J_CC(CC_NE);
+          WriteLinkJump(m_block_link_entry, m_block_size[start_addr]);
+          SetJumpTarget(other_block);
+        }
         MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
       }
       JMP(m_return_dispatcher, true);
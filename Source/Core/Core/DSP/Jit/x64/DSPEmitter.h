@@ -211,7 +211,8 @@ private:
   static void CompileCurrent(DSPEmitter& emitter);
 
   void WriteBranchExit();
-  void WriteBlockLink(u16 dest);
+  void WriteBlockLink(u16 dest, bool conditional);
+  void WriteLinkJump(const u8* entry, u16 dest_size);
 
   void ReJitConditional(UDSPInstruction opc, void (DSPEmitter::*conditional_fn)(UDSPInstruction));
   void r_jcc(UDSPInstruction opc);
@@ -96,42 +96,62 @@ void DSPEmitter::WriteBranchExit()
   m_gpr.FlushRegs(c, false);
 }
 
-void DSPEmitter::WriteBlockLink(u16 dest)
+void DSPEmitter::WriteBlockLink(u16 dest, bool conditional)
 {
+  // Branches back to the start of the current block can always be linked, unless the block is
+  // an idle loop whose exits have to go through the dispatcher to skip cycles.
+  if (dest == m_start_address)
+  {
+    if (!(Analyzer::GetCodeFlags(m_start_address) & Analyzer::CODE_IDLE_SKIP))
+    {
+      m_gpr.FlushRegs();
+      WriteLinkJump(m_block_link_entry, m_block_size[m_start_address] + 1);
+    }
+    return;
+  }
+
   // Jump directly to the called block if it has already been compiled.
   if (!(dest >= m_start_address && dest <= m_compile_pc))
   {
     if (m_block_links[dest] != nullptr)
     {
       m_gpr.FlushRegs();
-      // Check if we have enough cycles to execute the next block
-      MOV(64, R(RAX), ImmPtr(&m_cycles_left));
-      MOV(16, R(ECX), MatR(RAX));
-      CMP(16, R(ECX), Imm16(m_block_size[m_start_address] + m_block_size[dest]));
-      FixupBranch notEnoughCycles = J_CC(CC_BE);
-
-      SUB(16, R(ECX), Imm16(m_block_size[m_start_address]));
-      MOV(16, MatR(RAX), R(ECX));
-      JMP(m_block_links[dest], true);
-      SetJumpTarget(notEnoughCycles);
+      WriteLinkJump(m_block_links[dest], m_block_size[dest]);
     }
-    else
+    else if (!conditional)
     {
       // The destination has not been compiled yet.  Add it to the list
-      // of blocks that this block is waiting on.
+      // of blocks that this block is waiting on.  Conditional branches don't
+      // wait, as loops would otherwise make blocks wait on each other.
       m_unresolved_jumps[m_start_address].push_back(dest);
     }
   }
 }
 
+void DSPEmitter::WriteLinkJump(const u8* entry, u16 dest_size)
+{
+  // Linked blocks are entered right after their LoadRegs(), so the register cache has to be
+  // flushed: all guest registers are in memory, and the statically allocated ones are also
+  // still in their host registers.
+  // Check if we have enough cycles to execute the next block
+  MOV(64, R(RAX), ImmPtr(&m_cycles_left));
+  MOV(16, R(ECX), MatR(RAX));
+  CMP(16, R(ECX), Imm16(m_block_size[m_start_address] + dest_size));
+  FixupBranch notEnoughCycles = J_CC(CC_BE);
+
+  SUB(16, R(ECX), Imm16(m_block_size[m_start_address]));
+  MOV(16, MatR(RAX), R(ECX));
+  JMP(entry, true);
+  SetJumpTarget(notEnoughCycles);
+}
+
 void DSPEmitter::r_jcc(const UDSPInstruction opc)
 {
   u16 dest = dsp_imem_read(m_compile_pc + 1);
   const DSPOPCTemplate* opcode = GetOpTemplate(opc);
 
-  // If the block is unconditional, attempt to link block
-  if (opcode->uncond_branch)
-    WriteBlockLink(dest);
+  // Attempt to link block, conditional branches only link to already compiled blocks
+  WriteBlockLink(dest, !opcode->uncond_branch);
   MOV(16, M_SDSP_pc(), Imm16(dest));
   WriteBranchExit();
 }
@@ -175,9 +195,8 @@ void DSPEmitter::r_call(const UDSPInstruction opc)
   u16 dest = dsp_imem_read(m_compile_pc + 1);
   const DSPOPCTemplate* opcode = GetOpTemplate(opc);
 
-  // If the block is unconditional, attempt to link block
-  if (opcode->uncond_branch)
-    WriteBlockLink(dest);
+  // Attempt to link block, conditional branches only link to already compiled blocks
+  WriteBlockLink(dest, !opcode->uncond_branch);
   MOV(16, M_SDSP_pc(), Imm16(dest));
   WriteBranchExit();
 }
@@ -9,14 +9,18 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include <xxhash.h>
+#include <zlib.h>
 
 #include "Common/File.h"
 
+// Version 5 stores memory update data in a separate list, where each piece of data is stored once
+// and may be used by many memory updates, and compresses it and the FIFO data with zlib.
 enum
 {
   FILE_ID = 0x0d01f1f0,
-  VERSION_NUMBER = 4,
-  MIN_LOADER_VERSION = 1,
+  VERSION_NUMBER = 5,
+  MIN_LOADER_VERSION = 5,
 };
 
 #pragma pack(push, 1)
@@ -39,7 +43,9 @@ struct FileHeader
   u32 flags;
   u64 texMemOffset;
   u32 texMemSize;
-  u8 reserved[40];
+  u64 memoryDataListOffset;
+  u32 memoryDataCount;
+  u8 reserved[28];
 };
 static_assert(sizeof(FileHeader) == 128, "FileHeader should be 128 bytes");
 
@@ -51,7 +57,8 @@ struct FileFrameInfo
   u32 fifoEnd;
   u64 memoryUpdatesOffset;
   u32 numMemoryUpdates;
-  u8 reserved[32];
+  u32 fifoDataCompressedSize;
+  u8 reserved[28];
 };
 static_assert(sizeof(FileFrameInfo) == 64, "FileFrameInfo should be 64 bytes");
 
@@ -59,6 +66,7 @@ struct FileMemoryUpdate
 {
   u32 fifoPosition;
   u32 address;
+  // Since version 5, this is the index of the data in the memory data list
   u64 dataOffset;
   u32 dataSize;
   u8 type;
@@ -66,8 +74,48 @@ struct FileMemoryUpdate
 };
 static_assert(sizeof(FileMemoryUpdate) == 24, "FileMemoryUpdate should be 24 bytes");
 
+struct FileMemoryData
+{
+  u64 dataOffset;
+  u32 dataSize;
+  // Equal to dataSize if the data is stored uncompressed
+  u32 compressedSize;
+};
+static_assert(sizeof(FileMemoryData) == 16, "FileMemoryData should be 16 bytes");
+
 #pragma pack(pop)
 
+// Writes the data at the current position, compressed unless that wouldn't make it smaller.
+// Returns the number of bytes written.
+static u32 WriteCompressed(const u8* data, u32 size, std::vector<u8>& buffer, File::IOFile& file)
+{
+  uLongf compressedSize = compressBound(size);
+  buffer.resize(compressedSize);
+  if (compress2(buffer.data(), &compressedSize, data, size, Z_BEST_SPEED) != Z_OK ||
+      compressedSize >= size)
+  {
+    file.WriteBytes(data, size);
+    return size;
+  }
+
+  file.WriteBytes(buffer.data(), compressedSize);
+  return static_cast<u32>(compressedSize);
+}
+
+static bool ReadCompressed(u8* dest, u32 size, u32 compressedSize, std::vector<u8>& buffer,
+                           File::IOFile& file)
+{
+  if (compressedSize == size)
+    return file.ReadBytes(dest, size);
+
+  buffer.resize(compressedSize);
+  if (!file.ReadBytes(buffer.data(), compressedSize))
+    return false;
+
+  uLongf destSize = size;
+  return uncompress(dest, &destSize, buffer.data(), compressedSize) == Z_OK && destSize == size;
+}
+
 FifoDataFile::FifoDataFile() = default;
 
 FifoDataFile::~FifoDataFile() = default;
@@ -97,6 +145,50 @@ void FifoDataFile::AddFrame(const FifoFrameInfo& frameInfo)
   m_Frames.push_back(frameInfo);
 }
 
+u32 FifoDataFile::AddMemoryData(const u8* data, u32 size)
+{
+  std::lock_guard<std::mutex> lk(m_MemoryDataMutex);
+
+  const u64 hash = XXH64(data, size, 0);
+  const auto range = m_MemoryDataByHash.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    const MemoryData& memData = m_MemoryData[it->second];
+    if (!memData.inFile && memData.size == size &&
+        std::equal(data, data + size, memData.data.begin()))
+      return it->second;
+  }
+
+  const u32 index = static_cast<u32>(m_MemoryData.size());
+  MemoryData memData;
+  memData.data.assign(data, data + size);
+  memData.size = size;
+  m_MemoryData.push_back(std::move(memData));
+  m_MemoryDataByHash.emplace(hash, index);
+  return index;
+}
+
+bool FifoDataFile::ReadMemoryData(const MemoryUpdate& update, u8* dest)
+{
+  std::lock_guard<std::mutex> lk(m_MemoryDataMutex);
+  if (update.dataIndex >= m_MemoryData.size())
+    return false;
+  return ReadMemoryData(m_MemoryData[update.dataIndex], dest);
+}
+
+bool FifoDataFile::ReadMemoryData(const MemoryData& memData, u8* dest)
+{
+  if (!memData.inFile)
+  {
+    std::copy(memData.data.begin(), memData.data.end(), dest);
+    return true;
+  }
+
+  return m_LoadedFile->Seek(memData.fileOffset, SEEK_SET) &&
+         ReadCompressed(dest, memData.size, memData.compressedSize, m_CompressedBuffer,
+                        *m_LoadedFile);
+}
+
 bool FifoDataFile::Save(const std::string& filename)
 {
   File::IOFile file;
@@ -125,6 +217,12 @@ bool FifoDataFile::Save(const std::string& filename)
   u64 texMemOffset = file.Tell();
   file.WriteArray(m_TexMem, TEX_MEM_SIZE);
 
+  std::lock_guard<std::mutex> lk(m_MemoryDataMutex);
+
+  // Add space for memory data list
+  u64 memoryDataListOffset = file.Tell();
+  PadFile(m_MemoryData.size() * sizeof(FileMemoryData), file);
+
   // Write header
   FileHeader header;
   header.fileId = FILE_ID;
@@ -149,6 +247,9 @@ bool FifoDataFile::Save(const std::string& filename)
   header.frameListOffset = frameListOffset;
   header.frameCount = (u32)m_Frames.size();
 
+  header.memoryDataListOffset = memoryDataListOffset;
+  header.memoryDataCount = static_cast<u32>(m_MemoryData.size());
+
   header.flags = m_Flags;
 
   file.Seek(0, SEEK_SET);
@@ -162,7 +263,9 @@ bool FifoDataFile::Save(const std::string& filename)
     // Write FIFO data
     file.Seek(0, SEEK_END);
     u64 dataOffset = file.Tell();
-    file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
+    u32 compressedSize = WriteCompressed(srcFrame.fifoData.data(),
+                                         static_cast<u32>(srcFrame.fifoData.size()),
+                                         m_CompressedBuffer, file);
 
     u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file);
 
@@ -173,6 +276,7 @@ bool FifoDataFile::Save(const std::string& filename)
     dstFrame.fifoEnd = srcFrame.fifoEnd;
     dstFrame.memoryUpdatesOffset = memoryUpdatesOffset;
     dstFrame.numMemoryUpdates = static_cast<u32>(srcFrame.memoryUpdates.size());
+    dstFrame.fifoDataCompressedSize = compressedSize;
 
     // Write frame info
     u64 frameOffset = frameListOffset + (i * sizeof(FileFrameInfo));
@@ -180,6 +284,31 @@ bool FifoDataFile::Save(const std::string& filename)
     file.WriteBytes(&dstFrame, sizeof(FileFrameInfo));
   }
 
+  // Write memory data
+  std::vector<FileMemoryData> memoryDataList(m_MemoryData.size());
+  std::vector<u8> loadedData;
+  file.Seek(0, SEEK_END);
+  for (size_t i = 0; i < m_MemoryData.size(); ++i)
+  {
+    const MemoryData& srcData = m_MemoryData[i];
+    const u8* data = srcData.data.data();
+    if (srcData.inFile)
+    {
+      loadedData.resize(srcData.size);
+      if (!ReadMemoryData(srcData, loadedData.data()))
+        return false;
+      data = loadedData.data();
+    }
+
+    FileMemoryData& dstData = memoryDataList[i];
+    dstData.dataOffset = file.Tell();
+    dstData.dataSize = srcData.size;
+    dstData.compressedSize = WriteCompressed(data, srcData.size, m_CompressedBuffer, file);
+  }
+
+  file.Seek(memoryDataListOffset, SEEK_SET);
+  file.WriteArray(memoryDataList.data(), memoryDataList.size());
+
   if (!file.Close())
     return false;
 
@@ -188,8 +317,8 @@ bool FifoDataFile::Save(const std::string& filename)
 
 std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bool flagsOnly)
 {
-  File::IOFile file;
-  file.Open(filename, "rb");
+  auto loadedFile = std::make_unique<File::IOFile>(filename, "rb");
+  File::IOFile& file = *loadedFile;
   if (!file)
     return nullptr;
 
@@ -238,6 +367,25 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
     file.ReadArray(dataFile->m_TexMem, size);
   }
 
+  // Read the list of memory data, which is then read on demand
+  if (dataFile->m_Version >= 5)
+  {
+    std::vector<FileMemoryData> memoryDataList(header.memoryDataCount);
+    file.Seek(header.memoryDataListOffset, SEEK_SET);
+    if (!file.ReadArray(memoryDataList.data(), memoryDataList.size()))
+      return nullptr;
+
+    dataFile->m_MemoryData.resize(memoryDataList.size());
+    for (size_t i = 0; i < memoryDataList.size(); ++i)
+    {
+      MemoryData& memData = dataFile->m_MemoryData[i];
+      memData.inFile = true;
+      memData.fileOffset = memoryDataList[i].dataOffset;
+      memData.size = memoryDataList[i].dataSize;
+      memData.compressedSize = memoryDataList[i].compressedSize;
+    }
+  }
+
   // Read frames
   for (u32 i = 0; i < header.frameCount; ++i)
   {
@@ -251,16 +399,26 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
     dstFrame.fifoStart = srcFrame.fifoStart;
     dstFrame.fifoEnd = srcFrame.fifoEnd;
 
+    // FIFO data compression was added in version 5.
+    const u32 compressedSize =
+        dataFile->m_Version >= 5 ? srcFrame.fifoDataCompressedSize : srcFrame.fifoDataSize;
     file.Seek(srcFrame.fifoDataOffset, SEEK_SET);
-    file.ReadBytes(dstFrame.fifoData.data(), srcFrame.fifoDataSize);
-
-    ReadMemoryUpdates(srcFrame.memoryUpdatesOffset, srcFrame.numMemoryUpdates,
-                      dstFrame.memoryUpdates, file);
+    if (!ReadCompressed(dstFrame.fifoData.data(), srcFrame.fifoDataSize, compressedSize,
+                        dataFile->m_CompressedBuffer, file))
+    {
+      return nullptr;
+    }
+
+    if (!dataFile->ReadMemoryUpdates(srcFrame.memoryUpdatesOffset, srcFrame.numMemoryUpdates,
+                                     dstFrame.memoryUpdates, file))
+    {
+      return nullptr;
+    }
 
     dataFile->AddFrame(dstFrame);
   }
 
-  file.Close();
+  dataFile->m_LoadedFile = std::move(loadedFile);
 
   return dataFile;
 }
@@ -295,15 +453,10 @@ u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates
   {
     const MemoryUpdate& srcUpdate = memUpdates[i];
 
-    // Write memory
-    file.Seek(0, SEEK_END);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcUpdate.data.data(), srcUpdate.data.size());
-
     FileMemoryUpdate dstUpdate;
     dstUpdate.address = srcUpdate.address;
-    dstUpdate.dataOffset = dataOffset;
-    dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
+    dstUpdate.dataOffset = srcUpdate.dataIndex;
+    dstUpdate.dataSize = srcUpdate.dataSize;
     dstUpdate.fifoPosition = srcUpdate.fifoPosition;
     dstUpdate.type = srcUpdate.type;
 
@@ -312,10 +465,11 @@ u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates
     file.WriteBytes(&dstUpdate, sizeof(FileMemoryUpdate));
   }
 
+  file.Seek(0, SEEK_END);
   return updateListOffset;
 }
 
-void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
+bool FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
                                      std::vector<MemoryUpdate>& memUpdates, File::IOFile& file)
 {
   memUpdates.resize(numUpdates);
@@ -330,10 +484,30 @@ void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
     MemoryUpdate& dstUpdate = memUpdates[i];
     dstUpdate.address = srcUpdate.address;
     dstUpdate.fifoPosition = srcUpdate.fifoPosition;
-    dstUpdate.data.resize(srcUpdate.dataSize);
+    dstUpdate.dataSize = srcUpdate.dataSize;
     dstUpdate.type = static_cast<MemoryUpdate::Type>(srcUpdate.type);
 
-    file.Seek(srcUpdate.dataOffset, SEEK_SET);
-    file.ReadBytes(dstUpdate.data.data(), srcUpdate.dataSize);
+    if (m_Version >= 5)
+    {
+      if (srcUpdate.dataOffset >= m_MemoryData.size() ||
+          m_MemoryData[srcUpdate.dataOffset].size != srcUpdate.dataSize)
+      {
+        return false;
+      }
+      dstUpdate.dataIndex = static_cast<u32>(srcUpdate.dataOffset);
+    }
+    else
+    {
+      // Older versions store the data of each memory update separately and uncompressed
+      dstUpdate.dataIndex = static_cast<u32>(m_MemoryData.size());
+      MemoryData memData;
+      memData.inFile = true;
+      memData.fileOffset = srcUpdate.dataOffset;
+      memData.size = srcUpdate.dataSize;
+      memData.compressedSize = srcUpdate.dataSize;
+      m_MemoryData.push_back(std::move(memData));
+    }
   }
+
+  return true;
 }
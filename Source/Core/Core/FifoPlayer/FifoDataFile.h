@@ -5,7 +5,9 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -27,7 +29,9 @@ struct MemoryUpdate
 
   u32 fifoPosition;
   u32 address;
-  std::vector<u8> data;
+  u32 dataSize;
+  // The data is owned by the FifoDataFile, see FifoDataFile::AddMemoryData
+  u32 dataIndex;
   Type type;
 };
 
@@ -70,6 +74,14 @@ public:
   void AddFrame(const FifoFrameInfo& frameInfo);
   const FifoFrameInfo& GetFrame(u32 frame) const { return m_Frames[frame]; }
   u32 GetFrameCount() const { return static_cast<u32>(m_Frames.size()); }
+
+  // Memory update data is deduplicated by its contents, so all updates which write the same bytes
+  // share them. Returns the index to store in MemoryUpdate::dataIndex.
+  u32 AddMemoryData(const u8* data, u32 size);
+  // Copies the data of a memory update to dest. For loaded files, the data is only read from the
+  // file when it's needed, so recordings don't have to fit in RAM.
+  bool ReadMemoryData(const MemoryUpdate& update, u8* dest);
+
   bool Save(const std::string& filename);
 
   static std::unique_ptr<FifoDataFile> Load(const std::string& filename, bool flagsOnly);
@@ -80,14 +92,25 @@ private:
     FLAG_IS_WII = 1
   };
 
+  struct MemoryData
+  {
+    // Data added by AddMemoryData. Loaded data isn't kept in memory but read from m_LoadedFile.
+    std::vector<u8> data;
+    bool inFile = false;
+    u64 fileOffset = 0;
+    u32 size = 0;
+    u32 compressedSize = 0;
+  };
+
   void PadFile(size_t numBytes, File::IOFile& file);
 
   void SetFlag(u32 flag, bool set);
   bool GetFlag(u32 flag) const;
 
   u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
-  static void ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
-                                std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
+  bool ReadMemoryUpdates(u64 fileOffset, u32 numUpdates, std::vector<MemoryUpdate>& memUpdates,
+                         File::IOFile& file);
+  bool ReadMemoryData(const MemoryData& memData, u8* dest);
 
   u32 m_BPMem[BP_MEM_SIZE];
   u32 m_CPMem[CP_MEM_SIZE];
@@ -99,4 +122,11 @@ private:
   u32 m_Version = 0;
 
   std::vector<FifoFrameInfo> m_Frames;
+
+  // Accessed from both the video thread while recording and the CPU thread during playback
+  std::mutex m_MemoryDataMutex;
+  std::vector<MemoryData> m_MemoryData;
+  std::unordered_multimap<u64, u32> m_MemoryDataByHash;
+  std::unique_ptr<File::IOFile> m_LoadedFile;
+  std::vector<u8> m_CompressedBuffer;
 };
@@ -5,11 +5,17 @@
 #include "Core/FifoPlayer/FifoPlayer.h"
 
 #include <algorithm>
+#include <cinttypes>
+#include <fstream>
 #include <mutex>
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/StringUtil.h"
+#include "Common/Timer.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -24,8 +30,12 @@
 #include "Core/Host.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "VideoCommon/AsyncRequests.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/CommandProcessor.h"
+#include "VideoCommon/DataReader.h"
+#include "VideoCommon/Fifo.h"
+#include "VideoCommon/OpcodeDecoding.h"
 
 // We need to include TextureDecoder.h for the texMem array.
 // TODO: Move texMem somewhere else so this isn't an issue.
@@ -88,6 +98,11 @@ public:
 
     m_parent->m_CurrentFrame = m_parent->m_FrameRangeStart;
     m_parent->LoadMemory();
+
+    m_parent->m_benchmark_loop = 0;
+    m_parent->m_benchmark_frames.clear();
+    m_parent->m_benchmark_last_frame_end_us = Common::Timer::GetTimeUs();
+    m_parent->m_benchmark_last_totals = stats.GetTotals();
   }
 
   void Shutdown() override { IsPlayingBackFifologWithBrokenEFBCopies = false; }
@@ -134,8 +149,18 @@ CPU::State FifoPlayer::AdvanceFrame()
 {
   if (m_CurrentFrame >= m_FrameRangeEnd)
   {
-    if (!m_Loop)
+    if (m_benchmark_loops != 0)
+    {
+      if (++m_benchmark_loop >= m_benchmark_warmup_loops + m_benchmark_loops)
+      {
+        WriteBenchmarkResults();
+        return CPU::State::PowerDown;
+      }
+    }
+    else if (!m_Loop)
+    {
       return CPU::State::PowerDown;
+    }
     // If there are zero frames in the range then sleep instead of busy spinning
     if (m_FrameRangeStart >= m_FrameRangeEnd)
       return CPU::State::Stepping;
@@ -155,12 +180,82 @@ CPU::State FifoPlayer::AdvanceFrame()
   if (m_EarlyMemoryUpdates && m_CurrentFrame == m_FrameRangeStart)
     WriteAllMemoryUpdates();
 
-  WriteFrame(m_File->GetFrame(m_CurrentFrame), m_FrameInfo[m_CurrentFrame]);
+  const u64 start_time_us = Common::Timer::GetTimeUs();
+  if (m_DirectMode)
+    WriteFrameDirectly();
+  else
+    WriteFrame(m_File->GetFrame(m_CurrentFrame), m_FrameInfo[m_CurrentFrame]);
+  if (m_benchmark_loops != 0)
+    RecordBenchmarkFrame(start_time_us);
 
   ++m_CurrentFrame;
   return CPU::State::Running;
 }
 
+void FifoPlayer::SetBenchmark(u32 warmup_loops, u32 loops, const std::string& output_path)
+{
+  m_benchmark_warmup_loops = warmup_loops;
+  m_benchmark_loops = loops;
+  m_benchmark_output_path = output_path;
+}
+
+void FifoPlayer::RecordBenchmarkFrame(u64 start_time_us)
+{
+  // Waiting for the GPU thread gives each frame its own timing and statistics, at the cost of not
+  // letting the CPU and GPU threads overlap.
+  Fifo::SyncGPU(Fifo::SyncGPUReason::Other);
+
+  const u64 end_time_us = Common::Timer::GetTimeUs();
+  const Statistics::Totals totals = stats.GetTotals();
+  if (m_benchmark_loop >= m_benchmark_warmup_loops)
+  {
+    BenchmarkFrame frame;
+    frame.loop = m_benchmark_loop - m_benchmark_warmup_loops;
+    frame.frame = m_CurrentFrame;
+    frame.frame_time_us = end_time_us - m_benchmark_last_frame_end_us;
+    frame.submit_time_us = end_time_us - start_time_us;
+    frame.counts = totals.Since(m_benchmark_last_totals);
+    m_benchmark_frames.push_back(frame);
+  }
+  m_benchmark_last_frame_end_us = end_time_us;
+  m_benchmark_last_totals = totals;
+}
+
+void FifoPlayer::WriteBenchmarkResults() const
+{
+  std::ofstream file;
+  File::OpenFStream(file, m_benchmark_output_path, std::ios_base::out);
+  if (!file.is_open())
+  {
+    PanicAlertT("Failed to write the FIFO benchmark results to %s",
+                m_benchmark_output_path.c_str());
+    return;
+  }
+
+  file << "loop,frame,frame_time_us,submit_time_us,draw_calls,primitives,state_loads,"
+          "shader_changes,flushes,pipeline_changes,texture_uploads,texture_upload_bytes,"
+          "shader_compiles,efb_copies,efb_readbacks\n";
+  u64 total_time_us = 0;
+  for (const BenchmarkFrame& frame : m_benchmark_frames)
+  {
+    const Statistics::Totals& counts = frame.counts;
+    file << StringFromFormat("%u,%u,%" PRIu64 ",%" PRIu64, frame.loop, frame.frame,
+                             frame.frame_time_us, frame.submit_time_us);
+    for (u64 count : {counts.numDrawCalls, counts.numPrims, counts.numStateLoads,
+                      counts.numShaderChanges, counts.numFlushes, counts.numPipelineChanges,
+                      counts.numTextureUploads, counts.bytesTextureUploaded,
+                      counts.numShadersCompiled, counts.numEFBCopies, counts.numEFBReadbacks})
+    {
+      file << ',' << count;
+    }
+    file << '\n';
+    total_time_us += frame.frame_time_us;
+  }
+
+  NOTICE_LOG(VIDEO, "FIFO benchmark: %zu frames in %" PRIu64 " us, written to %s",
+             m_benchmark_frames.size(), total_time_us, m_benchmark_output_path.c_str());
+}
+
 std::unique_ptr<CPUCoreBase> FifoPlayer::GetCPUCore()
 {
   if (!m_File || m_File->GetFrameCount() == 0)
@@ -285,6 +380,9 @@ void FifoPlayer::WriteFrame(const FifoFrameInfo& frame, const AnalyzedFrameInfo&
   // Write data after the last object
   WriteFramePart(position, static_cast<u32>(frame.fifoData.size()), memoryUpdate, frame, info);
 
+  if (m_DirectMode)
+    return;
+
   FlushWGP();
 
   // Sleep while the GPU is active
@@ -295,6 +393,33 @@ void FifoPlayer::WriteFrame(const FifoFrameInfo& frame, const AnalyzedFrameInfo&
   }
 }
 
+void FifoPlayer::WriteFrameDirectly()
+{
+  // The registers which are loaded at the start of each loop still go through the FIFO, so they
+  // have to be processed before the frame.
+  while (!IsIdleSet())
+  {
+    CoreTiming::Idle();
+    CoreTiming::Advance();
+  }
+
+  AsyncRequests::Event e;
+  e.type = AsyncRequests::Event::FIFO_PLAYER_FRAME;
+  e.time = 0;
+  AsyncRequests::GetInstance()->PushEvent(e, true);
+
+  // The XFB copy of the frame is only output at the next VI field, so let a frame's worth of
+  // emulated time pass at once.
+  PowerPC::ppcState.downcount -=
+      static_cast<int>(SystemTimers::GetTicksPerSecond() / VideoInterface::GetTargetRefreshRate());
+  CoreTiming::Advance();
+}
+
+void FifoPlayer::DecodeFrame()
+{
+  WriteFrame(m_File->GetFrame(m_CurrentFrame), m_FrameInfo[m_CurrentFrame]);
+}
+
 void FifoPlayer::WriteFramePart(u32 dataStart, u32 dataEnd, u32& nextMemUpdate,
                                 const FifoFrameInfo& frame, const AnalyzedFrameInfo& info)
 {
@@ -350,11 +475,23 @@ void FifoPlayer::WriteMemory(const MemoryUpdate& memUpdate)
   else
     mem = &Memory::m_pRAM[memUpdate.address & Memory::RAM_MASK];
 
-  std::copy(memUpdate.data.begin(), memUpdate.data.end(), mem);
+  if (!m_File->ReadMemoryData(memUpdate, mem))
+  {
+    ERROR_LOG(VIDEO, "Failed to read the memory update at %08x from the FIFO log",
+              memUpdate.address);
+  }
 }
 
 void FifoPlayer::WriteFifo(const u8* data, u32 start, u32 end)
 {
+  if (m_DirectMode)
+  {
+    // Frames are split at command boundaries, so the decoder always consumes the whole range
+    OpcodeDecoder::Run(DataReader(const_cast<u8*>(data) + start, const_cast<u8*>(data) + end),
+                       nullptr, false);
+    return;
+  }
+
   u32 written = start;
   u32 lastBurstEnd = end - 1;
 
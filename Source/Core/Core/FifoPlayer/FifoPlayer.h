@@ -12,6 +12,7 @@
 #include "Core/FifoPlayer/FifoDataFile.h"
 #include "Core/FifoPlayer/FifoPlaybackAnalyzer.h"
 #include "Core/PowerPC/CPUCoreBase.h"
+#include "VideoCommon/Statistics.h"
 
 class FifoDataFile;
 struct MemoryUpdate;
@@ -92,6 +93,20 @@ public:
   // If enabled then all memory updates happen at once before the first frame
   // Default is disabled
   void SetEarlyMemoryUpdates(bool enabled) { m_EarlyMemoryUpdates = enabled; }
+  // Whether playback starts over at the end of the frame range rather than powering down
+  // Defaults to SConfig::bLoopFifoReplay
+  void SetLoop(bool loop) { m_Loop = loop; }
+  // Benchmark mode plays the frame range warmup_loops + loops times, waiting for the GPU thread
+  // after each frame, then writes the timings and statistics of each frame of the last loops to
+  // a CSV file at output_path and powers down. loops == 0 disables it.
+  void SetBenchmark(u32 warmup_loops, u32 loops, const std::string& output_path);
+  // Direct mode skips the emulated FIFO: the commands of each frame are decoded straight from the
+  // log on the GPU thread, along with its memory updates, rather than being written through the
+  // gather pipe while CoreTiming paces them. This keeps CPU emulation out of GPU measurements.
+  // Default is disabled
+  void SetDirectMode(bool enabled) { m_DirectMode = enabled; }
+  // Decodes the current frame in direct mode. Called on the GPU thread.
+  void DecodeFrame();
   // Callbacks
   void SetFileLoadedCallback(CallbackFunc callback) { m_FileLoadedCb = callback; }
   void SetFrameWrittenCallback(CallbackFunc callback) { m_FrameWrittenCb = callback; }
@@ -107,6 +122,7 @@ private:
   CPU::State AdvanceFrame();
 
   void WriteFrame(const FifoFrameInfo& frame, const AnalyzedFrameInfo& info);
+  void WriteFrameDirectly();
   void WriteFramePart(u32 dataStart, u32 dataEnd, u32& nextMemUpdate, const FifoFrameInfo& frame,
                       const AnalyzedFrameInfo& info);
 
@@ -138,8 +154,30 @@ private:
   static bool IsIdleSet();
   static bool IsHighWatermarkSet();
 
+  struct BenchmarkFrame
+  {
+    u32 loop;
+    u32 frame;
+    // Since the end of the previous frame
+    u64 frame_time_us;
+    // From the start of writing the frame to the FIFO until the GPU thread has processed it
+    u64 submit_time_us;
+    Statistics::Totals counts;
+  };
+
+  void RecordBenchmarkFrame(u64 start_time_us);
+  void WriteBenchmarkResults() const;
+
   bool m_Loop;
 
+  u32 m_benchmark_warmup_loops = 0;
+  u32 m_benchmark_loops = 0;
+  std::string m_benchmark_output_path;
+  u32 m_benchmark_loop = 0;
+  u64 m_benchmark_last_frame_end_us = 0;
+  Statistics::Totals m_benchmark_last_totals = {};
+  std::vector<BenchmarkFrame> m_benchmark_frames;
+
   u32 m_CurrentFrame = 0;
   u32 m_FrameRangeStart = 0;
   u32 m_FrameRangeEnd = 0;
@@ -148,6 +186,7 @@ private:
   u32 m_ObjectRangeEnd = 10000;
 
   bool m_EarlyMemoryUpdates = false;
+  bool m_DirectMode = false;
 
   u64 m_CyclesPerFrame = 0;
   u32 m_ElapsedCycles = 0;
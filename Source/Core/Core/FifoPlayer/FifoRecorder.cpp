@@ -140,8 +140,8 @@ void FifoRecorder::UseMemory(u32 address, u32 size, MemoryUpdate::Type type, boo
     memUpdate.address = address;
     memUpdate.fifoPosition = (u32)(m_FifoData.size());
     memUpdate.type = type;
-    memUpdate.data.resize(size);
-    std::copy(newData, newData + size, memUpdate.data.begin());
+    memUpdate.dataSize = size;
+    memUpdate.dataIndex = m_File->AddMemoryData(newData, size);
 
     m_CurrentFrame.memoryUpdates.push_back(std::move(memUpdate));
   }
@@ -192,6 +192,10 @@ u32 GetFunctionIndex(u32 address)
 u32 GetFirstFunctionIndex(u32 address)
 {
   u32 index = GetFunctionIndex(address);
+  // Most addresses aren't hooked, so avoid searching all of the hooks for them
+  if (index == 0)
+    return 0;
+
   auto first = std::find_if(
       s_original_instructions.begin(), s_original_instructions.end(),
       [=](const auto& entry) { return entry.second == index && entry.first < address; });
@@ -12,6 +12,7 @@
 #include "Common/Event.h"
 #include "Core/Core.h"
 #include "Core/Host.h"
+#include "Core/Movie.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "VideoCommon/Fifo.h"
 
@@ -147,7 +148,7 @@ static void RunAdjacentSystems(bool running)
 {
   // NOTE: We're assuming these will not try to call Break or EnableStepping.
   Fifo::EmulatorState(running);
-  AudioCommon::SetSoundStreamRunning(running);
+  AudioCommon::SetSoundStreamRunning(running && !Movie::IsVerifyingPlayback());
 }
 
 void Stop()
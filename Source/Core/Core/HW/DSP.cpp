@@ -24,6 +24,7 @@
 
 #include "Core/HW/DSP.h"
 
+#include <cstring>
 #include <memory>
 
 #include "AudioCommon/AudioCommon.h"
@@ -472,6 +473,21 @@ void UpdateAudioDMA()
   }
 }
 
+// The 8-byte accesses in Do_ARAM_DMA swap on both the read and the write, so the bytes land in
+// the same order they were in. A transfer that stays inside both memories can be done in one go.
+static bool IsBulkARAMDMAPossible()
+{
+  const u64 count = s_arDMA.Cnt.count;
+  return s_arDMA.ARAddr + count <= s_ARAM.size && s_arDMA.MMAddr + count <= Memory::REALRAM_SIZE;
+}
+
+static void AdvanceARAMDMA()
+{
+  s_arDMA.MMAddr += s_arDMA.Cnt.count;
+  s_arDMA.ARAddr += s_arDMA.Cnt.count;
+  s_arDMA.Cnt.count = 0;
+}
+
 static void Do_ARAM_DMA()
 {
   s_dspState.DMAState = 1;
@@ -493,6 +509,14 @@ static void Do_ARAM_DMA()
 
     if (s_arDMA.ARAddr < s_ARAM.size)
     {
+      // All mapping modes read ARAM the same way
+      if (IsBulkARAMDMAPossible())
+      {
+        std::memcpy(Memory::GetPointer(s_arDMA.MMAddr), &s_ARAM.ptr[s_arDMA.ARAddr],
+                    s_arDMA.Cnt.count);
+        AdvanceARAMDMA();
+      }
+
       while (s_arDMA.Cnt.count)
       {
         // These are logically separated in code to show that a memory map has been set up
@@ -519,6 +543,12 @@ static void Do_ARAM_DMA()
     {
       // Assuming no external ARAM installed; returns zeros on out of bounds reads (verified on real
       // HW)
+      if (s_arDMA.MMAddr + u64(s_arDMA.Cnt.count) <= Memory::REALRAM_SIZE)
+      {
+        std::memset(Memory::GetPointer(s_arDMA.MMAddr), 0, s_arDMA.Cnt.count);
+        AdvanceARAMDMA();
+      }
+
       while (s_arDMA.Cnt.count)
       {
         Memory::Write_U64(0, s_arDMA.MMAddr);
@@ -540,6 +570,14 @@ static void Do_ARAM_DMA()
 
     if (s_arDMA.ARAddr < s_ARAM.size)
     {
+      // Mode 4 mirrors the low 4 MiB, so it always goes through the loop below
+      if ((s_ARAM_Info.Hex & 0xf) != 4 && IsBulkARAMDMAPossible())
+      {
+        std::memcpy(&s_ARAM.ptr[s_arDMA.ARAddr], Memory::GetPointer(s_arDMA.MMAddr),
+                    s_arDMA.Cnt.count);
+        AdvanceARAMDMA();
+      }
+
       while (s_arDMA.Cnt.count)
       {
         if ((s_ARAM_Info.Hex & 0xf) == 3)
@@ -572,9 +610,7 @@ static void Do_ARAM_DMA()
     {
       // Assuming no external ARAM installed; writes nothing to ARAM when out of bounds (verified on
       // real HW)
-      s_arDMA.MMAddr += s_arDMA.Cnt.count;
-      s_arDMA.ARAddr += s_arDMA.Cnt.count;
-      s_arDMA.Cnt.count = 0;
+      AdvanceARAMDMA();
     }
   }
 }
@@ -11,6 +11,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
 #include "Common/Swap.h"
+#include "Core/ConfigManager.h"
 #include "Core/HW/DSP.h"
 #include "Core/HW/DSPHLE/DSPHLE.h"
 #include "Core/HW/DSPHLE/MailHandler.h"
@@ -26,6 +27,15 @@ namespace HLE
 AXUCode::AXUCode(DSPHLE* dsphle, u32 crc) : UCodeInterface(dsphle, crc), m_cmdlist_size(0)
 {
   INFO_LOG(DSPHLE, "Instantiating AXUCode: crc=%08x", crc);
+
+  const int num_voice_threads = MathUtil::Clamp(SConfig::GetInstance().m_DSPHLEVoiceThreads, 0, 8);
+  for (int i = 0; i < num_voice_threads; ++i)
+  {
+    m_voice_threads.push_back(std::make_unique<Common::WorkQueueThread<std::function<void()>>>(
+        [](std::function<void()> job) { job(); }));
+  }
+  m_voice_thread_samples.resize(num_voice_threads);
+  m_voice_thread_buffers.resize(num_voice_threads);
 }
 
 AXUCode::~AXUCode()
@@ -421,40 +431,112 @@ void AXUCode::DownloadAndMixWithVolume(u32 addr, u16 vol_main, u16 vol_auxa, u16
   }
 }
 
+void AXUCode::ProcessVoices(size_t num_voices, int* const* buffers, const u32* buffer_sizes,
+                            size_t num_buffers, const VoiceRangeFunction& process)
+{
+  // Below this many voices per thread, waking up the threads costs more than it saves.
+  constexpr size_t MIN_VOICES_PER_THREAD = 8;
+
+  const size_t num_jobs = std::min(m_voice_threads.size() + 1, num_voices / MIN_VOICES_PER_THREAD);
+  if (num_jobs <= 1)
+  {
+    process(0, num_voices, buffers);
+    return;
+  }
+
+  const size_t voices_per_job = (num_voices + num_jobs - 1) / num_jobs;
+  size_t total_size = 0;
+  for (size_t i = 0; i < num_buffers; ++i)
+    total_size += buffer_sizes[i];
+
+  m_voice_jobs_pending.store(num_jobs - 1);
+  for (size_t job = 1; job < num_jobs; ++job)
+  {
+    std::vector<int>& samples = m_voice_thread_samples[job - 1];
+    std::vector<int*>& job_buffers = m_voice_thread_buffers[job - 1];
+    samples.assign(total_size, 0);
+    job_buffers.resize(num_buffers);
+    for (size_t i = 0, offset = 0; i < num_buffers; offset += buffer_sizes[i++])
+      job_buffers[i] = samples.data() + offset;
+
+    const size_t first = job * voices_per_job;
+    const size_t last = std::min(first + voices_per_job, num_voices);
+    m_voice_threads[job - 1]->EmplaceItem([this, &process, &job_buffers, first, last] {
+      process(first, last, job_buffers.data());
+      if (m_voice_jobs_pending.fetch_sub(1) == 1)
+        m_voice_jobs_done.Set();
+    });
+  }
+
+  process(0, voices_per_job, buffers);
+  m_voice_jobs_done.Wait();
+
+  for (size_t job = 1; job < num_jobs; ++job)
+  {
+    const int* samples = m_voice_thread_samples[job - 1].data();
+    for (size_t i = 0; i < num_buffers; ++i)
+    {
+      int* buffer = buffers[i];
+      for (u32 j = 0; j < buffer_sizes[i]; ++j)
+        buffer[j] += samples[j];
+      samples += buffer_sizes[i];
+    }
+  }
+}
+
 void AXUCode::ProcessPBList(u32 pb_addr)
 {
   // Samples per millisecond. In theory DSP sampling rate can be changed from
   // 32KHz to 48KHz, but AX always process at 32KHz.
   const u32 spms = 32;
 
-  AXPB pb;
-
+  // Gather the whole list first so that the voices can be processed in parallel. Updates may
+  // overwrite next_pb, so they are replayed on a copy to find the next PB.
+  std::vector<std::pair<u32, AXPB>> pbs;
   while (pb_addr)
   {
-    AXBuffers buffers = {{m_samples_left, m_samples_right, m_samples_surround, m_samples_auxA_left,
-                          m_samples_auxA_right, m_samples_auxA_surround, m_samples_auxB_left,
-                          m_samples_auxB_right, m_samples_auxB_surround}};
-
+    AXPB pb;
     ReadPB(pb_addr, pb, m_crc);
+    pbs.emplace_back(pb_addr, pb);
 
-    u32 updates_addr = HILO_TO_32(pb.updates.data);
-    u16* updates = (u16*)HLEMemory_Get_Pointer(updates_addr);
-
+    u16* updates = (u16*)HLEMemory_Get_Pointer(HILO_TO_32(pb.updates.data));
     for (int curr_ms = 0; curr_ms < 5; ++curr_ms)
-    {
       ApplyUpdatesForMs(curr_ms, (u16*)&pb, pb.updates.num_updates, updates);
+    pb_addr = HILO_TO_32(pb.next_pb);
+  }
 
-      ProcessVoice(pb, buffers, spms, ConvertMixerControl(pb.mixer_control),
-                   m_coeffs_available ? m_coeffs : nullptr);
+  AXBuffers buffers = {{m_samples_left, m_samples_right, m_samples_surround, m_samples_auxA_left,
+                        m_samples_auxA_right, m_samples_auxA_surround, m_samples_auxB_left,
+                        m_samples_auxB_right, m_samples_auxB_surround}};
+  u32 buffer_sizes[ArraySize(buffers.ptrs)];
+  std::fill(std::begin(buffer_sizes), std::end(buffer_sizes), static_cast<u32>(spms * 5));
 
-      // Forward the buffers
-      for (size_t i = 0; i < ArraySize(buffers.ptrs); ++i)
-        buffers.ptrs[i] += spms;
-    }
+  const auto process = [&](size_t first, size_t last, int* const* ptrs) {
+    for (size_t i = first; i < last; ++i)
+    {
+      AXPB& pb = pbs[i].second;
+      AXBuffers voice_buffers;
+      std::copy(ptrs, ptrs + ArraySize(voice_buffers.ptrs), voice_buffers.ptrs);
 
-    WritePB(pb_addr, pb, m_crc);
-    pb_addr = HILO_TO_32(pb.next_pb);
-  }
+      u32 updates_addr = HILO_TO_32(pb.updates.data);
+      u16* updates = (u16*)HLEMemory_Get_Pointer(updates_addr);
+
+      for (int curr_ms = 0; curr_ms < 5; ++curr_ms)
+      {
+        ApplyUpdatesForMs(curr_ms, (u16*)&pb, pb.updates.num_updates, updates);
+
+        ProcessVoice(pb, voice_buffers, spms, ConvertMixerControl(pb.mixer_control),
+                     m_coeffs_available ? m_coeffs : nullptr);
+
+        // Forward the buffers
+        for (size_t j = 0; j < ArraySize(voice_buffers.ptrs); ++j)
+          voice_buffers.ptrs[j] += spms;
+      }
+
+      WritePB(pbs[i].first, pb, m_crc);
+    }
+  };
+  ProcessVoices(pbs.size(), buffers.ptrs, buffer_sizes, ArraySize(buffers.ptrs), process);
 }
 
 void AXUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr)
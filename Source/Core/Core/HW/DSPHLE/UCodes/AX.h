@@ -12,7 +12,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
 #include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
 
 namespace DSP
@@ -130,6 +137,16 @@ protected:
   // Handle save states for main AX.
   void DoAXState(PointerWrap& p);
 
+  // Called with a range of voices and the buffers to mix them into.
+  using VoiceRangeFunction = std::function<void(size_t first, size_t last, int* const* buffers)>;
+
+  // Splits the voices [0, num_voices) into contiguous ranges and runs process on each of them,
+  // on the voice threads if there are any. All ranges but the first mix into zeroed per-thread
+  // copies of buffers, which are then added to the real buffers. Mixing only ever adds integers,
+  // so the result is the same no matter how the voices were split.
+  void ProcessVoices(size_t num_voices, int* const* buffers, const u32* buffer_sizes,
+                     size_t num_buffers, const VoiceRangeFunction& process);
+
 private:
   enum CmdType
   {
@@ -154,6 +171,13 @@ private:
     CMD_UNK_12 = 0x12,
     CMD_SEND_AUX_AND_MIX = 0x13,
   };
+
+  // Worker threads for ProcessVoices, and the buffers each of them mixes into.
+  std::vector<std::unique_ptr<Common::WorkQueueThread<std::function<void()>>>> m_voice_threads;
+  std::vector<std::vector<int>> m_voice_thread_samples;
+  std::vector<std::vector<int*>> m_voice_thread_buffers;
+  std::atomic<size_t> m_voice_jobs_pending{0};
+  Common::Event m_voice_jobs_done;
 };
 }  // namespace HLE
 }  // namespace DSP
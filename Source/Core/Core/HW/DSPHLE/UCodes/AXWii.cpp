@@ -439,6 +439,13 @@ void AXWiiUCode::ReinjectUpdatesFields(AXPBWii& pb, u16* num_updates, u32 update
 
 void AXWiiUCode::ProcessPBList(u32 pb_addr)
 {
+  // Old versions with updates process voices one ms at a time, which is not worth splitting up.
+  if (!m_old_axwii)
+  {
+    ProcessPBListInParallel(pb_addr);
+    return;
+  }
+
   AXPBWii pb;
 
   while (pb_addr)
@@ -481,6 +488,42 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
   }
 }
 
+void AXWiiUCode::ProcessPBListInParallel(u32 pb_addr)
+{
+  std::vector<std::pair<u32, AXPBWii>> pbs;
+  while (pb_addr)
+  {
+    AXPBWii pb;
+    ReadPB(pb_addr, pb, m_crc);
+    pbs.emplace_back(pb_addr, pb);
+    pb_addr = HILO_TO_32(pb.next_pb);
+  }
+
+  AXBuffers buffers = {{m_samples_left,      m_samples_right,      m_samples_surround,
+                        m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
+                        m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround,
+                        m_samples_auxC_left, m_samples_auxC_right, m_samples_auxC_surround,
+                        m_samples_wm0,       m_samples_aux0,       m_samples_wm1,
+                        m_samples_aux1,      m_samples_wm2,        m_samples_aux2,
+                        m_samples_wm3,       m_samples_aux3}};
+  const u32 buffer_sizes[ArraySize(buffers.ptrs)] = {96, 96, 96, 96, 96, 96, 96, 96, 96, 96,
+                                                     96, 96, 18, 18, 18, 18, 18, 18, 18, 18};
+
+  const auto process = [&](size_t first, size_t last, int* const* ptrs) {
+    AXBuffers voice_buffers;
+    std::copy(ptrs, ptrs + ArraySize(voice_buffers.ptrs), voice_buffers.ptrs);
+
+    for (size_t i = first; i < last; ++i)
+    {
+      AXPBWii& pb = pbs[i].second;
+      ProcessVoice(pb, voice_buffers, 96, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
+                   m_coeffs_available ? m_coeffs : nullptr);
+      WritePB(pbs[i].first, pb, m_crc);
+    }
+  };
+  ProcessVoices(pbs.size(), buffers.ptrs, buffer_sizes, ArraySize(buffers.ptrs), process);
+}
+
 void AXWiiUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr, u16 volume)
 {
   u16 volume_ramp[96];
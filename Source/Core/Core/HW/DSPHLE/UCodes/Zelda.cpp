@@ -1079,8 +1079,29 @@ void ZeldaAudioRenderer::ApplyReverb(bool post_rendering)
         (*last8_samples_buffers[rpb_idx])[i] = buffer[0x50 + i];
 
       auto ApplyFilter = [&]() {
-        // Filter the buffer using provided coefficients.
-        for (u16 i = 0; i < 0x50; ++i)
+        // Filter the buffer using provided coefficients. Each output only depends on the
+        // samples at and after its own position, so 8 outputs can be computed at once in place.
+        u16 i = 0;
+#if defined(_M_X86) || defined(_M_X86_64)
+        for (; i < 0x50; i += 8)
+        {
+          __m128i sum_lo = _mm_setzero_si128();
+          __m128i sum_hi = _mm_setzero_si128();
+          for (u16 j = 0; j < 8; ++j)
+          {
+            const __m128i coeff = _mm_set1_epi16(rpb.filter_coeffs[j]);
+            const __m128i samples =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(&buffer[i + j]));
+            const __m128i prod_lo = _mm_mullo_epi16(samples, coeff);
+            const __m128i prod_hi = _mm_mulhi_epi16(samples, coeff);
+            sum_lo = _mm_add_epi32(sum_lo, _mm_unpacklo_epi16(prod_lo, prod_hi));
+            sum_hi = _mm_add_epi32(sum_hi, _mm_unpackhi_epi16(prod_lo, prod_hi));
+          }
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(&buffer[i]),
+                           _mm_packs_epi32(_mm_srai_epi32(sum_lo, 15), _mm_srai_epi32(sum_hi, 15)));
+        }
+#endif
+        for (; i < 0x50; ++i)
         {
           s32 sample = 0;
           for (u16 j = 0; j < 8; ++j)
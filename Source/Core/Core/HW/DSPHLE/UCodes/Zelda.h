@@ -6,6 +6,10 @@
 
 #include <array>
 
+#if defined(_M_X86) || defined(_M_X86_64)
+#include <emmintrin.h>
+#endif
+
 #include "Common/CommonTypes.h"
 #include "Common/MathUtil.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
@@ -44,12 +48,38 @@ private:
 
   // Utility functions for audio operations.
 
+#if defined(_M_X86) || defined(_M_X86_64)
+  // Multiplies 8 signed samples by 8 unsigned volumes, returning the 32-bit products of the low
+  // and high 4 lanes. The volumes are multiplied as signed values, and the high halves are then
+  // corrected by adding the sample wherever a volume has its top bit set.
+  static void MultiplyByVolume(__m128i samples, __m128i volumes, __m128i* lo, __m128i* hi)
+  {
+    const __m128i prod_lo = _mm_mullo_epi16(samples, volumes);
+    const __m128i prod_hi = _mm_add_epi16(_mm_mulhi_epi16(samples, volumes),
+                                          _mm_and_si128(samples, _mm_srai_epi16(volumes, 15)));
+    *lo = _mm_unpacklo_epi16(prod_lo, prod_hi);
+    *hi = _mm_unpackhi_epi16(prod_lo, prod_hi);
+  }
+#endif
+
   // Apply volume to a buffer. The volume is a fixed point integer, usually
   // 1.15 or 4.12 in the DAC UCode.
   template <size_t N, size_t B>
   void ApplyVolumeInPlace(std::array<s16, N>* buf, u16 vol)
   {
-    for (size_t i = 0; i < N; ++i)
+    size_t i = 0;
+#if defined(_M_X86) || defined(_M_X86_64)
+    const __m128i volumes = _mm_set1_epi16(static_cast<s16>(vol));
+    for (; i + 8 <= N; i += 8)
+    {
+      __m128i* ptr = reinterpret_cast<__m128i*>(buf->data() + i);
+      __m128i lo, hi;
+      MultiplyByVolume(_mm_loadu_si128(ptr), volumes, &lo, &hi);
+      _mm_storeu_si128(ptr,
+                       _mm_packs_epi32(_mm_srai_epi32(lo, 16 - B), _mm_srai_epi32(hi, 16 - B)));
+    }
+#endif
+    for (; i < N; ++i)
     {
       s32 tmp = (u32)(*buf)[i] * (u32)vol;
       tmp >>= 16 - B;
@@ -80,7 +110,27 @@ private:
     if (!vol && !step)
       return vol;
 
-    for (size_t i = 0; i < N; ++i)
+    size_t i = 0;
+#if defined(_M_X86) || defined(_M_X86_64)
+    // vol >> 16 always fits in 16 bits, which makes the product a signed high multiply.
+    const u32 ustep = static_cast<u32>(step);
+    const __m128i step8 = _mm_set1_epi32(static_cast<s32>(ustep * 8));
+    __m128i vol_lo =
+        _mm_add_epi32(_mm_set1_epi32(vol), _mm_setr_epi32(0, ustep, ustep * 2, ustep * 3));
+    __m128i vol_hi = _mm_add_epi32(vol_lo, _mm_set1_epi32(static_cast<s32>(ustep * 4)));
+    for (; i + 8 <= N; i += 8)
+    {
+      const __m128i volumes =
+          _mm_packs_epi32(_mm_srai_epi32(vol_lo, 16), _mm_srai_epi32(vol_hi, 16));
+      const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src.data() + i));
+      __m128i* ptr = reinterpret_cast<__m128i*>(dst->data() + i);
+      _mm_storeu_si128(ptr, _mm_add_epi16(_mm_loadu_si128(ptr), _mm_mulhi_epi16(volumes, samples)));
+      vol_lo = _mm_add_epi32(vol_lo, step8);
+      vol_hi = _mm_add_epi32(vol_hi, step8);
+    }
+    vol = static_cast<s32>(static_cast<u32>(vol) + ustep * static_cast<u32>(i));
+#endif
+    for (; i < N; ++i)
     {
       (*dst)[i] += ((vol >> 16) * src[i]) >> 16;
       vol += step;
@@ -93,6 +143,17 @@ private:
   // buffers. Volume is in 1.15 format.
   void AddBuffersWithVolume(s16* dst, const s16* src, size_t count, u16 vol)
   {
+#if defined(_M_X86) || defined(_M_X86_64)
+    const __m128i volumes = _mm_set1_epi16(static_cast<s16>(vol));
+    for (; count >= 8; count -= 8, src += 8, dst += 8)
+    {
+      __m128i lo, hi;
+      MultiplyByVolume(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)), volumes, &lo, &hi);
+      const __m128i scaled = _mm_packs_epi32(_mm_srai_epi32(lo, 15), _mm_srai_epi32(hi, 15));
+      __m128i* ptr = reinterpret_cast<__m128i*>(dst);
+      _mm_storeu_si128(ptr, _mm_add_epi16(_mm_loadu_si128(ptr), scaled));
+    }
+#endif
     while (count--)
     {
       s32 vol_src = ((s32)*src++ * (s32)vol) >> 15;
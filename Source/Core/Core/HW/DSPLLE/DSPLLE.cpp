@@ -36,6 +36,9 @@ static Common::Event s_dsp_event;
 static Common::Event s_ppc_event;
 static bool s_request_disable_thread;
 
+// How many DSP_Update() slices the DSP thread may lag behind the CPU thread.
+static constexpr u32 MAX_THREAD_SKEW_SLICES = 2;
+
 DSPLLE::DSPLLE() = default;
 
 DSPLLE::~DSPLLE()
@@ -95,23 +98,26 @@ void DSPLLE::DSPThread(DSPLLE* dsp_lle)
 
   while (dsp_lle->m_is_running.IsSet())
   {
-    const int cycles = static_cast<int>(dsp_lle->m_cycle_count.load());
+    const u32 cycles = dsp_lle->m_cycle_count.load();
     if (cycles > 0)
     {
-      std::lock_guard<std::mutex> dsp_thread_lock(dsp_lle->m_dsp_thread_mutex);
-      if (g_dsp_jit)
-      {
-        DSPCore_RunCycles(cycles);
-      }
-      else
       {
-        DSP::Interpreter::RunCyclesThread(cycles);
+        std::lock_guard<std::mutex> dsp_thread_lock(dsp_lle->m_dsp_thread_mutex);
+        if (g_dsp_jit)
+        {
+          DSPCore_RunCycles(static_cast<int>(cycles));
+        }
+        else
+        {
+          DSP::Interpreter::RunCyclesThread(static_cast<int>(cycles));
+        }
+        // The CPU thread may have handed out more cycles in the meantime, only consume ours.
+        dsp_lle->m_cycle_count.fetch_sub(cycles);
       }
-      dsp_lle->m_cycle_count.store(0);
+      s_ppc_event.Set();
     }
     else
     {
-      s_ppc_event.Set();
       s_dsp_event.Wait();
     }
   }
@@ -305,6 +311,8 @@ void DSPLLE::DSP_Update(int cycles)
     if (s_request_disable_thread || Core::WantsDeterminism())
     {
       DSP_StopSoundStream();
+      // Run whatever the thread had not gotten to yet on this thread instead.
+      dsp_cycles += static_cast<int>(m_cycle_count.exchange(0));
       m_is_dsp_on_thread = false;
       s_request_disable_thread = false;
       SConfig::GetInstance().bDSPThread = false;
@@ -319,10 +327,14 @@ void DSPLLE::DSP_Update(int cycles)
   }
   else
   {
-    // Wait for DSP thread to complete its cycle. Note: this logic should be thought through.
-    s_ppc_event.Wait();
+    // Hand the cycles to the DSP thread and only wait for it once it has fallen more than
+    // MAX_THREAD_SKEW_SLICES updates behind, so both sides can run in parallel.
     m_cycle_count.fetch_add(dsp_cycles);
     s_dsp_event.Set();
+
+    const u32 max_skew = MAX_THREAD_SKEW_SLICES * DSP_UpdateRate() / 6;
+    while (m_cycle_count.load() > max_skew && m_is_running.IsSet())
+      s_ppc_event.Wait();
   }
 }
 
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <cinttypes>
+#include <cstring>
 #include <memory>
 #include <optional>
 #include <string>
@@ -207,8 +208,6 @@ static UDICR s_DICR;
 static UDIIMMBUF s_DIIMMBUF;
 static UDICFG s_DICFG;
 
-static StreamADPCM::ADPCMDecoder s_adpcm_decoder;
-
 // DTK
 static bool s_stream = false;
 static bool s_stop_at_track_end = false;
@@ -218,6 +217,8 @@ static u32 s_current_length;
 static u64 s_next_start;
 static u32 s_next_length;
 static u32 s_pending_samples;
+// The ADPCM filter is reset by the DVD thread when it decodes the next DTK read
+static bool s_reset_dtk_filter;
 
 // Disc drive state
 static u32 s_error_code = 0;
@@ -275,6 +276,7 @@ void DoState(PointerWrap& p)
   p.Do(s_next_start);
   p.Do(s_next_length);
   p.Do(s_pending_samples);
+  p.Do(s_reset_dtk_filter);
 
   p.Do(s_error_code);
   p.Do(s_current_partition);
@@ -287,27 +289,6 @@ void DoState(PointerWrap& p)
   p.Do(s_disc_path_to_insert);
 
   DVDThread::DoState(p);
-
-  s_adpcm_decoder.DoState(p);
-}
-
-static size_t ProcessDTKSamples(std::vector<s16>* temp_pcm, const std::vector<u8>& audio_data)
-{
-  size_t samples_processed = 0;
-  size_t bytes_processed = 0;
-  while (samples_processed < temp_pcm->size() / 2 && bytes_processed < audio_data.size())
-  {
-    s_adpcm_decoder.DecodeBlock(&(*temp_pcm)[samples_processed * 2], &audio_data[bytes_processed]);
-    for (size_t i = 0; i < StreamADPCM::SAMPLES_PER_BLOCK * 2; ++i)
-    {
-      // TODO: Fix the mixer so it can accept non-byte-swapped samples.
-      s16* sample = &(*temp_pcm)[samples_processed * 2 + i];
-      *sample = Common::swap16(*sample);
-    }
-    samples_processed += StreamADPCM::SAMPLES_PER_BLOCK;
-    bytes_processed += StreamADPCM::ONE_BLOCK_SIZE;
-  }
-  return samples_processed;
 }
 
 static u32 AdvanceDTK(u32 maximum_samples, u32* samples_to_process)
@@ -334,7 +315,7 @@ static u32 AdvanceDTK(u32 maximum_samples, u32* samples_to_process)
         break;
       }
 
-      s_adpcm_decoder.ResetFilter();
+      s_reset_dtk_filter = true;
     }
 
     s_audio_position += StreamADPCM::ONE_BLOCK_SIZE;
@@ -345,11 +326,12 @@ static u32 AdvanceDTK(u32 maximum_samples, u32* samples_to_process)
   return bytes_to_process;
 }
 
-static void DTKStreamingCallback(const std::vector<u8>& audio_data, s64 cycles_late)
+static void DTKStreamingCallback(const std::vector<u8>& pcm_data, s64 cycles_late)
 {
-  // Send audio to the mixer.
+  // Send audio to the mixer. The DVD thread has already decoded it.
   std::vector<s16> temp_pcm(s_pending_samples * 2, 0);
-  ProcessDTKSamples(&temp_pcm, audio_data);
+  std::memcpy(temp_pcm.data(), pcm_data.data(),
+              std::min(temp_pcm.size() * sizeof(s16), pcm_data.size()));
   g_sound_stream->GetMixer()->PushStreamingSamples(temp_pcm.data(), s_pending_samples);
 
   // Determine which audio data to read next.
@@ -372,8 +354,8 @@ static void DTKStreamingCallback(const std::vector<u8>& audio_data, s64 cycles_l
   ticks_to_dtk -= cycles_late;
   if (read_length > 0)
   {
-    DVDThread::StartRead(read_offset, read_length, DiscIO::PARTITION_NONE, ReplyType::DTK,
-                         ticks_to_dtk);
+    DVDThread::StartReadDTK(read_offset, read_length, s_reset_dtk_filter, ticks_to_dtk);
+    s_reset_dtk_filter = false;
   }
   else
   {
@@ -424,6 +406,7 @@ void Reset()
   s_current_start = 0;
   s_current_length = 0;
   s_pending_samples = 0;
+  s_reset_dtk_filter = false;
 
   s_error_code = 0;
 
@@ -933,7 +916,7 @@ void ExecuteCommand(u32 command_0, u32 command_1, u32 command_2, u32 output_addr
           s_current_start = s_next_start;
           s_current_length = s_next_length;
           s_audio_position = s_current_start;
-          s_adpcm_decoder.ResetFilter();
+          s_reset_dtk_filter = true;
           s_stream = true;
         }
       }
@@ -4,7 +4,9 @@
 
 #include "Core/HW/DVD/DVDThread.h"
 
+#include <array>
 #include <cinttypes>
+#include <cstring>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -20,6 +22,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/SPSCQueue.h"
+#include "Common/Swap.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
 
@@ -29,6 +32,7 @@
 #include "Core/HW/DVD/DVDInterface.h"
 #include "Core/HW/DVD/FileMonitor.h"
 #include "Core/HW/Memmap.h"
+#include "Core/HW/StreamADPCM.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/IOS/ES/Formats.h"
 
@@ -50,6 +54,9 @@ struct ReadRequest
   // because function pointers can't be stored in savestates.
   DVDInterface::ReplyType reply_type;
 
+  // Only used for DTK reads. Decoding starts from a fresh ADPCM filter state.
+  bool reset_dtk_filter;
+
   // IDs are used to uniquely identify a request. They must not be
   // identical to IDs of any other requests that currently exist, but
   // it's fine to re-use IDs of requests that have existed in the past.
@@ -71,7 +78,15 @@ static void WaitUntilIdle();
 
 static void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offset, u32 length,
                               const DiscIO::Partition& partition,
-                              DVDInterface::ReplyType reply_type, s64 ticks_until_completion);
+                              DVDInterface::ReplyType reply_type, bool reset_dtk_filter,
+                              s64 ticks_until_completion);
+
+static std::vector<u8> DecodeDTK(const std::vector<u8>& audio_data, bool reset_filter);
+
+static void ResetPrefetch();
+static bool ReadFromPrefetchBuffer(const ReadRequest& request, u8* out_ptr);
+static void UpdateStreamDetection(const ReadRequest& request);
+static void Prefetch();
 
 static void FinishRead(u64 id, s64 cycles_late);
 static CoreTiming::EventType* s_finish_read;
@@ -89,6 +104,26 @@ static std::map<u64, ReadResult> s_result_map;
 
 static std::unique_ptr<DiscIO::Volume> s_disc;
 
+// Only touched by the DVD thread while it is running. Requests are handled in the order they
+// were made, so the filter state doesn't depend on host timing.
+static StreamADPCM::ADPCMDecoder s_adpcm_decoder;
+
+// When the game streams data, the DVD thread uses the time it would otherwise spend idle to read
+// ahead into a bounded buffer, which hides the latency of slow host storage such as network
+// shares. This doesn't affect emulated timing, as DVDInterface has already scheduled when each
+// read completes. Only touched by the DVD thread while it is running.
+static constexpr u64 PREFETCH_STEP_SIZE = 0x40000;
+static constexpr u64 PREFETCH_MAX_SIZE = 0x400000;
+// A stream is assumed once this many reads in a row have each started where the previous ended.
+static constexpr u32 PREFETCH_MIN_SEQUENTIAL_READS = 2;
+
+static DiscIO::Partition s_prefetch_partition;
+static u64 s_prefetch_offset;
+static std::vector<u8> s_prefetch_buffer;
+static DiscIO::Partition s_last_read_partition;
+static u64 s_last_read_end;
+static u32 s_sequential_reads;
+
 void Start()
 {
   s_finish_read = CoreTiming::RegisterEvent("FinishReadDVDThread", FinishRead);
@@ -102,6 +137,9 @@ void Start()
   // much, because this will never get exposed to the emulated game.
   s_next_id = 0;
 
+  s_adpcm_decoder.ResetFilter();
+  ResetPrefetch();
+
   StartDVDThread();
 }
 
@@ -148,6 +186,7 @@ void DoState(PointerWrap& p)
   // Both queues are now empty, so we don't need to savestate them.
   p.Do(s_result_map);
   p.Do(s_next_id);
+  s_adpcm_decoder.DoState(p);
 
   // s_disc isn't savestated (because it points to files on the
   // local system). Instead, we check that the status of the disc
@@ -179,6 +218,7 @@ void SetDisc(std::unique_ptr<DiscIO::Volume> disc)
 {
   WaitUntilIdle();
   s_disc = std::move(disc);
+  ResetPrefetch();
 }
 
 bool HasDisc()
@@ -248,20 +288,33 @@ void WaitUntilIdle()
 void StartRead(u64 dvd_offset, u32 length, const DiscIO::Partition& partition,
                DVDInterface::ReplyType reply_type, s64 ticks_until_completion)
 {
-  StartReadInternal(false, 0, dvd_offset, length, partition, reply_type, ticks_until_completion);
+  StartReadInternal(false, 0, dvd_offset, length, partition, reply_type, false,
+                    ticks_until_completion);
 }
 
 void StartReadToEmulatedRAM(u32 output_address, u64 dvd_offset, u32 length,
                             const DiscIO::Partition& partition, DVDInterface::ReplyType reply_type,
                             s64 ticks_until_completion)
 {
-  StartReadInternal(true, output_address, dvd_offset, length, partition, reply_type,
+  StartReadInternal(true, output_address, dvd_offset, length, partition, reply_type, false,
                     ticks_until_completion);
 }
 
+void StartReadDTK(u64 dvd_offset, u32 length, bool reset_filter, s64 ticks_until_completion)
+{
+  StartReadInternal(false, 0, dvd_offset, length, DiscIO::PARTITION_NONE,
+                    DVDInterface::ReplyType::DTK, reset_filter, ticks_until_completion);
+}
+
+u32 GetDecodedDTKSize(u32 length)
+{
+  return length / StreamADPCM::ONE_BLOCK_SIZE * StreamADPCM::SAMPLES_PER_BLOCK * 2 * sizeof(s16);
+}
+
 static void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offset, u32 length,
                               const DiscIO::Partition& partition,
-                              DVDInterface::ReplyType reply_type, s64 ticks_until_completion)
+                              DVDInterface::ReplyType reply_type, bool reset_dtk_filter,
+                              s64 ticks_until_completion)
 {
   ASSERT(Core::IsCPUThread());
 
@@ -273,6 +326,7 @@ static void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offs
   request.length = length;
   request.partition = partition;
   request.reply_type = reply_type;
+  request.reset_dtk_filter = reset_dtk_filter;
 
   u64 id = s_next_id++;
   request.id = id;
@@ -332,7 +386,8 @@ static void FinishRead(u64 id, s64 cycles_late)
             (CoreTiming::GetTicks() - request.time_started_ticks) /
                 (SystemTimers::GetTicksPerSecond() / 1000000));
 
-  if (buffer.size() != request.length)
+  const bool is_dtk = request.reply_type == DVDInterface::ReplyType::DTK;
+  if (buffer.size() != (is_dtk ? GetDecodedDTKSize(request.length) : request.length))
   {
     PanicAlertT("The disc could not be read (at 0x%" PRIx64 " - 0x%" PRIx64 ").",
                 request.dvd_offset, request.dvd_offset + request.length);
@@ -348,6 +403,103 @@ static void FinishRead(u64 id, s64 cycles_late)
                                        buffer);
 }
 
+static std::vector<u8> DecodeDTK(const std::vector<u8>& audio_data, bool reset_filter)
+{
+  if (reset_filter)
+    s_adpcm_decoder.ResetFilter();
+
+  const size_t blocks = audio_data.size() / StreamADPCM::ONE_BLOCK_SIZE;
+  std::vector<u8> pcm(GetDecodedDTKSize(static_cast<u32>(audio_data.size())));
+  for (size_t i = 0; i < blocks; ++i)
+  {
+    std::array<s16, StreamADPCM::SAMPLES_PER_BLOCK * 2> block_pcm;
+    s_adpcm_decoder.DecodeBlock(block_pcm.data(), &audio_data[i * StreamADPCM::ONE_BLOCK_SIZE]);
+
+    // TODO: Fix the mixer so it can accept non-byte-swapped samples.
+    for (s16& sample : block_pcm)
+      sample = Common::swap16(sample);
+
+    std::memcpy(&pcm[i * sizeof(block_pcm)], block_pcm.data(), sizeof(block_pcm));
+  }
+  return pcm;
+}
+
+static void ResetPrefetch()
+{
+  s_prefetch_partition = DiscIO::PARTITION_NONE;
+  s_prefetch_offset = 0;
+  s_prefetch_buffer.clear();
+  s_last_read_partition = DiscIO::PARTITION_NONE;
+  s_last_read_end = 0;
+  s_sequential_reads = 0;
+}
+
+static bool ReadFromPrefetchBuffer(const ReadRequest& request, u8* out_ptr)
+{
+  if (request.partition != s_prefetch_partition || request.dvd_offset < s_prefetch_offset ||
+      request.dvd_offset + request.length > s_prefetch_offset + s_prefetch_buffer.size())
+  {
+    return false;
+  }
+
+  std::memcpy(out_ptr, &s_prefetch_buffer[request.dvd_offset - s_prefetch_offset],
+              request.length);
+  return true;
+}
+
+static void UpdateStreamDetection(const ReadRequest& request)
+{
+  // Audio streaming is interleaved with regular reads, so it's left out to not break up streams.
+  if (request.reply_type == DVDInterface::ReplyType::DTK)
+    return;
+
+  if (request.partition == s_last_read_partition && request.dvd_offset == s_last_read_end)
+    ++s_sequential_reads;
+  else
+    s_sequential_reads = 0;
+
+  s_last_read_partition = request.partition;
+  s_last_read_end = request.dvd_offset + request.length;
+}
+
+static void Prefetch()
+{
+  // Reads are done in small steps so that a new request never waits long behind a prefetch.
+  while (s_sequential_reads >= PREFETCH_MIN_SEQUENTIAL_READS && s_request_queue.Empty() &&
+         !s_dvd_thread_exiting.IsSet())
+  {
+    const u64 buffer_end = s_prefetch_offset + s_prefetch_buffer.size();
+    if (s_prefetch_partition != s_last_read_partition || s_last_read_end < s_prefetch_offset ||
+        s_last_read_end > buffer_end)
+    {
+      s_prefetch_partition = s_last_read_partition;
+      s_prefetch_offset = s_last_read_end;
+      s_prefetch_buffer.clear();
+    }
+    else if (s_last_read_end > s_prefetch_offset)
+    {
+      // Data the stream has moved past won't be needed again.
+      s_prefetch_buffer.erase(s_prefetch_buffer.begin(),
+                              s_prefetch_buffer.begin() + (s_last_read_end - s_prefetch_offset));
+      s_prefetch_offset = s_last_read_end;
+    }
+
+    const size_t old_size = s_prefetch_buffer.size();
+    if (old_size >= PREFETCH_MAX_SIZE)
+      return;
+
+    s_prefetch_buffer.resize(old_size + PREFETCH_STEP_SIZE);
+    if (!s_disc->Read(s_prefetch_offset + old_size, PREFETCH_STEP_SIZE,
+                      &s_prefetch_buffer[old_size], s_prefetch_partition))
+    {
+      // Most likely the end of the disc or partition. Stop until a new stream is detected.
+      s_prefetch_buffer.resize(old_size);
+      s_sequential_reads = 0;
+      return;
+    }
+  }
+}
+
 static void DVDThread()
 {
   Common::SetCurrentThreadName("DVD thread");
@@ -365,8 +517,17 @@ static void DVDThread()
       FileMonitor::Log(*s_disc, request.partition, request.dvd_offset);
 
       std::vector<u8> buffer(request.length);
-      if (!s_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
+      if (!ReadFromPrefetchBuffer(request, buffer.data()) &&
+          !s_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
+      {
         buffer.resize(0);
+      }
+      UpdateStreamDetection(request);
+
+      // Decoding here keeps the CPU thread from having to do it when the read finishes.
+      // Failed reads still apply the filter reset so that later chunks decode the same way.
+      if (request.reply_type == DVDInterface::ReplyType::DTK)
+        buffer = DecodeDTK(buffer, request.reset_dtk_filter);
 
       request.realtime_done_us = Common::Timer::GetTimeUs();
 
@@ -376,6 +537,8 @@ static void DVDThread()
       if (s_dvd_thread_exiting.IsSet())
         return;
     }
+
+    Prefetch();
   }
 }
 }
@@ -59,4 +59,9 @@ void StartRead(u64 dvd_offset, u32 length, const DiscIO::Partition& partition,
 void StartReadToEmulatedRAM(u32 output_address, u64 dvd_offset, u32 length,
                             const DiscIO::Partition& partition, DVDInterface::ReplyType reply_type,
                             s64 ticks_until_completion);
+// Reads streamed audio (DTK) and decodes it on the DVD thread. The result handed to
+// DVDInterface::FinishExecutingCommand is byte-swapped stereo s16 PCM, not the raw ADPCM.
+void StartReadDTK(u64 dvd_offset, u32 length, bool reset_filter, s64 ticks_until_completion);
+// The size in bytes of the PCM that decoding length bytes of streamed audio produces
+u32 GetDecodedDTKSize(u32 length);
 }
@@ -4,6 +4,7 @@
 
 #include "Core/HW/EXI/EXI_DeviceEthernet.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -500,15 +501,20 @@ bool CEXIETHERNET::RecvHandlePacket()
   descriptor = (Descriptor*)write_ptr;
   write_ptr += 4;
 
-  for (u32 i = 0, off = 4; i < mRecvBufferLength; ++i, ++off)
+  // Copy the frame a page at a time. The ring buffer's pointers are all page aligned, so it can
+  // only wrap around or run into the read pointer at the end of a page.
+  for (u32 i = 0, off = 4; i < mRecvBufferLength;)
   {
-    *write_ptr++ = mRecvBuffer[i];
+    const u32 chunk_size = std::min<u32>(mRecvBufferLength - i, BBA_PAGE_SIZE - off);
+    memcpy(write_ptr, &mRecvBuffer[i], chunk_size);
+    write_ptr += chunk_size;
+    i += chunk_size;
+    off += chunk_size;
 
-    if (off == 0xff)
-    {
-      off = 0;
-      inc_rwp();
-    }
+    if (off != BBA_PAGE_SIZE)
+      break;
+    off = 0;
+    inc_rwp();
 
     if (write_ptr == end_ptr)
       write_ptr = ptr_from_page_ptr(BBA_BP);
@@ -4,6 +4,7 @@
 
 #include "Core/HW/EXI/EXI_DeviceIPL.h"
 
+#include <algorithm>
 #include <cstring>
 #include <string>
 
@@ -22,6 +23,7 @@
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/Sram.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/Movie.h"
@@ -377,21 +379,7 @@ void CEXIIPL::TransferByte(u8& byte)
           // At the moment, we pre-decrypt the whole thing and
           // ignore the "enabled" bit - see CEXIIPL::CEXIIPL
           byte = m_ipl[position];
-
-          if ((position >= 0x001AFF00) && (position <= 0x001FF474) && !m_fonts_loaded)
-          {
-            if (position >= 0x001FCF00)
-            {
-              PanicAlertT("Error: Trying to access Windows-1252 fonts but they are not loaded. "
-                          "Games may not show fonts correctly, or crash.");
-            }
-            else
-            {
-              PanicAlertT("Error: Trying to access Shift JIS fonts but they are not loaded. "
-                          "Games may not show fonts correctly, or crash.");
-            }
-            m_fonts_loaded = true;  // Don't be a nag :p
-          }
+          CheckFontsLoaded(position, 1);
         }
       }
       else
@@ -408,6 +396,42 @@ void CEXIIPL::TransferByte(u8& byte)
   m_position++;
 }
 
+// Reads from the ROM are copied at once. Everything else is transferred byte by byte.
+void CEXIIPL::DMARead(u32 address, u32 size)
+{
+  const u32 position = ((m_address >> 6) & ROM_MASK) + m_rw_offset;
+  if (m_position <= 3 || IsWriteCommand() || (m_address >> 6) >= ROM_SIZE ||
+      position + size > ROM_SIZE)
+  {
+    IEXIDevice::DMARead(address, size);
+    return;
+  }
+
+  Memory::CopyToEmu(address, m_ipl + position, size);
+  CheckFontsLoaded(position, size);
+  m_rw_offset += size;
+  m_position += size;
+}
+
+// Warns about reads of the fonts when they couldn't be loaded
+void CEXIIPL::CheckFontsLoaded(u32 position, u32 size)
+{
+  if (m_fonts_loaded || size == 0 || position > 0x001FF474 || position + size <= 0x001AFF00)
+    return;
+
+  if (std::max<u32>(position, 0x001AFF00) >= 0x001FCF00)
+  {
+    PanicAlertT("Error: Trying to access Windows-1252 fonts but they are not loaded. "
+                "Games may not show fonts correctly, or crash.");
+  }
+  else
+  {
+    PanicAlertT("Error: Trying to access Shift JIS fonts but they are not loaded. "
+                "Games may not show fonts correctly, or crash.");
+  }
+  m_fonts_loaded = true;  // Don't be a nag :p
+}
+
 u32 CEXIIPL::GetEmulatedTime(u32 epoch)
 {
   u64 ltime = 0;
@@ -21,6 +21,7 @@ public:
 
   void SetCS(int cs) override;
   bool IsPresent() const override;
+  void DMARead(u32 address, u32 size) override;
   void DoState(PointerWrap& p) override;
 
   static constexpr u32 UNIX_EPOCH = 0;         // 1970-01-01 00:00:00
@@ -70,6 +71,7 @@ private:
   void UpdateRTC();
 
   void TransferByte(u8& byte) override;
+  void CheckFontsLoaded(u32 position, u32 size);
   bool IsWriteCommand() const { return !!(m_address & (1 << 31)); }
   u32 CommandRegion() const { return (m_address & ~(1 << 31)) >> 8; }
   bool LoadFileToIPL(const std::string& filename, u32 offset);
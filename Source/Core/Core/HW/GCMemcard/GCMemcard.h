@@ -290,6 +290,9 @@ public:
   void DoState(PointerWrap& p);
   DEntry m_gci_header;
   std::vector<GCMBlock> m_save_data;
+  // Which blocks of m_save_data may differ from the file, so that flushing a save only has to
+  // write those. Doesn't match the size of m_save_data if the whole file has to be written.
+  std::vector<bool> m_dirty_blocks;
   std::vector<u16> m_used_blocks;
   int UsesBlock(u16 blocknum);
   bool m_dirty;
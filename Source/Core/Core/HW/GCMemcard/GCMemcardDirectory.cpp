@@ -110,6 +110,7 @@ int GCMemcardDirectory::LoadGCI(const std::string& file_name, bool current_game_
     {
       GCMemcard::PSO_MakeSaveGameValid(m_hdr, gci.m_gci_header, gci.m_save_data);
       GCMemcard::FZEROGX_MakeSaveGameValid(m_hdr, gci.m_gci_header, gci.m_save_data);
+      gci.m_dirty_blocks.clear();
     }
     int idx = (int)m_saves.size();
     m_dir1.Replace(gci.m_gci_header, idx);
@@ -450,11 +451,14 @@ inline s32 GCMemcardDirectory::SaveAreaRW(u32 block, bool writing)
             m_saves[i].m_save_data.emplace_back();
             num_blocks--;
           }
+          m_saves[i].m_dirty_blocks.clear();
         }
 
         if (writing)
         {
           m_saves[i].m_dirty = true;
+          if (static_cast<size_t>(idx) < m_saves[i].m_dirty_blocks.size())
+            m_saves[i].m_dirty_blocks[idx] = true;
         }
 
         m_last_block = block;
@@ -520,6 +524,52 @@ bool GCMemcardDirectory::SetUsedBlocks(int save_index)
   return true;
 }
 
+// Writes the blocks of the save which changed since it was last written, and its header. Writes
+// the whole file if it doesn't exist yet or has a different size.
+static bool WriteGCIFile(GCIFile& save)
+{
+  const size_t num_blocks = save.m_save_data.size();
+  const u64 file_size = DENTRY_SIZE + BLOCK_SIZE * static_cast<u64>(num_blocks);
+  const bool write_all = save.m_dirty_blocks.size() != num_blocks ||
+                         !File::Exists(save.m_filename) ||
+                         File::GetSize(save.m_filename) != file_size;
+
+  File::IOFile gci(save.m_filename, write_all ? "wb" : "r+b");
+  if (!gci)
+    return false;
+
+  gci.WriteBytes(&save.m_gci_header, DENTRY_SIZE);
+  if (write_all)
+  {
+    gci.WriteBytes(save.m_save_data.data(), BLOCK_SIZE * num_blocks);
+  }
+  else
+  {
+    // Write each run of consecutive dirty blocks at once
+    size_t block = 0;
+    while (block < num_blocks)
+    {
+      if (!save.m_dirty_blocks[block])
+      {
+        ++block;
+        continue;
+      }
+
+      size_t end = block;
+      while (end < num_blocks && save.m_dirty_blocks[end])
+        ++end;
+      gci.Seek(DENTRY_SIZE + BLOCK_SIZE * static_cast<u64>(block), SEEK_SET);
+      gci.WriteBytes(&save.m_save_data[block], BLOCK_SIZE * (end - block));
+      block = end;
+    }
+  }
+
+  if (!gci.IsGood())
+    return false;
+  save.m_dirty_blocks.assign(num_blocks, false);
+  return true;
+}
+
 void GCMemcardDirectory::FlushToFile()
 {
   std::unique_lock<std::mutex> l(m_write_mutex);
@@ -557,26 +607,18 @@ void GCMemcardDirectory::FlushToFile()
                         default_save_name.c_str());
           m_saves[i].m_filename = default_save_name;
         }
-        File::IOFile gci(m_saves[i].m_filename, "wb");
-        if (gci)
+        if (WriteGCIFile(m_saves[i]))
         {
-          gci.WriteBytes(&m_saves[i].m_gci_header, DENTRY_SIZE);
-          gci.WriteBytes(m_saves[i].m_save_data.data(), BLOCK_SIZE * m_saves[i].m_save_data.size());
-
-          if (gci.IsGood())
-          {
-            Core::DisplayMessage(
-                StringFromFormat("Wrote save contents to %s", m_saves[i].m_filename.c_str()), 4000);
-          }
-          else
-          {
-            ++errors;
-            Core::DisplayMessage(StringFromFormat("Failed to write save contents to %s",
-                                                  m_saves[i].m_filename.c_str()),
-                                 4000);
-            ERROR_LOG(EXPANSIONINTERFACE, "Failed to save data to %s",
-                      m_saves[i].m_filename.c_str());
-          }
+          Core::DisplayMessage(
+              StringFromFormat("Wrote save contents to %s", m_saves[i].m_filename.c_str()), 4000);
+        }
+        else
+        {
+          ++errors;
+          Core::DisplayMessage(StringFromFormat("Failed to write save contents to %s",
+                                                m_saves[i].m_filename.c_str()),
+                               4000);
+          ERROR_LOG(EXPANSIONINTERFACE, "Failed to save data to %s", m_saves[i].m_filename.c_str());
         }
       }
       else if (m_saves[i].m_filename.length() != 0)
@@ -655,6 +697,7 @@ bool GCIFile::LoadSaveBlocks()
       m_save_data.clear();
       return false;
     }
+    m_dirty_blocks.assign(num_blocks, false);
   }
   return true;
 }
@@ -682,6 +725,10 @@ void GCIFile::DoState(PointerWrap& p)
     p.DoPOD<GCMBlock>(*itr);
   }
   p.Do(m_used_blocks);
+
+  // The loaded blocks don't necessarily match the file anymore
+  if (p.GetMode() == PointerWrap::MODE_READ)
+    m_dirty_blocks.clear();
 }
 
 void MigrateFromMemcardFile(const std::string& directory_name, int card_index)
@@ -89,10 +89,13 @@ void UpdateGatherPipe()
       cur_mem += GATHER_PIPE_SIZE;
       ProcessorInterface::Fifo_CPUWritePointer += GATHER_PIPE_SIZE;
     }
-
-    CommandProcessor::GatherPipeBursted();
   }
 
+  // Hand all the bursts to the GPU at once, rather than updating the shared fifo state and waking
+  // the GPU thread for every 32 bytes.
+  if (processed != 0)
+    CommandProcessor::GatherPipeBursted(static_cast<u32>(processed / GATHER_PIPE_SIZE));
+
   // move back the spill bytes
   memmove(s_gather_pipe, s_gather_pipe + processed, pipe_count);
   SetGatherPipeCount(pipe_count);
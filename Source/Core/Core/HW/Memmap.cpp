@@ -189,7 +189,8 @@ void Init()
     region.shm_position = mem_size;
     mem_size += region.size;
   }
-  g_arena.GrabSHMSegment(mem_size);
+  g_arena.GrabSHMSegment(mem_size, SConfig::GetInstance().bHugePages,
+                         SConfig::GetInstance().bSharedMemoryExport);
   physical_base = Common::MemArena::FindMemoryBase();
 
   for (PhysicalMemoryRegion& region : physical_regions)
@@ -316,6 +317,21 @@ void Clear()
     memset(m_pEXRAM, 0, EXRAM_SIZE);
 }
 
+const std::string& GetSharedMemoryName()
+{
+  return g_arena.GetSharedName();
+}
+
+u32 GetSharedMemoryOffset(const u8* region)
+{
+  for (const PhysicalMemoryRegion& physical_region : physical_regions)
+  {
+    if (region && *physical_region.out_pointer == region)
+      return physical_region.shm_position;
+  }
+  return 0;
+}
+
 static inline u8* GetPointerForRange(u32 address, size_t size)
 {
   // Make sure we don't have a range spanning 2 separate banks
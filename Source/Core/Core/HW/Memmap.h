@@ -68,6 +68,12 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table);
 
 void Clear();
 
+// The name under which other processes can map the memory segment backing the emulated memory,
+// when SConfig::bSharedMemoryExport is set. Empty if the segment isn't shared.
+const std::string& GetSharedMemoryName();
+// Offset in that segment of an allocated region, e.g. m_pRAM or m_pEXRAM
+u32 GetSharedMemoryOffset(const u8* region);
+
 // Routines to access physically addressed memory, designed for use by
 // emulated hardware outside the CPU. Use "Device_" prefix.
 std::string GetString(u32 em_address, size_t size = 0);
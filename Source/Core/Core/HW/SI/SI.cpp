@@ -593,6 +593,18 @@ void ChangeDeviceDeterministic(SIDevices device, int channel)
   }
 }
 
+// Returns whether there's new data
+static bool UpdateChannelData(SSIChannel& channel)
+{
+  // Empty ports always respond like CSIDevice_Null does, so don't bother calling it on every poll
+  if (channel.device->GetDeviceType() == SIDEVICE_NONE)
+  {
+    channel.in_hi.hex = 0x80000000;
+    return true;
+  }
+  return channel.device->GetData(channel.in_hi.hex, channel.in_lo.hex);
+}
+
 void UpdateDevices()
 {
   // Update inputs at the rate of SI
@@ -600,14 +612,10 @@ void UpdateDevices()
   g_controller_interface.UpdateInput();
 
   // Update channels and set the status bit if there's new data
-  s_status_reg.RDST0 =
-      !!s_channel[0].device->GetData(s_channel[0].in_hi.hex, s_channel[0].in_lo.hex);
-  s_status_reg.RDST1 =
-      !!s_channel[1].device->GetData(s_channel[1].in_hi.hex, s_channel[1].in_lo.hex);
-  s_status_reg.RDST2 =
-      !!s_channel[2].device->GetData(s_channel[2].in_hi.hex, s_channel[2].in_lo.hex);
-  s_status_reg.RDST3 =
-      !!s_channel[3].device->GetData(s_channel[3].in_hi.hex, s_channel[3].in_lo.hex);
+  s_status_reg.RDST0 = UpdateChannelData(s_channel[0]);
+  s_status_reg.RDST1 = UpdateChannelData(s_channel[1]);
+  s_status_reg.RDST2 = UpdateChannelData(s_channel[2]);
+  s_status_reg.RDST3 = UpdateChannelData(s_channel[3]);
 
   UpdateInterrupts();
 }
@@ -2,7 +2,8 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
-#include <memory>
+#include <algorithm>
+#include <array>
 
 #include "AudioCommon/AudioCommon.h"
 #include "Common/CommonTypes.h"
@@ -48,13 +49,22 @@ static s32 av_clip(s32 a, s32 amin, s32 amax)
     return a;
 }
 
-static s16 adpcm_yamaha_expand_nibble(ADPCMState& s, u8 nibble)
+// Decodes a whole report at once, keeping the decoder state in locals rather than going through
+// the reference for every nibble.
+static void adpcm_yamaha_expand(ADPCMState& s, const u8* data, int length, s16* samples)
 {
-  s.predictor += (s.step * yamaha_difflookup[nibble]) / 8;
-  s.predictor = av_clip16(s.predictor);
-  s.step = (s.step * yamaha_indexscale[nibble]) >> 8;
-  s.step = av_clip(s.step, 127, 24576);
-  return s.predictor;
+  s32 predictor = s.predictor;
+  s32 step = s.step;
+  for (int i = 0; i < length * 2; ++i)
+  {
+    // The high nibble comes first
+    const u8 nibble = (i & 1) ? (data[i / 2] & 0xf) : (data[i / 2] >> 4);
+    predictor = av_clip16(predictor + (step * yamaha_difflookup[nibble]) / 8);
+    step = av_clip((step * yamaha_indexscale[nibble]) >> 8, 127, 24576);
+    samples[i] = predictor;
+  }
+  s.predictor = predictor;
+  s.step = step;
 }
 
 #ifdef WIIMOTE_SPEAKER_DUMP
@@ -75,8 +85,9 @@ void Wiimote::SpeakerData(const wm_speaker_data* sd)
   if (m_reg_speaker.volume == 0 || m_reg_speaker.sample_rate == 0 || sd->length == 0)
     return;
 
-  // TODO consider using static max size instead of new
-  std::unique_ptr<s16[]> samples(new s16[sd->length * 2]);
+  // The length field can claim more bytes than a report holds.
+  const int length = std::min<int>(sd->length, sizeof(sd->data));
+  std::array<s16, sizeof(sd->data) * 2> samples;
 
   unsigned int sample_rate_dividend, sample_length;
   u8 volume_divisor;
@@ -84,7 +95,7 @@ void Wiimote::SpeakerData(const wm_speaker_data* sd)
   if (m_reg_speaker.format == 0x40)
   {
     // 8 bit PCM
-    for (int i = 0; i < sd->length; ++i)
+    for (int i = 0; i < length; ++i)
     {
       samples[i] = ((s16)(s8)sd->data[i]) << 8;
     }
@@ -92,16 +103,12 @@ void Wiimote::SpeakerData(const wm_speaker_data* sd)
     // Following details from http://wiibrew.org/wiki/Wiimote#Speaker
     sample_rate_dividend = 12000000;
     volume_divisor = 0xff;
-    sample_length = (unsigned int)sd->length;
+    sample_length = (unsigned int)length;
   }
   else if (m_reg_speaker.format == 0x00)
   {
     // 4 bit Yamaha ADPCM (same as dreamcast)
-    for (int i = 0; i < sd->length; ++i)
-    {
-      samples[i * 2] = adpcm_yamaha_expand_nibble(m_adpcm_state, (sd->data[i] >> 4) & 0xf);
-      samples[i * 2 + 1] = adpcm_yamaha_expand_nibble(m_adpcm_state, sd->data[i] & 0xf);
-    }
+    adpcm_yamaha_expand(m_adpcm_state, sd->data, length, samples.data());
 
     // Following details from http://wiibrew.org/wiki/Wiimote#Speaker
     sample_rate_dividend = 6000000;
@@ -109,7 +116,7 @@ void Wiimote::SpeakerData(const wm_speaker_data* sd)
     // 0 - 127
     // TODO: does it go beyond 127 for format == 0x40?
     volume_divisor = 0x7F;
-    sample_length = (unsigned int)sd->length * 2;
+    sample_length = (unsigned int)length * 2;
   }
   else
   {
@@ -133,7 +140,7 @@ void Wiimote::SpeakerData(const wm_speaker_data* sd)
   g_sound_stream->GetMixer()->SetWiimoteSpeakerVolume(left_volume, right_volume);
 
   // ADPCM sample rate is thought to be x2.(3000 x2 = 6000).
-  g_sound_stream->GetMixer()->PushWiimoteSpeakerSamples(samples.get(), sample_length,
+  g_sound_stream->GetMixer()->PushWiimoteSpeakerSamples(samples.data(), sample_length,
                                                         sample_rate * 2);
 
 #ifdef WIIMOTE_SPEAKER_DUMP
@@ -147,10 +154,10 @@ void Wiimote::SpeakerData(const wm_speaker_data* sd)
     File::OpenFStream(ofile, "rmtdump.bin", ofile.binary | ofile.out);
     wav.Start("rmtdump.wav", 6000);
   }
-  wav.AddMonoSamples(samples.get(), sd->length * 2);
+  wav.AddMonoSamples(samples.data(), length * 2);
   if (ofile.good())
   {
-    for (int i = 0; i < sd->length; i++)
+    for (int i = 0; i < length; i++)
     {
       ofile << sd->data[i];
     }
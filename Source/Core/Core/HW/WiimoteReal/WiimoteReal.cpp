@@ -16,6 +16,7 @@
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
 #include "Common/Thread.h"
+#include "Common/Timer.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/HW/Wiimote.h"
@@ -122,7 +123,7 @@ void Wiimote::SetChannel(u16 channel)
 
 void Wiimote::ClearReadQueue()
 {
-  Report rpt;
+  ReadReport rpt;
 
   // The "Clear" function isn't thread-safe :/
   while (m_read_reports.Pop(rpt))
@@ -201,21 +202,22 @@ void Wiimote::InterruptChannel(const u16 channel, const void* const data, const
 
 void Wiimote::Read()
 {
-  Report rpt(MAX_PAYLOAD);
-  auto const result = IORead(rpt.data());
+  // Only reports which are actually received need to be allocated.
+  u8 buffer[MAX_PAYLOAD];
+  auto const result = IORead(buffer);
 
   if (result > 0 && m_channel > 0)
   {
+    const u64 read_time_us = Common::Timer::GetTimeUs();
     if (SConfig::GetInstance().iBBDumpPort > 0 && m_index == WIIMOTE_BALANCE_BOARD)
     {
       static sf::UdpSocket Socket;
-      Socket.send((char*)rpt.data(), rpt.size(), sf::IpAddress::LocalHost,
+      Socket.send((char*)buffer, sizeof(buffer), sf::IpAddress::LocalHost,
                   SConfig::GetInstance().iBBDumpPort);
     }
 
     // Add it to queue
-    rpt.resize(result);
-    m_read_reports.Push(std::move(rpt));
+    m_read_reports.Push(ReadReport{Report(buffer, buffer + result), read_time_us});
   }
   else if (0 == result)
   {
@@ -322,8 +324,11 @@ static bool IsDataReport(const Report& rpt)
 Report& Wiimote::ProcessReadQueue()
 {
   // Pop through the queued reports
-  while (m_read_reports.Pop(m_last_input_report))
+  ReadReport rpt;
+  while (m_read_reports.Pop(rpt))
   {
+    m_last_input_report = std::move(rpt.report);
+    m_last_input_report_time_us = rpt.read_time_us;
     if (!IsDataReport(m_last_input_report))
     {
       // A non-data report, use it.
@@ -359,9 +364,31 @@ void Wiimote::Update()
   if (!rpt.empty() && m_channel > 0)
   {
     Core::Callback_WiimoteInterruptChannel(m_index, m_channel, rpt.data(), (u32)rpt.size());
+
+    // Data reports are repeated until a new one is read, but only new ones count for latency.
+    if (m_last_input_report_time_us != 0)
+    {
+      AddReportLatencySample(Common::Timer::GetTimeUs() - m_last_input_report_time_us);
+      m_last_input_report_time_us = 0;
+    }
   }
 }
 
+void Wiimote::AddReportLatencySample(u64 latency_us)
+{
+  m_report_latency_sum_us += latency_us;
+  m_report_latency_max_us = std::max(m_report_latency_max_us, latency_us);
+  if (++m_report_latency_samples < REPORT_LATENCY_WINDOW)
+    return;
+
+  m_average_report_latency_us.store(
+      static_cast<u32>(m_report_latency_sum_us / m_report_latency_samples));
+  m_max_report_latency_us.store(static_cast<u32>(m_report_latency_max_us));
+  m_report_latency_sum_us = 0;
+  m_report_latency_max_us = 0;
+  m_report_latency_samples = 0;
+}
+
 bool Wiimote::CheckForButtonPress()
 {
   const Report& rpt = ProcessReadQueue();
@@ -674,6 +701,24 @@ int Wiimote::GetIndex() const
   return m_index;
 }
 
+std::string GetReportLatencyDisplay()
+{
+  std::string display;
+  std::lock_guard<std::mutex> lk(g_wiimotes_mutex);
+  for (int i = 0; i < MAX_BBMOTES; ++i)
+  {
+    if (!g_wiimotes[i] || !g_wiimotes[i]->IsConnected())
+      continue;
+
+    const std::string name =
+        i == WIIMOTE_BALANCE_BOARD ? "Balance Board" : StringFromFormat("Wii Remote %d", i + 1);
+    display += StringFromFormat("%s latency: %.2f ms (max %.2f ms)\n", name.c_str(),
+                                g_wiimotes[i]->GetAverageReportLatencyUs() / 1000.0,
+                                g_wiimotes[i]->GetMaxReportLatencyUs() / 1000.0);
+  }
+  return display;
+}
+
 void LoadSettings()
 {
   std::string ini_filename = File::GetUserPath(D_CONFIG_IDX) + WIIMOTE_INI_NAME ".ini";
@@ -82,6 +82,11 @@ public:
 
   int GetIndex() const;
 
+  // Time between a report being read from the device and it being passed to the emulated
+  // Bluetooth stack, over the last REPORT_LATENCY_WINDOW reports
+  u32 GetAverageReportLatencyUs() const { return m_average_report_latency_us.load(); }
+  u32 GetMaxReportLatencyUs() const { return m_max_report_latency_us.load(); }
+
 protected:
   Wiimote();
   int m_index;
@@ -93,7 +98,17 @@ protected:
   bool m_really_disconnect = false;
 
 private:
+  struct ReadReport
+  {
+    Report report;
+    // When the report was read, for the latency statistics
+    u64 read_time_us;
+  };
+
+  static constexpr u32 REPORT_LATENCY_WINDOW = 200;
+
   void ClearReadQueue();
+  void AddReportLatencySample(u64 latency_us);
   void WriteReport(Report rpt);
 
   virtual int IORead(u8* buf) = 0;
@@ -112,8 +127,16 @@ private:
   // Triggered when the thread has finished ConnectInternal.
   Common::Event m_thread_ready_event;
 
-  Common::SPSCQueue<Report> m_read_reports;
+  Common::SPSCQueue<ReadReport> m_read_reports;
   Common::SPSCQueue<Report> m_write_reports;
+
+  // Read time of m_last_input_report, or 0 once it has been sent
+  u64 m_last_input_report_time_us = 0;
+  u64 m_report_latency_sum_us = 0;
+  u64 m_report_latency_max_us = 0;
+  u32 m_report_latency_samples = 0;
+  std::atomic<u32> m_average_report_latency_us{0};
+  std::atomic<u32> m_max_report_latency_us{0};
 };
 
 class WiimoteScannerBackend
@@ -170,6 +193,9 @@ bool IsValidDeviceName(const std::string& name);
 bool IsBalanceBoardName(const std::string& name);
 bool IsNewWiimote(const std::string& identifier);
 
+// Describes the report latency of each connected real Wii Remote, one per line
+std::string GetReportLatencyDisplay();
+
 #ifdef ANDROID
 void InitAdapterClass();
 #endif
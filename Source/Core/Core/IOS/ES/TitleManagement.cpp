@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <cinttypes>
 #include <cstddef>
+#include <future>
 #include <utility>
 #include <vector>
 
@@ -301,6 +302,8 @@ ReturnCode ES::ImportContentBegin(Context& context, u64 title_id, u32 content_id
     return ES_EINVAL;
   context.title_import_export.content.iv[0] = (content_info.index >> 8) & 0xFF;
   context.title_import_export.content.iv[1] = content_info.index & 0xFF;
+  // Contents are usually imported in many small chunks
+  context.title_import_export.content.buffer.reserve(Common::AlignUp(content_info.size, 16));
 
   context.title_import_export.content.valid = true;
 
@@ -371,11 +374,12 @@ ReturnCode ES::ImportContentEnd(Context& context, u32 content_fd)
   IOS::ES::Content content_info;
   context.title_import_export.tmd.FindContentById(context.title_import_export.content.id,
                                                   &content_info);
-  if (!CheckIfContentHashMatches(decrypted_data, content_info))
-  {
-    ERROR_LOG(IOS_ES, "ImportContentEnd: Hash for content %08x doesn't match", content_info.id);
-    return ES_HASH_MISMATCH;
-  }
+
+  // The content is hashed while it is written to a temporary file, which is only moved to its
+  // final location if the hash matches.
+  std::future<bool> hash_matches = std::async(std::launch::async, [&] {
+    return CheckIfContentHashMatches(decrypted_data, content_info);
+  });
 
   const auto fs = m_ios.GetFS();
   std::string content_path;
@@ -403,6 +407,13 @@ ReturnCode ES::ImportContentEnd(Context& context, u32 content_fd)
     }
   }
 
+  if (!hash_matches.get())
+  {
+    fs->Delete(PID_KERNEL, PID_KERNEL, temp_path);
+    ERROR_LOG(IOS_ES, "ImportContentEnd: Hash for content %08x doesn't match", content_info.id);
+    return ES_HASH_MISMATCH;
+  }
+
   const FS::ResultCode rename_result = fs->Rename(PID_KERNEL, PID_KERNEL, temp_path, content_path);
   if (rename_result != FS::ResultCode::Success)
   {
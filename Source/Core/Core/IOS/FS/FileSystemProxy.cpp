@@ -6,6 +6,9 @@
 
 #include <algorithm>
 #include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
 
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
@@ -29,6 +32,14 @@ static IPCCommandResult GetFSReply(s32 return_value, u64 extra_tb_ticks = 0)
   return {return_value, true, (2700 + extra_tb_ticks) * SystemTimers::TIMER_RATIO};
 }
 
+// For commands which access file data, whose host I/O is done on the IOS worker thread
+static IPCCommandResult GetAsyncFSReply(std::function<s32()> work, u64 extra_tb_ticks)
+{
+  IPCCommandResult result = GetFSReply(IPC_SUCCESS, extra_tb_ticks);
+  result.async_work = std::move(work);
+  return result;
+}
+
 /// Amount of TB ticks required for a superblock write to complete.
 constexpr u64 SUPERBLOCK_WRITE_TICKS = 3370000;
 /// Amount of TB ticks required to write a cluster (for a file).
@@ -229,15 +240,16 @@ IPCCommandResult FS::Read(const ReadWriteRequest& request)
   // Simulate the FS read logic to estimate ticks. Note: this must be done before reading.
   const u64 ticks = EstimateTicksForReadWrite(handle, request);
 
-  const Result<u32> result = m_ios.GetFS()->ReadBytesFromFile(
-      handle.fs_fd, Memory::GetPointer(request.buffer), request.size);
-  LogResult(
-      StringFromFormat("Read(%s, 0x%08x, %u)", handle.name.data(), request.buffer, request.size),
-      result);
-  if (!result)
-    return GetFSReply(ConvertResult(result.Error()));
-
-  return GetFSReply(*result, ticks);
+  const std::shared_ptr<FileSystem> fs = m_ios.GetFS();
+  const std::string name = handle.name.data();
+  const Fd fd = handle.fs_fd;
+  return GetAsyncFSReply(
+      [fs, name, fd, buffer = request.buffer, size = request.size] {
+        const Result<u32> result = fs->ReadBytesFromFile(fd, Memory::GetPointer(buffer), size);
+        LogResult(StringFromFormat("Read(%s, 0x%08x, %u)", name.c_str(), buffer, size), result);
+        return result ? static_cast<s32>(*result) : ConvertResult(result.Error());
+      },
+      ticks);
 }
 
 IPCCommandResult FS::Write(const ReadWriteRequest& request)
@@ -249,15 +261,16 @@ IPCCommandResult FS::Write(const ReadWriteRequest& request)
   // Simulate the FS write logic to estimate ticks. Must be done before writing.
   const u64 ticks = EstimateTicksForReadWrite(handle, request);
 
-  const Result<u32> result = m_ios.GetFS()->WriteBytesToFile(
-      handle.fs_fd, Memory::GetPointer(request.buffer), request.size);
-  LogResult(
-      StringFromFormat("Write(%s, 0x%08x, %u)", handle.name.data(), request.buffer, request.size),
-      result);
-  if (!result)
-    return GetFSReply(ConvertResult(result.Error()));
-
-  return GetFSReply(*result, ticks);
+  const std::shared_ptr<FileSystem> fs = m_ios.GetFS();
+  const std::string name = handle.name.data();
+  const Fd fd = handle.fs_fd;
+  return GetAsyncFSReply(
+      [fs, name, fd, buffer = request.buffer, size = request.size] {
+        const Result<u32> result = fs->WriteBytesToFile(fd, Memory::GetPointer(buffer), size);
+        LogResult(StringFromFormat("Write(%s, 0x%08x, %u)", name.c_str(), buffer, size), result);
+        return result ? static_cast<s32>(*result) : ConvertResult(result.Error());
+      },
+      ticks);
 }
 
 IPCCommandResult FS::Seek(const SeekRequest& request)
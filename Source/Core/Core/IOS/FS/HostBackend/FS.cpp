@@ -49,20 +49,49 @@ HostFileSystem::HostFileSystem(const std::string& root_path) : m_root_path{root_
   Init();
 }
 
-HostFileSystem::~HostFileSystem() = default;
+HostFileSystem::~HostFileSystem()
+{
+  // Closing a file writes its pending data and updates the caches, so it must happen first.
+  for (Handle& handle : m_handles)
+    handle.host_file.reset();
+  m_closed_files.clear();
+}
+
+const HostFileSystem::HostEntryInfo& HostFileSystem::GetHostEntryInfo(const std::string& host_path)
+{
+  const auto it = m_entry_info_cache.find(host_path);
+  if (it != m_entry_info_cache.end())
+    return it->second;
+
+  const File::FileInfo file_info(host_path);
+  HostEntryInfo info;
+  info.exists = file_info.Exists();
+  info.is_directory = file_info.IsDirectory();
+  info.size = file_info.GetSize();
+  return m_entry_info_cache.emplace(host_path, info).first->second;
+}
+
+void HostFileSystem::InvalidateCaches()
+{
+  m_entry_info_cache.clear();
+  m_directory_cache.clear();
+}
 
 void HostFileSystem::DoState(PointerWrap& p)
 {
   p.Do(m_root_path);
 
-  // Temporarily close the file, to prevent any issues with the savestating of /tmp
+  // Temporarily close the file, to prevent any issues with the savestating of /tmp.
+  // This also writes all pending data to the host files.
   for (Handle& handle : m_handles)
     handle.host_file.reset();
+  m_closed_files.clear();
 
   // handle /tmp
   std::string Path = BuildFilename("/tmp");
   if (p.GetMode() == PointerWrap::MODE_READ)
   {
+    InvalidateCaches();
     File::DeleteDirRecursively(Path);
     File::CreateDir(Path);
 
@@ -162,6 +191,8 @@ void HostFileSystem::DoState(PointerWrap& p)
 ResultCode HostFileSystem::Format(Uid uid)
 {
   const std::string root = BuildFilename("/");
+  ReleaseClosedFiles(root);
+  InvalidateCaches();
   if (!File::DeleteDirRecursively(root) || !File::CreateDir(root))
     return ResultCode::UnknownError;
   return ResultCode::Success;
@@ -171,9 +202,11 @@ ResultCode HostFileSystem::CreateFile(Uid, Gid, const std::string& path, FileAtt
 {
   std::string file_name(BuildFilename(path));
   // check if the file already exist
-  if (File::Exists(file_name))
+  if (GetHostEntryInfo(file_name).exists)
     return ResultCode::AlreadyExists;
 
+  InvalidateCaches();
+
   // create the file
   File::CreateFullPath(file_name);  // just to be sure
   if (!File::CreateEmptyFile(file_name))
@@ -192,6 +225,8 @@ ResultCode HostFileSystem::CreateDirectory(Uid, Gid, const std::string& path, Fi
 
   std::string name(BuildFilename(path));
 
+  InvalidateCaches();
+
   name += "/";
   File::CreateFullPath(name);
   DEBUG_ASSERT_MSG(IOS_FS, File::IsDirectory(name), "CREATE_DIR %s failed", name.c_str());
@@ -205,6 +240,8 @@ ResultCode HostFileSystem::Delete(Uid, Gid, const std::string& path)
     return ResultCode::Invalid;
 
   const std::string file_name = BuildFilename(path);
+  ReleaseClosedFiles(file_name);
+  InvalidateCaches();
   if (File::Delete(file_name))
     INFO_LOG(IOS_FS, "DeleteFile %s", file_name.c_str());
   else if (File::DeleteDirRecursively(file_name))
@@ -226,6 +263,10 @@ ResultCode HostFileSystem::Rename(Uid, Gid, const std::string& old_path,
     return ResultCode::Invalid;
   const std::string new_name = BuildFilename(new_path);
 
+  ReleaseClosedFiles(old_name);
+  ReleaseClosedFiles(new_name);
+  InvalidateCaches();
+
   // try to make the basis directory
   File::CreateFullPath(new_name);
 
@@ -260,20 +301,24 @@ Result<std::vector<std::string>> HostFileSystem::ReadDirectory(Uid, Gid, const s
   // the Wii uses this function to define the type (dir or file)
   const std::string dir_name(BuildFilename(path));
 
-  const File::FileInfo file_info(dir_name);
+  const HostEntryInfo& info = GetHostEntryInfo(dir_name);
 
-  if (!file_info.Exists())
+  if (!info.exists)
   {
     WARN_LOG(IOS_FS, "Search not found: %s", dir_name.c_str());
     return ResultCode::NotFound;
   }
 
-  if (!file_info.IsDirectory())
+  if (!info.is_directory)
   {
     // It's not a directory, so error.
     return ResultCode::Invalid;
   }
 
+  const auto cached = m_directory_cache.find(dir_name);
+  if (cached != m_directory_cache.end())
+    return cached->second;
+
   File::FSTEntry entry = File::ScanDirectoryTree(dir_name, false);
 
   for (File::FSTEntry& child : entry.children)
@@ -293,6 +338,7 @@ Result<std::vector<std::string>> HostFileSystem::ReadDirectory(Uid, Gid, const s
   std::vector<std::string> output;
   for (File::FSTEntry& child : entry.children)
     output.emplace_back(child.virtualName);
+  m_directory_cache.emplace(dir_name, output);
   return output;
 }
 
@@ -321,10 +367,19 @@ Result<Metadata> HostFileSystem::GetMetadata(Uid, Gid, const std::string& path)
       metadata.gid = tmd.GetGroupId();
   }
 
-  const File::FileInfo info{file_name};
-  metadata.is_file = info.IsFile();
-  metadata.size = info.GetSize();
-  if (!info.Exists())
+  // Open files may have pending writes, so their size is only known by the file.
+  const auto open_file = m_open_files.find(file_name);
+  if (open_file != m_open_files.end())
+  {
+    metadata.is_file = true;
+    metadata.size = open_file->second.lock()->size;
+    return metadata;
+  }
+
+  const HostEntryInfo& info = GetHostEntryInfo(file_name);
+  metadata.is_file = info.exists && !info.is_directory;
+  metadata.size = info.size;
+  if (!info.exists)
     return ResultCode::NotFound;
   return metadata;
 }
@@ -361,6 +416,7 @@ Result<DirectoryStats> HostFileSystem::GetDirectoryStats(const std::string& wii_
 
   DirectoryStats stats{};
   std::string path(BuildFilename(wii_path));
+  FlushAllHostFiles();
   if (File::IsDirectory(path))
   {
     File::FSTEntry parent_dir = File::ScanDirectoryTree(path, true);
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <deque>
 #include <map>
 #include <memory>
 #include <string>
@@ -20,6 +21,10 @@ namespace IOS::HLE::FS
 ///
 /// Ignores metadata like permissions, attributes and various checks and also
 /// sometimes returns wrong information because metadata is not available.
+///
+/// Since every IOS FS request would otherwise need host stat and open calls, what is known about
+/// host paths and directory listings is cached, and consecutive writes to a file are coalesced
+/// in memory. All of this assumes the NAND is only modified through this class while it exists.
 class HostFileSystem final : public FileSystem
 {
 public:
@@ -58,12 +63,28 @@ public:
   Result<DirectoryStats> GetDirectoryStats(const std::string& path) override;
 
 private:
+  struct HostFile
+  {
+    File::IOFile file;
+    u64 size = 0;
+    // Data of consecutive writes which hasn't been written to the host file yet
+    std::vector<u8> pending_write;
+    u64 pending_write_offset = 0;
+  };
+
+  struct HostEntryInfo
+  {
+    bool exists = false;
+    bool is_directory = false;
+    u64 size = 0;
+  };
+
   struct Handle
   {
     bool opened = false;
     Mode mode = Mode::None;
     std::string wii_path;
-    std::shared_ptr<File::IOFile> host_file;
+    std::shared_ptr<HostFile> host_file;
     u32 file_offset = 0;
   };
   Handle* AssignFreeHandle();
@@ -71,11 +92,24 @@ private:
   Fd ConvertHandleToFd(const Handle* handle) const;
 
   std::string BuildFilename(const std::string& wii_path) const;
-  std::shared_ptr<File::IOFile> OpenHostFile(const std::string& host_path);
+  std::shared_ptr<HostFile> OpenHostFile(const std::string& host_path);
+  static void FlushHostFile(HostFile& host_file);
+  void FlushAllHostFiles();
+  // Closes the recently closed files which are within host_path, so it can be deleted or renamed
+  void ReleaseClosedFiles(const std::string& host_path);
+
+  const HostEntryInfo& GetHostEntryInfo(const std::string& host_path);
+  void InvalidateCaches();
 
   std::string m_root_path;
-  std::map<std::string, std::weak_ptr<File::IOFile>> m_open_files;
+  std::map<std::string, std::weak_ptr<HostFile>> m_open_files;
   std::array<Handle, 16> m_handles{};
+  // Games often open a file for every small write to it, so closed files are kept open for a
+  // while to let their writes be coalesced.
+  std::deque<std::shared_ptr<HostFile>> m_closed_files;
+
+  std::map<std::string, HostEntryInfo> m_entry_info_cache;
+  std::map<std::string, std::vector<std::string>> m_directory_cache;
 };
 
 }  // namespace IOS::HLE::FS
@@ -3,7 +3,9 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <cinttypes>
 #include <memory>
+#include <vector>
 
 #include "Common/File.h"
 #include "Common/FileUtil.h"
@@ -12,8 +14,13 @@
 
 namespace IOS::HLE::FS
 {
+// Writes which would make the pending data of a file larger than this go to the host file.
+constexpr size_t MAX_PENDING_WRITE_SIZE = 0x100000;
+// Number of closed files which are kept open
+constexpr size_t MAX_CLOSED_FILES = 16;
+
 // This isn't theadsafe, but it's only called from the CPU thread.
-std::shared_ptr<File::IOFile> HostFileSystem::OpenHostFile(const std::string& host_path)
+std::shared_ptr<HostFileSystem::HostFile> HostFileSystem::OpenHostFile(const std::string& host_path)
 {
   // On the wii, all file operations are strongly ordered.
   // If a game opens the same file twice (or 8 times, looking at you PokePark Wii)
@@ -32,7 +39,7 @@ std::shared_ptr<File::IOFile> HostFileSystem::OpenHostFile(const std::string& ho
   //    - The Beatles: Rock Band (saving doesn't work)
 
   // Check if the file has already been opened.
-  std::shared_ptr<File::IOFile> file;
+  std::shared_ptr<HostFile> file;
   auto search = m_open_files.find(host_path);
   if (search != m_open_files.end())
   {
@@ -41,22 +48,68 @@ std::shared_ptr<File::IOFile> HostFileSystem::OpenHostFile(const std::string& ho
   else
   {
     // This code will be called when all references to the shared pointer below have been removed.
-    auto deleter = [this, host_path](File::IOFile* ptr) {
+    auto deleter = [this, host_path](HostFile* ptr) {
+      FlushHostFile(*ptr);
       delete ptr;                     // IOFile's deconstructor closes the file.
       m_open_files.erase(host_path);  // erase the weak pointer from the list of open files.
+      // The size of the file may have changed.
+      m_entry_info_cache.erase(host_path);
     };
 
     // All files are opened read/write. Actual access rights will be controlled per handle by the
     // read/write functions below
-    file = std::shared_ptr<File::IOFile>(new File::IOFile(host_path, "r+b"),
-                                         deleter);  // Use the custom deleter from above.
+    file = std::shared_ptr<HostFile>(new HostFile, deleter);  // Use the custom deleter from above.
+    file->file.Open(host_path, "r+b");
+    file->size = file->file.GetSize();
 
     // Store a weak pointer to our newly opened file in the cache.
-    m_open_files[host_path] = std::weak_ptr<File::IOFile>(file);
+    m_open_files[host_path] = std::weak_ptr<HostFile>(file);
   }
   return file;
 }
 
+void HostFileSystem::FlushHostFile(HostFile& host_file)
+{
+  if (host_file.pending_write.empty())
+    return;
+
+  if (!host_file.file.Seek(host_file.pending_write_offset, SEEK_SET) ||
+      !host_file.file.WriteBytes(host_file.pending_write.data(), host_file.pending_write.size()))
+  {
+    ERROR_LOG(IOS_FS, "Failed to write %zu bytes at offset %" PRIu64 " to the host file",
+              host_file.pending_write.size(), host_file.pending_write_offset);
+  }
+  host_file.pending_write.clear();
+}
+
+void HostFileSystem::FlushAllHostFiles()
+{
+  for (const auto& entry : m_open_files)
+  {
+    if (const std::shared_ptr<HostFile> file = entry.second.lock())
+      FlushHostFile(*file);
+  }
+}
+
+void HostFileSystem::ReleaseClosedFiles(const std::string& host_path)
+{
+  // Destroying the last reference removes the file from m_open_files, so whether a closed file is
+  // within host_path has to be determined beforehand.
+  std::vector<std::shared_ptr<HostFile>> released;
+  for (const auto& entry : m_open_files)
+  {
+    if (entry.first.compare(0, host_path.size(), host_path) != 0)
+      continue;
+    const std::shared_ptr<HostFile> file = entry.second.lock();
+    const auto it = std::find(m_closed_files.begin(), m_closed_files.end(), file);
+    if (it != m_closed_files.end())
+    {
+      released.push_back(std::move(*it));
+      m_closed_files.erase(it);
+    }
+  }
+}
+
 Result<FileHandle> HostFileSystem::OpenFile(Uid, Gid, const std::string& path, Mode mode)
 {
   Handle* handle = AssignFreeHandle();
@@ -64,13 +117,23 @@ Result<FileHandle> HostFileSystem::OpenFile(Uid, Gid, const std::string& path, M
     return ResultCode::NoFreeHandle;
 
   const std::string host_path = BuildFilename(path);
-  if (!File::IsFile(host_path))
+  if (m_open_files.find(host_path) == m_open_files.end())
+  {
+    const HostEntryInfo& info = GetHostEntryInfo(host_path);
+    if (!info.exists || info.is_directory)
+    {
+      *handle = Handle{};
+      return ResultCode::NotFound;
+    }
+  }
+
+  handle->host_file = OpenHostFile(host_path);
+  if (!handle->host_file->file.IsOpen())
   {
     *handle = Handle{};
     return ResultCode::NotFound;
   }
 
-  handle->host_file = OpenHostFile(host_path);
   handle->wii_path = path;
   handle->mode = mode;
   handle->file_offset = 0;
@@ -84,7 +147,14 @@ ResultCode HostFileSystem::Close(Fd fd)
     return ResultCode::Invalid;
 
   // Let go of our pointer to the file, it will automatically close if we are the last handle
-  // accessing it.
+  // accessing it and it is no longer one of the recently closed files.
+  if (std::find(m_closed_files.begin(), m_closed_files.end(), handle->host_file) ==
+      m_closed_files.end())
+  {
+    m_closed_files.push_back(handle->host_file);
+    if (m_closed_files.size() > MAX_CLOSED_FILES)
+      m_closed_files.pop_front();
+  }
   *handle = Handle{};
   return ResultCode::Success;
 }
@@ -92,22 +162,25 @@ ResultCode HostFileSystem::Close(Fd fd)
 Result<u32> HostFileSystem::ReadBytesFromFile(Fd fd, u8* ptr, u32 count)
 {
   Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   if ((u8(handle->mode) & u8(Mode::Read)) == 0)
     return ResultCode::AccessDenied;
 
-  const u32 file_size = static_cast<u32>(handle->host_file->GetSize());
+  HostFile& host_file = *handle->host_file;
+  const u32 file_size = static_cast<u32>(host_file.size);
   // IOS has this check in the read request handler.
   if (count + handle->file_offset > file_size)
     count = file_size - handle->file_offset;
 
+  FlushHostFile(host_file);
+
   // File might be opened twice, need to seek before we read
-  handle->host_file->Seek(handle->file_offset, SEEK_SET);
-  const u32 actually_read = static_cast<u32>(fread(ptr, 1, count, handle->host_file->GetHandle()));
+  host_file.file.Seek(handle->file_offset, SEEK_SET);
+  const u32 actually_read = static_cast<u32>(fread(ptr, 1, count, host_file.file.GetHandle()));
 
-  if (actually_read != count && ferror(handle->host_file->GetHandle()))
+  if (actually_read != count && ferror(host_file.file.GetHandle()))
     return ResultCode::AccessDenied;
 
   // IOS returns the number of bytes read and adds that value to the seek position,
@@ -119,25 +192,42 @@ Result<u32> HostFileSystem::ReadBytesFromFile(Fd fd, u8* ptr, u32 count)
 Result<u32> HostFileSystem::WriteBytesToFile(Fd fd, const u8* ptr, u32 count)
 {
   Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   if ((u8(handle->mode) & u8(Mode::Write)) == 0)
     return ResultCode::AccessDenied;
 
-  // File might be opened twice, need to seek before we read
-  handle->host_file->Seek(handle->file_offset, SEEK_SET);
-  if (!handle->host_file->WriteBytes(ptr, count))
-    return ResultCode::AccessDenied;
+  HostFile& host_file = *handle->host_file;
+  const bool continues_pending_write =
+      !host_file.pending_write.empty() &&
+      host_file.pending_write_offset + host_file.pending_write.size() == handle->file_offset;
+  if (!continues_pending_write || host_file.pending_write.size() + count > MAX_PENDING_WRITE_SIZE)
+    FlushHostFile(host_file);
+
+  if (count > MAX_PENDING_WRITE_SIZE)
+  {
+    // File might be opened twice, need to seek before we write
+    host_file.file.Seek(handle->file_offset, SEEK_SET);
+    if (!host_file.file.WriteBytes(ptr, count))
+      return ResultCode::AccessDenied;
+  }
+  else
+  {
+    if (host_file.pending_write.empty())
+      host_file.pending_write_offset = handle->file_offset;
+    host_file.pending_write.insert(host_file.pending_write.end(), ptr, ptr + count);
+  }
 
   handle->file_offset += count;
+  host_file.size = std::max<u64>(host_file.size, handle->file_offset);
   return count;
 }
 
 Result<u32> HostFileSystem::SeekFile(Fd fd, std::uint32_t offset, SeekMode mode)
 {
   Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   u32 new_position = 0;
@@ -150,14 +240,14 @@ Result<u32> HostFileSystem::SeekFile(Fd fd, std::uint32_t offset, SeekMode mode)
     new_position = handle->file_offset + offset;
     break;
   case SeekMode::End:
-    new_position = handle->host_file->GetSize() + offset;
+    new_position = handle->host_file->size + offset;
     break;
   default:
     return ResultCode::Invalid;
   }
 
   // This differs from POSIX behaviour which allows seeking past the end of the file.
-  if (handle->host_file->GetSize() < new_position)
+  if (handle->host_file->size < new_position)
     return ResultCode::Invalid;
 
   handle->file_offset = new_position;
@@ -167,11 +257,11 @@ Result<u32> HostFileSystem::SeekFile(Fd fd, std::uint32_t offset, SeekMode mode)
 Result<FileStatus> HostFileSystem::GetFileStatus(Fd fd)
 {
   const Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   FileStatus status;
-  status.size = handle->host_file->GetSize();
+  status.size = handle->host_file->size;
   status.offset = handle->file_offset;
   return status;
 }
@@ -65,6 +65,7 @@ static std::unique_ptr<EmulationKernel> s_ios;
 
 constexpr u64 ENQUEUE_REQUEST_FLAG = 0x100000000ULL;
 constexpr u64 ENQUEUE_ACKNOWLEDGEMENT_FLAG = 0x200000000ULL;
+constexpr u64 ENQUEUE_ASYNC_REPLY_FLAG = 0x400000000ULL;
 static CoreTiming::EventType* s_event_enqueue;
 static CoreTiming::EventType* s_event_sdio_notify;
 
@@ -188,6 +189,7 @@ Kernel::Kernel()
 
 Kernel::~Kernel()
 {
+  WaitForAsyncIPCWork();
   {
     std::lock_guard<std::mutex> lock(m_device_map_mutex);
     m_device_map.clear();
@@ -223,6 +225,7 @@ EmulationKernel::EmulationKernel(u64 title_id) : Kernel(title_id)
 
 EmulationKernel::~EmulationKernel()
 {
+  WaitForAsyncIPCWork();
   CoreTiming::RemoveAllEvents(s_event_enqueue);
 }
 
@@ -527,6 +530,10 @@ IPCCommandResult Kernel::HandleIPCCommand(const Request& request)
   if (!device)
     return IPCCommandResult{IPC_EINVAL, true, 550 * SystemTimers::TIMER_RATIO};
 
+  // Commands may depend on the side effects of earlier ones, even if they were sent to other
+  // devices, and devices aren't thread safe. So asynchronous work only overlaps with emulation.
+  WaitForAsyncIPCWork();
+
   IPCCommandResult ret;
   u64 wall_time_before = Common::Timer::GetTimeUs();
 
@@ -582,6 +589,19 @@ void Kernel::ExecuteIPCCommand(const u32 address)
     result.reply_delay_ticks += ticks_until_last_reply;
   m_last_reply_time = CoreTiming::GetTicks() + result.reply_delay_ticks;
 
+  // Running the work on another thread would make the timing of its memory writes depend on the
+  // host, which could be observed by a misbehaving game.
+  if (result.async_work && Core::WantsDeterminism())
+  {
+    result.return_value = result.async_work();
+  }
+  else if (result.async_work)
+  {
+    EnqueueAsyncIPCReply(request, std::move(result.async_work),
+                         static_cast<int>(result.reply_delay_ticks));
+    return;
+  }
+
   EnqueueIPCReply(request, result.return_value, static_cast<int>(result.reply_delay_ticks));
 }
 
@@ -607,6 +627,49 @@ void Kernel::EnqueueIPCReply(const Request& request, const s32 return_value, int
   CoreTiming::ScheduleEvent(cycles_in_future, s_event_enqueue, request.address, from);
 }
 
+void Kernel::EnqueueAsyncIPCReply(const Request& request, std::function<s32()> work,
+                                  int cycles_in_future)
+{
+  if (!m_async_work_thread)
+  {
+    m_async_work_thread = std::make_unique<Common::WorkQueueThread<std::function<void()>>>(
+        [](std::function<void()> item) { item(); });
+  }
+
+  auto task = std::make_shared<std::packaged_task<s32()>>(std::move(work));
+  m_async_replies.emplace(request.address, task->get_future().share());
+  m_async_work_thread->EmplaceItem([task] { (*task)(); });
+  CoreTiming::ScheduleEvent(cycles_in_future, s_event_enqueue,
+                            request.address | ENQUEUE_ASYNC_REPLY_FLAG);
+}
+
+// The reply is sent at the emulated time that was determined when the command was executed.
+// If the host hasn't completed the work by then, emulation waits for it.
+void Kernel::SendAsyncIPCReply(u32 address)
+{
+  const auto it = m_async_replies.find(address);
+  if (it == m_async_replies.end())
+  {
+    ERROR_LOG(IOS, "No pending reply for IPC request @ 0x%08x", address);
+    return;
+  }
+
+  const s32 return_value = it->second.get();
+  m_async_replies.erase(it);
+
+  const Request request{address};
+  Memory::Write_U32(static_cast<u32>(return_value), request.address + 4);
+  Memory::Write_U32(request.command, request.address + 8);
+  Memory::Write_U32(IPC_REPLY, request.address);
+  m_reply_queue.push_back(address);
+}
+
+void Kernel::WaitForAsyncIPCWork()
+{
+  for (const auto& reply : m_async_replies)
+    reply.second.wait();
+}
+
 void Kernel::EnqueueIPCAcknowledgement(u32 address, int cycles_in_future)
 {
   CoreTiming::ScheduleEvent(cycles_in_future, s_event_enqueue,
@@ -617,6 +680,8 @@ void Kernel::HandleIPCEvent(u64 userdata)
 {
   if (userdata & ENQUEUE_ACKNOWLEDGEMENT_FLAG)
     m_ack_queue.push_back(static_cast<u32>(userdata));
+  else if (userdata & ENQUEUE_ASYNC_REPLY_FLAG)
+    SendAsyncIPCReply(static_cast<u32>(userdata));
   else if (userdata & ENQUEUE_REQUEST_FLAG)
     m_request_queue.push_back(static_cast<u32>(userdata));
   else
@@ -689,6 +754,23 @@ void Kernel::DoState(PointerWrap& p)
   p.Do(m_request_queue);
   p.Do(m_reply_queue);
   p.Do(m_last_reply_time);
+
+  // Only the results of the pending commands are saved, so their work must be completed first.
+  WaitForAsyncIPCWork();
+  std::map<u32, s32> async_results;
+  for (const auto& reply : m_async_replies)
+    async_results.emplace(reply.first, reply.second.get());
+  p.Do(async_results);
+  if (p.GetMode() == PointerWrap::MODE_READ)
+  {
+    m_async_replies.clear();
+    for (const auto& result : async_results)
+    {
+      std::promise<s32> promise;
+      promise.set_value(result.second);
+      m_async_replies.emplace(result.first, promise.get_future().share());
+    }
+  }
   p.Do(m_title_id);
   p.Do(m_ppc_uid);
   p.Do(m_ppc_gid);
@@ -6,6 +6,8 @@
 
 #include <array>
 #include <deque>
+#include <functional>
+#include <future>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -13,6 +15,7 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/IOS/IOSC.h"
@@ -42,6 +45,10 @@ struct IPCCommandResult
   s32 return_value;
   bool send_reply;
   u64 reply_delay_ticks;
+  // If set, the command is completed by running this function on the IOS worker thread, which
+  // returns the actual return value. This is meant for commands which do slow host I/O.
+  // The reply is still sent reply_delay_ticks after the command, whatever the host latency is.
+  std::function<s32()> async_work;
 };
 
 enum IPCCommandType : u32
@@ -100,6 +107,12 @@ protected:
   void ExecuteIPCCommand(u32 address);
   IPCCommandResult HandleIPCCommand(const Request& request);
   void EnqueueIPCAcknowledgement(u32 address, int cycles_in_future = 0);
+  void EnqueueAsyncIPCReply(const Request& request, std::function<s32()> work,
+                            int cycles_in_future);
+  void SendAsyncIPCReply(u32 address);
+  // Waits until the asynchronous work of all commands has completed. Must be done before anything
+  // else accesses the state of the devices.
+  void WaitForAsyncIPCWork();
 
   void AddDevice(std::unique_ptr<Device::Device> device);
   void AddCoreDevices();
@@ -124,9 +137,13 @@ protected:
   IPCMsgQueue m_reply_queue;    // arm -> ppc
   IPCMsgQueue m_ack_queue;      // arm -> ppc
   u64 m_last_reply_time = 0;
+  // Results of the commands whose replies are pending, by request address
+  std::map<u32, std::shared_future<s32>> m_async_replies;
 
   IOSC m_iosc;
   std::shared_ptr<FS::FileSystem> m_fs;
+  // Only started once a command needs it. Declared last so that it is shut down first.
+  std::unique_ptr<Common::WorkQueueThread<std::function<void()>>> m_async_work_thread;
 };
 
 // HLE for an IOS tied to emulation: base kernel which may have additional modules loaded.
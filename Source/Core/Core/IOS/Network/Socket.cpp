@@ -201,11 +201,51 @@ s32 WiiSocket::FCntl(u32 cmd, u32 arg)
   return ret;
 }
 
+// Returns whether retrying an operation which would have blocked could make progress now
+bool WiiSocket::IsOperationReady(const sockop& op, bool read, bool write, bool except)
+{
+  if (except)
+    return true;
+
+  if (op.is_ssl)
+  {
+    switch (op.ssl_type)
+    {
+    case IOCTLV_NET_SSL_READ:
+      return read;
+    case IOCTLV_NET_SSL_WRITE:
+      return write;
+    default:
+      // Handshakes need to both send and receive.
+      return read || write;
+    }
+  }
+
+  switch (op.net_type)
+  {
+  case IOCTL_SO_ACCEPT:
+  case IOCTLV_SO_RECVFROM:
+    return read;
+  case IOCTL_SO_CONNECT:
+  case IOCTLV_SO_SENDTO:
+    return write;
+  default:
+    return true;
+  }
+}
+
 void WiiSocket::Update(bool read, bool write, bool except)
 {
   auto it = pending_sockops.begin();
   while (it != pending_sockops.end())
   {
+    if (it->attempted && !IsOperationReady(*it, read, write, except))
+    {
+      ++it;
+      continue;
+    }
+    it->attempted = true;
+
     s32 ReturnValue = 0;
     bool forceNonBlock = false;
     IPCCommandType ct = it->request.command;
@@ -681,50 +721,41 @@ s32 WiiSockMan::DeleteSocket(s32 s)
 
 void WiiSockMan::Update()
 {
-  s32 nfds = 0;
-  fd_set read_fds, write_fds, except_fds;
-  struct timeval t = {0, 0};
-  FD_ZERO(&read_fds);
-  FD_ZERO(&write_fds);
-  FD_ZERO(&except_fds);
-
+  // Only the sockets with pending operations are polled, so idle sockets cost nothing.
+  poll_fds.clear();
+  poll_sockets.clear();
   auto socket_iter = WiiSockets.begin();
-  auto end_socks = WiiSockets.end();
-
-  while (socket_iter != end_socks)
+  while (socket_iter != WiiSockets.end())
   {
     WiiSocket& sock = socket_iter->second;
-    if (sock.IsValid())
-    {
-      FD_SET(sock.fd, &read_fds);
-      FD_SET(sock.fd, &write_fds);
-      FD_SET(sock.fd, &except_fds);
-      nfds = std::max(nfds, sock.fd + 1);
-      ++socket_iter;
-    }
-    else
+    if (!sock.IsValid())
     {
       // Good time to clean up invalid sockets.
       socket_iter = WiiSockets.erase(socket_iter);
+      continue;
     }
-  }
-  s32 ret = select(nfds, &read_fds, &write_fds, &except_fds, &t);
 
-  if (ret >= 0)
-  {
-    for (auto& pair : WiiSockets)
+    if (!sock.pending_sockops.empty())
     {
-      WiiSocket& sock = pair.second;
-      sock.Update(FD_ISSET(sock.fd, &read_fds) != 0, FD_ISSET(sock.fd, &write_fds) != 0,
-                  FD_ISSET(sock.fd, &except_fds) != 0);
+      poll_fds.push_back({sock.fd, POLLIN | POLLOUT, 0});
+      poll_sockets.push_back(&sock);
     }
+    ++socket_iter;
   }
-  else
+
+  if (poll_fds.empty())
+    return;
+
+  const int ret = poll(poll_fds.data(), static_cast<unsigned long>(poll_fds.size()), 0);
+
+  // Updating a socket can add new ones (accept), but references to elements of an unordered_map
+  // stay valid when it grows.
+  for (size_t i = 0; i < poll_sockets.size(); ++i)
   {
-    for (auto& elem : WiiSockets)
-    {
-      elem.second.Update(false, false, false);
-    }
+    // If polling failed, all operations are retried.
+    const short revents = ret >= 0 ? poll_fds[i].revents : POLLERR;
+    poll_sockets[i]->Update((revents & POLLIN) != 0, (revents & POLLOUT) != 0,
+                            (revents & (POLLERR | POLLHUP | POLLNVAL)) != 0);
   }
 }
 
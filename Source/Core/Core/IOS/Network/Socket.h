@@ -47,6 +47,7 @@ typedef struct pollfd pollfd_t;
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -189,6 +190,8 @@ private:
       NET_IOCTL net_type;
       SSL_IOCTL ssl_type;
     };
+    // Once an operation has been tried, it is only retried when the socket is ready for it
+    bool attempted = false;
   };
 
   friend class WiiSockMan;
@@ -200,6 +203,7 @@ private:
   void DoSock(Request request, NET_IOCTL type);
   void DoSock(Request request, SSL_IOCTL type);
   void Update(bool read, bool write, bool except);
+  static bool IsOperationReady(const sockop& op, bool read, bool write, bool except);
   bool IsValid() const { return fd >= 0; }
   s32 fd = -1;
   s32 wii_fd = -1;
@@ -256,5 +260,8 @@ private:
 
   std::unordered_map<s32, WiiSocket> WiiSockets;
   s32 errno_last;
+  // Reused by Update for the sockets which have pending operations
+  std::vector<pollfd_t> poll_fds;
+  std::vector<WiiSocket*> poll_sockets;
 };
 }  // namespace IOS::HLE
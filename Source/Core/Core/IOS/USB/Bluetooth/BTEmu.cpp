@@ -232,6 +232,12 @@ void BluetoothEmu::IncDataPacket(u16 _ConnectionHandle)
 // Here we send ACL packets to CPU. They will consist of header + data.
 // The header is for example 07 00 41 00 which means size 0x0007 and channel 0x0041.
 void BluetoothEmu::SendACLPacket(u16 connection_handle, const u8* data, u32 size)
+{
+  SendACLPacket(connection_handle, data, size, nullptr, 0);
+}
+
+void BluetoothEmu::SendACLPacket(u16 connection_handle, const u8* header, u32 header_size,
+                                 const u8* payload, u32 payload_size)
 {
   DEBUG_LOG(IOS_WIIMOTE, "ACL packet from %x ready to send to stack...", connection_handle);
 
@@ -240,24 +246,33 @@ void BluetoothEmu::SendACLPacket(u16 connection_handle, const u8* data, u32 size
     DEBUG_LOG(IOS_WIIMOTE, "ACL endpoint valid, sending packet to %08x",
               m_ACLEndpoint->ios_request.address);
 
-    hci_acldata_hdr_t* header =
-        reinterpret_cast<hci_acldata_hdr_t*>(Memory::GetPointer(m_ACLEndpoint->data_address));
-    header->con_handle = HCI_MK_CON_HANDLE(connection_handle, HCI_PACKET_START, HCI_POINT2POINT);
-    header->length = size;
-
-    // Write the packet to the buffer
-    memcpy(reinterpret_cast<u8*>(header) + sizeof(hci_acldata_hdr_t), data, header->length);
-
-    m_ios.EnqueueIPCReply(m_ACLEndpoint->ios_request, sizeof(hci_acldata_hdr_t) + size);
+    WriteACLPacket(*m_ACLEndpoint, connection_handle, header, header_size, payload, payload_size);
+    m_ios.EnqueueIPCReply(m_ACLEndpoint->ios_request,
+                          sizeof(hci_acldata_hdr_t) + header_size + payload_size);
     m_ACLEndpoint.reset();
   }
   else
   {
     DEBUG_LOG(IOS_WIIMOTE, "ACL endpoint not currently valid, queuing...");
-    m_acl_pool.Store(data, size, connection_handle);
+    m_acl_pool.Store(header, header_size, payload, payload_size, connection_handle);
   }
 }
 
+// Writes the packet straight to the emulated memory of the endpoint's buffer
+void BluetoothEmu::WriteACLPacket(USB::V0BulkMessage& endpoint, u16 conn_handle, const u8* header,
+                                  u32 header_size, const u8* payload, u32 payload_size)
+{
+  hci_acldata_hdr_t* acl_header =
+      reinterpret_cast<hci_acldata_hdr_t*>(Memory::GetPointer(endpoint.data_address));
+  acl_header->con_handle = HCI_MK_CON_HANDLE(conn_handle, HCI_PACKET_START, HCI_POINT2POINT);
+  acl_header->length = header_size + payload_size;
+
+  u8* const data = reinterpret_cast<u8*>(acl_header) + sizeof(hci_acldata_hdr_t);
+  std::copy(header, header + header_size, data);
+  if (payload_size)
+    std::copy(payload, payload + payload_size, data + header_size);
+}
+
 // These messages are sent from the Wii Remote to the game, for example RequestConnection()
 // or ConnectionComplete().
 //
@@ -371,48 +386,62 @@ void BluetoothEmu::Update()
   SendEventNumberOfCompletedPackets();
 }
 
-void BluetoothEmu::ACLPool::Store(const u8* data, const u16 size, const u16 conn_handle)
+void BluetoothEmu::ACLPool::Store(const u8* header, u32 header_size, const u8* payload,
+                                  u32 payload_size, u16 conn_handle)
 {
-  if (m_queue.size() >= 100)
+  if (m_count >= MAX_PACKETS)
   {
     // Many simultaneous exchanges of ACL packets tend to cause the queue to fill up.
     ERROR_LOG(IOS_WIIMOTE, "ACL queue size reached 100 - current packet will be dropped!");
     return;
   }
 
+  const u32 size = header_size + payload_size;
   DEBUG_ASSERT_MSG(IOS_WIIMOTE, size < ACL_PKT_SIZE, "ACL packet too large for pool");
 
-  m_queue.push_back(Packet());
-  auto& packet = m_queue.back();
+  Packet& packet = m_packets[(m_first + m_count) % MAX_PACKETS];
+  ++m_count;
 
-  std::copy(data, data + size, packet.data);
-  packet.size = size;
+  std::copy(header, header + header_size, packet.data);
+  if (payload_size)
+    std::copy(payload, payload + payload_size, packet.data + header_size);
+  packet.size = static_cast<u16>(size);
   packet.conn_handle = conn_handle;
 }
 
 void BluetoothEmu::ACLPool::WriteToEndpoint(USB::V0BulkMessage& endpoint)
 {
-  auto& packet = m_queue.front();
-
-  const u8* const data = packet.data;
-  const u16 size = packet.size;
-  const u16 conn_handle = packet.conn_handle;
+  const Packet& packet = m_packets[m_first];
 
   DEBUG_LOG(IOS_WIIMOTE,
             "ACL packet being written from "
             "queue to %08x",
             endpoint.ios_request.address);
 
-  hci_acldata_hdr_t* pHeader = (hci_acldata_hdr_t*)Memory::GetPointer(endpoint.data_address);
-  pHeader->con_handle = HCI_MK_CON_HANDLE(conn_handle, HCI_PACKET_START, HCI_POINT2POINT);
-  pHeader->length = size;
+  WriteACLPacket(endpoint, packet.conn_handle, packet.data, packet.size, nullptr, 0);
+
+  m_first = (m_first + 1) % MAX_PACKETS;
+  --m_count;
 
-  // Write the packet to the buffer
-  std::copy(data, data + size, (u8*)pHeader + sizeof(hci_acldata_hdr_t));
+  m_ios.EnqueueIPCReply(endpoint.ios_request, sizeof(hci_acldata_hdr_t) + packet.size);
+}
 
-  m_queue.pop_front();
+// Uses the same format as the std::deque which used to hold the packets
+void BluetoothEmu::ACLPool::DoState(PointerWrap& p)
+{
+  u32 count = m_count;
+  p.Do(count);
+  if (p.GetMode() == PointerWrap::MODE_READ)
+  {
+    m_first = 0;
+    m_count = std::min(count, MAX_PACKETS);
+  }
 
-  m_ios.EnqueueIPCReply(endpoint.ios_request, sizeof(hci_acldata_hdr_t) + size);
+  for (u32 i = 0; i < count; ++i)
+  {
+    Packet dropped;
+    p.Do(i < MAX_PACKETS ? m_packets[(m_first + i) % MAX_PACKETS] : dropped);
+  }
 }
 
 bool BluetoothEmu::SendEventInquiryComplete()
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <deque>
 #include <memory>
 #include <queue>
@@ -54,6 +55,10 @@ public:
 
   // Send ACL data back to Bluetooth stack
   void SendACLPacket(u16 connection_handle, const u8* data, u32 size);
+  // Same as above, for a packet made of a header and a separate payload. This avoids copying
+  // reports into a temporary buffer just to prepend their L2CAP header.
+  void SendACLPacket(u16 connection_handle, const u8* header, u32 header_size, const u8* payload,
+                     u32 payload_size);
 
   bool RemoteDisconnect(u16 _connectionHandle);
 
@@ -74,19 +79,23 @@ private:
   std::unique_ptr<USB::V0BulkMessage> m_ACLEndpoint;
   std::deque<SQueuedEvent> m_EventQueue;
 
+  // A fixed-size ring of packets, so that queueing a packet never allocates
   class ACLPool
   {
   public:
-    explicit ACLPool(Kernel& ios) : m_ios(ios), m_queue() {}
-    void Store(const u8* data, const u16 size, const u16 conn_handle);
+    explicit ACLPool(Kernel& ios) : m_ios(ios) {}
+    void Store(const u8* header, u32 header_size, const u8* payload, u32 payload_size,
+               u16 conn_handle);
 
     void WriteToEndpoint(USB::V0BulkMessage& endpoint);
 
-    bool IsEmpty() const { return m_queue.empty(); }
+    bool IsEmpty() const { return m_count == 0; }
     // For SaveStates
-    void DoState(PointerWrap& p) { p.Do(m_queue); }
+    void DoState(PointerWrap& p);
 
   private:
+    static constexpr u32 MAX_PACKETS = 100;
+
     struct Packet
     {
       u8 data[ACL_PKT_SIZE];
@@ -95,12 +104,17 @@ private:
     };
 
     Kernel& m_ios;
-    std::deque<Packet> m_queue;
+    std::array<Packet, MAX_PACKETS> m_packets;
+    u32 m_first = 0;
+    u32 m_count = 0;
   } m_acl_pool{m_ios};
 
   u32 m_PacketCount[MAX_BBMOTES] = {};
   u64 m_last_ticks = 0;
 
+  static void WriteACLPacket(USB::V0BulkMessage& endpoint, u16 conn_handle, const u8* header,
+                             u32 header_size, const u8* payload, u32 payload_size);
+
   // Send ACL data to a device (wiimote)
   void IncDataPacket(u16 _ConnectionHandle);
   void SendToDevice(u16 _ConnectionHandle, u8* _pData, u32 _Size);
@@ -281,11 +281,11 @@ void BluetoothReal::DoState(PointerWrap& p)
     return;
   }
 
-  // Prevent the transfer callbacks from messing with m_current_transfers after we have started
-  // writing a savestate. We cannot use a scoped lock here because DoState is called twice and
-  // we would lose the lock between the two calls.
-  if (p.GetMode() == PointerWrap::MODE_MEASURE || p.GetMode() == PointerWrap::MODE_VERIFY)
-    m_transfers_mutex.lock();
+  // Prevent the transfer callbacks from messing with m_current_transfers while the savestate is
+  // being written. Savestates are written in a single pass, so a scoped lock is enough.
+  std::unique_lock<std::mutex> transfers_lock(m_transfers_mutex, std::defer_lock);
+  if (p.GetMode() != PointerWrap::MODE_READ)
+    transfers_lock.lock();
 
   std::vector<u32> addresses_to_discard;
   if (p.GetMode() != PointerWrap::MODE_READ)
@@ -319,10 +319,6 @@ void BluetoothReal::DoState(PointerWrap& p)
                     OSD::Duration::VERY_LONG);
     s_has_shown_savestate_warning = true;
   }
-
-  // We have finished the savestate now, so the transfers mutex can be unlocked.
-  if (p.GetMode() == PointerWrap::MODE_WRITE)
-    m_transfers_mutex.unlock();
 }
 
 void BluetoothReal::UpdateSyncButtonState(const bool is_held)
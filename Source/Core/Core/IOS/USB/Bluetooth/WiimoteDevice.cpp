@@ -6,6 +6,7 @@
 
 #include <cstring>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -897,27 +898,18 @@ void WiimoteDevice::SendCommandToACL(u8 _Ident, u8 _Code, u8 _CommandLength, u8*
 
 void WiimoteDevice::ReceiveL2capData(u16 scid, const void* _pData, u32 _Size)
 {
-  // Allocate DataFrame
-  u8 DataFrame[1024];
-  u32 Offset = 0;
-  l2cap_hdr_t* pHeader = (l2cap_hdr_t*)DataFrame;
-  Offset += sizeof(l2cap_hdr_t);
-
   // Check if we are already reporting on this channel
   DEBUG_ASSERT(DoesChannelExist(scid));
   SChannel& rChannel = m_Channel[scid];
 
   // Add an additional 4 byte header to the Wiimote report
-  pHeader->dcid = rChannel.DCID;
-  pHeader->length = _Size;
-
-  // Copy the Wiimote report to DataFrame
-  memcpy(DataFrame + Offset, _pData, _Size);
-  // Update Offset to the final size of the report
-  Offset += _Size;
+  l2cap_hdr_t header;
+  header.dcid = rChannel.DCID;
+  header.length = _Size;
 
-  // Send the report
-  m_pHost->SendACLPacket(GetConnectionHandle(), DataFrame, Offset);
+  // Send the report. The header and the report are written to the ACL buffer directly.
+  m_pHost->SendACLPacket(GetConnectionHandle(), reinterpret_cast<const u8*>(&header),
+                         sizeof(header), static_cast<const u8*>(_pData), _Size);
 }
 }  // namespace IOS::HLE
 
@@ -934,8 +926,10 @@ void Callback_WiimoteInterruptChannel(int _number, u16 _channelID, const void* _
   DEBUG_LOG(WIIMOTE, "   Data: %s", ArrayToString(pData, _Size, 50).c_str());
   DEBUG_LOG(WIIMOTE, "   Channel: %x", _channelID);
 
+  // This runs for every report, so the name isn't turned into a new string every time.
+  static const std::string device_name = "/dev/usb/oh1/57e/305";
   const auto bt = std::static_pointer_cast<IOS::HLE::Device::BluetoothEmu>(
-      IOS::HLE::GetIOS()->GetDeviceByName("/dev/usb/oh1/57e/305"));
+      IOS::HLE::GetIOS()->GetDeviceByName(device_name));
   if (bt)
     bt->m_WiiMotes[_number].ReceiveL2capData(_channelID, _pData, _Size);
 }
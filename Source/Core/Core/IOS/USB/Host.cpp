@@ -223,6 +223,12 @@ void USBHost::StartThreads()
     m_event_thread_running.Set();
     m_event_thread = std::thread([this] {
       Common::SetCurrentThreadName("USB Passthrough Thread");
+      // Transfers complete on this thread, and isochronous devices drop data if it is late.
+      if (SConfig::GetInstance().bHighThreadPriority &&
+          !Common::SetCurrentThreadPriority(Common::ThreadPriority::High))
+      {
+        WARN_LOG(IOS_USB, "Could not raise the priority of the USB passthrough thread");
+      }
       while (m_event_thread_running.IsSet())
       {
         if (SConfig::GetInstance().m_usb_passthrough_devices.empty())
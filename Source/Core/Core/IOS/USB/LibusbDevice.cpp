@@ -24,6 +24,11 @@
 
 namespace IOS::HLE::USB
 {
+// The number of isochronous packets in a request is a u8.
+constexpr int MAX_ISO_PACKETS = 0xff;
+// More transfers than this are rarely in flight at once.
+constexpr size_t MAX_POOLED_TRANSFERS = 32;
+
 LibusbDevice::LibusbDevice(Kernel& ios, libusb_device* device,
                            const libusb_device_descriptor& descriptor)
     : m_ios(ios), m_device(device)
@@ -46,6 +51,8 @@ LibusbDevice::~LibusbDevice()
   if (m_handle != nullptr)
     libusb_close(m_handle);
   libusb_unref_device(m_device);
+  for (libusb_transfer* transfer : m_transfer_pool)
+    libusb_free_transfer(transfer);
 }
 
 DeviceDescriptor LibusbDevice::GetDeviceDescriptor() const
@@ -218,8 +225,7 @@ int LibusbDevice::SubmitTransfer(std::unique_ptr<CtrlMessage> cmd)
   libusb_fill_control_setup(buffer.get(), cmd->request_type, cmd->request, cmd->value, cmd->index,
                             cmd->length);
   Memory::CopyFromEmu(buffer.get() + LIBUSB_CONTROL_SETUP_SIZE, cmd->data_address, cmd->length);
-  libusb_transfer* transfer = libusb_alloc_transfer(0);
-  transfer->flags |= LIBUSB_TRANSFER_FREE_TRANSFER;
+  libusb_transfer* transfer = AllocateTransfer();
   libusb_fill_control_transfer(transfer, m_handle, buffer.release(), CtrlTransferCallback, this, 0);
   m_transfer_endpoints[0].AddTransfer(std::move(cmd), transfer);
   return libusb_submit_transfer(transfer);
@@ -230,11 +236,10 @@ int LibusbDevice::SubmitTransfer(std::unique_ptr<BulkMessage> cmd)
   if (!m_device_attached)
     return LIBUSB_ERROR_NOT_FOUND;
 
-  libusb_transfer* transfer = libusb_alloc_transfer(0);
+  libusb_transfer* transfer = AllocateTransfer();
   libusb_fill_bulk_transfer(transfer, m_handle, cmd->endpoint,
                             cmd->MakeBuffer(cmd->length).release(), cmd->length, TransferCallback,
                             this, 0);
-  transfer->flags |= LIBUSB_TRANSFER_FREE_TRANSFER;
   m_transfer_endpoints[transfer->endpoint].AddTransfer(std::move(cmd), transfer);
   return libusb_submit_transfer(transfer);
 }
@@ -244,11 +249,10 @@ int LibusbDevice::SubmitTransfer(std::unique_ptr<IntrMessage> cmd)
   if (!m_device_attached)
     return LIBUSB_ERROR_NOT_FOUND;
 
-  libusb_transfer* transfer = libusb_alloc_transfer(0);
+  libusb_transfer* transfer = AllocateTransfer();
   libusb_fill_interrupt_transfer(transfer, m_handle, cmd->endpoint,
                                  cmd->MakeBuffer(cmd->length).release(), cmd->length,
                                  TransferCallback, this, 0);
-  transfer->flags |= LIBUSB_TRANSFER_FREE_TRANSFER;
   m_transfer_endpoints[transfer->endpoint].AddTransfer(std::move(cmd), transfer);
   return libusb_submit_transfer(transfer);
 }
@@ -258,12 +262,11 @@ int LibusbDevice::SubmitTransfer(std::unique_ptr<IsoMessage> cmd)
   if (!m_device_attached)
     return LIBUSB_ERROR_NOT_FOUND;
 
-  libusb_transfer* transfer = libusb_alloc_transfer(cmd->num_packets);
+  libusb_transfer* transfer = AllocateTransfer();
   transfer->buffer = cmd->MakeBuffer(cmd->length).release();
   transfer->callback = TransferCallback;
   transfer->dev_handle = m_handle;
   transfer->endpoint = cmd->endpoint;
-  transfer->flags |= LIBUSB_TRANSFER_FREE_TRANSFER;
   for (size_t i = 0; i < cmd->num_packets; ++i)
     transfer->iso_packet_desc[i].length = cmd->packet_sizes[i];
   transfer->length = cmd->length;
@@ -283,6 +286,7 @@ void LibusbDevice::CtrlTransferCallback(libusb_transfer* transfer)
     // The return code is the total transfer length -- *including* the setup packet.
     return transfer->length;
   });
+  device->ReleaseTransfer(transfer);
 }
 
 void LibusbDevice::TransferCallback(libusb_transfer* transfer)
@@ -306,6 +310,7 @@ void LibusbDevice::TransferCallback(libusb_transfer* transfer)
       return static_cast<s32>(transfer->actual_length);
     }
   });
+  device->ReleaseTransfer(transfer);
 }
 
 static const std::map<u8, const char*> s_transfer_types = {
@@ -370,6 +375,41 @@ void LibusbDevice::TransferEndpoint::CancelTransfers()
     libusb_cancel_transfer(pending_transfer.first);
 }
 
+libusb_transfer* LibusbDevice::AllocateTransfer()
+{
+  libusb_transfer* transfer = nullptr;
+  {
+    std::lock_guard<std::mutex> lk{m_transfer_pool_mutex};
+    if (!m_transfer_pool.empty())
+    {
+      transfer = m_transfer_pool.back();
+      m_transfer_pool.pop_back();
+    }
+  }
+  if (!transfer)
+    transfer = libusb_alloc_transfer(MAX_ISO_PACKETS);
+
+  // The fill functions don't reset these
+  transfer->flags = 0;
+  transfer->num_iso_packets = 0;
+  return transfer;
+}
+
+// Called from the completion callbacks. libusb allows a transfer to be reused as soon as its
+// callback has run.
+void LibusbDevice::ReleaseTransfer(libusb_transfer* transfer)
+{
+  {
+    std::lock_guard<std::mutex> lk{m_transfer_pool_mutex};
+    if (m_transfer_pool.size() < MAX_POOLED_TRANSFERS)
+    {
+      m_transfer_pool.push_back(transfer);
+      return;
+    }
+  }
+  libusb_free_transfer(transfer);
+}
+
 int LibusbDevice::GetNumberOfAltSettings(const u8 interface_number)
 {
   return m_config_descriptors[0]->Get()->interface[interface_number].num_altsetting;
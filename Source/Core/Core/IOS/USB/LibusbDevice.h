@@ -85,6 +85,14 @@ private:
   static void CtrlTransferCallback(libusb_transfer* transfer);
   static void TransferCallback(libusb_transfer* transfer);
 
+  // Completed transfers are kept for reuse rather than freed, so that streaming devices such as
+  // microphones and cameras don't allocate a transfer for every request. All of them have room for
+  // as many isochronous packets as a request can have.
+  libusb_transfer* AllocateTransfer();
+  void ReleaseTransfer(libusb_transfer* transfer);
+  std::mutex m_transfer_pool_mutex;
+  std::vector<libusb_transfer*> m_transfer_pool;
+
   int AttachInterface(u8 interface);
   int DetachInterface();
 };
@@ -7,10 +7,12 @@
 #include <algorithm>
 #include <array>
 #include <cctype>
+#include <cinttypes>
 #include <iomanip>
 #include <iterator>
 #include <mbedtls/config.h>
 #include <mbedtls/md.h>
+#include <mbedtls/sha1.h>
 #include <mutex>
 #include <sstream>
 #include <thread>
@@ -25,6 +27,7 @@
 #include "Common/File.h"
 #include "Common/FileUtil.h"
 #include "Common/Hash.h"
+#include "Common/Logging/Log.h"
 #include "Common/NandPaths.h"
 #include "Common/StringUtil.h"
 #include "Common/Timer.h"
@@ -39,16 +42,20 @@
 #include "Core/CoreTiming.h"
 #include "Core/DSP/DSPCore.h"
 #include "Core/HW/CPU.h"
+#include "Core/HW/DSP.h"
 #include "Core/HW/DVD/DVDInterface.h"
 #include "Core/HW/EXI/EXI_DeviceIPL.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/ProcessorInterface.h"
 #include "Core/HW/SI/SI.h"
 #include "Core/HW/Wiimote.h"
 #include "Core/HW/WiimoteCommon/WiimoteReport.h"
 #include "Core/HW/WiimoteEmu/WiimoteEmu.h"
+#include "Core/Host.h"
 #include "Core/IOS/USB/Bluetooth/BTEmu.h"
 #include "Core/IOS/USB/Bluetooth/WiimoteDevice.h"
 #include "Core/NetPlayProto.h"
+#include "Core/PowerPC/PowerPC.h"
 #include "Core/State.h"
 
 #include "DiscIO/Enums.h"
@@ -66,6 +73,8 @@ namespace Movie
 static bool s_bReadOnly = true;
 static u32 s_rerecords = 0;
 static PlayMode s_playMode = MODE_NONE;
+static bool s_verify_playback = false;
+static std::string s_verified_playback_hash;
 
 static u8 s_controllers = 0;
 static ControllerState s_padState;
@@ -299,6 +308,16 @@ bool IsPlayingInput()
   return (s_playMode == MODE_PLAYING);
 }
 
+bool IsVerifyingPlayback()
+{
+  return s_verify_playback && s_playMode == MODE_PLAYING;
+}
+
+std::string GetVerifiedPlaybackHash()
+{
+  return s_verified_playback_hash;
+}
+
 bool IsMovieActive()
 {
   return s_playMode != MODE_NONE;
@@ -888,6 +907,8 @@ bool PlayInput(const std::string& movie_path, std::optional<std::string>* savest
   s_currentInputCount = 0;
 
   s_playMode = MODE_PLAYING;
+  s_verify_playback = Config::Get(Config::MAIN_MOVIE_VERIFY_PLAYBACK);
+  s_verified_playback_hash.clear();
 
   // Wiimotes cause desync issues if they're not reset before launching the game
   Wiimote::ResetAllWiimotes();
@@ -1251,9 +1272,35 @@ bool PlayWiimote(int wiimote, u8* data, const WiimoteEmu::ReportFeatures& rptf,
 }
 
 // NOTE: Host / EmuThread / CPU Thread
+// NOTE: CPU Thread
+static std::string GetStateHash()
+{
+  mbedtls_sha1_context ctx;
+  mbedtls_sha1_init(&ctx);
+  mbedtls_sha1_starts(&ctx);
+  mbedtls_sha1_update(&ctx, Memory::m_pRAM, Memory::REALRAM_SIZE);
+  // On Wii, ARAM is mapped to MEM2
+  if (SConfig::GetInstance().bWii)
+    mbedtls_sha1_update(&ctx, Memory::m_pEXRAM, Memory::EXRAM_SIZE);
+  else
+    mbedtls_sha1_update(&ctx, DSP::GetARAMPtr(), DSP::ARAM_SIZE);
+  mbedtls_sha1_update(&ctx, reinterpret_cast<const u8*>(PowerPC::ppcState.gpr),
+                      sizeof(PowerPC::ppcState.gpr));
+  mbedtls_sha1_update(&ctx, reinterpret_cast<const u8*>(PowerPC::ppcState.ps),
+                      sizeof(PowerPC::ppcState.ps));
+  mbedtls_sha1_update(&ctx, reinterpret_cast<const u8*>(&PowerPC::ppcState.pc),
+                      sizeof(PowerPC::ppcState.pc));
+
+  std::array<u8, 20> hash;
+  mbedtls_sha1_finish(&ctx, hash.data());
+  mbedtls_sha1_free(&ctx);
+  return ArrayToString(hash.data(), static_cast<u32>(hash.size()), 0, false);
+}
+
 void EndPlayInput(bool cont)
 {
-  if (cont)
+  // Verified playback always ends with the state hash rather than switching to recording
+  if (cont && !IsVerifyingPlayback())
   {
     // If !IsMovieActive(), changing s_playMode requires calling UpdateWantDeterminism
     ASSERT(IsMovieActive());
@@ -1265,6 +1312,14 @@ void EndPlayInput(bool cont)
   {
     // We can be called by EmuThread during boot (CPU::State::PowerDown)
     bool was_running = Core::IsRunningAndStarted() && !CPU::IsStepping();
+    const bool stop = IsVerifyingPlayback() && was_running && Core::IsCPUThread();
+    if (stop)
+    {
+      s_verified_playback_hash = GetStateHash();
+      NOTICE_LOG(CORE, "Verified movie playback ended at frame %" PRIu64 ", state hash %s",
+                 s_currentFrame, s_verified_playback_hash.c_str());
+      Core::DisplayMessage("Movie state hash: " + s_verified_playback_hash, 10000);
+    }
     if (was_running)
       CPU::Break();
     s_rerecords = 0;
@@ -1280,7 +1335,9 @@ void EndPlayInput(bool cont)
 
     Core::QueueHostJob([=] {
       Core::UpdateWantDeterminism();
-      if (was_running && !SConfig::GetInstance().m_PauseMovie)
+      if (stop)
+        Host_Message(HostMessageID::WMUserStop);
+      else if (was_running && !SConfig::GetInstance().m_PauseMovie)
         CPU::EnableStepping(false);
     });
   }
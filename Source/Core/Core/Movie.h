@@ -126,6 +126,12 @@ bool IsRecordingInputFromSaveState();
 bool IsJustStartingRecordingInputFromSaveState();
 bool IsJustStartingPlayingInputFromSaveState();
 bool IsPlayingInput();
+// Set while playing a movie with MAIN_MOVIE_VERIFY_PLAYBACK enabled. Verified playback runs as fast
+// as possible without presenting frames or outputting audio, and when the movie ends, emulation is
+// stopped after logging a hash of the emulated state, which can be compared between runs.
+bool IsVerifyingPlayback();
+// Returns the state hash of the last verified playback, or an empty string if there was none
+std::string GetVerifiedPlaybackHash();
 bool IsMovieActive();
 bool IsReadOnly();
 u64 GetRecordingStartTime();
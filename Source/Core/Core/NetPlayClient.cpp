@@ -18,7 +18,7 @@
 #include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
 #include "Common/ENetUtil.h"
-#include "Common/MD5.h"
+#include "Common/Hash.h"
 #include "Common/MsgHandler.h"
 #include "Common/QoSSession.h"
 #include "Common/StringUtil.h"
@@ -26,7 +26,9 @@
 #include "Common/Version.h"
 #include "Core/Config/NetplaySettings.h"
 #include "Core/ConfigManager.h"
+#include "Core/Core.h"
 #include "Core/HW/EXI/EXI_DeviceIPL.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/SI/SI.h"
 #include "Core/HW/SI/SI_DeviceGCController.h"
 #include "Core/HW/Sram.h"
@@ -34,6 +36,9 @@
 #include "Core/HW/WiimoteReal/WiimoteReal.h"
 #include "Core/IOS/USB/Bluetooth/BTEmu.h"
 #include "Core/Movie.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/State.h"
+#include "DiscIO/DiscHasher.h"
 #include "InputCommon/GCAdapter.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
@@ -42,6 +47,9 @@ static std::mutex crit_netplay_client;
 static NetPlayClient* netplay_client = nullptr;
 NetSettings g_NetPlaySettings;
 
+// MEM1 is hashed one slice per frame, which keeps the cost of the state hash negligible
+static constexpr u32 STATE_HASH_MEMORY_SLICES = 64;
+
 // called from ---GUI--- thread
 NetPlayClient::~NetPlayClient()
 {
@@ -325,33 +333,43 @@ unsigned int NetPlayClient::OnData(sf::Packet& packet)
 
   case NP_MSG_PAD_DATA:
   {
-    PadMapping map = 0;
-    GCPadStatus pad;
-    packet >> map >> pad.button >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >>
-        pad.substickX >> pad.substickY >> pad.triggerLeft >> pad.triggerRight >> pad.isConnected;
-
-    // Trusting server for good map value (>=0 && <4)
-    // add to pad buffer
-    m_pad_buffer.at(map).Push(pad);
+    while (!packet.endOfPacket())
+    {
+      PadMapping map = 0;
+      GCPadStatus pad;
+      packet >> map >> pad.button >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >>
+          pad.substickX >> pad.substickY >> pad.triggerLeft >> pad.triggerRight >> pad.isConnected;
+      if (!packet)
+        break;
+
+      // Trusting server for good map value (>=0 && <4)
+      // add to pad buffer
+      m_pad_buffer.at(map).Push(pad);
+    }
     m_gc_pad_event.Set();
   }
   break;
 
   case NP_MSG_WIIMOTE_DATA:
   {
-    PadMapping map = 0;
-    NetWiimote nw;
-    u8 size;
-    packet >> map >> size;
+    while (!packet.endOfPacket())
+    {
+      PadMapping map = 0;
+      NetWiimote nw;
+      u8 size;
+      packet >> map >> size;
 
-    nw.resize(size);
+      nw.resize(size);
 
-    for (unsigned int i = 0; i < size; ++i)
-      packet >> nw[i];
+      for (unsigned int i = 0; i < size; ++i)
+        packet >> nw[i];
+      if (!packet)
+        break;
 
-    // Trusting server for good map value (>=0 && <4)
-    // add to Wiimote buffer
-    m_wiimote_buffer.at(map).Push(nw);
+      // Trusting server for good map value (>=0 && <4)
+      // add to Wiimote buffer
+      m_wiimote_buffer.at(map).Push(nw);
+    }
     m_wii_pad_event.Set();
   }
   break;
@@ -495,6 +513,60 @@ unsigned int NetPlayClient::OnData(sf::Packet& packet)
   }
   break;
 
+  case NP_MSG_RESYNC_START:
+  {
+    m_resync_state.clear();
+    m_resync_phase = ResyncPhase::Receiving;
+
+    // stop waiting for input
+    m_gc_pad_event.Set();
+    m_wii_pad_event.Set();
+
+    OSD::AddMessage("Resynchronizing with the host...");
+  }
+  break;
+
+  case NP_MSG_RESYNC_DATA:
+  {
+    u32 total_size;
+    u32 offset;
+    packet >> total_size;
+    packet >> offset;
+
+    // The chunk is the rest of the packet
+    const size_t header_size = sizeof(MessageId) + sizeof(total_size) + sizeof(offset);
+    if (m_resync_phase != ResyncPhase::Receiving || packet.getDataSize() < header_size ||
+        offset > total_size || packet.getDataSize() - header_size > total_size - offset)
+    {
+      break;
+    }
+
+    const size_t chunk_size = packet.getDataSize() - header_size;
+    m_resync_state.resize(total_size);
+    if (chunk_size != 0)
+    {
+      std::memcpy(&m_resync_state[offset],
+                  static_cast<const u8*>(packet.getData()) + header_size, chunk_size);
+    }
+
+    if (offset + chunk_size == total_size)
+      LoadResyncState();
+  }
+  break;
+
+  case NP_MSG_RESYNC_DONE:
+  {
+    // Inputs aren't touched while the state is loaded, so the buffers can be cleared here. The
+    // server sends this after everyone's inputs from before the resync, so none are left over.
+    ClearBuffers();
+    m_timebase_frame = 0;
+    m_resync_phase = ResyncPhase::None;
+    m_resync_event.Set();
+
+    OSD::AddMessage("Resynchronized with the host.");
+  }
+  break;
+
   case NP_MSG_SYNC_GC_SRAM:
   {
     u8 sram[sizeof(g_SRAM.p_SRAM)];
@@ -652,10 +724,15 @@ void NetPlayClient::ThreadFunc()
     if (m_traversal_client)
       m_traversal_client->HandleResends();
     net = enet_host_service(m_client, &netEvent, 250);
-    while (!m_async_queue.Empty())
+    if (!m_async_queue.Empty())
     {
-      Send(m_async_queue.Front());
-      m_async_queue.Pop();
+      while (!m_async_queue.Empty())
+      {
+        Send(m_async_queue.Front());
+        m_async_queue.Pop();
+      }
+      // Send the packets now, rather than after the event has been handled
+      enet_host_flush(m_client);
     }
     if (net > 0)
     {
@@ -760,30 +837,24 @@ void NetPlayClient::SendChatMessage(const std::string& msg)
 }
 
 // called from ---CPU--- thread
-void NetPlayClient::SendPadState(const int in_game_pad, const GCPadStatus& pad)
+void NetPlayClient::AddPadStateToPacket(const int in_game_pad, const GCPadStatus& pad,
+                                        sf::Packet& packet)
 {
-  sf::Packet packet;
-  packet << static_cast<MessageId>(NP_MSG_PAD_DATA);
   packet << static_cast<PadMapping>(in_game_pad);
   packet << pad.button << pad.analogA << pad.analogB << pad.stickX << pad.stickY << pad.substickX
          << pad.substickY << pad.triggerLeft << pad.triggerRight << pad.isConnected;
-
-  SendAsync(std::move(packet));
 }
 
 // called from ---CPU--- thread
-void NetPlayClient::SendWiimoteState(const int in_game_pad, const NetWiimote& nw)
+void NetPlayClient::AddWiimoteStateToPacket(const int in_game_pad, const NetWiimote& nw,
+                                            sf::Packet& packet)
 {
-  sf::Packet packet;
-  packet << static_cast<MessageId>(NP_MSG_WIIMOTE_DATA);
   packet << static_cast<PadMapping>(in_game_pad);
   packet << static_cast<u8>(nw.size());
   for (auto it : nw)
   {
     packet << it;
   }
-
-  SendAsync(std::move(packet));
 }
 
 // called from ---GUI--- thread
@@ -818,6 +889,7 @@ bool NetPlayClient::StartGame(const std::string& path)
   }
 
   m_timebase_frame = 0;
+  m_resync_phase = ResyncPhase::None;
 
   m_is_running.Set();
   NetPlay_Enable(this);
@@ -976,12 +1048,18 @@ bool NetPlayClient::GetNetPads(const int pad_nb, GCPadStatus* pad_status)
   // The slot number is the "local" pad number, and what player
   // it actually means is the "in-game" pad number.
 
+  if (!WaitForResync())
+    return false;
+
   // When the 1st in-game pad is polled, we assume the others will
   // will be polled as well. To reduce latency, we poll all local
   // controllers at once and then send the status to the other
   // clients.
   if (IsFirstInGamePad(pad_nb))
   {
+    sf::Packet packet;
+    packet << static_cast<MessageId>(NP_MSG_PAD_DATA);
+    bool send_packet = false;
     const int num_local_pads = NumLocalPads();
     for (int local_pad = 0; local_pad < num_local_pads; local_pad++)
     {
@@ -1006,16 +1084,20 @@ bool NetPlayClient::GetNetPads(const int pad_nb, GCPadStatus* pad_status)
         m_pad_buffer[ingame_pad].Push(*pad_status);
 
         // send
-        SendPadState(ingame_pad, *pad_status);
+        AddPadStateToPacket(ingame_pad, *pad_status, packet);
+        send_packet = true;
       }
     }
+
+    if (send_packet)
+      SendAsync(std::move(packet));
   }
 
   // Now, we either use the data pushed earlier, or wait for the
   // other clients to send it to us
   while (m_pad_buffer[pad_nb].Size() == 0)
   {
-    if (!m_is_running.IsSet())
+    if (!m_is_running.IsSet() || m_resync_phase != ResyncPhase::None)
     {
       return false;
     }
@@ -1041,6 +1123,10 @@ bool NetPlayClient::GetNetPads(const int pad_nb, GCPadStatus* pad_status)
 // called from ---CPU--- thread
 bool NetPlayClient::WiimoteUpdate(int _number, u8* data, const u8 size, u8 reporting_mode)
 {
+  // While the state is being replaced, the local data is used as is
+  if (!WaitForResync())
+    return m_is_running.IsSet();
+
   NetWiimote nw;
   {
     std::lock_guard<std::recursive_mutex> lkp(m_crit.players);
@@ -1049,15 +1135,18 @@ bool NetPlayClient::WiimoteUpdate(int _number, u8* data, const u8 size, u8 repor
     if (m_wiimote_map[_number] == m_local_player->pid)
     {
       nw.assign(data, data + size);
+      sf::Packet packet;
+      packet << static_cast<MessageId>(NP_MSG_WIIMOTE_DATA);
       do
       {
         // add to buffer
         m_wiimote_buffer[_number].Push(nw);
 
-        SendWiimoteState(_number, nw);
+        AddWiimoteStateToPacket(_number, nw, packet);
       } while (m_wiimote_buffer[_number].Size() <=
                m_target_buffer_size * 200 /
                    120);  // TODO: add a seperate setting for wiimote buffer?
+      SendAsync(std::move(packet));
     }
 
   }  // unlock players
@@ -1068,6 +1157,8 @@ bool NetPlayClient::WiimoteUpdate(int _number, u8* data, const u8 size, u8 repor
     {
       return false;
     }
+    if (m_resync_phase != ResyncPhase::None)
+      return true;
 
     // wait for receiving thread to push some data
     m_wii_pad_event.Wait();
@@ -1088,6 +1179,8 @@ bool NetPlayClient::WiimoteUpdate(int _number, u8* data, const u8 size, u8 repor
         {
           return false;
         }
+        if (m_resync_phase != ResyncPhase::None)
+          return true;
 
         // wait for receiving thread to push some data
         m_wii_pad_event.Wait();
@@ -1120,6 +1213,7 @@ bool NetPlayClient::StopGame()
   // stop waiting for input
   m_gc_pad_event.Set();
   m_wii_pad_event.Set();
+  m_resync_event.Set();
 
   NetPlay_Disable();
 
@@ -1140,6 +1234,7 @@ void NetPlayClient::Stop()
   // stop waiting for input
   m_gc_pad_event.Set();
   m_wii_pad_event.Set();
+  m_resync_event.Set();
 
   // Tell the server to stop if we have a pad mapped in game.
   if (LocalPlayerHasControllerMapped())
@@ -1207,17 +1302,50 @@ int NetPlayClient::LocalPadToInGamePad(int local_pad) const
   return ingame_pad;
 }
 
+// called from ---CPU--- thread
+// A cheap hash of the emulated state, so that desyncs are noticed even when they don't affect the
+// timebase. The CPU registers are hashed every frame, and MEM1 a slice at a time. In dual core
+// mode the GPU thread writes to RAM at times which differ between players, so RAM is only hashed
+// in single core mode. Adler-32 is used because, unlike GetHash64, it gives the same result on
+// every CPU.
+static u64 ComputeStateHash(u32 frame)
+{
+  std::array<u32, 33> registers;
+  std::copy(std::begin(PowerPC::ppcState.gpr), std::end(PowerPC::ppcState.gpr),
+            registers.begin());
+  registers[32] = PowerPC::ppcState.pc;
+  const u32 registers_hash =
+      Common::HashAdler32(reinterpret_cast<const u8*>(registers.data()), sizeof(registers));
+
+  u32 memory_hash = 0;
+  if (!SConfig::GetInstance().bCPUThread && Memory::m_pRAM)
+  {
+    const u32 slice_size = Memory::REALRAM_SIZE / STATE_HASH_MEMORY_SLICES;
+    const u32 slice = frame % STATE_HASH_MEMORY_SLICES;
+    memory_hash = Common::HashAdler32(Memory::m_pRAM + slice * slice_size, slice_size);
+  }
+
+  return static_cast<u64>(registers_hash) << 32 | memory_hash;
+}
+
 void NetPlayClient::SendTimeBase()
 {
   std::lock_guard<std::mutex> lk(crit_netplay_client);
 
+  if (!netplay_client->WaitForResync())
+    return;
+
   u64 timebase = SystemTimers::GetFakeTimeBase();
+  const u32 frame = netplay_client->m_timebase_frame++;
+  const u64 state_hash = ComputeStateHash(frame);
 
   sf::Packet packet;
   packet << static_cast<MessageId>(NP_MSG_TIMEBASE);
   packet << static_cast<u32>(timebase);
   packet << static_cast<u32>(timebase << 32);
-  packet << netplay_client->m_timebase_frame++;
+  packet << frame;
+  packet << static_cast<u32>(state_hash);
+  packet << static_cast<u32>(state_hash >> 32);
 
   netplay_client->SendAsync(std::move(packet));
 }
@@ -1254,7 +1382,7 @@ void NetPlayClient::ComputeMD5(const std::string& file_identifier)
   }
 
   m_MD5_thread = std::thread([this, file]() {
-    std::string sum = MD5::MD5Sum(file, [&](int progress) {
+    std::string sum = DiscIO::ComputeMD5String(file, [&](int progress) {
       sf::Packet packet;
       packet << static_cast<MessageId>(NP_MSG_MD5_PROGRESS);
       packet << progress;
@@ -1271,6 +1399,53 @@ void NetPlayClient::ComputeMD5(const std::string& file_identifier)
   m_MD5_thread.detach();
 }
 
+// called from ---CPU--- thread
+// Returns false if inputs should be skipped, because the state is about to be replaced
+bool NetPlayClient::WaitForResync()
+{
+  while (m_resync_phase == ResyncPhase::Loaded)
+  {
+    if (!m_is_running.IsSet())
+      return false;
+
+    m_resync_event.Wait();
+  }
+
+  return m_resync_phase == ResyncPhase::None && m_is_running.IsSet();
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayClient::LoadResyncState()
+{
+  // Loading the state has to wait for the CPU thread, which may be waiting for this thread to
+  // receive inputs, so it is done by the host instead.
+  Core::QueueHostJob([state = std::move(m_resync_state)] {
+    // The phase has to change before the emulation continues, or it could run past the loaded
+    // state before its inputs are held back.
+    Core::RunAsCPUThread([&] {
+      const bool loaded = state.empty() || State::LoadFromCompressedBuffer(state);
+
+      std::lock_guard<std::mutex> lk(crit_netplay_client);
+      if (netplay_client)
+        netplay_client->OnResyncStateLoaded(loaded);
+    });
+  });
+  m_resync_state.clear();
+}
+
+// called from ---GUI--- thread
+void NetPlayClient::OnResyncStateLoaded(bool loaded)
+{
+  if (!loaded)
+    OSD::AddMessage("Failed to load the host's state.", OSD::Duration::NORMAL, OSD::Color::RED);
+
+  m_resync_phase = ResyncPhase::Loaded;
+
+  sf::Packet packet;
+  packet << static_cast<MessageId>(NP_MSG_RESYNC_LOADED);
+  SendAsync(std::move(packet));
+}
+
 const PadMappingArray& NetPlayClient::GetPadMapping() const
 {
   return m_pad_map;
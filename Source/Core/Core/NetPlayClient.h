@@ -6,6 +6,7 @@
 
 #include <SFML/Network/Packet.hpp>
 #include <array>
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <string>
@@ -139,6 +140,15 @@ protected:
   bool m_is_recording = false;
 
 private:
+  enum class ResyncPhase
+  {
+    None,
+    // The host's state is being received, which replaces anything emulated in the meantime
+    Receiving,
+    // The host's state is loaded, and inputs are held back until all players have loaded it
+    Loaded
+  };
+
   enum class ConnectionState
   {
     WaitingForTraversalClientConnection,
@@ -155,13 +165,18 @@ private:
   void SendStopGamePacket();
 
   void UpdateDevices();
-  void SendPadState(int in_game_pad, const GCPadStatus& np);
-  void SendWiimoteState(int in_game_pad, const NetWiimote& nw);
+  // Pad and Wiimote data packets hold any number of states, so that every state produced by one
+  // poll goes out in a single packet.
+  void AddPadStateToPacket(int in_game_pad, const GCPadStatus& np, sf::Packet& packet);
+  void AddWiimoteStateToPacket(int in_game_pad, const NetWiimote& nw, sf::Packet& packet);
   unsigned int OnData(sf::Packet& packet);
   void Send(const sf::Packet& packet);
   void Disconnect();
   bool Connect();
   void ComputeMD5(const std::string& file_identifier);
+  bool WaitForResync();
+  void LoadResyncState();
+  void OnResyncStateLoaded(bool loaded);
   void DisplayPlayersPing();
   u32 GetPlayersMaxPing() const;
 
@@ -180,6 +195,10 @@ private:
   Common::Event m_wii_pad_event;
 
   u32 m_timebase_frame = 0;
+
+  std::atomic<ResyncPhase> m_resync_phase{ResyncPhase::None};
+  std::vector<u8> m_resync_state;
+  Common::Event m_resync_event;
 };
 
 void NetPlay_Enable(NetPlayClient* const np);
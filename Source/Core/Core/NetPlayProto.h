@@ -72,6 +72,10 @@ enum
 
   NP_MSG_TIMEBASE = 0xB0,
   NP_MSG_DESYNC_DETECTED = 0xB1,
+  NP_MSG_RESYNC_START = 0xB2,
+  NP_MSG_RESYNC_DATA = 0xB3,
+  NP_MSG_RESYNC_LOADED = 0xB4,
+  NP_MSG_RESYNC_DONE = 0xB5,
 
   NP_MSG_COMPUTE_MD5 = 0xC0,
   NP_MSG_MD5_PROGRESS = 0xC1,
@@ -23,8 +23,10 @@
 #include "Common/Version.h"
 #include "Core/Config/NetplaySettings.h"
 #include "Core/ConfigManager.h"
+#include "Core/Core.h"
 #include "Core/HW/Sram.h"
 #include "Core/NetPlayClient.h"  //for NetPlayUI
+#include "Core/State.h"
 #include "InputCommon/GCPadStatus.h"
 
 #if !defined(_WIN32)
@@ -41,6 +43,13 @@
 
 u64 g_netplay_initial_rtc = 1272737767;
 
+// States sent for resynchronization are split into chunks of this size, so that other messages
+// can still get through while a state is being sent.
+static constexpr u32 RESYNC_CHUNK_SIZE = 16 * 1024;
+// The rate at which states are sent to each player is also limited by ENet's congestion control,
+// as a chunk is only queued once the previous one has left ENet's outgoing queue.
+static constexpr u64 RESYNC_MAX_BYTES_PER_SECOND = 8 * 1024 * 1024;
+
 NetPlayServer::~NetPlayServer()
 {
   if (is_connected)
@@ -139,7 +148,9 @@ void NetPlayServer::ThreadFunc()
     int net;
     if (m_traversal_client)
       m_traversal_client->HandleResends();
-    net = enet_host_service(m_server, &netEvent, 1000);
+    if (m_resync_in_progress)
+      SendResyncData();
+    net = enet_host_service(m_server, &netEvent, m_resync_in_progress ? 1 : 1000);
     while (!m_async_queue.Empty())
     {
       {
@@ -397,6 +408,9 @@ unsigned int NetPlayServer::OnDisconnect(const Client& player)
   // alert other players of disconnect
   SendToClients(spac);
 
+  if (m_resync_in_progress)
+    CheckResyncLoaded();
+
   for (PadMapping& mapping : m_pad_map)
   {
     if (mapping == pid)
@@ -523,24 +537,28 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     if (player.current_game != m_current_game)
       break;
 
-    PadMapping map = 0;
-    GCPadStatus pad;
-    packet >> map >> pad.button >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >>
-        pad.substickX >> pad.substickY >> pad.triggerLeft >> pad.triggerRight >> pad.isConnected;
+    // Relay to clients, in one packet like they were received
+    sf::Packet spac;
+    spac << (MessageId)NP_MSG_PAD_DATA;
 
-    // If the data is not from the correct player,
-    // then disconnect them.
-    if (m_pad_map.at(map) != player.pid)
+    while (!packet.endOfPacket())
     {
-      return 1;
-    }
+      PadMapping map = 0;
+      GCPadStatus pad;
+      packet >> map >> pad.button >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >>
+          pad.substickX >> pad.substickY >> pad.triggerLeft >> pad.triggerRight >> pad.isConnected;
+
+      // If the data is not from the correct player,
+      // then disconnect them.
+      if (!packet || m_pad_map.at(map) != player.pid)
+      {
+        return 1;
+      }
 
-    // Relay to clients
-    sf::Packet spac;
-    spac << (MessageId)NP_MSG_PAD_DATA;
-    spac << map << pad.button << pad.analogA << pad.analogB << pad.stickX << pad.stickY
-         << pad.substickX << pad.substickY << pad.triggerLeft << pad.triggerRight
-         << pad.isConnected;
+      spac << map << pad.button << pad.analogA << pad.analogB << pad.stickX << pad.stickY
+           << pad.substickX << pad.substickY << pad.triggerLeft << pad.triggerRight
+           << pad.isConnected;
+    }
 
     SendToClients(spac, player.pid);
   }
@@ -552,27 +570,31 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     if (player.current_game != m_current_game)
       break;
 
-    PadMapping map = 0;
-    u8 size;
-    packet >> map >> size;
-    std::vector<u8> data(size);
-    for (size_t i = 0; i < data.size(); ++i)
-      packet >> data[i];
+    // relay to clients, in one packet like they were received
+    sf::Packet spac;
+    spac << (MessageId)NP_MSG_WIIMOTE_DATA;
 
-    // If the data is not from the correct player,
-    // then disconnect them.
-    if (m_wiimote_map.at(map) != player.pid)
+    while (!packet.endOfPacket())
     {
-      return 1;
-    }
+      PadMapping map = 0;
+      u8 size;
+      packet >> map >> size;
+      std::vector<u8> data(size);
+      for (size_t i = 0; i < data.size(); ++i)
+        packet >> data[i];
+
+      // If the data is not from the correct player,
+      // then disconnect them.
+      if (!packet || m_wiimote_map.at(map) != player.pid)
+      {
+        return 1;
+      }
 
-    // relay to clients
-    sf::Packet spac;
-    spac << (MessageId)NP_MSG_WIIMOTE_DATA;
-    spac << map;
-    spac << size;
-    for (const u8& byte : data)
-      spac << byte;
+      spac << map;
+      spac << size;
+      for (const u8& byte : data)
+        spac << byte;
+    }
 
     SendToClients(spac, player.pid);
   }
@@ -614,6 +636,7 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     SendToClients(spac);
 
     m_is_running = false;
+    m_resync_in_progress = false;
   }
   break;
 
@@ -636,34 +659,40 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
 
   case NP_MSG_TIMEBASE:
   {
-    u32 x, y, frame;
+    u32 x, y, frame, hash_low, hash_high;
     packet >> x;
     packet >> y;
     packet >> frame;
+    packet >> hash_low;
+    packet >> hash_high;
 
-    if (m_desync_detected)
+    if (m_desync_detected || m_resync_in_progress)
       break;
 
     u64 timebase = x | ((u64)y << 32);
-    std::vector<std::pair<PlayerId, u64>>& timebases = m_timebase_by_frame[frame];
-    timebases.emplace_back(player.pid, timebase);
-    if (timebases.size() >= m_players.size())
+    u64 state_hash = hash_low | (static_cast<u64>(hash_high) << 32);
+    std::vector<FrameReport>& reports = m_timebase_by_frame[frame];
+    reports.push_back({player.pid, timebase, state_hash});
+    if (reports.size() >= m_players.size())
     {
       // we have all records for this frame
 
-      if (!std::all_of(timebases.begin(), timebases.end(), [&](std::pair<PlayerId, u64> pair) {
-            return pair.second == timebases[0].second;
-          }))
+      const auto same_state = [](const FrameReport& a, const FrameReport& b) {
+        return a.timebase == b.timebase && a.state_hash == b.state_hash;
+      };
+
+      if (!std::all_of(reports.begin(), reports.end(),
+                       [&](const FrameReport& report) { return same_state(report, reports[0]); }))
       {
         int pid_to_blame = -1;
-        for (auto pair : timebases)
+        for (const FrameReport& report : reports)
         {
-          if (std::all_of(timebases.begin(), timebases.end(), [&](std::pair<PlayerId, u64> other) {
-                return other.first == pair.first || other.second != pair.second;
+          if (std::all_of(reports.begin(), reports.end(), [&](const FrameReport& other) {
+                return other.pid == report.pid || !same_state(other, report);
               }))
           {
             // we are the only outlier
-            pid_to_blame = pair.first;
+            pid_to_blame = report.pid;
             break;
           }
         }
@@ -675,12 +704,23 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
         SendToClients(spac);
 
         m_desync_detected = true;
+        StartResync();
       }
       m_timebase_by_frame.erase(frame);
     }
   }
   break;
 
+  case NP_MSG_RESYNC_LOADED:
+  {
+    if (!m_resync_in_progress)
+      break;
+
+    player.resync_loaded = true;
+    CheckResyncLoaded();
+  }
+  break;
+
   case NP_MSG_MD5_PROGRESS:
   {
     int progress;
@@ -802,6 +842,7 @@ bool NetPlayServer::StartGame()
 {
   m_timebase_by_frame.clear();
   m_desync_detected = false;
+  m_resync_in_progress = false;
   std::lock_guard<std::recursive_mutex> lkg(m_crit.game);
   m_current_game = Common::Timer::GetTimeMs();
 
@@ -842,6 +883,104 @@ bool NetPlayServer::StartGame()
   return true;
 }
 
+// called from ---NETPLAY--- thread
+void NetPlayServer::StartResync()
+{
+  if (m_resync_in_progress)
+    return;
+
+  m_resync_in_progress = true;
+  m_resync_sending = false;
+  for (auto& player_entry : m_players)
+  {
+    player_entry.second.resync_chunks_sent = 0;
+    player_entry.second.resync_loaded = false;
+  }
+
+  // Makes the players stop waiting for inputs, since their current state is going to be replaced
+  sf::Packet spac;
+  spac << static_cast<MessageId>(NP_MSG_RESYNC_START);
+  SendToClients(spac);
+
+  // Saving the state has to wait for the CPU thread, which may be waiting for inputs relayed by
+  // this thread, so it is done by the host instead.
+  m_resync_state = std::make_shared<ResyncState>();
+  Core::QueueHostJob([resync_state = m_resync_state] {
+    std::vector<u8> data;
+    State::SaveToCompressedBuffer(data);
+
+    std::lock_guard<std::mutex> lk(resync_state->mutex);
+    resync_state->data = std::move(data);
+    resync_state->ready = true;
+  });
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayServer::SendResyncData()
+{
+  if (!m_resync_sending)
+  {
+    std::lock_guard<std::mutex> lk(m_resync_state->mutex);
+    if (!m_resync_state->ready)
+      return;
+
+    m_resync_sending = true;
+    m_resync_timer.Start();
+  }
+
+  // The data is no longer modified once it is ready. An empty state is still sent as one empty
+  // chunk, so that the players go on without it.
+  const std::vector<u8>& data = m_resync_state->data;
+  const u32 num_chunks = std::max<u32>(
+      static_cast<u32>((data.size() + RESYNC_CHUNK_SIZE - 1) / RESYNC_CHUNK_SIZE), 1);
+  const u64 allowed_bytes =
+      m_resync_timer.GetTimeElapsed() * RESYNC_MAX_BYTES_PER_SECOND / 1000 + RESYNC_CHUNK_SIZE;
+
+  for (auto& player_entry : m_players)
+  {
+    Client& player = player_entry.second;
+    if (player.resync_chunks_sent == num_chunks ||
+        static_cast<u64>(player.resync_chunks_sent) * RESYNC_CHUNK_SIZE >= allowed_bytes ||
+        !enet_list_empty(&player.socket->outgoingReliableCommands))
+    {
+      continue;
+    }
+
+    // The chunk is the rest of the packet
+    const u32 offset = player.resync_chunks_sent * RESYNC_CHUNK_SIZE;
+    const u32 size = std::min<u32>(RESYNC_CHUNK_SIZE, static_cast<u32>(data.size()) - offset);
+    sf::Packet spac;
+    spac << static_cast<MessageId>(NP_MSG_RESYNC_DATA);
+    spac << static_cast<u32>(data.size());
+    spac << offset;
+    spac.append(data.data() + offset, size);
+
+    Send(player.socket, spac);
+    player.resync_chunks_sent++;
+  }
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayServer::CheckResyncLoaded()
+{
+  if (!std::all_of(m_players.begin(), m_players.end(),
+                   [](const auto& player_entry) { return player_entry.second.resync_loaded; }))
+  {
+    return;
+  }
+
+  m_resync_in_progress = false;
+  m_resync_state.reset();
+  m_timebase_by_frame.clear();
+  m_desync_detected = false;
+
+  // Everyone is waiting with the same state now. Since this is sent after the players' last
+  // inputs from before the resync, they can safely clear their pad buffers when they receive it.
+  sf::Packet spac;
+  spac << static_cast<MessageId>(NP_MSG_RESYNC_DONE);
+  SendToClients(spac);
+}
+
 // called from multiple threads
 void NetPlayServer::SendToClients(const sf::Packet& packet, const PlayerId skip_pid)
 {
@@ -13,6 +13,7 @@
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 #include "Common/QoSSession.h"
 #include "Common/SPSCQueue.h"
 #include "Common/Timer.h"
@@ -75,6 +76,9 @@ private:
 
     Common::QoSSession qos_session;
 
+    u32 resync_chunks_sent = 0;
+    bool resync_loaded = false;
+
     bool operator==(const Client& other) const { return this == &other; }
   };
 
@@ -89,6 +93,9 @@ private:
   void OnConnectFailed(u8) override {}
   void UpdatePadMapping();
   void UpdateWiimoteMapping();
+  void StartResync();
+  void SendResyncData();
+  void CheckResyncLoaded();
   std::vector<std::pair<std::string, std::string>> GetInterfaceListInternal() const;
 
   NetSettings m_settings;
@@ -105,9 +112,32 @@ private:
 
   std::map<PlayerId, Client> m_players;
 
-  std::unordered_map<u32, std::vector<std::pair<PlayerId, u64>>> m_timebase_by_frame;
+  struct FrameReport
+  {
+    PlayerId pid;
+    u64 timebase;
+    u64 state_hash;
+  };
+
+  std::unordered_map<u32, std::vector<FrameReport>> m_timebase_by_frame;
   bool m_desync_detected;
 
+  // When a desync is detected, the host's state is sent to all players, including the host's own
+  // client. Everyone loads it and stays paused until all players have loaded it, so that they
+  // all continue from the same state with empty pad buffers.
+  struct ResyncState
+  {
+    std::mutex mutex;
+    std::vector<u8> data;
+    bool ready = false;
+  };
+
+  bool m_resync_in_progress = false;
+  bool m_resync_sending = false;
+  // Saved by a host job, which may only run after the server is gone
+  std::shared_ptr<ResyncState> m_resync_state;
+  Common::Timer m_resync_timer;
+
   struct
   {
     std::recursive_mutex game;
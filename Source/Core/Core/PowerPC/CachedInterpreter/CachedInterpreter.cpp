@@ -15,39 +15,6 @@
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 
-struct CachedInterpreter::Instruction
-{
-  using CommonCallback = void (*)(UGeckoInstruction);
-  using ConditionalCallback = bool (*)(u32);
-
-  Instruction() {}
-  Instruction(const CommonCallback c, UGeckoInstruction i)
-      : common_callback(c), data(i.hex), type(Type::Common)
-  {
-  }
-
-  Instruction(const ConditionalCallback c, u32 d)
-      : conditional_callback(c), data(d), type(Type::Conditional)
-  {
-  }
-
-  enum class Type
-  {
-    Abort,
-    Common,
-    Conditional,
-  };
-
-  union
-  {
-    const CommonCallback common_callback;
-    const ConditionalCallback conditional_callback;
-  };
-
-  u32 data = 0;
-  Type type = Type::Abort;
-};
-
 CachedInterpreter::CachedInterpreter() : code_buffer(32000)
 {
 }
@@ -87,8 +54,11 @@ void CachedInterpreter::ExecuteOneBlock()
     return;
   }
 
-  const Instruction* code = reinterpret_cast<const Instruction*>(normal_entry);
+  ExecuteInstructions(reinterpret_cast<const Instruction*>(normal_entry));
+}
 
+void CachedInterpreter::ExecuteInstructions(const Instruction* code)
+{
   for (; code->type != Instruction::Type::Abort; ++code)
   {
     switch (code->type)
@@ -102,6 +72,10 @@ void CachedInterpreter::ExecuteOneBlock()
         return;
       break;
 
+    case Instruction::Type::Fused:
+      code->fused_callback(code->data, code->data2);
+      break;
+
     default:
       ERROR_LOG(POWERPC, "Unknown CachedInterpreter Instruction: %d", static_cast<int>(code->type));
       break;
@@ -148,6 +122,24 @@ static void WriteBrokenBlockNPC(UGeckoInstruction data)
   NPC = data.hex;
 }
 
+static bool CheckBranch(u32 data)
+{
+  // A branch in the middle of the block went somewhere other than the next compiled instruction.
+  return PC != data;
+}
+
+static void SetRegister(u32 reg, u32 value)
+{
+  rGPR[reg] = value;
+}
+
+template <Interpreter::Instruction First, Interpreter::Instruction Second>
+static void FusedPair(u32 first, u32 second)
+{
+  First(UGeckoInstruction(first));
+  Second(UGeckoInstruction(second));
+}
+
 static bool CheckFPU(u32 data)
 {
   if (!MSR.FP)
@@ -171,17 +163,48 @@ static bool CheckDSI(u32 data)
   return false;
 }
 
-bool CachedInterpreter::HandleFunctionHooking(u32 address)
+CachedInterpreter::Instruction::FusedCallback
+CachedInterpreter::GetFusedOp(Interpreter::Instruction first, Interpreter::Instruction second)
+{
+  struct FusedOp
+  {
+    Interpreter::Instruction first;
+    Interpreter::Instruction second;
+    Instruction::FusedCallback callback;
+  };
+
+  // Frequent pairs which are run through a single dispatch rather than two.
+  static const FusedOp fused_ops[] = {
+      {Interpreter::lwz, Interpreter::addi, FusedPair<Interpreter::lwz, Interpreter::addi>},
+      {Interpreter::lwz, Interpreter::lwz, FusedPair<Interpreter::lwz, Interpreter::lwz>},
+      {Interpreter::lwz, Interpreter::cmpi, FusedPair<Interpreter::lwz, Interpreter::cmpi>},
+      {Interpreter::lwz, Interpreter::cmpli, FusedPair<Interpreter::lwz, Interpreter::cmpli>},
+      {Interpreter::stw, Interpreter::stw, FusedPair<Interpreter::stw, Interpreter::stw>},
+      {Interpreter::addi, Interpreter::addi, FusedPair<Interpreter::addi, Interpreter::addi>},
+      {Interpreter::psq_l, Interpreter::psq_l, FusedPair<Interpreter::psq_l, Interpreter::psq_l>},
+      {Interpreter::psq_l, Interpreter::ps_mul, FusedPair<Interpreter::psq_l, Interpreter::ps_mul>},
+  };
+
+  for (const FusedOp& op : fused_ops)
+  {
+    if (op.first == first && op.second == second)
+      return op.callback;
+  }
+  return nullptr;
+}
+
+bool CachedInterpreter::HandleFunctionHooking(std::vector<Instruction>* code, u32 address,
+                                              int downcount_amount)
 {
   return HLE::ReplaceFunctionIfPossible(address, [&](u32 function, HLE::HookType type) {
-    m_code.emplace_back(WritePC, address);
-    m_code.emplace_back(Interpreter::HLEFunction, function);
+    code->emplace_back(WritePC, address);
+    code->emplace_back(Interpreter::HLEFunction, function);
 
     if (type != HLE::HookType::Replace)
       return false;
 
-    m_code.emplace_back(EndBlock, js.downcountAmount);
-    m_code.emplace_back();
+    code->emplace_back(EndBlock, downcount_amount);
+    code->emplace_back();
     return true;
   });
 }
@@ -194,7 +217,7 @@ void CachedInterpreter::Jit(u32 address)
     ClearCache();
   }
 
-  const u32 nextPC = analyzer.Analyze(PC, &code_block, &code_buffer, code_buffer.size());
+  const u32 nextPC = AnalyzeBlock(PC, &code_buffer, code_buffer.size());
   if (code_block.m_memory_exception)
   {
     // Address of instruction could not be translated
@@ -207,57 +230,101 @@ void CachedInterpreter::Jit(u32 address)
 
   JitBlock* b = m_block_cache.AllocateBlock(PC);
 
-  js.blockStart = PC;
-  js.firstFPInstructionFound = false;
-  js.fifoBytesSinceCheck = 0;
-  js.downcountAmount = 0;
-  js.curBlock = b;
-
   b->checkedEntry = GetCodePtr();
   b->normalEntry = GetCodePtr();
 
+  CompileInstructions(&m_code, code_block, code_buffer, nextPC, jo.memcheck);
+
+  b->codeSize = (u32)(GetCodePtr() - b->checkedEntry);
+  b->originalSize = code_block.m_num_instructions;
+
+  m_block_cache.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
+}
+
+void CachedInterpreter::CompileInstructions(std::vector<Instruction>* code,
+                                            const PPCAnalyst::CodeBlock& code_block,
+                                            const PPCAnalyst::CodeBuffer& code_buffer,
+                                            u32 next_pc, bool memcheck)
+{
+  bool first_fp_instruction_found = false;
+  int downcount_amount = 0;
+
   for (u32 i = 0; i < code_block.m_num_instructions; i++)
   {
-    PPCAnalyst::CodeOp& op = code_buffer[i];
+    const PPCAnalyst::CodeOp& op = code_buffer[i];
 
-    js.downcountAmount += op.opinfo->numCycles;
+    downcount_amount += op.opinfo->numCycles;
 
-    if (HandleFunctionHooking(op.address))
+    if (HandleFunctionHooking(code, op.address, downcount_amount))
       break;
 
     if (!op.skip)
     {
-      const bool check_fpu = (op.opinfo->flags & FL_USE_FPU) && !js.firstFPInstructionFound;
+      const bool check_fpu = (op.opinfo->flags & FL_USE_FPU) && !first_fp_instruction_found;
       const bool endblock = (op.opinfo->flags & FL_ENDBLOCK) != 0;
-      const bool memcheck = (op.opinfo->flags & FL_LOADSTORE) && jo.memcheck;
+      const bool check_dsi = (op.opinfo->flags & FL_LOADSTORE) && memcheck;
 
       if (check_fpu)
       {
-        m_code.emplace_back(WritePC, op.address);
-        m_code.emplace_back(CheckFPU, js.downcountAmount);
-        js.firstFPInstructionFound = true;
+        code->emplace_back(WritePC, op.address);
+        code->emplace_back(CheckFPU, downcount_amount);
+        first_fp_instruction_found = true;
       }
 
-      if (endblock || memcheck)
-        m_code.emplace_back(WritePC, op.address);
-      m_code.emplace_back(PPCTables::GetInterpreterOp(op.inst), op.inst);
-      if (memcheck)
-        m_code.emplace_back(CheckDSI, js.downcountAmount);
+      // Pair this instruction up with the next one if neither needs any bookkeeping of its own.
+      const PPCAnalyst::CodeOp* next =
+          i + 1 < code_block.m_num_instructions ? &code_buffer[i + 1] : nullptr;
+      Instruction::FusedCallback fused = nullptr;
+      if (!endblock && !check_dsi && op.constGprOut < 0 && next && !next->skip &&
+          next->constGprOut < 0 && !(next->opinfo->flags & FL_ENDBLOCK) &&
+          !((next->opinfo->flags & FL_LOADSTORE) && memcheck) &&
+          !((next->opinfo->flags & FL_USE_FPU) && !first_fp_instruction_found) &&
+          HLE::GetFirstFunctionIndex(next->address) == 0)
+      {
+        fused = GetFusedOp(PPCTables::GetInterpreterOp(op.inst),
+                           PPCTables::GetInterpreterOp(next->inst));
+      }
+
+      if (endblock || check_dsi)
+        code->emplace_back(WritePC, op.address);
+      if (op.constGprOut >= 0)
+      {
+        // The analyzer already knows the result, so skip decoding the instruction entirely.
+        code->emplace_back(SetRegister, op.constGprOut, op.constValue);
+      }
+      else if (fused)
+      {
+        code->emplace_back(fused, op.inst.hex, next->inst.hex);
+        downcount_amount += next->opinfo->numCycles;
+        i++;
+      }
+      else
+      {
+        code->emplace_back(PPCTables::GetInterpreterOp(op.inst), op.inst);
+      }
+      if (check_dsi)
+        code->emplace_back(CheckDSI, downcount_amount);
       if (endblock)
-        m_code.emplace_back(EndBlock, js.downcountAmount);
+      {
+        code->emplace_back(EndBlock, downcount_amount);
+
+        // Blocks analyzed with conditional continue or trace following carry on past branches,
+        // so check that execution actually continues with the next instruction. The downcount
+        // up to here has been paid for already.
+        if (i + 1 < code_block.m_num_instructions)
+        {
+          code->emplace_back(CheckBranch, code_buffer[i + 1].address);
+          downcount_amount = 0;
+        }
+      }
     }
   }
   if (code_block.m_broken)
   {
-    m_code.emplace_back(WriteBrokenBlockNPC, nextPC);
-    m_code.emplace_back(EndBlock, js.downcountAmount);
+    code->emplace_back(WriteBrokenBlockNPC, next_pc);
+    code->emplace_back(EndBlock, downcount_amount);
   }
-  m_code.emplace_back();
-
-  b->codeSize = (u32)(GetCodePtr() - b->checkedEntry);
-  b->originalSize = code_block.m_num_instructions;
-
-  m_block_cache.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
+  code->emplace_back();
 }
 
 void CachedInterpreter::ClearCache()
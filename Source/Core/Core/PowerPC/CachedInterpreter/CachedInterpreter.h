@@ -8,6 +8,8 @@
 
 #include "Common/CommonTypes.h"
 #include "Core/PowerPC/CachedInterpreter/InterpreterBlockCache.h"
+#include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 
@@ -32,13 +34,64 @@ public:
   const char* GetName() const override { return "Cached Interpreter"; }
   const CommonAsmRoutinesBase* GetAsmRoutines() override { return nullptr; }
 
-private:
-  struct Instruction;
+  struct Instruction
+  {
+    using CommonCallback = void (*)(UGeckoInstruction);
+    using ConditionalCallback = bool (*)(u32);
+    using FusedCallback = void (*)(u32, u32);
+
+    Instruction() {}
+    Instruction(const CommonCallback c, UGeckoInstruction i)
+        : common_callback(c), data(i.hex), type(Type::Common)
+    {
+    }
+
+    Instruction(const ConditionalCallback c, u32 d)
+        : conditional_callback(c), data(d), type(Type::Conditional)
+    {
+    }
+
+    Instruction(const FusedCallback c, u32 d, u32 d2)
+        : fused_callback(c), data(d), data2(d2), type(Type::Fused)
+    {
+    }
+
+    enum class Type
+    {
+      Abort,
+      Common,
+      Conditional,
+      Fused,
+    };
 
+    union
+    {
+      const CommonCallback common_callback;
+      const ConditionalCallback conditional_callback;
+      const FusedCallback fused_callback;
+    };
+
+    u32 data = 0;
+    u32 data2 = 0;
+    Type type = Type::Abort;
+  };
+
+  // Translates an analyzed block into a list of interpreter calls terminated by an Abort entry.
+  // This is also used by the cold tier of the tiered JITs, which share the same format.
+  static void CompileInstructions(std::vector<Instruction>* code,
+                                  const PPCAnalyst::CodeBlock& code_block,
+                                  const PPCAnalyst::CodeBuffer& code_buffer, u32 next_pc,
+                                  bool memcheck);
+  static void ExecuteInstructions(const Instruction* code);
+
+private:
   const u8* GetCodePtr() const;
   void ExecuteOneBlock();
 
-  bool HandleFunctionHooking(u32 address);
+  static Instruction::FusedCallback GetFusedOp(Interpreter::Instruction first,
+                                              Interpreter::Instruction second);
+  static bool HandleFunctionHooking(std::vector<Instruction>* code, u32 address,
+                                    int downcount_amount);
 
   BlockCache m_block_cache{*this};
   std::vector<Instruction> m_code;
@@ -19,15 +19,19 @@
 #endif
 
 #include "Common/Logging/Log.h"
+#include "Core/CoreTiming.h"
 #include "Core/HW/CPU.h"
 #include "Core/HW/Memmap.h"
+#include "Core/HW/SystemTimers.h"
 #include "Core/Host.h"
 #include "Core/PowerPC/GDBStub.h"
 #include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PPCCache.h"
 #include "Core/PowerPC/PowerPC.h"
 
-#define GDB_BFR_MAX 10000
+// Large enough for reads of 128 KiB per packet, which gdb is told about through qSupported
+#define GDB_BFR_MAX 0x40000
 #define GDB_MAX_BP 10
 
 #define GDB_STUB_START '$'
@@ -41,6 +45,17 @@ static int sock = -1;
 static u8 cmd_bfr[GDB_BFR_MAX];
 static u32 cmd_len;
 
+// Received bytes which haven't been read yet
+static u8 recv_bfr[4096];
+static u32 recv_pos;
+static u32 recv_len;
+
+// Memory and breakpoint requests don't need the CPU to be stopped, so they are also answered while
+// it runs, from this event on the CPU thread. This way, tools which read memory repeatedly don't
+// have to interrupt the game for every request.
+static CoreTiming::EventType* poll_event;
+static const int POLL_RATE = 120;  // Polls per second
+
 static u32 sig = 0;
 static u32 send_signal = 0;
 static u32 step_break = 0;
@@ -101,18 +116,30 @@ static void hex2mem(u8* dst, u8* src, u32 len)
   }
 }
 
-static u8 gdb_read_byte()
+static u8 gdb_peek_byte()
 {
-  ssize_t res;
-  u8 c = '+';
-
-  res = recv(sock, &c, 1, MSG_WAITALL);
-  if (res != 1)
+  if (recv_pos == recv_len)
   {
-    ERROR_LOG(GDB_STUB, "recv failed : %ld", res);
-    gdb_deinit();
+    recv_pos = 0;
+    recv_len = 0;
+    ssize_t res = recv(sock, (char*)recv_bfr, sizeof recv_bfr, 0);
+    if (res <= 0)
+    {
+      ERROR_LOG(GDB_STUB, "recv failed : %ld", res);
+      gdb_deinit();
+      return '+';
+    }
+    recv_len = static_cast<u32>(res);
   }
 
+  return recv_bfr[recv_pos];
+}
+
+static u8 gdb_read_byte()
+{
+  u8 c = gdb_peek_byte();
+  if (recv_pos != recv_len)
+    recv_pos++;
   return c;
 }
 
@@ -261,7 +288,7 @@ static void gdb_read_command()
     return;
   }
 
-  while ((c = gdb_read_byte()) != GDB_STUB_END)
+  while (gdb_active() && (c = gdb_read_byte()) != GDB_STUB_END)
   {
     cmd_bfr[cmd_len++] = c;
     if (cmd_len == sizeof cmd_bfr)
@@ -271,6 +298,11 @@ static void gdb_read_command()
       return;
     }
   }
+  if (!gdb_active())
+  {
+    cmd_len = 0;
+    return;
+  }
 
   chk_read = hex2char(gdb_read_byte()) << 4;
   chk_read |= hex2char(gdb_read_byte());
@@ -297,6 +329,9 @@ static int gdb_data_available()
   struct timeval t;
   fd_set _fds, *fds = &_fds;
 
+  if (recv_pos != recv_len)
+    return 1;
+
   FD_ZERO(fds);
   FD_SET(sock, fds);
 
@@ -366,6 +401,13 @@ static void gdb_handle_query()
     return gdb_reply("T0");
   }
 
+  if (!strncmp((const char*)(cmd_bfr + 1), "Supported", 9))
+  {
+    char bfr[32];
+    sprintf(bfr, "PacketSize=%x", GDB_BFR_MAX - 4);
+    return gdb_reply(bfr);
+  }
+
   gdb_reply("");
 }
 
@@ -559,54 +601,110 @@ static void gdb_write_register()
   gdb_reply("OK");
 }
 
-static void gdb_read_mem()
+// Returns the host pointer of len bytes of emulated memory at addr (masked like
+// Memory::GetPointer), or nullptr if they aren't all in the same region. Unlike
+// Memory::GetPointer, this doesn't alert about invalid addresses, which debuggers read routinely.
+static u8* gdb_get_mem_pointer(u32 addr, u32 len)
 {
-  static u8 reply[GDB_BFR_MAX - 4];
-  u32 addr, len;
-  u32 i;
+  const u32 physical = addr & 0x3FFFFFFF;
+  const u32 size = len != 0 ? len : 1;
+  if (physical < Memory::REALRAM_SIZE && Memory::REALRAM_SIZE - physical >= size)
+    return Memory::m_pRAM + physical;
+
+  const u32 exram_offset = physical - 0x10000000;
+  if (Memory::m_pEXRAM && physical >= 0x10000000 && exram_offset < Memory::EXRAM_SIZE &&
+      Memory::EXRAM_SIZE - exram_offset >= size)
+  {
+    return Memory::m_pEXRAM + exram_offset;
+  }
 
-  i = 1;
-  addr = 0;
-  while (cmd_bfr[i] != ',')
-    addr = (addr << 4) | hex2char(cmd_bfr[i++]);
+  return nullptr;
+}
+
+// Parses the "addr,len" of memory packets, followed by the given terminator.
+// Returns the index of the terminator.
+static u32 gdb_parse_mem_range(u32* addr, u32* len, u8 terminator)
+{
+  u32 i = 1;
+  *addr = 0;
+  while (i < cmd_len && cmd_bfr[i] != ',')
+    *addr = (*addr << 4) | hex2char(cmd_bfr[i++]);
   i++;
 
-  len = 0;
-  while (i < cmd_len)
-    len = (len << 4) | hex2char(cmd_bfr[i++]);
+  *len = 0;
+  while (i < cmd_len && cmd_bfr[i] != terminator)
+    *len = (*len << 4) | hex2char(cmd_bfr[i++]);
+  return i;
+}
+
+static void gdb_read_mem()
+{
+  // The hex data and its null terminator
+  static u8 reply[GDB_BFR_MAX - 3];
+  u32 addr, len;
+
+  gdb_parse_mem_range(&addr, &len, '\0');
   DEBUG_LOG(GDB_STUB, "gdb: read memory: %08x bytes from %08x", len, addr);
 
-  if (len * 2 > sizeof reply)
-    gdb_reply("E01");
-  u8* data = Memory::GetPointer(addr);
+  if (len > (sizeof reply - 1) / 2)
+    return gdb_reply("E01");
+  u8* data = gdb_get_mem_pointer(addr, len);
   if (!data)
-    return gdb_reply("E0");
+    return gdb_reply("E01");
   mem2hex(reply, data, len);
   reply[len * 2] = '\0';
   gdb_reply((char*)reply);
 }
 
-static void gdb_write_mem()
+// Returns whether the memory was written
+static bool gdb_write_mem()
 {
   u32 addr, len;
-  u32 i;
-
-  i = 1;
-  addr = 0;
-  while (cmd_bfr[i] != ',')
-    addr = (addr << 4) | hex2char(cmd_bfr[i++]);
-  i++;
-
-  len = 0;
-  while (cmd_bfr[i] != ':')
-    len = (len << 4) | hex2char(cmd_bfr[i++]);
+  u32 i = gdb_parse_mem_range(&addr, &len, ':');
   DEBUG_LOG(GDB_STUB, "gdb: write memory: %08x bytes to %08x", len, addr);
 
-  u8* dst = Memory::GetPointer(addr);
-  if (!dst)
-    return gdb_reply("E00");
+  u8* dst = gdb_get_mem_pointer(addr, len);
+  if (!dst || i + 1 + u64(len) * 2 > cmd_len)
+  {
+    gdb_reply("E01");
+    return false;
+  }
   hex2mem(dst, cmd_bfr + i + 1, len);
   gdb_reply("OK");
+  return true;
+}
+
+// Like gdb_write_mem, but for the X packet, whose data is binary, with '}' escaping the next byte
+static bool gdb_write_mem_binary()
+{
+  static u8 data[GDB_BFR_MAX];
+  u32 addr, len;
+  u32 i = gdb_parse_mem_range(&addr, &len, ':') + 1;
+  DEBUG_LOG(GDB_STUB, "gdb: write binary memory: %08x bytes to %08x", len, addr);
+
+  u8* dst = gdb_get_mem_pointer(addr, len);
+  if (!dst || len > sizeof data)
+  {
+    gdb_reply("E01");
+    return false;
+  }
+
+  for (u32 n = 0; n < len; n++, i++)
+  {
+    const bool escaped = i < cmd_len && cmd_bfr[i] == '}';
+    if (escaped)
+      i++;
+    if (i >= cmd_len)
+    {
+      gdb_reply("E01");
+      return false;
+    }
+    data[n] = escaped ? cmd_bfr[i] ^ 0x20 : cmd_bfr[i];
+  }
+
+  memcpy(dst, data, len);
+  gdb_reply("OK");
+  return true;
 }
 
 // forces a break on next instruction check
@@ -759,9 +857,12 @@ void gdb_handle_exception()
       gdb_read_mem();
       break;
     case 'M':
-      gdb_write_mem();
-      PowerPC::ppcState.iCache.Reset();
-      Host_UpdateDisasmDialog();
+    case 'X':
+      if (cmd_bfr[0] == 'M' ? gdb_write_mem() : gdb_write_mem_binary())
+      {
+        PowerPC::ppcState.iCache.Reset();
+        Host_UpdateDisasmDialog();
+      }
       break;
     case 's':
       gdb_step();
@@ -783,6 +884,68 @@ void gdb_handle_exception()
   }
 }
 
+// Makes the running CPU see code written by gdb, without throwing away all of the JIT's blocks
+static void gdb_invalidate_code(u32 addr, u32 len)
+{
+  u32 i;
+  const u32 aligned_addr = addr & ~0x1f;
+  // The instruction cache has 128 sets of 32 bytes, so a larger range clears all of them anyway
+  for (i = 0; i < len + (addr - aligned_addr) && i < 128 * 32; i += 32)
+    PowerPC::ppcState.iCache.Invalidate(aligned_addr + i);
+  JitInterface::InvalidateICache(addr, len, true);
+}
+
+static void gdb_poll(u64 userdata, s64 cycles_late)
+{
+  while (gdb_active() && gdb_data_available())
+  {
+    // An interrupt stops the CPU at the next instruction, like a step
+    if (gdb_peek_byte() == 0x03)
+    {
+      gdb_read_byte();
+      gdb_break();
+      continue;
+    }
+
+    gdb_read_command();
+    if (cmd_len == 0)
+      continue;
+
+    u32 addr, len;
+    switch (cmd_bfr[0])
+    {
+    case 'q':
+      gdb_handle_query();
+      break;
+    case 'm':
+      gdb_read_mem();
+      break;
+    case 'M':
+    case 'X':
+      gdb_parse_mem_range(&addr, &len, ':');
+      if (cmd_bfr[0] == 'M' ? gdb_write_mem() : gdb_write_mem_binary())
+        gdb_invalidate_code(addr, len);
+      break;
+    case 'z':
+      gdb_remove_bp();
+      break;
+    case 'Z':
+      _gdb_add_bp();
+      break;
+    default:
+      // Everything else needs the CPU to be stopped
+      gdb_reply("E01");
+      break;
+    }
+  }
+
+  if (gdb_active())
+  {
+    CoreTiming::ScheduleEvent(SystemTimers::GetTicksPerSecond() / POLL_RATE - cycles_late,
+                              poll_event);
+  }
+}
+
 #ifdef _WIN32
 WSADATA InitData;
 #endif
@@ -858,10 +1021,20 @@ static void gdb_init_generic(int domain, const sockaddr* server_addr, socklen_t
 
   close(tmpsock);
   tmpsock = -1;
+
+  recv_pos = 0;
+  recv_len = 0;
+  poll_event = CoreTiming::RegisterEvent("GDBStubPoll", gdb_poll);
+  CoreTiming::ScheduleEvent(0, poll_event);
 }
 
 void gdb_deinit()
 {
+  if (poll_event)
+  {
+    CoreTiming::RemoveEvent(poll_event);
+    poll_event = nullptr;
+  }
   if (tmpsock != -1)
   {
     shutdown(tmpsock, SHUT_RDWR);
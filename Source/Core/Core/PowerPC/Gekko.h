@@ -726,6 +726,7 @@ union UReg_PTE
 // branches
 enum
 {
+  BO_REVERSE_PREDICTION = 1,     // 4
   BO_BRANCH_IF_CTR_0 = 2,        // 3
   BO_DONT_DECREMENT_FLAG = 4,    // 2
   BO_BRANCH_IF_TRUE = 8,         // 1
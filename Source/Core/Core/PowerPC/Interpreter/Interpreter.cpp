@@ -42,6 +42,7 @@ std::array<Interpreter::Instruction, 1024> Interpreter::m_op_table19;
 std::array<Interpreter::Instruction, 1024> Interpreter::m_op_table31;
 std::array<Interpreter::Instruction, 32> Interpreter::m_op_table59;
 std::array<Interpreter::Instruction, 1024> Interpreter::m_op_table63;
+std::array<Interpreter::DecodedInstruction, 4096> Interpreter::m_decode_cache;
 
 void Interpreter::RunTable4(UGeckoInstruction inst)
 {
@@ -64,9 +65,29 @@ void Interpreter::RunTable63(UGeckoInstruction inst)
   m_op_table63[inst.SUBOP10](inst);
 }
 
+const Interpreter::DecodedInstruction& Interpreter::Decode(UGeckoInstruction inst)
+{
+  // Multiplicative hashing, as the opcode is in the upper bits and the registers in the lower ones
+  const u32 index = (inst.hex * 0x9E3779B1) >> 20;
+  DecodedInstruction& entry = m_decode_cache[index];
+  if (entry.hex != inst.hex || !entry.info)
+  {
+    entry.hex = inst.hex;
+    entry.function = PPCTables::GetInterpreterOp(inst);
+    entry.info = PPCTables::GetOpInfo(inst);
+  }
+  return entry;
+}
+
+void Interpreter::ClearDecodeCache()
+{
+  m_decode_cache.fill({});
+}
+
 void Interpreter::Init()
 {
   InitializeInstructionTables();
+  ClearDecodeCache();
   m_reserve = false;
   m_end_block = false;
 }
@@ -138,9 +159,10 @@ int Interpreter::SingleStepInner()
 
     if (m_prev_inst.hex != 0)
     {
+      const DecodedInstruction& decoded = Decode(m_prev_inst);
       if (MSR.FP)  // If FPU is enabled, just execute
       {
-        m_op_table[m_prev_inst.OPCD](m_prev_inst);
+        decoded.function(m_prev_inst);
         if (PowerPC::ppcState.Exceptions & EXCEPTION_DSI)
         {
           PowerPC::CheckExceptions();
@@ -150,9 +172,9 @@ int Interpreter::SingleStepInner()
       else
       {
         // check if we have to generate a FPU unavailable exception
-        if (!PPCTables::UsesFPU(m_prev_inst))
+        if (!(decoded.info->flags & FL_USE_FPU))
         {
-          m_op_table[m_prev_inst.OPCD](m_prev_inst);
+          decoded.function(m_prev_inst);
           if (PowerPC::ppcState.Exceptions & EXCEPTION_DSI)
           {
             PowerPC::CheckExceptions();
@@ -177,8 +199,7 @@ int Interpreter::SingleStepInner()
   last_pc = PC;
   PC = NPC;
 
-  const GekkoOPInfo* opinfo = PPCTables::GetOpInfo(m_prev_inst);
-  return opinfo->numCycles;
+  return Decode(m_prev_inst).info->numCycles;
 }
 
 void Interpreter::SingleStep()
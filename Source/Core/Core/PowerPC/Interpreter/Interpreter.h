@@ -10,6 +10,8 @@
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/Gekko.h"
 
+struct GekkoOPInfo;
+
 class Interpreter : public CPUCoreBase
 {
 public:
@@ -286,6 +288,20 @@ private:
 
   static bool HandleFunctionHooking(u32 address);
 
+  // The result of decoding an instruction word, so that the tables don't need to be walked again
+  // each time the instruction is executed. The cache is indexed by the instruction word rather
+  // than by address, so the emulated instruction cache is still used for every fetch and nothing
+  // needs to be invalidated when code is modified.
+  struct DecodedInstruction
+  {
+    u32 hex;
+    Instruction function;
+    const GekkoOPInfo* info;
+  };
+  static const DecodedInstruction& Decode(UGeckoInstruction inst);
+  static void ClearDecodeCache();
+  static std::array<DecodedInstruction, 4096> m_decode_cache;
+
   // flag helper
   static void Helper_UpdateCR0(u32 value);
 
@@ -4,6 +4,7 @@
 
 #include "Core/PowerPC/Jit64/Jit.h"
 
+#include <algorithm>
 #include <map>
 #include <string>
 
@@ -25,6 +26,7 @@
 #include "Core/HW/CPU.h"
 #include "Core/HW/GPFifo.h"
 #include "Core/HW/ProcessorInterface.h"
+#include "Core/HW/SystemTimers.h"
 #include "Core/PatchEngine.h"
 #include "Core/PowerPC/Jit64/JitAsm.h"
 #include "Core/PowerPC/Jit64/JitRegCache.h"
@@ -252,6 +254,20 @@ void Jit64::Init()
   m_far_code.Init();
   Clear();
 
+  const size_t code_segments =
+      static_cast<size_t>(std::clamp(SConfig::GetInstance().iJITCodeSegments, 1, 16));
+  SetSegmentCount(code_segments);
+  m_far_code.SetSegmentCount(code_segments);
+
+  m_tier_up_threshold = static_cast<u32>(std::max(SConfig::GetInstance().iJITTierUpThreshold, 0));
+  if (m_tier_up_threshold != 0)
+    m_cold_code.reserve(COLD_CODE_ELEMENTS);
+  m_tier_up_budget = static_cast<u64>(std::max(SConfig::GetInstance().iJITTierUpBudget, 0));
+  m_tier_up_credit = 0;
+  m_tier_up_last_ticks = CoreTiming::GetTicks();
+  m_recompile_threshold =
+      static_cast<u32>(std::max(SConfig::GetInstance().iJITRecompileThreshold, 0));
+
   code_block.m_stats = &js.st;
   code_block.m_gpa = &js.gpa;
   code_block.m_fpa = &js.fpa;
@@ -261,6 +277,7 @@ void Jit64::Init()
 void Jit64::ClearCache()
 {
   blocks.Clear();
+  m_cold_code.clear();
   trampolines.ClearCodeSpace();
   m_far_code.ClearCodeSpace();
   m_const_pool.Clear();
@@ -283,6 +300,11 @@ void Jit64::FallBackToInterpreter(UGeckoInstruction inst)
 {
   gpr.Flush();
   fpr.Flush();
+  if (Profiler::g_ProfileBlocks)
+  {
+    MOV(64, R(RSCRATCH), ImmPtr(&js.op->opinfo->fallbackCount));
+    ADD(64, MatR(RSCRATCH), Imm8(1));
+  }
   if (js.op->opinfo->flags & FL_ENDBLOCK)
   {
     MOV(32, PPCSTATE(pc), Imm32(js.compilerPC));
@@ -480,6 +502,35 @@ void Jit64::WriteExitDestInRSCRATCH(bool bl, u32 after)
   }
 }
 
+void Jit64::WriteIndirectExit(bool bl, u32 after)
+{
+  if (!jo.enableBlocklink)
+  {
+    WriteExitDestInRSCRATCH(bl, after);
+    return;
+  }
+
+  const auto prediction = js.indirectBranchTargets.find(js.compilerPC);
+  if (prediction == js.indirectBranchTargets.end())
+  {
+    // Record the first target we see; this gets the block recompiled with it as the prediction.
+    MOV(32, PPCSTATE(pc), R(RSCRATCH));
+    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_CallFunctionC(JitInterface::PredictIndirectBranch, js.compilerPC);
+    ABI_PopRegistersAndAdjustStack({}, 0);
+    MOV(32, R(RSCRATCH), PPCSTATE(pc));
+    WriteExitDestInRSCRATCH(bl, after);
+    return;
+  }
+
+  // Link straight to the predicted target, and leave anything else to the dispatcher.
+  CMP(32, R(RSCRATCH), Imm32(prediction->second));
+  FixupBranch mispredicted = J_CC(CC_NE, true);
+  WriteExit(prediction->second, bl, after);
+  SetJumpTarget(mispredicted);
+  WriteExitDestInRSCRATCH(bl, after);
+}
+
 void Jit64::WriteBLRExit()
 {
   if (!m_enable_blr_optimization)
@@ -522,6 +573,15 @@ void Jit64::WriteExceptionExit()
   JMP(asm_routines.dispatcher, true);
 }
 
+void Jit64::WriteIdleExit(u32 destination)
+{
+  ABI_PushRegistersAndAdjustStack({}, 0);
+  ABI_CallFunction(CoreTiming::Idle);
+  ABI_PopRegistersAndAdjustStack({}, 0);
+  MOV(32, PPCSTATE(pc), Imm32(destination));
+  WriteExceptionExit();
+}
+
 void Jit64::WriteExternalExceptionExit()
 {
   Cleanup();
@@ -582,13 +642,26 @@ void Jit64::Jit(u32 em_address)
 #endif
   }
 
-  if (IsAlmostFull() || m_far_code.IsAlmostFull() || trampolines.IsAlmostFull() ||
-      SConfig::GetInstance().bJITNoBlockCache)
+  const bool cold_code_full =
+      m_tier_up_threshold != 0 && m_cold_code.size() >= COLD_CODE_ELEMENTS - 0x1000;
+  const bool segment_full = IsSegmentAlmostFull() || m_far_code.IsSegmentAlmostFull();
+  if (segment_full && GetSegmentCount() > 1 && !trampolines.IsAlmostFull() && !cold_code_full &&
+      !SConfig::GetInstance().bJITNoBlockCache)
+  {
+    EvictOldestCodeSegment();
+  }
+  else if (segment_full || trampolines.IsAlmostFull() || cold_code_full ||
+           SConfig::GetInstance().bJITNoBlockCache)
   {
     if (!SConfig::GetInstance().bJITNoBlockCache)
     {
-      const auto reason =
-          IsAlmostFull() ? "main" : m_far_code.IsAlmostFull() ? "far" : "trampoline";
+      const char* reason = "cold";
+      if (IsSegmentAlmostFull())
+        reason = "main";
+      else if (m_far_code.IsSegmentAlmostFull())
+        reason = "far";
+      else if (trampolines.IsAlmostFull())
+        reason = "trampoline";
       WARN_LOG(POWERPC, "flushing %s code cache, please report if this happens a lot", reason);
     }
     ClearCache();
@@ -616,18 +689,36 @@ void Jit64::Jit(u32 em_address)
         analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CROR_MERGE);
         analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
         analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+        analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_TRACE_FOLLOW);
       }
       Trace();
     }
   }
 
+  u64 compile_start = 0;
+  if (Profiler::g_ProfileBlocks)
+    QueryPerformanceCounter(reinterpret_cast<LARGE_INTEGER*>(&compile_start));
+
   // Analyze the block, collect all instructions it is made of (including inlining,
   // if that is enabled), reorder instructions for optimal performance, and join joinable
   // instructions.
-  const u32 nextPC = analyzer.Analyze(em_address, &code_block, &code_buffer, block_size);
+  // Blocks that the entry counters found to be hot get the more expensive analysis.
+  const bool recompile_hot = m_recompile_threshold != 0 &&
+                             js.hotAddresses.find(em_address) != js.hotAddresses.end();
+  if (recompile_hot)
+    analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_TRACE_FOLLOW);
+
+  const u32 nextPC = AnalyzeBlock(em_address, &code_buffer, block_size);
+
+  if (recompile_hot && !SConfig::GetInstance().bJITTraceFormation)
+    analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_TRACE_FOLLOW);
 
   if (code_block.m_memory_exception)
   {
+    // Speculative compiles from the block manifest must not raise exceptions on the guest.
+    if (blocks.IsPrecompiling())
+      return;
+
     // Address of instruction could not be translated
     NPC = nextPC;
     PowerPC::ppcState.Exceptions |= EXCEPTION_ISI;
@@ -637,8 +728,21 @@ void Jit64::Jit(u32 em_address)
   }
 
   JitBlock* b = blocks.AllocateBlock(em_address);
-  DoJit(em_address, b, nextPC);
+  if (ShouldCompileCold(em_address))
+    DoColdJit(em_address, b, nextPC);
+  else
+    DoJit(em_address, b, nextPC);
   blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
+
+  if (Profiler::g_ProfileBlocks)
+  {
+    u64 compile_end;
+    QueryPerformanceCounter(reinterpret_cast<LARGE_INTEGER*>(&compile_end));
+    b->profile_data.compileTicks = compile_end - compile_start;
+  }
+
+  if (!SConfig::GetInstance().bEnableDebugging)
+    blocks.PrecompileFromManifest(em_address);
 }
 
 const u8* Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
@@ -648,6 +752,8 @@ const u8* Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   js.blockStart = em_address;
   js.fifoBytesSinceCheck = 0;
   js.mustCheckFifo = false;
+  js.fifoBytesPending = 0;
+  js.deferFifoPointerUpdate = false;
   js.curBlock = b;
   js.numLoadStoreInst = 0;
   js.numFloatingPointInst = 0;
@@ -665,6 +771,7 @@ const u8* Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
 
   const u8* normalEntry = GetCodePtr();
   b->normalEntry = normalEntry;
+  WritePageGenerationChecks(b, em_address);
 
   // Used to get a trace of the last few blocks before a crash, sometimes VERY useful
   if (ImHereDebug)
@@ -684,6 +791,25 @@ const u8* Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     ADD(64, MDisp(ABI_PARAM1, offset), Imm8(1));
     ABI_CallFunction(QueryPerformanceCounter);
   }
+  else if (m_recompile_threshold != 0 &&
+           js.hotAddresses.find(js.blockStart) == js.hotAddresses.end())
+  {
+    // Count block entries, and once the block turns out to be hot, have it recompiled.
+    MOV(64, R(RSCRATCH), ImmPtr(&b->profile_data.runCount));
+    ADD(64, MatR(RSCRATCH), Imm8(1));
+    CMP(64, MatR(RSCRATCH), Imm32(m_recompile_threshold));
+    FixupBranch hot = J_CC(CC_AE, true);
+
+    SwitchToFarCode();
+    SetJumpTarget(hot);
+    MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
+    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_CallFunctionC(JitInterface::CompileExceptionCheck,
+                      static_cast<u32>(JitInterface::ExceptionType::HotBlock));
+    ABI_PopRegistersAndAdjustStack({}, 0);
+    JMP(asm_routines.dispatcher_no_check, true);
+    SwitchToNearCode();
+  }
 #if defined(_DEBUG) || defined(DEBUGFAST) || defined(NAN_CHECK)
   // should help logged stack-traces become more accurate
   MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
@@ -762,6 +888,11 @@ const u8* Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
       js.isLastInstruction = true;
     }
 
+    // Nothing but another gather pipe store may run while the gather pipe pointer is behind.
+    js.deferFifoPointerUpdate = CanDeferFifoPointerUpdate(op);
+    if (!js.deferFifoPointerUpdate)
+      FlushFifoPointer();
+
     // Gather pipe writes using a non-immediate address are discovered by profiling.
     bool gatherPipeIntCheck = js.fifoWriteAddresses.find(op.address) != js.fifoWriteAddresses.end();
 
@@ -770,6 +901,7 @@ const u8* Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     {
       js.fifoBytesSinceCheck = 0;
       js.mustCheckFifo = false;
+      FlushFifoPointer();
       BitSet32 registersInUse = CallerSavedRegistersInUse();
       ABI_PushRegistersAndAdjustStack(registersInUse, 0);
       ABI_CallFunction(GPFifo::FastCheckGatherPipe);
@@ -782,6 +914,7 @@ const u8* Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     // asynchronous.
     if (gatherPipeIntCheck)
     {
+      FlushFifoPointer();
       TEST(32, PPCSTATE(Exceptions), Imm32(EXCEPTION_EXTERNAL_INT));
       FixupBranch extException = J_CC(CC_NZ, true);
 
@@ -876,7 +1009,13 @@ const u8* Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
           fpr.BindToRegister(reg, true, false);
       }
 
-      CompileInstruction(op);
+      // The analyzer may know the result even when the register cache has lost track of the
+      // inputs, e.g. after a flush or an interpreter fallback.
+      if (op.constGprOut >= 0 && !SConfig::GetInstance().bJITOff &&
+          !SConfig::GetInstance().bJITIntegerOff)
+        gpr.SetImmediate32(op.constGprOut, op.constValue);
+      else
+        CompileInstruction(op);
 
       if (jo.memcheck && (opinfo->flags & FL_LOADSTORE))
       {
@@ -939,6 +1078,9 @@ const u8* Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     js.skipInstructions = 0;
   }
 
+  js.deferFifoPointerUpdate = false;
+  FlushFifoPointer();
+
   if (code_block.m_broken)
   {
     gpr.Flush();
@@ -956,6 +1098,139 @@ const u8* Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   return normalEntry;
 }
 
+void Jit64::EvictOldestCodeSegment()
+{
+  // Segments are filled in order, so the one after the current segment holds the oldest code.
+  // Hot blocks which get evicted are simply recompiled into the new segment on their next use.
+  const size_t segment = (GetCurrentSegment() + 1) % GetSegmentCount();
+  const u8* near_start = GetSegmentStart(segment);
+  const u8* near_end = near_start + GetSegmentSize();
+  const u8* far_start = m_far_code.GetSegmentStart(segment);
+  const u8* far_end = far_start + m_far_code.GetSegmentSize();
+
+  INFO_LOG(POWERPC, "Recycling JIT code segment %zu", segment);
+
+  blocks.EraseHostCodeRange(near_start, near_end);
+  ClearRange(near_start, near_end);
+  ClearRange(far_start, far_end);
+
+  SwitchToSegment(segment);
+  m_far_code.SwitchToSegment(segment);
+}
+
+bool Jit64::ShouldCompileCold(u32 em_address) const
+{
+  // The cold tier shares profile_data.runCount with the block profiler, and doesn't support
+  // breakpoints, so it's only used for plain execution.
+  return m_tier_up_threshold != 0 && !SConfig::GetInstance().bEnableDebugging &&
+         !Profiler::g_ProfileBlocks && !blocks.IsPrecompiling() &&
+         js.tierUpAddresses.find(em_address) == js.tierUpAddresses.end();
+}
+
+void Jit64::DoColdJit(u32 em_address, JitBlock* b, u32 nextPC)
+{
+  const CachedInterpreter::Instruction* cold_code = m_cold_code.data() + m_cold_code.size();
+  CachedInterpreter::CompileInstructions(&m_cold_code, code_block, code_buffer, nextPC,
+                                         jo.memcheck);
+
+  const u8* start = AlignCode4();
+  b->checkedEntry = start;
+
+  // Other blocks may link to us, so the checked entry still has to do the downcount check.
+  FixupBranch skip = J_CC(CC_G);
+  MOV(32, PPCSTATE(pc), Imm32(em_address));
+  JMP(asm_routines.do_timing, true);
+  SetJumpTarget(skip);
+
+  b->normalEntry = GetCodePtr();
+  WritePageGenerationChecks(b, em_address);
+  ABI_PushRegistersAndAdjustStack({}, 0);
+  ABI_CallFunctionPPC(RunColdBlock, b, cold_code, m_tier_up_threshold);
+  ABI_PopRegistersAndAdjustStack({}, 0);
+
+  // The interpreter has already updated PC and the downcount, so all that's left is setting up
+  // the flags the dispatcher expects from a block exit.
+  CMP(32, PPCSTATE(downcount), Imm8(0));
+  JMP(asm_routines.dispatcher, true);
+
+  b->codeSize = (u32)(GetCodePtr() - start);
+  b->originalSize = code_block.m_num_instructions;
+}
+
+void Jit64::WritePageGenerationChecks(JitBlock* b, u32 em_address)
+{
+  if (!blocks.IsLazyInvalidationEnabled())
+    return;
+
+  const u32* last_generation = nullptr;
+  for (u32 address : code_block.m_physical_addresses)
+  {
+    // The addresses are sorted, so each page only has to be checked once.
+    const u32* generation = blocks.GetPageGenerationPointer(address);
+    if (generation == last_generation)
+      continue;
+    last_generation = generation;
+
+    // MOV always encodes the full immediate, which RevalidatePage patches when the block
+    // survives an invalidation of its page.
+    MOV(32, R(RSCRATCH2), Imm32(*generation));
+    b->page_generation_checks.emplace_back(address, GetWritableCodePtr() - sizeof(u32));
+    MOV(64, R(RSCRATCH), ImmPtr(generation));
+    CMP(32, MatR(RSCRATCH), R(RSCRATCH2));
+    FixupBranch stale = J_CC(CC_NE, true);
+
+    SwitchToFarCode();
+    SetJumpTarget(stale);
+    MOV(32, PPCSTATE(pc), Imm32(em_address));
+    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_CallFunctionC(JitInterface::RevalidateCodePage, address);
+    ABI_PopRegistersAndAdjustStack({}, 0);
+    JMP(asm_routines.dispatcher_no_check, true);
+    SwitchToNearCode();
+  }
+}
+
+void Jit64::RunColdBlock(JitBlock* block, const CachedInterpreter::Instruction* code,
+                         u32 threshold)
+{
+  // The block may get invalidated while it runs (e.g. by self-modifying code), so grab everything
+  // we need from it beforehand.
+  const u32 start_address = block->effectiveAddress;
+  const bool promote = ++block->profile_data.runCount >= threshold &&
+                       static_cast<Jit64*>(g_jit)->ConsumeTierUpBudget();
+
+  CachedInterpreter::ExecuteInstructions(code);
+
+  if (promote)
+  {
+    // Throw away the cold block; the next dispatch of this address recompiles it with the
+    // full optimizer.
+    g_jit->js.tierUpAddresses.insert(start_address);
+    g_jit->GetBlockCache()->InvalidateICache(start_address, 4, true);
+  }
+}
+
+bool Jit64::ConsumeTierUpBudget()
+{
+  if (m_tier_up_budget == 0)
+    return true;
+
+  // Credit is measured in ticks * promotions; one promotion costs a millisecond worth of ticks
+  // and the bucket holds at most one millisecond worth of promotions.
+  const u64 ticks_per_ms = SystemTimers::GetTicksPerSecond() / 1000;
+  const u64 max_credit = m_tier_up_budget * ticks_per_ms;
+  const u64 now = CoreTiming::GetTicks();
+  const u64 elapsed = std::min(now - m_tier_up_last_ticks, ticks_per_ms);
+  m_tier_up_last_ticks = now;
+  m_tier_up_credit = std::min(m_tier_up_credit + elapsed * m_tier_up_budget, max_credit);
+
+  if (m_tier_up_credit < ticks_per_ms)
+    return false;
+
+  m_tier_up_credit -= ticks_per_ms;
+  return true;
+}
+
 BitSet8 Jit64::ComputeStaticGQRs(const PPCAnalyst::CodeBlock& cb) const
 {
   return cb.m_gqr_used & ~cb.m_gqr_modified;
@@ -988,6 +1263,8 @@ void Jit64::EnableOptimization()
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CROR_MERGE);
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+  if (SConfig::GetInstance().bJITTraceFormation)
+    analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_TRACE_FOLLOW);
 }
 
 void Jit64::IntializeSpeculativeConstants()
@@ -1025,6 +1302,60 @@ void Jit64::IntializeSpeculativeConstants()
   }
 }
 
+bool Jit64::CanDeferFifoPointerUpdate(const PPCAnalyst::CodeOp& op)
+{
+  // Anything which may call out of the block or exit it needs the pointer to be up to date, so
+  // only stores taking the constant address path of WriteToConstAddress qualify.
+  const SConfig& config = SConfig::GetInstance();
+  if (!jo.optimizeGatherPipe || jo.memcheck || config.bEnableDebugging || config.bJITOff ||
+      op.skip || op.constGprOut >= 0 || HLE::GetFirstFunctionIndex(op.address) != 0)
+  {
+    return false;
+  }
+
+  switch (op.inst.OPCD)
+  {
+  case 36:  // stw
+  case 37:  // stwu
+  case 38:  // stb
+  case 39:  // stbu
+  case 44:  // sth
+  case 45:  // sthu
+    if (config.bJITLoadStoreOff)
+      return false;
+    break;
+  case 52:  // stfs
+  case 53:  // stfsu
+  case 54:  // stfd
+  case 55:  // stfdu
+    // The first FPU instruction of a block checks whether the FPU is enabled.
+    if (config.bJITLoadStoreFloatingOff || !js.firstFPInstructionFound)
+      return false;
+    break;
+  default:
+    return false;
+  }
+
+  const int a = op.inst.RA;
+  if (a && !gpr.R(a).IsImm())
+    return false;
+
+  const u32 address = (a ? gpr.R(a).Imm32() : 0) + static_cast<s32>(op.inst.SIMM_16);
+  return PowerPC::IsOptimizableGatherPipeWrite(address);
+}
+
+void Jit64::FlushFifoPointer()
+{
+  if (js.fifoBytesPending == 0)
+    return;
+
+  // This can end up between an instruction setting the host carry flag and the one using it.
+  MOV(64, R(RSCRATCH), PPCSTATE(gather_pipe_ptr));
+  LEA(64, RSCRATCH, MDisp(RSCRATCH, js.fifoBytesPending));
+  MOV(64, PPCSTATE(gather_pipe_ptr), R(RSCRATCH));
+  js.fifoBytesPending = 0;
+}
+
 bool Jit64::HandleFunctionHooking(u32 address)
 {
   return HLE::ReplaceFunctionIfPossible(address, [&](u32 function, HLE::HookType type) {
@@ -21,6 +21,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/x64ABI.h"
 #include "Common/x64Emitter.h"
+#include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 #include "Core/PowerPC/Jit64/FPURegCache.h"
 #include "Core/PowerPC/Jit64/GPRRegCache.h"
 #include "Core/PowerPC/Jit64/JitAsm.h"
@@ -47,6 +48,9 @@ public:
 
   void Jit(u32 em_address) override;
   const u8* DoJit(u32 em_address, JitBlock* b, u32 nextPC);
+  // Emits a cold-tier block, which runs the block through the cached interpreter and counts
+  // executions until it gets promoted to a full DoJit() compile.
+  void DoColdJit(u32 em_address, JitBlock* b, u32 nextPC);
 
   BitSet32 CallerSavedRegistersInUse() const;
   BitSet8 ComputeStaticGQRs(const PPCAnalyst::CodeBlock&) const;
@@ -70,8 +74,11 @@ public:
   void WriteExit(u32 destination, bool bl = false, u32 after = 0);
   void JustWriteExit(u32 destination, bool bl, u32 after);
   void WriteExitDestInRSCRATCH(bool bl = false, u32 after = 0);
+  void WriteIndirectExit(bool bl = false, u32 after = 0);
   void WriteBLRExit();
   void WriteExceptionExit();
+  // Skips ahead to the next scheduled event, then continues at destination.
+  void WriteIdleExit(u32 destination);
   void WriteExternalExceptionExit();
   void WriteRfiExitDestInRSCRATCH();
   bool Cleanup();
@@ -236,6 +243,22 @@ private:
 
   bool HandleFunctionHooking(u32 address);
 
+  // Whether op is a gather pipe store which can leave updating gather_pipe_ptr to a later one.
+  bool CanDeferFifoPointerUpdate(const PPCAnalyst::CodeOp& op);
+  void FlushFifoPointer();
+
+  // Recycles the next code segment (and the matching far code segment), destroying only the
+  // blocks which were compiled into it.
+  void EvictOldestCodeSegment();
+
+  // With lazy invalidation, checks that the pages the block spans haven't been invalidated since.
+  void WritePageGenerationChecks(JitBlock* b, u32 em_address);
+
+  bool ShouldCompileCold(u32 em_address) const;
+  bool ConsumeTierUpBudget();
+  static void RunColdBlock(JitBlock* block, const CachedInterpreter::Instruction* code,
+                           u32 threshold);
+
   void AllocStack();
   void FreeStack();
 
@@ -247,6 +270,19 @@ private:
   PPCAnalyst::CodeBuffer code_buffer;
   Jit64AsmRoutineManager asm_routines{*this};
 
+  static constexpr size_t COLD_CODE_ELEMENTS = 0x100000;
+
+  // Interpreter call lists of cold-tier blocks. This is reserved once, since blocks point into it.
+  std::vector<CachedInterpreter::Instruction> m_cold_code;
+  u32 m_tier_up_threshold = 0;
+  // Token bucket limiting how many blocks get promoted per millisecond of emulated time, so that
+  // a burst of newly hot code keeps running in the cold tier instead of stalling the CPU thread.
+  u64 m_tier_up_budget = 0;
+  u64 m_tier_up_credit = 0;
+  u64 m_tier_up_last_ticks = 0;
+  // Number of entries after which a block is recompiled with the more expensive optimizations.
+  u32 m_recompile_threshold = 0;
+
   bool m_enable_blr_optimization;
   bool m_cleanup_after_stackfault;
   u8* m_stack;
@@ -16,4 +16,5 @@ public:
 private:
   void WriteLinkBlock(const JitBlock::LinkData& source, const JitBlock* dest) override;
   void WriteDestroyBlock(const JitBlock& block) override;
+  bool SupportsLazyInvalidation() const override { return true; }
 };
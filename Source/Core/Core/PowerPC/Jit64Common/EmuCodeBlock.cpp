@@ -43,6 +43,19 @@ OpArg FixImmediate(int access_size, OpArg arg)
   }
   return arg;
 }
+
+u32 GetOptimizableMMIOWriteAddress(u32 address, int access_size)
+{
+  if (access_size == 64)
+    return 0;
+
+  // The whole page around the gather pipe is treated as the gather pipe by WriteToHardware.
+  const u32 mmio_address = PowerPC::IsOptimizableMMIOAccess(address, access_size);
+  if ((mmio_address & 0xFFFFF000) == 0x0C008000)
+    return 0;
+
+  return mmio_address;
+}
 }  // Anonymous namespace
 
 void EmuCodeBlock::MemoryExceptionCheck()
@@ -141,21 +154,19 @@ void EmuCodeBlock::UnsafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acc
     info->nonAtomicSwapStore = false;
   }
 
-  OpArg dest = MComplex(RMEM, reg_addr, SCALE_1, offset);
+  WriteRegToMemOperand(reg_value, MComplex(RMEM, reg_addr, SCALE_1, offset), accessSize, swap,
+                       info);
+}
+
+void EmuCodeBlock::WriteRegToMemOperand(const OpArg& reg_value, const OpArg& dest, int accessSize,
+                                        bool swap, MovInfo* info)
+{
   if (reg_value.IsImm())
-  {
-    if (swap)
-      reg_value = SwapImmediate(accessSize, reg_value);
-    MOV(accessSize, dest, reg_value);
-  }
+    MOV(accessSize, dest, swap ? SwapImmediate(accessSize, reg_value) : reg_value);
   else if (swap)
-  {
     SwapAndStore(accessSize, dest, reg_value.GetSimpleReg(), info);
-  }
   else
-  {
     MOV(accessSize, dest, reg_value);
-  }
 }
 
 void EmuCodeBlock::UnsafeWriteRegToReg(Gen::X64Reg reg_value, Gen::X64Reg reg_addr, int accessSize,
@@ -313,6 +324,167 @@ void EmuCodeBlock::MMIOLoadToReg(MMIO::Mapping* mmio, Gen::X64Reg reg_value,
   }
 }
 
+// Visitor that generates code to write a MMIO value.
+template <typename T>
+class MMIOWriteCodeGenerator : public MMIO::WriteHandlingMethodVisitor<T>
+{
+public:
+  MMIOWriteCodeGenerator(Gen::X64CodeBlock* code, BitSet32 registers_in_use,
+                         const Gen::OpArg& value, u32 address)
+      : m_code(code), m_registers_in_use(registers_in_use), m_value(value), m_address(address)
+  {
+  }
+
+  void VisitNop() override {}
+  void VisitDirect(T* addr, u32 mask) override { StoreValueToAddrMask(8 * sizeof(T), addr, mask); }
+  void VisitComplex(const std::function<void(u32, T)>* lambda) override
+  {
+    CallLambda(8 * sizeof(T), lambda);
+  }
+
+private:
+  void StoreValueToAddrMask(int sbits, void* ptr, u32 mask)
+  {
+    if (m_value.IsImm())
+    {
+      const u32 value = m_value.AsImm32().Imm32() & mask;
+      m_code->MOV(64, R(RSCRATCH2), ImmPtr(ptr));
+      m_code->MOV(sbits, MatR(RSCRATCH2), FixImmediate(sbits, Gen::Imm32(value)));
+      return;
+    }
+
+    const u32 all_ones = (1ULL << sbits) - 1;
+    if (!m_value.IsSimpleReg(RSCRATCH))
+      m_code->MOV(32, R(RSCRATCH), m_value);
+    if ((all_ones & mask) != all_ones)
+      m_code->AND(32, R(RSCRATCH), Imm32(mask));
+    m_code->MOV(64, R(RSCRATCH2), ImmPtr(ptr));
+    m_code->MOV(sbits, MatR(RSCRATCH2), R(RSCRATCH));
+  }
+
+  void CallLambda(int sbits, const std::function<void(u32, T)>* lambda)
+  {
+    m_code->ABI_PushRegistersAndAdjustStack(m_registers_in_use, 0);
+    // The value goes first, since it may live in one of the other parameter registers.
+    if (m_value.IsImm())
+    {
+      const u32 value = m_value.AsImm32().Imm32() & static_cast<u32>((1ULL << sbits) - 1);
+      m_code->MOV(32, R(ABI_PARAM3), Gen::Imm32(value));
+    }
+    else if (sbits < 32)
+      m_code->MOVZX(32, sbits, ABI_PARAM3, m_value);
+    else if (!m_value.IsSimpleReg(ABI_PARAM3))
+      m_code->MOV(32, R(ABI_PARAM3), m_value);
+    m_code->MOV(64, R(ABI_PARAM1), ImmPtr(lambda));
+    m_code->MOV(32, R(ABI_PARAM2), Gen::Imm32(m_address));
+    m_code->ABI_CallFunction(&Gen::XEmitter::CallLambdaTrampoline<void, u32, T>);
+    m_code->ABI_PopRegistersAndAdjustStack(m_registers_in_use, 0);
+  }
+
+  Gen::X64CodeBlock* m_code;
+  BitSet32 m_registers_in_use;
+  Gen::OpArg m_value;
+  u32 m_address;
+};
+
+void EmuCodeBlock::MMIOWriteRegToAddr(MMIO::Mapping* mmio, const Gen::OpArg& value,
+                                      BitSet32 registers_in_use, u32 address, int access_size)
+{
+  switch (access_size)
+  {
+  case 8:
+  {
+    MMIOWriteCodeGenerator<u8> gen(this, registers_in_use, value, address);
+    mmio->GetHandlerForWrite<u8>(address).Visit(gen);
+    break;
+  }
+  case 16:
+  {
+    MMIOWriteCodeGenerator<u16> gen(this, registers_in_use, value, address);
+    mmio->GetHandlerForWrite<u16>(address).Visit(gen);
+    break;
+  }
+  case 32:
+  {
+    MMIOWriteCodeGenerator<u32> gen(this, registers_in_use, value, address);
+    mmio->GetHandlerForWrite<u32>(address).Visit(gen);
+    break;
+  }
+  }
+}
+
+bool EmuCodeBlock::IsKnownSlowmemAccess() const
+{
+  const auto& slowmem_addresses = g_jit->js.slowmemAddresses;
+  return slowmem_addresses.find(g_jit->js.compilerPC) != slowmem_addresses.end();
+}
+
+bool EmuCodeBlock::HostTLBAccess(X64Reg reg_addr, const OpArg& reg_value, int accessSize,
+                                 bool write, bool swap, bool signExtend, BitSet32 registers_in_use,
+                                 FixupBranch* hit)
+{
+  const X64Reg value_reg = reg_value.IsSimpleReg() ? reg_value.GetSimpleReg() : INVALID_REG;
+  registers_in_use[reg_addr] = true;
+  if (write && value_reg != INVALID_REG)
+    registers_in_use[value_reg] = true;
+
+  // host_reg ends up holding the host address, so it has to be free (a load target is, as long
+  // as it isn't also the address). tag_reg is only needed for the comparison and can be saved.
+  X64Reg host_reg = INVALID_REG;
+  X64Reg tag_reg = INVALID_REG;
+  if (!write && !registers_in_use[value_reg])
+    host_reg = value_reg;
+  for (X64Reg reg : {RSCRATCH_EXTRA, RSCRATCH2, RSCRATCH})
+  {
+    if (host_reg == INVALID_REG && !registers_in_use[reg])
+      host_reg = reg;
+    else if (reg != host_reg && !registers_in_use[reg])
+      tag_reg = reg;
+  }
+  if (tag_reg == INVALID_REG)
+  {
+    for (X64Reg reg : {RSCRATCH_EXTRA, RSCRATCH2, RSCRATCH})
+    {
+      if (reg != host_reg && reg != reg_addr && reg != value_reg)
+        tag_reg = reg;
+    }
+  }
+  if (host_reg == INVALID_REG || tag_reg == INVALID_REG)
+    return false;
+
+  const u8* table = reinterpret_cast<u8*>(&PowerPC::ppcState.host_tlb[write]);
+  const s32 table_offset =
+      static_cast<s32>(table - reinterpret_cast<u8*>(&PowerPC::ppcState)) - 0x80;
+  const bool save_tag_reg = registers_in_use[tag_reg];
+
+  MOV(32, R(host_reg), R(reg_addr));
+  SHR(32, R(host_reg), Imm8(PowerPC::HW_PAGE_INDEX_SHIFT - 4));
+  AND(32, R(host_reg), Imm32((PowerPC::HOST_TLB_SIZE - 1) << 4));
+
+  // Misaligned addresses never match the tag, so a hit can't cross into the next page.
+  if (save_tag_reg)
+    PUSH(tag_reg);
+  MOV(32, R(tag_reg), R(reg_addr));
+  AND(32, R(tag_reg), Imm32(~static_cast<u32>(PowerPC::HW_PAGE_SIZE - 1) | (accessSize / 8 - 1)));
+  CMP(32, R(tag_reg), MComplex(RPPCSTATE, host_reg, SCALE_1,
+                               table_offset + offsetof(PowerPC::HostTLBEntry, tag)));
+  if (save_tag_reg)
+    POP(tag_reg);
+  FixupBranch miss = J_CC(CC_NE);
+
+  MOV(64, R(host_reg), MComplex(RPPCSTATE, host_reg, SCALE_1,
+                                table_offset + offsetof(PowerPC::HostTLBEntry, host_offset)));
+  const OpArg host_address = MComplex(host_reg, reg_addr, SCALE_1, 0);
+  if (write)
+    WriteRegToMemOperand(reg_value, host_address, accessSize, swap, nullptr);
+  else
+    LoadAndSwap(accessSize, value_reg, host_address, signExtend);
+  *hit = J(true);
+
+  SetJumpTarget(miss);
+  return true;
+}
+
 void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress, int accessSize,
                                  s32 offset, BitSet32 registersInUse, bool signExtend, int flags)
 {
@@ -320,7 +492,7 @@ void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress,
 
   registersInUse[reg_value] = false;
   if (g_jit->jo.fastmem && !(flags & (SAFE_LOADSTORE_NO_FASTMEM | SAFE_LOADSTORE_NO_UPDATE_PC)) &&
-      !slowmem)
+      !slowmem && !IsKnownSlowmemAccess())
   {
     u8* backpatchStart = GetWritableCodePtr();
     MovInfo mov;
@@ -367,6 +539,8 @@ void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress,
   }
 
   FixupBranch exit;
+  FixupBranch host_tlb_hit;
+  bool host_tlb = false;
   const bool dr_set = (flags & SAFE_LOADSTORE_DR_ON) || MSR.DR;
   const bool fast_check_address = !slowmem && dr_set;
   if (fast_check_address)
@@ -378,6 +552,12 @@ void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress,
     else
       exit = J(true);
     SetJumpTarget(slow);
+
+    if (g_jit->jo.memcheck)
+    {
+      host_tlb = HostTLBAccess(reg_addr, R(reg_value), accessSize, false, true, signExtend,
+                               registersInUse, &host_tlb_hit);
+    }
   }
 
   // Helps external systems know which instruction triggered the read.
@@ -425,6 +605,8 @@ void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress,
       SwitchToNearCode();
     }
     SetJumpTarget(exit);
+    if (host_tlb)
+      SetJumpTarget(host_tlb_hit);
   }
 }
 
@@ -491,7 +673,7 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
   reg_value = FixImmediate(accessSize, reg_value);
 
   if (g_jit->jo.fastmem && !(flags & (SAFE_LOADSTORE_NO_FASTMEM | SAFE_LOADSTORE_NO_UPDATE_PC)) &&
-      !slowmem)
+      !slowmem && !IsKnownSlowmemAccess())
   {
     u8* backpatchStart = GetWritableCodePtr();
     MovInfo mov;
@@ -534,6 +716,8 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
   }
 
   FixupBranch exit;
+  FixupBranch host_tlb_hit;
+  bool host_tlb = false;
   const bool dr_set = (flags & SAFE_LOADSTORE_DR_ON) || MSR.DR;
   const bool fast_check_address = !slowmem && dr_set;
   if (fast_check_address)
@@ -545,6 +729,12 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
     else
       exit = J(true);
     SetJumpTarget(slow);
+
+    if (g_jit->jo.memcheck)
+    {
+      host_tlb = HostTLBAccess(reg_addr, reg_value, accessSize, true, swap, false, registersInUse,
+                               &host_tlb_hit);
+    }
   }
 
   // PC is used by memory watchpoints (if enabled) or to print accurate PC locations in debug logs
@@ -596,6 +786,8 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
       SwitchToNearCode();
     }
     SetJumpTarget(exit);
+    if (host_tlb)
+      SetJumpTarget(host_tlb_hit);
   }
 }
 
@@ -628,13 +820,19 @@ bool EmuCodeBlock::WriteToConstAddress(int accessSize, OpArg arg, u32 address,
     if (!arg.IsSimpleReg(arg_reg))
       MOV(accessSize, R(arg_reg), arg);
 
-    // And store it in the gather pipe
+    // And store it in the gather pipe, after any stores whose pointer update is still pending
+    auto& js = g_jit->js;
     MOV(64, R(RSCRATCH2), PPCSTATE(gather_pipe_ptr));
-    SwapAndStore(accessSize, MatR(RSCRATCH2), arg_reg);
-    ADD(64, R(RSCRATCH2), Imm8(accessSize >> 3));
-    MOV(64, PPCSTATE(gather_pipe_ptr), R(RSCRATCH2));
+    SwapAndStore(accessSize, MDisp(RSCRATCH2, js.fifoBytesPending), arg_reg);
+    js.fifoBytesPending += accessSize >> 3;
+    if (!js.deferFifoPointerUpdate)
+    {
+      ADD(64, R(RSCRATCH2), Imm8(js.fifoBytesPending));
+      MOV(64, PPCSTATE(gather_pipe_ptr), R(RSCRATCH2));
+      js.fifoBytesPending = 0;
+    }
 
-    g_jit->js.fifoBytesSinceCheck += accessSize >> 3;
+    js.fifoBytesSinceCheck += accessSize >> 3;
     return false;
   }
   else if (PowerPC::IsOptimizableRAMAddress(address))
@@ -642,6 +840,15 @@ bool EmuCodeBlock::WriteToConstAddress(int accessSize, OpArg arg, u32 address,
     WriteToConstRamAddress(accessSize, arg, address);
     return false;
   }
+  else if (const u32 mmio_address = GetOptimizableMMIOWriteAddress(address, accessSize))
+  {
+    // Helps external systems know which instruction triggered the write
+    MOV(32, PPCSTATE(pc), Imm32(g_jit->js.compilerPC));
+
+    // MMIO handlers can't fault, so there's no exception to check for afterwards.
+    MMIOWriteRegToAddr(Memory::mmio_mapping.get(), arg, registersInUse, mmio_address, accessSize);
+    return false;
+  }
   else
   {
     // Helps external systems know which instruction triggered the write
@@ -1095,3 +1302,24 @@ void EmuCodeBlock::Clear()
   m_back_patch_info.clear();
   m_exception_handler_at_loc.clear();
 }
+
+void EmuCodeBlock::ClearRange(const u8* begin, const u8* end)
+{
+  const auto in_range = [begin, end](const u8* ptr) { return ptr >= begin && ptr < end; };
+
+  for (auto it = m_back_patch_info.begin(); it != m_back_patch_info.end();)
+  {
+    if (in_range(it->first))
+      it = m_back_patch_info.erase(it);
+    else
+      ++it;
+  }
+
+  for (auto it = m_exception_handler_at_loc.begin(); it != m_exception_handler_at_loc.end();)
+  {
+    if (in_range(it->first))
+      it = m_exception_handler_at_loc.erase(it);
+    else
+      ++it;
+  }
+}
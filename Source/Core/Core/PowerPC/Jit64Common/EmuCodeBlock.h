@@ -66,6 +66,8 @@ public:
   // call for known addresses in MMIO range (MMIO::IsMMIOAddress).
   void MMIOLoadToReg(MMIO::Mapping* mmio, Gen::X64Reg reg_value, BitSet32 registers_in_use,
                      u32 address, int access_size, bool sign_extend);
+  void MMIOWriteRegToAddr(MMIO::Mapping* mmio, const Gen::OpArg& value, BitSet32 registers_in_use,
+                          u32 address, int access_size);
 
   enum SafeLoadStoreFlags
   {
@@ -123,8 +125,20 @@ public:
   void ConvertDoubleToSingle(Gen::X64Reg dst, Gen::X64Reg src);
   void SetFPRF(Gen::X64Reg xmm);
   void Clear();
+  // Forgets backpatch information for code within [begin, end), e.g. when it gets recycled.
+  void ClearRange(const u8* begin, const u8* end);
 
 protected:
+  // Whether fastmem already faulted for the instruction being compiled.
+  bool IsKnownSlowmemAccess() const;
+
+  // Performs the access directly if reg_addr hits in PowerPC::ppcState.host_tlb, in which case
+  // *hit is taken. Returns false if no registers could be found for the lookup.
+  bool HostTLBAccess(Gen::X64Reg reg_addr, const Gen::OpArg& reg_value, int accessSize, bool write,
+                     bool swap, bool signExtend, BitSet32 registers_in_use, Gen::FixupBranch* hit);
+  void WriteRegToMemOperand(const Gen::OpArg& reg_value, const Gen::OpArg& dest, int accessSize,
+                            bool swap, Gen::MovInfo* info);
+
   ConstantPool m_const_pool;
   FarCodeCache m_far_code;
   u8* m_near_code;  // Backed up when we switch to far code.
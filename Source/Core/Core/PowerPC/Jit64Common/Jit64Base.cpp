@@ -53,6 +53,9 @@ bool Jitx86Base::BackPatch(u32 emAddress, SContext* ctx)
 
   TrampolineInfo& info = it->second;
 
+  // Remember the faulting instruction, so that recompiling its block doesn't fault again.
+  js.slowmemAddresses.insert(info.pc);
+
   u8* exceptionHandler = nullptr;
   if (jo.memcheck)
   {
@@ -135,8 +135,34 @@ void JitArm64::Shutdown()
 void JitArm64::FallBackToInterpreter(UGeckoInstruction inst)
 {
   FlushCarry();
-  gpr.Flush(FlushMode::FLUSH_ALL, js.op);
-  fpr.Flush(FlushMode::FLUSH_ALL, js.op);
+
+  // Floating point instructions only touch the registers PPCAnalyst lists for them, besides CR and
+  // FPSCR, so PS-heavy blocks don't have to reload everything after each of them.
+  const ::OpType type = js.op->opinfo->type;
+  if (!(js.op->opinfo->flags & (FL_ENDBLOCK | FL_LOADSTORE)) &&
+      (type == ::OpType::PS || type == ::OpType::SingleFP || type == ::OpType::DoubleFP))
+  {
+    BitSet32 fregs_written;
+    fregs_written[inst.FD] = true;
+    if (js.op->fregOut >= 0)
+      fregs_written[js.op->fregOut] = true;
+
+    gpr.FlushForCall(js.op->regsIn, js.op->regsOut);
+    fpr.FlushForCall(js.op->fregsIn, fregs_written);
+  }
+  else
+  {
+    gpr.Flush(FlushMode::FLUSH_ALL, js.op);
+    fpr.Flush(FlushMode::FLUSH_ALL, js.op);
+  }
+
+  if (Profiler::g_ProfileBlocks)
+  {
+    MOVP2R(X0, &js.op->opinfo->fallbackCount);
+    LDR(INDEX_UNSIGNED, X1, X0, 0);
+    ADD(X1, X1, 1);
+    STR(INDEX_UNSIGNED, X1, X0, 0);
+  }
 
   if (js.op->opinfo->flags & FL_ENDBLOCK)
   {
@@ -565,7 +591,7 @@ void JitArm64::Jit(u32)
   // Analyze the block, collect all instructions it is made of (including inlining,
   // if that is enabled), reorder instructions for optimal performance, and join joinable
   // instructions.
-  const u32 nextPC = analyzer.Analyze(em_address, &code_block, &code_buffer, block_size);
+  const u32 nextPC = AnalyzeBlock(em_address, &code_buffer, block_size);
 
   if (code_block.m_memory_exception)
   {
@@ -770,7 +796,13 @@ void JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
         js.firstFPInstructionFound = true;
       }
 
-      CompileInstruction(op);
+      // The analyzer may know the result even when the register cache has lost track of the
+      // inputs, e.g. after a flush or an interpreter fallback.
+      if (op.constGprOut >= 0 && !SConfig::GetInstance().bJITOff &&
+          !SConfig::GetInstance().bJITIntegerOff)
+        gpr.SetImmediate(op.constGprOut, op.constValue);
+      else
+        CompileInstruction(op);
       if (!CanMergeNextInstructions(1) || js.op[1].opinfo->type != ::OpType::Integer)
         FlushCarry();
 
@@ -85,6 +85,7 @@ public:
   void addic(UGeckoInstruction inst);
   void mulli(UGeckoInstruction inst);
   void addzex(UGeckoInstruction inst);
+  void addmex(UGeckoInstruction inst);
   void divwx(UGeckoInstruction inst);
   void subfx(UGeckoInstruction inst);
   void addcx(UGeckoInstruction inst);
@@ -94,6 +95,7 @@ public:
   void rlwimix(UGeckoInstruction inst);
   void subfex(UGeckoInstruction inst);
   void subfzex(UGeckoInstruction inst);
+  void subfmex(UGeckoInstruction inst);
   void subfcx(UGeckoInstruction inst);
   void subfic(UGeckoInstruction inst);
   void addex(UGeckoInstruction inst);
@@ -139,6 +141,7 @@ public:
   void fctiwzx(UGeckoInstruction inst);
 
   // Paired
+  void ps_cmpXX(UGeckoInstruction inst);
   void ps_maddXX(UGeckoInstruction inst);
   void ps_mergeXX(UGeckoInstruction inst);
   void ps_mulsX(UGeckoInstruction inst);
@@ -169,6 +172,7 @@ private:
   {
     u32 length;
     const u8* slowmem_code;
+    u32 pc;
   };
 
   static void InitializeInstructionTables();
@@ -230,6 +234,7 @@ private:
   void ComputeRC0(u64 imm);
   void ComputeCarry(bool Carry);
   void ComputeCarry();
+  void FloatCompare(UGeckoInstruction inst, bool upper = false);
   void FlushCarry();
 
   void reg_imm(u32 d, u32 a, u32 value, u32 (*do_op)(u32, u32),
@@ -54,6 +54,10 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, bool fastmem, bool do_farcode, AR
   bool in_far_code = false;
   const u8* fastmem_start = GetCodePtr();
 
+  // Accesses that faulted before are compiled straight to the slow path.
+  if (fastmem && js.slowmemAddresses.find(js.compilerPC) != js.slowmemAddresses.end())
+    fastmem = false;
+
   if (fastmem)
   {
     if (flags & BackPatchInfo::FLAG_STORE && flags & BackPatchInfo::FLAG_MASK_FLOAT)
@@ -102,7 +106,9 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, bool fastmem, bool do_farcode, AR
     else if (flags & BackPatchInfo::FLAG_STORE)
     {
       ARM64Reg temp = W0;
-      if (flags & BackPatchInfo::FLAG_SIZE_32)
+      if (flags & BackPatchInfo::FLAG_REVERSE)
+        temp = RS;
+      else if (flags & BackPatchInfo::FLAG_SIZE_32)
         REV32(temp, RS);
       else if (flags & BackPatchInfo::FLAG_SIZE_16)
         REV16(temp, RS);
@@ -166,12 +172,14 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, bool fastmem, bool do_farcode, AR
         m_handler_to_loc[handler] = handler_loc;
         fastmem_area->slowmem_code = handler_loc;
         fastmem_area->length = fastmem_end - fastmem_start;
+        fastmem_area->pc = js.compilerPC;
       }
       else
       {
         const u8* handler_loc = handler_loc_iter->second;
         fastmem_area->slowmem_code = handler_loc;
         fastmem_area->length = fastmem_end - fastmem_start;
+        fastmem_area->pc = js.compilerPC;
         return;
       }
     }
@@ -233,7 +241,12 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, bool fastmem, bool do_farcode, AR
     }
     else if (flags & BackPatchInfo::FLAG_STORE)
     {
-      MOV(W0, RS);
+      if (!(flags & BackPatchInfo::FLAG_REVERSE))
+        MOV(W0, RS);
+      else if (flags & BackPatchInfo::FLAG_SIZE_32)
+        REV32(W0, RS);
+      else
+        REV16(W0, RS);
 
       if (flags & BackPatchInfo::FLAG_SIZE_32)
         MOVP2R(X30, &PowerPC::Write_U32);
@@ -322,6 +335,9 @@ bool JitArm64::HandleFastmemFault(uintptr_t access_address, SContext* ctx)
   for (u32 i = 0; i < num_insts_max; ++i)
     emitter.HINT(HINT_NOP);
 
+  // Remember the faulting instruction, so that recompiling its block doesn't fault again.
+  js.slowmemAddresses.insert(slow_handler_iter->second.pc);
+
   m_fault_to_handler.erase(slow_handler_iter);
 
   emitter.FlushIcache();
@@ -252,21 +252,45 @@ void JitArm64::frspx(UGeckoInstruction inst)
   }
 }
 
-void JitArm64::fcmpX(UGeckoInstruction inst)
+void JitArm64::FloatCompare(UGeckoInstruction inst, bool upper)
 {
-  INSTRUCTION_START
-  JITDISABLE(bJITFloatingPointOff);
-  FALLBACK_IF(SConfig::GetInstance().bFPRF && js.op->wantsFPRF);
-
   u32 a = inst.FA, b = inst.FB;
   int crf = inst.CRFD;
 
-  bool singles = fpr.IsSingle(a, true) && fpr.IsSingle(b, true);
-  RegType type = singles ? REG_LOWER_PAIR_SINGLE : REG_LOWER_PAIR;
+  bool singles = fpr.IsSingle(a, !upper) && fpr.IsSingle(b, !upper);
+  RegType type;
+  if (upper)
+    type = singles ? REG_REG_SINGLE : REG_REG;
+  else
+    type = singles ? REG_LOWER_PAIR_SINGLE : REG_LOWER_PAIR;
   ARM64Reg (*reg_encoder)(ARM64Reg) = singles ? EncodeRegToSingle : EncodeRegToDouble;
 
-  ARM64Reg VA = reg_encoder(fpr.R(a, type));
-  ARM64Reg VB = reg_encoder(fpr.R(b, type));
+  ARM64Reg VA = fpr.R(a, type);
+  ARM64Reg VB = fpr.R(b, type);
+  ARM64Reg V0Q = INVALID_REG;
+  ARM64Reg V1Q = INVALID_REG;
+  if (upper)
+  {
+    // Move the upper elements to the bottom of temporary registers, where FCMP looks at them
+    u8 size = singles ? 32 : 64;
+    ARM64Reg (*vector_encoder)(ARM64Reg) = singles ? EncodeRegToDouble : EncodeRegToQuad;
+
+    V0Q = fpr.GetReg();
+    m_float_emit.DUP(size, vector_encoder(V0Q), vector_encoder(VA), 1);
+    VA = V0Q;
+    if (a != b)
+    {
+      V1Q = fpr.GetReg();
+      m_float_emit.DUP(size, vector_encoder(V1Q), vector_encoder(VB), 1);
+      VB = V1Q;
+    }
+    else
+    {
+      VB = V0Q;
+    }
+  }
+  VA = reg_encoder(VA);
+  VB = reg_encoder(VB);
 
   gpr.BindCRToRegister(crf, false);
   ARM64Reg XA = gpr.CR(crf);
@@ -312,6 +336,20 @@ void JitArm64::fcmpX(UGeckoInstruction inst)
     SetJumpTarget(continue3);
   }
   SetJumpTarget(continue1);
+
+  if (V0Q != INVALID_REG)
+    fpr.Unlock(V0Q);
+  if (V1Q != INVALID_REG)
+    fpr.Unlock(V1Q);
+}
+
+void JitArm64::fcmpX(UGeckoInstruction inst)
+{
+  INSTRUCTION_START
+  JITDISABLE(bJITFloatingPointOff);
+  FALLBACK_IF(SConfig::GetInstance().bFPRF && js.op->wantsFPRF);
+
+  FloatCompare(inst);
 }
 
 void JitArm64::fctiwzx(UGeckoInstruction inst)
@@ -845,6 +845,31 @@ void JitArm64::addzex(UGeckoInstruction inst)
     ComputeRC0(gpr.R(d));
 }
 
+void JitArm64::addmex(UGeckoInstruction inst)
+{
+  INSTRUCTION_START
+  JITDISABLE(bJITIntegerOff);
+  FALLBACK_IF(inst.OE);
+
+  int a = inst.RA, d = inst.RD;
+
+  // rD = rA + CA - 1, which is rA + 0xFFFFFFFF with the carry added in
+  ARM64Reg WA = gpr.GetReg();
+  if (!js.carryFlagSet)
+  {
+    LDRB(INDEX_UNSIGNED, WA, PPC_REG, PPCSTATE_OFF(xer_ca));
+    CMP(WA, 1);
+  }
+  MOVI2R(WA, 0xFFFFFFFF);
+  gpr.BindToRegister(d, d == a);
+  ADCS(gpr.R(d), gpr.R(a), WA);
+  gpr.Unlock(WA);
+
+  ComputeCarry();
+  if (inst.Rc)
+    ComputeRC0(gpr.R(d));
+}
+
 void JitArm64::subfx(UGeckoInstruction inst)
 {
   INSTRUCTION_START
@@ -1001,6 +1026,32 @@ void JitArm64::subfzex(UGeckoInstruction inst)
     ComputeRC0(gpr.R(d));
 }
 
+void JitArm64::subfmex(UGeckoInstruction inst)
+{
+  INSTRUCTION_START
+  JITDISABLE(bJITIntegerOff);
+  FALLBACK_IF(inst.OE);
+
+  int a = inst.RA, d = inst.RD;
+
+  // rD = ~rA + CA - 1, which is ~rA + 0xFFFFFFFF with the carry added in
+  ARM64Reg WA = gpr.GetReg();
+  if (!js.carryFlagSet)
+  {
+    LDRB(INDEX_UNSIGNED, WA, PPC_REG, PPCSTATE_OFF(xer_ca));
+    CMP(WA, 1);
+  }
+  gpr.BindToRegister(d, d == a);
+  MVN(gpr.R(d), gpr.R(a));
+  MOVI2R(WA, 0xFFFFFFFF);
+  ADCS(gpr.R(d), gpr.R(d), WA);
+  gpr.Unlock(WA);
+
+  ComputeCarry();
+  if (inst.Rc)
+    ComputeRC0(gpr.R(d));
+}
+
 void JitArm64::subfic(UGeckoInstruction inst)
 {
   INSTRUCTION_START
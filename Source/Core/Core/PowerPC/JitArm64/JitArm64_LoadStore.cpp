@@ -239,14 +239,19 @@ void JitArm64::SafeStoreFromReg(s32 dest, u32 value, s32 regOffset, u32 flags, s
       accessSize = 8;
 
     LDR(INDEX_UNSIGNED, X0, PPC_REG, PPCSTATE_OFF(gather_pipe_ptr));
+    if (flags & BackPatchInfo::FLAG_REVERSE)
+      MOV(W1, RS);
+    else if (accessSize == 32)
+      REV32(W1, RS);
+    else if (accessSize == 16)
+      REV16(W1, RS);
+
     if (accessSize == 32)
     {
-      REV32(W1, RS);
       STR(INDEX_POST, W1, X0, 4);
     }
     else if (accessSize == 16)
     {
-      REV16(W1, RS);
       STRH(INDEX_POST, W1, X0, 2);
     }
     else
@@ -413,6 +418,14 @@ void JitArm64::stX(UGeckoInstruction inst)
       flags |= BackPatchInfo::FLAG_SIZE_16;
       regOffset = b;
       break;
+    case 662:  // stwbrx
+      flags |= BackPatchInfo::FLAG_REVERSE | BackPatchInfo::FLAG_SIZE_32;
+      regOffset = b;
+      break;
+    case 918:  // sthbrx
+      flags |= BackPatchInfo::FLAG_REVERSE | BackPatchInfo::FLAG_SIZE_16;
+      regOffset = b;
+      break;
     }
     break;
   case 37:  // stwu
@@ -152,6 +152,15 @@ void JitArm64::ps_maddXX(UGeckoInstruction inst)
   fpr.Unlock(V0Q);
 }
 
+void JitArm64::ps_cmpXX(UGeckoInstruction inst)
+{
+  INSTRUCTION_START
+  JITDISABLE(bJITPairedOff);
+  FALLBACK_IF(SConfig::GetInstance().bFPRF && js.op->wantsFPRF);
+
+  FloatCompare(inst, !!(inst.SUBOP10 & 64));
+}
+
 void JitArm64::ps_sel(UGeckoInstruction inst)
 {
   INSTRUCTION_START
@@ -255,6 +255,31 @@ void Arm64GPRCache::Flush(FlushMode mode, PPCAnalyst::CodeOp* op)
   FlushCRRegisters(BitSet32(~0U), mode == FLUSH_MAINTAIN_STATE);
 }
 
+void Arm64GPRCache::FlushForCall(BitSet32 regs_read, BitSet32 regs_written)
+{
+  BitSet32 to_store;
+  BitSet32 to_flush;
+  for (size_t i = 0; i < GUEST_GPR_COUNT; ++i)
+  {
+    const OpArg& reg = m_guest_registers[GUEST_GPR_OFFSET + i];
+    if (regs_written[i] || (reg.GetType() == REG_REG && !IsCalleeSaved(reg.GetReg())))
+      to_flush[i] = true;
+    else if (regs_read[i])
+      to_store[i] = true;
+  }
+
+  FlushRegisters(to_store, true);
+  for (int i : to_store)
+  {
+    // The stored registers are now in sync with ppcState
+    OpArg& reg = m_guest_registers[GUEST_GPR_OFFSET + i];
+    if (reg.GetType() == REG_REG)
+      reg.SetDirty(false);
+  }
+  FlushRegisters(to_flush, false);
+  FlushCRRegisters(BitSet32(~0U), false);
+}
+
 ARM64Reg Arm64GPRCache::R(const GuestRegInfo& guest_reg)
 {
   OpArg& reg = guest_reg.reg;
@@ -716,6 +741,31 @@ void Arm64FPRCache::FlushRegister(size_t preg, bool maintain_state)
   }
 }
 
+void Arm64FPRCache::FlushForCall(BitSet32 regs_read, BitSet32 regs_written)
+{
+  for (size_t i = 0; i < m_guest_registers.size(); ++i)
+  {
+    OpArg& reg = m_guest_registers[i];
+    const RegType type = reg.GetType();
+    if (type == REG_NOTLOADED || type == REG_IMM)
+      continue;
+
+    const bool survives_call = type != REG_REG && IsCalleeSaved(reg.GetReg());
+    const bool is_single =
+        type == REG_REG_SINGLE || type == REG_LOWER_PAIR_SINGLE || type == REG_DUP_SINGLE;
+    if (regs_written[i] || !survives_call || (regs_read[i] && is_single && reg.IsDirty()))
+    {
+      // Storing a single converts the host register in place, so it can't be kept
+      FlushRegister(i, false);
+    }
+    else if (regs_read[i])
+    {
+      FlushRegister(i, true);
+      reg.SetDirty(false);
+    }
+  }
+}
+
 void Arm64FPRCache::FlushRegisters(BitSet32 regs, bool maintain_state)
 {
   for (int j : regs)
@@ -234,6 +234,11 @@ public:
   void StoreRegisters(BitSet32 regs) { FlushRegisters(regs, false); }
   void StoreCRRegisters(BitSet32 regs) { FlushCRRegisters(regs, false); }
 
+  // Prepares for a call which reads and writes the given guest registers in ppcState. Those are
+  // written back, and the written ones leave the cache. Other registers stay in callee saved host
+  // registers. CRs are always flushed.
+  void FlushForCall(BitSet32 regs_read, BitSet32 regs_written);
+
 protected:
   // Get the order of the host registers
   void GetAllocationOrder() override;
@@ -288,6 +293,11 @@ public:
 
   void StoreRegisters(BitSet32 regs) { FlushRegisters(regs, false); }
 
+  // Same as Arm64GPRCache::FlushForCall. Since calls only preserve the lower 64 bits of the callee
+  // saved registers, full paired doubles are always flushed, but singles and lower pairs are kept
+  // without any conversion.
+  void FlushForCall(BitSet32 regs_read, BitSet32 regs_written);
+
 protected:
   // Get the order of the host registers
   void GetAllocationOrder() override;
@@ -121,18 +121,18 @@ constexpr GekkoOPTemplate primarytable[] = {
 
 constexpr GekkoOPTemplate table4[] = {
     // SUBOP10
-    {0, &JitArm64::FallBackToInterpreter},   // ps_cmpu0
-    {32, &JitArm64::FallBackToInterpreter},  // ps_cmpo0
-    {40, &JitArm64::fp_logic},               // ps_neg
-    {136, &JitArm64::fp_logic},              // ps_nabs
-    {264, &JitArm64::fp_logic},              // ps_abs
-    {64, &JitArm64::FallBackToInterpreter},  // ps_cmpu1
-    {72, &JitArm64::fp_logic},               // ps_mr
-    {96, &JitArm64::FallBackToInterpreter},  // ps_cmpo1
-    {528, &JitArm64::ps_mergeXX},            // ps_merge00
-    {560, &JitArm64::ps_mergeXX},            // ps_merge01
-    {592, &JitArm64::ps_mergeXX},            // ps_merge10
-    {624, &JitArm64::ps_mergeXX},            // ps_merge11
+    {0, &JitArm64::ps_cmpXX},      // ps_cmpu0
+    {32, &JitArm64::ps_cmpXX},     // ps_cmpo0
+    {40, &JitArm64::fp_logic},     // ps_neg
+    {136, &JitArm64::fp_logic},    // ps_nabs
+    {264, &JitArm64::fp_logic},    // ps_abs
+    {64, &JitArm64::ps_cmpXX},     // ps_cmpu1
+    {72, &JitArm64::fp_logic},     // ps_mr
+    {96, &JitArm64::ps_cmpXX},     // ps_cmpo1
+    {528, &JitArm64::ps_mergeXX},  // ps_merge00
+    {560, &JitArm64::ps_mergeXX},  // ps_merge01
+    {592, &JitArm64::ps_mergeXX},  // ps_merge10
+    {624, &JitArm64::ps_mergeXX},  // ps_merge11
 
     {1014, &JitArm64::FallBackToInterpreter},  // dcbz_l
 };
@@ -183,36 +183,36 @@ constexpr GekkoOPTemplate table19[] = {
 };
 
 constexpr GekkoOPTemplate table31[] = {
-    {266, &JitArm64::addx},                   // addx
-    {778, &JitArm64::addx},                   // addox
-    {10, &JitArm64::addcx},                   // addcx
-    {522, &JitArm64::addcx},                  // addcox
-    {138, &JitArm64::addex},                  // addex
-    {650, &JitArm64::addex},                  // addeox
-    {234, &JitArm64::FallBackToInterpreter},  // addmex
-    {746, &JitArm64::FallBackToInterpreter},  // addmeox
-    {202, &JitArm64::addzex},                 // addzex
-    {714, &JitArm64::addzex},                 // addzeox
-    {491, &JitArm64::divwx},                  // divwx
-    {1003, &JitArm64::divwx},                 // divwox
-    {459, &JitArm64::divwux},                 // divwux
-    {971, &JitArm64::divwux},                 // divwuox
-    {75, &JitArm64::mulhwx},                  // mulhwx
-    {11, &JitArm64::mulhwux},                 // mulhwux
-    {235, &JitArm64::mullwx},                 // mullwx
-    {747, &JitArm64::mullwx},                 // mullwox
-    {104, &JitArm64::negx},                   // negx
-    {616, &JitArm64::negx},                   // negox
-    {40, &JitArm64::subfx},                   // subfx
-    {552, &JitArm64::subfx},                  // subfox
-    {8, &JitArm64::subfcx},                   // subfcx
-    {520, &JitArm64::subfcx},                 // subfcox
-    {136, &JitArm64::subfex},                 // subfex
-    {648, &JitArm64::subfex},                 // subfeox
-    {232, &JitArm64::FallBackToInterpreter},  // subfmex
-    {744, &JitArm64::FallBackToInterpreter},  // subfmeox
-    {200, &JitArm64::subfzex},                // subfzex
-    {712, &JitArm64::subfzex},                // subfzeox
+    {266, &JitArm64::addx},     // addx
+    {778, &JitArm64::addx},     // addox
+    {10, &JitArm64::addcx},     // addcx
+    {522, &JitArm64::addcx},    // addcox
+    {138, &JitArm64::addex},    // addex
+    {650, &JitArm64::addex},    // addeox
+    {234, &JitArm64::addmex},   // addmex
+    {746, &JitArm64::addmex},   // addmeox
+    {202, &JitArm64::addzex},   // addzex
+    {714, &JitArm64::addzex},   // addzeox
+    {491, &JitArm64::divwx},    // divwx
+    {1003, &JitArm64::divwx},   // divwox
+    {459, &JitArm64::divwux},   // divwux
+    {971, &JitArm64::divwux},   // divwuox
+    {75, &JitArm64::mulhwx},    // mulhwx
+    {11, &JitArm64::mulhwux},   // mulhwux
+    {235, &JitArm64::mullwx},   // mullwx
+    {747, &JitArm64::mullwx},   // mullwox
+    {104, &JitArm64::negx},     // negx
+    {616, &JitArm64::negx},     // negox
+    {40, &JitArm64::subfx},     // subfx
+    {552, &JitArm64::subfx},    // subfox
+    {8, &JitArm64::subfcx},     // subfcx
+    {520, &JitArm64::subfcx},   // subfcox
+    {136, &JitArm64::subfex},   // subfex
+    {648, &JitArm64::subfex},   // subfeox
+    {232, &JitArm64::subfmex},  // subfmex
+    {744, &JitArm64::subfmex},  // subfmeox
+    {200, &JitArm64::subfzex},  // subfzex
+    {712, &JitArm64::subfzex},  // subfzeox
 
     {28, &JitArm64::boolX},    // andx
     {60, &JitArm64::boolX},    // andcx
@@ -281,8 +281,8 @@ constexpr GekkoOPTemplate table31[] = {
     {247, &JitArm64::stX},  // stbux
 
     // store bytereverse
-    {662, &JitArm64::FallBackToInterpreter},  // stwbrx
-    {918, &JitArm64::FallBackToInterpreter},  // sthbrx
+    {662, &JitArm64::stX},  // stwbrx
+    {918, &JitArm64::stX},  // sthbrx
 
     {661, &JitArm64::FallBackToInterpreter},  // stswx
     {725, &JitArm64::FallBackToInterpreter},  // stswi
@@ -92,13 +92,22 @@ void JitArm64::GenerateAsm()
     MOVP2R(MEM_REG, Memory::logical_base);
     SetJumpTarget(membaseend);
 
-    // iCache[(address >> 2) & iCache_Mask];
     ARM64Reg pc_masked = W25;
     ARM64Reg cache_base = X27;
     ARM64Reg block = X30;
-    ORRI2R(pc_masked, WZR, JitBaseBlockCache::FAST_BLOCK_MAP_MASK << 3);
-    AND(pc_masked, pc_masked, DISPATCHER_PC, ArithOption(DISPATCHER_PC, ST_LSL, 1));
-    MOVP2R(cache_base, GetBlockCache()->GetFastBlockMap());
+    if (GetBlockCache()->GetFastBlockMap())
+    {
+      // iCache[address >> 2];
+      UBFIZ(EncodeRegTo64(pc_masked), EncodeRegTo64(DISPATCHER_PC), 1, 32);
+      MOVP2R(cache_base, GetBlockCache()->GetFastBlockMap());
+    }
+    else
+    {
+      // iCache[(address >> 2) & iCache_Mask];
+      ORRI2R(pc_masked, WZR, JitBaseBlockCache::FAST_BLOCK_MAP_FALLBACK_MASK << 3);
+      AND(pc_masked, pc_masked, DISPATCHER_PC, ArithOption(DISPATCHER_PC, ST_LSL, 1));
+      MOVP2R(cache_base, GetBlockCache()->GetFastBlockMapFallback());
+    }
     LDR(block, cache_base, EncodeRegTo64(pc_masked));
     FixupBranch not_found = CBZ(block);
 
@@ -4,9 +4,13 @@
 
 #include "Core/PowerPC/JitCommon/JitBase.h"
 
+#include <algorithm>
+
 #include "Common/CommonTypes.h"
 #include "Core/ConfigManager.h"
+#include "Core/HLE/HLE.h"
 #include "Core/HW/CPU.h"
+#include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 
@@ -32,6 +36,77 @@ JitBase::JitBase() = default;
 
 JitBase::~JitBase() = default;
 
+u32 JitBase::AnalyzeBlock(u32 em_address, PPCAnalyst::CodeBuffer* buffer, std::size_t block_size)
+{
+  // Breakpoints affect instruction reordering, and single stepping analyzes single instructions
+  if (SConfig::GetInstance().bEnableDebugging || block_size == 1)
+    return analyzer.Analyze(em_address, &code_block, buffer, block_size);
+
+  const u64 key = (static_cast<u64>(analyzer.GetOptions()) << 40) |
+                  (static_cast<u64>(MSR.Hex & JitBaseBlockCache::JIT_CACHE_MSR_MASK) << 32) |
+                  em_address;
+  const auto iter = m_analysis_cache.find(key);
+  if (iter != m_analysis_cache.end() && IsCachedAnalysisValid(iter->second))
+  {
+    const CachedAnalysis& analysis = iter->second;
+    *code_block.m_stats = analysis.stats;
+    *code_block.m_gpa = analysis.gpa;
+    *code_block.m_fpa = analysis.fpa;
+    code_block.m_address = em_address;
+    code_block.m_num_instructions = static_cast<u32>(analysis.code.size());
+    code_block.m_broken = analysis.broken;
+    code_block.m_memory_exception = false;
+    code_block.m_gqr_used = analysis.gqr_used;
+    code_block.m_gqr_modified = analysis.gqr_modified;
+    code_block.m_gpr_inputs = analysis.gpr_inputs;
+    code_block.m_physical_addresses = analysis.physical_addresses;
+    std::copy(analysis.code.begin(), analysis.code.end(), buffer->begin());
+    return analysis.next_pc;
+  }
+
+  const u32 next_pc = analyzer.Analyze(em_address, &code_block, buffer, block_size);
+
+  // Blocks containing HLE hooks are left out, as the hooks can change without the code changing
+  const auto begin = buffer->begin();
+  const auto end = begin + code_block.m_num_instructions;
+  if (code_block.m_memory_exception || code_block.m_num_instructions == 0 ||
+      std::any_of(begin, end, [](const PPCAnalyst::CodeOp& op) {
+        return HLE::GetFirstFunctionIndex(op.address) != 0;
+      }))
+  {
+    return next_pc;
+  }
+
+  if (m_analysis_cache.size() >= MAX_CACHED_ANALYSES)
+    m_analysis_cache.clear();
+
+  CachedAnalysis& analysis = m_analysis_cache[key];
+  analysis.next_pc = next_pc;
+  analysis.stats = *code_block.m_stats;
+  analysis.gpa = *code_block.m_gpa;
+  analysis.fpa = *code_block.m_fpa;
+  analysis.broken = code_block.m_broken;
+  analysis.gqr_used = code_block.m_gqr_used;
+  analysis.gqr_modified = code_block.m_gqr_modified;
+  analysis.gpr_inputs = code_block.m_gpr_inputs;
+  analysis.physical_addresses = code_block.m_physical_addresses;
+  analysis.code.assign(begin, end);
+  return next_pc;
+}
+
+bool JitBase::IsCachedAnalysisValid(const CachedAnalysis& analysis) const
+{
+  // Reading the instructions again also fills the emulated instruction cache like an analysis
+  return std::all_of(analysis.code.begin(), analysis.code.end(),
+                     [&analysis](const PPCAnalyst::CodeOp& op) {
+                       const PowerPC::TryReadInstResult result =
+                           PowerPC::TryReadInstruction(op.address);
+                       return result.valid && result.hex == op.inst.hex &&
+                              analysis.physical_addresses.count(result.physical_address) != 0 &&
+                              HLE::GetFirstFunctionIndex(op.address) == 0;
+                     });
+}
+
 bool JitBase::CanMergeNextInstructions(int count) const
 {
   if (CPU::IsStepping() || js.instructionsLeft < count)
@@ -8,8 +8,12 @@
 //#define JIT_LOG_GPR     // Enables logging of the PPC general purpose regs
 //#define JIT_LOG_FPR     // Enables logging of the PPC floating point regs
 
+#include <cstddef>
 #include <map>
+#include <set>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/x64Emitter.h"
@@ -87,6 +91,10 @@ protected:
 
     bool mustCheckFifo;
     int fifoBytesSinceCheck;
+    // Bytes stored to the gather pipe which haven't been added to gather_pipe_ptr yet. The pointer
+    // update is deferred over runs of constant-address gather pipe stores.
+    int fifoBytesPending;
+    bool deferFifoPointerUpdate;
 
     PPCAnalyst::BlockStats st;
     PPCAnalyst::BlockRegStats gpa;
@@ -99,15 +107,51 @@ protected:
     std::unordered_set<u32> fifoWriteAddresses;
     std::unordered_set<u32> pairedQuantizeAddresses;
     std::unordered_set<u32> noSpeculativeConstantsAddresses;
+    // Block start addresses which have been promoted out of the cold tier.
+    std::unordered_set<u32> tierUpAddresses;
+    // Block start addresses which the entry counters found to be hot.
+    std::unordered_set<u32> hotAddresses;
+    // Guest PCs of loads and stores whose fastmem access faulted. These are nearly always MMIO
+    // accesses, so this survives invalidation and recompiles go straight to the slow path.
+    std::unordered_set<u32> slowmemAddresses;
+    // The first target seen by each indirect branch, which later compiles link to directly.
+    std::unordered_map<u32, u32> indirectBranchTargets;
   };
 
   PPCAnalyst::CodeBlock code_block;
   PPCAnalyst::PPCAnalyzer analyzer;
 
+  // Analyzes a block into code_block and buffer like PPCAnalyzer::Analyze, but reuses the result
+  // of an earlier analysis of the same address if the guest code hasn't changed since. This makes
+  // recompiles after invalidations and cache flushes cheaper.
+  u32 AnalyzeBlock(u32 em_address, PPCAnalyst::CodeBuffer* buffer, std::size_t block_size);
+
   bool CanMergeNextInstructions(int count) const;
 
   void UpdateMemoryOptions();
 
+private:
+  struct CachedAnalysis
+  {
+    u32 next_pc;
+    PPCAnalyst::BlockStats stats;
+    PPCAnalyst::BlockRegStats gpa;
+    PPCAnalyst::BlockRegStats fpa;
+    bool broken;
+    BitSet8 gqr_used;
+    BitSet8 gqr_modified;
+    BitSet32 gpr_inputs;
+    std::set<u32> physical_addresses;
+    std::vector<PPCAnalyst::CodeOp> code;
+  };
+
+  bool IsCachedAnalysisValid(const CachedAnalysis& analysis) const;
+
+  // Keyed by effective address, MSR bits and analyzer options. The guest code is checked on
+  // every use, so this doesn't need to be invalidated.
+  static constexpr size_t MAX_CACHED_ANALYSES = 0x4000;
+  std::unordered_map<u64, CachedAnalysis> m_analysis_cache;
+
 public:
   // This should probably be removed from public:
   JitOptions jo{};
@@ -17,10 +17,17 @@
 #include <set>
 #include <utility>
 
+#include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
 #include "Common/JitRegister.h"
+#include "Common/Logging/Log.h"
+#include "Common/MemoryUtil.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
@@ -32,6 +39,65 @@
 
 using namespace Gen;
 
+namespace
+{
+constexpr u32 MANIFEST_MAGIC = 0x4D424A44;  // "DJBM"
+constexpr u32 MANIFEST_VERSION = 1;
+constexpr u32 MANIFEST_PAGE_SHIFT = 12;
+
+struct ManifestHeader
+{
+  u32 magic;
+  u32 version;
+  u32 feature_flags;
+  u32 num_entries;
+};
+
+struct ManifestEntryHeader
+{
+  u32 effective_address;
+  u32 physical_address;
+  u32 msr_bits;
+  u32 code_hash;
+  u32 num_code_runs;
+};
+
+// Only code in main RAM (or EXRAM) is worth remembering; anything else is too likely to be
+// transient between boots, and can't be hashed without going through MMIO.
+bool IsManifestCodeRange(u32 address, u32 length)
+{
+  const auto is_ram = [](u32 addr) {
+    addr &= 0x3FFFFFFF;
+    if (addr < Memory::REALRAM_SIZE)
+      return true;
+    return Memory::m_pEXRAM && (addr >> 28) == 0x1 && (addr & 0x0FFFFFFF) < Memory::EXRAM_SIZE;
+  };
+  return length != 0 && is_ram(address) && is_ram(address + length - 1) &&
+         ((address ^ (address + length - 1)) >> 28) == 0;
+}
+
+// Contiguous runs of guest code, as (physical start, length in bytes).
+std::vector<std::pair<u32, u32>> GetCodeRuns(const std::set<u32>& physical_addresses)
+{
+  std::vector<std::pair<u32, u32>> code_runs;
+  for (u32 addr : physical_addresses)
+  {
+    if (!code_runs.empty() && code_runs.back().first + code_runs.back().second == addr)
+      code_runs.back().second += 4;
+    else
+      code_runs.emplace_back(addr, 4);
+  }
+  return code_runs;
+}
+
+bool AreCodeRunsInRAM(const std::vector<std::pair<u32, u32>>& code_runs)
+{
+  return std::all_of(code_runs.begin(), code_runs.end(), [](const auto& run) {
+    return IsManifestCodeRange(run.first, run.second);
+  });
+}
+}  // Anonymous namespace
+
 bool JitBlock::OverlapsPhysicalRange(u32 address, u32 length) const
 {
   return physical_addresses.lower_bound(address) !=
@@ -42,17 +108,41 @@ JitBaseBlockCache::JitBaseBlockCache(JitBase& jit) : m_jit{jit}
 {
 }
 
-JitBaseBlockCache::~JitBaseBlockCache() = default;
+JitBaseBlockCache::~JitBaseBlockCache()
+{
+  if (fast_block_map_direct)
+    Common::FreeMemoryPages(fast_block_map_direct, FAST_BLOCK_MAP_SIZE);
+}
 
 void JitBaseBlockCache::Init()
 {
   JitRegister::Init(SConfig::GetInstance().m_perfDir);
 
+  // The dispatchers embed the address of the map, so it is only allocated once
+  if (!fast_block_map)
+  {
+#ifdef _ARCH_64
+    fast_block_map_direct =
+        static_cast<JitBlock**>(Common::AllocateLazyMemoryPages(FAST_BLOCK_MAP_SIZE));
+#endif
+    fast_block_map = fast_block_map_direct ? fast_block_map_direct : fast_block_map_fallback.data();
+  }
+
+  m_lazy_invalidation = SupportsLazyInvalidation() && SConfig::GetInstance().bJITLazyInvalidation;
+  if (m_lazy_invalidation && !m_page_generations)
+    m_page_generations = std::make_unique<u32[]>(1u << (32 - GENERATION_PAGE_SHIFT));
+
   Clear();
 }
 
 void JitBaseBlockCache::Shutdown()
 {
+  if (!m_manifest_game_id.empty())
+    SaveBlockManifest(GetManifestPath(m_manifest_game_id));
+  m_manifest_game_id.clear();
+  m_manifest.clear();
+  m_pending_manifest.clear();
+
   JitRegister::Shutdown();
 }
 
@@ -72,10 +162,12 @@ void JitBaseBlockCache::Clear()
   block_map.clear();
   links_to.clear();
   block_range_map.clear();
+  m_dirty_lines.clear();
 
   valid_block.ClearAll();
 
-  fast_block_map.fill(nullptr);
+  // Destroying the blocks has cleared all entries of the direct map
+  fast_block_map_fallback.fill(nullptr);
 }
 
 void JitBaseBlockCache::Reset()
@@ -86,7 +178,12 @@ void JitBaseBlockCache::Reset()
 
 JitBlock** JitBaseBlockCache::GetFastBlockMap()
 {
-  return fast_block_map.data();
+  return fast_block_map_direct;
+}
+
+JitBlock** JitBaseBlockCache::GetFastBlockMapFallback()
+{
+  return fast_block_map_fallback.data();
 }
 
 void JitBaseBlockCache::RunOnBlocks(std::function<void(const JitBlock&)> f)
@@ -103,6 +200,8 @@ JitBlock* JitBaseBlockCache::AllocateBlock(u32 em_address)
   b.physicalAddress = physicalAddress;
   b.msrBits = MSR.Hex & JIT_CACHE_MSR_MASK;
   b.linkData.clear();
+  b.page_generation_checks.clear();
+  b.code_hash.reset();
   b.fast_block_map_index = 0;
   return &b;
 }
@@ -116,6 +215,10 @@ void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
 
   block.physical_addresses = physical_addresses;
 
+  const std::vector<std::pair<u32, u32>> code_runs = GetCodeRuns(physical_addresses);
+  if (AreCodeRunsInRAM(code_runs))
+    block.code_hash = HashGuestCode(code_runs);
+
   u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
   for (u32 addr : physical_addresses)
   {
@@ -123,6 +226,8 @@ void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
     block_range_map[addr & range_mask].insert(&block);
   }
 
+  RecordManifestBlock(block);
+
   if (block_link)
   {
     for (const auto& e : block.linkData)
@@ -203,8 +308,18 @@ void JitBaseBlockCache::InvalidateICache(u32 address, u32 length, bool forced)
 
   if (destroy_block)
   {
-    // destroy JIT blocks
-    ErasePhysicalRange(pAddr, length);
+    if (m_lazy_invalidation && !forced && length == 32)
+    {
+      // The blocks get destroyed in RevalidatePage once one of them on this page is entered.
+      const u32 page = pAddr >> GENERATION_PAGE_SHIFT;
+      m_page_generations[page]++;
+      m_dirty_lines[page].set((pAddr / 32) % LINES_PER_GENERATION_PAGE);
+    }
+    else
+    {
+      // destroy JIT blocks
+      ErasePhysicalRange(pAddr, length);
+    }
 
     // If the code was actually modified, we need to clear the relevant entries from the
     // FIFO write address cache, so we don't end up with FIFO checks in places they shouldn't
@@ -216,6 +331,9 @@ void JitBaseBlockCache::InvalidateICache(u32 address, u32 length, bool forced)
       {
         m_jit.js.fifoWriteAddresses.erase(i);
         m_jit.js.pairedQuantizeAddresses.erase(i);
+        m_jit.js.tierUpAddresses.erase(i);
+        m_jit.js.hotAddresses.erase(i);
+        m_jit.js.indirectBranchTargets.erase(i);
       }
     }
   }
@@ -270,6 +388,288 @@ void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
   }
 }
 
+void JitBaseBlockCache::EraseChangedBlocks()
+{
+  // Loading a savestate replaces memory without any icache invalidation, so each block's code is
+  // compared with what it was compiled from. Blocks are only referred to by address here, since
+  // erasing one may erase others which overlap it.
+  struct ChangedBlock
+  {
+    u32 physical_address;
+    u32 effective_address;
+    u32 size;
+  };
+  std::vector<ChangedBlock> changed_blocks;
+  for (const auto& e : block_map)
+  {
+    const JitBlock& block = e.second;
+    if (block.physical_addresses.empty())
+      continue;
+    if (block.code_hash && HashGuestCode(GetCodeRuns(block.physical_addresses)) == *block.code_hash)
+      continue;
+    changed_blocks.push_back(
+        {*block.physical_addresses.begin(), block.effectiveAddress, block.originalSize * 4});
+  }
+
+  const size_t num_blocks = block_map.size();
+  for (const ChangedBlock& changed_block : changed_blocks)
+  {
+    ErasePhysicalRange(changed_block.physical_address, 4);
+
+    // As in InvalidateICache, what was learned about the old code doesn't apply to the new code.
+    const u32 end = changed_block.effective_address + changed_block.size;
+    for (u32 i = changed_block.effective_address; i < end; i += 4)
+    {
+      m_jit.js.fifoWriteAddresses.erase(i);
+      m_jit.js.pairedQuantizeAddresses.erase(i);
+      m_jit.js.tierUpAddresses.erase(i);
+      m_jit.js.hotAddresses.erase(i);
+      m_jit.js.indirectBranchTargets.erase(i);
+    }
+  }
+
+  INFO_LOG(DYNA_REC, "Kept %zu of %zu JIT blocks after loading a state", block_map.size(),
+           num_blocks);
+}
+
+const u32* JitBaseBlockCache::GetPageGenerationPointer(u32 physical_address) const
+{
+  return &m_page_generations[physical_address >> GENERATION_PAGE_SHIFT];
+}
+
+void JitBaseBlockCache::RevalidatePage(u32 physical_address)
+{
+  const u32 page = physical_address >> GENERATION_PAGE_SHIFT;
+  const u32 page_start = page << GENERATION_PAGE_SHIFT;
+
+  auto dirty = m_dirty_lines.find(page);
+  if (dirty != m_dirty_lines.end())
+  {
+    const auto lines = dirty->second;
+    m_dirty_lines.erase(dirty);
+    for (u32 i = 0; i < LINES_PER_GENERATION_PAGE; ++i)
+    {
+      if (lines[i])
+        ErasePhysicalRange(page_start + i * 32, 32);
+    }
+  }
+
+  // The remaining blocks don't overlap any invalidated line, so they only need their entry checks
+  // updated to the current generation.
+  const u32 generation = m_page_generations[page];
+  auto start = block_range_map.lower_bound(page_start);
+  const auto end = block_range_map.upper_bound(page_start | ((1 << GENERATION_PAGE_SHIFT) - 1));
+  for (; start != end; ++start)
+  {
+    for (JitBlock* block : start->second)
+    {
+      for (const auto& check : block->page_generation_checks)
+      {
+        if (check.first >> GENERATION_PAGE_SHIFT == page)
+          std::memcpy(check.second, &generation, sizeof(generation));
+      }
+    }
+  }
+}
+
+void JitBaseBlockCache::EraseHostCodeRange(const u8* begin, const u8* end)
+{
+  const u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
+  auto iter = block_map.begin();
+  while (iter != block_map.end())
+  {
+    JitBlock& block = iter->second;
+    if (block.checkedEntry < begin || block.checkedEntry >= end)
+    {
+      ++iter;
+      continue;
+    }
+
+    for (u32 addr : block.physical_addresses)
+    {
+      auto range = block_range_map.find(addr & range_mask);
+      if (range == block_range_map.end())
+        continue;
+      range->second.erase(&block);
+      if (range->second.empty())
+        block_range_map.erase(range);
+    }
+
+    DestroyBlock(block);
+    iter = block_map.erase(iter);
+  }
+}
+
+std::string JitBaseBlockCache::GetManifestPath(const std::string& game_id)
+{
+  return File::GetUserPath(D_CACHE_IDX) + "JIT" DIR_SEP + game_id + ".jbm";
+}
+
+u32 JitBaseBlockCache::GetManifestFeatureFlags()
+{
+  // Settings which change the code the JIT generates for a given guest block. Manifests recorded
+  // with different values are discarded rather than replayed.
+  const SConfig& config = SConfig::GetInstance();
+  return (config.bMMU ? 1 : 0) | (config.bFastmem ? 2 : 0) | (config.bFPRF ? 4 : 0) |
+         (config.bAccurateNaNs ? 8 : 0) | (config.bJITNoBlockLinking ? 16 : 0);
+}
+
+u32 JitBaseBlockCache::HashGuestCode(const std::vector<std::pair<u32, u32>>& code_runs)
+{
+  u32 hash = 0;
+  for (const auto& run : code_runs)
+    hash = hash * 31 + Common::HashAdler32(Memory::GetPointer(run.first), run.second);
+  return hash;
+}
+
+void JitBaseBlockCache::RecordManifestBlock(const JitBlock& block)
+{
+  if (!SConfig::GetInstance().bJITBlockManifest || block.physical_addresses.empty() ||
+      !block.code_hash)
+  {
+    return;
+  }
+
+  ManifestEntry entry;
+  entry.effective_address = block.effectiveAddress;
+  entry.physical_address = block.physicalAddress;
+  entry.msr_bits = block.msrBits;
+  entry.code_runs = GetCodeRuns(block.physical_addresses);
+  entry.code_hash = *block.code_hash;
+  m_manifest[{entry.effective_address, entry.msr_bits}] = std::move(entry);
+}
+
+void JitBaseBlockCache::LoadBlockManifest(const std::string& filename)
+{
+  m_manifest.clear();
+  m_pending_manifest.clear();
+
+  File::IOFile file(filename, "rb");
+  ManifestHeader header;
+  if (!file.ReadArray(&header, 1))
+    return;
+
+  if (header.magic != MANIFEST_MAGIC || header.version != MANIFEST_VERSION ||
+      header.feature_flags != GetManifestFeatureFlags())
+  {
+    INFO_LOG(DYNA_REC, "Ignoring stale JIT block manifest %s", filename.c_str());
+    return;
+  }
+
+  for (u32 i = 0; i < header.num_entries; ++i)
+  {
+    ManifestEntryHeader entry_header;
+    if (!file.ReadArray(&entry_header, 1))
+      break;
+
+    ManifestEntry entry;
+    entry.effective_address = entry_header.effective_address;
+    entry.physical_address = entry_header.physical_address;
+    entry.msr_bits = entry_header.msr_bits;
+    entry.code_hash = entry_header.code_hash;
+    entry.code_runs.resize(entry_header.num_code_runs);
+    if (!file.ReadArray(entry.code_runs.data(), entry.code_runs.size()))
+      break;
+
+    m_pending_manifest.emplace(entry.effective_address >> MANIFEST_PAGE_SHIFT, std::move(entry));
+  }
+
+  INFO_LOG(DYNA_REC, "Loaded %zu blocks from JIT block manifest %s", m_pending_manifest.size(),
+           filename.c_str());
+}
+
+void JitBaseBlockCache::SaveBlockManifest(const std::string& filename) const
+{
+  // Blocks from the previous session which were never reached are kept, since the game may
+  // simply not have gotten that far this time.
+  std::vector<const ManifestEntry*> entries;
+  entries.reserve(m_manifest.size() + m_pending_manifest.size());
+  for (const auto& e : m_manifest)
+    entries.push_back(&e.second);
+  for (const auto& e : m_pending_manifest)
+  {
+    if (!m_manifest.count({e.second.effective_address, e.second.msr_bits}))
+      entries.push_back(&e.second);
+  }
+
+  if (entries.empty())
+    return;
+
+  File::CreateFullPath(filename);
+  File::IOFile file(filename, "wb");
+  const ManifestHeader header{MANIFEST_MAGIC, MANIFEST_VERSION, GetManifestFeatureFlags(),
+                              static_cast<u32>(entries.size())};
+  if (!file.WriteArray(&header, 1))
+    return;
+
+  for (const ManifestEntry* entry : entries)
+  {
+    const ManifestEntryHeader entry_header{
+        entry->effective_address, entry->physical_address, entry->msr_bits, entry->code_hash,
+        static_cast<u32>(entry->code_runs.size())};
+    if (!file.WriteArray(&entry_header, 1) ||
+        !file.WriteArray(entry->code_runs.data(), entry->code_runs.size()))
+    {
+      ERROR_LOG(DYNA_REC, "Failed to write JIT block manifest %s", filename.c_str());
+      return;
+    }
+  }
+}
+
+void JitBaseBlockCache::SyncManifestWithRunningGame()
+{
+  // Wii titles can launch other titles, so the manifest follows whatever is currently running.
+  const std::string& game_id = SConfig::GetInstance().GetGameID();
+  if (game_id == m_manifest_game_id)
+    return;
+
+  if (!m_manifest_game_id.empty())
+    SaveBlockManifest(GetManifestPath(m_manifest_game_id));
+  LoadBlockManifest(GetManifestPath(game_id));
+  m_manifest_game_id = game_id;
+}
+
+void JitBaseBlockCache::PrecompileFromManifest(u32 em_address)
+{
+  // Jit() calls back into here, so only the outermost miss drives precompilation.
+  if (m_precompiling || !SConfig::GetInstance().bJITBlockManifest)
+    return;
+
+  SyncManifestWithRunningGame();
+  if (m_pending_manifest.empty())
+    return;
+
+  m_precompiling = true;
+  const u32 msr_bits = MSR.Hex & JIT_CACHE_MSR_MASK;
+  auto range = m_pending_manifest.equal_range(em_address >> MANIFEST_PAGE_SHIFT);
+  while (range.first != range.second)
+  {
+    const ManifestEntry& entry = range.first->second;
+    if (entry.msr_bits != msr_bits)
+    {
+      ++range.first;
+      continue;
+    }
+
+    // The address translation must still lead to the same code, and that code must still be
+    // the code we compiled last time. Otherwise we simply wait for the normal dispatcher miss.
+    const auto translated = PowerPC::JitCache_TranslateAddress(entry.effective_address);
+    const bool ranges_valid =
+        std::all_of(entry.code_runs.begin(), entry.code_runs.end(), [](const auto& run) {
+          return IsManifestCodeRange(run.first, run.second);
+        });
+    if (translated.valid && translated.address == entry.physical_address && ranges_valid &&
+        !GetBlockFromStartAddress(entry.effective_address, MSR.Hex) &&
+        HashGuestCode(entry.code_runs) == entry.code_hash)
+    {
+      m_jit.Jit(entry.effective_address);
+    }
+
+    range.first = m_pending_manifest.erase(range.first);
+  }
+  m_precompiling = false;
+}
+
 u32* JitBaseBlockCache::GetBlockBitSet() const
 {
   return valid_block.m_valid_block.get();
@@ -386,5 +786,7 @@ JitBlock* JitBaseBlockCache::MoveBlockIntoFastCache(u32 addr, u32 msr)
 
 size_t JitBaseBlockCache::FastLookupIndexForAddress(u32 address)
 {
-  return (address >> 2) & FAST_BLOCK_MAP_MASK;
+  if (fast_block_map_direct)
+    return address >> 2;
+  return (address >> 2) & FAST_BLOCK_MAP_FALLBACK_MASK;
 }
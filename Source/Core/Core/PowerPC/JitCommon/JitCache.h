@@ -10,7 +10,11 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -64,6 +68,14 @@ struct JitBlock
   // This set stores all physical addresses of all occupied instructions.
   std::set<u32> physical_addresses;
 
+  // Hash of the guest code the block was compiled from, unless some of it is outside of RAM.
+  // Used to find out which blocks are still valid after a savestate is loaded.
+  std::optional<u32> code_hash;
+
+  // With lazy invalidation, the entry checks of the pages this block spans, as (physical address
+  // within the page, location of the expected 32-bit generation in the host code).
+  std::vector<std::pair<u32, u8*>> page_generation_checks;
+
   // Block profiling data, structure is inlined in Jit.cpp
   struct ProfileData
   {
@@ -72,6 +84,8 @@ struct JitBlock
     u64 runCount;
     u64 ticStart;
     u64 ticStop;
+    // Time spent analyzing and compiling the block, in performance counter ticks
+    u64 compileTicks;
   } profile_data = {};
 
   // This tracks the position if this block within the fast block cache.
@@ -118,8 +132,11 @@ public:
   // is valid (MSR.IR and MSR.DR, the address translation bits).
   static constexpr u32 JIT_CACHE_MSR_MASK = 0x30;
 
-  static constexpr u32 FAST_BLOCK_MAP_ELEMENTS = 0x10000;
-  static constexpr u32 FAST_BLOCK_MAP_MASK = FAST_BLOCK_MAP_ELEMENTS - 1;
+  // The fast block map is a direct table with an entry for every effective address (>> 2) on
+  // hosts which can reserve the address space for it, and a smaller hashed table otherwise.
+  static constexpr u64 FAST_BLOCK_MAP_SIZE = 0x200000000ULL;
+  static constexpr u32 FAST_BLOCK_MAP_FALLBACK_ELEMENTS = 0x10000;
+  static constexpr u32 FAST_BLOCK_MAP_FALLBACK_MASK = FAST_BLOCK_MAP_FALLBACK_ELEMENTS - 1;
 
   explicit JitBaseBlockCache(JitBase& jit);
   virtual ~JitBaseBlockCache();
@@ -130,7 +147,9 @@ public:
   void Reset();
 
   // Code Cache
+  // The direct fast block map, or nullptr if the fallback map is used instead.
   JitBlock** GetFastBlockMap();
+  JitBlock** GetFastBlockMapFallback();
   void RunOnBlocks(std::function<void(const JitBlock&)> f);
 
   JitBlock* AllocateBlock(u32 em_address);
@@ -149,15 +168,39 @@ public:
 
   void InvalidateICache(u32 address, u32 length, bool forced);
   void ErasePhysicalRange(u32 address, u32 length);
+  // Destroys all blocks whose guest code doesn't match their code hash anymore.
+  void EraseChangedBlocks();
+
+  // With lazy invalidation, invalidating a cache line containing code only bumps the generation
+  // of its page. Blocks compare the generations of their pages on entry and call
+  // RevalidatePage() on a mismatch, which destroys the blocks overlapping invalidated lines.
+  bool IsLazyInvalidationEnabled() const { return m_lazy_invalidation; }
+  const u32* GetPageGenerationPointer(u32 physical_address) const;
+  void RevalidatePage(u32 physical_address);
+  // Destroys all blocks whose host code starts within [begin, end).
+  void EraseHostCodeRange(const u8* begin, const u8* end);
 
   u32* GetBlockBitSet() const;
 
+  // The block manifest is a per-game list of every block that has been compiled, together with
+  // a hash of its guest code. It is saved on shutdown and reloaded on the next boot, so that
+  // known blocks can be compiled in batches as soon as their code is found in memory again
+  // instead of being discovered one dispatcher miss at a time.
+  void LoadBlockManifest(const std::string& filename);
+  void SaveBlockManifest(const std::string& filename) const;
+  // Compiles all pending manifest blocks which live in the same guest page as em_address and
+  // whose guest code still matches. Entries which don't match are dropped.
+  void PrecompileFromManifest(u32 em_address);
+  bool IsPrecompiling() const { return m_precompiling; }
+
 protected:
   JitBase& m_jit;
 
 private:
   virtual void WriteLinkBlock(const JitBlock::LinkData& source, const JitBlock* dest) = 0;
   virtual void WriteDestroyBlock(const JitBlock& block);
+  // Whether the backend emits the entry checks needed for lazy invalidation.
+  virtual bool SupportsLazyInvalidation() const { return false; }
 
   void LinkBlockExits(JitBlock& block);
   void LinkBlock(JitBlock& block);
@@ -169,6 +212,30 @@ private:
   // Fast but risky block lookup based on fast_block_map.
   size_t FastLookupIndexForAddress(u32 address);
 
+  struct ManifestEntry
+  {
+    u32 effective_address;
+    u32 physical_address;
+    u32 msr_bits;
+    u32 code_hash;
+    // Contiguous runs of guest code making up the block, as (physical start, length in bytes).
+    std::vector<std::pair<u32, u32>> code_runs;
+  };
+
+  static std::string GetManifestPath(const std::string& game_id);
+  static u32 GetManifestFeatureFlags();
+  static u32 HashGuestCode(const std::vector<std::pair<u32, u32>>& code_runs);
+  void RecordManifestBlock(const JitBlock& block);
+  void SyncManifestWithRunningGame();
+
+  // All blocks compiled during this session, keyed by (effective address, MSR bits).
+  // Unlike the other maps, this survives Clear() since it describes guest code, not host code.
+  std::map<std::pair<u32, u32>, ManifestEntry> m_manifest;
+  // Blocks loaded from a previous session which haven't been compiled yet, keyed by guest page.
+  std::multimap<u32, ManifestEntry> m_pending_manifest;
+  std::string m_manifest_game_id;
+  bool m_precompiling = false;
+
   // links_to hold all exit points of all valid blocks in a reverse way.
   // It is used to query all blocks which links to an address.
   std::multimap<u32, JitBlock*> links_to;  // destination_PC -> number
@@ -187,7 +254,19 @@ private:
   // It is used to provide a fast way to query if no icache invalidation is needed.
   ValidBlockBitSet valid_block;
 
-  // This array is indexed with the masked PC and likely holds the correct block id.
-  // This is used as a fast cache of block_map used in the assembly dispatcher.
-  std::array<JitBlock*, FAST_BLOCK_MAP_ELEMENTS> fast_block_map;  // start_addr & mask -> number
+  static constexpr u32 GENERATION_PAGE_SHIFT = 12;
+  static constexpr u32 LINES_PER_GENERATION_PAGE = (1 << GENERATION_PAGE_SHIFT) / 32;
+  bool m_lazy_invalidation = false;
+  // Indexed by physical page, only allocated with lazy invalidation.
+  std::unique_ptr<u32[]> m_page_generations;
+  // Cache lines invalidated since the blocks on their page were last revalidated.
+  std::unordered_map<u32, std::bitset<LINES_PER_GENERATION_PAGE>> m_dirty_lines;
+
+  // These tables are indexed with the (masked) PC and likely hold the correct block id.
+  // They are used as a fast cache of block_map used in the assembly dispatcher.
+  // fast_block_map points to the one in use. The direct map is lazily committed, so only the
+  // pages around code addresses use memory.
+  JitBlock** fast_block_map = nullptr;
+  JitBlock** fast_block_map_direct = nullptr;  // start_addr >> 2 -> number
+  std::array<JitBlock*, FAST_BLOCK_MAP_FALLBACK_ELEMENTS> fast_block_map_fallback;
 };
@@ -16,7 +16,6 @@
 #include "Common/PerformanceCounter.h"
 #endif
 
-#include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/File.h"
 #include "Common/MsgHandler.h"
@@ -27,6 +26,7 @@
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
+#include "Core/PowerPC/PPCTables.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/PowerPC/Profiler.h"
 
@@ -40,11 +40,6 @@
 
 namespace JitInterface
 {
-void DoState(PointerWrap& p)
-{
-  if (g_jit && p.GetMode() == PointerWrap::MODE_READ)
-    g_jit->ClearCache();
-}
 CPUCoreBase* InitJitCore(int core)
 {
   switch (core)
@@ -91,17 +86,23 @@ void WriteProfileResults(const std::string& filename)
     return;
   }
   fprintf(f.GetHandle(), "origAddr\tblkName\trunCount\tcost\ttimeCost\tpercent\ttimePercent\tOvAlli"
-                         "nBlkTime(ms)\tblkCodeSize\n");
+                         "nBlkTime(ms)\tblkCodeSize\tcompileTime(us)\n");
   for (auto& stat : prof_stats.block_stats)
   {
     std::string name = g_symbolDB.GetDescription(stat.addr);
+    double compile_us = (double)stat.compile_ticks * 1000000.0 / (double)prof_stats.countsPerSec;
     double percent = 100.0 * (double)stat.cost / (double)prof_stats.cost_sum;
     double timePercent = 100.0 * (double)stat.tick_counter / (double)prof_stats.timecost_sum;
     fprintf(f.GetHandle(),
-            "%08x\t%s\t%" PRIu64 "\t%" PRIu64 "\t%" PRIu64 "\t%.2f\t%.2f\t%.2f\t%i\n", stat.addr,
-            name.c_str(), stat.run_count, stat.cost, stat.tick_counter, percent, timePercent,
-            (double)stat.tick_counter * 1000.0 / (double)prof_stats.countsPerSec, stat.block_size);
+            "%08x\t%s\t%" PRIu64 "\t%" PRIu64 "\t%" PRIu64 "\t%.2f\t%.2f\t%.2f\t%i\t%.1f\n",
+            stat.addr, name.c_str(), stat.run_count, stat.cost, stat.tick_counter, percent,
+            timePercent, (double)stat.tick_counter * 1000.0 / (double)prof_stats.countsPerSec,
+            stat.block_size, compile_us);
   }
+
+  fprintf(f.GetHandle(), "\ninstruction\tinterpreterFallbacks\n");
+  for (auto& stat : prof_stats.fallback_stats)
+    fprintf(f.GetHandle(), "%s\t%" PRIu64 "\n", stat.opname, stat.fallback_count);
 }
 
 void GetProfileResults(Profiler::ProfileStats* prof_stats)
@@ -113,6 +114,7 @@ void GetProfileResults(Profiler::ProfileStats* prof_stats)
   prof_stats->cost_sum = 0;
   prof_stats->timecost_sum = 0;
   prof_stats->block_stats.clear();
+  prof_stats->fallback_stats.clear();
 
   Core::State old_state = Core::GetState();
   if (old_state == Core::State::Running)
@@ -126,12 +128,20 @@ void GetProfileResults(Profiler::ProfileStats* prof_stats)
     // Todo: tweak.
     if (data.runCount >= 1)
       prof_stats->block_stats.emplace_back(block.effectiveAddress, cost, timecost, data.runCount,
-                                           block.codeSize);
+                                           block.codeSize, data.compileTicks);
     prof_stats->cost_sum += cost;
     prof_stats->timecost_sum += timecost;
   });
 
   sort(prof_stats->block_stats.begin(), prof_stats->block_stats.end());
+
+  for (size_t i = 0; i < m_numInstructions; i++)
+  {
+    const GekkoOPInfo* info = m_allInstructions[i];
+    if (info->fallbackCount != 0)
+      prof_stats->fallback_stats.emplace_back(info->opname, info->fallbackCount);
+  }
+  sort(prof_stats->fallback_stats.begin(), prof_stats->fallback_stats.end());
   if (old_state == Core::State::Running)
     Core::SetState(Core::State::Running);
 }
@@ -200,6 +210,8 @@ void ClearCache()
 {
   if (g_jit)
     g_jit->ClearCache();
+  // The fallback counts belong to the blocks which were just thrown away, like their profiles
+  PPCTables::ResetFallbackCounts();
 }
 void ClearSafe()
 {
@@ -211,6 +223,12 @@ void ClearSafe()
     g_jit->GetBlockCache()->Clear();
 }
 
+void OnStateLoaded()
+{
+  if (g_jit)
+    g_jit->GetBlockCache()->EraseChangedBlocks();
+}
+
 void InvalidateICache(u32 address, u32 size, bool forced)
 {
   if (g_jit)
@@ -235,6 +253,9 @@ void CompileExceptionCheck(ExceptionType type)
   case ExceptionType::SpeculativeConstants:
     exception_addresses = &g_jit->js.noSpeculativeConstantsAddresses;
     break;
+  case ExceptionType::HotBlock:
+    exception_addresses = &g_jit->js.hotAddresses;
+    break;
   }
 
   if (PC != 0 && (exception_addresses->find(PC)) == (exception_addresses->end()))
@@ -254,6 +275,24 @@ void CompileExceptionCheck(ExceptionType type)
   }
 }
 
+void RevalidateCodePage(u32 physical_address)
+{
+  if (g_jit)
+    g_jit->GetBlockCache()->RevalidatePage(physical_address);
+}
+
+void PredictIndirectBranch(u32 branch_address)
+{
+  if (!g_jit)
+    return;
+
+  if (g_jit->js.indirectBranchTargets.emplace(branch_address, PC).second)
+  {
+    // Invalidate the JIT block so that it gets recompiled with a check for the target.
+    g_jit->GetBlockCache()->InvalidateICache(branch_address, 4, true);
+  }
+}
+
 void Shutdown()
 {
   if (g_jit)
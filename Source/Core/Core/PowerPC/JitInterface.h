@@ -10,7 +10,6 @@
 #include "Core/MachineContext.h"
 
 class CPUCoreBase;
-class PointerWrap;
 
 namespace Profiler
 {
@@ -23,11 +22,10 @@ enum class ExceptionType
 {
   FIFOWrite,
   PairedQuantize,
-  SpeculativeConstants
+  SpeculativeConstants,
+  HotBlock
 };
 
-void DoState(PointerWrap& p);
-
 CPUCoreBase* InitJitCore(int core);
 CPUCoreBase* GetCore();
 
@@ -45,10 +43,20 @@ void ClearCache();
 
 void ClearSafe();
 
+// Called after a savestate has been loaded. Rather than clearing the cache, this destroys only the
+// blocks whose guest code differs in the loaded state, so the rest don't need to be recompiled.
+void OnStateLoaded();
+
 // If "forced" is true, a recompile is being requested on code that hasn't been modified.
 void InvalidateICache(u32 address, u32 size, bool forced);
 
 void CompileExceptionCheck(ExceptionType type);
 
+// Called by blocks whose entry check found their page invalidated.
+void RevalidateCodePage(u32 physical_address);
+
+// Remembers the current PC as the predicted target of the indirect branch at branch_address.
+void PredictIndirectBranch(u32 branch_address);
+
 void Shutdown();
 }
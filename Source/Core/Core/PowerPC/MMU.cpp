@@ -27,8 +27,6 @@
 
 namespace PowerPC
 {
-constexpr size_t HW_PAGE_SIZE = 4096;
-constexpr u32 HW_PAGE_INDEX_SHIFT = 12;
 constexpr u32 HW_PAGE_INDEX_MASK = 0x3f;
 
 // EFB RE
@@ -641,16 +639,14 @@ std::string HostGetString(u32 address, size_t size)
 
 bool IsOptimizableRAMAddress(const u32 address)
 {
-  if (PowerPC::memchecks.HasAny())
-    return false;
-
   if (!MSR.DR)
     return false;
 
   // TODO: This API needs to take an access size
   //
   // We store whether an access can be optimized to an unchecked access
-  // in dbat_table.
+  // in dbat_table. Pages overlapping a memcheck never have the physical bit set, so accesses
+  // to other pages can stay unchecked while watchpoints are active.
   u32 bat_result = dbat_table[address >> BAT_INDEX_SHIFT];
   return (bat_result & BAT_PHYSICAL_BIT) != 0;
 }
@@ -791,7 +787,7 @@ void ClearCacheLine(u32 address)
 
 u32 IsOptimizableMMIOAccess(u32 address, u32 access_size)
 {
-  if (PowerPC::memchecks.HasAny())
+  if (PowerPC::memchecks.OverlapsMemcheck(address, BAT_PAGE_SIZE))
     return 0;
 
   if (!MSR.DR)
@@ -813,7 +809,7 @@ u32 IsOptimizableMMIOAccess(u32 address, u32 access_size)
 
 bool IsOptimizableGatherPipeWrite(u32 address)
 {
-  if (PowerPC::memchecks.HasAny())
+  if (PowerPC::memchecks.OverlapsMemcheck(address, BAT_PAGE_SIZE))
     return false;
 
   if (!MSR.DR)
@@ -1041,6 +1037,59 @@ static TLBLookupResult LookupTLBPageAddress(const XCheckTLBFlag flag, const u32
   return TLBLookupResult::NotFound;
 }
 
+static void InvalidateHostTLBEntry(const u32 tag)
+{
+  if (tag == TLBEntry::INVALID_TAG)
+    return;
+
+  for (auto& host_tlb : ppcState.host_tlb)
+  {
+    HostTLBEntry& entry = host_tlb[tag & (HOST_TLB_SIZE - 1)];
+    if (entry.tag == tag << HW_PAGE_INDEX_SHIFT)
+      entry.tag = HostTLBEntry::INVALID_TAG;
+  }
+}
+
+// Must only be called once the data TLB contains the translation, so that evicting the TLB entry
+// also evicts the host TLB entry.
+static void UpdateHostTLBEntry(const XCheckTLBFlag flag, const u32 address, const u32 paddr)
+{
+  if (flag != XCheckTLBFlag::Read && flag != XCheckTLBFlag::Write)
+    return;
+
+  const u32 page = address & ~(HW_PAGE_SIZE - 1);
+  const u32 physical_page = paddr & ~(HW_PAGE_SIZE - 1);
+  u8* host_page;
+  if ((physical_page & 0xF8000000) == 0x00000000)
+  {
+    host_page = &Memory::m_pRAM[physical_page & Memory::RAM_MASK];
+  }
+  else if (Memory::m_pEXRAM && (physical_page >> 28) == 0x1 &&
+           (physical_page & 0x0FFFFFFF) < Memory::EXRAM_SIZE)
+  {
+    host_page = &Memory::m_pEXRAM[physical_page & 0x0FFFFFFF];
+  }
+  else
+  {
+    return;
+  }
+
+  // Accesses which skip TranslateAddress also skip the memcheck.
+  if (memchecks.OverlapsMemcheck(page, HW_PAGE_SIZE))
+    return;
+
+  HostTLBEntry& entry = ppcState.host_tlb[flag == XCheckTLBFlag::Write]
+                                         [(page >> HW_PAGE_INDEX_SHIFT) & (HOST_TLB_SIZE - 1)];
+  entry.tag = page;
+  entry.host_offset = reinterpret_cast<uintptr_t>(host_page) - page;
+}
+
+static void InvalidateHostTLB()
+{
+  for (auto& host_tlb : ppcState.host_tlb)
+    host_tlb.fill({});
+}
+
 static void UpdateTLBEntry(const XCheckTLBFlag flag, UPTE2 PTE2, const u32 address)
 {
   if (IsNoExceptionFlag(flag))
@@ -1049,6 +1098,8 @@ static void UpdateTLBEntry(const XCheckTLBFlag flag, UPTE2 PTE2, const u32 addre
   const int tag = address >> HW_PAGE_INDEX_SHIFT;
   TLBEntry& tlbe = ppcState.tlb[IsOpcodeFlag(flag)][tag & HW_PAGE_INDEX_MASK];
   const int index = tlbe.recent == 0 && tlbe.tag[0] != TLBEntry::INVALID_TAG;
+  if (!IsOpcodeFlag(flag))
+    InvalidateHostTLBEntry(tlbe.tag[index]);
   tlbe.recent = index;
   tlbe.paddr[index] = PTE2.RPN << HW_PAGE_INDEX_SHIFT;
   tlbe.pte[index] = PTE2.Hex;
@@ -1060,6 +1111,8 @@ void InvalidateTLBEntry(u32 address)
   const u32 entry_index = (address >> HW_PAGE_INDEX_SHIFT) & HW_PAGE_INDEX_MASK;
 
   TLBEntry& tlbe = ppcState.tlb[0][entry_index];
+  InvalidateHostTLBEntry(tlbe.tag[0]);
+  InvalidateHostTLBEntry(tlbe.tag[1]);
   tlbe.tag[0] = TLBEntry::INVALID_TAG;
   tlbe.tag[1] = TLBEntry::INVALID_TAG;
 
@@ -1078,7 +1131,10 @@ static TranslateAddressResult TranslatePageAddress(const u32 address, const XChe
   u32 translatedAddress = 0;
   TLBLookupResult res = LookupTLBPageAddress(flag, address, &translatedAddress);
   if (res == TLBLookupResult::Found)
+  {
+    UpdateHostTLBEntry(flag, address, translatedAddress);
     return TranslateAddressResult{TranslateAddressResult::PAGE_TABLE_TRANSLATED, translatedAddress};
+  }
 
   u32 sr = PowerPC::ppcState.sr[EA_SR(address)];
 
@@ -1152,6 +1208,7 @@ static TranslateAddressResult TranslatePageAddress(const u32 address, const XChe
         // We already updated the TLB entry if this was caused by a C bit.
         if (res != TLBLookupResult::UpdateC)
           UpdateTLBEntry(flag, PTE2, address);
+        UpdateHostTLBEntry(flag, address, PTE2.RPN << 12);
 
         return TranslateAddressResult{TranslateAddressResult::PAGE_TABLE_TRANSLATED,
                                       (PTE2.RPN << 12) | offset};
@@ -1253,6 +1310,9 @@ static void UpdateFakeMMUBat(BatTable& bat_table, u32 start_addr)
 
 void DBATUpdated()
 {
+  // The host TLB depends on the BATs taking precedence, the memchecks and the RAM pointers.
+  InvalidateHostTLB();
+
   dbat_table = {};
   UpdateBATs(dbat_table, SPR_DBAT0U);
   bool extended_bats = SConfig::GetInstance().bWii && HID4.SBE;
@@ -5,16 +5,19 @@
 #include "Core/PowerPC/PPCAnalyst.h"
 
 #include <algorithm>
+#include <array>
 #include <map>
 #include <queue>
 #include <string>
 #include <vector>
 
 #include "Common/Assert.h"
+#include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
 #include "Core/ConfigManager.h"
+#include "Core/HLE/HLE.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PPCTables.h"
@@ -40,6 +43,9 @@ constexpr int CODEBUFFER_SIZE = 32000;
 // 0 does not perform block merging
 constexpr u32 BRANCH_FOLLOWING_THRESHOLD = 2;
 
+// Maximum number of conditional branches a trace may follow
+constexpr u32 TRACE_FOLLOWING_THRESHOLD = 4;
+
 constexpr u32 INVALID_BRANCH_TARGET = 0xFFFFFFFF;
 
 static u32 EvaluateBranchTarget(UGeckoInstruction instr, u32 pc)
@@ -67,6 +73,123 @@ static u32 EvaluateBranchTarget(UGeckoInstruction instr, u32 pc)
   }
 }
 
+static u32 RotationMask(u32 mb, u32 me)
+{
+  const u32 begin = 0xFFFFFFFF >> mb;
+  const u32 end = me < 31 ? (0xFFFFFFFF >> (me + 1)) : 0;
+  const u32 mask = begin ^ end;
+  return me < mb ? ~mask : mask;
+}
+
+// Works out the result of an integer instruction which writes a single GPR, doesn't touch CR or
+// XER, and whose inputs are all known.
+static bool EvaluateConstantResult(const CodeOp& op, const std::array<u32, 32>& values,
+                                   BitSet32 known, u32* result)
+{
+  const UGeckoInstruction inst = op.inst;
+  if (op.regsIn & ~known)
+    return false;
+
+  const u32 a = values[inst.RA];
+  const u32 b = values[inst.RB];
+  const u32 s = values[inst.RS];
+
+  switch (inst.OPCD)
+  {
+  case 7:  // mulli
+    *result = a * inst.SIMM_16;
+    return true;
+  case 14:  // addi
+    *result = (inst.RA ? a : 0) + inst.SIMM_16;
+    return true;
+  case 15:  // addis
+    *result = (inst.RA ? a : 0) + (static_cast<u32>(inst.SIMM_16) << 16);
+    return true;
+  case 20:  // rlwimix
+  {
+    if (inst.Rc)
+      return false;
+    const u32 mask = RotationMask(inst.MB, inst.ME);
+    *result = (Common::RotateLeft(s, inst.SH) & mask) | (a & ~mask);
+    return true;
+  }
+  case 21:  // rlwinmx
+    if (inst.Rc)
+      return false;
+    *result = Common::RotateLeft(s, inst.SH) & RotationMask(inst.MB, inst.ME);
+    return true;
+  case 24:  // ori
+    *result = s | inst.UIMM;
+    return true;
+  case 25:  // oris
+    *result = s | (inst.UIMM << 16);
+    return true;
+  case 26:  // xori
+    *result = s ^ inst.UIMM;
+    return true;
+  case 27:  // xoris
+    *result = s ^ (inst.UIMM << 16);
+    return true;
+  case 31:
+    if (inst.Rc)
+      return false;
+    switch (inst.SUBOP10)
+    {
+    case 24:  // slwx
+      *result = (b & 0x20) ? 0 : s << (b & 0x1F);
+      return true;
+    case 28:  // andx
+      *result = s & b;
+      return true;
+    case 40:  // subfx
+      *result = b - a;
+      return true;
+    case 60:  // andcx
+      *result = s & ~b;
+      return true;
+    case 104:  // negx
+      *result = 0 - a;
+      return true;
+    case 124:  // norx
+      *result = ~(s | b);
+      return true;
+    case 235:  // mullwx
+      *result = a * b;
+      return true;
+    case 266:  // addx
+      *result = a + b;
+      return true;
+    case 284:  // eqvx
+      *result = ~(s ^ b);
+      return true;
+    case 316:  // xorx
+      *result = s ^ b;
+      return true;
+    case 412:  // orcx
+      *result = s | ~b;
+      return true;
+    case 444:  // orx
+      *result = s | b;
+      return true;
+    case 476:  // nandx
+      *result = ~(s & b);
+      return true;
+    case 536:  // srwx
+      *result = (b & 0x20) ? 0 : s >> (b & 0x1F);
+      return true;
+    case 922:  // extshx
+      *result = static_cast<u32>(static_cast<s32>(static_cast<s16>(s)));
+      return true;
+    case 954:  // extsbx
+      *result = static_cast<u32>(static_cast<s32>(static_cast<s8>(s)));
+      return true;
+    }
+    return false;
+  }
+
+  return false;
+}
+
 // To find the size of each found function, scan
 // forward until we hit blr or rfi. In the meantime, collect information
 // about which functions this function calls.
@@ -642,6 +765,51 @@ void PPCAnalyzer::SetInstructionStats(CodeBlock* block, CodeOp* code, const Gekk
   }
 }
 
+bool PPCAnalyzer::IsBusyWaitLoop(const CodeOp* code, u32 branch_index) const
+{
+  // Running another iteration of a busy wait loop can't do anything the previous one didn't,
+  // unless something outside of the CPU thread (an interrupt, DMA, a device register) changes
+  // what it reads. That holds if the loop:
+  //   * only contains integer instructions, loads and branches which don't link or use CTR,
+  //   * doesn't write memory, XER or any other SPR,
+  //   * doesn't read a register before writing it, if the loop writes that register at all.
+  BitSet32 written_regs;
+  BitSet32 write_disallowed_regs;
+  for (u32 i = 0; i <= branch_index; ++i)
+  {
+    const CodeOp& op = code[i];
+    const UGeckoInstruction inst = op.inst;
+
+    if (op.opinfo->type == OpType::Branch)
+    {
+      // Conditional branches out of the loop are fine, anything else isn't.
+      if (inst.OPCD == 18 && !inst.LK && i == branch_index)
+        continue;
+      if (inst.OPCD == 16 && !inst.LK && (inst.BO & BO_DONT_DECREMENT_FLAG))
+        continue;
+      return false;
+    }
+
+    if (op.opinfo->type != OpType::Integer && op.opinfo->type != OpType::Load)
+      return false;
+    if (op.opinfo->flags & (FL_EVIL | FL_TIMER | FL_SET_CA | FL_READ_CA))
+      return false;
+    if ((op.opinfo->flags & FL_SET_OE) && inst.OE)
+      return false;
+
+    for (int reg : op.regsIn)
+    {
+      if (!written_regs[reg])
+        write_disallowed_regs[reg] = true;
+    }
+    if (op.regsOut & write_disallowed_regs)
+      return false;
+    written_regs |= op.regsOut;
+  }
+
+  return true;
+}
+
 u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std::size_t block_size)
 {
   // Clear block stats
@@ -670,6 +838,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
   bool found_call = false;
   size_t caller = 0;
   u32 numFollows = 0;
+  u32 numTraceFollows = 0;
   u32 num_inst = 0;
 
   for (std::size_t i = 0; i < block_size; ++i)
@@ -693,11 +862,21 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
     code[i].branchTo = UINT32_MAX;
     code[i].branchToIndex = UINT32_MAX;
     code[i].skip = false;
+    code[i].traceTaken = false;
+    code[i].branchIsIdleLoop = false;
     block->m_stats->numCycles += opinfo->numCycles;
     block->m_physical_addresses.insert(result.physical_address);
 
     SetInstructionStats(block, &code[i], opinfo, static_cast<u32>(i));
 
+    // Until a branch has been followed, the block is straight-line code starting at its entry,
+    // so a branch back to the entry closes a loop over everything analyzed so far.
+    if (opinfo->type == OpType::Branch && numFollows == 0 && numTraceFollows == 0 &&
+        EvaluateBranchTarget(inst, address) == block->m_address)
+    {
+      code[i].branchIsIdleLoop = IsBusyWaitLoop(code, static_cast<u32>(i));
+    }
+
     bool follow = false;
     u32 destination = 0;
 
@@ -714,8 +893,8 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
         // Always follow BX instructions.
         // TODO: Loop unrolling might bloat the code size too much.
         //       Enable it carefully.
-        follow = destination != block->m_address;
         destination = SignExt26(inst.LI << 2) + (inst.AA ? 0 : address);
+        follow = destination != block->m_address;
         if (inst.LK)
         {
           found_call = true;
@@ -792,6 +971,28 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
       }
     }
 
+    if (conditional_continue && HasOption(OPTION_TRACE_FOLLOW) &&
+        numTraceFollows < TRACE_FOLLOWING_THRESHOLD && inst.OPCD == 16 && !inst.LK &&
+        block_size > 1)
+    {
+      // Static prediction: backward branches are taken, forward ones aren't, unless the
+      // y bit says otherwise. Don't follow branches back into the trace itself, that would
+      // just unroll loops.
+      const s32 offset = SignExt16(inst.BD << 2);
+      const u32 target = offset + (inst.AA ? 0 : address);
+      const bool predict_taken = (offset < 0) != ((inst.BO & BO_REVERSE_PREDICTION) != 0);
+      const bool in_trace = std::any_of(
+          code, code + i + 1, [target](const CodeOp& op) { return op.address == target; });
+      if (predict_taken && !in_trace)
+      {
+        numTraceFollows++;
+        code[i].traceTaken = true;
+        found_call = false;
+        address = target;
+        continue;
+      }
+    }
+
     if (follow)
     {
       // Follow the unconditional branch.
@@ -873,10 +1074,36 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
   // Forward scan, for flags that need the other direction for calculation.
   BitSet32 fprIsSingle, fprIsDuplicated, fprIsStoreSafe, gprDefined, gprBlockInputs;
   BitSet8 gqrUsed, gqrModified;
+  // GPR values which are known at compile time. The block is a single path (branches out of it
+  // are exits), so anything learned here holds until the register is written again, no matter
+  // how often the JIT flushes its register cache in between.
+  BitSet32 gprKnown;
+  std::array<u32, 32> gprValues{};
   for (u32 i = 0; i < block->m_num_instructions; i++)
   {
     CodeOp& op = code[i];
 
+    op.constGprOut = -1;
+    if (HLE::GetFirstFunctionIndex(op.address) != 0 || (op.opinfo->flags & FL_EVIL))
+    {
+      gprKnown = BitSet32(0);
+    }
+    else if (!op.skip && op.opinfo->type == OpType::Integer && op.regsOut.Count() == 1 &&
+             !(op.opinfo->flags & (FL_SET_CA | FL_READ_CA | FL_SET_CRx | FL_SET_OE)))
+    {
+      const int reg = *op.regsOut.begin();
+      u32 value;
+      if (EvaluateConstantResult(op, gprValues, gprKnown, &value))
+      {
+        op.constGprOut = static_cast<s8>(reg);
+        op.constValue = value;
+        gprValues[reg] = value;
+        gprKnown[reg] = true;
+      }
+    }
+    if (op.constGprOut < 0)
+      gprKnown &= ~op.regsOut;
+
     gprBlockInputs |= op.regsIn & ~gprDefined;
     gprDefined |= op.regsOut;
 
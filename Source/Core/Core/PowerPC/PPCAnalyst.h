@@ -46,6 +46,15 @@ struct CodeOp  // 16B
   bool canEndBlock;
   bool skipLRStack;
   bool skip;  // followed BL-s for example
+  // conditional branch whose taken path was appended to the block; not taking it is a side exit
+  bool traceTaken;
+  // branch back to the start of a loop that can't make progress until something else changes
+  // memory, so the JIT may skip ahead to the next event
+  bool branchIsIdleLoop;
+  // if >= 0, the only register this instruction changes, which always ends up holding
+  // constValue, no matter what path led to the instruction
+  s8 constGprOut;
+  u32 constValue;
   // which registers are still needed after this instruction in this block
   BitSet32 fprInUse;
   BitSet32 gprInUse;
@@ -194,12 +203,19 @@ public:
 
     // Reorder cror instructions next to their associated fcmp.
     OPTION_CROR_MERGE = (1 << 6),
+
+    // Follow conditional branches that are statically predicted taken, turning the
+    // fall-through path into a side exit. This lets several small blocks share one
+    // register allocation.
+    // Requires JIT support to be enabled.
+    OPTION_TRACE_FOLLOW = (1 << 7),
   };
 
   // Option setting/getting
   void SetOption(AnalystOption option) { m_options |= option; }
   void ClearOption(AnalystOption option) { m_options &= ~(option); }
   bool HasOption(AnalystOption option) const { return !!(m_options & option); }
+  u32 GetOptions() const { return m_options; }
   u32 Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std::size_t block_size);
 
 private:
@@ -213,6 +229,7 @@ private:
   void ReorderInstructionsCore(u32 instructions, CodeOp* code, bool reverse, ReorderType type);
   void ReorderInstructions(u32 instructions, CodeOp* code);
   void SetInstructionStats(CodeBlock* block, CodeOp* code, const GekkoOPInfo* opinfo, u32 index);
+  bool IsBusyWaitLoop(const CodeOp* code, u32 branch_index) const;
 
   // Options
   u32 m_options = 0;
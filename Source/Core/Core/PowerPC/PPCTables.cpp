@@ -220,4 +220,10 @@ void LogCompiledInstructions()
   ++time;
 }
 
+void ResetFallbackCounts()
+{
+  for (size_t i = 0; i < m_numInstructions; i++)
+    m_allInstructions[i]->fallbackCount = 0;
+}
+
 }  // namespace
@@ -94,6 +94,9 @@ struct GekkoOPInfo
   u64 runCount;
   int compileCount;
   u32 lastUse;
+  // Number of times the JIT ran this instruction through the interpreter while blocks were
+  // being profiled
+  u64 fallbackCount;
 };
 extern std::array<GekkoOPInfo*, 64> m_infoTable;
 extern std::array<GekkoOPInfo*, 1024> m_infoTable4;
@@ -116,5 +119,6 @@ bool UsesFPU(UGeckoInstruction inst);
 void CountInstruction(UGeckoInstruction inst);
 void PrintInstructionRunCounts();
 void LogCompiledInstructions();
+void ResetFallbackCounts();
 const char* GetInstructionName(UGeckoInstruction inst);
 }  // namespace PPCTables
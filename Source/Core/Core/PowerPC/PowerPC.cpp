@@ -23,6 +23,7 @@
 #include "Core/PowerPC/Interpreter/Interpreter.h"
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/SamplingProfiler.h"
 
 namespace PowerPC
 {
@@ -62,8 +63,24 @@ void ExpandCR(u32 cr)
   }
 }
 
+// The registers which determine how addresses are translated, and so which code is compiled
+static std::vector<u32> GetAddressTranslationState()
+{
+  std::vector<u32> state(std::begin(ppcState.sr), std::end(ppcState.sr));
+  state.insert(state.end(), &ppcState.spr[SPR_IBAT0U], &ppcState.spr[SPR_IBAT0U + 16]);
+  state.insert(state.end(), &ppcState.spr[SPR_IBAT4U], &ppcState.spr[SPR_IBAT4U + 16]);
+  state.push_back(ppcState.spr[SPR_SDR]);
+  state.push_back(ppcState.spr[SPR_HID4]);
+  return state;
+}
+
 void DoState(PointerWrap& p)
 {
+  // Compiled code is kept across savestate loads, unless they change address translation
+  std::vector<u32> old_translation_state;
+  if (p.GetMode() == PointerWrap::MODE_READ)
+    old_translation_state = GetAddressTranslationState();
+
   // some of this code has been disabled, because
   // it changes registers even in MODE_MEASURE (which is suspicious and seems like it could cause
   // desyncs)
@@ -94,16 +111,16 @@ void DoState(PointerWrap& p)
 
   ppcState.iCache.DoState(p);
 
-  if (p.GetMode() == PointerWrap::MODE_READ)
+  if (p.GetMode() == PointerWrap::MODE_READ &&
+      GetAddressTranslationState() != old_translation_state)
   {
     IBATUpdated();
     DBATUpdated();
+    JitInterface::ClearCache();
   }
 
   // SystemTimers::DecrementerSet();
   // SystemTimers::TimeBaseSet();
-
-  JitInterface::DoState(p);
 }
 
 static void ResetRegisters()
@@ -207,6 +224,7 @@ void Init(int cpu_core)
 
   s_invalidate_cache_thread_safe =
       CoreTiming::RegisterEvent("invalidateEmulatedCache", InvalidateCacheThreadSafe);
+  SamplingProfiler::Init();
 
   Reset();
 
@@ -242,6 +260,7 @@ void ScheduleInvalidateCacheThreadSafe(u32 address)
 
 void Shutdown()
 {
+  SamplingProfiler::Shutdown();
   InjectExternalCPUCore(nullptr);
   JitInterface::Shutdown();
   s_interpreter->Shutdown();
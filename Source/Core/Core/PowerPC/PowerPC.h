@@ -52,6 +52,21 @@ struct TLBEntry
   u8 recent = 0;
 };
 
+// Host-side copy of the data TLB entries that map RAM, looked up inline by the JIT so that hits
+// don't have to go through TranslateAddress. Indexed by the low bits of the effective page.
+constexpr size_t HOST_TLB_SIZE = 256;
+
+struct HostTLBEntry
+{
+  static constexpr u32 INVALID_TAG = 0xffffffff;
+
+  // Effective address of the page.
+  u32 tag = INVALID_TAG;
+  // Added to an effective address within the page to get the host address.
+  u64 host_offset = 0;
+};
+static_assert(sizeof(HostTLBEntry) == 16, "The JIT relies on the size of HostTLBEntry");
+
 // This contains the entire state of the emulated PowerPC "Gekko" CPU.
 struct PowerPCState
 {
@@ -122,6 +137,9 @@ struct PowerPCState
 
   std::array<std::array<TLBEntry, TLB_SIZE / TLB_WAYS>, NUM_TLBS> tlb;
 
+  // Entries for reads and writes respectively. Not savestated, as it's rebuilt on demand.
+  std::array<std::array<HostTLBEntry, HOST_TLB_SIZE>, 2> host_tlb;
+
   u32 pagetable_base;
   u32 pagetable_hashmask;
 
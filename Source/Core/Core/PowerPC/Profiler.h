@@ -16,8 +16,9 @@ extern bool g_ProfileBlocks;
 
 struct BlockStat
 {
-  BlockStat(u32 _addr, u64 c, u64 ticks, u64 run, u32 size)
-      : addr(_addr), cost(c), tick_counter(ticks), run_count(run), block_size(size)
+  BlockStat(u32 _addr, u64 c, u64 ticks, u64 run, u32 size, u64 compile_ticks_)
+      : addr(_addr), cost(c), tick_counter(ticks), run_count(run), block_size(size),
+        compile_ticks(compile_ticks_)
   {
   }
   u32 addr;
@@ -25,12 +26,22 @@ struct BlockStat
   u64 tick_counter;
   u64 run_count;
   u32 block_size;
+  u64 compile_ticks;
 
   bool operator<(const BlockStat& other) const { return cost > other.cost; }
 };
+struct FallbackStat
+{
+  FallbackStat(const char* name, u64 count) : opname(name), fallback_count(count) {}
+  const char* opname;
+  u64 fallback_count;
+
+  bool operator<(const FallbackStat& other) const { return fallback_count > other.fallback_count; }
+};
 struct ProfileStats
 {
   std::vector<BlockStat> block_stats;
+  std::vector<FallbackStat> fallback_stats;
   u64 cost_sum;
   u64 timecost_sum;
   u64 countsPerSec;
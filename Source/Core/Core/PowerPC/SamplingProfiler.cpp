@@ -0,0 +1,329 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/PowerPC/SamplingProfiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/Flag.h"
+#include "Common/Logging/Log.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/SystemTimers.h"
+#include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
+#include "Core/PowerPC/PowerPC.h"
+
+#if defined(__linux__) && !defined(_M_GENERIC)
+#define HAS_SAMPLING_PROFILER
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "Core/MachineContext.h"
+
+// Older glibc versions only provide the underlying member
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#endif
+
+namespace SamplingProfiler
+{
+// The CPU thread is sampled every millisecond of its own CPU time, or at the rate of the kernel's
+// scheduler tick if that is lower
+constexpr long SAMPLE_INTERVAL_NS = 1000000;
+// Samples are attributed to guest code this many times per emulated second. It has to happen
+// before the JIT blocks they hit are destroyed, but iterates over all the blocks.
+constexpr int RESOLVE_RATE = 10;
+// Samples beyond this, between two resolves, are dropped
+constexpr size_t MAX_PENDING_SAMPLES = 4096;
+
+struct Sample
+{
+  uintptr_t host_pc;
+  u32 guest_pc;
+};
+
+static CoreTiming::EventType* s_event;
+static Common::Flag s_enabled;
+
+// Only accessed on the CPU thread. The event of a resolve chain carries the generation of the
+// timer it was started for, so that stale chains stop after a restart.
+static bool s_timer_armed = false;
+static u64 s_generation = 0;
+
+// Protects the resolved samples, which are also read by WriteReport
+static std::mutex s_mutex;
+// Guest block address -> samples in the JIT code of the block
+static std::map<u32, u64> s_block_samples;
+// Guest PC -> samples outside of JIT blocks
+static std::map<u32, u64> s_host_samples;
+
+static void Resolve(std::vector<Sample> samples)
+{
+  if (samples.empty())
+    return;
+
+  std::sort(samples.begin(), samples.end(),
+            [](const Sample& a, const Sample& b) { return a.host_pc < b.host_pc; });
+
+  std::vector<bool> in_block(samples.size());
+  std::map<u32, u64> block_samples;
+  if (g_jit)
+  {
+    g_jit->GetBlockCache()->RunOnBlocks([&](const JitBlock& block) {
+      const uintptr_t start = reinterpret_cast<uintptr_t>(block.checkedEntry);
+      const uintptr_t end = start + block.codeSize;
+      auto it = std::lower_bound(samples.begin(), samples.end(), start,
+                                 [](const Sample& s, uintptr_t pc) { return s.host_pc < pc; });
+      for (; it != samples.end() && it->host_pc < end; ++it)
+      {
+        block_samples[block.effectiveAddress]++;
+        in_block[it - samples.begin()] = true;
+      }
+    });
+  }
+
+  std::lock_guard<std::mutex> lock(s_mutex);
+  for (const auto& entry : block_samples)
+    s_block_samples[entry.first] += entry.second;
+  for (size_t i = 0; i < samples.size(); i++)
+  {
+    if (!in_block[i])
+      s_host_samples[samples[i].guest_pc]++;
+  }
+}
+
+#ifdef HAS_SAMPLING_PROFILER
+static timer_t s_timer;
+static bool s_handler_installed = false;
+
+// Filled by the signal handler, which only interrupts the CPU thread
+static Sample s_pending[MAX_PENDING_SAMPLES];
+static std::atomic<size_t> s_pending_count{0};
+static_assert(std::atomic<size_t>::is_always_lock_free, "Used from a signal handler");
+
+static void SignalHandler(int, siginfo_t*, void* raw_context)
+{
+  const size_t count = s_pending_count.load(std::memory_order_relaxed);
+  if (count == MAX_PENDING_SAMPLES)
+    return;
+
+  SContext* ctx = &static_cast<ucontext_t*>(raw_context)->uc_mcontext;
+  s_pending[count] = {static_cast<uintptr_t>(ctx->CTX_PC), PowerPC::ppcState.pc};
+  s_pending_count.store(count + 1, std::memory_order_relaxed);
+}
+
+static bool ArmTimer()
+{
+  // The handler stays installed: a signal which is already pending when the timer is deleted
+  // must not reach the default action, which terminates the process
+  if (!s_handler_installed)
+  {
+    struct sigaction sa = {};
+    sa.sa_sigaction = &SignalHandler;
+    sa.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(SIGPROF, &sa, nullptr) != 0)
+    {
+      ERROR_LOG(POWERPC, "Sampling profiler: sigaction failed: %s", strerror(errno));
+      return false;
+    }
+    s_handler_installed = true;
+  }
+
+  clockid_t clock;
+  if (pthread_getcpuclockid(pthread_self(), &clock) != 0)
+    clock = CLOCK_MONOTONIC;
+
+  struct sigevent sev = {};
+  sev.sigev_notify = SIGEV_THREAD_ID;
+  sev.sigev_signo = SIGPROF;
+  sev.sigev_notify_thread_id = static_cast<pid_t>(syscall(SYS_gettid));
+  if (timer_create(clock, &sev, &s_timer) != 0)
+  {
+    ERROR_LOG(POWERPC, "Sampling profiler: timer_create failed: %s", strerror(errno));
+    return false;
+  }
+
+  s_pending_count.store(0, std::memory_order_relaxed);
+  struct itimerspec interval = {{0, SAMPLE_INTERVAL_NS}, {0, SAMPLE_INTERVAL_NS}};
+  timer_settime(s_timer, 0, &interval, nullptr);
+  return true;
+}
+
+static void DisarmTimer()
+{
+  timer_delete(s_timer);
+}
+
+static std::vector<Sample> TakePendingSamples()
+{
+  // The handler can't run while the samples are copied
+  sigset_t set, old_set;
+  sigemptyset(&set);
+  sigaddset(&set, SIGPROF);
+  pthread_sigmask(SIG_BLOCK, &set, &old_set);
+  std::vector<Sample> samples(s_pending,
+                              s_pending + s_pending_count.load(std::memory_order_relaxed));
+  s_pending_count.store(0, std::memory_order_relaxed);
+  pthread_sigmask(SIG_SETMASK, &old_set, nullptr);
+  return samples;
+}
+#else
+static bool ArmTimer()
+{
+  ERROR_LOG(POWERPC, "The sampling profiler isn't supported on this platform");
+  return false;
+}
+
+static void DisarmTimer()
+{
+}
+
+static std::vector<Sample> TakePendingSamples()
+{
+  return {};
+}
+#endif
+
+static void Disarm()
+{
+  DisarmTimer();
+  s_timer_armed = false;
+  Resolve(TakePendingSamples());
+}
+
+static void ScheduleResolve(s64 cycles_late)
+{
+  CoreTiming::ScheduleEvent(SystemTimers::GetTicksPerSecond() / RESOLVE_RATE - cycles_late,
+                            s_event, s_generation);
+}
+
+// Runs on the CPU thread. Start and Stop schedule it with a userdata of 0.
+static void SamplingCallback(u64 userdata, s64 cycles_late)
+{
+  if (!s_enabled.IsSet())
+  {
+    if (s_timer_armed)
+      Disarm();
+    return;
+  }
+
+  if (!s_timer_armed)
+  {
+    if (!ArmTimer())
+    {
+      s_enabled.Clear();
+      return;
+    }
+    s_timer_armed = true;
+    s_generation++;
+    ScheduleResolve(0);
+    return;
+  }
+
+  if (userdata != s_generation)
+    return;
+
+  Resolve(TakePendingSamples());
+  ScheduleResolve(cycles_late);
+}
+
+void Init()
+{
+  s_event = CoreTiming::RegisterEvent("SamplingProfiler", SamplingCallback);
+  if (s_enabled.IsSet())
+    CoreTiming::ScheduleEvent(0, s_event);
+}
+
+void Shutdown()
+{
+  if (s_timer_armed)
+    Disarm();
+  s_event = nullptr;
+}
+
+bool IsSupported()
+{
+#ifdef HAS_SAMPLING_PROFILER
+  return true;
+#else
+  return false;
+#endif
+}
+
+void Start()
+{
+  {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    s_block_samples.clear();
+    s_host_samples.clear();
+  }
+  s_enabled.Set();
+  if (Core::IsRunning())
+    CoreTiming::ScheduleEvent(0, s_event, 0, CoreTiming::FromThread::ANY);
+}
+
+void Stop()
+{
+  s_enabled.Clear();
+  if (Core::IsRunning())
+    CoreTiming::ScheduleEvent(0, s_event, 0, CoreTiming::FromThread::ANY);
+}
+
+bool IsRunning()
+{
+  return s_enabled.IsSet();
+}
+
+bool WriteReport(const std::string& filename)
+{
+  std::map<u32, u64> block_samples, host_samples;
+  {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    block_samples = s_block_samples;
+    host_samples = s_host_samples;
+  }
+
+  File::IOFile f(filename, "w");
+  if (!f)
+    return false;
+
+  const auto function_name = [](u32 address) -> std::string {
+    const Common::Symbol* symbol = g_symbolDB.GetSymbolFromAddr(address);
+    return symbol ? symbol->name : "unknown";
+  };
+
+  u64 total = 0;
+  for (const auto& entry : block_samples)
+  {
+    fprintf(f.GetHandle(), "%s;%08x %" PRIu64 "\n", function_name(entry.first).c_str(),
+            entry.first, entry.second);
+    total += entry.second;
+  }
+  for (const auto& entry : host_samples)
+  {
+    fprintf(f.GetHandle(), "%s;[host] %" PRIu64 "\n", function_name(entry.first).c_str(),
+            entry.second);
+    total += entry.second;
+  }
+
+  NOTICE_LOG(POWERPC, "Wrote %" PRIu64 " samples to %s", total, filename.c_str());
+  return true;
+}
+}  // namespace SamplingProfiler
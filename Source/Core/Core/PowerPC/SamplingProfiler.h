@@ -0,0 +1,34 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <string>
+
+// The sampling profiler periodically interrupts the CPU thread, and attributes the host time it
+// spends to the guest code that caused it. Samples inside JIT blocks are attributed to the block,
+// samples elsewhere (dispatcher, interpreter, MMIO, HLE...) to the current guest PC.
+//
+// Unlike block profiling, it doesn't change the generated code, so it barely affects the timings
+// it measures. The report uses the folded stack format of FlameGraph's flamegraph.pl, with one
+// "function;block count" line per guest block.
+namespace SamplingProfiler
+{
+// Called by PowerPC::Init and PowerPC::Shutdown
+void Init();
+void Shutdown();
+
+// Whether the profiler is implemented for this host
+bool IsSupported();
+
+// Can be called from any thread. Starting discards the previous samples. Profiling keeps running
+// across emulation restarts until it is stopped.
+void Start();
+void Stop();
+bool IsRunning();
+
+// Writes the samples collected so far. The guest functions are looked up in g_symbolDB, so
+// symbols can still be loaded after profiling.
+bool WriteReport(const std::string& filename);
+}  // namespace SamplingProfiler
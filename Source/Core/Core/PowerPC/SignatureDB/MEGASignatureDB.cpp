@@ -102,11 +102,8 @@ bool GetRefs(MEGASignature* sig, std::istringstream* iss)
   return true;
 }
 
-bool Compare(u32 address, u32 size, const MEGASignature& sig)
+bool Compare(u32 address, const MEGASignature& sig)
 {
-  if (size != sig.code.size() * sizeof(u32))
-    return false;
-
   for (size_t i = 0; i < sig.code.size(); ++i)
   {
     if (sig.code[i] != 0 &&
@@ -141,7 +138,8 @@ bool MEGASignatureDB::Load(const std::string& file_path)
 
     if (GetCode(&sig, &iss) && GetName(&sig, &iss) && GetRefs(&sig, &iss))
     {
-      m_signatures.push_back(std::move(sig));
+      const u32 size = static_cast<u32>(sig.code.size() * sizeof(u32));
+      m_signatures[size].push_back(std::move(sig));
     }
     else
     {
@@ -162,9 +160,13 @@ void MEGASignatureDB::Apply(PPCSymbolDB* symbol_db) const
   for (auto& it : symbol_db->AccessSymbols())
   {
     auto& symbol = it.second;
-    for (const auto& sig : m_signatures)
+    const auto signatures = m_signatures.find(symbol.size);
+    if (signatures == m_signatures.end())
+      continue;
+
+    for (const auto& sig : signatures->second)
     {
-      if (Compare(symbol.address, symbol.size, sig))
+      if (Compare(symbol.address, sig))
       {
         symbol.name = sig.name;
         INFO_LOG(SYMBOLS, "Found %s at %08x (size: %08x)!", sig.name.c_str(), symbol.address,
@@ -189,9 +191,12 @@ bool MEGASignatureDB::Add(u32 startAddr, u32 size, const std::string& name)
 
 void MEGASignatureDB::List() const
 {
+  size_t count = 0;
   for (const auto& entry : m_signatures)
   {
-    DEBUG_LOG(SYMBOLS, "%s : %zu bytes", entry.name.c_str(), entry.code.size() * sizeof(u32));
+    for (const auto& sig : entry.second)
+      DEBUG_LOG(SYMBOLS, "%s : %u bytes", sig.name.c_str(), entry.first);
+    count += entry.second.size();
   }
-  INFO_LOG(SYMBOLS, "%zu functions known in current MEGA database.", m_signatures.size());
+  INFO_LOG(SYMBOLS, "%zu functions known in current MEGA database.", count);
 }
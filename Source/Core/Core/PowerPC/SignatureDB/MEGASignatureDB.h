@@ -5,6 +5,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -53,5 +54,7 @@ public:
   bool Add(u32 startAddr, u32 size, const std::string& name) override;
 
 private:
-  std::vector<MEGASignature> m_signatures;
+  // Signatures grouped by code size in bytes, in file order. A function can only match the
+  // signatures of its own size, so Apply doesn't have to compare it against all of them.
+  std::unordered_map<u32, std::vector<MEGASignature>> m_signatures;
 };
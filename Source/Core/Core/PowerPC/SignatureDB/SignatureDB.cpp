@@ -6,6 +6,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -96,13 +97,7 @@ bool HashSignatureDB::Add(u32 startAddr, u32 size, const std::string& name)
   temp_dbfunc.size = size;
   temp_dbfunc.name = name;
 
-  FuncDB::iterator iter = m_database.find(hash);
-  if (iter == m_database.end())
-  {
-    m_database[hash] = temp_dbfunc;
-    return true;
-  }
-  return false;
+  return m_database.emplace(hash, std::move(temp_dbfunc)).second;
 }
 
 void HashSignatureDB::List() const
@@ -4,9 +4,9 @@
 
 #pragma once
 
-#include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 #include "Common/CommonTypes.h"
 
@@ -68,7 +68,7 @@ public:
     std::string object_name;
     std::string object_location;
   };
-  using FuncDB = std::map<u32, DBFunc>;
+  using FuncDB = std::unordered_map<u32, DBFunc>;
 
   static u32 ComputeCodeChecksum(u32 offsetStart, u32 offsetEnd);
 
@@ -0,0 +1,133 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/SharedMemoryExport.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <new>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "Common/Flag.h"
+#include "Common/Logging/Log.h"
+#include "Core/ConfigManager.h"
+#include "Core/HW/Memmap.h"
+
+namespace SharedMemoryExport
+{
+// The frame starts on its own page, after the header
+constexpr u32 FRAME_OFFSET = 4096;
+constexpr size_t SEGMENT_SIZE = FRAME_OFFSET + size_t(MAX_FRAME_WIDTH) * MAX_FRAME_HEIGHT * 4;
+static_assert(sizeof(Header) <= FRAME_OFFSET, "The header must fit before the frame");
+
+// Protects s_header against Shutdown while the video thread exports a frame
+static std::mutex s_mutex;
+static Header* s_header = nullptr;
+static std::string s_name;
+static Common::Flag s_active;
+
+void Init()
+{
+  if (!SConfig::GetInstance().bSharedMemoryExport)
+    return;
+
+  const std::string& memory_name = Memory::GetSharedMemoryName();
+  if (memory_name.empty() || memory_name.size() >= sizeof(Header::memory_name))
+  {
+    ERROR_LOG(MEMMAP, "The emulated memory couldn't be shared, not exporting it");
+    return;
+  }
+
+  s_name = "/dolphin-emu." + std::to_string(getpid()) + ".export";
+  const int fd = shm_open(s_name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (fd == -1)
+  {
+    ERROR_LOG(MEMMAP, "shm_open for %s failed: %s", s_name.c_str(), strerror(errno));
+    return;
+  }
+
+  // The frame pages are only allocated once they are written to
+  void* mapping = MAP_FAILED;
+  if (ftruncate(fd, SEGMENT_SIZE) == 0)
+    mapping = mmap(nullptr, SEGMENT_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED)
+  {
+    ERROR_LOG(MEMMAP, "Mapping %s failed: %s", s_name.c_str(), strerror(errno));
+    shm_unlink(s_name.c_str());
+    return;
+  }
+
+  Header* header = new (mapping) Header{};
+  header->magic = MAGIC;
+  header->version = VERSION;
+  std::strcpy(header->memory_name, memory_name.c_str());
+  header->mem1_offset = Memory::GetSharedMemoryOffset(Memory::m_pRAM);
+  header->mem1_size = Memory::REALRAM_SIZE;
+  if (Memory::m_pEXRAM)
+  {
+    header->mem2_offset = Memory::GetSharedMemoryOffset(Memory::m_pEXRAM);
+    header->mem2_size = Memory::EXRAM_SIZE;
+  }
+  header->frame_offset = FRAME_OFFSET;
+
+  {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    s_header = header;
+  }
+  s_active.Set();
+  NOTICE_LOG(MEMMAP, "Exporting the emulated memory as %s, described by %s", memory_name.c_str(),
+             s_name.c_str());
+}
+
+void Shutdown()
+{
+  s_active.Clear();
+
+  std::lock_guard<std::mutex> lock(s_mutex);
+  if (!s_header)
+    return;
+
+  munmap(s_header, SEGMENT_SIZE);
+  shm_unlink(s_name.c_str());
+  s_header = nullptr;
+}
+
+bool IsActive()
+{
+  return s_active.IsSet();
+}
+
+void ExportFrame(const u8* data, int width, int height, int stride)
+{
+  if (width <= 0 || height <= 0 || static_cast<u32>(width) > MAX_FRAME_WIDTH ||
+      static_cast<u32>(height) > MAX_FRAME_HEIGHT)
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(s_mutex);
+  if (!s_header)
+    return;
+
+  const u32 sequence = s_header->frame_sequence.load(std::memory_order_relaxed);
+  s_header->frame_sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  const u32 row_size = static_cast<u32>(width) * 4;
+  u8* frame = reinterpret_cast<u8*>(s_header) + FRAME_OFFSET;
+  for (int y = 0; y < height; y++)
+    std::memcpy(frame + y * row_size, data + y * stride, row_size);
+  s_header->frame_width = width;
+  s_header->frame_height = height;
+  s_header->frame_stride = row_size;
+  s_header->frame_number++;
+
+  s_header->frame_sequence.store(sequence + 2, std::memory_order_release);
+}
+}  // namespace SharedMemoryExport
@@ -0,0 +1,62 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+
+#include "Common/CommonTypes.h"
+
+// SharedMemoryExport lets other processes, such as bots or analysis tools, read the emulated
+// memory and the latest rendered frame at full speed, without copies or sockets. It is enabled
+// by Core.SharedMemoryExport.
+//
+// The emulated memory is then backed by a named POSIX shared memory segment, which consumers can
+// map read-only. A second segment, named "/dolphin-emu.<pid>.export", starts with a Header which
+// describes where MEM1 and MEM2 are, and is followed by the latest frame.
+namespace SharedMemoryExport
+{
+constexpr u32 MAGIC = 0x454D5344;  // DSME
+constexpr u32 VERSION = 1;
+
+// Larger frames aren't exported
+constexpr u32 MAX_FRAME_WIDTH = 4096;
+constexpr u32 MAX_FRAME_HEIGHT = 4096;
+
+struct Header
+{
+  u32 magic;
+  u32 version;
+
+  // Name of the segment containing the emulated memory, for shm_open
+  char memory_name[64];
+  // MEM1 and MEM2 as offsets from the start of that segment. mem2_size is 0 on the GameCube.
+  u32 mem1_offset;
+  u32 mem1_size;
+  u32 mem2_offset;
+  u32 mem2_size;
+
+  // Sequence lock for the frame fields and data: odd while a frame is being written. Readers copy
+  // what they need, then retry if the sequence was odd or has changed in the meantime.
+  std::atomic<u32> frame_sequence;
+  // The frame is RGBA8, with rows of frame_stride bytes, starting frame_offset bytes after the
+  // start of this header.
+  u32 frame_width;
+  u32 frame_height;
+  u32 frame_stride;
+  u32 frame_offset;
+  // Counts the exported frames; 0 until the first one
+  u64 frame_number;
+};
+static_assert(std::atomic<u32>::is_always_lock_free, "The sequence must be usable across processes");
+
+// Called after the emulated memory has been initialized, and before it is shut down
+void Init();
+void Shutdown();
+
+// Whether frames should be passed to ExportFrame. Can be called from any thread.
+bool IsActive();
+// Called by the video backend for each rendered frame, with RGBA8 rows of stride bytes
+void ExportFrame(const u8* data, int width, int height, int stride);
+}  // namespace SharedMemoryExport
@@ -4,6 +4,11 @@
 
 #include "Core/State.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstring>
+#include <deque>
 #include <lzo/lzo1x.h>
 #include <map>
 #include <mutex>
@@ -13,10 +18,12 @@
 #include <vector>
 
 #include "Common/ChunkFile.h"
+#include "Common/Config/Config.h"
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/File.h"
 #include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
@@ -24,6 +31,7 @@
 #include "Common/Timer.h"
 #include "Common/Version.h"
 
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -33,6 +41,7 @@
 #include "Core/Host.h"
 #include "Core/Movie.h"
 #include "Core/NetPlayClient.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
 
 #include "VideoCommon/AVIDump.h"
@@ -51,12 +60,8 @@ static const u32 IN_LEN = 128 * 1024u;
 
 static const u32 OUT_LEN = IN_LEN + (IN_LEN / 16) + 64 + 3;
 
-static unsigned char __LZO_MMODEL out[OUT_LEN];
-
-#define HEAP_ALLOC(var, size)                                                                      \
-  lzo_align_t __LZO_MMODEL var[((size) + (sizeof(lzo_align_t) - 1)) / sizeof(lzo_align_t)]
-
-static HEAP_ALLOC(wrkmem, LZO1X_1_MEM_COMPRESS);
+static const size_t WORK_MEMORY_SIZE =
+    (LZO1X_1_MEM_COMPRESS + sizeof(lzo_align_t) - 1) / sizeof(lzo_align_t);
 
 static std::string g_last_filename;
 
@@ -73,8 +78,21 @@ static Common::Event g_compressAndDumpStateSyncEvent;
 
 static std::thread g_save_thread;
 
+// Rewind states are compared and delta-encoded in pages of this size, in segments of this many
+// pages which are processed independently
+static const size_t REWIND_PAGE_SIZE = 0x1000;
+static const size_t REWIND_PAGES_PER_SEGMENT = 0x800;
+
+static std::mutex s_rewind_mutex;
+// The most recent rewind state, uncompressed
+static std::vector<u8> s_rewind_newest;
+// The older rewind states, oldest first, each encoded against the state after it
+static std::deque<std::vector<u8>> s_rewind_deltas;
+static int s_rewind_field_counter = 0;
+static std::atomic<bool> s_rewind_save_queued{false};
+
 // Don't forget to increase this after doing changes on the savestate system
-static const u32 STATE_VERSION = 98;  // Last changed in PR 6895
+static const u32 STATE_VERSION = 100;  // Last changed when IPC replies became asynchronous
 
 // Maps savestate versions to Dolphin versions.
 // Versions after 42 don't need to be added to this list,
@@ -171,6 +189,8 @@ static std::string DoState(PointerWrap& p)
     return version_created_by;
   }
 
+  const bool loading = p.GetMode() == PointerWrap::MODE_READ;
+
   // Begin with video backend, so that it gets a chance to clear its caches and writeback modified
   // things to RAM
   g_video_backend->DoState(p);
@@ -193,6 +213,10 @@ static std::string DoState(PointerWrap& p)
   Gecko::DoState(p);
   p.DoMarker("Gecko");
 
+  // Now that memory has been loaded, compiled code which doesn't match it anymore can be found
+  if (loading)
+    JitInterface::OnStateLoaded();
+
 #if defined(HAVE_FFMPEG)
   AVIDump::DoState();
 #endif
@@ -218,17 +242,414 @@ void LoadFromBuffer(std::vector<u8>& buffer)
 void SaveToBuffer(std::vector<u8>& buffer)
 {
   Core::RunAsCPUThread([&] {
-    u8* ptr = nullptr;
-    PointerWrap p(&ptr, PointerWrap::MODE_MEASURE);
-
+    PointerWrap p(&buffer);
     DoState(p);
-    const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-    buffer.resize(buffer_size);
+    if (p.GetMode() == PointerWrap::MODE_WRITE)
+      p.FinishWrite();
+  });
+}
+
+// Calls function(thread_index, i) for every i below count, spread over num_threads threads.
+template <typename Function>
+static void ForEachInParallel(size_t count, u32 num_threads, const Function& function)
+{
+  std::vector<std::thread> threads;
+  for (u32 t = 1; t < num_threads && t < count; t++)
+  {
+    threads.emplace_back([&, t] {
+      for (size_t i = t; i < count; i += num_threads)
+        function(t, i);
+    });
+  }
+
+  for (size_t i = 0; i < count; i += num_threads)
+    function(0, i);
+
+  for (std::thread& thread : threads)
+    thread.join();
+}
+
+// Compresses a state in IN_LEN sized blocks, each stored as its compressed size followed by its
+// data. The blocks are compressed independently, so they can be compressed on all cores. The last
+// block is always shorter than IN_LEN (possibly empty), which is how older versions find the end
+// of the data.
+static std::vector<u8> CompressState(const u8* data, size_t size)
+{
+  const size_t num_blocks = size / IN_LEN + 1;
+  const u32 num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  std::vector<std::vector<u8>> compressed_blocks(num_blocks);
+  std::vector<std::vector<lzo_align_t>> work_memory(num_threads,
+                                                    std::vector<lzo_align_t>(WORK_MEMORY_SIZE));
+
+  ForEachInParallel(num_blocks, num_threads, [&](u32 thread_index, size_t i) {
+    const size_t offset = i * IN_LEN;
+    const lzo_uint cur_len = static_cast<lzo_uint>(std::min<size_t>(IN_LEN, size - offset));
+    std::vector<u8>& out = compressed_blocks[i];
+    out.resize(OUT_LEN);
+
+    lzo_uint out_len = 0;
+    if (lzo1x_1_compress(data + offset, cur_len, out.data(), &out_len,
+                         work_memory[thread_index].data()) != LZO_E_OK)
+    {
+      PanicAlertT("Internal LZO Error - compression failed");
+    }
+    out.resize(out_len);
+  });
+
+  std::vector<u8> compressed;
+  for (const std::vector<u8>& out : compressed_blocks)
+  {
+    // The size of the data to write is 'out_len'
+    const lzo_uint32 out_len = static_cast<lzo_uint32>(out.size());
+    const size_t position = compressed.size();
+    compressed.resize(position + sizeof(out_len) + out_len);
+    std::memcpy(&compressed[position], &out_len, sizeof(out_len));
+    std::copy(out.begin(), out.end(), compressed.begin() + position + sizeof(out_len));
+  }
+  return compressed;
+}
+
+// Decompresses data written by CompressState into buffer, which must already have the size of the
+// decompressed state. Every block but the last decompresses to exactly IN_LEN bytes, so all of
+// them can be located up front and decompressed on all cores.
+static bool DecompressState(const u8* compressed, size_t compressed_size, std::vector<u8>& buffer)
+{
+  std::vector<std::pair<size_t, lzo_uint32>> blocks;  // offset and size in compressed
+  size_t position = 0;
+  while (position + sizeof(lzo_uint32) <= compressed_size)
+  {
+    lzo_uint32 cur_len;  // number of bytes to read
+    std::memcpy(&cur_len, &compressed[position], sizeof(cur_len));
+    position += sizeof(cur_len);
+    cur_len = static_cast<lzo_uint32>(std::min<size_t>(cur_len, compressed_size - position));
+    blocks.emplace_back(position, cur_len);
+    position += cur_len;
+  }
+
+  std::atomic<bool> failed{false};
+  std::mutex error_mutex;
+  int error_result = LZO_E_OK;
+  lzo_uint error_offset = 0;
+  lzo_uint error_length = 0;
+
+  const u32 num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  ForEachInParallel(blocks.size(), num_threads, [&](u32, size_t i) {
+    const lzo_uint offset = static_cast<lzo_uint>(i * IN_LEN);
+    if (failed || offset > buffer.size())
+    {
+      failed = true;
+      return;
+    }
+
+    // number of bytes to write
+    lzo_uint new_len = std::min<lzo_uint>(IN_LEN, buffer.size() - offset);
+    const int res = lzo1x_decompress_safe(compressed + blocks[i].first, blocks[i].second,
+                                          buffer.data() + offset, &new_len, nullptr);
+    if (res != LZO_E_OK || (i != blocks.size() - 1 && new_len != IN_LEN))
+    {
+      std::lock_guard<std::mutex> lk(error_mutex);
+      failed = true;
+      error_result = res;
+      error_offset = offset;
+      error_length = new_len;
+    }
+  });
+
+  if (failed)
+  {
+    // This doesn't seem to happen anymore.
+    PanicAlertT("Internal LZO Error - decompression failed (%d) (%li, %li) \n"
+                "Try loading the state again",
+                error_result, error_offset, error_length);
+    return false;
+  }
+
+  return true;
+}
+
+void SaveToCompressedBuffer(std::vector<u8>& buffer)
+{
+  std::vector<u8> state;
+  SaveToBuffer(state);
+
+  // Compressing outside of SaveToBuffer keeps the emulation paused only for the serialization.
+  const std::vector<u8> compressed = CompressState(state.data(), state.size());
+  const u64 size = state.size();
+  buffer.resize(sizeof(size) + compressed.size());
+  std::memcpy(buffer.data(), &size, sizeof(size));
+  std::copy(compressed.begin(), compressed.end(), buffer.begin() + sizeof(size));
+}
+
+bool LoadFromCompressedBuffer(const std::vector<u8>& buffer)
+{
+  u64 size;
+  if (buffer.size() < sizeof(size))
+    return false;
+  std::memcpy(&size, buffer.data(), sizeof(size));
 
-    ptr = &buffer[0];
-    p.SetMode(PointerWrap::MODE_WRITE);
+  std::vector<u8> state(static_cast<size_t>(size));
+  if (!DecompressState(buffer.data() + sizeof(size), buffer.size() - sizeof(size), state))
+    return false;
+
+  bool loaded_successfully = false;
+  Core::RunAsCPUThread([&] {
+    u8* ptr = state.data();
+    PointerWrap p(&ptr, PointerWrap::MODE_READ);
     DoState(p);
+    loaded_successfully = p.GetMode() == PointerWrap::MODE_READ;
+  });
+  return loaded_successfully;
+}
+
+// Encodes the given pages of state as their difference to reference. Pages which are identical in
+// both are skipped, and the others are XORed with the reference, which leaves runs of zeros
+// wherever only parts of a page changed. The result is then LZO compressed.
+static std::vector<u8> EncodeRewindSegment(const std::vector<u8>& state,
+                                           const std::vector<u8>& reference, size_t first_page,
+                                           size_t num_pages)
+{
+  // Layout: one byte per page which is set if the page changed, then the changed pages
+  std::vector<u8> delta(num_pages);
+  for (size_t i = 0; i < num_pages; i++)
+  {
+    const size_t offset = (first_page + i) * REWIND_PAGE_SIZE;
+    const size_t length = std::min(REWIND_PAGE_SIZE, state.size() - offset);
+    const size_t reference_length =
+        offset < reference.size() ? std::min(length, reference.size() - offset) : 0;
+    if (reference_length == length && !std::memcmp(&state[offset], &reference[offset], length))
+      continue;
+
+    delta[i] = 1;
+    const size_t position = delta.size();
+    delta.resize(position + length);
+    for (size_t j = 0; j < reference_length; j++)
+      delta[position + j] = state[offset + j] ^ reference[offset + j];
+    std::copy(state.begin() + offset + reference_length, state.begin() + offset + length,
+              delta.begin() + position + reference_length);
+  }
+
+  const lzo_uint32 delta_size = static_cast<lzo_uint32>(delta.size());
+  std::vector<u8> compressed(sizeof(delta_size) + delta.size() + delta.size() / 16 + 64 + 3);
+  std::memcpy(compressed.data(), &delta_size, sizeof(delta_size));
+  std::vector<lzo_align_t> work_memory(WORK_MEMORY_SIZE);
+  lzo_uint compressed_size = 0;
+  if (lzo1x_1_compress(delta.data(), delta.size(), compressed.data() + sizeof(delta_size),
+                       &compressed_size, work_memory.data()) != LZO_E_OK)
+  {
+    return {};
+  }
+
+  compressed.resize(sizeof(delta_size) + compressed_size);
+  return compressed;
+}
+
+// Reverses EncodeRewindSegment, writing the pages into state. Returns false on failure.
+static bool DecodeRewindSegment(const u8* compressed, size_t compressed_size,
+                                const std::vector<u8>& reference, size_t first_page,
+                                size_t num_pages, std::vector<u8>* state)
+{
+  lzo_uint32 delta_size;
+  if (compressed_size < sizeof(delta_size))
+    return false;
+  std::memcpy(&delta_size, compressed, sizeof(delta_size));
+
+  std::vector<u8> delta(delta_size);
+  lzo_uint decompressed_size = delta.size();
+  if (lzo1x_decompress_safe(compressed + sizeof(delta_size), compressed_size - sizeof(delta_size),
+                            delta.data(), &decompressed_size, nullptr) != LZO_E_OK ||
+      decompressed_size != delta.size() || delta.size() < num_pages)
+  {
+    return false;
+  }
+
+  size_t position = num_pages;
+  for (size_t i = 0; i < num_pages; i++)
+  {
+    const size_t offset = (first_page + i) * REWIND_PAGE_SIZE;
+    const size_t length = std::min(REWIND_PAGE_SIZE, state->size() - offset);
+    const size_t reference_length =
+        offset < reference.size() ? std::min(length, reference.size() - offset) : 0;
+    u8* const out = state->data() + offset;
+
+    if (!delta[i])
+    {
+      if (reference_length != length)
+        return false;
+      std::copy_n(reference.begin() + offset, length, out);
+      continue;
+    }
+
+    if (position + length > delta.size())
+      return false;
+    for (size_t j = 0; j < reference_length; j++)
+      out[j] = delta[position + j] ^ reference[offset + j];
+    std::copy_n(delta.begin() + position + reference_length, length - reference_length,
+                out + reference_length);
+    position += length;
+  }
+
+  return true;
+}
+
+// Encodes state as its difference to reference. The state is split into segments which are
+// compared, delta-encoded and compressed independently on all cores.
+static std::vector<u8> EncodeRewindDelta(const std::vector<u8>& state,
+                                         const std::vector<u8>& reference)
+{
+  const size_t num_pages = (state.size() + REWIND_PAGE_SIZE - 1) / REWIND_PAGE_SIZE;
+  const size_t num_segments =
+      (num_pages + REWIND_PAGES_PER_SEGMENT - 1) / REWIND_PAGES_PER_SEGMENT;
+  std::vector<std::vector<u8>> segments(num_segments);
+  std::atomic<bool> failed{false};
+
+  const u32 num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  ForEachInParallel(num_segments, num_threads, [&](u32, size_t i) {
+    const size_t first_page = i * REWIND_PAGES_PER_SEGMENT;
+    segments[i] = EncodeRewindSegment(state, reference, first_page,
+                                      std::min(REWIND_PAGES_PER_SEGMENT, num_pages - first_page));
+    if (segments[i].empty())
+      failed = true;
+  });
+  if (failed)
+    return {};
+
+  // Layout: state size, then the size and data of each segment
+  const u64 state_size = state.size();
+  std::vector<u8> delta(sizeof(state_size));
+  std::memcpy(delta.data(), &state_size, sizeof(state_size));
+  for (const std::vector<u8>& segment : segments)
+  {
+    const u32 segment_size = static_cast<u32>(segment.size());
+    const size_t position = delta.size();
+    delta.resize(position + sizeof(segment_size) + segment.size());
+    std::memcpy(&delta[position], &segment_size, sizeof(segment_size));
+    std::copy(segment.begin(), segment.end(), delta.begin() + position + sizeof(segment_size));
+  }
+
+  return delta;
+}
+
+// Reverses EncodeRewindDelta. Returns an empty vector on failure.
+static std::vector<u8> DecodeRewindDelta(const std::vector<u8>& delta,
+                                         const std::vector<u8>& reference)
+{
+  u64 state_size;
+  if (delta.size() < sizeof(state_size))
+    return {};
+  std::memcpy(&state_size, delta.data(), sizeof(state_size));
+
+  const size_t num_pages = (state_size + REWIND_PAGE_SIZE - 1) / REWIND_PAGE_SIZE;
+  const size_t num_segments =
+      (num_pages + REWIND_PAGES_PER_SEGMENT - 1) / REWIND_PAGES_PER_SEGMENT;
+  std::vector<std::pair<size_t, u32>> segments;  // offset and size in delta
+  size_t position = sizeof(state_size);
+  for (size_t i = 0; i < num_segments; i++)
+  {
+    u32 segment_size;
+    if (position + sizeof(segment_size) > delta.size())
+      return {};
+    std::memcpy(&segment_size, &delta[position], sizeof(segment_size));
+    position += sizeof(segment_size);
+    if (segment_size > delta.size() - position)
+      return {};
+    segments.emplace_back(position, segment_size);
+    position += segment_size;
+  }
+
+  std::vector<u8> state(state_size);
+  std::atomic<bool> failed{false};
+  const u32 num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  ForEachInParallel(num_segments, num_threads, [&](u32, size_t i) {
+    const size_t first_page = i * REWIND_PAGES_PER_SEGMENT;
+    if (!DecodeRewindSegment(delta.data() + segments[i].first, segments[i].second, reference,
+                             first_page, std::min(REWIND_PAGES_PER_SEGMENT, num_pages - first_page),
+                             &state))
+    {
+      failed = true;
+    }
   });
+
+  if (failed)
+    return {};
+  return state;
+}
+
+static void SaveRewindState()
+{
+  if (!Core::IsRunningAndStarted())
+    return;
+
+  const u64 start_time = Common::Timer::GetTimeUs();
+  std::vector<u8> state;
+  SaveToBuffer(state);
+  const u64 save_time = Common::Timer::GetTimeUs();
+
+  std::lock_guard<std::mutex> lk(s_rewind_mutex);
+  if (!s_rewind_newest.empty())
+  {
+    std::vector<u8> delta = EncodeRewindDelta(s_rewind_newest, state);
+    if (delta.empty())
+      s_rewind_deltas.clear();
+    else
+      s_rewind_deltas.push_back(std::move(delta));
+  }
+  s_rewind_newest = std::move(state);
+
+  // Only the serialization pauses the emulation. How long it takes is what limits features built
+  // on in-memory states, such as rollback for NetPlay, so it is logged.
+  DEBUG_LOG(CORE, "Rewind state saved in %" PRIu64 " us, encoded in %" PRIu64 " us",
+            save_time - start_time, Common::Timer::GetTimeUs() - save_time);
+
+  const size_t max_states =
+      static_cast<size_t>(std::max(Config::Get(Config::MAIN_REWIND_STATE_COUNT), 1));
+  while (s_rewind_deltas.size() + 1 > max_states)
+    s_rewind_deltas.pop_front();
+}
+
+void UpdateRewind()
+{
+  if (!Config::Get(Config::MAIN_REWIND_ENABLE) || NetPlay::IsNetPlayRunning())
+    return;
+
+  if (++s_rewind_field_counter < Config::Get(Config::MAIN_REWIND_INTERVAL))
+    return;
+  s_rewind_field_counter = 0;
+
+  // The state is taken from the host thread, where the CPU thread can be paused between blocks,
+  // rather than from the middle of a VI event.
+  if (!s_rewind_save_queued.exchange(true))
+  {
+    Core::QueueHostJob([] {
+      SaveRewindState();
+      s_rewind_save_queued = false;
+    });
+  }
+}
+
+void Rewind()
+{
+  std::lock_guard<std::mutex> lk(s_rewind_mutex);
+  if (s_rewind_newest.empty())
+  {
+    Core::DisplayMessage("No rewind state available", 2000);
+    return;
+  }
+
+  const u64 start_time = Common::Timer::GetTimeUs();
+  LoadFromBuffer(s_rewind_newest);
+  DEBUG_LOG(CORE, "Rewind state loaded in %" PRIu64 " us",
+            Common::Timer::GetTimeUs() - start_time);
+
+  if (s_rewind_deltas.empty())
+  {
+    s_rewind_newest.clear();
+    return;
+  }
+
+  s_rewind_newest = DecodeRewindDelta(s_rewind_deltas.back(), s_rewind_newest);
+  s_rewind_deltas.pop_back();
+  if (s_rewind_newest.empty())
+    s_rewind_deltas.clear();
 }
 
 // return state number not in map
@@ -346,33 +767,8 @@ static void CompressAndDumpState(CompressAndDumpState_args save_args)
 
   if (header.size != 0)  // non-zero header size means the state is compressed
   {
-    lzo_uint i = 0;
-    while (true)
-    {
-      lzo_uint32 cur_len = 0;
-      lzo_uint out_len = 0;
-
-      if ((i + IN_LEN) >= buffer_size)
-      {
-        cur_len = (lzo_uint32)(buffer_size - i);
-      }
-      else
-      {
-        cur_len = IN_LEN;
-      }
-
-      if (lzo1x_1_compress(buffer_data + i, cur_len, out, &out_len, wrkmem) != LZO_E_OK)
-        PanicAlertT("Internal LZO Error - compression failed");
-
-      // The size of the data to write is 'out_len'
-      f.WriteArray((lzo_uint32*)&out_len, 1);
-      f.WriteBytes(out, out_len);
-
-      if (cur_len != IN_LEN)
-        break;
-
-      i += cur_len;
-    }
+    const std::vector<u8> compressed = CompressState(buffer_data, buffer_size);
+    f.WriteBytes(compressed.data(), compressed.size());
   }
   else  // uncompressed
   {
@@ -386,20 +782,13 @@ static void CompressAndDumpState(CompressAndDumpState_args save_args)
 void SaveAs(const std::string& filename, bool wait)
 {
   Core::RunAsCPUThread([&] {
-    // Measure the size of the buffer.
-    u8* ptr = nullptr;
-    PointerWrap p(&ptr, PointerWrap::MODE_MEASURE);
+    // The state is written in a single pass, directly into the buffer kept from the last save.
+    std::unique_lock<std::mutex> lk(g_cs_current_buffer);
+    PointerWrap p(&g_current_buffer);
     DoState(p);
-    const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-
-    // Then actually do the write.
-    {
-      std::lock_guard<std::mutex> lk(g_cs_current_buffer);
-      g_current_buffer.resize(buffer_size);
-      ptr = &g_current_buffer[0];
-      p.SetMode(PointerWrap::MODE_WRITE);
-      DoState(p);
-    }
+    if (p.GetMode() == PointerWrap::MODE_WRITE)
+      p.FinishWrite();
+    lk.unlock();
 
     if (p.GetMode() == PointerWrap::MODE_WRITE)
     {
@@ -480,28 +869,15 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
 
     buffer.resize(header.size);
 
-    lzo_uint i = 0;
-    while (true)
+    std::vector<u8> compressed(static_cast<size_t>(f.GetSize() - sizeof(StateHeader)));
+    if (!f.ReadBytes(compressed.data(), compressed.size()))
     {
-      lzo_uint32 cur_len = 0;  // number of bytes to read
-      lzo_uint new_len = 0;    // number of bytes to write
-
-      if (!f.ReadArray(&cur_len, 1))
-        break;
-
-      f.ReadBytes(out, cur_len);
-      const int res = lzo1x_decompress(out, cur_len, &buffer[i], &new_len, nullptr);
-      if (res != LZO_E_OK)
-      {
-        // This doesn't seem to happen anymore.
-        PanicAlertT("Internal LZO Error - decompression failed (%d) (%li, %li) \n"
-                    "Try loading the state again",
-                    res, i, new_len);
-        return;
-      }
-
-      i += new_len;
+      PanicAlert("wtf? reading bytes: %zu", compressed.size());
+      return;
     }
+
+    if (!DecompressState(compressed.data(), compressed.size(), buffer))
+      return;
   }
   else  // uncompressed
   {
@@ -622,6 +998,12 @@ void Shutdown()
     std::lock_guard<std::mutex> lk(g_cs_undo_load_buffer);
     std::vector<u8>().swap(g_undo_load_buffer);
   }
+
+  {
+    std::lock_guard<std::mutex> lk(s_rewind_mutex);
+    std::vector<u8>().swap(s_rewind_newest);
+    s_rewind_deltas.clear();
+  }
 }
 
 static std::string MakeStateFilename(int number)
@@ -50,6 +50,20 @@ void LoadAs(const std::string& filename);
 void SaveToBuffer(std::vector<u8>& buffer);
 void LoadFromBuffer(std::vector<u8>& buffer);
 
+// Same as above, but the state is compressed in the format of savestate files, preceded by its
+// decompressed size. NetPlay sends these to bring all players back to the host's state, so unlike
+// LoadFromBuffer, loading is allowed while NetPlay is running.
+void SaveToCompressedBuffer(std::vector<u8>& buffer);
+bool LoadFromCompressedBuffer(const std::vector<u8>& buffer);
+
+// Rewind keeps the most recent states in memory, one taken every MAIN_REWIND_INTERVAL fields while
+// MAIN_REWIND_ENABLE is set. Each state but the newest is stored as the compressed difference to
+// the state taken after it, so mostly only the memory pages which changed in between take up space.
+// Called once per field on the CPU thread
+void UpdateRewind();
+// Loads the most recent rewind state and discards it, so that calling it again goes further back
+void Rewind();
+
 void LoadLastSaved(int i = 1);
 void SaveFirstSaved();
 void UndoSaveState();
@@ -9,6 +9,7 @@
 #include <cinttypes>
 #include <cstddef>
 #include <cstring>
+#include <future>
 #include <map>
 #include <memory>
 #include <optional>
@@ -86,9 +87,20 @@ static bool ImportWAD(IOS::HLE::Kernel& ios, const DiscIO::WiiWAD& wad)
 
   const bool contents_imported = [&]() {
     const u64 title_id = tmd.GetTitleId();
-    for (const IOS::ES::Content& content : tmd.GetContents())
+    const std::vector<IOS::ES::Content> contents = tmd.GetContents();
+    // Each content is read while the previous one is being decrypted, hashed and written.
+    const auto read_content = [&wad](u16 index) {
+      return std::async(std::launch::async, [&wad, index] { return wad.GetContent(index); });
+    };
+    std::future<std::vector<u8>> next_data;
+    if (!contents.empty())
+      next_data = read_content(contents[0].index);
+    for (size_t i = 0; i < contents.size(); ++i)
     {
-      const std::vector<u8> data = wad.GetContent(content.index);
+      const IOS::ES::Content& content = contents[i];
+      const std::vector<u8> data = next_data.get();
+      if (i + 1 < contents.size())
+        next_data = read_content(contents[i + 1].index);
 
       if (es->ImportContentBegin(context, title_id, content.id) < 0 ||
           es->ImportContentData(context, 0, data.data(), static_cast<u32>(data.size())) < 0 ||
@@ -469,17 +481,36 @@ UpdateResult OnlineSystemUpdater::InstallTitleFromNUS(const std::string& prefix_
 
   // Now download and install contents listed in the TMD.
   const std::vector<IOS::ES::Content> stored_contents = es->GetStoredContentsFromTMD(tmd.first);
+  std::vector<IOS::ES::Content> contents;
+  for (const IOS::ES::Content& content : tmd.first.GetContents())
+  {
+    const bool is_already_installed = std::find_if(stored_contents.begin(), stored_contents.end(),
+                                                   [&content](const auto& stored_content) {
+                                                     return stored_content.id == content.id;
+                                                   }) != stored_contents.end();
+
+    // Do skip what is already installed on the NAND.
+    if (!is_already_installed)
+      contents.push_back(content);
+  }
+
   const UpdateResult import_result = [&]() {
-    for (const IOS::ES::Content& content : tmd.first.GetContents())
+    // Each content is downloaded while the previous one is being decrypted, hashed and written.
+    // Only one download is in progress at a time, since they share the HTTP request.
+    const auto download_content = [&](u32 content_id) {
+      return std::async(std::launch::async, [this, &prefix_url, &title, content_id] {
+        return DownloadContent(prefix_url, title, content_id);
+      });
+    };
+    std::future<std::optional<std::vector<u8>>> next_data;
+    if (!contents.empty())
+      next_data = download_content(contents[0].id);
+    for (size_t i = 0; i < contents.size(); ++i)
     {
-      const bool is_already_installed = std::find_if(stored_contents.begin(), stored_contents.end(),
-                                                     [&content](const auto& stored_content) {
-                                                       return stored_content.id == content.id;
-                                                     }) != stored_contents.end();
-
-      // Do skip what is already installed on the NAND.
-      if (is_already_installed)
-        continue;
+      const IOS::ES::Content& content = contents[i];
+      const std::optional<std::vector<u8>> data = next_data.get();
+      if (data && i + 1 < contents.size())
+        next_data = download_content(contents[i + 1].id);
 
       if ((ret = es->ImportContentBegin(context, title.id, content.id)) < 0)
       {
@@ -487,7 +518,6 @@ UpdateResult OnlineSystemUpdater::InstallTitleFromNUS(const std::string& prefix_
         return UpdateResult::ImportFailed;
       }
 
-      const std::optional<std::vector<u8>> data = DownloadContent(prefix_url, title, content.id);
       if (!data)
       {
         ERROR_LOG(CORE, "Failed to download content %08x", content.id);
@@ -34,7 +34,8 @@ enum class BlobType
   GCZ,
   CISO,
   WBFS,
-  TGC
+  TGC,
+  WCZ
 };
 
 class BlobReader
@@ -164,5 +165,7 @@ bool CompressFileToBlob(const std::string& infile_path, const std::string& outfi
                         void* arg = nullptr);
 bool DecompressBlobToFile(const std::string& infile_path, const std::string& outfile_path,
                           CompressCB callback = nullptr, void* arg = nullptr);
+bool ConvertToWCZ(const std::string& infile_path, const std::string& outfile_path,
+                  CompressCB callback = nullptr, void* arg = nullptr);
 
 }  // namespace
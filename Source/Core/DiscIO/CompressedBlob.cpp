@@ -13,6 +13,7 @@
 #include <cstring>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 #include <zlib.h>
@@ -26,6 +27,7 @@
 #include "Common/StringUtil.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/CompressedBlob.h"
+#include "DiscIO/ConversionPipeline.h"
 #include "DiscIO/DiscScrubber.h"
 
 namespace DiscIO
@@ -152,6 +154,49 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
   return true;
 }
 
+namespace
+{
+// Blocks are handed to the compression threads in groups, to keep the synchronization overhead
+// small compared to the work.
+constexpr u32 BLOCKS_PER_JOB = 32;
+
+struct CompressedBlock
+{
+  std::vector<u8> in_buf;
+  std::vector<u8> out_buf;
+
+  // Size of the compressed data in out_buf, 0 if the block should be stored uncompressed, or
+  // negative if zlib failed.
+  int comp_size;
+};
+
+struct CompressionJob
+{
+  std::vector<CompressedBlock> blocks;
+  u32 num_blocks;
+};
+
+void CompressBlock(z_stream* z, CompressedBlock* block, u32 block_size)
+{
+  if (deflateReset(z) != Z_OK)
+  {
+    block->comp_size = -1;
+    return;
+  }
+
+  z->next_in = block->in_buf.data();
+  z->avail_in = block_size;
+  z->next_out = block->out_buf.data();
+  z->avail_out = block_size;
+
+  int status = deflate(z, Z_FINISH);
+  if ((status != Z_STREAM_END) || (z->avail_out < 10))
+    block->comp_size = 0;
+  else
+    block->comp_size = static_cast<int>(block_size - z->avail_out);
+}
+}  // Anonymous namespace
+
 bool CompressFileToBlob(const std::string& infile_path, const std::string& outfile_path,
                         u32 sub_type, int block_size, CompressCB callback, void* arg)
 {
@@ -193,9 +238,19 @@ bool CompressFileToBlob(const std::string& infile_path, const std::string& outfi
     scrubbing = true;
   }
 
-  z_stream z = {};
-  if (deflateInit(&z, 9) != Z_OK)
-    return false;
+  // Reading (and scrubbing), compressing and writing are pipelined, with one zlib stream per
+  // compression thread.
+  const u32 num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  std::vector<z_stream> streams(num_threads);
+  for (u32 i = 0; i < num_threads; i++)
+  {
+    if (deflateInit(&streams[i], 9) != Z_OK)
+    {
+      for (u32 j = 0; j < i; j++)
+        deflateEnd(&streams[j]);
+      return false;
+    }
+  }
 
   callback(GetStringT("Files opened, ready to compress."), 0, arg);
 
@@ -210,8 +265,6 @@ bool CompressFileToBlob(const std::string& infile_path, const std::string& outfi
 
   std::vector<u64> offsets(header.num_blocks);
   std::vector<u32> hashes(header.num_blocks);
-  std::vector<u8> out_buf(block_size);
-  std::vector<u8> in_buf(block_size);
 
   // seek past the header (we will write it at the end)
   outfile.Seek(sizeof(CompressedBlobHeader), SEEK_CUR);
@@ -224,88 +277,108 @@ bool CompressFileToBlob(const std::string& infile_path, const std::string& outfi
   u64 position = 0;
   int num_compressed = 0;
   int num_stored = 0;
-  int progress_monitor = std::max<int>(1, header.num_blocks / 1000);
-  bool success = true;
+  u32 progress_monitor = std::max<u32>(1, header.num_blocks / 1000);
+  u32 next_progress_update = 0;
 
-  for (u32 i = 0; i < header.num_blocks; i++)
-  {
-    if (i % progress_monitor == 0)
+  const auto read = [&](u64 index, CompressionJob* job) {
+    if (job->blocks.empty())
+    {
+      job->blocks.resize(BLOCKS_PER_JOB);
+      for (CompressedBlock& block : job->blocks)
+      {
+        block.in_buf.resize(block_size);
+        block.out_buf.resize(block_size);
+      }
+    }
+
+    const u32 first_block = static_cast<u32>(index * BLOCKS_PER_JOB);
+    job->num_blocks = std::min(BLOCKS_PER_JOB, header.num_blocks - first_block);
+    for (u32 j = 0; j < job->num_blocks; j++)
+    {
+      std::vector<u8>& in_buf = job->blocks[j].in_buf;
+      size_t read_bytes;
+      if (scrubbing)
+        read_bytes = disc_scrubber.GetNextBlock(infile, in_buf.data());
+      else
+        infile.ReadArray(in_buf.data(), header.block_size, &read_bytes);
+      if (read_bytes < header.block_size)
+        std::fill(in_buf.begin() + read_bytes, in_buf.begin() + header.block_size, 0);
+    }
+    return true;
+  };
+
+  const auto compress = [&](CompressionJob* job, u32 worker_index) {
+    for (u32 j = 0; j < job->num_blocks; j++)
+      CompressBlock(&streams[worker_index], &job->blocks[j], header.block_size);
+  };
+
+  const auto write = [&](u64 index, CompressionJob* job) {
+    const u32 first_block = static_cast<u32>(index * BLOCKS_PER_JOB);
+    if (first_block >= next_progress_update)
     {
-      const u64 inpos = infile.Tell();
+      const u64 inpos = static_cast<u64>(first_block) * header.block_size;
       int ratio = 0;
       if (inpos != 0)
         ratio = (int)(100 * position / inpos);
 
       std::string temp =
-          StringFromFormat(GetStringT("%i of %i blocks. Compression ratio %i%%").c_str(), i,
-                           header.num_blocks, ratio);
-      bool was_cancelled = !callback(temp, (float)i / (float)header.num_blocks, arg);
+          StringFromFormat(GetStringT("%i of %i blocks. Compression ratio %i%%").c_str(),
+                           first_block, header.num_blocks, ratio);
+      bool was_cancelled =
+          !callback(temp, (float)first_block / (float)header.num_blocks, arg);
       if (was_cancelled)
-      {
-        success = false;
-        break;
-      }
+        return false;
+      next_progress_update = first_block + progress_monitor;
     }
 
-    offsets[i] = position;
+    for (u32 j = 0; j < job->num_blocks; j++)
+    {
+      const u32 i = first_block + j;
+      const CompressedBlock& block = job->blocks[j];
+      if (block.comp_size < 0)
+      {
+        ERROR_LOG(DISCIO, "Deflate failed");
+        return false;
+      }
 
-    size_t read_bytes;
-    if (scrubbing)
-      read_bytes = disc_scrubber.GetNextBlock(infile, in_buf.data());
-    else
-      infile.ReadArray(in_buf.data(), header.block_size, &read_bytes);
-    if (read_bytes < header.block_size)
-      std::fill(in_buf.begin() + read_bytes, in_buf.begin() + header.block_size, 0);
+      offsets[i] = position;
 
-    int retval = deflateReset(&z);
-    z.next_in = in_buf.data();
-    z.avail_in = header.block_size;
-    z.next_out = out_buf.data();
-    z.avail_out = block_size;
+      const u8* write_buf;
+      int write_size;
+      if (block.comp_size == 0)
+      {
+        // let's store uncompressed
+        write_buf = block.in_buf.data();
+        offsets[i] |= 0x8000000000000000ULL;
+        write_size = block_size;
+        num_stored++;
+      }
+      else
+      {
+        // let's store compressed
+        write_buf = block.out_buf.data();
+        write_size = block.comp_size;
+        num_compressed++;
+      }
 
-    if (retval != Z_OK)
-    {
-      ERROR_LOG(DISCIO, "Deflate failed");
-      success = false;
-      break;
-    }
+      if (!outfile.WriteBytes(write_buf, write_size))
+      {
+        PanicAlertT("Failed to write the output file \"%s\".\n"
+                    "Check that you have enough space available on the target drive.",
+                    outfile_path.c_str());
+        return false;
+      }
 
-    int status = deflate(&z, Z_FINISH);
-    int comp_size = block_size - z.avail_out;
+      position += write_size;
 
-    u8* write_buf;
-    int write_size;
-    if ((status != Z_STREAM_END) || (z.avail_out < 10))
-    {
-      // PanicAlert("%i %i Store %i", i*block_size, position, comp_size);
-      // let's store uncompressed
-      write_buf = in_buf.data();
-      offsets[i] |= 0x8000000000000000ULL;
-      write_size = block_size;
-      num_stored++;
-    }
-    else
-    {
-      // let's store compressed
-      // PanicAlert("Comp %i to %i", block_size, comp_size);
-      write_buf = out_buf.data();
-      write_size = comp_size;
-      num_compressed++;
+      hashes[i] = Common::HashAdler32(write_buf, write_size);
     }
+    return true;
+  };
 
-    if (!outfile.WriteBytes(write_buf, write_size))
-    {
-      PanicAlertT("Failed to write the output file \"%s\".\n"
-                  "Check that you have enough space available on the target drive.",
-                  outfile_path.c_str());
-      success = false;
-      break;
-    }
-
-    position += write_size;
-
-    hashes[i] = Common::HashAdler32(write_buf, write_size);
-  }
+  const u64 num_jobs = (header.num_blocks + BLOCKS_PER_JOB - 1) / BLOCKS_PER_JOB;
+  const bool success = RunConversionPipeline<CompressionJob>(
+      num_jobs, num_threads, num_threads * 4, read, compress, write);
 
   header.compressed_data_size = position;
 
@@ -325,7 +398,8 @@ bool CompressFileToBlob(const std::string& infile_path, const std::string& outfi
   }
 
   // Cleanup
-  deflateEnd(&z);
+  for (z_stream& z : streams)
+    deflateEnd(&z);
 
   if (success)
   {
@@ -369,33 +443,35 @@ bool DecompressBlobToFile(const std::string& infile_path, const std::string& out
   static const size_t BUFFER_BLOCKS = 32;
   size_t buffer_size = header.block_size * BUFFER_BLOCKS;
   size_t last_buffer_size = header.block_size * (header.num_blocks % BUFFER_BLOCKS);
-  std::vector<u8> buffer(buffer_size);
   u32 num_buffers = (header.num_blocks + BUFFER_BLOCKS - 1) / BUFFER_BLOCKS;
   int progress_monitor = std::max<int>(1, num_buffers / 100);
-  bool success = true;
 
-  for (u64 i = 0; i < num_buffers; i++)
-  {
+  // Decompression happens inside the reader, so the pipeline only overlaps it with writing.
+  const auto read = [&](u64 i, std::vector<u8>* buffer) {
+    buffer->resize(i == num_buffers - 1 ? last_buffer_size : buffer_size);
+    reader->Read(i * buffer_size, buffer->size(), buffer->data());
+    return true;
+  };
+
+  const auto write = [&](u64 i, std::vector<u8>* buffer) {
     if (i % progress_monitor == 0)
     {
       bool was_cancelled = !callback(GetStringT("Unpacking"), (float)i / (float)num_buffers, arg);
       if (was_cancelled)
-      {
-        success = false;
-        break;
-      }
+        return false;
     }
-    const size_t sz = i == num_buffers - 1 ? last_buffer_size : buffer_size;
-    reader->Read(i * buffer_size, sz, buffer.data());
-    if (!outfile.WriteBytes(buffer.data(), sz))
+    if (!outfile.WriteBytes(buffer->data(), buffer->size()))
     {
       PanicAlertT("Failed to write the output file \"%s\".\n"
                   "Check that you have enough space available on the target drive.",
                   outfile_path.c_str());
-      success = false;
-      break;
+      return false;
     }
-  }
+    return true;
+  };
+
+  const bool success = RunConversionPipeline<std::vector<u8>>(
+      num_buffers, 1, 4, read, [](std::vector<u8>*, u32) {}, write);
 
   if (!success)
   {
@@ -0,0 +1,130 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
+
+namespace DiscIO
+{
+// Runs a disc image conversion as three overlapping stages, so that reading the input,
+// transforming it (scrubbing, compressing, decrypting...) and writing the output all happen at
+// the same time, and the conversion is limited by the slowest stage rather than by their sum:
+//
+// - read(index, job) is called for each job in order, on a dedicated reader thread.
+// - transform(job, worker_index) is called for each job on one of num_workers worker threads.
+// - write(index, job) is called for each job in order, on the calling thread.
+//
+// At most max_jobs_in_flight jobs exist at once, which bounds the memory used when one stage is
+// slower than the others. Job objects are reused, so buffers allocated by one job are kept for
+// the later ones. If read or write returns false, the conversion stops and false is returned.
+template <typename Job>
+bool RunConversionPipeline(u64 num_jobs, u32 num_workers, size_t max_jobs_in_flight,
+                           const std::function<bool(u64, Job*)>& read,
+                           const std::function<void(Job*, u32)>& transform,
+                           const std::function<bool(u64, Job*)>& write)
+{
+  enum class SlotState
+  {
+    Free,
+    Transforming,
+    Done
+  };
+
+  struct Slot
+  {
+    Job job;
+    SlotState state = SlotState::Free;
+  };
+
+  std::vector<Slot> slots(max_jobs_in_flight);
+  std::mutex mutex;
+  std::condition_variable state_changed;
+  bool aborted = false;
+
+  auto set_state = [&](Slot* slot, SlotState state) {
+    {
+      std::lock_guard<std::mutex> lk(mutex);
+      slot->state = state;
+    }
+    state_changed.notify_all();
+  };
+
+  auto abort = [&] {
+    {
+      std::lock_guard<std::mutex> lk(mutex);
+      aborted = true;
+    }
+    state_changed.notify_all();
+  };
+
+  // Waits for the slot to reach the given state. Returns false if the conversion was aborted.
+  auto wait_for_state = [&](const Slot& slot, SlotState state) {
+    std::unique_lock<std::mutex> lk(mutex);
+    state_changed.wait(lk, [&] { return aborted || slot.state == state; });
+    return !aborted;
+  };
+
+  std::vector<std::unique_ptr<Common::WorkQueueThread<size_t>>> workers;
+  for (u32 i = 0; i < num_workers; i++)
+  {
+    workers.push_back(std::make_unique<Common::WorkQueueThread<size_t>>([&, i](size_t slot_index) {
+      transform(&slots[slot_index].job, i);
+      set_state(&slots[slot_index], SlotState::Done);
+    }));
+  }
+
+  // Since jobs are read and written in order, the slot of a job is only reused once the job
+  // max_jobs_in_flight before it has been written.
+  std::thread reader([&] {
+    for (u64 index = 0; index < num_jobs; index++)
+    {
+      const size_t slot_index = static_cast<size_t>(index % slots.size());
+      Slot& slot = slots[slot_index];
+      if (!wait_for_state(slot, SlotState::Free))
+        return;
+
+      if (!read(index, &slot.job))
+      {
+        abort();
+        return;
+      }
+
+      set_state(&slot, SlotState::Transforming);
+      workers[index % workers.size()]->EmplaceItem(slot_index);
+    }
+  });
+
+  bool success = true;
+  for (u64 index = 0; index < num_jobs; index++)
+  {
+    Slot& slot = slots[static_cast<size_t>(index % slots.size())];
+    if (!wait_for_state(slot, SlotState::Done) || !write(index, &slot.job))
+    {
+      success = false;
+      abort();
+      break;
+    }
+
+    set_state(&slot, SlotState::Free);
+  }
+
+  reader.join();
+
+  // Wait for any jobs that are still being transformed before their slots go away.
+  workers.clear();
+
+  return success;
+}
+
+}  // namespace DiscIO
@@ -8,6 +8,7 @@
 #include <array>
 #include <cinttypes>
 #include <cstring>
+#include <list>
 #include <locale>
 #include <map>
 #include <memory>
@@ -28,6 +29,7 @@
 #include "Common/Swap.h"
 #include "Core/Boot/DolReader.h"
 #include "DiscIO/Blob.h"
+#include "DiscIO/FileBlob.h"
 #include "DiscIO/VolumeWii.h"
 
 namespace DiscIO
@@ -60,6 +62,26 @@ constexpr u8 ENTRY_SIZE = 0x0c;
 constexpr u8 FILE_ENTRY = 0;
 constexpr u8 DIRECTORY_ENTRY = 1;
 
+BlobReader* OpenFileCache::Get(const std::string& path)
+{
+  auto it = std::find_if(m_files.begin(), m_files.end(),
+                         [&path](const auto& file) { return file.first == path; });
+  if (it != m_files.end())
+  {
+    m_files.splice(m_files.begin(), m_files, it);
+    return m_files.front().second.get();
+  }
+
+  std::unique_ptr<BlobReader> reader = PlainFileReader::Create(File::IOFile(path, "rb"));
+  if (!reader)
+    return nullptr;
+
+  if (m_files.size() >= MAX_OPEN_FILES)
+    m_files.pop_back();
+  m_files.emplace_front(path, std::move(reader));
+  return m_files.front().second.get();
+}
+
 DiscContent::DiscContent(u64 offset, u64 size, const std::string& path)
     : m_offset(offset), m_size(size), m_content_source(path)
 {
@@ -89,7 +111,7 @@ u64 DiscContent::GetSize() const
   return m_size;
 }
 
-bool DiscContent::Read(u64* offset, u64* length, u8** buffer) const
+bool DiscContent::Read(u64* offset, u64* length, u8** buffer, OpenFileCache* file_cache) const
 {
   if (m_size == 0)
     return true;
@@ -103,9 +125,8 @@ bool DiscContent::Read(u64* offset, u64* length, u8** buffer) const
 
     if (std::holds_alternative<std::string>(m_content_source))
     {
-      File::IOFile file(std::get<std::string>(m_content_source), "rb");
-      file.Seek(offset_in_content, SEEK_SET);
-      if (!file.ReadBytes(*buffer, bytes_to_read))
+      BlobReader* file = file_cache->Get(std::get<std::string>(m_content_source));
+      if (!file || !file->Read(offset_in_content, bytes_to_read, *buffer))
         return false;
     }
     else
@@ -158,7 +179,7 @@ bool DiscContentContainer::Read(u64 offset, u64 length, u8* buffer) const
     // Zero fill to start of DiscContent data
     PadToAddress(it->GetOffset(), &offset, &length, &buffer);
 
-    if (!it->Read(&offset, &length, &buffer))
+    if (!it->Read(&offset, &length, &buffer, &m_open_files))
       return false;
 
     ++it;
@@ -729,19 +750,21 @@ void DirectoryBlobPartition::WriteDirectory(const File::FSTEntry& parent_entry,
                                             u32* name_offset, u64* data_offset,
                                             u32 parent_entry_index, u64 name_table_offset)
 {
-  std::vector<File::FSTEntry> sorted_entries = parent_entry.children;
+  // Sort for determinism. Only pointers are sorted, since copying the entries would copy their
+  // whole subtrees, and the uppercase names are computed once per entry rather than per comparison.
+  std::vector<std::pair<std::string, const File::FSTEntry*>> sorted_entries;
+  sorted_entries.reserve(parent_entry.children.size());
+  for (const File::FSTEntry& entry : parent_entry.children)
+    sorted_entries.emplace_back(ASCIIToUppercase(entry.virtualName), &entry);
 
-  // Sort for determinism
-  std::sort(sorted_entries.begin(), sorted_entries.end(),
-            [](const File::FSTEntry& one, const File::FSTEntry& two) {
-              const std::string one_upper = ASCIIToUppercase(one.virtualName);
-              const std::string two_upper = ASCIIToUppercase(two.virtualName);
-              return one_upper == two_upper ? one.virtualName < two.virtualName :
-                                              one_upper < two_upper;
-            });
+  std::sort(sorted_entries.begin(), sorted_entries.end(), [](const auto& one, const auto& two) {
+    return one.first == two.first ? one.second->virtualName < two.second->virtualName :
+                                    one.first < two.first;
+  });
 
-  for (const File::FSTEntry& entry : sorted_entries)
+  for (const auto& sorted_entry : sorted_entries)
   {
+    const File::FSTEntry& entry = *sorted_entry.second;
     if (entry.isDirectory)
     {
       u32 entry_index = *fst_offset / ENTRY_SIZE;
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <cstddef>
+#include <list>
 #include <map>
 #include <memory>
 #include <optional>
@@ -30,6 +31,21 @@ enum class PartitionType : u32;
 // Returns true if the path is inside a DirectoryBlob and doesn't represent the DirectoryBlob itself
 bool ShouldHideFromGameList(const std::string& volume_path);
 
+// Keeps the most recently read host files open, so that reading from a directory with many
+// files doesn't open and close a file for every read. The files are memory-mapped when possible.
+class OpenFileCache
+{
+public:
+  // Returns nullptr if the file couldn't be opened.
+  BlobReader* Get(const std::string& path);
+
+private:
+  static constexpr size_t MAX_OPEN_FILES = 32;
+
+  // Sorted from most to least recently used.
+  std::list<std::pair<std::string, std::unique_ptr<BlobReader>>> m_files;
+};
+
 class DiscContent
 {
 public:
@@ -44,7 +60,7 @@ public:
   u64 GetOffset() const;
   u64 GetEndOffset() const;
   u64 GetSize() const;
-  bool Read(u64* offset, u64* length, u8** buffer) const;
+  bool Read(u64* offset, u64* length, u8** buffer, OpenFileCache* file_cache) const;
 
   bool operator==(const DiscContent& other) const { return GetEndOffset() == other.GetEndOffset(); }
   bool operator!=(const DiscContent& other) const { return !(*this == other); }
@@ -76,6 +92,7 @@ public:
 
 private:
   std::set<DiscContent> m_contents;
+  mutable OpenFileCache m_open_files;
 };
 
 class DirectoryBlobPartition
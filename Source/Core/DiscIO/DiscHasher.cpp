@@ -0,0 +1,170 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "DiscIO/DiscHasher.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <mbedtls/md5.h>
+#include <mbedtls/sha1.h>
+#include <zlib.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/StringUtil.h"
+#include "Common/WorkQueueThread.h"
+#include "DiscIO/Blob.h"
+
+namespace DiscIO
+{
+namespace
+{
+constexpr size_t CHUNK_SIZE = 8 * 1024 * 1024;
+
+using HashFunction = std::function<void(const u8* data, size_t size)>;
+using HashJob = std::pair<const u8*, size_t>;
+}  // Anonymous namespace
+
+std::optional<DiscHashes> ComputeDiscHashes(BlobReader* reader, bool compute_crc32,
+                                            bool compute_md5, bool compute_sha1,
+                                            const std::function<bool(int)>& report_progress)
+{
+  u32 crc32_value = crc32(0, nullptr, 0);
+  mbedtls_md5_context md5_context;
+  mbedtls_sha1_context sha1_context;
+  mbedtls_md5_init(&md5_context);
+  mbedtls_sha1_init(&sha1_context);
+  mbedtls_md5_starts(&md5_context);
+  mbedtls_sha1_starts(&sha1_context);
+
+  std::vector<HashFunction> hash_functions;
+  if (compute_crc32)
+  {
+    hash_functions.emplace_back([&crc32_value](const u8* data, size_t size) {
+      crc32_value = crc32(crc32_value, data, static_cast<uInt>(size));
+    });
+  }
+  if (compute_md5)
+  {
+    hash_functions.emplace_back([&md5_context](const u8* data, size_t size) {
+      mbedtls_md5_update(&md5_context, data, size);
+    });
+  }
+  if (compute_sha1)
+  {
+    hash_functions.emplace_back([&sha1_context](const u8* data, size_t size) {
+      mbedtls_sha1_update(&sha1_context, data, size);
+    });
+  }
+
+  std::atomic<u32> jobs_pending{0};
+  Common::Event jobs_done;
+  std::vector<std::unique_ptr<Common::WorkQueueThread<HashJob>>> workers;
+  for (HashFunction& hash_function : hash_functions)
+  {
+    workers.push_back(
+        std::make_unique<Common::WorkQueueThread<HashJob>>([&](const HashJob& job) {
+          hash_function(job.first, job.second);
+          if (jobs_pending.fetch_sub(1) == 1)
+            jobs_done.Set();
+        }));
+  }
+
+  bool chunk_in_flight = false;
+  const auto wait_for_chunk = [&] {
+    if (chunk_in_flight)
+      jobs_done.Wait();
+    chunk_in_flight = false;
+  };
+
+  // Two buffers are used, so that one can be read into while the other one is being hashed.
+  std::array<std::vector<u8>, 2> buffers;
+  const u64 size = reader->GetDataSize();
+  bool success = true;
+  size_t buffer_index = 0;
+  for (u64 offset = 0; offset < size; offset += CHUNK_SIZE, buffer_index ^= 1)
+  {
+    std::vector<u8>& buffer = buffers[buffer_index];
+    const size_t read_size = static_cast<size_t>(std::min<u64>(CHUNK_SIZE, size - offset));
+    buffer.resize(read_size);
+    if (!reader->Read(offset, read_size, buffer.data()))
+    {
+      success = false;
+      break;
+    }
+
+    wait_for_chunk();
+    if (!workers.empty())
+    {
+      jobs_pending.store(static_cast<u32>(workers.size()));
+      for (auto& worker : workers)
+        worker->EmplaceItem(buffer.data(), read_size);
+      chunk_in_flight = true;
+    }
+
+    const int progress =
+        static_cast<int>(static_cast<float>(offset + read_size) / static_cast<float>(size) * 100);
+    if (!report_progress(progress))
+    {
+      success = false;
+      break;
+    }
+  }
+  wait_for_chunk();
+  workers.clear();
+
+  DiscHashes hashes;
+  if (success)
+  {
+    if (compute_crc32)
+      hashes.crc32 = crc32_value;
+    if (compute_md5)
+    {
+      hashes.md5.emplace();
+      mbedtls_md5_finish(&md5_context, hashes.md5->data());
+    }
+    if (compute_sha1)
+    {
+      hashes.sha1.emplace();
+      mbedtls_sha1_finish(&sha1_context, hashes.sha1->data());
+    }
+  }
+
+  mbedtls_md5_free(&md5_context);
+  mbedtls_sha1_free(&sha1_context);
+
+  if (!success)
+    return std::nullopt;
+  return hashes;
+}
+
+std::string ComputeMD5String(const std::string& file_path,
+                             const std::function<bool(int)>& report_progress)
+{
+  std::string output_string;
+
+  std::unique_ptr<BlobReader> file(CreateBlobReader(file_path));
+  if (!file)
+    return output_string;
+
+  const std::optional<DiscHashes> hashes =
+      ComputeDiscHashes(file.get(), false, true, false, report_progress);
+  if (!hashes)
+    return output_string;
+
+  // Convert to hex
+  for (u8 n : *hashes->md5)
+    output_string += StringFromFormat("%02x", n);
+
+  return output_string;
+}
+}  // namespace DiscIO
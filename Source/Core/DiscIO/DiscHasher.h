@@ -0,0 +1,38 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <functional>
+#include <optional>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace DiscIO
+{
+class BlobReader;
+
+struct DiscHashes
+{
+  // Only the hashes that were requested are set.
+  std::optional<u32> crc32;
+  std::optional<std::array<u8, 16>> md5;
+  std::optional<std::array<u8, 20>> sha1;
+};
+
+// Hashes the whole blob in a single pass. Each algorithm runs on its own thread, and the next
+// chunk is read while the previous one is being hashed, so computing several hashes takes about
+// as long as computing the slowest one. report_progress gets a percentage and can return false
+// to cancel. Returns std::nullopt if reading fails or the operation is cancelled.
+std::optional<DiscHashes> ComputeDiscHashes(BlobReader* reader, bool compute_crc32,
+                                            bool compute_md5, bool compute_sha1,
+                                            const std::function<bool(int)>& report_progress);
+
+// Returns the MD5 of the disc image at the given path as a hex string, or an empty string if it
+// could not be computed.
+std::string ComputeMD5String(const std::string& file_path,
+                             const std::function<bool(int)>& report_progress);
+}  // namespace DiscIO
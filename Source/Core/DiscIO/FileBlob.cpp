@@ -2,17 +2,50 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
 
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "Common/Align.h"
 #include "DiscIO/FileBlob.h"
 
 namespace DiscIO
 {
+#ifdef _WIN32
+namespace
+{
+// PrefetchVirtualMemory is only available on Windows 8 and newer.
+using PrefetchVirtualMemoryFunc = BOOL(WINAPI*)(HANDLE, ULONG_PTR, PWIN32_MEMORY_RANGE_ENTRY,
+                                                ULONG);
+
+PrefetchVirtualMemoryFunc GetPrefetchVirtualMemory()
+{
+  static const PrefetchVirtualMemoryFunc func = reinterpret_cast<PrefetchVirtualMemoryFunc>(
+      GetProcAddress(GetModuleHandle(TEXT("kernel32.dll")), "PrefetchVirtualMemory"));
+  return func;
+}
+}  // Anonymous namespace
+#endif
+
 PlainFileReader::PlainFileReader(File::IOFile file) : m_file(std::move(file))
 {
   m_size = m_file.GetSize();
+  MapFile();
+}
+
+PlainFileReader::~PlainFileReader()
+{
+  UnmapFile();
 }
 
 std::unique_ptr<PlainFileReader> PlainFileReader::Create(File::IOFile file)
@@ -23,8 +56,95 @@ std::unique_ptr<PlainFileReader> PlainFileReader::Create(File::IOFile file)
   return nullptr;
 }
 
+// If mapping fails (for instance because the address space is too small for the image), reads
+// fall back to going through m_file. The file is kept open either way.
+void PlainFileReader::MapFile()
+{
+  if (m_size <= 0)
+    return;
+
+#ifdef _WIN32
+  const HANDLE file_handle =
+      reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(m_file.GetHandle())));
+  m_mapping_handle = CreateFileMapping(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!m_mapping_handle)
+    return;
+
+  m_mapped_data = static_cast<const u8*>(MapViewOfFile(m_mapping_handle, FILE_MAP_READ, 0, 0, 0));
+  if (!m_mapped_data)
+  {
+    CloseHandle(m_mapping_handle);
+    m_mapping_handle = nullptr;
+  }
+#else
+  void* data = mmap(nullptr, static_cast<size_t>(m_size), PROT_READ, MAP_SHARED,
+                    fileno(m_file.GetHandle()), 0);
+  if (data != MAP_FAILED)
+    m_mapped_data = static_cast<const u8*>(data);
+#endif
+}
+
+void PlainFileReader::UnmapFile()
+{
+  if (!m_mapped_data)
+    return;
+
+#ifdef _WIN32
+  UnmapViewOfFile(m_mapped_data);
+  CloseHandle(m_mapping_handle);
+  m_mapping_handle = nullptr;
+#else
+  munmap(const_cast<u8*>(m_mapped_data), static_cast<size_t>(m_size));
+#endif
+
+  m_mapped_data = nullptr;
+}
+
+void PlainFileReader::ReadAhead(u64 offset, u64 nbytes)
+{
+  const u64 end = offset + nbytes;
+  const bool sequential = offset == m_last_read_end;
+  m_last_read_end = end;
+
+  // Random reads are left to the page fault handler. For sequential ones, a hint is only issued
+  // once the read gets close to the end of the previous window, to keep the syscalls rare.
+  if (!sequential || end + READ_AHEAD_SIZE / 2 <= m_read_ahead_end)
+    return;
+
+  const u64 start = std::max(end, m_read_ahead_end);
+  const u64 read_ahead_end = std::min<u64>(end + READ_AHEAD_SIZE, m_size);
+  m_read_ahead_end = read_ahead_end;
+  if (start >= read_ahead_end)
+    return;
+
+#ifdef _WIN32
+  if (const PrefetchVirtualMemoryFunc prefetch = GetPrefetchVirtualMemory())
+  {
+    WIN32_MEMORY_RANGE_ENTRY range;
+    range.VirtualAddress = const_cast<u8*>(m_mapped_data + start);
+    range.NumberOfBytes = static_cast<SIZE_T>(read_ahead_end - start);
+    prefetch(GetCurrentProcess(), 1, &range, 0);
+  }
+#else
+  static const u64 page_size = static_cast<u64>(sysconf(_SC_PAGESIZE));
+  const u64 aligned_start = Common::AlignDown(start, page_size);
+  madvise(const_cast<u8*>(m_mapped_data + aligned_start),
+          static_cast<size_t>(read_ahead_end - aligned_start), MADV_WILLNEED);
+#endif
+}
+
 bool PlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
 {
+  if (m_mapped_data)
+  {
+    if (offset > static_cast<u64>(m_size) || nbytes > static_cast<u64>(m_size) - offset)
+      return false;
+
+    ReadAhead(offset, nbytes);
+    std::memcpy(out_ptr, m_mapped_data + offset, static_cast<size_t>(nbytes));
+    return true;
+  }
+
   if (m_file.Seek(offset, SEEK_SET) && m_file.ReadBytes(out_ptr, nbytes))
   {
     return true;
@@ -14,10 +14,15 @@
 
 namespace DiscIO
 {
+// Plain disc images are memory-mapped when possible, so that the many small reads done while
+// booting and extracting files are plain copies instead of a seek and a read syscall each. Reads
+// which continue where the previous one ended hint the OS to read ahead, since the drive
+// interface mostly streams consecutive sectors.
 class PlainFileReader : public BlobReader
 {
 public:
   static std::unique_ptr<PlainFileReader> Create(File::IOFile file);
+  ~PlainFileReader();
 
   BlobType GetBlobType() const override { return BlobType::PLAIN; }
   u64 GetDataSize() const override { return m_size; }
@@ -25,10 +30,24 @@ public:
   bool Read(u64 offset, u64 nbytes, u8* out_ptr) override;
 
 private:
+  // How far past the end of a sequential read the OS is asked to prefetch.
+  static constexpr u64 READ_AHEAD_SIZE = 4 * 1024 * 1024;
+
   PlainFileReader(File::IOFile file);
 
+  void MapFile();
+  void UnmapFile();
+  void ReadAhead(u64 offset, u64 nbytes);
+
   File::IOFile m_file;
   s64 m_size;
+
+  const u8* m_mapped_data = nullptr;
+#ifdef _WIN32
+  void* m_mapping_handle = nullptr;
+#endif
+  u64 m_last_read_end = 0;
+  u64 m_read_ahead_end = 0;
 };
 
 }  // namespace
@@ -6,22 +6,30 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <cinttypes>
 #include <cstddef>
 #include <cstring>
+#include <iterator>
 #include <map>
-#include <mbedtls/aes.h>
 #include <mbedtls/sha1.h>
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/Crypto/AES.h"
+#include "Common/Event.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
+#include "Common/WorkQueueThread.h"
+#include "Core/Config/MainSettings.h"
 
 #include "DiscIO/Blob.h"
 #include "DiscIO/DiscExtractor.h"
@@ -34,11 +42,15 @@
 namespace DiscIO
 {
 VolumeWii::VolumeWii(std::unique_ptr<BlobReader> reader)
-    : m_reader(std::move(reader)), m_game_partition(PARTITION_NONE),
-      m_last_decrypted_block(UINT64_MAX)
+    : m_reader(std::move(reader)), m_game_partition(PARTITION_NONE)
 {
   ASSERT(m_reader);
 
+  // Always keep at least the last cluster, so sequential small reads don't decrypt it repeatedly.
+  const int cache_size_mb = std::max(Config::Get(Config::MAIN_WII_DISC_CLUSTER_CACHE_SIZE), 0);
+  m_max_decrypted_clusters =
+      std::max<size_t>(static_cast<size_t>(cache_size_mb) * 1024 * 1024 / BLOCK_TOTAL_SIZE, 1);
+
   m_encrypted = m_reader->ReadSwapped<u32>(0x60) == u32(0);
 
   for (u32 partition_group = 0; partition_group < 4; ++partition_group)
@@ -97,14 +109,12 @@ VolumeWii::VolumeWii(std::unique_ptr<BlobReader> reader)
         return IOS::ES::TMDReader{std::move(tmd_buffer)};
       };
 
-      auto get_key = [this, partition]() -> std::unique_ptr<mbedtls_aes_context> {
+      auto get_key = [this, partition]() -> std::unique_ptr<Common::AES::Context> {
         const IOS::ES::TicketReader& ticket = *m_partitions[partition].ticket;
         if (!ticket.IsValid())
           return nullptr;
         const std::array<u8, 16> key = ticket.GetTitleKey();
-        std::unique_ptr<mbedtls_aes_context> aes_context = std::make_unique<mbedtls_aes_context>();
-        mbedtls_aes_setkey_dec(aes_context.get(), key.data(), 128);
-        return aes_context;
+        return Common::AES::CreateContext(key.data(), Common::AES::Mode::Decrypt);
       };
 
       auto get_file_system = [this, partition]() -> std::unique_ptr<FileSystem> {
@@ -117,11 +127,12 @@ VolumeWii::VolumeWii(std::unique_ptr<BlobReader> reader)
       };
 
       m_partitions.emplace(
-          partition, PartitionDetails{Common::Lazy<std::unique_ptr<mbedtls_aes_context>>(get_key),
-                                      Common::Lazy<IOS::ES::TicketReader>(get_ticket),
-                                      Common::Lazy<IOS::ES::TMDReader>(get_tmd),
-                                      Common::Lazy<std::unique_ptr<FileSystem>>(get_file_system),
-                                      Common::Lazy<u64>(get_data_offset), *partition_type});
+          partition,
+          PartitionDetails{Common::Lazy<std::unique_ptr<Common::AES::Context>>(get_key),
+                           Common::Lazy<IOS::ES::TicketReader>(get_ticket),
+                           Common::Lazy<IOS::ES::TMDReader>(get_tmd),
+                           Common::Lazy<std::unique_ptr<FileSystem>>(get_file_system),
+                           Common::Lazy<u64>(get_data_offset), *partition_type});
     }
   }
 }
@@ -149,11 +160,10 @@ bool VolumeWii::Read(u64 offset, u64 length, u8* buffer, const Partition& partit
   if (m_reader->SupportsReadWiiDecrypted())
     return m_reader->ReadWiiDecrypted(offset, length, buffer, partition.offset);
 
-  mbedtls_aes_context* aes_context = partition_details.key->get();
+  Common::AES::Context* aes_context = partition_details.key->get();
   if (!aes_context)
     return false;
 
-  std::vector<u8> read_buffer(BLOCK_TOTAL_SIZE);
   while (length > 0)
   {
     // Calculate offsets
@@ -161,30 +171,13 @@ bool VolumeWii::Read(u64 offset, u64 length, u8* buffer, const Partition& partit
                                offset / BLOCK_DATA_SIZE * BLOCK_TOTAL_SIZE;
     u64 data_offset_in_block = offset % BLOCK_DATA_SIZE;
 
-    if (m_last_decrypted_block != block_offset_on_disc)
-    {
-      // Read the current block
-      if (!m_reader->Read(block_offset_on_disc, BLOCK_TOTAL_SIZE, read_buffer.data()))
-        return false;
-
-      // Decrypt the block's data.
-      // 0x3D0 - 0x3DF in read_buffer will be overwritten,
-      // but that won't affect anything, because we won't
-      // use the content of read_buffer anymore after this
-      mbedtls_aes_crypt_cbc(aes_context, MBEDTLS_AES_DECRYPT, BLOCK_DATA_SIZE, &read_buffer[0x3D0],
-                            &read_buffer[BLOCK_HEADER_SIZE], m_last_decrypted_block_data);
-      m_last_decrypted_block = block_offset_on_disc;
-
-      // The only thing we currently use from the 0x000 - 0x3FF part
-      // of the block is the IV (at 0x3D0), but it also contains SHA-1
-      // hashes that IOS uses to check that discs aren't tampered with.
-      // http://wiibrew.org/wiki/Wii_Disc#Encrypted
-    }
+    const u8* block_data = GetDecryptedCluster(block_offset_on_disc, aes_context);
+    if (!block_data)
+      return false;
 
     // Copy the decrypted data
     u64 copy_size = std::min(length, BLOCK_DATA_SIZE - data_offset_in_block);
-    memcpy(buffer, &m_last_decrypted_block_data[data_offset_in_block],
-           static_cast<size_t>(copy_size));
+    memcpy(buffer, &block_data[data_offset_in_block], static_cast<size_t>(copy_size));
 
     // Update offsets
     length -= copy_size;
@@ -195,6 +188,52 @@ bool VolumeWii::Read(u64 offset, u64 length, u8* buffer, const Partition& partit
   return true;
 }
 
+const u8* VolumeWii::GetDecryptedCluster(u64 offset_on_disc,
+                                         Common::AES::Context* aes_context) const
+{
+  auto map_iter = m_decrypted_cluster_map.find(offset_on_disc);
+  if (map_iter != m_decrypted_cluster_map.end())
+  {
+    m_decrypted_clusters.splice(m_decrypted_clusters.begin(), m_decrypted_clusters,
+                                map_iter->second);
+    return map_iter->second->data.data();
+  }
+
+  // Read the current block
+  m_encrypted_cluster.resize(BLOCK_TOTAL_SIZE);
+  if (!m_reader->Read(offset_on_disc, BLOCK_TOTAL_SIZE, m_encrypted_cluster.data()))
+    return nullptr;
+
+  // Reuse the least recently used entry once the cache is full.
+  if (m_decrypted_clusters.size() < m_max_decrypted_clusters)
+  {
+    m_decrypted_clusters.emplace_front();
+  }
+  else
+  {
+    m_decrypted_cluster_map.erase(m_decrypted_clusters.back().offset_on_disc);
+    m_decrypted_clusters.splice(m_decrypted_clusters.begin(), m_decrypted_clusters,
+                                std::prev(m_decrypted_clusters.end()));
+  }
+
+  // Decrypt the block's data.
+  // 0x3D0 - 0x3DF in m_encrypted_cluster will be overwritten,
+  // but that won't affect anything, because we won't
+  // use the content of m_encrypted_cluster anymore after this
+  DecryptedCluster& cluster = m_decrypted_clusters.front();
+  aes_context->CryptCBC(&m_encrypted_cluster[0x3D0], &m_encrypted_cluster[BLOCK_HEADER_SIZE],
+                        cluster.data.data(), BLOCK_DATA_SIZE);
+  cluster.offset_on_disc = offset_on_disc;
+  m_decrypted_cluster_map.emplace(offset_on_disc, m_decrypted_clusters.begin());
+
+  // The only thing we currently use from the 0x000 - 0x3FF part
+  // of the block is the IV (at 0x3D0), but it also contains SHA-1
+  // hashes that IOS uses to check that discs aren't tampered with.
+  // http://wiibrew.org/wiki/Wii_Disc#Encrypted
+
+  return cluster.data.data();
+}
+
 bool VolumeWii::IsEncryptedAndHashed() const
 {
   return m_encrypted;
@@ -379,6 +418,88 @@ u64 VolumeWii::GetRawSize() const
   return m_reader->GetRawSize();
 }
 
+namespace
+{
+// An H2 hash covers 8 clusters, and an H3 hash covers 8 * 8 clusters.
+constexpr u64 CLUSTERS_PER_SUBGROUP = 8;
+constexpr u64 CLUSTERS_PER_GROUP = 64;
+constexpr size_t H3_TABLE_SIZE = 0x18000;
+
+// Checks a cluster's data against its H0 hashes, and its hash tables against the H1, H2 and H3
+// hashes covering them.
+bool CheckClusterIntegrity(Common::AES::Context* aes_context, const u8* cluster_crypted,
+                           const u8* h3_hash, u64 cluster_id)
+{
+  // Read and decrypt the cluster metadata
+  u8 cluster_metadata[VolumeWii::BLOCK_HEADER_SIZE];
+  u8 iv[16] = {0};
+  aes_context->CryptCBC(iv, cluster_crypted, cluster_metadata, sizeof(cluster_metadata));
+
+  // Some clusters have invalid data and metadata because they aren't
+  // meant to be read by the game (for example, holes between files). To
+  // try to avoid reporting errors because of these clusters, we check
+  // the 0x00 paddings in the metadata.
+  //
+  // This may cause some false negatives though: some bad clusters may be
+  // skipped because they are *too* bad and are not even recognized as
+  // valid clusters. To be improved.
+  const u8* pad_begin = cluster_metadata + 0x26C;
+  const u8* pad_end = pad_begin + 0x14;
+  const bool meaningless = std::any_of(pad_begin, pad_end, [](u8 val) { return val != 0; });
+
+  if (meaningless)
+    return true;
+
+  u8 cluster_data[VolumeWii::BLOCK_DATA_SIZE];
+  std::memcpy(iv, cluster_crypted + 0x3D0, sizeof(iv));
+  aes_context->CryptCBC(iv, cluster_crypted + sizeof(cluster_metadata), cluster_data,
+                        sizeof(cluster_data));
+
+  u8 hash[20];
+  for (u32 hash_id = 0; hash_id < 31; ++hash_id)
+  {
+    mbedtls_sha1(cluster_data + hash_id * sizeof(cluster_metadata), sizeof(cluster_metadata),
+                 hash);
+
+    // Note that we do not use strncmp here
+    if (memcmp(hash, cluster_metadata + hash_id * sizeof(hash), sizeof(hash)))
+    {
+      WARN_LOG(DISCIO, "Integrity Check: fail at cluster %" PRIu64 ": hash %d is invalid",
+               cluster_id, hash_id);
+      return false;
+    }
+  }
+
+  const u64 h1_index = cluster_id % CLUSTERS_PER_SUBGROUP;
+  mbedtls_sha1(cluster_metadata, 0x26C, hash);
+  if (memcmp(hash, cluster_metadata + 0x280 + h1_index * sizeof(hash), sizeof(hash)))
+  {
+    WARN_LOG(DISCIO, "Integrity Check: fail at cluster %" PRIu64 ": H1 hash is invalid",
+             cluster_id);
+    return false;
+  }
+
+  const u64 h2_index = cluster_id % CLUSTERS_PER_GROUP / CLUSTERS_PER_SUBGROUP;
+  mbedtls_sha1(cluster_metadata + 0x280, 0xA0, hash);
+  if (memcmp(hash, cluster_metadata + 0x340 + h2_index * sizeof(hash), sizeof(hash)))
+  {
+    WARN_LOG(DISCIO, "Integrity Check: fail at cluster %" PRIu64 ": H2 hash is invalid",
+             cluster_id);
+    return false;
+  }
+
+  mbedtls_sha1(cluster_metadata + 0x340, 0xA0, hash);
+  if (memcmp(hash, h3_hash, sizeof(hash)))
+  {
+    WARN_LOG(DISCIO, "Integrity Check: fail at cluster %" PRIu64 ": H3 hash is invalid",
+             cluster_id);
+    return false;
+  }
+
+  return true;
+}
+}  // Anonymous namespace
+
 bool VolumeWii::CheckIntegrity(const Partition& partition) const
 {
   if (!m_encrypted)
@@ -389,7 +510,7 @@ bool VolumeWii::CheckIntegrity(const Partition& partition) const
   if (it == m_partitions.end())
     return false;
   const PartitionDetails& partition_details = it->second;
-  mbedtls_aes_context* aes_context = partition_details.key->get();
+  Common::AES::Context* aes_context = partition_details.key->get();
   if (!aes_context)
     return false;
 
@@ -398,64 +519,78 @@ bool VolumeWii::CheckIntegrity(const Partition& partition) const
   if (!part_data_size)
     return false;
 
-  const u32 num_clusters = static_cast<u32>(part_data_size.value() / 0x8000);
-  for (u32 cluster_id = 0; cluster_id < num_clusters; ++cluster_id)
+  const std::optional<u64> h3_offset =
+      ReadSwappedAndShifted(partition.offset + 0x2B4, PARTITION_NONE);
+  std::vector<u8> h3_table(H3_TABLE_SIZE);
+  if (!h3_offset ||
+      !m_reader->Read(partition.offset + *h3_offset, h3_table.size(), h3_table.data()))
   {
-    const u64 cluster_offset =
-        partition.offset + *partition_details.data_offset + static_cast<u64>(cluster_id) * 0x8000;
-
-    // Read and decrypt the cluster metadata
-    u8 cluster_metadata_crypted[0x400];
-    u8 cluster_metadata[0x400];
-    u8 iv[16] = {0};
-    if (!m_reader->Read(cluster_offset, sizeof(cluster_metadata_crypted), cluster_metadata_crypted))
+    WARN_LOG(DISCIO, "Integrity Check: could not read the H3 table");
+    return false;
+  }
+
+  // The partition is read one group of clusters at a time, in large sequential reads, and the
+  // clusters of each group are decrypted and hashed on all cores.
+  const u64 num_clusters = part_data_size.value() / BLOCK_TOTAL_SIZE;
+  if (num_clusters > H3_TABLE_SIZE / 20 * CLUSTERS_PER_GROUP)
+    return false;
+  const u64 data_start = partition.offset + *partition_details.data_offset;
+  const u32 num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+  std::vector<u8> group(CLUSTERS_PER_GROUP * BLOCK_TOTAL_SIZE);
+  u64 group_start = 0;
+  u64 group_clusters = 0;
+  std::atomic<bool> valid{true};
+  auto check_clusters = [&](u32 thread_index) {
+    const u8* h3_hash = &h3_table[group_start / CLUSTERS_PER_GROUP * 20];
+    for (u64 i = thread_index; i < group_clusters && valid.load(std::memory_order_relaxed);
+         i += num_threads)
     {
-      WARN_LOG(DISCIO, "Integrity Check: fail at cluster %d: could not read metadata", cluster_id);
-      return false;
+      if (!CheckClusterIntegrity(aes_context, &group[i * BLOCK_TOTAL_SIZE], h3_hash,
+                                 group_start + i))
+      {
+        valid.store(false, std::memory_order_relaxed);
+      }
     }
-    mbedtls_aes_crypt_cbc(aes_context, MBEDTLS_AES_DECRYPT, sizeof(cluster_metadata), iv,
-                          cluster_metadata_crypted, cluster_metadata);
-
-    // Some clusters have invalid data and metadata because they aren't
-    // meant to be read by the game (for example, holes between files). To
-    // try to avoid reporting errors because of these clusters, we check
-    // the 0x00 paddings in the metadata.
-    //
-    // This may cause some false negatives though: some bad clusters may be
-    // skipped because they are *too* bad and are not even recognized as
-    // valid clusters. To be improved.
-    const u8* pad_begin = cluster_metadata + 0x26C;
-    const u8* pad_end = pad_begin + 0x14;
-    const bool meaningless = std::any_of(pad_begin, pad_end, [](u8 val) { return val != 0; });
-
-    if (meaningless)
-      continue;
+  };
+
+  std::atomic<u32> jobs_pending{0};
+  Common::Event jobs_done;
+  std::vector<std::unique_ptr<Common::WorkQueueThread<u32>>> workers;
+  for (u32 i = 1; i < num_threads; i++)
+  {
+    workers.push_back(std::make_unique<Common::WorkQueueThread<u32>>([&](u32 thread_index) {
+      check_clusters(thread_index);
+      if (jobs_pending.fetch_sub(1) == 1)
+        jobs_done.Set();
+    }));
+  }
 
-    u8 cluster_data[0x7C00];
-    if (!Read(cluster_id * sizeof(cluster_data), sizeof(cluster_data), cluster_data, partition))
+  for (; group_start < num_clusters && valid; group_start += CLUSTERS_PER_GROUP)
+  {
+    group_clusters = std::min(CLUSTERS_PER_GROUP, num_clusters - group_start);
+    if (!m_reader->Read(data_start + group_start * BLOCK_TOTAL_SIZE,
+                        group_clusters * BLOCK_TOTAL_SIZE, group.data()))
     {
-      WARN_LOG(DISCIO, "Integrity Check: fail at cluster %d: could not read data", cluster_id);
-      return false;
+      WARN_LOG(DISCIO, "Integrity Check: fail at cluster %" PRIu64 ": could not read data",
+               group_start);
+      valid = false;
+      break;
     }
 
-    for (u32 hash_id = 0; hash_id < 31; ++hash_id)
+    const u32 num_jobs = static_cast<u32>(std::min<u64>(num_threads, group_clusters));
+    if (num_jobs > 1)
     {
-      u8 hash[20];
-
-      mbedtls_sha1(cluster_data + hash_id * sizeof(cluster_metadata), sizeof(cluster_metadata),
-                   hash);
-
-      // Note that we do not use strncmp here
-      if (memcmp(hash, cluster_metadata + hash_id * sizeof(hash), sizeof(hash)))
-      {
-        WARN_LOG(DISCIO, "Integrity Check: fail at cluster %d: hash %d is invalid", cluster_id,
-                 hash_id);
-        return false;
-      }
+      jobs_pending.store(num_jobs - 1);
+      for (u32 t = 1; t < num_jobs; t++)
+        workers[t - 1]->EmplaceItem(t);
     }
+    check_clusters(0);
+    if (num_jobs > 1)
+      jobs_done.Wait();
   }
 
-  return true;
+  return valid;
 }
 
 }  // namespace
@@ -4,14 +4,17 @@
 
 #pragma once
 
+#include <array>
+#include <list>
 #include <map>
-#include <mbedtls/aes.h>
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Crypto/AES.h"
 #include "Common/Lazy.h"
 #include "Core/IOS/ES/Formats.h"
 #include "DiscIO/Filesystem.h"
@@ -71,9 +74,19 @@ protected:
   u32 GetOffsetShift() const override { return 2; }
 
 private:
+  struct DecryptedCluster
+  {
+    u64 offset_on_disc;
+    std::array<u8, BLOCK_DATA_SIZE> data;
+  };
+
+  // Returns the decrypted data of the cluster at the given offset, reading and decrypting it if
+  // it is not cached. The pointer is valid until the next call.
+  const u8* GetDecryptedCluster(u64 offset_on_disc, Common::AES::Context* aes_context) const;
+
   struct PartitionDetails
   {
-    Common::Lazy<std::unique_ptr<mbedtls_aes_context>> key;
+    Common::Lazy<std::unique_ptr<Common::AES::Context>> key;
     Common::Lazy<IOS::ES::TicketReader> ticket;
     Common::Lazy<IOS::ES::TMDReader> tmd;
     Common::Lazy<std::unique_ptr<FileSystem>> file_system;
@@ -86,8 +99,12 @@ private:
   Partition m_game_partition;
   bool m_encrypted;
 
-  mutable u64 m_last_decrypted_block;
-  mutable u8 m_last_decrypted_block_data[BLOCK_DATA_SIZE];
+  // LRU cache of decrypted clusters, most recently used first. Cluster offsets are absolute, so
+  // clusters of all partitions share the cache.
+  mutable std::list<DecryptedCluster> m_decrypted_clusters;
+  mutable std::unordered_map<u64, std::list<DecryptedCluster>::iterator> m_decrypted_cluster_map;
+  mutable std::vector<u8> m_encrypted_cluster;
+  size_t m_max_decrypted_clusters;
 };
 
 }  // namespace
@@ -0,0 +1,512 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "DiscIO/WCZBlob.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <zlib.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/AES.h"
+#include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "Common/MsgHandler.h"
+#include "Common/StringUtil.h"
+#include "Core/IOS/ES/Formats.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/ConversionPipeline.h"
+#include "DiscIO/Enums.h"
+#include "DiscIO/Volume.h"
+#include "DiscIO/VolumeWii.h"
+
+namespace DiscIO
+{
+namespace
+{
+// Large chunks compress much better than GCZ's 16 KiB blocks. Since chunks never need to be
+// aligned to clusters, this is only a trade-off between ratio and the cost of a random read.
+constexpr u32 CHUNK_SIZE = 0x200000;
+
+constexpr u64 CLUSTER_SIZE = VolumeWii::BLOCK_TOTAL_SIZE;
+constexpr u64 CLUSTER_HEADER_SIZE = VolumeWii::BLOCK_HEADER_SIZE;
+constexpr u64 CLUSTER_DATA_SIZE = VolumeWii::BLOCK_DATA_SIZE;
+
+// The IV of a cluster's data is stored in its (encrypted) header.
+constexpr u64 CLUSTER_IV_OFFSET = 0x3D0;
+
+struct CompressionJob
+{
+  std::vector<u8> in_buf;
+  std::vector<u8> out_buf;
+  u32 size;
+  u32 compressed_size;
+  bool uncompressed;
+};
+
+struct PartitionToConvert
+{
+  WCZPartitionEntry entry;
+  std::unique_ptr<Common::AES::Context> key;
+};
+
+void DecryptCluster(Common::AES::Context* key, const u8* in, u8* out)
+{
+  u8 iv[16];
+  std::memcpy(iv, in + CLUSTER_IV_OFFSET, sizeof(iv));
+  std::memcpy(out, in, CLUSTER_HEADER_SIZE);
+  key->CryptCBC(iv, in + CLUSTER_HEADER_SIZE, out + CLUSTER_HEADER_SIZE, CLUSTER_DATA_SIZE);
+}
+
+// Reads raw disc data and decrypts the partition clusters within it.
+bool ReadForStorage(BlobReader* reader, const std::vector<PartitionToConvert>& partitions,
+                    u64 offset, u64 size, u8* out_ptr, std::vector<u8>* cluster_buffer)
+{
+  if (!reader->Read(offset, size, out_ptr))
+    return false;
+
+  const u64 end = offset + size;
+  for (const PartitionToConvert& partition : partitions)
+  {
+    const u64 data_start = partition.entry.data_offset;
+    const u64 data_end = data_start + partition.entry.data_size;
+    if (data_end <= offset || data_start >= end)
+      continue;
+
+    // Clusters that straddle the edges of the range are read in full separately.
+    u64 cluster_offset =
+        data_start + (std::max(offset, data_start) - data_start) / CLUSTER_SIZE * CLUSTER_SIZE;
+    for (; cluster_offset < std::min(end, data_end); cluster_offset += CLUSTER_SIZE)
+    {
+      if (cluster_offset >= offset && cluster_offset + CLUSTER_SIZE <= end)
+      {
+        u8* cluster = out_ptr + (cluster_offset - offset);
+        DecryptCluster(partition.key.get(), cluster, cluster);
+        continue;
+      }
+
+      if (!reader->Read(cluster_offset, CLUSTER_SIZE, cluster_buffer->data()))
+        return false;
+      DecryptCluster(partition.key.get(), cluster_buffer->data(), cluster_buffer->data());
+
+      const u64 copy_start = std::max(cluster_offset, offset);
+      const u64 copy_end = std::min(cluster_offset + CLUSTER_SIZE, end);
+      std::copy_n(cluster_buffer->data() + (copy_start - cluster_offset), copy_end - copy_start,
+                  out_ptr + (copy_start - offset));
+    }
+  }
+
+  return true;
+}
+
+std::vector<PartitionToConvert> GetPartitionsToConvert(const Volume& volume, u64 disc_size)
+{
+  std::vector<PartitionToConvert> partitions;
+  if (volume.GetVolumeType() != Platform::WiiDisc || !volume.IsEncryptedAndHashed())
+    return partitions;
+
+  for (const Partition& partition : volume.GetPartitions())
+  {
+    const IOS::ES::TicketReader& ticket = volume.GetTicket(partition);
+    const std::optional<u64> data_offset =
+        volume.ReadSwappedAndShifted(partition.offset + 0x2b8, PARTITION_NONE);
+    const std::optional<u64> data_size =
+        volume.ReadSwappedAndShifted(partition.offset + 0x2bc, PARTITION_NONE);
+    if (!ticket.IsValid() || !data_offset || !data_size)
+      continue;
+
+    PartitionToConvert converted;
+    converted.entry.partition_offset = partition.offset;
+    converted.entry.data_offset = partition.offset + *data_offset;
+    if (converted.entry.data_offset >= disc_size)
+      continue;
+
+    // Only whole clusters inside the image are stored decrypted.
+    const u64 available_size = std::min(*data_size, disc_size - converted.entry.data_offset);
+    converted.entry.data_size = available_size / CLUSTER_SIZE * CLUSTER_SIZE;
+
+    const std::array<u8, 16> key = ticket.GetTitleKey();
+    converted.key = Common::AES::CreateContext(key.data(), Common::AES::Mode::Decrypt);
+    partitions.push_back(std::move(converted));
+  }
+
+  return partitions;
+}
+}  // Anonymous namespace
+
+WCZFileReader::WCZFileReader(File::IOFile file, const std::string& filename)
+    : m_file(std::move(file)), m_file_name(filename)
+{
+  m_file_size = m_file.GetSize();
+}
+
+WCZFileReader::~WCZFileReader() = default;
+
+std::unique_ptr<WCZFileReader> WCZFileReader::Create(File::IOFile file,
+                                                     const std::string& filename)
+{
+  std::unique_ptr<WCZFileReader> reader(new WCZFileReader(std::move(file), filename));
+  if (!reader->Initialize())
+    return nullptr;
+  return reader;
+}
+
+bool WCZFileReader::Initialize()
+{
+  m_file.Seek(0, SEEK_SET);
+  if (!m_file.ReadArray(&m_header, 1) || m_header.magic != WCZ_MAGIC ||
+      m_header.chunk_size == 0 ||
+      m_header.num_chunks != (m_header.data_size + m_header.chunk_size - 1) / m_header.chunk_size)
+  {
+    return false;
+  }
+
+  std::vector<WCZPartitionEntry> partition_entries(m_header.num_partitions);
+  m_chunks.resize(m_header.num_chunks);
+  if (!m_file.ReadArray(partition_entries.data(), partition_entries.size()) ||
+      !m_file.ReadArray(m_chunks.data(), m_chunks.size()))
+  {
+    return false;
+  }
+
+  m_chunk_buffer.resize(m_header.chunk_size);
+  m_cluster_buffer.resize(CLUSTER_SIZE);
+
+  for (const WCZPartitionEntry& entry : partition_entries)
+  {
+    const u64 data_end = entry.data_offset + entry.data_size;
+    if (entry.data_size % CLUSTER_SIZE != 0 || data_end < entry.data_offset ||
+        data_end > m_header.data_size)
+    {
+      return false;
+    }
+
+    // Tickets are outside of the encrypted area, so they can be read before the partitions are
+    // set up.
+    std::vector<u8> ticket_buffer(sizeof(IOS::ES::Ticket));
+    if (!ReadStored(entry.partition_offset, ticket_buffer.size(), ticket_buffer.data()))
+      return false;
+    const IOS::ES::TicketReader ticket(std::move(ticket_buffer));
+    if (!ticket.IsValid())
+      return false;
+
+    const std::array<u8, 16> key = ticket.GetTitleKey();
+    m_partitions.push_back(
+        Partition{entry, Common::AES::CreateContext(key.data(), Common::AES::Mode::Encrypt)});
+  }
+
+  return true;
+}
+
+bool WCZFileReader::LoadChunk(u64 chunk_index)
+{
+  if (m_cached_chunk == chunk_index)
+    return true;
+  m_cached_chunk = UINT64_MAX;
+
+  const WCZChunkEntry& chunk = m_chunks[chunk_index];
+  const u64 chunk_start = chunk_index * m_header.chunk_size;
+  const u64 chunk_size = std::min<u64>(m_header.chunk_size, m_header.data_size - chunk_start);
+
+  if (chunk.uncompressed && chunk.compressed_size != chunk_size)
+    return false;
+  if (!chunk.uncompressed)
+    m_compressed_buffer.resize(chunk.compressed_size);
+
+  u8* read_buffer = chunk.uncompressed ? m_chunk_buffer.data() : m_compressed_buffer.data();
+  if (!m_file.Seek(chunk.file_offset, SEEK_SET) ||
+      !m_file.ReadBytes(read_buffer, chunk.compressed_size))
+  {
+    PanicAlertT("The disc image \"%s\" is truncated, some of the data is missing.",
+                m_file_name.c_str());
+    m_file.Clear();
+    return false;
+  }
+
+  if (!chunk.uncompressed)
+  {
+    z_stream z = {};
+    z.next_in = m_compressed_buffer.data();
+    z.avail_in = chunk.compressed_size;
+    z.next_out = m_chunk_buffer.data();
+    z.avail_out = static_cast<u32>(chunk_size);
+    if (inflateInit(&z) != Z_OK)
+      return false;
+    const int status = inflate(&z, Z_FINISH);
+    inflateEnd(&z);
+    if (status != Z_STREAM_END || z.avail_out != 0)
+    {
+      PanicAlertT("The disc image \"%s\" is corrupt.", m_file_name.c_str());
+      return false;
+    }
+  }
+
+  m_cached_chunk = chunk_index;
+  return true;
+}
+
+bool WCZFileReader::ReadStored(u64 offset, u64 size, u8* out_ptr)
+{
+  if (offset + size > m_header.data_size || offset + size < offset)
+    return false;
+
+  while (size > 0)
+  {
+    const u64 chunk_index = offset / m_header.chunk_size;
+    const u64 offset_in_chunk = offset % m_header.chunk_size;
+    const u64 bytes_to_copy = std::min(size, m_header.chunk_size - offset_in_chunk);
+    if (!LoadChunk(chunk_index))
+      return false;
+
+    std::copy_n(m_chunk_buffer.data() + offset_in_chunk, bytes_to_copy, out_ptr);
+    offset += bytes_to_copy;
+    size -= bytes_to_copy;
+    out_ptr += bytes_to_copy;
+  }
+
+  return true;
+}
+
+const u8* WCZFileReader::GetEncryptedCluster(const Partition& partition, u64 cluster_offset)
+{
+  if (m_cached_cluster == cluster_offset)
+    return m_cluster_buffer.data();
+  m_cached_cluster = UINT64_MAX;
+
+  u8* cluster = m_cluster_buffer.data();
+  if (!ReadStored(cluster_offset, CLUSTER_SIZE, cluster))
+    return nullptr;
+
+  u8 iv[16];
+  std::memcpy(iv, cluster + CLUSTER_IV_OFFSET, sizeof(iv));
+  partition.key->CryptCBC(iv, cluster + CLUSTER_HEADER_SIZE, cluster + CLUSTER_HEADER_SIZE,
+                          CLUSTER_DATA_SIZE);
+
+  m_cached_cluster = cluster_offset;
+  return cluster;
+}
+
+bool WCZFileReader::Read(u64 offset, u64 size, u8* out_ptr)
+{
+  if (offset + size > m_header.data_size || offset + size < offset)
+    return false;
+
+  while (size > 0)
+  {
+    const Partition* partition = nullptr;
+    u64 bytes_to_read = size;
+    for (const Partition& p : m_partitions)
+    {
+      const u64 data_start = p.entry.data_offset;
+      if (offset >= data_start && offset < data_start + p.entry.data_size)
+        partition = &p;
+      else if (data_start > offset)
+        bytes_to_read = std::min(bytes_to_read, data_start - offset);
+    }
+
+    if (partition)
+    {
+      const u64 cluster_offset =
+          partition->entry.data_offset +
+          (offset - partition->entry.data_offset) / CLUSTER_SIZE * CLUSTER_SIZE;
+      const u64 offset_in_cluster = offset - cluster_offset;
+      bytes_to_read = std::min(size, CLUSTER_SIZE - offset_in_cluster);
+
+      const u8* cluster = GetEncryptedCluster(*partition, cluster_offset);
+      if (!cluster)
+        return false;
+      std::copy_n(cluster + offset_in_cluster, bytes_to_read, out_ptr);
+    }
+    else if (!ReadStored(offset, bytes_to_read, out_ptr))
+    {
+      return false;
+    }
+
+    offset += bytes_to_read;
+    size -= bytes_to_read;
+    out_ptr += bytes_to_read;
+  }
+
+  return true;
+}
+
+bool WCZFileReader::ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr, u64 partition_offset)
+{
+  const auto it =
+      std::find_if(m_partitions.begin(), m_partitions.end(), [partition_offset](const auto& p) {
+        return p.entry.partition_offset == partition_offset;
+      });
+  if (it == m_partitions.end())
+    return false;
+  const WCZPartitionEntry& entry = it->entry;
+
+  while (size > 0)
+  {
+    const u64 cluster_index = offset / CLUSTER_DATA_SIZE;
+    const u64 offset_in_cluster = offset % CLUSTER_DATA_SIZE;
+    const u64 bytes_to_read = std::min(size, CLUSTER_DATA_SIZE - offset_in_cluster);
+    if ((cluster_index + 1) * CLUSTER_SIZE > entry.data_size)
+      return false;
+
+    const u64 stored_offset = entry.data_offset + cluster_index * CLUSTER_SIZE +
+                              CLUSTER_HEADER_SIZE + offset_in_cluster;
+    if (!ReadStored(stored_offset, bytes_to_read, out_ptr))
+      return false;
+
+    offset += bytes_to_read;
+    size -= bytes_to_read;
+    out_ptr += bytes_to_read;
+  }
+
+  return true;
+}
+
+bool ConvertToWCZ(const std::string& infile_path, const std::string& outfile_path,
+                  CompressCB callback, void* arg)
+{
+  std::unique_ptr<BlobReader> reader = CreateBlobReader(infile_path);
+  if (!reader)
+  {
+    PanicAlertT("Failed to open the input file \"%s\".", infile_path.c_str());
+    return false;
+  }
+
+  if (reader->GetBlobType() == BlobType::WCZ)
+  {
+    PanicAlertT("\"%s\" is already compressed! Cannot compress it further.", infile_path.c_str());
+    return false;
+  }
+
+  std::vector<PartitionToConvert> partitions;
+  if (std::unique_ptr<Volume> volume = CreateVolumeFromFilename(infile_path))
+    partitions = GetPartitionsToConvert(*volume, reader->GetDataSize());
+
+  File::IOFile outfile(outfile_path, "wb");
+  if (!outfile)
+  {
+    PanicAlertT("Failed to open the output file \"%s\".\n"
+                "Check that you have permissions to write the target folder and that the media can "
+                "be written.",
+                outfile_path.c_str());
+    return false;
+  }
+
+  // Reading (and decrypting), compressing and writing are pipelined, with one zlib stream per
+  // compression thread.
+  const u32 num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  std::vector<z_stream> streams(num_threads);
+  for (u32 i = 0; i < num_threads; i++)
+  {
+    if (deflateInit(&streams[i], 9) != Z_OK)
+    {
+      for (u32 j = 0; j < i; j++)
+        deflateEnd(&streams[j]);
+      return false;
+    }
+  }
+
+  WCZHeader header;
+  header.magic = WCZ_MAGIC;
+  header.chunk_size = CHUNK_SIZE;
+  header.data_size = reader->GetDataSize();
+  header.num_partitions = static_cast<u32>(partitions.size());
+  header.num_chunks = static_cast<u32>((header.data_size + CHUNK_SIZE - 1) / CHUNK_SIZE);
+
+  std::vector<WCZChunkEntry> chunks(header.num_chunks);
+
+  // Seek past the header and the tables, which are written at the end.
+  u64 position = sizeof(WCZHeader) + sizeof(WCZPartitionEntry) * partitions.size() +
+                 sizeof(WCZChunkEntry) * chunks.size();
+  outfile.Seek(position, SEEK_SET);
+
+  std::vector<u8> cluster_buffer(CLUSTER_SIZE);
+
+  const auto read = [&](u64 i, CompressionJob* job) {
+    const u64 chunk_start = i * CHUNK_SIZE;
+    job->size = static_cast<u32>(std::min<u64>(CHUNK_SIZE, header.data_size - chunk_start));
+    job->in_buf.resize(CHUNK_SIZE);
+    if (!ReadForStorage(reader.get(), partitions, chunk_start, job->size, job->in_buf.data(),
+                        &cluster_buffer))
+    {
+      PanicAlertT("Failed to read from the input file \"%s\".", infile_path.c_str());
+      return false;
+    }
+    return true;
+  };
+
+  const auto compress = [&](CompressionJob* job, u32 worker_index) {
+    z_stream& z = streams[worker_index];
+    job->out_buf.resize(deflateBound(&z, CHUNK_SIZE));
+    deflateReset(&z);
+    z.next_in = job->in_buf.data();
+    z.avail_in = job->size;
+    z.next_out = job->out_buf.data();
+    z.avail_out = static_cast<u32>(job->out_buf.size());
+    const int status = deflate(&z, Z_FINISH);
+    job->compressed_size = static_cast<u32>(job->out_buf.size() - z.avail_out);
+    job->uncompressed = status != Z_STREAM_END || job->compressed_size >= job->size;
+  };
+
+  const auto write = [&](u64 i, CompressionJob* job) {
+    const u64 chunk_start = i * CHUNK_SIZE;
+    if (callback)
+    {
+      const int ratio = chunk_start == 0 ? 0 : static_cast<int>(100 * position / chunk_start);
+      const std::string text =
+          StringFromFormat(GetStringT("%i of %i blocks. Compression ratio %i%%").c_str(),
+                           static_cast<int>(i), header.num_chunks, ratio);
+      if (!callback(text, static_cast<float>(i) / header.num_chunks, arg))
+        return false;
+    }
+
+    WCZChunkEntry& chunk = chunks[i];
+    chunk.file_offset = position;
+    chunk.uncompressed = job->uncompressed;
+    chunk.compressed_size = chunk.uncompressed ? job->size : job->compressed_size;
+
+    if (!outfile.WriteBytes(chunk.uncompressed ? job->in_buf.data() : job->out_buf.data(),
+                            chunk.compressed_size))
+    {
+      PanicAlertT("Failed to write the output file \"%s\".\n"
+                  "Check that you have enough space available on the target drive.",
+                  outfile_path.c_str());
+      return false;
+    }
+    position += chunk.compressed_size;
+    return true;
+  };
+
+  const bool success = RunConversionPipeline<CompressionJob>(
+      header.num_chunks, num_threads, num_threads * 2, read, compress, write);
+
+  for (z_stream& z : streams)
+    deflateEnd(&z);
+
+  if (!success)
+  {
+    // Remove the incomplete output file.
+    outfile.Close();
+    File::Delete(outfile_path);
+    return false;
+  }
+
+  outfile.Seek(0, SEEK_SET);
+  outfile.WriteArray(&header, 1);
+  for (const PartitionToConvert& partition : partitions)
+    outfile.WriteArray(&partition.entry, 1);
+  outfile.WriteArray(chunks.data(), chunks.size());
+
+  if (callback)
+    callback(GetStringT("Done compressing disc image."), 1.0f, arg);
+  return true;
+}
+
+}  // namespace
@@ -0,0 +1,114 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "DiscIO/Blob.h"
+
+namespace Common
+{
+namespace AES
+{
+class Context;
+}
+}
+
+namespace DiscIO
+{
+static constexpr u32 WCZ_MAGIC = 0x315A4357;  // "WCZ1" (byteswapped to little endian)
+
+// WCZ is a chunked, zlib-compressed disc image format that stores the data of encrypted Wii
+// partitions decrypted. Encrypted data is incompressible, so this is what lets the padding and
+// repeated data inside partitions compress. Reads of partition data through ReadWiiDecrypted
+// skip AES altogether, and raw reads re-encrypt the stored data, which reproduces the original
+// disc image bit for bit.
+//
+// File structure (little-endian):
+//   WCZHeader
+//   WCZPartitionEntry[num_partitions]
+//   WCZChunkEntry[num_chunks]
+//   compressed data
+//
+// The decompressed chunks form a stream with the same layout as the original disc, except that
+// the 0x7C00 data bytes of every cluster in a partition's data area are decrypted. The 0x400
+// byte cluster headers are kept encrypted, as they hold the IVs needed for re-encryption.
+struct WCZHeader
+{
+  u32 magic;
+  u32 chunk_size;
+  u64 data_size;
+  u32 num_partitions;
+  u32 num_chunks;
+};
+
+struct WCZPartitionEntry
+{
+  // Offset of the partition header, as listed in the partition table.
+  u64 partition_offset;
+  // Absolute offset and size of the partition's encrypted cluster data.
+  u64 data_offset;
+  u64 data_size;
+};
+
+struct WCZChunkEntry
+{
+  u64 file_offset;
+  u32 compressed_size;
+  // Set if the chunk did not compress and is stored as-is.
+  u32 uncompressed;
+};
+
+class WCZFileReader : public BlobReader
+{
+public:
+  static std::unique_ptr<WCZFileReader> Create(File::IOFile file, const std::string& filename);
+  ~WCZFileReader();
+
+  BlobType GetBlobType() const override { return BlobType::WCZ; }
+  u64 GetDataSize() const override { return m_header.data_size; }
+  u64 GetRawSize() const override { return m_file_size; }
+  bool Read(u64 offset, u64 size, u8* out_ptr) override;
+
+  bool SupportsReadWiiDecrypted() const override { return !m_partitions.empty(); }
+  bool ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr, u64 partition_offset) override;
+
+private:
+  struct Partition
+  {
+    WCZPartitionEntry entry;
+    std::unique_ptr<Common::AES::Context> key;
+  };
+
+  WCZFileReader(File::IOFile file, const std::string& filename);
+
+  bool Initialize();
+
+  // Reads from the stored stream, in which partition cluster data is decrypted.
+  bool ReadStored(u64 offset, u64 size, u8* out_ptr);
+  bool LoadChunk(u64 chunk_index);
+  const u8* GetEncryptedCluster(const Partition& partition, u64 cluster_offset);
+
+  File::IOFile m_file;
+  std::string m_file_name;
+  u64 m_file_size;
+
+  WCZHeader m_header;
+  std::vector<Partition> m_partitions;
+  std::vector<WCZChunkEntry> m_chunks;
+
+  std::vector<u8> m_compressed_buffer;
+  std::vector<u8> m_chunk_buffer;
+  u64 m_cached_chunk = UINT64_MAX;
+
+  std::vector<u8> m_cluster_buffer;
+  u64 m_cached_cluster = UINT64_MAX;
+};
+
+}  // namespace
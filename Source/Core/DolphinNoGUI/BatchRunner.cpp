@@ -0,0 +1,258 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "DolphinNoGUI/BatchRunner.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+
+namespace BatchRunner
+{
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+struct Job
+{
+  std::string path;
+  std::string movie;
+  std::string frames;
+  std::string expected_hash;
+};
+
+struct Result
+{
+  bool reported = false;
+  int exit_status = 0;
+  u64 frames = 0;
+  double seconds = 0;
+  std::string hash;
+};
+
+struct RunningJob
+{
+  size_t index;
+  int report_fd;
+};
+}  // Anonymous namespace
+
+static std::optional<std::vector<Job>> ReadJobFile(const std::string& job_file)
+{
+  std::ifstream stream;
+  File::OpenFStream(stream, job_file, std::ios_base::in);
+  if (!stream.is_open())
+  {
+    fprintf(stderr, "Could not open the job file %s\n", job_file.c_str());
+    return std::nullopt;
+  }
+
+  std::vector<Job> jobs;
+  std::string line;
+  for (int line_number = 1; std::getline(stream, line); line_number++)
+  {
+    std::istringstream fields(line);
+    Job job;
+    if (!(fields >> std::quoted(job.path)) || job.path[0] == '#')
+      continue;
+
+    std::string field;
+    while (fields >> std::quoted(field))
+    {
+      const size_t separator = field.find('=');
+      const std::string key = field.substr(0, separator);
+      const std::string value = separator == std::string::npos ? "" : field.substr(separator + 1);
+      if (key == "movie")
+        job.movie = value;
+      else if (key == "frames")
+        job.frames = value;
+      else if (key == "hash")
+        job.expected_hash = value;
+      else
+      {
+        fprintf(stderr, "%s:%d: Unknown job field %s\n", job_file.c_str(), line_number,
+                field.c_str());
+        return std::nullopt;
+      }
+    }
+    jobs.push_back(std::move(job));
+  }
+  return jobs;
+}
+
+// Starts the process of a job. Its report is read from *report_fd once it has exited.
+static pid_t StartJob(const Job& job, const std::vector<std::string>& extra_args, int* report_fd)
+{
+  int fds[2];
+  if (pipe(fds) != 0)
+    return -1;
+  // Only the write end is meant for the job, so the read end must not leak into other jobs
+  fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+
+  std::vector<std::string> args = {File::GetExePath(), "--exec", job.path, "--report_fd",
+                                   std::to_string(fds[1])};
+  if (!job.movie.empty())
+  {
+    args.insert(args.end(), {"--movie", job.movie, "-C", "Dolphin.Movie.VerifyPlayback=True"});
+  }
+  if (!job.frames.empty())
+    args.insert(args.end(), {"--fifo_frames", job.frames});
+  args.insert(args.end(), extra_args.begin(), extra_args.end());
+
+  std::vector<char*> argv;
+  for (std::string& arg : args)
+    argv.push_back(arg.data());
+  argv.push_back(nullptr);
+
+  const pid_t pid = fork();
+  if (pid == 0)
+  {
+    execv(argv[0], argv.data());
+    _exit(127);
+  }
+
+  close(fds[1]);
+  if (pid < 0)
+  {
+    close(fds[0]);
+    return -1;
+  }
+  *report_fd = fds[0];
+  return pid;
+}
+
+static bool ReadReport(int fd, Result* result)
+{
+  std::string report;
+  char buffer[256];
+  ssize_t size;
+  while ((size = read(fd, buffer, sizeof(buffer))) > 0 || (size < 0 && errno == EINTR))
+  {
+    if (size > 0)
+      report.append(buffer, size);
+  }
+  close(fd);
+
+  std::istringstream fields(report);
+  return static_cast<bool>(fields >> result->frames >> result->seconds >> result->hash);
+}
+
+static std::string GetStatus(const Job& job, const Result& result)
+{
+  if (WIFSIGNALED(result.exit_status))
+    return StringFromFormat("FAILED (signal %d)", WTERMSIG(result.exit_status));
+  if (!WIFEXITED(result.exit_status) || WEXITSTATUS(result.exit_status) != 0)
+    return StringFromFormat("FAILED (exit code %d)", WEXITSTATUS(result.exit_status));
+  if (!result.reported)
+    return "FAILED (no report)";
+  if (!job.expected_hash.empty() && job.expected_hash != result.hash)
+    return "MISMATCH";
+  return "OK";
+}
+
+int Run(const std::string& job_file, int num_processes, const std::vector<std::string>& extra_args)
+{
+  const std::optional<std::vector<Job>> jobs = ReadJobFile(job_file);
+  if (!jobs)
+    return 1;
+
+  if (num_processes <= 0)
+    num_processes = std::max(1u, std::thread::hardware_concurrency());
+
+  std::vector<Result> results(jobs->size());
+  std::map<pid_t, RunningJob> running;
+  size_t next_job = 0;
+  const Clock::time_point start_time = Clock::now();
+  while (next_job < jobs->size() || !running.empty())
+  {
+    while (next_job < jobs->size() && running.size() < static_cast<size_t>(num_processes))
+    {
+      int report_fd;
+      const pid_t pid = StartJob((*jobs)[next_job], extra_args, &report_fd);
+      if (pid < 0)
+      {
+        fprintf(stderr, "Could not start the job for %s\n", (*jobs)[next_job].path.c_str());
+        results[next_job].exit_status = 127 << 8;
+      }
+      else
+      {
+        running.emplace(pid, RunningJob{next_job, report_fd});
+      }
+      next_job++;
+    }
+
+    if (running.empty())
+      continue;
+
+    int status;
+    const pid_t pid = waitpid(-1, &status, 0);
+    if (pid < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      break;
+    }
+
+    const auto it = running.find(pid);
+    if (it == running.end())
+      continue;
+
+    Result& result = results[it->second.index];
+    result.exit_status = status;
+    result.reported = ReadReport(it->second.report_fd, &result);
+    fprintf(stderr, "Finished job %zu of %zu: %s\n", it->second.index + 1, jobs->size(),
+            (*jobs)[it->second.index].path.c_str());
+    running.erase(it);
+  }
+  const double total_seconds = std::chrono::duration<double>(Clock::now() - start_time).count();
+
+  printf("%-24s %10s %10s %10s  %-40s  %s\n", "Status", "Frames", "Seconds", "FPS", "Hash", "Job");
+  size_t num_passed = 0;
+  u64 total_frames = 0;
+  for (size_t i = 0; i < jobs->size(); i++)
+  {
+    const Job& job = (*jobs)[i];
+    const Result& result = results[i];
+    const std::string status = GetStatus(job, result);
+    if (status == "OK")
+      num_passed++;
+    total_frames += result.frames;
+
+    const double fps = result.seconds > 0 ? result.frames / result.seconds : 0;
+    const std::string name = job.movie.empty() ? job.path : job.path + " " + job.movie;
+    printf("%-24s %10" PRIu64 " %10.2f %10.1f  %-40s  %s\n", status.c_str(), result.frames,
+           result.seconds, fps, result.hash.c_str(), name.c_str());
+  }
+  printf("%zu of %zu jobs passed, %" PRIu64 " frames in %.2f seconds (%.1f FPS overall)\n",
+         num_passed, jobs->size(), total_frames, total_seconds,
+         total_seconds > 0 ? total_frames / total_seconds : 0);
+
+  return num_passed == jobs->size() ? 0 : 1;
+}
+
+void WriteReport(int fd, u64 frames, double seconds, const std::string& hash)
+{
+  const std::string report =
+      StringFromFormat("%" PRIu64 " %f %s\n", frames, seconds, hash.empty() ? "-" : hash.c_str());
+  if (write(fd, report.data(), report.size()) < 0)
+  {
+  }
+  close(fd);
+}
+}  // namespace BatchRunner
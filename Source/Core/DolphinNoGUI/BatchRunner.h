@@ -0,0 +1,31 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// Runs a regression suite of movie and FIFO log jobs, each in its own dolphin-emu-nogui process.
+//
+// Each line of the job file describes one job, as whitespace-separated fields which can be
+// quoted. Empty lines and lines starting with # are ignored.
+//
+//   <game or FIFO log> [movie=<DTM file>] [frames=<first>-<end>] [hash=<expected state hash>]
+//
+// Movies are played back with Movie.VerifyPlayback enabled and report the hash of the emulated
+// state at their end. FIFO logs are played once, optionally over the given range of frames.
+// A job whose hash differs from the expected one is reported as a mismatch.
+namespace BatchRunner
+{
+// Runs the jobs, at most num_processes of them at once, and prints a report with the result and
+// throughput of each job. extra_args are passed on to every job's process.
+// Returns the exit code: 0 if all jobs succeeded.
+int Run(const std::string& job_file, int num_processes, const std::vector<std::string>& extra_args);
+
+// Called by the process of a job, to send its result back to the batch runner
+void WriteReport(int fd, u64 frames, double seconds, const std::string& hash);
+}  // namespace BatchRunner
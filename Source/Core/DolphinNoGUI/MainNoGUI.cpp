@@ -3,6 +3,8 @@
 // Refer to the license.txt file included.
 
 #include <OptionParser.h>
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
@@ -10,6 +12,7 @@
 #include <string>
 #include <thread>
 #include <unistd.h>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
@@ -22,11 +25,15 @@
 #include "Core/BootManager.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
 #include "Core/Host.h"
 #include "Core/IOS/IOS.h"
 #include "Core/IOS/STM/STM.h"
+#include "Core/Movie.h"
 #include "Core/State.h"
 
+#include "DolphinNoGUI/BatchRunner.h"
+
 #include "UICommon/CommandLineParse.h"
 #include "UICommon/UICommon.h"
 
@@ -371,9 +378,67 @@ static Platform* GetPlatform()
 int main(int argc, char* argv[])
 {
   auto parser = CommandLineParse::CreateParser(CommandLineParse::ParserOptions::OmitGUIOptions);
+  parser->add_option("--batch_jobs")
+      .action("store")
+      .metavar("<file>")
+      .help("Run the movie and FIFO log jobs listed in a file and report their results");
+  parser->add_option("--batch_processes")
+      .action("store")
+      .type("int")
+      .metavar("<count>")
+      .help("Number of batch jobs to run at once, defaults to the number of CPU threads");
+  parser->add_option("--fifo_frames")
+      .action("store")
+      .metavar("<first>-<end>")
+      .help("Only play the given range of frames of a FIFO log");
+  parser->add_option("--fifo_benchmark")
+      .action("store")
+      .metavar("<file>")
+      .help("Benchmark a FIFO log and write the time and statistics of each frame to a CSV file");
+  parser->add_option("--fifo_benchmark_loops")
+      .action("store")
+      .type("int")
+      .set_default(5)
+      .metavar("<count>")
+      .help("Number of times the FIFO log is measured, defaults to 5");
+  parser->add_option("--fifo_benchmark_warmup")
+      .action("store")
+      .type("int")
+      .set_default(1)
+      .metavar("<count>")
+      .help("Number of times the FIFO log is played before measuring, defaults to 1");
+  parser->add_option("--fifo_direct")
+      .action("store_true")
+      .help("Decode FIFO logs directly on the GPU thread, bypassing the emulated FIFO");
+  parser->add_option("--report_fd").action("store").type("int").help(optparse::SUPPRESS_HELP);
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
 
+  if (options.is_set("batch_jobs"))
+  {
+    // Each job runs in its own process, with the same user folder and settings as this one
+    std::vector<std::string> job_args;
+    if (options.is_set("user"))
+      job_args.insert(job_args.end(), {"--user", static_cast<const char*>(options.get("user"))});
+    if (options.is_set_by_user("config"))
+    {
+      for (const std::string& config : options.all("config"))
+        job_args.insert(job_args.end(), {"-C", config});
+    }
+    if (options.is_set_by_user("video_backend"))
+    {
+      job_args.insert(job_args.end(),
+                      {"-v", static_cast<const char*>(options.get("video_backend"))});
+    }
+    if (options.is_set_by_user("audio_emulation"))
+    {
+      job_args.insert(job_args.end(),
+                      {"-a", static_cast<const char*>(options.get("audio_emulation"))});
+    }
+    return BatchRunner::Run(static_cast<const char*>(options.get("batch_jobs")),
+                            static_cast<int>(options.get("batch_processes")), job_args);
+  }
+
   std::unique_ptr<BootParameters> boot;
   if (options.is_set("exec"))
   {
@@ -418,6 +483,50 @@ int main(int argc, char* argv[])
   UICommon::SetUserDirectory(user_directory);
   UICommon::Init();
 
+  // Batch jobs have to end by themselves
+  const bool report = options.is_set("report_fd");
+  if (report)
+    FifoPlayer::GetInstance().SetLoop(false);
+
+  if (options.is_set("fifo_frames"))
+  {
+    u32 first_frame, end_frame;
+    if (sscanf(static_cast<const char*>(options.get("fifo_frames")), "%u-%u", &first_frame,
+               &end_frame) != 2)
+    {
+      fprintf(stderr, "Invalid FIFO log frame range\n");
+      return 1;
+    }
+    FifoPlayer::GetInstance().SetFileLoadedCallback([first_frame, end_frame] {
+      FifoPlayer& player = FifoPlayer::GetInstance();
+      player.SetFrameRangeEnd(end_frame);
+      player.SetFrameRangeStart(first_frame);
+    });
+  }
+
+  if (options.is_set("fifo_direct"))
+    FifoPlayer::GetInstance().SetDirectMode(true);
+
+  if (options.is_set("fifo_benchmark"))
+  {
+    FifoPlayer::GetInstance().SetBenchmark(
+        static_cast<u32>(std::max(0, static_cast<int>(options.get("fifo_benchmark_warmup")))),
+        static_cast<u32>(std::max(1, static_cast<int>(options.get("fifo_benchmark_loops")))),
+        static_cast<const char*>(options.get("fifo_benchmark")));
+  }
+
+  const bool play_movie = options.is_set("movie");
+  if (play_movie && boot)
+  {
+    std::optional<std::string> savestate_path;
+    if (!Movie::PlayInput(static_cast<const char*>(options.get("movie")), &savestate_path))
+    {
+      fprintf(stderr, "Could not play the specified movie\n");
+      return 1;
+    }
+    boot->savestate_path = savestate_path;
+  }
+
   Core::SetOnStateChangedCallback([](Core::State state) {
     if (state == Core::State::Uninitialized)
       s_running.Clear();
@@ -446,8 +555,33 @@ int main(int argc, char* argv[])
     updateMainFrameEvent.Wait();
   }
 
+  const auto start_time = std::chrono::steady_clock::now();
   if (s_running.IsSet())
     platform->MainLoop();
+
+  int exit_code = 0;
+  if (report)
+  {
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    const FifoPlayer& player = FifoPlayer::GetInstance();
+    u64 frames = 0;
+    std::string hash;
+    if (play_movie)
+    {
+      frames = Movie::GetCurrentFrame();
+      hash = Movie::GetVerifiedPlaybackHash();
+      // The movie was not played to its end
+      if (hash.empty())
+        exit_code = 1;
+    }
+    else if (player.GetFile())
+    {
+      frames = player.GetCurrentFrameNum() - player.GetFrameRangeStart();
+    }
+    BatchRunner::WriteReport(static_cast<int>(options.get("report_fd")), frames, seconds, hash);
+  }
+
   Core::Stop();
 
   Core::Shutdown();
@@ -456,5 +590,5 @@ int main(int argc, char* argv[])
 
   delete platform;
 
-  return 0;
+  return exit_code;
 }
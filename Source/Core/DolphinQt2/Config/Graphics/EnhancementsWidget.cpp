@@ -81,6 +81,8 @@ void EnhancementsWidget::CreateWidgets()
       new GraphicsBool(tr("Force 24-Bit Color"), Config::GFX_ENHANCE_FORCE_TRUE_COLOR);
   m_disable_copy_filter =
       new GraphicsBool(tr("Disable Copy Filter"), Config::GFX_ENHANCE_DISABLE_COPY_FILTER);
+  m_dynamic_resolution =
+      new GraphicsBool(tr("Dynamic Resolution"), Config::GFX_DYNAMIC_RESOLUTION);
 
   enhancements_layout->addWidget(new QLabel(tr("Internal Resolution:")), 0, 0);
   enhancements_layout->addWidget(m_ir_combo, 0, 1, 1, -1);
@@ -100,6 +102,7 @@ void EnhancementsWidget::CreateWidgets()
   enhancements_layout->addWidget(m_disable_fog, 7, 0);
   enhancements_layout->addWidget(m_force_24bit_color, 7, 1);
   enhancements_layout->addWidget(m_disable_copy_filter, 8, 0);
+  enhancements_layout->addWidget(m_dynamic_resolution, 8, 1);
 
   // Stereoscopy
   auto* stereoscopy_box = new QGroupBox(tr("Stereoscopy"));
@@ -342,6 +345,12 @@ void EnhancementsWidget::AddDescriptions()
                  "effect on performance, but may result in a sharper image, and causes few "
                  "graphical issues.\n\n\nIf unsure, leave this checked.");
 
+  static const char TR_DYNAMIC_RESOLUTION_DESCRIPTION[] =
+      QT_TR_NOOP("Lowers the internal resolution while the game runs below full speed, and raises "
+                 "it back up to the selected internal resolution once it keeps up again.\nHas no "
+                 "effect with Auto or Native internal resolution.\n\nIf unsure, leave this "
+                 "unchecked.");
+
   AddDescription(m_ir_combo, TR_INTERNAL_RESOLUTION_DESCRIPTION);
   AddDescription(m_aa_combo, TR_ANTIALIAS_DESCRIPTION);
   AddDescription(m_af_combo, TR_ANISOTROPIC_FILTERING_DESCRIPTION);
@@ -353,6 +362,7 @@ void EnhancementsWidget::AddDescriptions()
   AddDescription(m_force_24bit_color, TR_FORCE_24BIT_DESCRIPTION);
   AddDescription(m_force_texture_filtering, TR_FORCE_TEXTURE_FILTERING_DESCRIPTION);
   AddDescription(m_disable_copy_filter, TR_DISABLE_COPY_FILTER_DESCRIPTION);
+  AddDescription(m_dynamic_resolution, TR_DYNAMIC_RESOLUTION_DESCRIPTION);
   AddDescription(m_3d_mode, TR_3D_MODE_DESCRIPTION);
   AddDescription(m_3d_depth, TR_3D_DEPTH_DESCRIPTION);
   AddDescription(m_3d_convergence, TR_3D_CONVERGENCE_DESCRIPTION);
@@ -41,6 +41,7 @@ private:
   QCheckBox* m_disable_fog;
   QCheckBox* m_force_24bit_color;
   QCheckBox* m_disable_copy_filter;
+  QCheckBox* m_dynamic_resolution;
 
   // Stereoscopy
   QComboBox* m_3d_mode;
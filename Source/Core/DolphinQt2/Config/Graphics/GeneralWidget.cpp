@@ -57,6 +57,8 @@ void GeneralWidget::CreateWidgets()
                          Config::GFX_ASPECT_RATIO);
   m_adapter_combo = new QComboBox;
   m_enable_vsync = new GraphicsBool(tr("V-Sync"), Config::GFX_VSYNC);
+  m_low_latency_present = new GraphicsBool(tr("Low Latency Presentation"),
+                                           Config::GFX_LOW_LATENCY_PRESENT);
   m_enable_fullscreen = new QCheckBox(tr("Use Fullscreen"));
 
   m_video_box->setLayout(m_video_layout);
@@ -75,6 +77,7 @@ void GeneralWidget::CreateWidgets()
 
   m_video_layout->addWidget(m_enable_vsync, 4, 0);
   m_video_layout->addWidget(m_enable_fullscreen, 4, 1);
+  m_video_layout->addWidget(m_low_latency_present, 5, 0);
 
   // Other
   auto* m_options_box = new QGroupBox(tr("Other"));
@@ -263,6 +266,11 @@ void GeneralWidget::AddDescriptions()
   static const char TR_VSYNC_DESCRIPTION[] =
       QT_TR_NOOP("Wait for vertical blanks in order to reduce tearing.\nDecreases performance if "
                  "emulation speed is below 100%.\n\nIf unsure, leave this unchecked.");
+  static const char TR_LOW_LATENCY_PRESENT_DESCRIPTION[] = QT_TR_NOOP(
+      "Waits for each frame to finish rendering before starting the next one, and prefers "
+      "presentation modes which show the newest frame. Reduces input latency at the cost of "
+      "performance. The measured presentation latency is shown next to the FPS.\n\nIf unsure, "
+      "leave this unchecked.");
   static const char TR_SHOW_FPS_DESCRIPTION[] =
       QT_TR_NOOP("Show the number of frames rendered per second as a measure of "
                  "emulation speed.\n\nIf unsure, leave this unchecked.");
@@ -303,6 +311,7 @@ void GeneralWidget::AddDescriptions()
   AddDescription(m_adapter_combo, TR_ADAPTER_DESCRIPTION);
   AddDescription(m_aspect_combo, TR_ASPECT_RATIO_DESCRIPTION);
   AddDescription(m_enable_vsync, TR_VSYNC_DESCRIPTION);
+  AddDescription(m_low_latency_present, TR_LOW_LATENCY_PRESENT_DESCRIPTION);
   AddDescription(m_enable_fullscreen, TR_FULLSCREEN_DESCRIPTION);
   AddDescription(m_show_fps, TR_SHOW_FPS_DESCRIPTION);
   AddDescription(m_show_ping, TR_SHOW_NETPLAY_PING_DESCRIPTION);
@@ -43,6 +43,7 @@ private:
   QComboBox* m_adapter_combo;
   QComboBox* m_aspect_combo;
   QCheckBox* m_enable_vsync;
+  QCheckBox* m_low_latency_present;
   QCheckBox* m_enable_fullscreen;
 
   // Options
@@ -292,8 +292,9 @@ void GameList::CompressISO()
   const auto original_path = file->GetFilePath();
 
   const bool compressed = (file->GetBlobType() == DiscIO::BlobType::GCZ);
+  const bool is_wii_disc = file->GetPlatform() == DiscIO::Platform::WiiDisc;
 
-  if (!compressed && file->GetPlatform() == DiscIO::Platform::WiiDisc)
+  if (!compressed && is_wii_disc)
   {
     QMessageBox wii_warning(this);
     wii_warning.setIcon(QMessageBox::Warning);
@@ -307,6 +308,10 @@ void GameList::CompressISO()
       return;
   }
 
+  QString compressed_filter = tr("Compressed GC/Wii images (*.gcz)");
+  if (is_wii_disc)
+    compressed_filter.append(QStringLiteral(";;")).append(tr("Compressed Wii images (*.wcz)"));
+
   QString dst_path = QFileDialog::getSaveFileName(
       this,
       compressed ? tr("Select where you want to save the decompressed image") :
@@ -315,8 +320,7 @@ void GameList::CompressISO()
           .dir()
           .absoluteFilePath(QString::fromStdString(file->GetGameID()))
           .append(compressed ? QStringLiteral(".gcm") : QStringLiteral(".gcz")),
-      compressed ? tr("Uncompressed GC/Wii images (*.iso *.gcm)") :
-                   tr("Compressed GC/Wii images (*.gcz)"));
+      compressed ? tr("Uncompressed GC/Wii images (*.iso *.gcm)") : compressed_filter);
 
   if (dst_path.isEmpty())
     return;
@@ -332,10 +336,14 @@ void GameList::CompressISO()
     good = DiscIO::DecompressBlobToFile(original_path, dst_path.toStdString(), &CompressCB,
                                         &progress_dialog);
   }
+  else if (is_wii_disc && dst_path.endsWith(QStringLiteral(".wcz"), Qt::CaseInsensitive))
+  {
+    good = DiscIO::ConvertToWCZ(original_path, dst_path.toStdString(), &CompressCB,
+                                &progress_dialog);
+  }
   else
   {
-    good = DiscIO::CompressFileToBlob(original_path, dst_path.toStdString(),
-                                      file->GetPlatform() == DiscIO::Platform::WiiDisc ? 1 : 0,
+    good = DiscIO::CompressFileToBlob(original_path, dst_path.toStdString(), is_wii_disc ? 1 : 0,
                                       16384, &CompressCB, &progress_dialog);
   }
 
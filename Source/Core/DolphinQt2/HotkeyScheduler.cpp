@@ -468,6 +468,9 @@ void HotkeyScheduler::Run()
 
     if (IsHotkey(HK_UNDO_SAVE_STATE))
       emit StateSaveUndo();
+
+    if (IsHotkey(HK_REWIND))
+      emit Rewind();
   }
 }
 
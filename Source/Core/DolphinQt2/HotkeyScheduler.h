@@ -40,6 +40,7 @@ signals:
   void StateSaveOldest();
   void StateLoadUndo();
   void StateSaveUndo();
+  void Rewind();
   void StartRecording();
   void ExportRecording();
   void ToggleReadOnlyMode();
@@ -87,6 +87,7 @@ private:
   void StateLoadLastSavedAt(int slot);
   void StateLoadUndo();
   void StateSaveUndo();
+  void Rewind();
   void StateSaveOldest();
   void SetStateSlot(int slot);
   void BootWiiSystemMenu();
@@ -45,7 +45,7 @@ void PathPane::BrowseDefaultGame()
 
   QString file = QDir::toNativeSeparators(QFileDialog::getOpenFileName(
       this, tr("Select a Game"), QString::fromStdString(default_iso),
-      tr("All GC/Wii files (*.elf *.dol *.gcm *.iso *.tgc *.wbfs *.ciso *.gcz *.wad);;"
+      tr("All GC/Wii files (*.elf *.dol *.gcm *.iso *.tgc *.wbfs *.ciso *.gcz *.wcz *.wad);;"
          "All Files (*)")));
   if (!file.isEmpty())
   {
@@ -39,6 +39,7 @@
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/PowerPC/Profiler.h"
+#include "Core/PowerPC/SamplingProfiler.h"
 #include "Core/PowerPC/SignatureDB/MEGASignatureDB.h"
 #include "Core/PowerPC/SignatureDB/SignatureDB.h"
 
@@ -160,6 +161,22 @@ void CCodeWindow::OnProfilerMenu(wxCommandEvent& event)
         wxExecute(OpenCommand, wxEXEC_SYNC);
     }
     break;
+  case IDM_SAMPLING_PROFILER:
+    if (GetParentMenuBar()->IsChecked(IDM_SAMPLING_PROFILER))
+      SamplingProfiler::Start();
+    else
+      SamplingProfiler::Stop();
+    break;
+  case IDM_WRITE_SAMPLING_PROFILE:
+  {
+    std::string filename = File::GetUserPath(D_DUMP_IDX) + "Debug/sampling_profile.folded";
+    File::CreateFullPath(filename);
+    if (SamplingProfiler::WriteReport(filename))
+      Parent->StatusBarMessage("Wrote the sampling profile to %s", filename.c_str());
+    else
+      Parent->StatusBarMessage("Failed to write the sampling profile to %s", filename.c_str());
+    break;
+  }
   }
 }
 
@@ -929,7 +929,7 @@ wxString FifoPlayerDlg::CreateRecordingMemSizeLabel() const
     {
       const std::vector<MemoryUpdate>& memUpdates = file->GetFrame(frameNum).memoryUpdates;
       for (const auto& memUpdate : memUpdates)
-        memBytes += memUpdate.data.size();
+        memBytes += memUpdate.dataSize;
     }
 
     return wxString::Format(_("%zu memory bytes"), memBytes);
@@ -252,6 +252,7 @@ GameListCtrl::GameListCtrl(bool disable_scanning, wxWindow* parent, const wxWind
   Bind(wxEVT_LIST_KEY_DOWN, &GameListCtrl::OnKeyPress, this);
   Bind(wxEVT_LIST_COL_BEGIN_DRAG, &GameListCtrl::OnColBeginDrag, this);
   Bind(wxEVT_LIST_COL_CLICK, &GameListCtrl::OnColumnClick, this);
+  Bind(wxEVT_LIST_ITEM_SELECTED, &GameListCtrl::OnSelectionChanged, this);
 
   Bind(wxEVT_MENU, &GameListCtrl::OnProperties, this, IDM_PROPERTIES);
   Bind(wxEVT_MENU, &GameListCtrl::OnWiki, this, IDM_GAME_WIKI);
@@ -756,6 +757,17 @@ void GameListCtrl::OnColumnClick(wxListEvent& event)
   event.Skip();
 }
 
+// Reads the shader caches of the selected games in the background, so that they boot faster
+void GameListCtrl::OnSelectionChanged(wxListEvent& event)
+{
+  event.Skip();
+
+  std::vector<std::string> game_ids;
+  for (const UICommon::GameFile* iso : GetAllSelectedISOs())
+    game_ids.push_back(iso->GetGameID());
+  m_shader_cache_warmup.SetGames(std::move(game_ids));
+}
+
 // This is used by keyboard gamelist search
 void GameListCtrl::OnKeyPress(wxListEvent& event)
 {
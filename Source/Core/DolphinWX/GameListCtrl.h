@@ -17,6 +17,7 @@
 #include "Common/Event.h"
 #include "Common/Flag.h"
 #include "UICommon/GameFileCache.h"
+#include "UICommon/ShaderCacheWarmup.h"
 
 namespace UICommon
 {
@@ -78,6 +79,7 @@ private:
   void OnColumnClick(wxListEvent& event);
   void OnColBeginDrag(wxListEvent& event);
   void OnKeyPress(wxListEvent& event);
+  void OnSelectionChanged(wxListEvent& event);
   void OnSize(wxSizeEvent& event);
   void OnProperties(wxCommandEvent& event);
   void OnWiki(wxCommandEvent& event);
@@ -119,6 +121,8 @@ private:
   std::vector<std::shared_ptr<const UICommon::GameFile>> m_shown_files;
   std::vector<std::string> m_shown_names;
 
+  UICommon::ShaderCacheWarmup m_shader_cache_warmup;
+
   int m_last_column;
   int m_last_sort;
   wxSize m_lastpos;
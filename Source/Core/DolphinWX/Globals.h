@@ -254,6 +254,8 @@ enum
   // Profiler
   IDM_PROFILE_BLOCKS,
   IDM_WRITE_PROFILE,
+  IDM_SAMPLING_PROFILER,
+  IDM_WRITE_SAMPLING_PROFILE,
   // --------------------------------------------------------------
 
   // --------------------------------------------------------------
@@ -26,10 +26,10 @@
 #include <wx/textctrl.h>
 #include <wx/utils.h>
 
-#include "Common/MD5.h"
 #include "Common/StringUtil.h"
 #include "Core/ConfigManager.h"
 #include "Core/IOS/ES/Formats.h"
+#include "DiscIO/DiscHasher.h"
 #include "DiscIO/Enums.h"
 #include "DiscIO/Volume.h"
 #include "DolphinWX/ISOProperties/ISOProperties.h"
@@ -337,9 +337,9 @@ void InfoPanel::OnComputeMD5(wxCommandEvent& WXUNUSED(event))
                                        wxPD_ELAPSED_TIME | wxPD_ESTIMATED_TIME |
                                        wxPD_REMAINING_TIME | wxPD_SMOOTH);
 
-  const auto result = MD5::MD5Sum(m_game_list_item.GetFilePath(), [&progress_dialog](int progress) {
-    return progress_dialog.Update(progress);
-  });
+  const auto result = DiscIO::ComputeMD5String(
+      m_game_list_item.GetFilePath(),
+      [&progress_dialog](int progress) { return progress_dialog.Update(progress); });
 
   if (progress_dialog.WasCancelled())
     return;
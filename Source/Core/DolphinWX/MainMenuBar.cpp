@@ -14,6 +14,7 @@
 #include "Core/IOS/ES/ES.h"
 #include "Core/IOS/ES/Formats.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PowerPC/SamplingProfiler.h"
 #include "Core/State.h"
 #include "DiscIO/Enums.h"
 #include "DolphinWX/Frame.h"
@@ -511,6 +512,11 @@ wxMenu* MainMenuBar::CreateProfilerMenu() const
   profiler_menu->AppendCheckItem(IDM_PROFILE_BLOCKS, _("&Profile Blocks"));
   profiler_menu->AppendSeparator();
   profiler_menu->Append(IDM_WRITE_PROFILE, _("&Write to profile.txt, Show"));
+  profiler_menu->AppendSeparator();
+  profiler_menu->AppendCheckItem(IDM_SAMPLING_PROFILER, _("&Sampling Profiler"));
+  profiler_menu->Append(IDM_WRITE_SAMPLING_PROFILE, _("Write Sampling Profile for &FlameGraph"));
+  profiler_menu->Enable(IDM_SAMPLING_PROFILER, SamplingProfiler::IsSupported());
+  profiler_menu->Enable(IDM_WRITE_SAMPLING_PROFILE, SamplingProfiler::IsSupported());
 
   return profiler_menu;
 }
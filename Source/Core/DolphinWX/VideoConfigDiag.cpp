@@ -136,6 +136,11 @@ static wxString ws_hack_desc = wxTRANSLATE(
 static wxString vsync_desc =
     wxTRANSLATE("Wait for vertical blanks in order to reduce tearing.\nDecreases performance if "
                 "emulation speed is below 100%.\n\nIf unsure, leave this unchecked.");
+static wxString low_latency_present_desc = wxTRANSLATE(
+    "Waits for each frame to finish rendering before starting the next one, and prefers "
+    "presentation modes which show the newest frame. Reduces input latency at the cost of "
+    "performance. The measured presentation latency is shown next to the FPS.\n\nIf unsure, "
+    "leave this unchecked.");
 static wxString af_desc = wxTRANSLATE(
     "Enable anisotropic filtering.\nEnhances visual quality of textures that are at oblique "
     "viewing angles.\nMight cause issues in a small number of games.\n\nIf unsure, select 1x.");
@@ -187,6 +192,11 @@ static wxString skip_efb_copy_to_ram_desc = wxTRANSLATE(
     "Stores EFB Copies exclusively on the GPU, bypassing system memory. Causes graphical defects "
     "in a small number of games.\n\nEnabled = EFB Copies to Texture\nDisabled = EFB Copies to RAM "
     "(and Texture)\n\nIf unsure, leave this checked.");
+static wxString defer_efb_copies_desc = wxTRANSLATE(
+    "Waits for EFB Copies to RAM only when the emulated CPU or the texture cache reads the copied "
+    "memory, instead of stalling the GPU after every copy. Improves performance in games that "
+    "make many EFB Copies to RAM. Has no effect when EFB Copies are stored to Texture only.\n\nIf "
+    "unsure, leave this checked.");
 static wxString skip_xfb_copy_to_ram_desc = wxTRANSLATE(
     "Stores XFB Copies exclusively on the GPU, bypassing system memory. Causes graphical defects "
     "in a small number of games that need to readback from memory.\n\nEnabled = XFB Copies to "
@@ -295,6 +305,11 @@ static wxString disable_copy_filter_desc =
                 "some games as \"deflickering\" or \"smoothing\". Disabling the filter has no "
                 "effect on performance, but may result in a sharper image, and causes few "
                 "graphical issues.\n\n\nIf unsure, leave this checked.");
+static wxString dynamic_resolution_desc =
+    wxTRANSLATE("Lowers the internal resolution while the game runs below full speed, and raises "
+                "it back up to the selected internal resolution once it keeps up again.\nHas no "
+                "effect with Auto or Native internal resolution.\n\nIf unsure, leave this "
+                "unchecked.");
 static wxString vertex_rounding_desc =
     wxTRANSLATE("Rounds 2D vertices to whole pixels. Fixes graphical problems in some games at "
                 "higher internal resolutions. This setting has no effect when native internal "
@@ -413,6 +428,9 @@ VideoConfigDiag::VideoConfigDiag(wxWindow* parent, const std::string& title)
           szr_display->Add(CreateCheckBoxRefBool(page_general, _("Use Fullscreen"),
                                                  wxGetTranslation(use_fullscreen_desc),
                                                  SConfig::GetInstance().bFullscreen));
+          szr_display->Add(CreateCheckBox(page_general, _("Low Latency Presentation"),
+                                          wxGetTranslation(low_latency_present_desc),
+                                          Config::GFX_LOW_LATENCY_PRESENT));
         }
       }
 
@@ -615,6 +633,9 @@ VideoConfigDiag::VideoConfigDiag(wxWindow* parent, const std::string& title)
     cb_szr->Add(CreateCheckBox(page_enh, _("Disable Copy Filter"),
                                wxGetTranslation(disable_copy_filter_desc),
                                Config::GFX_ENHANCE_DISABLE_COPY_FILTER));
+    cb_szr->Add(CreateCheckBox(page_enh, _("Dynamic Resolution"),
+                               wxGetTranslation(dynamic_resolution_desc),
+                               Config::GFX_DYNAMIC_RESOLUTION));
     szr_enh->Add(cb_szr, wxGBPosition(row, 0), wxGBSpan(1, 3));
     row += 1;
 
@@ -709,6 +730,11 @@ VideoConfigDiag::VideoConfigDiag(wxWindow* parent, const std::string& title)
                                 Config::GFX_HACK_SKIP_EFB_COPY_TO_RAM),
                  0, wxLEFT | wxRIGHT, space5);
     szr_efb->AddSpacer(space5);
+    szr_efb->Add(CreateCheckBox(page_hacks, _("Defer EFB Copies to RAM"),
+                                wxGetTranslation(defer_efb_copies_desc),
+                                Config::GFX_HACK_DEFER_EFB_COPIES),
+                 0, wxLEFT | wxRIGHT, space5);
+    szr_efb->AddSpacer(space5);
 
     szr_hacks->AddSpacer(space5);
     szr_hacks->Add(szr_efb, 0, wxEXPAND | wxLEFT | wxRIGHT, space5);
@@ -5,8 +5,10 @@
 #include "InputCommon/ControllerInterface/ControllerInterface.h"
 
 #include <algorithm>
+#include <chrono>
 
 #include "Common/Logging/Log.h"
+#include "Common/Thread.h"
 
 #ifdef CIFACE_USE_XINPUT
 #include "InputCommon/ControllerInterface/XInput/XInput.h"
@@ -131,6 +133,8 @@ void ControllerInterface::Shutdown()
   if (!m_is_init)
     return;
 
+  SetBackgroundSamplingRate(0);
+
   {
     std::lock_guard<std::mutex> lk(m_devices_mutex);
 
@@ -223,6 +227,15 @@ void ControllerInterface::RemoveDevice(std::function<bool(const ciface::Core::De
 // Update input for all devices
 //
 void ControllerInterface::UpdateInput()
+{
+  // The sampling thread keeps the devices up to date.
+  if (m_sampling_thread_running.IsSet())
+    return;
+
+  UpdateDevices();
+}
+
+void ControllerInterface::UpdateDevices()
 {
   // Don't block the UI or CPU thread (to avoid a short but noticeable frame drop)
   if (m_devices_mutex.try_lock())
@@ -233,6 +246,39 @@ void ControllerInterface::UpdateInput()
   }
 }
 
+void ControllerInterface::SetBackgroundSamplingRate(u32 rate_hz)
+{
+  if (m_sampling_thread_running.TestAndClear())
+  {
+    m_sampling_thread_stop_event.Set();
+    m_sampling_thread.join();
+  }
+
+  if (rate_hz == 0)
+    return;
+
+  m_sampling_thread_stop_event.Reset();
+  m_sampling_thread_running.Set();
+  m_sampling_thread = std::thread(&ControllerInterface::SamplingThreadFunc, this, rate_hz);
+}
+
+void ControllerInterface::SamplingThreadFunc(u32 rate_hz)
+{
+  Common::SetCurrentThreadName("Input sampling thread");
+
+  const auto interval = std::chrono::microseconds(1000000 / rate_hz);
+  auto next_sample = std::chrono::steady_clock::now();
+  while (m_sampling_thread_running.IsSet())
+  {
+    UpdateDevices();
+
+    // Samples are taken at a fixed rate. If the devices took longer than the interval to update,
+    // the next one is taken right away instead of trying to catch up.
+    next_sample = std::max(next_sample + interval, std::chrono::steady_clock::now());
+    m_sampling_thread_stop_event.WaitFor(next_sample - std::chrono::steady_clock::now());
+  }
+}
+
 //
 // RegisterDevicesChangedCallback
 //
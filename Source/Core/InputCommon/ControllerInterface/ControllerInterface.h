@@ -8,8 +8,12 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <thread>
 #include <vector>
 
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
 #include "InputCommon/ControllerInterface/Device.h"
 
 // enable disable sources
@@ -47,16 +51,27 @@ public:
   void RemoveDevice(std::function<bool(const ciface::Core::Device*)> callback);
   bool IsInit() const { return m_is_init; }
   void UpdateInput();
+  // Updates the devices rate_hz times per second on a separate thread, so that slow backends
+  // don't stall whoever needs the input. UpdateInput does nothing while this is enabled.
+  // A rate of 0 goes back to updating the devices in UpdateInput.
+  void SetBackgroundSamplingRate(u32 rate_hz);
 
   void RegisterDevicesChangedCallback(std::function<void(void)> callback);
   void InvokeDevicesChangedCallbacks() const;
 
 private:
+  void UpdateDevices();
+  void SamplingThreadFunc(u32 rate_hz);
+
   std::vector<std::function<void()>> m_devices_changed_callbacks;
   mutable std::mutex m_callbacks_mutex;
   bool m_is_init;
   std::atomic<bool> m_is_populating_devices{false};
   void* m_hwnd;
+
+  std::thread m_sampling_thread;
+  Common::Flag m_sampling_thread_running;
+  Common::Event m_sampling_thread_stop_event;
 };
 
 extern ControllerInterface g_controller_interface;
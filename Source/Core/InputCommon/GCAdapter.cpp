@@ -3,13 +3,17 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <libusb.h>
 #include <mutex>
 
 #include "Common/Event.h"
 #include "Common/Flag.h"
 #include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
 #include "Common/Thread.h"
+#include "Common/Timer.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -35,11 +39,33 @@ static u8 s_controller_type[SerialInterface::MAX_SI_CHANNELS] = {
     ControllerTypes::CONTROLLER_NONE, ControllerTypes::CONTROLLER_NONE};
 static u8 s_controller_rumble[4];
 
-static std::mutex s_mutex;
-static u8 s_controller_payload[37];
-static u8 s_controller_payload_swap[37];
-
-static std::atomic<int> s_controller_payload_size = {0};
+struct AdapterReport
+{
+  std::array<u8, 37> payload;
+  int size = 0;
+  // When the report was read, for the latency statistics
+  u64 read_time_us = 0;
+};
+
+// The input thread and Input() hand reports over through a triple buffer, so neither of them
+// ever waits for the other. Each side owns one of the reports, and they swap theirs with the
+// shared one: the input thread after reading a report, and Input() when a new one was shared.
+constexpr u32 NEW_REPORT_FLAG = 0x10;
+static std::array<AdapterReport, 3> s_reports;
+static u32 s_input_thread_report = 0;
+static u32 s_latest_report = 1;
+static std::atomic<u32> s_shared_report{2};
+
+// Time between a report being read and Input() first seeing it, over the last
+// REPORT_LATENCY_WINDOW reports. Only accessed by the thread calling Input().
+constexpr u32 REPORT_LATENCY_WINDOW = 200;
+static u64 s_report_latency_sum_us = 0;
+static u64 s_report_latency_max_us = 0;
+static u32 s_report_latency_samples = 0;
+static std::atomic<u32> s_average_report_latency_us{0};
+static std::atomic<u32> s_max_report_latency_us{0};
+// Number of reports read during the last second
+static std::atomic<u32> s_report_rate{0};
 
 static std::thread s_adapter_input_thread;
 static std::thread s_adapter_output_thread;
@@ -71,22 +97,46 @@ static u64 s_last_init = 0;
 
 static void Read()
 {
-  int payload_size = 0;
+  u32 reports_this_second = 0;
+  u64 second_start_us = Common::Timer::GetTimeUs();
   while (s_adapter_thread_running.IsSet())
   {
-    libusb_interrupt_transfer(s_handle, s_endpoint_in, s_controller_payload_swap,
-                              sizeof(s_controller_payload_swap), &payload_size, 16);
+    AdapterReport& report = s_reports[s_input_thread_report];
+    libusb_interrupt_transfer(s_handle, s_endpoint_in, report.payload.data(),
+                              static_cast<int>(report.payload.size()), &report.size, 16);
+    report.read_time_us = Common::Timer::GetTimeUs();
+
+    s_input_thread_report =
+        s_shared_report.exchange(s_input_thread_report | NEW_REPORT_FLAG) & ~NEW_REPORT_FLAG;
 
+    if (report.size != 0)
+      ++reports_this_second;
+    if (report.read_time_us - second_start_us >= 1000000)
     {
-      std::lock_guard<std::mutex> lk(s_mutex);
-      std::swap(s_controller_payload_swap, s_controller_payload);
-      s_controller_payload_size.store(payload_size);
+      s_report_rate.store(reports_this_second);
+      reports_this_second = 0;
+      second_start_us = report.read_time_us;
     }
 
     Common::YieldCPU();
   }
 }
 
+static void AddReportLatencySample(u64 latency_us)
+{
+  s_report_latency_sum_us += latency_us;
+  s_report_latency_max_us = std::max(s_report_latency_max_us, latency_us);
+  if (++s_report_latency_samples < REPORT_LATENCY_WINDOW)
+    return;
+
+  s_average_report_latency_us.store(
+      static_cast<u32>(s_report_latency_sum_us / s_report_latency_samples));
+  s_max_report_latency_us.store(static_cast<u32>(s_report_latency_max_us));
+  s_report_latency_sum_us = 0;
+  s_report_latency_max_us = 0;
+  s_report_latency_samples = 0;
+}
+
 static void Write()
 {
   int size = 0;
@@ -404,18 +454,18 @@ GCPadStatus Input(int chan)
   if (s_handle == nullptr || !s_detected)
     return {};
 
-  int payload_size = 0;
-  u8 controller_payload_copy[37];
-
+  if (s_shared_report.load() & NEW_REPORT_FLAG)
   {
-    std::lock_guard<std::mutex> lk(s_mutex);
-    std::copy(std::begin(s_controller_payload), std::end(s_controller_payload),
-              std::begin(controller_payload_copy));
-    payload_size = s_controller_payload_size.load();
+    s_latest_report = s_shared_report.exchange(s_latest_report) & ~NEW_REPORT_FLAG;
+    AddReportLatencySample(Common::Timer::GetTimeUs() - s_reports[s_latest_report].read_time_us);
   }
 
+  const AdapterReport& report = s_reports[s_latest_report];
+  const int payload_size = report.size;
+  const std::array<u8, 37>& controller_payload_copy = report.payload;
+
   GCPadStatus pad = {};
-  if (payload_size != sizeof(controller_payload_copy) ||
+  if (payload_size != static_cast<int>(controller_payload_copy.size()) ||
       controller_payload_copy[0] != LIBUSB_DT_HID)
   {
     ERROR_LOG(SERIALINTERFACE, "error reading payload (size: %d, type: %02x)", payload_size,
@@ -551,6 +601,16 @@ bool IsDetected()
   return s_detected;
 }
 
+std::string GetReportLatencyDisplay()
+{
+  if (s_handle == nullptr || !s_detected)
+    return "";
+
+  return StringFromFormat("GC Adapter: %u reports/s, latency: %.2f ms (max %.2f ms)\n",
+                          s_report_rate.load(), s_average_report_latency_us.load() / 1000.0,
+                          s_max_report_latency_us.load() / 1000.0);
+}
+
 bool IsDriverDetected()
 {
   return !s_libusb_driver_not_supported;
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <functional>
+#include <string>
 
 #include "Common/CommonTypes.h"
 
@@ -28,6 +29,9 @@ GCPadStatus Input(int chan);
 void Output(int chan, u8 rumble_command);
 bool IsDetected();
 bool IsDriverDetected();
+// Describes the rate of the adapter's reports, and the time between a report being read and the
+// emulated controllers seeing it
+std::string GetReportLatencyDisplay();
 bool DeviceConnected(int chan);
 bool UseAdapter();
 
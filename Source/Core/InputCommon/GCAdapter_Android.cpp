@@ -374,6 +374,10 @@ bool IsDetected()
 {
   return s_detected;
 }
+std::string GetReportLatencyDisplay()
+{
+  return "";
+}
 bool IsDriverDetected()
 {
   return true;
@@ -85,6 +85,10 @@ GameFile::LookupUsingConfigLanguage(const std::map<DiscIO::Language, std::string
 GameFile::GameFile(const std::string& path)
     : m_file_path(path), m_region(DiscIO::Region::Unknown), m_country(DiscIO::Country::Unknown)
 {
+  const File::FileInfo file_info(m_file_path);
+  m_file_size_on_disk = file_info.GetSize();
+  m_file_modification_time = file_info.GetModificationTime();
+
   {
     std::string name, extension;
     SplitPath(m_file_path, nullptr, &name, &extension);
@@ -141,6 +145,13 @@ bool GameFile::IsValid() const
   return true;
 }
 
+bool GameFile::IsOutdated() const
+{
+  const File::FileInfo file_info(m_file_path);
+  return file_info.GetSize() != m_file_size_on_disk ||
+         file_info.GetModificationTime() != m_file_modification_time;
+}
+
 void GameBanner::DoState(PointerWrap& p)
 {
   p.Do(buffer);
@@ -156,6 +167,8 @@ void GameFile::DoState(PointerWrap& p)
 
   p.Do(m_file_size);
   p.Do(m_volume_size);
+  p.Do(m_file_size_on_disk);
+  p.Do(m_file_modification_time);
 
   p.Do(m_short_names);
   p.Do(m_long_names);
@@ -42,6 +42,8 @@ public:
   ~GameFile() = default;
 
   bool IsValid() const;
+  // Returns true if the file on disk has changed since this GameFile was created.
+  bool IsOutdated() const;
   const std::string& GetFilePath() const { return m_file_path; }
   const std::string& GetFileName() const { return m_file_name; }
   const std::string& GetName(const Core::TitleDatabase& title_database) const;
@@ -99,6 +101,9 @@ private:
 
   u64 m_file_size{};
   u64 m_volume_size{};
+  // Used for detecting changes to the file, m_file_size isn't always the size on disk.
+  u64 m_file_size_on_disk{};
+  u64 m_file_modification_time{};
 
   std::map<DiscIO::Language, std::string> m_short_names{};
   std::map<DiscIO::Language, std::string> m_long_names{};
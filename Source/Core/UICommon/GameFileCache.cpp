@@ -5,17 +5,20 @@
 #include "UICommon/GameFileCache.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <vector>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Event.h"
 #include "Common/File.h"
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
@@ -26,13 +29,16 @@
 
 namespace UICommon
 {
-static constexpr u32 CACHE_REVISION = 11;  // Last changed in PR 7058
+// Scanning threads spend most of their time blocked on I/O, so there can be more than cores.
+static constexpr size_t SCAN_THREADS_PER_CORE = 2;
+
+static constexpr u32 CACHE_REVISION = 13;  // Last changed when adding change detection
 
 std::vector<std::string> FindAllGamePaths(const std::vector<std::string>& directories_to_scan,
                                           bool recursive_scan)
 {
   static const std::vector<std::string> search_extensions = {
-      ".gcm", ".tgc", ".iso", ".ciso", ".gcz", ".wbfs", ".wad", ".dol", ".elf"};
+      ".gcm", ".tgc", ".iso", ".ciso", ".gcz", ".wcz", ".wbfs", ".wad", ".dol", ".elf"};
 
   // TODO: We could process paths iteratively as they are found
   return Common::DoFileSearch(directories_to_scan, search_extensions, recursive_scan);
@@ -90,13 +96,15 @@ bool GameFileCache::Update(
 
   // Delete paths that aren't in game_paths from m_cached_files,
   // while simultaneously deleting paths that are in m_cached_files from game_paths.
+  // Files that have changed on disk are deleted from m_cached_files but kept in game_paths,
+  // so that they get rescanned.
   // For the sake of speed, we don't care about maintaining the order of m_cached_files.
   {
     auto it = m_cached_files.begin();
     auto end = m_cached_files.end();
     while (it != end)
     {
-      if (game_paths.erase((*it)->GetFilePath()))
+      if (!(*it)->IsOutdated() && game_paths.erase((*it)->GetFilePath()))
       {
         ++it;
       }
@@ -115,19 +123,60 @@ bool GameFileCache::Update(
 
   // Now that the previous loop has run, game_paths only contains paths that
   // aren't in m_cached_files, so we simply add all of them to m_cached_files.
-  for (const std::string& path : game_paths)
+  // Scanning a file is mostly waiting for disk I/O, so files are scanned on several threads.
+  // The callbacks are still only invoked on the calling thread, as files finish scanning.
+  const std::vector<std::string> paths_to_scan(game_paths.begin(), game_paths.end());
+  std::atomic<size_t> next_path_index{0};
+  std::mutex scanned_files_lock;
+  std::vector<std::shared_ptr<GameFile>> scanned_files;
+  Common::Event file_scanned;
+
+  const auto scan_files = [&] {
+    for (size_t i = next_path_index++; i < paths_to_scan.size(); i = next_path_index++)
+    {
+      auto file = std::make_shared<GameFile>(paths_to_scan[i]);
+      {
+        std::lock_guard<std::mutex> lk(scanned_files_lock);
+        scanned_files.push_back(std::move(file));
+      }
+      file_scanned.Set();
+    }
+  };
+
+  const size_t num_threads = std::min<size_t>(
+      std::max(std::thread::hardware_concurrency(), 1u) * SCAN_THREADS_PER_CORE,
+      paths_to_scan.size());
+  std::vector<std::thread> scan_threads;
+  for (size_t i = 0; i < num_threads; i++)
+    scan_threads.emplace_back(scan_files);
+
+  std::vector<std::shared_ptr<GameFile>> files_to_add;
+  for (size_t num_handled = 0; num_handled < paths_to_scan.size();)
   {
-    auto file = std::make_shared<GameFile>(path);
-    if (file->IsValid())
+    file_scanned.Wait();
     {
-      if (game_added_to_cache)
-        game_added_to_cache(file);
+      std::lock_guard<std::mutex> lk(scanned_files_lock);
+      files_to_add.swap(scanned_files);
+    }
+
+    for (std::shared_ptr<GameFile>& file : files_to_add)
+    {
+      if (file->IsValid())
+      {
+        if (game_added_to_cache)
+          game_added_to_cache(file);
 
-      cache_changed = true;
-      m_cached_files.push_back(std::move(file));
+        cache_changed = true;
+        m_cached_files.push_back(std::move(file));
+      }
     }
+    num_handled += files_to_add.size();
+    files_to_add.clear();
   }
 
+  for (std::thread& thread : scan_threads)
+    thread.join();
+
   return cache_changed;
 }
 
@@ -0,0 +1,183 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "UICommon/ShaderCacheWarmup.h"
+
+#include <algorithm>
+
+#include "Common/CommonPaths.h"
+#include "Common/Config/Config.h"
+#include "Common/File.h"
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+#include "Common/Thread.h"
+
+#include "Core/Config/GraphicsSettings.h"
+#include "Core/Core.h"
+
+namespace UICommon
+{
+// Reading is throttled to this rate, so that the disk stays responsive for the game list
+constexpr u64 MAX_BYTES_PER_SECOND = 32 * 1024 * 1024;
+constexpr size_t CHUNK_SIZE = 1024 * 1024;
+
+// Shader cache files are named <API>-<type>[-<game ID>]-<host config>.cache. The types which
+// aren't specific to a game are shared by all of them.
+static bool IsSharedShaderCache(const std::string& filename)
+{
+  for (const char* type : {"-uber-vs-", "-uber-ps-", "-gs-", "-Pipeline-"})
+  {
+    if (filename.find(type) != std::string::npos)
+      return true;
+  }
+  return false;
+}
+
+static std::vector<std::string> FindShaderCacheFiles()
+{
+  return Common::DoFileSearch({File::GetUserPath(D_SHADERCACHE_IDX)}, {".cache"});
+}
+
+static std::vector<std::string> FindSharedCacheFiles()
+{
+  std::vector<std::string> paths = FindShaderCacheFiles();
+  paths.erase(std::remove_if(paths.begin(), paths.end(),
+                             [](const std::string& path) {
+                               std::string filename;
+                               SplitPath(path, nullptr, &filename, nullptr);
+                               return !IsSharedShaderCache(filename);
+                             }),
+              paths.end());
+  return paths;
+}
+
+static std::vector<std::string> FindGameCacheFiles(const std::string& game_id)
+{
+  std::vector<std::string> paths;
+  for (const std::string& path :
+       {File::GetUserPath(D_CACHE_IDX) + game_id + ".uidcache",
+        File::GetUserPath(D_LOAD_IDX) + PIPELINE_UID_LISTS_DIR DIR_SEP + game_id + ".uidcache"})
+  {
+    if (File::Exists(path))
+      paths.push_back(path);
+  }
+
+  const std::string game_tag = '-' + game_id + '-';
+  for (const std::string& path : FindShaderCacheFiles())
+  {
+    std::string filename;
+    SplitPath(path, nullptr, &filename, nullptr);
+    if (filename.find(game_tag) != std::string::npos && !IsSharedShaderCache(filename))
+      paths.push_back(path);
+  }
+  return paths;
+}
+
+ShaderCacheWarmup::ShaderCacheWarmup()
+{
+  m_thread = std::thread([this] { ThreadFunc(); });
+}
+
+ShaderCacheWarmup::~ShaderCacheWarmup()
+{
+  m_exiting.Set();
+  m_wakeup.Set();
+  m_thread.join();
+}
+
+void ShaderCacheWarmup::SetGames(std::vector<std::string> game_ids)
+{
+  if (!Config::Get(Config::GFX_SHADER_CACHE))
+    game_ids.clear();
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending_games = std::move(game_ids);
+    m_generation++;
+  }
+  m_wakeup.Set();
+}
+
+bool ShaderCacheWarmup::ShouldStopReading(u64 generation) const
+{
+  if (m_exiting.IsSet() || Core::GetState() != Core::State::Uninitialized)
+    return true;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_generation != generation;
+}
+
+bool ShaderCacheWarmup::ReadFile(const std::string& path, u64 generation)
+{
+  File::IOFile file(path, "rb");
+  std::vector<u8> buffer(CHUNK_SIZE);
+  size_t read_bytes = CHUNK_SIZE;
+  while (read_bytes == CHUNK_SIZE && file.IsGood())
+  {
+    if (ShouldStopReading(generation))
+      return false;
+
+    file.ReadArray(buffer.data(), CHUNK_SIZE, &read_bytes);
+    Common::SleepCurrentThread(static_cast<int>(read_bytes * 1000 / MAX_BYTES_PER_SECOND));
+  }
+  return true;
+}
+
+void ShaderCacheWarmup::ThreadFunc()
+{
+  Common::SetCurrentThreadName("Shader cache warmup");
+  Common::SetCurrentThreadPriority(Common::ThreadPriority::Low);
+
+  while (true)
+  {
+    m_wakeup.Wait();
+    if (m_exiting.IsSet())
+      return;
+
+    std::vector<std::string> game_ids;
+    u64 generation;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      game_ids = m_pending_games;
+      generation = m_generation;
+    }
+
+    if (game_ids.empty() || ShouldStopReading(generation))
+      continue;
+
+    if (!m_read_shared_caches)
+    {
+      m_read_shared_caches = true;
+      for (const std::string& path : FindSharedCacheFiles())
+      {
+        if (!ReadFile(path, generation))
+        {
+          m_read_shared_caches = false;
+          break;
+        }
+      }
+    }
+
+    for (const std::string& game_id : game_ids)
+    {
+      if (ShouldStopReading(generation))
+        break;
+      if (game_id.empty() || m_read_games.count(game_id))
+        continue;
+
+      const std::vector<std::string> paths = FindGameCacheFiles(game_id);
+      const bool finished = std::all_of(paths.begin(), paths.end(), [&](const std::string& path) {
+        return ReadFile(path, generation);
+      });
+      if (!finished)
+        break;
+
+      m_read_games.insert(game_id);
+      INFO_LOG(COMMON, "Read %zu shader cache files of %s", paths.size(), game_id.c_str());
+    }
+  }
+}
+}  // namespace UICommon
@@ -0,0 +1,52 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
+
+namespace UICommon
+{
+// Reads the shader caches and pipeline UID caches of games on a low priority background thread
+// while the emulator is idle, e.g. for the games selected in the game list. The operating system
+// then keeps them in memory, so the video backend doesn't have to wait for the disk when it loads
+// them at boot. Reading is throttled and stops as soon as emulation starts.
+class ShaderCacheWarmup
+{
+public:
+  ShaderCacheWarmup();
+  ~ShaderCacheWarmup();
+
+  // Replaces the games whose caches are still to be read. Games which have already been read
+  // are skipped, and nothing is read if the shader cache is disabled.
+  void SetGames(std::vector<std::string> game_ids);
+
+private:
+  void ThreadFunc();
+  bool ReadFile(const std::string& path, u64 generation);
+  bool ShouldStopReading(u64 generation) const;
+
+  std::thread m_thread;
+  Common::Event m_wakeup;
+  Common::Flag m_exiting;
+
+  // Protects m_pending_games and m_generation
+  mutable std::mutex m_mutex;
+  std::vector<std::string> m_pending_games;
+  // Incremented by SetGames, to tell the thread to drop the games it is reading
+  u64 m_generation = 0;
+
+  // Only accessed by the thread
+  std::set<std::string> m_read_games;
+  bool m_read_shared_caches = false;
+};
+}  // namespace UICommon
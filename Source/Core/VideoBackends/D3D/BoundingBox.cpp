@@ -3,6 +3,10 @@
 // Refer to the license.txt file included.
 
 #include "VideoBackends/D3D/BoundingBox.h"
+
+#include <array>
+#include <cstring>
+
 #include "Common/CommonTypes.h"
 #include "Common/MsgHandler.h"
 #include "VideoCommon/VideoConfig.h"
@@ -13,6 +17,11 @@ static ID3D11Buffer* s_bbox_buffer;
 static ID3D11Buffer* s_bbox_staging_buffer;
 static ID3D11UnorderedAccessView* s_bbox_uav;
 
+// The values last read back from the GPU, which stay valid until a draw updates the bounding box.
+// All four values are read together, as games read every register in turn.
+static std::array<s32, 4> s_bbox_values;
+static bool s_bbox_values_valid;
+
 ID3D11UnorderedAccessView*& BBox::GetUAV()
 {
   return s_bbox_uav;
@@ -54,6 +63,9 @@ void BBox::Init()
     hr = D3D::device->CreateUnorderedAccessView(s_bbox_buffer, &UAVdesc, &s_bbox_uav);
     CHECK(SUCCEEDED(hr), "Create BoundingBox UAV.");
     D3D::SetDebugObjectName(s_bbox_uav, "BoundingBox UAV");
+
+    s_bbox_values = {};
+    s_bbox_values_valid = true;
   }
 }
 
@@ -68,19 +80,33 @@ void BBox::Set(int index, int value)
 {
   D3D11_BOX box{index * sizeof(s32), 0, 0, (index + 1) * sizeof(s32), 1, 1};
   D3D::context->UpdateSubresource(s_bbox_buffer, 0, &box, &value, 0, 0);
+  s_bbox_values[index] = value;
+
+  // A copy to the staging buffer may already be in flight, which doesn't include this value.
+  if (!s_bbox_values_valid)
+    D3D::context->CopyResource(s_bbox_staging_buffer, s_bbox_buffer);
 }
 
 int BBox::Get(int index)
 {
-  int data = 0;
-  D3D::context->CopyResource(s_bbox_staging_buffer, s_bbox_buffer);
-  D3D11_MAPPED_SUBRESOURCE map;
-  HRESULT hr = D3D::context->Map(s_bbox_staging_buffer, 0, D3D11_MAP_READ, 0, &map);
-  if (SUCCEEDED(hr))
+  if (!s_bbox_values_valid)
   {
-    data = ((s32*)map.pData)[index];
+    D3D11_MAPPED_SUBRESOURCE map;
+    HRESULT hr = D3D::context->Map(s_bbox_staging_buffer, 0, D3D11_MAP_READ, 0, &map);
+    if (SUCCEEDED(hr))
+    {
+      std::memcpy(s_bbox_values.data(), map.pData, sizeof(s_bbox_values));
+      D3D::context->Unmap(s_bbox_staging_buffer, 0);
+    }
+    s_bbox_values_valid = true;
   }
-  D3D::context->Unmap(s_bbox_staging_buffer, 0);
-  return data;
+
+  return s_bbox_values[index];
+}
+
+void BBox::Invalidate()
+{
+  D3D::context->CopyResource(s_bbox_staging_buffer, s_bbox_buffer);
+  s_bbox_values_valid = false;
 }
 };
@@ -16,5 +16,9 @@ public:
 
   static void Set(int index, int value);
   static int Get(int index);
+
+  // Called after a draw which may have updated the bounding box. The values are copied to the
+  // staging buffer straight away, so that a later read only has to wait for this copy.
+  static void Invalidate();
 };
 };
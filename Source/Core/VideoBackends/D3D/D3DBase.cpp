@@ -426,6 +426,30 @@ HRESULT Create(HWND wnd)
   g_Config.backend_info.bSupportsST3CTextures = SupportsS3TCTextures(device);
   g_Config.backend_info.bSupportsBPTCTextures = SupportsBPTCTextures(device);
 
+  // All rendering is recorded on the immediate context. Deferred contexts only save time when the
+  // driver builds command lists natively; otherwise the runtime just replays the calls on the
+  // immediate context, so log what the driver offers.
+  D3D11_FEATURE_DATA_THREADING threading = {};
+  if (SUCCEEDED(device->CheckFeatureSupport(D3D11_FEATURE_THREADING, &threading,
+                                            sizeof(threading))))
+  {
+    INFO_LOG(VIDEO, "D3D11 driver threading: concurrent creates %s, command lists %s",
+             threading.DriverConcurrentCreates ? "yes" : "no",
+             threading.DriverCommandLists ? "yes" : "no");
+  }
+
+  // Limit the number of frames DXGI queues up before blocking Present in low latency mode.
+  // This only takes effect when the device is created.
+  if (g_Config.bLowLatencyPresent)
+  {
+    IDXGIDevice1* dxgi_device;
+    if (SUCCEEDED(device->QueryInterface<IDXGIDevice1>(&dxgi_device)))
+    {
+      dxgi_device->SetMaximumFrameLatency(1);
+      dxgi_device->Release();
+    }
+  }
+
   // prevent DXGI from responding to Alt+Enter, unfortunately DXGI_MWA_NO_ALT_ENTER
   // does not work so we disable all monitoring of window messages. However this
   // may make it more difficult for DXGI to handle display mode changes.
@@ -4,6 +4,7 @@
 
 #include "VideoBackends/D3D/FramebufferManager.h"
 
+#include <cstring>
 #include <memory>
 #include <utility>
 
@@ -16,6 +17,7 @@
 #include "VideoBackends/D3D/PixelShaderCache.h"
 #include "VideoBackends/D3D/Render.h"
 #include "VideoBackends/D3D/VertexShaderCache.h"
+#include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
 
 namespace DX11
@@ -123,6 +125,94 @@ void FramebufferManager::BindEFBRenderTarget(bool bind_depth)
   D3D::context->OMSetRenderTargets(1, &rtv, dsv);
 }
 
+u32 FramebufferManager::PeekEFBColor(u32 x, u32 y)
+{
+  if (!m_efb.color_peek_cache_valid)
+    PopulatePeekCache(false);
+
+  return m_efb.color_peek_cache[y * EFB_WIDTH + x];
+}
+
+float FramebufferManager::PeekEFBDepth(u32 x, u32 y)
+{
+  if (!m_efb.depth_peek_cache_valid)
+    PopulatePeekCache(true);
+
+  float depth;
+  std::memcpy(&depth, &m_efb.depth_peek_cache[y * EFB_WIDTH + x], sizeof(depth));
+  return depth;
+}
+
+void FramebufferManager::UpdateEFBColorPeekCache(u32 x, u32 y, u32 rgba)
+{
+  if (m_efb.color_peek_cache_valid)
+    m_efb.color_peek_cache[y * EFB_WIDTH + x] = rgba;
+}
+
+void FramebufferManager::UpdateEFBDepthPeekCache(u32 x, u32 y, float depth)
+{
+  if (m_efb.depth_peek_cache_valid)
+    std::memcpy(&m_efb.depth_peek_cache[y * EFB_WIDTH + x], &depth, sizeof(depth));
+}
+
+void FramebufferManager::InvalidatePeekCache()
+{
+  m_efb.color_peek_cache_valid = false;
+  m_efb.depth_peek_cache_valid = false;
+}
+
+void FramebufferManager::PopulatePeekCache(bool depth)
+{
+  // Select copy and read textures depending on if we are doing a color or depth read (since they
+  // are different formats).
+  D3DTexture2D* source_tex = depth ? m_efb.depth_tex : m_efb.color_tex;
+  D3DTexture2D* read_tex = depth ? m_efb.depth_read_texture : m_efb.color_read_texture;
+  ID3D11Texture2D* staging_tex = depth ? m_efb.depth_staging_buf : m_efb.color_staging_buf;
+  std::vector<u32>& cache = depth ? m_efb.depth_peek_cache : m_efb.color_peek_cache;
+
+  // Select pixel shader (we don't want to average depth samples, instead select the minimum).
+  ID3D11PixelShader* copy_pixel_shader;
+  if (depth && g_ActiveConfig.iMultisamples > 1)
+    copy_pixel_shader = PixelShaderCache::GetDepthResolveProgram();
+  else
+    copy_pixel_shader = PixelShaderCache::GetColorCopyProgram(true);
+
+  // Scale the whole EFB down to native resolution in a single draw.
+  g_renderer->ResetAPIState();
+
+  CD3D11_VIEWPORT viewport(0.f, 0.f, static_cast<float>(EFB_WIDTH),
+                           static_cast<float>(EFB_HEIGHT));
+  D3D::context->RSSetViewports(1, &viewport);
+  D3D::context->OMSetRenderTargets(1, &read_tex->GetRTV(), nullptr);
+  D3D::SetPointCopySampler();
+
+  const D3D11_RECT source_rect = CD3D11_RECT(0, 0, m_target_width, m_target_height);
+  D3D::drawShadedTexQuad(source_tex->GetSRV(), &source_rect, m_target_width, m_target_height,
+                         copy_pixel_shader, VertexShaderCache::GetSimpleVertexShader(),
+                         VertexShaderCache::GetSimpleInputLayout());
+
+  g_renderer->RestoreAPIState();
+
+  // Copy the pixels from the renderable to cpu-readable buffer.
+  D3D::context->CopyResource(staging_tex, read_tex->GetTex());
+  D3D11_MAPPED_SUBRESOURCE map;
+  CHECK(D3D::context->Map(staging_tex, 0, D3D11_MAP_READ, 0, &map) == S_OK,
+        "Map staging buffer failed");
+
+  for (u32 row = 0; row < EFB_HEIGHT; row++)
+  {
+    std::memcpy(&cache[row * EFB_WIDTH], static_cast<const u8*>(map.pData) + row * map.RowPitch,
+                EFB_WIDTH * sizeof(u32));
+  }
+
+  D3D::context->Unmap(staging_tex, 0);
+
+  if (depth)
+    m_efb.depth_peek_cache_valid = true;
+  else
+    m_efb.color_peek_cache_valid = true;
+}
+
 FramebufferManager::FramebufferManager(int target_width, int target_height)
 {
   m_target_width = static_cast<unsigned int>(std::max(target_width, 1));
@@ -188,7 +278,8 @@ FramebufferManager::FramebufferManager(int target_width, int target_height)
   CHECK(hr == S_OK, "create EFB integer RTV(hr=%#x)", hr);
 
   // Render buffer for AccessEFB (color data)
-  texdesc = CD3D11_TEXTURE2D_DESC(DXGI_FORMAT_R8G8B8A8_UNORM, 1, 1, 1, 1, D3D11_BIND_RENDER_TARGET);
+  texdesc = CD3D11_TEXTURE2D_DESC(DXGI_FORMAT_R8G8B8A8_UNORM, EFB_WIDTH, EFB_HEIGHT, 1, 1,
+                                  D3D11_BIND_RENDER_TARGET);
   hr = D3D::device->CreateTexture2D(&texdesc, nullptr, &buf);
   CHECK(hr == S_OK, "create EFB color read texture (hr=%#x)", hr);
   m_efb.color_read_texture = new D3DTexture2D(buf, D3D11_BIND_RENDER_TARGET);
@@ -200,8 +291,8 @@ FramebufferManager::FramebufferManager(int target_width, int target_height)
       "EFB color read texture render target view (used in Renderer::AccessEFB)");
 
   // AccessEFB - Sysmem buffer used to retrieve the pixel data from depth_read_texture
-  texdesc = CD3D11_TEXTURE2D_DESC(DXGI_FORMAT_R8G8B8A8_UNORM, 1, 1, 1, 1, 0, D3D11_USAGE_STAGING,
-                                  D3D11_CPU_ACCESS_READ);
+  texdesc = CD3D11_TEXTURE2D_DESC(DXGI_FORMAT_R8G8B8A8_UNORM, EFB_WIDTH, EFB_HEIGHT, 1, 1, 0,
+                                  D3D11_USAGE_STAGING, D3D11_CPU_ACCESS_READ);
   hr = D3D::device->CreateTexture2D(&texdesc, nullptr, &m_efb.color_staging_buf);
   CHECK(hr == S_OK, "create EFB color staging buffer (hr=%#x)", hr);
   D3D::SetDebugObjectName(m_efb.color_staging_buf,
@@ -224,7 +315,8 @@ FramebufferManager::FramebufferManager(int target_width, int target_height)
   D3D::SetDebugObjectName(m_efb.depth_tex->GetSRV(), "EFB depth texture shader resource view");
 
   // Render buffer for AccessEFB (depth data)
-  texdesc = CD3D11_TEXTURE2D_DESC(DXGI_FORMAT_R32_FLOAT, 1, 1, 1, 1, D3D11_BIND_RENDER_TARGET);
+  texdesc = CD3D11_TEXTURE2D_DESC(DXGI_FORMAT_R32_FLOAT, EFB_WIDTH, EFB_HEIGHT, 1, 1,
+                                  D3D11_BIND_RENDER_TARGET);
   hr = D3D::device->CreateTexture2D(&texdesc, nullptr, &buf);
   CHECK(hr == S_OK, "create EFB depth read texture (hr=%#x)", hr);
   m_efb.depth_read_texture = new D3DTexture2D(buf, D3D11_BIND_RENDER_TARGET);
@@ -236,8 +328,8 @@ FramebufferManager::FramebufferManager(int target_width, int target_height)
       "EFB depth read texture render target view (used in Renderer::AccessEFB)");
 
   // AccessEFB - Sysmem buffer used to retrieve the pixel data from depth_read_texture
-  texdesc = CD3D11_TEXTURE2D_DESC(DXGI_FORMAT_R32_FLOAT, 1, 1, 1, 1, 0, D3D11_USAGE_STAGING,
-                                  D3D11_CPU_ACCESS_READ);
+  texdesc = CD3D11_TEXTURE2D_DESC(DXGI_FORMAT_R32_FLOAT, EFB_WIDTH, EFB_HEIGHT, 1, 1, 0,
+                                  D3D11_USAGE_STAGING, D3D11_CPU_ACCESS_READ);
   hr = D3D::device->CreateTexture2D(&texdesc, nullptr, &m_efb.depth_staging_buf);
   CHECK(hr == S_OK, "create EFB depth staging buffer (hr=%#x)", hr);
   D3D::SetDebugObjectName(m_efb.depth_staging_buf,
@@ -278,6 +370,10 @@ FramebufferManager::FramebufferManager(int target_width, int target_height)
     m_efb.resolved_color_tex = nullptr;
     m_efb.resolved_depth_tex = nullptr;
   }
+  m_efb.color_peek_cache.resize(EFB_WIDTH * EFB_HEIGHT);
+  m_efb.depth_peek_cache.resize(EFB_WIDTH * EFB_HEIGHT);
+  InvalidatePeekCache();
+
   s_integer_efb_render_target = false;
 }
 
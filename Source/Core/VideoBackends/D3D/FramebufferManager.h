@@ -7,6 +7,7 @@
 #include <d3d11.h>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "VideoBackends/D3D/D3DTexture.h"
@@ -68,7 +69,18 @@ public:
   static void SetIntegerEFBRenderTarget(bool enabled);
   static void BindEFBRenderTarget(bool bind_depth = true);
 
+  // Peeks are served from a CPU-side copy of the EFB at native resolution. The copy is read back
+  // from the GPU by the first peek after the EFB has been modified, so that a run of peeks only
+  // has to wait for the GPU once.
+  static u32 PeekEFBColor(u32 x, u32 y);
+  static float PeekEFBDepth(u32 x, u32 y);
+  static void UpdateEFBColorPeekCache(u32 x, u32 y, u32 rgba);
+  static void UpdateEFBDepthPeekCache(u32 x, u32 y, float depth);
+  static void InvalidatePeekCache();
+
 private:
+  static void PopulatePeekCache(bool depth);
+
   static struct Efb
   {
     D3DTexture2D* color_tex;
@@ -86,6 +98,11 @@ private:
     D3DTexture2D* resolved_color_tex;
     D3DTexture2D* resolved_depth_tex;
 
+    std::vector<u32> color_peek_cache;
+    std::vector<u32> depth_peek_cache;
+    bool color_peek_cache_valid;
+    bool depth_peek_cache_valid;
+
     int slices;
   } m_efb;
 
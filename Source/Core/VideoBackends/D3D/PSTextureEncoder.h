@@ -13,7 +13,6 @@
 #include "VideoCommon/VideoCommon.h"
 
 class AbstractTexture;
-class AbstractStagingTexture;
 
 struct ID3D11Texture2D;
 struct ID3D11RenderTargetView;
@@ -48,7 +47,6 @@ private:
 
   ID3D11Buffer* m_encode_params = nullptr;
   std::unique_ptr<AbstractTexture> m_encoding_render_texture;
-  std::unique_ptr<AbstractStagingTexture> m_encoding_readback_texture;
   std::map<EFBCopyParams, ID3D11PixelShader*> m_encoding_shaders;
 };
 }
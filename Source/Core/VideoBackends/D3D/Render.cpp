@@ -383,86 +383,11 @@ void Renderer::SetScissorRect(const MathUtil::Rectangle<int>& rc)
 //  - GX_PokeZMode (TODO)
 u32 Renderer::AccessEFB(EFBAccessType type, u32 x, u32 y, u32 poke_data)
 {
-  // Convert EFB dimensions to the ones of our render target
-  EFBRectangle efbPixelRc;
-  efbPixelRc.left = x;
-  efbPixelRc.top = y;
-  efbPixelRc.right = x + 1;
-  efbPixelRc.bottom = y + 1;
-  TargetRectangle targetPixelRc = Renderer::ConvertEFBRectangle(efbPixelRc);
-
-  // Take the mean of the resulting dimensions; TODO: Don't use the center pixel, compute the
-  // average color instead
-  D3D11_RECT RectToLock;
-  if (type == EFBAccessType::PeekColor || type == EFBAccessType::PeekZ)
-  {
-    RectToLock.left = (targetPixelRc.left + targetPixelRc.right) / 2;
-    RectToLock.top = (targetPixelRc.top + targetPixelRc.bottom) / 2;
-    RectToLock.right = RectToLock.left + 1;
-    RectToLock.bottom = RectToLock.top + 1;
-  }
-  else
-  {
-    RectToLock.left = targetPixelRc.left;
-    RectToLock.right = targetPixelRc.right;
-    RectToLock.top = targetPixelRc.top;
-    RectToLock.bottom = targetPixelRc.bottom;
-  }
-
-  // Reset any game specific settings.
-  ResetAPIState();
-  D3D11_VIEWPORT vp = CD3D11_VIEWPORT(0.f, 0.f, 1.f, 1.f);
-  D3D::context->RSSetViewports(1, &vp);
-  D3D::SetPointCopySampler();
-
-  // Select copy and read textures depending on if we are doing a color or depth read (since they
-  // are different formats).
-  D3DTexture2D* source_tex;
-  D3DTexture2D* read_tex;
-  ID3D11Texture2D* staging_tex;
-  if (type == EFBAccessType::PeekColor)
-  {
-    source_tex = FramebufferManager::GetEFBColorTexture();
-    read_tex = FramebufferManager::GetEFBColorReadTexture();
-    staging_tex = FramebufferManager::GetEFBColorStagingBuffer();
-  }
-  else
-  {
-    source_tex = FramebufferManager::GetEFBDepthTexture();
-    read_tex = FramebufferManager::GetEFBDepthReadTexture();
-    staging_tex = FramebufferManager::GetEFBDepthStagingBuffer();
-  }
-
-  // Select pixel shader (we don't want to average depth samples, instead select the minimum).
-  ID3D11PixelShader* copy_pixel_shader;
-  if (type == EFBAccessType::PeekZ && g_ActiveConfig.iMultisamples > 1)
-    copy_pixel_shader = PixelShaderCache::GetDepthResolveProgram();
-  else
-    copy_pixel_shader = PixelShaderCache::GetColorCopyProgram(true);
-
-  // Draw a quad to grab the texel we want to read.
-  D3D::context->OMSetRenderTargets(1, &read_tex->GetRTV(), nullptr);
-  D3D::drawShadedTexQuad(source_tex->GetSRV(), &RectToLock, Renderer::GetTargetWidth(),
-                         Renderer::GetTargetHeight(), copy_pixel_shader,
-                         VertexShaderCache::GetSimpleVertexShader(),
-                         VertexShaderCache::GetSimpleInputLayout());
-
-  // Restore expected game state.
-  RestoreAPIState();
-
-  // Copy the pixel from the renderable to cpu-readable buffer.
-  D3D11_BOX box = CD3D11_BOX(0, 0, 0, 1, 1, 1);
-  D3D::context->CopySubresourceRegion(staging_tex, 0, 0, 0, 0, read_tex->GetTex(), 0, &box);
-  D3D11_MAPPED_SUBRESOURCE map;
-  CHECK(D3D::context->Map(staging_tex, 0, D3D11_MAP_READ, 0, &map) == S_OK,
-        "Map staging buffer failed");
-
   // Convert the framebuffer data to the format the game is expecting to receive.
   u32 ret;
   if (type == EFBAccessType::PeekColor)
   {
-    u32 val;
-    memcpy(&val, map.pData, sizeof(val));
+    u32 val = FramebufferManager::PeekEFBColor(x, y);
 
     // our buffers are RGBA, yet a BGRA value is expected
     val = ((val & 0xFF00FF00) | ((val >> 16) & 0xFF) | ((val << 16) & 0xFF0000));
@@ -492,8 +417,7 @@ u32 Renderer::AccessEFB(EFBAccessType type, u32 x, u32 y, u32 poke_data)
   }
   else  // type == EFBAccessType::PeekZ
   {
-    float val;
-    memcpy(&val, map.pData, sizeof(val));
+    float val = FramebufferManager::PeekEFBDepth(x, y);
 
     // depth buffer is inverted in the d3d backend
     val = 1.0f - val;
@@ -509,7 +433,6 @@ u32 Renderer::AccessEFB(EFBAccessType type, u32 x, u32 y, u32 poke_data)
     }
   }
 
-  D3D::context->Unmap(staging_tex, 0);
   return ret;
 }
 
@@ -537,6 +460,24 @@ void Renderer::PokeEFB(EFBAccessType type, const EfbPokeData* points, size_t num
   D3D::DrawEFBPokeQuads(type, points, num_points);
 
   RestoreAPIState();
+
+  // Update the peek cache if it's valid, since we know the values of the pixels now.
+  for (size_t i = 0; i < num_points; i++)
+  {
+    const EfbPokeData& point = points[i];
+    if (type == EFBAccessType::PokeColor)
+    {
+      // Color is passed in bgra mode so we need to convert it to rgba
+      const u32 rgba =
+          (point.data & 0xFF00FF00) | ((point.data >> 16) & 0xFF) | ((point.data << 16) & 0xFF0000);
+      FramebufferManager::UpdateEFBColorPeekCache(point.x, point.y, rgba);
+    }
+    else
+    {
+      const float depth = 1.0f - (point.data & 0xFFFFFF) / 16777216.0f;
+      FramebufferManager::UpdateEFBDepthPeekCache(point.x, point.y, depth);
+    }
+  }
 }
 
 void Renderer::SetViewport(float x, float y, float width, float height, float near_depth,
@@ -588,6 +529,7 @@ void Renderer::ClearScreen(const EFBRectangle& rc, bool colorEnable, bool alphaE
   D3D::drawClearQuad(rgbaColor, 1.0f - (z & 0xFFFFFF) / 16777216.0f);
 
   RestoreAPIState();
+  FramebufferManager::InvalidatePeekCache();
 }
 
 void Renderer::ReinterpretPixelData(unsigned int convtype)
@@ -624,6 +566,7 @@ void Renderer::ReinterpretPixelData(unsigned int convtype)
 
   FramebufferManager::SwapReinterpretTexture();
   RestoreAPIState();
+  FramebufferManager::InvalidatePeekCache();
 }
 
 // This function has the final picture. We adjust the aspect ratio here.
@@ -667,7 +610,7 @@ void Renderer::SwapImpl(AbstractTexture* texture, const EFBRectangle& xfb_region
   g_texture_cache->OnConfigChanged(g_ActiveConfig);
 
   // Flip/present backbuffer to frontbuffer here
-  if (D3D::swapchain)
+  if (D3D::swapchain && !ShouldSkipPresent())
     D3D::Present();
 
   // Resize the back buffers NOW to avoid flickering
@@ -160,6 +160,10 @@ void VertexManager::vFlush()
   D3D::stateman->SetGeometryConstants(GeometryShaderCache::GetConstantBuffer());
 
   Draw(stride);
+  FramebufferManager::InvalidatePeekCache();
+
+  if (g_ActiveConfig.backend_info.bSupportsBBox && BoundingBox::active)
+    BBox::Invalidate();
 }
 
 void VertexManager::ResetBuffer(u32 stride)
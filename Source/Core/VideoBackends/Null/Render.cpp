@@ -2,7 +2,11 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <string>
+#include <utility>
+
 #include "Common/Logging/Log.h"
+#include "Common/Profiler.h"
 
 #include "VideoBackends/Null/NullTexture.h"
 #include "VideoBackends/Null/Render.h"
@@ -94,6 +98,16 @@ TargetRectangle Renderer::ConvertEFBRectangle(const EFBRectangle& rc)
 
 void Renderer::SwapImpl(AbstractTexture*, const EFBRectangle&, u64)
 {
+  // Nothing is drawn, so the timings of the VideoCommon stages go to the log instead of the
+  // screen. The table is only recomputed every few frames, so log it whenever it changed.
+  Common::Profiler::SetEnabled(g_ActiveConfig.bOverlayTimings);
+  std::string timings = Common::Profiler::ToString();
+  if (!timings.empty() && timings != m_last_timings)
+  {
+    NOTICE_LOG(VIDEO, "Frame timings:\n%s", timings.c_str());
+    m_last_timings = std::move(timings);
+  }
+
   UpdateActiveConfig();
 }
 
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <string>
+
 #include "VideoCommon/RenderBase.h"
 
 namespace Null
@@ -42,5 +44,8 @@ public:
   }
 
   void ReinterpretPixelData(unsigned int convtype) override {}
+
+private:
+  std::string m_last_timings;
 };
 }
@@ -17,6 +17,11 @@
 static GLuint s_bbox_buffer_id;
 static GLuint s_pbo;
 
+// Cached copy of the SSBO. All four values are read back at once, as games read every register
+// in turn.
+static std::array<int, 4> s_bbox_values;
+static bool s_bbox_values_valid;
+
 static std::array<int, 4> s_stencil_bounds;
 static bool s_stencil_updated;
 static bool s_stencil_cleared;
@@ -49,6 +54,8 @@ void BoundingBox::Init(int target_width, int target_height)
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, s_bbox_buffer_id);
     glBufferData(GL_SHADER_STORAGE_BUFFER, 4 * sizeof(s32), initial_values, GL_DYNAMIC_DRAW);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, s_bbox_buffer_id);
+    s_bbox_values = {};
+    s_bbox_values_valid = true;
   }
   else
   {
@@ -77,6 +84,10 @@ void BoundingBox::Set(int index, int value)
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, s_bbox_buffer_id);
     glBufferSubData(GL_SHADER_STORAGE_BUFFER, index * sizeof(int), sizeof(int), &value);
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    // If the cache is invalid, the next readback picks this value up from the buffer.
+    if (s_bbox_values_valid)
+      s_bbox_values[index] = value;
   }
   else
   {
@@ -97,28 +108,32 @@ int BoundingBox::Get(int index)
 {
   if (g_ActiveConfig.BBoxUseFragmentShaderImplementation())
   {
-    int data = 0;
+    if (s_bbox_values_valid)
+      return s_bbox_values[index];
+
+    constexpr GLsizeiptr size = sizeof(s_bbox_values);
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, s_bbox_buffer_id);
     if (!DriverDetails::HasBug(DriverDetails::BUG_SLOW_GETBUFFERSUBDATA))
     {
       // Using glMapBufferRange to read back the contents of the SSBO is extremely slow
       // on nVidia drivers. This is more noticeable at higher internal resolutions.
       // Using glGetBufferSubData instead does not seem to exhibit this slowdown.
-      glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, index * sizeof(int), sizeof(int), &data);
+      glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, size, s_bbox_values.data());
     }
     else
     {
       // Using glMapBufferRange is faster on AMD cards by a measurable margin.
-      void* ptr = glMapBufferRange(GL_SHADER_STORAGE_BUFFER, index * sizeof(int), sizeof(int),
-                                   GL_MAP_READ_BIT);
+      void* ptr = glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, size, GL_MAP_READ_BIT);
       if (ptr)
       {
-        memcpy(&data, ptr, sizeof(int));
+        memcpy(s_bbox_values.data(), ptr, size);
         glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
       }
     }
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
-    return data;
+
+    s_bbox_values_valid = true;
+    return s_bbox_values[index];
   }
   else
   {
@@ -168,6 +183,11 @@ void BoundingBox::StencilWasUpdated()
   s_stencil_cleared = false;
 }
 
+void BoundingBox::Invalidate()
+{
+  s_bbox_values_valid = false;
+}
+
 bool BoundingBox::NeedsStencilBuffer()
 {
   return g_ActiveConfig.bBBoxEnable && !g_ActiveConfig.BBoxUseFragmentShaderImplementation();
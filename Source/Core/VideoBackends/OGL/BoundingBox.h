@@ -20,6 +20,9 @@ public:
   // When the stencil buffer is changed, this function needs to be called to
   // invalidate the cached bounding box data.
   static void StencilWasUpdated();
+  // When a draw may have changed the SSBO, this function needs to be called to
+  // invalidate the cached bounding box values.
+  static void Invalidate();
 
   static void Set(int index, int value);
   static int Get(int index);
@@ -44,6 +44,11 @@ OGLPipeline::~OGLPipeline()
   ProgramShaderCache::ReleasePipelineProgram(m_program);
 }
 
+bool OGLPipeline::IsReady() const
+{
+  return ProgramShaderCache::IsPipelineProgramLinked(m_program);
+}
+
 std::unique_ptr<OGLPipeline> OGLPipeline::Create(const AbstractPipelineConfig& config)
 {
   const PipelineProgram* program = ProgramShaderCache::GetPipelineProgram(
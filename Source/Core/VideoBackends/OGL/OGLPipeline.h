@@ -29,6 +29,7 @@ public:
   const PipelineProgram* GetProgram() const { return m_program; }
   bool HasVertexInput() const { return m_vertex_format != nullptr; }
   GLenum GetGLPrimitive() const { return m_gl_primitive; }
+  bool IsReady() const override;
   static std::unique_ptr<OGLPipeline> Create(const AbstractPipelineConfig& config);
 
 private:
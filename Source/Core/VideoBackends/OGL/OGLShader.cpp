@@ -3,7 +3,11 @@
 // Refer to the license.txt file included.
 
 #include "VideoBackends/OGL/OGLShader.h"
+
+#include <utility>
+
 #include "VideoBackends/OGL/ProgramShaderCache.h"
+#include "VideoBackends/OGL/Render.h"
 
 namespace OGL
 {
@@ -24,8 +28,8 @@ static GLenum GetGLShaderTypeForStage(ShaderStage stage)
   }
 }
 
-OGLShader::OGLShader(ShaderStage stage, GLenum gl_type, GLuint shader_id)
-    : AbstractShader(stage), m_type(gl_type), m_id(shader_id)
+OGLShader::OGLShader(ShaderStage stage, GLenum gl_type, GLuint shader_id, std::string source)
+    : AbstractShader(stage), m_type(gl_type), m_id(shader_id), m_source(std::move(source))
 {
 }
 
@@ -60,6 +64,16 @@ std::unique_ptr<OGLShader> OGLShader::CreateFromSource(ShaderStage stage, const
   if (stage != ShaderStage::Compute)
   {
     GLenum shader_type = GetGLShaderTypeForStage(stage);
+
+    // Checking the result would wait for the driver's background compile. It is checked along
+    // with the first program using the shader instead, see FinishPipelineProgram().
+    if (g_ogl_config.bSupportsParallelShaderCompile)
+    {
+      std::string code(source, length);
+      GLuint shader_id = ProgramShaderCache::SubmitSingleShader(shader_type, code);
+      return std::make_unique<OGLShader>(stage, shader_type, shader_id, std::move(code));
+    }
+
     GLuint shader_id =
         ProgramShaderCache::CompileSingleShader(shader_type, std::string(source, length));
     if (!shader_id)
@@ -6,6 +6,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <string>
 
 #include "Common/CommonTypes.h"
 #include "Common/GL/GLUtil.h"
@@ -16,13 +17,16 @@ namespace OGL
 class OGLShader final : public AbstractShader
 {
 public:
-  explicit OGLShader(ShaderStage stage, GLenum gl_type, GLuint shader_id);
+  explicit OGLShader(ShaderStage stage, GLenum gl_type, GLuint shader_id,
+                     std::string source = {});
   explicit OGLShader(GLuint compute_program_id);
   ~OGLShader() override;
 
   GLenum GetGLShaderType() const { return m_type; }
   GLuint GetGLShaderID() const { return m_id; }
   GLuint GetGLComputeProgramID() const { return m_compute_program_id; }
+  // Only kept for shaders compiled in the background, whose errors are reported later.
+  const std::string& GetSource() const { return m_source; }
   bool HasBinary() const override;
   BinaryData GetBinary() const override;
 
@@ -33,6 +37,7 @@ private:
   GLenum m_type;
   GLuint m_id = 0;
   GLuint m_compute_program_id = 0;
+  std::string m_source;
 };
 
 }  // namespace OGL
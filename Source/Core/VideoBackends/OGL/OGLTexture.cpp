@@ -2,6 +2,9 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <cstdint>
+#include <cstring>
+
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
 #include "Common/GL/GLInterfaceBase.h"
@@ -10,6 +13,7 @@
 #include "VideoBackends/OGL/FramebufferManager.h"
 #include "VideoBackends/OGL/OGLTexture.h"
 #include "VideoBackends/OGL/SamplerCache.h"
+#include "VideoBackends/OGL/StreamBuffer.h"
 #include "VideoBackends/OGL/TextureCache.h"
 
 #include "VideoCommon/ImageWrite.h"
@@ -303,6 +307,20 @@ void OGLTexture::Load(u32 level, u32 width, u32 height, u32 row_length, const u8
   if (row_length != width)
     glPixelStorei(GL_UNPACK_ROW_LENGTH, row_length);
 
+  // Copy the data into the upload buffer, the GL calls below then take an offset into it.
+  StreamBuffer* upload_buffer = TextureCache::GetInstance()->GetTextureUploadBuffer();
+  const bool use_upload_buffer =
+      upload_buffer && buffer_size <= TextureCache::TEXTURE_UPLOAD_THRESHOLD;
+  if (use_upload_buffer)
+  {
+    const u32 upload_size = static_cast<u32>(buffer_size);
+    const u32 alignment = static_cast<u32>(GetTexelSizeForFormat(m_config.format));
+    auto mapping = upload_buffer->Map(upload_size, alignment);
+    std::memcpy(mapping.first, buffer, buffer_size);
+    upload_buffer->Unmap(upload_size);
+    buffer = reinterpret_cast<const u8*>(static_cast<uintptr_t>(mapping.second));
+  }
+
   GLenum gl_internal_format = GetGLInternalFormatForTextureFormat(m_config.format, false);
   if (IsCompressedFormat(m_config.format))
   {
@@ -335,6 +353,8 @@ void OGLTexture::Load(u32 level, u32 width, u32 height, u32 row_length, const u8
 
   if (row_length != width)
     glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+  if (use_upload_buffer)
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 }
 
 OGLStagingTexture::OGLStagingTexture(StagingTextureType type, const TextureConfig& config,
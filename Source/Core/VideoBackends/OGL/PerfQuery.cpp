@@ -178,6 +178,11 @@ void PerfQueryGL::FlushResults()
     FlushOne();
 }
 
+void PerfQueryGL::PollResults()
+{
+  WeakFlush();
+}
+
 PerfQueryGLESNV::PerfQueryGLESNV()
 {
   for (ActiveQuery& query : m_query_buffer)
@@ -266,4 +271,9 @@ void PerfQueryGLESNV::FlushResults()
     FlushOne();
 }
 
+void PerfQueryGLESNV::PollResults()
+{
+  WeakFlush();
+}
+
 }  // namespace
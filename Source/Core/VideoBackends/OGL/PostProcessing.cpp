@@ -35,7 +35,8 @@ OpenGLPostProcessing::OpenGLPostProcessing() : m_initialized(false)
 
 OpenGLPostProcessing::~OpenGLPostProcessing()
 {
-  m_shader.Destroy();
+  for (auto& program : m_programs)
+    program.second.shader.Destroy();
 }
 
 void OpenGLPostProcessing::BlitFromTexture(TargetRectangle src, TargetRectangle dst,
@@ -43,19 +44,22 @@ void OpenGLPostProcessing::BlitFromTexture(TargetRectangle src, TargetRectangle
                                            int layer)
 {
   ApplyShader();
+  if (!m_program)
+    return;
 
   glViewport(dst.left, dst.bottom, dst.GetWidth(), dst.GetHeight());
 
   ProgramShaderCache::BindVertexFormat(nullptr);
 
-  m_shader.Bind();
+  m_program->shader.Bind();
 
-  glUniform4f(m_uniform_resolution, (float)src_width, (float)src_height, 1.0f / (float)src_width,
-              1.0f / (float)src_height);
-  glUniform4f(m_uniform_src_rect, src.left / (float)src_width, src.top / (float)src_height,
-              src.right / (float)src_width, src.bottom / (float)src_height);
-  glUniform1ui(m_uniform_time, (GLuint)m_timer.GetTimeElapsed());
-  glUniform1i(m_uniform_layer, layer);
+  glUniform4f(m_program->uniform_resolution, (float)src_width, (float)src_height,
+              1.0f / (float)src_width, 1.0f / (float)src_height);
+  glUniform4f(m_program->uniform_src_rect, src.left / (float)src_width,
+              src.top / (float)src_height, src.right / (float)src_width,
+              src.bottom / (float)src_height);
+  glUniform1ui(m_program->uniform_time, (GLuint)m_timer.GetTimeElapsed());
+  glUniform1i(m_program->uniform_layer, layer);
 
   if (m_config.IsDirty())
   {
@@ -66,24 +70,24 @@ void OpenGLPostProcessing::BlitFromTexture(TargetRectangle src, TargetRectangle
         switch (it.second.m_type)
         {
         case PostProcessingShaderConfiguration::ConfigurationOption::OptionType::OPTION_BOOL:
-          glUniform1i(m_uniform_bindings[it.first], it.second.m_bool_value);
+          glUniform1i(m_program->uniform_bindings[it.first], it.second.m_bool_value);
           break;
         case PostProcessingShaderConfiguration::ConfigurationOption::OptionType::OPTION_INTEGER:
           switch (it.second.m_integer_values.size())
           {
           case 1:
-            glUniform1i(m_uniform_bindings[it.first], it.second.m_integer_values[0]);
+            glUniform1i(m_program->uniform_bindings[it.first], it.second.m_integer_values[0]);
             break;
           case 2:
-            glUniform2i(m_uniform_bindings[it.first], it.second.m_integer_values[0],
+            glUniform2i(m_program->uniform_bindings[it.first], it.second.m_integer_values[0],
                         it.second.m_integer_values[1]);
             break;
           case 3:
-            glUniform3i(m_uniform_bindings[it.first], it.second.m_integer_values[0],
+            glUniform3i(m_program->uniform_bindings[it.first], it.second.m_integer_values[0],
                         it.second.m_integer_values[1], it.second.m_integer_values[2]);
             break;
           case 4:
-            glUniform4i(m_uniform_bindings[it.first], it.second.m_integer_values[0],
+            glUniform4i(m_program->uniform_bindings[it.first], it.second.m_integer_values[0],
                         it.second.m_integer_values[1], it.second.m_integer_values[2],
                         it.second.m_integer_values[3]);
             break;
@@ -93,18 +97,18 @@ void OpenGLPostProcessing::BlitFromTexture(TargetRectangle src, TargetRectangle
           switch (it.second.m_float_values.size())
           {
           case 1:
-            glUniform1f(m_uniform_bindings[it.first], it.second.m_float_values[0]);
+            glUniform1f(m_program->uniform_bindings[it.first], it.second.m_float_values[0]);
             break;
           case 2:
-            glUniform2f(m_uniform_bindings[it.first], it.second.m_float_values[0],
+            glUniform2f(m_program->uniform_bindings[it.first], it.second.m_float_values[0],
                         it.second.m_float_values[1]);
             break;
           case 3:
-            glUniform3f(m_uniform_bindings[it.first], it.second.m_float_values[0],
+            glUniform3f(m_program->uniform_bindings[it.first], it.second.m_float_values[0],
                         it.second.m_float_values[1], it.second.m_float_values[2]);
             break;
           case 4:
-            glUniform4f(m_uniform_bindings[it.first], it.second.m_float_values[0],
+            glUniform4f(m_program->uniform_bindings[it.first], it.second.m_float_values[0],
                         it.second.m_float_values[1], it.second.m_float_values[2],
                         it.second.m_float_values[3]);
             break;
@@ -129,35 +133,46 @@ void OpenGLPostProcessing::ApplyShader()
   if (m_initialized && m_config.GetShader() == g_ActiveConfig.sPostProcessingShader)
     return;
 
-  m_shader.Destroy();
-  m_uniform_bindings.clear();
-
   // load shader code
   std::string main_code = m_config.LoadShader();
   std::string options_code = LoadShaderOptions();
-  std::string code = m_glsl_header + options_code + main_code;
-
-  // and compile it
-  if (!ProgramShaderCache::CompileShader(m_shader, s_vertex_shader, code))
+  m_program = GetProgram(m_glsl_header + options_code + main_code);
+  if (!m_program)
   {
     ERROR_LOG(VIDEO, "Failed to compile post-processing shader %s", m_config.GetShader().c_str());
     Config::SetCurrent(Config::GFX_ENHANCE_POST_SHADER, "");
-    code = m_config.LoadShader();
-    ProgramShaderCache::CompileShader(m_shader, s_vertex_shader, code);
+    m_program = GetProgram(m_config.LoadShader());
   }
 
+  // Reloading the configuration marked every option dirty, so a cached program gets the current
+  // option values on the next blit.
+  m_initialized = true;
+}
+
+OpenGLPostProcessing::Program* OpenGLPostProcessing::GetProgram(const std::string& code)
+{
+  auto iter = m_programs.find(code);
+  if (iter != m_programs.end())
+    return &iter->second;
+
+  Program program;
+  if (!ProgramShaderCache::CompileShader(program.shader, s_vertex_shader, code))
+    return nullptr;
+
   // read uniform locations
-  m_uniform_resolution = glGetUniformLocation(m_shader.glprogid, "resolution");
-  m_uniform_time = glGetUniformLocation(m_shader.glprogid, "time");
-  m_uniform_src_rect = glGetUniformLocation(m_shader.glprogid, "src_rect");
-  m_uniform_layer = glGetUniformLocation(m_shader.glprogid, "layer");
+  program.uniform_resolution = glGetUniformLocation(program.shader.glprogid, "resolution");
+  program.uniform_time = glGetUniformLocation(program.shader.glprogid, "time");
+  program.uniform_src_rect = glGetUniformLocation(program.shader.glprogid, "src_rect");
+  program.uniform_layer = glGetUniformLocation(program.shader.glprogid, "layer");
 
   for (const auto& it : m_config.GetOptions())
   {
     std::string glsl_name = "options." + it.first;
-    m_uniform_bindings[it.first] = glGetUniformLocation(m_shader.glprogid, glsl_name.c_str());
+    program.uniform_bindings[it.first] =
+        glGetUniformLocation(program.shader.glprogid, glsl_name.c_str());
   }
-  m_initialized = true;
+
+  return &m_programs.emplace(code, std::move(program)).first->second;
 }
 
 void OpenGLPostProcessing::CreateHeader()
@@ -234,7 +249,6 @@ void OpenGLPostProcessing::CreateHeader()
 
 std::string OpenGLPostProcessing::LoadShaderOptions()
 {
-  m_uniform_bindings.clear();
   if (m_config.GetOptions().empty())
     return "";
 
@@ -265,8 +279,6 @@ std::string OpenGLPostProcessing::LoadShaderOptions()
       else
         glsl_options += StringFromFormat("float%d %s;\n", count, it.first.c_str());
     }
-
-    m_uniform_bindings[it.first] = 0;
   }
 
   glsl_options += "};\n";
@@ -27,16 +27,25 @@ public:
   void ApplyShader();
 
 private:
+  struct Program
+  {
+    SHADER shader;
+    GLuint uniform_resolution;
+    GLuint uniform_src_rect;
+    GLuint uniform_time;
+    GLuint uniform_layer;
+    std::unordered_map<std::string, GLuint> uniform_bindings;
+  };
+
   bool m_initialized;
-  SHADER m_shader;
-  GLuint m_uniform_resolution;
-  GLuint m_uniform_src_rect;
-  GLuint m_uniform_time;
-  GLuint m_uniform_layer;
   std::string m_glsl_header;
 
-  std::unordered_map<std::string, GLuint> m_uniform_bindings;
+  // Programs are kept for the lifetime of the renderer, keyed by their source, so that switching
+  // back to a shader doesn't compile it again.
+  std::unordered_map<std::string, Program> m_programs;
+  Program* m_program = nullptr;
 
+  Program* GetProgram(const std::string& code);
   void CreateHeader();
   std::string LoadShaderOptions();
 };
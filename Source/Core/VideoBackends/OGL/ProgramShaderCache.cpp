@@ -4,6 +4,8 @@
 
 #include "VideoBackends/OGL/ProgramShaderCache.h"
 
+#include <algorithm>
+#include <array>
 #include <limits>
 #include <memory>
 #include <string>
@@ -48,6 +50,11 @@ GLuint ProgramShaderCache::s_attributeless_VAO = 0;
 GLuint ProgramShaderCache::s_last_VAO = 0;
 
 static std::unique_ptr<StreamBuffer> s_buffer;
+static u32 s_last_constants_offset = 0;
+// Buffer ranges of the pixel, vertex and geometry constants, which are bound to indices 1-3.
+static std::array<GLintptr, 3> s_constants_offsets;
+static const std::array<GLsizeiptr, 3> s_constants_sizes = {
+    sizeof(PixelShaderConstants), sizeof(VertexShaderConstants), sizeof(GeometryShaderConstants)};
 static int num_failures = 0;
 
 static GLuint CurrentProgram = 0;
@@ -227,36 +234,63 @@ void ProgramShaderCache::InvalidateConstants()
 
 void ProgramShaderCache::UploadConstants()
 {
-  if (PixelShaderManager::dirty || VertexShaderManager::dirty || GeometryShaderManager::dirty)
-  {
-    auto buffer = s_buffer->Map(s_ubo_buffer_size, s_ubo_align);
-
-    memcpy(buffer.first, &PixelShaderManager::constants, sizeof(PixelShaderConstants));
-
-    memcpy(buffer.first + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align),
-           &VertexShaderManager::constants, sizeof(VertexShaderConstants));
-
-    memcpy(buffer.first + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align) +
-               Common::AlignUp(sizeof(VertexShaderConstants), s_ubo_align),
-           &GeometryShaderManager::constants, sizeof(GeometryShaderConstants));
+  if (!PixelShaderManager::dirty && !VertexShaderManager::dirty && !GeometryShaderManager::dirty)
+    return;
 
-    s_buffer->Unmap(s_ubo_buffer_size);
-    glBindBufferRange(GL_UNIFORM_BUFFER, 1, s_buffer->m_buffer, buffer.second,
-                      sizeof(PixelShaderConstants));
-    glBindBufferRange(GL_UNIFORM_BUFFER, 2, s_buffer->m_buffer,
-                      buffer.second + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align),
-                      sizeof(VertexShaderConstants));
-    glBindBufferRange(GL_UNIFORM_BUFFER, 3, s_buffer->m_buffer,
-                      buffer.second + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align) +
-                          Common::AlignUp(sizeof(VertexShaderConstants), s_ubo_align),
-                      sizeof(GeometryShaderConstants));
+  // Only the stages whose constants have changed are uploaded. The other stages stay bound to
+  // their previous upload, which remains valid until the stream buffer wraps around, so all of
+  // the stages are uploaded again when that happens.
+  auto buffer = s_buffer->Map(s_ubo_buffer_size, s_ubo_align);
+  if (buffer.second < s_last_constants_offset)
+    InvalidateConstants();
+  s_last_constants_offset = buffer.second;
+
+  u32 used_size = 0;
+  u32 first_stage = static_cast<u32>(s_constants_offsets.size());
+  u32 last_stage = 0;
+  const auto upload_stage = [&](u32 stage, const void* data) {
+    const u32 size = static_cast<u32>(s_constants_sizes[stage]);
+    memcpy(buffer.first + used_size, data, size);
+    s_constants_offsets[stage] = buffer.second + used_size;
+    if (!g_ogl_config.bSupportsMultiBind)
+    {
+      glBindBufferRange(GL_UNIFORM_BUFFER, stage + 1, s_buffer->m_buffer,
+                        s_constants_offsets[stage], size);
+    }
+    first_stage = std::min(first_stage, stage);
+    last_stage = std::max(last_stage, stage);
+    used_size = Common::AlignUp(used_size + size, s_ubo_align);
+  };
 
+  if (PixelShaderManager::dirty)
+  {
+    upload_stage(0, &PixelShaderManager::constants);
     PixelShaderManager::dirty = false;
+  }
+  if (VertexShaderManager::dirty)
+  {
+    upload_stage(1, &VertexShaderManager::constants);
     VertexShaderManager::dirty = false;
+  }
+  if (GeometryShaderManager::dirty)
+  {
+    upload_stage(2, &GeometryShaderManager::constants);
     GeometryShaderManager::dirty = false;
+  }
 
-    ADDSTAT(stats.thisFrame.bytesUniformStreamed, s_ubo_buffer_size);
+  // Bind every uploaded stage with a single call. A clean stage in between is bound to its
+  // previous upload again, which is still valid.
+  if (g_ogl_config.bSupportsMultiBind)
+  {
+    const std::array<GLuint, 3> buffers = {s_buffer->m_buffer, s_buffer->m_buffer,
+                                           s_buffer->m_buffer};
+    glBindBuffersRange(GL_UNIFORM_BUFFER, first_stage + 1, last_stage - first_stage + 1,
+                       &buffers[first_stage], &s_constants_offsets[first_stage],
+                       &s_constants_sizes[first_stage]);
   }
+
+  s_buffer->Unmap(used_size);
+  ADDSTAT(stats.thisFrame.bytesUniformStreamed, used_size);
 }
 
 bool ProgramShaderCache::CompileShader(SHADER& shader, const std::string& vcode,
@@ -362,13 +396,7 @@ bool ProgramShaderCache::CompileComputeShader(SHADER& shader, const std::string&
 
 GLuint ProgramShaderCache::CompileSingleShader(GLenum type, const std::string& code)
 {
-  GLuint result = glCreateShader(type);
-
-  const char* src[] = {s_glsl_header.c_str(), code.c_str()};
-
-  glShaderSource(result, 2, src, nullptr);
-  glCompileShader(result);
-
+  GLuint result = SubmitSingleShader(type, code);
   if (!CheckShaderCompileResult(result, type, code))
   {
     // Don't try to use this shader
@@ -379,6 +407,17 @@ GLuint ProgramShaderCache::CompileSingleShader(GLenum type, const std::string& c
   return result;
 }
 
+GLuint ProgramShaderCache::SubmitSingleShader(GLenum type, const std::string& code)
+{
+  GLuint result = glCreateShader(type);
+
+  const char* src[] = {s_glsl_header.c_str(), code.c_str()};
+
+  glShaderSource(result, 2, src, nullptr);
+  glCompileShader(result);
+  return result;
+}
+
 bool ProgramShaderCache::CheckShaderCompileResult(GLuint id, GLenum type, const std::string& code)
 {
   GLint compileStatus;
@@ -488,6 +527,7 @@ void ProgramShaderCache::Init()
   // So multiply by four to get how many floats we have from vec4s
   // Then once more to get bytes
   s_buffer = StreamBuffer::Create(GL_UNIFORM_BUFFER, UBO_LENGTH);
+  s_last_constants_offset = 0;
 
   CreateHeader();
   CreateAttributelessVAO();
@@ -594,7 +634,12 @@ const PipelineProgram* ProgramShaderCache::GetPipelineProgram(const GLVertexForm
   if (!s_is_shared_context && vao != s_last_VAO)
     glBindVertexArray(s_last_VAO);
 
-  if (!ProgramShaderCache::CheckProgramLinkResult(prog->shader.glprogid, {}, {}, {}))
+  // Checking the result would wait for the driver to finish linking in the background.
+  if (g_ogl_config.bSupportsParallelShaderCompile)
+  {
+    prog->linking = true;
+  }
+  else if (!ProgramShaderCache::CheckProgramLinkResult(prog->shader.glprogid, {}, {}, {}))
   {
     prog->shader.Destroy();
     return nullptr;
@@ -613,7 +658,8 @@ const PipelineProgram* ProgramShaderCache::GetPipelineProgram(const GLVertexForm
 
   // Set program variables on the shader which will be returned.
   // This is only needed for drivers which don't support binding layout.
-  prog->shader.SetProgramVariables();
+  if (!prog->linking)
+    prog->shader.SetProgramVariables();
 
   // If this is a shared context, ensure we sync before we return the program to
   // the main thread. If we don't do this, some driver can lock up (e.g. AMD).
@@ -636,6 +682,53 @@ void ProgramShaderCache::ReleasePipelineProgram(const PipelineProgram* prog)
   }
 }
 
+bool ProgramShaderCache::IsPipelineProgramLinked(const PipelineProgram* prog)
+{
+  if (!prog->linking)
+    return true;
+
+  GLint completed = GL_FALSE;
+  glGetProgramiv(prog->shader.glprogid, GL_COMPLETION_STATUS_KHR, &completed);
+  return completed == GL_TRUE;
+}
+
+void ProgramShaderCache::FinishPipelineProgram(const PipelineProgram* prog)
+{
+  if (!prog->linking)
+    return;
+
+  std::lock_guard<std::mutex> guard(s_pipeline_program_lock);
+  PipelineProgram* program = s_pipeline_programs.at(prog->key).get();
+  program->linking = false;
+
+  // The shaders weren't checked when they were compiled, so a failed one is reported here, with
+  // its source. A failure to link them is only reported if they compiled.
+  GLint link_status = GL_FALSE;
+  glGetProgramiv(program->shader.glprogid, GL_LINK_STATUS, &link_status);
+  bool result = true;
+  if (link_status != GL_TRUE)
+  {
+    for (const OGLShader* shader :
+         {program->key.vertex_shader, program->key.geometry_shader, program->key.pixel_shader})
+    {
+      if (shader)
+      {
+        result &= CheckShaderCompileResult(shader->GetGLShaderID(), shader->GetGLShaderType(),
+                                           shader->GetSource());
+      }
+    }
+  }
+
+  if (!result || !CheckProgramLinkResult(program->shader.glprogid, {}, {}, {}))
+  {
+    // Don't try to use this program
+    program->shader.Destroy();
+    return;
+  }
+
+  program->shader.SetProgramVariables();
+}
+
 void ProgramShaderCache::CreateHeader()
 {
   GlslVersion v = g_ogl_config.eSupportedGLSLVersion;
@@ -702,6 +795,12 @@ void ProgramShaderCache::CreateHeader()
     break;
   }
 
+  std::string vs_layer_string;
+  if (GLExtensions::Supports("GL_ARB_shader_viewport_layer_array"))
+    vs_layer_string = "#extension GL_ARB_shader_viewport_layer_array : enable";
+  else if (GLExtensions::Supports("GL_AMD_vertex_shader_layer"))
+    vs_layer_string = "#extension GL_AMD_vertex_shader_layer : enable";
+
   s_glsl_header = StringFromFormat(
       "%s\n"
       "%s\n"  // ubo
@@ -720,6 +819,7 @@ void ProgramShaderCache::CreateHeader()
       "%s\n"  // ES dual source blend
       "%s\n"  // shader image load store
       "%s\n"  // shader framebuffer fetch
+      "%s\n"  // vertex shader layer output
 
       // Precision defines for GLSL ES
       "%s\n"
@@ -794,7 +894,8 @@ void ProgramShaderCache::CreateHeader()
               ((!is_glsles && v < Glsl430) || (is_glsles && v < GlslEs310)) ?
           "#extension GL_ARB_shader_image_load_store : enable" :
           "",
-      framebuffer_fetch_string.c_str(), is_glsles ? "precision highp float;" : "",
+      framebuffer_fetch_string.c_str(), vs_layer_string.c_str(),
+      is_glsles ? "precision highp float;" : "",
       is_glsles ? "precision highp int;" : "", is_glsles ? "precision highp sampler2DArray;" : "",
       (is_glsles && g_ActiveConfig.backend_info.bSupportsPaletteConversion) ?
           "precision highp usamplerBuffer;" :
@@ -63,6 +63,8 @@ struct PipelineProgram
   PipelineProgramKey key;
   SHADER shader;
   std::atomic_size_t reference_count{1};
+  // Set while the driver links the program in the background, until the result is checked.
+  bool linking = false;
 };
 
 class ProgramShaderCache
@@ -76,6 +78,8 @@ public:
                             const std::string& gcode = "");
   static bool CompileComputeShader(SHADER& shader, const std::string& code);
   static GLuint CompileSingleShader(GLenum type, const std::string& code);
+  // Starts compiling a shader without checking the result, for parallel shader compilation.
+  static GLuint SubmitSingleShader(GLenum type, const std::string& code);
   static bool CheckShaderCompileResult(GLuint id, GLenum type, const std::string& code);
   static bool CheckProgramLinkResult(GLuint id, const std::string& vcode, const std::string& pcode,
                                      const std::string& gcode);
@@ -93,6 +97,11 @@ public:
                                                    const OGLShader* geometry_shader,
                                                    const OGLShader* pixel_shader);
   static void ReleasePipelineProgram(const PipelineProgram* prog);
+  // With parallel shader compilation, returns false while the program is still linking.
+  static bool IsPipelineProgramLinked(const PipelineProgram* prog);
+  // Checks the result of a program linked in the background, waiting for it if needed. Must be
+  // called before the program is used.
+  static void FinishPipelineProgram(const PipelineProgram* prog);
 
 private:
   typedef std::unordered_map<PipelineProgramKey, std::unique_ptr<PipelineProgram>,
@@ -442,6 +442,9 @@ Renderer::Renderer()
   g_Config.backend_info.bSupportsFragmentStoresAndAtomics =
       GLExtensions::Supports("GL_ARB_shader_storage_buffer_object");
   g_Config.backend_info.bSupportsGSInstancing = GLExtensions::Supports("GL_ARB_gpu_shader5");
+  g_Config.backend_info.bSupportsVSLayerOutput =
+      GLExtensions::Supports("GL_ARB_shader_viewport_layer_array") ||
+      GLExtensions::Supports("GL_AMD_vertex_shader_layer");
   g_Config.backend_info.bSupportsSSAA = GLExtensions::Supports("GL_ARB_gpu_shader5") &&
                                         GLExtensions::Supports("GL_ARB_sample_shading");
   g_Config.backend_info.bSupportsGeometryShaders =
@@ -481,7 +484,13 @@ Renderer::Renderer()
                                        GLExtensions::Supports("GL_OES_draw_elements_base_vertex");
   g_ogl_config.bSupportsGLBufferStorage = GLExtensions::Supports("GL_ARB_buffer_storage") ||
                                           GLExtensions::Supports("GL_EXT_buffer_storage");
+  // glBindTextures is only loaded as part of OpenGL 4.4.
+  g_ogl_config.bSupportsMultiBind = GLInterface->GetMode() == GLInterfaceMode::MODE_OPENGL &&
+                                    GLExtensions::Version() >= 440;
   g_ogl_config.bSupportsMSAA = GLExtensions::Supports("GL_ARB_texture_multisample");
+  g_ogl_config.bSupportsParallelShaderCompile =
+      GLExtensions::Supports("GL_KHR_parallel_shader_compile") ||
+      GLExtensions::Supports("GL_ARB_parallel_shader_compile");
   g_ogl_config.bSupportViewportFloat = GLExtensions::Supports("GL_ARB_viewport_array");
   g_ogl_config.bSupportsDebug =
       GLExtensions::Supports("GL_KHR_debug") || GLExtensions::Supports("GL_ARB_debug_output");
@@ -675,9 +684,20 @@ Renderer::Renderer()
       g_Config.backend_info.bSupportsPaletteConversion &&
       g_Config.backend_info.bSupportsComputeShaders && g_ogl_config.bSupportsImageLoadStore;
 
-  // Background compiling is supported only when shared contexts aren't broken.
-  g_Config.backend_info.bSupportsBackgroundCompiling =
-      !DriverDetails::HasBug(DriverDetails::BUG_SHARED_CONTEXT_SHADER_COMPILATION);
+  if (g_ogl_config.bSupportsParallelShaderCompile)
+  {
+    // The driver compiles and links in the background itself, without the shared contexts many
+    // drivers handle poorly. Shaders are submitted on the GPU thread, and pipelines are polled
+    // until they are ready, so the compiler threads aren't used.
+    glMaxShaderCompilerThreads(0xFFFFFFFF);
+    g_Config.backend_info.bSupportsBackgroundCompiling = false;
+  }
+  else
+  {
+    // Background compiling is supported only when shared contexts aren't broken.
+    g_Config.backend_info.bSupportsBackgroundCompiling =
+        !DriverDetails::HasBug(DriverDetails::BUG_SHARED_CONTEXT_SHADER_COMPILATION);
+  }
 
   if (g_ogl_config.bSupportsDebug)
   {
@@ -1398,8 +1418,8 @@ void Renderer::SwapImpl(AbstractTexture* texture, const EFBRectangle& xfb_region
   TargetRectangle flipped_trc = GetTargetRectangle();
   std::swap(flipped_trc.top, flipped_trc.bottom);
 
-  // Skip screen rendering when running in headless mode.
-  if (!IsHeadless())
+  // Skip screen rendering when running in headless mode or verifying a movie.
+  if (!ShouldSkipPresent())
   {
     // Clear the framebuffer before drawing anything.
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -1422,6 +1442,11 @@ void Renderer::SwapImpl(AbstractTexture* texture, const EFBRectangle& xfb_region
 
     // Swap the back and front buffers, presenting the image.
     GLInterface->Swap();
+
+    // In low latency mode, block until the frame has been presented, so that the driver can't
+    // queue up further frames behind it.
+    if (g_ActiveConfig.bLowLatencyPresent)
+      glFinish();
   }
   else
   {
@@ -1629,6 +1654,7 @@ void Renderer::SetPipeline(const AbstractPipeline* pipeline)
   ApplyDepthState(m_graphics_pipeline->GetDepthState());
   ApplyBlendingState(m_graphics_pipeline->GetBlendingState());
   ProgramShaderCache::BindVertexFormat(m_graphics_pipeline->GetVertexFormat());
+  ProgramShaderCache::FinishPipelineProgram(m_graphics_pipeline->GetProgram());
   m_graphics_pipeline->GetProgram()->shader.Bind();
 }
 
@@ -1637,10 +1663,43 @@ void Renderer::SetTexture(u32 index, const AbstractTexture* texture)
   if (m_bound_textures[index] == texture)
     return;
 
+  m_bound_textures[index] = texture;
+
+  // With multi-bind, every changed unit is bound with a single call before the next draw.
+  if (g_ogl_config.bSupportsMultiBind)
+  {
+    m_dirty_textures[index] = true;
+    return;
+  }
+
   glActiveTexture(GL_TEXTURE0 + index);
   glBindTexture(GL_TEXTURE_2D_ARRAY,
                 texture ? static_cast<const OGLTexture*>(texture)->GetRawTexIdentifier() : 0);
-  m_bound_textures[index] = texture;
+}
+
+void Renderer::ApplyTextureBindings()
+{
+  if (!m_dirty_textures)
+    return;
+
+  // Rebinding the clean units in between costs less than another call.
+  u32 first = 0;
+  while (!m_dirty_textures[first])
+    first++;
+  u32 last = static_cast<u32>(m_bound_textures.size()) - 1;
+  while (!m_dirty_textures[last])
+    last--;
+
+  std::array<GLuint, 8> textures;
+  for (u32 i = first; i <= last; i++)
+  {
+    textures[i] = m_bound_textures[i] ?
+                      static_cast<const OGLTexture*>(m_bound_textures[i])->GetRawTexIdentifier() :
+                      0;
+  }
+
+  glBindTextures(first, last - first + 1, &textures[first]);
+  m_dirty_textures = BitSet8();
 }
 
 void Renderer::SetSamplerState(u32 index, const SamplerState& state)
@@ -1657,6 +1716,8 @@ void Renderer::UnbindTexture(const AbstractTexture* texture)
 
     glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + i));
     glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    m_bound_textures[i] = nullptr;
+    m_dirty_textures[i] = false;
   }
 }
 
@@ -1672,6 +1733,8 @@ void Renderer::DrawUtilityPipeline(const void* uniforms, u32 uniforms_size, cons
   if (uniforms_size > 0)
     UploadUtilityUniforms(uniforms, uniforms_size);
 
+  ApplyTextureBindings();
+
   // Draw from base index if there is vertex data.
   if (vertices)
   {
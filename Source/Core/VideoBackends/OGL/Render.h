@@ -7,6 +7,7 @@
 #include <array>
 #include <string>
 
+#include "Common/BitSet.h"
 #include "Common/GL/GLUtil.h"
 #include "VideoCommon/RenderBase.h"
 
@@ -68,6 +69,8 @@ struct VideoConfig
   bool bSupportsAniso;
   bool bSupportsBitfield;
   bool bSupportsTextureSubImage;
+  bool bSupportsMultiBind;
+  bool bSupportsParallelShaderCompile;
   EsFbFetchType SupportedFramebufferFetch;
 
   const char* gl_vendor;
@@ -109,6 +112,7 @@ public:
   void SetTexture(u32 index, const AbstractTexture* texture) override;
   void SetSamplerState(u32 index, const SamplerState& state) override;
   void UnbindTexture(const AbstractTexture* texture) override;
+  void ApplyTextureBindings();
   void SetInterlacingMode() override;
   void SetViewport(float x, float y, float width, float height, float near_depth,
                    float far_depth) override;
@@ -160,6 +164,8 @@ private:
   void UploadUtilityUniforms(const void* uniforms, u32 uniforms_size);
 
   std::array<const AbstractTexture*, 8> m_bound_textures{};
+  // Texture units that still have to be bound before drawing, when multi-bind is supported.
+  BitSet8 m_dirty_textures;
   const OGLPipeline* m_graphics_pipeline = nullptr;
   RasterizationState m_current_rasterization_state = {};
   DepthState m_current_depth_state = {};
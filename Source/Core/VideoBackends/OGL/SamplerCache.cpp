@@ -51,13 +51,13 @@ void SamplerCache::SetSamplerState(u32 stage, const SamplerState& state)
   if (m_active_samplers[stage].first == state && m_active_samplers[stage].second != 0)
     return;
 
-  auto it = m_cache.find(state);
+  auto it = m_cache.find(state.hex);
   if (it == m_cache.end())
   {
     GLuint sampler;
     glGenSamplers(1, &sampler);
     SetParameters(sampler, state);
-    it = m_cache.emplace(state, sampler).first;
+    it = m_cache.emplace(state.hex, sampler).first;
   }
 
   m_active_samplers[stage].first = state;
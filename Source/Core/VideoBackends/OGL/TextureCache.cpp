@@ -108,6 +108,16 @@ TextureCache::TextureCache()
     if (g_ActiveConfig.backend_info.bSupportsGPUTextureDecoding)
       CreateTextureDecodingResources();
   }
+
+  // Uploading from a buffer lets the driver copy the texture data asynchronously, instead of
+  // reading it from client memory before glTexSubImage returns. This is only worth it with the
+  // fenced streaming methods, the others copy the data with glBufferSubData again.
+  if (g_ogl_config.bSupportsGLSync && g_ogl_config.bSupportsGLBaseVertex)
+  {
+    m_texture_upload_buffer =
+        StreamBuffer::Create(GL_PIXEL_UNPACK_BUFFER, TEXTURE_UPLOAD_BUFFER_SIZE);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  }
 }
 
 TextureCache::~TextureCache()
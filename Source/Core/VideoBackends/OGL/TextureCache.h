@@ -39,6 +39,15 @@ public:
   const SHADER& GetColorCopyProgram() const;
   GLuint GetColorCopyPositionUniform() const;
 
+  // Larger uploads would wait for most of the buffer to be consumed by the GPU, and are copied
+  // from client memory instead.
+  static constexpr u32 TEXTURE_UPLOAD_BUFFER_SIZE = 32 * 1024 * 1024;
+  static constexpr u32 TEXTURE_UPLOAD_THRESHOLD = 8 * 1024 * 1024;
+
+  // Pixel unpack buffer for texture uploads, or null if the driver can't stream into one without
+  // stalling. Not left bound to GL_PIXEL_UNPACK_BUFFER.
+  StreamBuffer* GetTextureUploadBuffer() const { return m_texture_upload_buffer.get(); }
+
 private:
   struct PaletteShader
   {
@@ -101,6 +110,8 @@ private:
   std::unique_ptr<StreamBuffer> m_palette_stream_buffer;
   GLuint m_palette_resolv_texture = 0;
 
+  std::unique_ptr<StreamBuffer> m_texture_upload_buffer;
+
   std::map<std::pair<u32, u32>, TextureDecodingProgramInfo> m_texture_decoding_program_info;
   std::array<GLuint, TextureConversionShaderTiled::BUFFER_FORMAT_COUNT>
       m_texture_decoding_buffer_views;
@@ -147,7 +147,21 @@ void VertexManager::Draw(u32 stride)
     break;
   }
 
-  if (g_ogl_config.bSupportsGLBaseVertex)
+  if (g_ActiveConfig.UseVertexShaderStereo())
+  {
+    // One instance for each eye, see VertexShaderGen
+    if (g_ogl_config.bSupportsGLBaseVertex)
+    {
+      glDrawElementsInstancedBaseVertex(primitive_mode, index_size, GL_UNSIGNED_SHORT,
+                                        (u8*)nullptr + s_index_offset, 2, (GLint)s_baseVertex);
+    }
+    else
+    {
+      glDrawElementsInstanced(primitive_mode, index_size, GL_UNSIGNED_SHORT,
+                              (u8*)nullptr + s_index_offset, 2);
+    }
+  }
+  else if (g_ogl_config.bSupportsGLBaseVertex)
   {
     glDrawRangeElementsBaseVertex(primitive_mode, 0, max_index, index_size, GL_UNSIGNED_SHORT,
                                   (u8*)nullptr + s_index_offset, (GLint)s_baseVertex);
@@ -179,13 +193,21 @@ void VertexManager::vFlush()
   if (m_current_pipeline_object)
   {
     g_renderer->SetPipeline(m_current_pipeline_object);
+    static_cast<Renderer*>(g_renderer.get())->ApplyTextureBindings();
     Draw(stride);
   }
 
-  if (::BoundingBox::active && !g_Config.BBoxUseFragmentShaderImplementation())
+  if (::BoundingBox::active)
   {
-    OGL::BoundingBox::StencilWasUpdated();
-    glDisable(GL_STENCIL_TEST);
+    if (g_Config.BBoxUseFragmentShaderImplementation())
+    {
+      OGL::BoundingBox::Invalidate();
+    }
+    else
+    {
+      OGL::BoundingBox::StencilWasUpdated();
+      glDisable(GL_STENCIL_TEST);
+    }
   }
 
   g_Config.iSaveTargetId++;
@@ -75,6 +75,7 @@ void VideoBackend::InitBackendInfo()
 {
   g_Config.backend_info.api_type = APIType::OpenGL;
   g_Config.backend_info.MaxTextureSize = 16384;
+  g_Config.backend_info.MaxPointSize = 0;
   g_Config.backend_info.bSupportsExclusiveFullscreen = false;
   g_Config.backend_info.bSupportsOversizedViewports = true;
   g_Config.backend_info.bSupportsGeometryShaders = true;
@@ -84,6 +85,7 @@ void VideoBackend::InitBackendInfo()
   g_Config.backend_info.bSupportsSSAA = true;
   g_Config.backend_info.bSupportsReversedDepthRange = true;
   g_Config.backend_info.bSupportsLogicOp = true;
+  g_Config.backend_info.bSupportsVSLayerOutput = false;
   g_Config.backend_info.bSupportsMultithreading = false;
   g_Config.backend_info.bSupportsCopyToVram = true;
 
@@ -152,6 +154,10 @@ bool VideoBackend::FillBackendInfo()
     return false;
   }
 
+  GLfloat point_size_range[2] = {};
+  glGetFloatv(GL_ALIASED_POINT_SIZE_RANGE, point_size_range);
+  g_Config.backend_info.MaxPointSize = static_cast<u32>(point_size_range[1]);
+
   // TODO: Move the remaining fields from the Renderer constructor here.
   return true;
 }
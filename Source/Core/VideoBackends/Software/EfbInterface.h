@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <array>
+
 #include "Common/CommonTypes.h"
 #include "VideoCommon/PerfQueryBase.h"
 #include "VideoCommon/VideoCommon.h"
@@ -57,7 +59,15 @@ u8* GetPixelPointer(u16 x, u16 y, bool depth);
 void EncodeXFB(u8* xfb_in_ram, u32 memory_stride, const EFBRectangle& source_rect, float y_scale,
                float gamma);
 
+using PerfCounters = std::array<u32, PQ_NUM_MEMBERS>;
+
 u32 GetPerfQueryResult(PerfQueryType type);
 void ResetPerfQuery();
 void IncPerfCounterQuadCount(PerfQueryType type);
+
+// Makes the calling thread count into counters instead of the perf query results. Threads drawing
+// pixels in parallel use this, and their counts are merged back once they are done.
+void SetThreadPerfCounters(PerfCounters* counters);
+// Adds counters to the perf query results, and resets them.
+void MergePerfCounters(PerfCounters* counters);
 }  // namespace EfbInterface
@@ -3,13 +3,20 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <functional>
+#include <memory>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/WorkQueueThread.h"
 #include "VideoBackends/Software/EfbInterface.h"
 #include "VideoBackends/Software/NativeVertexFormat.h"
 #include "VideoBackends/Software/Rasterizer.h"
 #include "VideoBackends/Software/Tev.h"
+#include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/PerfQueryBase.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoConfig.h"
@@ -19,6 +26,13 @@ namespace Rasterizer
 {
 static constexpr int BLOCK_SIZE = 2;
 
+// Below this many pixels per thread, waking up the threads costs more than it saves.
+static constexpr s32 MIN_PIXELS_PER_JOB = 32 * 32;
+
+// Large triangles are split into bands of this many rows, which are handed out to the threads in
+// turn. Interleaving them balances the work when the triangle gets narrower towards one end.
+static constexpr s32 ROWS_PER_BAND = 8;
+
 static Slope ZSlope;
 static Slope WSlope;
 static Slope ColorSlopes[2][4];
@@ -29,12 +43,50 @@ static s32 vertex0Y;
 static float vertexOffsetX;
 static float vertexOffsetY;
 
-static Tev tev;
-static RasterBlock rasterBlock;
+// State that each thread drawing pixels of a triangle needs for its own.
+struct RasterContext
+{
+  Tev tev;
+  RasterBlock block;
+  EfbInterface::PerfCounters perf_counters{};
+  u32 rasterized_pixels = 0;
+};
+
+// Half-edge constants and deltas of the triangle being drawn, in 28.4 fixed point.
+struct Edges
+{
+  s32 C1, C2, C3;
+  s32 DX12, DX23, DX31;
+  s32 DY12, DY23, DY31;
+  s32 FDX12, FDX23, FDX31;
+  s32 FDY12, FDY23, FDY31;
+};
+
+// The first context is used by the GPU thread, the others by the matching rasterizer thread.
+// Triangles are still drawn one after another, which keeps the order of the pixel updates that
+// blending and the depth test depend on.
+static std::vector<std::unique_ptr<RasterContext>> s_contexts;
+static std::vector<std::unique_ptr<Common::WorkQueueThread<std::function<void()>>>> s_threads;
+static std::atomic<u32> s_jobs_pending;
+static Common::Event s_jobs_done;
 
 void Init()
 {
-  tev.Init();
+  Shutdown();
+
+  const u32 num_threads = g_ActiveConfig.GetSWRasterizerThreads();
+  for (u32 i = 0; i <= num_threads; ++i)
+  {
+    s_contexts.push_back(std::make_unique<RasterContext>());
+    s_contexts.back()->tev.Init();
+    s_contexts.back()->tev.PixelsIn = 0;
+    s_contexts.back()->tev.PixelsOut = 0;
+  }
+  for (u32 i = 0; i < num_threads; ++i)
+  {
+    s_threads.push_back(std::make_unique<Common::WorkQueueThread<std::function<void()>>>(
+        [](std::function<void()> job) { job(); }));
+  }
 
   // Set initial z reference plane in the unlikely case that zfreeze is enabled when drawing the
   // first primitive.
@@ -43,6 +95,12 @@ void Init()
   ZSlope.f0 = 1.f;
 }
 
+void Shutdown()
+{
+  s_threads.clear();
+  s_contexts.clear();
+}
+
 // Returns approximation of log2(f) in s28.4
 // results are close enough to use for LOD
 static s32 FixedLog2(float f)
@@ -67,12 +125,15 @@ static inline int iround(float x)
 
 void SetTevReg(int reg, int comp, s16 color)
 {
-  tev.SetRegColor(reg, comp, color);
+  for (auto& context : s_contexts)
+    context->tev.SetRegColor(reg, comp, color);
 }
 
-static void Draw(s32 x, s32 y, s32 xi, s32 yi)
+static void Draw(RasterContext& context, s32 x, s32 y, s32 xi, s32 yi)
 {
-  INCSTAT(stats.thisFrame.rasterizedPixels);
+  Tev& tev = context.tev;
+  const RasterBlock& rasterBlock = context.block;
+  context.rasterized_pixels++;
 
   float dx = vertexOffsetX + (float)(x - vertex0X);
   float dy = vertexOffsetY + (float)(y - vertex0Y);
@@ -92,7 +153,7 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
     EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT_ZCOMPLOC);
   }
 
-  RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
+  const RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
 
   tev.Position[0] = x;
   tev.Position[1] = y;
@@ -160,7 +221,8 @@ static void InitSlope(Slope* slope, float f1, float f2, float f3, float DX31, fl
   slope->f0 = f1;
 }
 
-static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoord)
+static inline void CalculateLOD(const RasterBlock& rasterBlock, s32* lodp, bool* linear,
+                                u32 texmap, u32 texcoord)
 {
   const FourTexUnits& texUnit = bpmem.tex[(texmap >> 2) & 1];
   const u8 subTexmap = texmap & 3;
@@ -173,17 +235,17 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   float sDelta, tDelta;
   if (tm0.diag_lod)
   {
-    float* uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
-    float* uv1 = rasterBlock.Pixel[1][1].Uv[texcoord];
+    const float* uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
+    const float* uv1 = rasterBlock.Pixel[1][1].Uv[texcoord];
 
     sDelta = fabsf(uv0[0] - uv1[0]);
     tDelta = fabsf(uv0[1] - uv1[1]);
   }
   else
   {
-    float* uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
-    float* uv1 = rasterBlock.Pixel[1][0].Uv[texcoord];
-    float* uv2 = rasterBlock.Pixel[0][1].Uv[texcoord];
+    const float* uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
+    const float* uv1 = rasterBlock.Pixel[1][0].Uv[texcoord];
+    const float* uv2 = rasterBlock.Pixel[0][1].Uv[texcoord];
 
     sDelta = std::max(fabsf(uv0[0] - uv1[0]), fabsf(uv0[0] - uv2[0]));
     tDelta = std::max(fabsf(uv0[1] - uv1[1]), fabsf(uv0[1] - uv2[1]));
@@ -208,7 +270,7 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   *lodp = lod;
 }
 
-static void BuildBlock(s32 blockX, s32 blockY)
+static void BuildBlock(RasterBlock& rasterBlock, s32 blockX, s32 blockY)
 {
   for (s32 yi = 0; yi < BLOCK_SIZE; yi++)
   {
@@ -247,7 +309,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
     u32 texcoord = indref & 3;
     indref >>= 3;
 
-    CalculateLOD(&rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap, texcoord);
+    CalculateLOD(rasterBlock, &rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap,
+                 texcoord);
   }
 
   for (unsigned int i = 0; i <= bpmem.genMode.numtevstages; i++)
@@ -259,7 +322,102 @@ static void BuildBlock(s32 blockX, s32 blockY)
       u32 texmap = order.getTexMap(stageOdd);
       u32 texcoord = order.getTexCoord(stageOdd);
 
-      CalculateLOD(&rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap, texcoord);
+      CalculateLOD(rasterBlock, &rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap,
+                   texcoord);
+    }
+  }
+}
+
+static void DrawBands(RasterContext& context, const Edges& edges, s32 minx, s32 maxx, s32 miny,
+                      s32 maxy, s32 first_band, s32 band_step)
+{
+  const s32 C1 = edges.C1, C2 = edges.C2, C3 = edges.C3;
+  const s32 DX12 = edges.DX12, DX23 = edges.DX23, DX31 = edges.DX31;
+  const s32 DY12 = edges.DY12, DY23 = edges.DY23, DY31 = edges.DY31;
+  const s32 FDX12 = edges.FDX12, FDX23 = edges.FDX23, FDX31 = edges.FDX31;
+  const s32 FDY12 = edges.FDY12, FDY23 = edges.FDY23, FDY31 = edges.FDY31;
+
+  // Loop through blocks
+  for (s32 band = miny + first_band * ROWS_PER_BAND; band < maxy;
+       band += band_step * ROWS_PER_BAND)
+  {
+    const s32 band_end = std::min(band + ROWS_PER_BAND, maxy);
+    for (s32 y = band; y < band_end; y += BLOCK_SIZE)
+    {
+      for (s32 x = minx; x < maxx; x += BLOCK_SIZE)
+      {
+        // Corners of block
+        s32 x0 = x << 4;
+        s32 x1 = (x + BLOCK_SIZE - 1) << 4;
+        s32 y0 = y << 4;
+        s32 y1 = (y + BLOCK_SIZE - 1) << 4;
+
+        // Evaluate half-space functions
+        bool a00 = C1 + DX12 * y0 - DY12 * x0 > 0;
+        bool a10 = C1 + DX12 * y0 - DY12 * x1 > 0;
+        bool a01 = C1 + DX12 * y1 - DY12 * x0 > 0;
+        bool a11 = C1 + DX12 * y1 - DY12 * x1 > 0;
+        int a = (a00 << 0) | (a10 << 1) | (a01 << 2) | (a11 << 3);
+
+        bool b00 = C2 + DX23 * y0 - DY23 * x0 > 0;
+        bool b10 = C2 + DX23 * y0 - DY23 * x1 > 0;
+        bool b01 = C2 + DX23 * y1 - DY23 * x0 > 0;
+        bool b11 = C2 + DX23 * y1 - DY23 * x1 > 0;
+        int b = (b00 << 0) | (b10 << 1) | (b01 << 2) | (b11 << 3);
+
+        bool c00 = C3 + DX31 * y0 - DY31 * x0 > 0;
+        bool c10 = C3 + DX31 * y0 - DY31 * x1 > 0;
+        bool c01 = C3 + DX31 * y1 - DY31 * x0 > 0;
+        bool c11 = C3 + DX31 * y1 - DY31 * x1 > 0;
+        int c = (c00 << 0) | (c10 << 1) | (c01 << 2) | (c11 << 3);
+
+        // Skip block when outside an edge
+        if (a == 0x0 || b == 0x0 || c == 0x0)
+          continue;
+
+        BuildBlock(context.block, x, y);
+
+        // Accept whole block when totally covered
+        if (a == 0xF && b == 0xF && c == 0xF)
+        {
+          for (s32 iy = 0; iy < BLOCK_SIZE; iy++)
+          {
+            for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
+            {
+              Draw(context, x + ix, y + iy, ix, iy);
+            }
+          }
+        }
+        else  // Partially covered block
+        {
+          s32 CY1 = C1 + DX12 * y0 - DY12 * x0;
+          s32 CY2 = C2 + DX23 * y0 - DY23 * x0;
+          s32 CY3 = C3 + DX31 * y0 - DY31 * x0;
+
+          for (s32 iy = 0; iy < BLOCK_SIZE; iy++)
+          {
+            s32 CX1 = CY1;
+            s32 CX2 = CY2;
+            s32 CX3 = CY3;
+
+            for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
+            {
+              if (CX1 > 0 && CX2 > 0 && CX3 > 0)
+              {
+                Draw(context, x + ix, y + iy, ix, iy);
+              }
+
+              CX1 -= FDY12;
+              CX2 -= FDY23;
+              CX3 -= FDY31;
+            }
+
+            CY1 += FDX12;
+            CY2 += FDX23;
+            CY3 += FDX31;
+          }
+        }
+      }
     }
   }
 }
@@ -388,83 +546,66 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   minx &= ~(BLOCK_SIZE - 1);
   miny &= ~(BLOCK_SIZE - 1);
 
-  // Loop through blocks
-  for (s32 y = miny; y < maxy; y += BLOCK_SIZE)
-  {
-    for (s32 x = minx; x < maxx; x += BLOCK_SIZE)
-    {
-      // Corners of block
-      s32 x0 = x << 4;
-      s32 x1 = (x + BLOCK_SIZE - 1) << 4;
-      s32 y0 = y << 4;
-      s32 y1 = (y + BLOCK_SIZE - 1) << 4;
-
-      // Evaluate half-space functions
-      bool a00 = C1 + DX12 * y0 - DY12 * x0 > 0;
-      bool a10 = C1 + DX12 * y0 - DY12 * x1 > 0;
-      bool a01 = C1 + DX12 * y1 - DY12 * x0 > 0;
-      bool a11 = C1 + DX12 * y1 - DY12 * x1 > 0;
-      int a = (a00 << 0) | (a10 << 1) | (a01 << 2) | (a11 << 3);
-
-      bool b00 = C2 + DX23 * y0 - DY23 * x0 > 0;
-      bool b10 = C2 + DX23 * y0 - DY23 * x1 > 0;
-      bool b01 = C2 + DX23 * y1 - DY23 * x0 > 0;
-      bool b11 = C2 + DX23 * y1 - DY23 * x1 > 0;
-      int b = (b00 << 0) | (b10 << 1) | (b01 << 2) | (b11 << 3);
-
-      bool c00 = C3 + DX31 * y0 - DY31 * x0 > 0;
-      bool c10 = C3 + DX31 * y0 - DY31 * x1 > 0;
-      bool c01 = C3 + DX31 * y1 - DY31 * x0 > 0;
-      bool c11 = C3 + DX31 * y1 - DY31 * x1 > 0;
-      int c = (c00 << 0) | (c10 << 1) | (c01 << 2) | (c11 << 3);
-
-      // Skip block when outside an edge
-      if (a == 0x0 || b == 0x0 || c == 0x0)
-        continue;
-
-      BuildBlock(x, y);
-
-      // Accept whole block when totally covered
-      if (a == 0xF && b == 0xF && c == 0xF)
-      {
-        for (s32 iy = 0; iy < BLOCK_SIZE; iy++)
-        {
-          for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
-          {
-            Draw(x + ix, y + iy, ix, iy);
-          }
-        }
-      }
-      else  // Partially covered block
-      {
-        s32 CY1 = C1 + DX12 * y0 - DY12 * x0;
-        s32 CY2 = C2 + DX23 * y0 - DY23 * x0;
-        s32 CY3 = C3 + DX31 * y0 - DY31 * x0;
+  const Edges edges = {C1,   C2,    C3,    DX12,  DX23,  DX31,  DY12, DY23,
+                       DY31, FDX12, FDX23, FDX31, FDY12, FDY23, FDY31};
 
-        for (s32 iy = 0; iy < BLOCK_SIZE; iy++)
-        {
-          s32 CX1 = CY1;
-          s32 CX2 = CY2;
-          s32 CX3 = CY3;
+  const s32 num_bands = (maxy - miny + ROWS_PER_BAND - 1) / ROWS_PER_BAND;
+  const s32 num_pixels = (maxx - minx) * (maxy - miny);
+  s32 num_jobs = std::max(std::min({static_cast<s32>(s_contexts.size()),
+                                    num_pixels / MIN_PIXELS_PER_JOB, num_bands}),
+                          1);
 
-          for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
-          {
-            if (CX1 > 0 && CX2 > 0 && CX3 > 0)
-            {
-              Draw(x + ix, y + iy, ix, iy);
-            }
+  // Dumping the TEV stages writes to shared buffers for every pixel, so stay on this thread.
+  if (g_ActiveConfig.bDumpTevStages || g_ActiveConfig.bDumpTevTextureFetches)
+    num_jobs = 1;
 
-            CX1 -= FDY12;
-            CX2 -= FDY23;
-            CX3 -= FDY31;
-          }
+  for (s32 i = 0; i < num_jobs; ++i)
+    std::copy_n(BoundingBox::coords, 4, s_contexts[i]->tev.BBox);
 
-          CY1 += FDX12;
-          CY2 += FDX23;
-          CY3 += FDX31;
-        }
-      }
+  if (num_jobs == 1)
+  {
+    DrawBands(*s_contexts[0], edges, minx, maxx, miny, maxy, 0, 1);
+  }
+  else
+  {
+    s_jobs_pending.store(num_jobs - 1);
+    for (s32 job = 1; job < num_jobs; ++job)
+    {
+      RasterContext* context = s_contexts[job].get();
+      s_threads[job - 1]->EmplaceItem([=] {
+        EfbInterface::SetThreadPerfCounters(&context->perf_counters);
+        DrawBands(*context, edges, minx, maxx, miny, maxy, job, num_jobs);
+        if (s_jobs_pending.fetch_sub(1) == 1)
+          s_jobs_done.Set();
+      });
     }
+
+    DrawBands(*s_contexts[0], edges, minx, maxx, miny, maxy, 0, num_jobs);
+    s_jobs_done.Wait();
+  }
+
+  // Merge the results of every thread.
+  for (s32 i = 0; i < num_jobs; ++i)
+  {
+    RasterContext& context = *s_contexts[i];
+    BoundingBox::coords[BoundingBox::LEFT] =
+        std::min(context.tev.BBox[BoundingBox::LEFT], BoundingBox::coords[BoundingBox::LEFT]);
+    BoundingBox::coords[BoundingBox::RIGHT] =
+        std::max(context.tev.BBox[BoundingBox::RIGHT], BoundingBox::coords[BoundingBox::RIGHT]);
+    BoundingBox::coords[BoundingBox::TOP] =
+        std::min(context.tev.BBox[BoundingBox::TOP], BoundingBox::coords[BoundingBox::TOP]);
+    BoundingBox::coords[BoundingBox::BOTTOM] =
+        std::max(context.tev.BBox[BoundingBox::BOTTOM], BoundingBox::coords[BoundingBox::BOTTOM]);
+
+    ADDSTAT(stats.thisFrame.rasterizedPixels, context.rasterized_pixels);
+    ADDSTAT(stats.thisFrame.tevPixelsIn, context.tev.PixelsIn);
+    ADDSTAT(stats.thisFrame.tevPixelsOut, context.tev.PixelsOut);
+    context.rasterized_pixels = 0;
+    context.tev.PixelsIn = 0;
+    context.tev.PixelsOut = 0;
+
+    if (i != 0)
+      EfbInterface::MergePerfCounters(&context.perf_counters);
   }
 }
 }
@@ -91,7 +91,7 @@ void SWRenderer::SwapImpl(AbstractTexture* texture, const EFBRectangle& xfb_regi
 {
   OSD::DoCallbacks(OSD::CallbackType::OnFrame);
 
-  if (!IsHeadless())
+  if (!ShouldSkipPresent())
   {
     DrawDebugText();
     SWOGLWindow::s_instance->ShowImage(texture, xfb_region);
@@ -58,6 +58,7 @@ void VideoSoftware::InitBackendInfo()
 {
   g_Config.backend_info.api_type = APIType::Nothing;
   g_Config.backend_info.MaxTextureSize = 16384;
+  g_Config.backend_info.MaxPointSize = 0;
   g_Config.backend_info.bSupports3DVision = false;
   g_Config.backend_info.bSupportsDualSourceBlend = true;
   g_Config.backend_info.bSupportsEarlyZ = true;
@@ -72,6 +73,7 @@ void VideoSoftware::InitBackendInfo()
   g_Config.backend_info.bSupportsFramebufferFetch = false;
   g_Config.backend_info.bSupportsBackgroundCompiling = false;
   g_Config.backend_info.bSupportsLogicOp = true;
+  g_Config.backend_info.bSupportsVSLayerOutput = false;
 
   // aamodes
   g_Config.backend_info.AAModes = {1};
@@ -107,6 +109,7 @@ void VideoSoftware::Shutdown()
   if (g_renderer)
     g_renderer->Shutdown();
 
+  Rasterizer::Shutdown();
   DebugUtil::Shutdown();
   SWOGLWindow::Shutdown();
   g_framebuffer_manager.reset();
@@ -75,6 +75,11 @@ public:
   s32 TextureLod[16];
   bool TextureLinear[16];
 
+  // Results of the drawn pixels, which the rasterizer merges into the global state.
+  u16 BBox[4];
+  u32 PixelsIn;
+  u32 PixelsOut;
+
   enum
   {
     ALP_C,
@@ -6,8 +6,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Core/HW/Memmap.h"
 
 #include "VideoCommon/BPMemory.h"
@@ -59,6 +61,49 @@ static inline void AddTexel(const u8* inTexel, u32* outTexel, u32 fract)
   outTexel[3] += inTexel[3] * fract;
 }
 
+// Blends the four texels around a sample location. fractS and fractT are in 0.7 fixed point.
+static inline void BilinearFilter(const u8 texels[4][4], s32 fractS, s32 fractT, u8* sample)
+{
+  const u32 weights[4] = {static_cast<u32>((128 - fractS) * (128 - fractT)),
+                          static_cast<u32>(fractS * (128 - fractT)),
+                          static_cast<u32>((128 - fractS) * fractT),
+                          static_cast<u32>(fractS * fractT)};
+
+#ifdef _M_X86
+  u32 packed[4];
+  std::memcpy(packed, texels, sizeof(packed));
+
+  // Interleave the channels of each horizontal pair of texels as 16-bit values, so that pmaddwd
+  // weighs and adds a pair in one go. The largest sum, 255 * 128 * 128, fits into 32 bits.
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i top = _mm_unpacklo_epi8(
+      _mm_unpacklo_epi8(_mm_cvtsi32_si128(packed[0]), _mm_cvtsi32_si128(packed[1])), zero);
+  const __m128i bottom = _mm_unpacklo_epi8(
+      _mm_unpacklo_epi8(_mm_cvtsi32_si128(packed[2]), _mm_cvtsi32_si128(packed[3])), zero);
+  const __m128i top_weights = _mm_set1_epi32(static_cast<int>(weights[1] << 16 | weights[0]));
+  const __m128i bottom_weights = _mm_set1_epi32(static_cast<int>(weights[3] << 16 | weights[2]));
+
+  __m128i result = _mm_add_epi32(_mm_madd_epi16(top, top_weights),
+                                 _mm_madd_epi16(bottom, bottom_weights));
+  result = _mm_srli_epi32(result, 14);
+  result = _mm_packus_epi16(_mm_packs_epi32(result, result), result);
+
+  const u32 filtered = static_cast<u32>(_mm_cvtsi128_si32(result));
+  std::memcpy(sample, &filtered, sizeof(filtered));
+#else
+  u32 texel[4];
+  SetTexel(texels[0], texel, weights[0]);
+  AddTexel(texels[1], texel, weights[1]);
+  AddTexel(texels[2], texel, weights[2]);
+  AddTexel(texels[3], texel, weights[3]);
+
+  sample[0] = (u8)(texel[0] >> 14);
+  sample[1] = (u8)(texel[1] >> 14);
+  sample[2] = (u8)(texel[2] >> 14);
+  sample[3] = (u8)(texel[3] >> 14);
+#endif
+}
+
 void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
 {
   int baseMip = 0;
@@ -180,8 +225,7 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     int imageTPlus1 = imageT + 1;
     const int fractT = t & 0x7f;
 
-    u8 sampledTex[4];
-    u32 texel[4];
+    u8 texels[4][4];
 
     WrapCoord(&imageS, tm0.wrap_s, imageWidth);
     WrapCoord(&imageT, tm0.wrap_t, imageHeight);
@@ -190,45 +234,28 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
 
     if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1[subTexmap].image_type))
     {
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageS, imageT, imageWidth, texfmt, tlut,
+      TexDecoder_DecodeTexel(texels[0], imageSrc, imageS, imageT, imageWidth, texfmt, tlut,
                              tlutfmt);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageSPlus1, imageT, imageWidth, texfmt, tlut,
+      TexDecoder_DecodeTexel(texels[1], imageSrc, imageSPlus1, imageT, imageWidth, texfmt, tlut,
                              tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageS, imageTPlus1, imageWidth, texfmt, tlut,
+      TexDecoder_DecodeTexel(texels[2], imageSrc, imageS, imageTPlus1, imageWidth, texfmt, tlut,
                              tlutfmt);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageSPlus1, imageTPlus1, imageWidth, texfmt,
+      TexDecoder_DecodeTexel(texels[3], imageSrc, imageSPlus1, imageTPlus1, imageWidth, texfmt,
                              tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
     }
     else
     {
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageS, imageT,
+      TexDecoder_DecodeTexelRGBA8FromTmem(texels[0], imageSrc, imageSrcOdd, imageS, imageT,
                                           imageWidth);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageSPlus1, imageT,
+      TexDecoder_DecodeTexelRGBA8FromTmem(texels[1], imageSrc, imageSrcOdd, imageSPlus1, imageT,
                                           imageWidth);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageS, imageTPlus1,
+      TexDecoder_DecodeTexelRGBA8FromTmem(texels[2], imageSrc, imageSrcOdd, imageS, imageTPlus1,
                                           imageWidth);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageSPlus1,
+      TexDecoder_DecodeTexelRGBA8FromTmem(texels[3], imageSrc, imageSrcOdd, imageSPlus1,
                                           imageTPlus1, imageWidth);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
     }
 
-    sample[0] = (u8)(texel[0] >> 14);
-    sample[1] = (u8)(texel[1] >> 14);
-    sample[2] = (u8)(texel[2] >> 14);
-    sample[3] = (u8)(texel[3] >> 14);
+    BilinearFilter(texels, fractS, fractT, sample);
   }
   else
   {
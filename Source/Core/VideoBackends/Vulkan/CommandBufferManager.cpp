@@ -244,6 +244,19 @@ void CommandBufferManager::WaitForFence(VkFence fence)
   OnCommandBufferExecuted(command_buffer_index);
 }
 
+void CommandBufferManager::WaitForFenceCounter(u64 fence_counter)
+{
+  if (m_completed_fence_counter >= fence_counter)
+    return;
+
+  // Counters which have not completed yet belong to one of the command buffers in the ring.
+  auto iter = std::find_if(
+      m_frame_resources.begin(), m_frame_resources.end(),
+      [fence_counter](const FrameResources& res) { return res.fence_counter == fence_counter; });
+  ASSERT(iter != m_frame_resources.end() && iter->needs_fence_wait);
+  WaitForFence(iter->fence);
+}
+
 void CommandBufferManager::SubmitCommandBuffer(bool submit_on_worker_thread,
                                                VkSemaphore wait_semaphore,
                                                VkSemaphore signal_semaphore,
@@ -257,17 +270,6 @@ void CommandBufferManager::SubmitCommandBuffer(bool submit_on_worker_thread,
   for (const auto& iter : m_fence_point_callbacks)
     iter.second.first(resources.command_buffers[1], resources.fence);
 
-  // End the current command buffer.
-  for (VkCommandBuffer command_buffer : resources.command_buffers)
-  {
-    VkResult res = vkEndCommandBuffer(command_buffer);
-    if (res != VK_SUCCESS)
-    {
-      LOG_VULKAN_ERROR(res, "vkEndCommandBuffer failed: ");
-      PanicAlert("Failed to end command buffer");
-    }
-  }
-
   // This command buffer now has commands, so can't be re-used without waiting.
   resources.needs_fence_wait = true;
 
@@ -300,6 +302,20 @@ void CommandBufferManager::SubmitCommandBuffer(size_t index, VkSemaphore wait_se
   FrameResources& resources = m_frame_resources[index];
 
   // This may be executed on the worker thread, so don't modify any state of the manager class.
+  // Ending the command buffers here moves their finalization, which can be expensive with large
+  // numbers of draws, off the GPU thread. This is safe because each frame's command buffers are
+  // allocated from their own pool, and the GPU thread doesn't touch them again until they have
+  // been submitted.
+  for (VkCommandBuffer command_buffer : resources.command_buffers)
+  {
+    VkResult res = vkEndCommandBuffer(command_buffer);
+    if (res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkEndCommandBuffer failed: ");
+      PanicAlert("Failed to end command buffer");
+    }
+  }
+
   uint32_t wait_bits = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
   VkSubmitInfo submit_info = {VK_STRUCTURE_TYPE_SUBMIT_INFO,
                               nullptr,
@@ -370,6 +386,10 @@ void CommandBufferManager::OnCommandBufferExecuted(size_t index)
 {
   FrameResources& resources = m_frame_resources[index];
 
+  // The queue executes command buffers in submission order, so everything before this one has
+  // completed too, even if its fence has not been waited on yet.
+  m_completed_fence_counter = std::max(m_completed_fence_counter, resources.fence_counter);
+
   // Fire fence tracking callbacks.
   for (auto iter = m_fence_point_callbacks.begin(); iter != m_fence_point_callbacks.end();)
   {
@@ -427,6 +447,7 @@ void CommandBufferManager::ActivateCommandBuffer()
 
   // Reset upload command buffer state
   resources.init_command_buffer_used = false;
+  resources.fence_counter = m_next_fence_counter++;
 }
 
 void CommandBufferManager::ExecuteCommandBuffer(bool submit_off_thread, bool wait_for_completion)
@@ -463,6 +484,12 @@ void CommandBufferManager::DeferDeviceMemoryDestruction(VkDeviceMemory object)
       [object]() { vkFreeMemory(g_vulkan_context->GetDevice(), object, nullptr); });
 }
 
+void CommandBufferManager::DeferAllocationDestruction(const MemoryAllocator::Allocation& allocation)
+{
+  FrameResources& resources = m_frame_resources[m_current_frame];
+  resources.cleanup_resources.push_back([allocation]() { g_memory_allocator->Free(allocation); });
+}
+
 void CommandBufferManager::DeferFramebufferDestruction(VkFramebuffer object)
 {
   FrameResources& resources = m_frame_resources[m_current_frame];
@@ -22,6 +22,7 @@
 #include "VideoCommon/VideoCommon.h"
 
 #include "VideoBackends/Vulkan/Constants.h"
+#include "VideoBackends/Vulkan/MemoryAllocator.h"
 #include "VideoBackends/Vulkan/Util.h"
 
 namespace Vulkan
@@ -55,6 +56,12 @@ public:
   // Gets the fence that will be signaled when the currently executing command buffer is
   // queued and executed. Do not wait for this fence before the buffer is executed.
   VkFence GetCurrentCommandBufferFence() const { return m_frame_resources[m_current_frame].fence; }
+
+  // Each command buffer submission is assigned a counter value, which increases monotonically.
+  // Resources can record the counter of the command buffer which last used them, and compare it
+  // against the completed counter, rather than tracking fences through callbacks.
+  u64 GetCurrentFenceCounter() const { return m_frame_resources[m_current_frame].fence_counter; }
+  u64 GetCompletedFenceCounter() const { return m_completed_fence_counter; }
   // Ensure the worker thread has submitted the previous frame's command buffer.
   void PrepareToSubmitCommandBuffer();
 
@@ -69,6 +76,10 @@ public:
   // Also invokes callbacks for completion.
   void WaitForFence(VkFence fence);
 
+  // Wait for the command buffer with the specified counter to complete, which implies that all
+  // earlier submissions have completed as well. The command buffer must have been submitted.
+  void WaitForFenceCounter(u64 fence_counter);
+
   void SubmitCommandBuffer(bool submit_on_worker_thread,
                            VkSemaphore wait_semaphore = VK_NULL_HANDLE,
                            VkSemaphore signal_semaphore = VK_NULL_HANDLE,
@@ -86,6 +97,7 @@ public:
   void DeferBufferDestruction(VkBuffer object);
   void DeferBufferViewDestruction(VkBufferView object);
   void DeferDeviceMemoryDestruction(VkDeviceMemory object);
+  void DeferAllocationDestruction(const MemoryAllocator::Allocation& allocation);
   void DeferFramebufferDestruction(VkFramebuffer object);
   void DeferImageDestruction(VkImage object);
   void DeferImageViewDestruction(VkImageView object);
@@ -119,6 +131,7 @@ private:
     std::array<VkCommandBuffer, 2> command_buffers;
     VkDescriptorPool descriptor_pool;
     VkFence fence;
+    u64 fence_counter;
     bool init_command_buffer_used;
     bool needs_fence_wait;
 
@@ -127,6 +140,8 @@ private:
 
   std::array<FrameResources, NUM_COMMAND_BUFFERS> m_frame_resources = {};
   size_t m_current_frame;
+  u64 m_next_fence_counter = 1;
+  u64 m_completed_fence_counter = 0;
 
   // callbacks when a fence point is set
   std::map<const void*, std::pair<CommandBufferQueuedCallback, CommandBufferExecutedCallback>>
@@ -148,9 +148,21 @@ bool FramebufferManager::CreateEFBRenderPasses()
   m_efb_clear_render_pass =
       g_object_cache->GetRenderPass(EFB_COLOR_TEXTURE_FORMAT, EFB_DEPTH_TEXTURE_FORMAT,
                                     g_ActiveConfig.iMultisamples, VK_ATTACHMENT_LOAD_OP_CLEAR);
+  m_efb_clear_color_render_pass = g_object_cache->GetRenderPass(
+      EFB_COLOR_TEXTURE_FORMAT, EFB_DEPTH_TEXTURE_FORMAT, g_ActiveConfig.iMultisamples,
+      VK_ATTACHMENT_LOAD_OP_CLEAR, VK_ATTACHMENT_LOAD_OP_LOAD);
+  m_efb_clear_depth_render_pass = g_object_cache->GetRenderPass(
+      EFB_COLOR_TEXTURE_FORMAT, EFB_DEPTH_TEXTURE_FORMAT, g_ActiveConfig.iMultisamples,
+      VK_ATTACHMENT_LOAD_OP_LOAD, VK_ATTACHMENT_LOAD_OP_CLEAR);
+  m_efb_convert_render_pass = g_object_cache->GetRenderPass(
+      EFB_COLOR_TEXTURE_FORMAT, EFB_DEPTH_TEXTURE_FORMAT, g_ActiveConfig.iMultisamples,
+      VK_ATTACHMENT_LOAD_OP_DONT_CARE, VK_ATTACHMENT_LOAD_OP_LOAD);
   m_depth_resolve_render_pass = g_object_cache->GetRenderPass(
       EFB_DEPTH_AS_COLOR_TEXTURE_FORMAT, VK_FORMAT_UNDEFINED, 1, VK_ATTACHMENT_LOAD_OP_DONT_CARE);
   return m_efb_load_render_pass != VK_NULL_HANDLE && m_efb_clear_render_pass != VK_NULL_HANDLE &&
+         m_efb_clear_color_render_pass != VK_NULL_HANDLE &&
+         m_efb_clear_depth_render_pass != VK_NULL_HANDLE &&
+         m_efb_convert_render_pass != VK_NULL_HANDLE &&
          m_depth_resolve_render_pass != VK_NULL_HANDLE;
 }
 
@@ -367,7 +379,7 @@ void FramebufferManager::ReinterpretPixelData(int convtype)
 
   UtilityShaderDraw draw(g_command_buffer_mgr->GetCurrentCommandBuffer(),
                          g_object_cache->GetPipelineLayout(PIPELINE_LAYOUT_STANDARD),
-                         m_efb_load_render_pass, g_shader_cache->GetScreenQuadVertexShader(),
+                         m_efb_convert_render_pass, g_shader_cache->GetScreenQuadVertexShader(),
                          g_shader_cache->GetScreenQuadGeometryShader(), pixel_shader);
 
   VkRect2D region = {{0, 0}, {GetEFBWidth(), GetEFBHeight()}};
@@ -36,6 +36,8 @@ public:
 
   VkRenderPass GetEFBLoadRenderPass() const { return m_efb_load_render_pass; }
   VkRenderPass GetEFBClearRenderPass() const { return m_efb_clear_render_pass; }
+  VkRenderPass GetEFBClearColorRenderPass() const { return m_efb_clear_color_render_pass; }
+  VkRenderPass GetEFBClearDepthRenderPass() const { return m_efb_clear_depth_render_pass; }
   Texture2D* GetEFBColorTexture() const { return m_efb_color_texture.get(); }
   Texture2D* GetEFBDepthTexture() const { return m_efb_depth_texture.get(); }
   VkFramebuffer GetEFBFramebuffer() const { return m_efb_framebuffer; }
@@ -113,6 +115,10 @@ private:
 
   VkRenderPass m_efb_load_render_pass = VK_NULL_HANDLE;
   VkRenderPass m_efb_clear_render_pass = VK_NULL_HANDLE;
+  VkRenderPass m_efb_clear_color_render_pass = VK_NULL_HANDLE;
+  VkRenderPass m_efb_clear_depth_render_pass = VK_NULL_HANDLE;
+  // Fully overwrites the color attachment, so its previous contents aren't loaded.
+  VkRenderPass m_efb_convert_render_pass = VK_NULL_HANDLE;
   VkRenderPass m_depth_resolve_render_pass = VK_NULL_HANDLE;
 
   std::unique_ptr<Texture2D> m_efb_color_texture;
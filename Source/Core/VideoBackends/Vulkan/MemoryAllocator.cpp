@@ -0,0 +1,203 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoBackends/Vulkan/MemoryAllocator.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "Common/Align.h"
+#include "Common/Assert.h"
+
+#include "VideoBackends/Vulkan/VulkanContext.h"
+
+namespace Vulkan
+{
+std::unique_ptr<MemoryAllocator> g_memory_allocator;
+
+MemoryAllocator::~MemoryAllocator()
+{
+  for (Pool& pool : m_pools)
+  {
+    for (std::unique_ptr<Block>& block : pool)
+    {
+      ASSERT_MSG(VIDEO, block->used == 0, "Vulkan device memory block still has allocations");
+      FreeDeviceMemory(block->memory, block->map_pointer);
+    }
+  }
+}
+
+bool MemoryAllocator::Allocate(const VkMemoryRequirements& requirements, u32 memory_type_index,
+                               ResourceType resource_type, Allocation* out_allocation)
+{
+  VkDeviceSize size = Common::AlignUp(requirements.size, MIN_ALLOCATION_SIZE);
+  VkDeviceSize alignment = std::max(requirements.alignment, MIN_ALLOCATION_SIZE);
+
+  // Flushes and invalidates of non-coherent memory operate on whole atoms, so allocations must not
+  // share an atom with their neighbours.
+  const VkMemoryPropertyFlags memory_flags =
+      g_vulkan_context->GetDeviceMemoryProperties().memoryTypes[memory_type_index].propertyFlags;
+  if ((memory_flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) &&
+      !(memory_flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
+  {
+    const VkDeviceSize atom_size = g_vulkan_context->GetDeviceLimits().nonCoherentAtomSize;
+    size = Common::AlignUp(size, atom_size);
+    alignment = std::max(alignment, atom_size);
+  }
+
+  if (size <= MAX_SUBALLOCATION_SIZE)
+  {
+    const size_t pool_index =
+        memory_type_index * static_cast<size_t>(ResourceType::Count) +
+        static_cast<size_t>(resource_type);
+    Pool& pool = m_pools[pool_index];
+    for (std::unique_ptr<Block>& block : pool)
+    {
+      if (SuballocateFromBlock(block.get(), size, alignment, out_allocation))
+        return true;
+    }
+
+    // No space in the existing blocks, so start a new one. If that fails, the heap may still have
+    // enough room for a dedicated allocation of the resource's size.
+    VkDeviceMemory memory;
+    char* map_pointer;
+    if (AllocateDeviceMemory(BLOCK_SIZE, memory_type_index, &memory, &map_pointer))
+    {
+      std::unique_ptr<Block> block = std::make_unique<Block>();
+      block->memory = memory;
+      block->map_pointer = map_pointer;
+      block->pool_index = pool_index;
+      block->free_ranges.emplace(0, BLOCK_SIZE);
+      block->used = 0;
+      pool.push_back(std::move(block));
+      return SuballocateFromBlock(pool.back().get(), size, alignment, out_allocation);
+    }
+  }
+
+  Allocation allocation;
+  if (!AllocateDeviceMemory(requirements.size, memory_type_index, &allocation.memory,
+                            &allocation.map_pointer))
+  {
+    return false;
+  }
+
+  allocation.size = requirements.size;
+  *out_allocation = allocation;
+  return true;
+}
+
+void MemoryAllocator::Free(const Allocation& allocation)
+{
+  Block* block = allocation.block;
+  if (!block)
+  {
+    FreeDeviceMemory(allocation.memory, allocation.map_pointer);
+    return;
+  }
+
+  // Return the range to the block, merging it with the free ranges on either side.
+  VkDeviceSize offset = allocation.offset;
+  VkDeviceSize size = allocation.size;
+  auto next = block->free_ranges.lower_bound(offset);
+  if (next != block->free_ranges.begin())
+  {
+    auto prev = std::prev(next);
+    if (prev->first + prev->second == offset)
+    {
+      offset = prev->first;
+      size += prev->second;
+      block->free_ranges.erase(prev);
+    }
+  }
+  if (next != block->free_ranges.end() && offset + size == next->first)
+  {
+    size += next->second;
+    block->free_ranges.erase(next);
+  }
+  block->free_ranges.emplace(offset, size);
+  block->used -= allocation.size;
+
+  // Release empty blocks, but keep the last one of each pool around, so that a texture being
+  // recreated every frame does not cause a device memory allocation every frame.
+  Pool& pool = m_pools[block->pool_index];
+  if (block->used == 0 && pool.size() > 1)
+  {
+    FreeDeviceMemory(block->memory, block->map_pointer);
+    pool.erase(std::find_if(pool.begin(), pool.end(),
+                            [block](const std::unique_ptr<Block>& b) { return b.get() == block; }));
+  }
+}
+
+bool MemoryAllocator::AllocateDeviceMemory(VkDeviceSize size, u32 memory_type_index,
+                                           VkDeviceMemory* out_memory, char** out_map_pointer)
+{
+  VkMemoryAllocateInfo memory_info = {VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, nullptr, size,
+                                      memory_type_index};
+  VkResult res = vkAllocateMemory(g_vulkan_context->GetDevice(), &memory_info, nullptr, out_memory);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkAllocateMemory failed: ");
+    return false;
+  }
+
+  *out_map_pointer = nullptr;
+  const VkMemoryPropertyFlags memory_flags =
+      g_vulkan_context->GetDeviceMemoryProperties().memoryTypes[memory_type_index].propertyFlags;
+  if (memory_flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+  {
+    void* map_pointer;
+    res = vkMapMemory(g_vulkan_context->GetDevice(), *out_memory, 0, VK_WHOLE_SIZE, 0,
+                      &map_pointer);
+    if (res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkMapMemory failed: ");
+      vkFreeMemory(g_vulkan_context->GetDevice(), *out_memory, nullptr);
+      return false;
+    }
+
+    *out_map_pointer = static_cast<char*>(map_pointer);
+  }
+
+  return true;
+}
+
+void MemoryAllocator::FreeDeviceMemory(VkDeviceMemory memory, char* map_pointer)
+{
+  if (map_pointer)
+    vkUnmapMemory(g_vulkan_context->GetDevice(), memory);
+  vkFreeMemory(g_vulkan_context->GetDevice(), memory, nullptr);
+}
+
+bool MemoryAllocator::SuballocateFromBlock(Block* block, VkDeviceSize size, VkDeviceSize alignment,
+                                           Allocation* out_allocation)
+{
+  // First fit. The ranges are sorted by offset, so this packs allocations towards the start of
+  // the block, leaving the largest possible range at the end.
+  for (auto iter = block->free_ranges.begin(); iter != block->free_ranges.end(); ++iter)
+  {
+    const VkDeviceSize range_start = iter->first;
+    const VkDeviceSize range_end = iter->first + iter->second;
+    const VkDeviceSize offset = Common::AlignUp(range_start, alignment);
+    if (offset + size > range_end)
+      continue;
+
+    block->free_ranges.erase(iter);
+    if (offset > range_start)
+      block->free_ranges.emplace(range_start, offset - range_start);
+    if (offset + size < range_end)
+      block->free_ranges.emplace(offset + size, range_end - (offset + size));
+    block->used += size;
+
+    out_allocation->memory = block->memory;
+    out_allocation->offset = offset;
+    out_allocation->size = size;
+    out_allocation->map_pointer = block->map_pointer ? block->map_pointer + offset : nullptr;
+    out_allocation->block = block;
+    return true;
+  }
+
+  return false;
+}
+
+}  // namespace Vulkan
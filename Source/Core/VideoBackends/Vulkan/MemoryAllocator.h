@@ -0,0 +1,94 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoBackends/Vulkan/Constants.h"
+
+namespace Vulkan
+{
+// Suballocates device memory for textures and staging buffers out of large blocks, so that
+// creating a resource does not require a vkAllocateMemory call, which can be slow, and is limited
+// to maxMemoryAllocationCount allocations. Blocks of host-visible memory are persistently mapped.
+// Resources which are too large to share a block receive a dedicated allocation.
+//
+// Allocations must be released through the command buffer manager, as the GPU may still be using
+// the memory. The allocator is only accessed from the GPU thread.
+class MemoryAllocator
+{
+  struct Block;
+
+public:
+  // Linear resources (buffers and linear images) and optimal-tiled images are kept in separate
+  // blocks, so neighbouring allocations never have to be padded to bufferImageGranularity.
+  enum class ResourceType
+  {
+    Linear,
+    Optimal,
+    Count
+  };
+
+  struct Allocation
+  {
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
+    VkDeviceSize size = 0;
+
+    // Pointer to the start of the allocation, if the memory is host-visible.
+    char* map_pointer = nullptr;
+
+    // Null for dedicated allocations.
+    Block* block = nullptr;
+  };
+
+  static constexpr VkDeviceSize BLOCK_SIZE = 32 * 1024 * 1024;
+
+  // Allocations larger than this are not placed in a shared block.
+  static constexpr VkDeviceSize MAX_SUBALLOCATION_SIZE = BLOCK_SIZE / 4;
+
+  // Sizes are rounded up to a multiple of this, to reduce fragmentation of the free ranges.
+  static constexpr VkDeviceSize MIN_ALLOCATION_SIZE = 256;
+
+  MemoryAllocator() = default;
+  ~MemoryAllocator();
+
+  bool Allocate(const VkMemoryRequirements& requirements, u32 memory_type_index,
+                ResourceType resource_type, Allocation* out_allocation);
+
+  // Releases the memory immediately, use CommandBufferManager::DeferAllocationDestruction if the
+  // GPU may still be accessing it.
+  void Free(const Allocation& allocation);
+
+private:
+  struct Block
+  {
+    VkDeviceMemory memory;
+    char* map_pointer;
+    size_t pool_index;
+
+    // Offset -> size of the unused ranges, adjacent ranges are always merged.
+    std::map<VkDeviceSize, VkDeviceSize> free_ranges;
+    VkDeviceSize used;
+  };
+
+  using Pool = std::vector<std::unique_ptr<Block>>;
+
+  static bool AllocateDeviceMemory(VkDeviceSize size, u32 memory_type_index,
+                                   VkDeviceMemory* out_memory, char** out_map_pointer);
+  static void FreeDeviceMemory(VkDeviceMemory memory, char* map_pointer);
+  static bool SuballocateFromBlock(Block* block, VkDeviceSize size, VkDeviceSize alignment,
+                                   Allocation* out_allocation);
+
+  std::array<Pool, VK_MAX_MEMORY_TYPES * static_cast<size_t>(ResourceType::Count)> m_pools;
+};
+
+extern std::unique_ptr<MemoryAllocator> g_memory_allocator;
+
+}  // namespace Vulkan
@@ -327,7 +327,7 @@ bool ObjectCache::CreateStaticSamplers()
 
 VkSampler ObjectCache::GetSampler(const SamplerState& info)
 {
-  auto iter = m_sampler_cache.find(info);
+  auto iter = m_sampler_cache.find(info.hex);
   if (iter != m_sampler_cache.end())
     return iter->second;
 
@@ -374,14 +374,15 @@ VkSampler ObjectCache::GetSampler(const SamplerState& info)
     LOG_VULKAN_ERROR(res, "vkCreateSampler failed: ");
 
   // Store it even if it failed
-  m_sampler_cache.emplace(info, sampler);
+  m_sampler_cache.emplace(info.hex, sampler);
   return sampler;
 }
 
 VkRenderPass ObjectCache::GetRenderPass(VkFormat color_format, VkFormat depth_format,
-                                        u32 multisamples, VkAttachmentLoadOp load_op)
+                                        u32 multisamples, VkAttachmentLoadOp color_load_op,
+                                        VkAttachmentLoadOp depth_load_op)
 {
-  auto key = std::tie(color_format, depth_format, multisamples, load_op);
+  auto key = std::tie(color_format, depth_format, multisamples, color_load_op, depth_load_op);
   auto it = m_render_pass_cache.find(key);
   if (it != m_render_pass_cache.end())
     return it->second;
@@ -397,7 +398,7 @@ VkRenderPass ObjectCache::GetRenderPass(VkFormat color_format, VkFormat depth_fo
     attachments[num_attachments] = {0,
                                     color_format,
                                     static_cast<VkSampleCountFlagBits>(multisamples),
-                                    load_op,
+                                    color_load_op,
                                     VK_ATTACHMENT_STORE_OP_STORE,
                                     VK_ATTACHMENT_LOAD_OP_DONT_CARE,
                                     VK_ATTACHMENT_STORE_OP_DONT_CARE,
@@ -413,7 +414,7 @@ VkRenderPass ObjectCache::GetRenderPass(VkFormat color_format, VkFormat depth_fo
     attachments[num_attachments] = {0,
                                     depth_format,
                                     static_cast<VkSampleCountFlagBits>(multisamples),
-                                    load_op,
+                                    depth_load_op,
                                     VK_ATTACHMENT_STORE_OP_STORE,
                                     VK_ATTACHMENT_LOAD_OP_DONT_CARE,
                                     VK_ATTACHMENT_STORE_OP_DONT_CARE,
@@ -69,7 +69,15 @@ public:
   VkImageView GetDummyImageView() const { return m_dummy_texture->GetView(); }
   // Render pass cache.
   VkRenderPass GetRenderPass(VkFormat color_format, VkFormat depth_format, u32 multisamples,
-                             VkAttachmentLoadOp load_op);
+                             VkAttachmentLoadOp load_op)
+  {
+    return GetRenderPass(color_format, depth_format, multisamples, load_op, load_op);
+  }
+
+  // Tile-based GPUs can skip reading in an attachment from memory if its previous contents are
+  // not needed, so the color and depth attachments can use different load ops.
+  VkRenderPass GetRenderPass(VkFormat color_format, VkFormat depth_format, u32 multisamples,
+                             VkAttachmentLoadOp color_load_op, VkAttachmentLoadOp depth_load_op);
 
   // Perform at startup, create descriptor layouts, compiles all static shaders.
   bool Initialize();
@@ -98,13 +106,14 @@ private:
   VkSampler m_point_sampler = VK_NULL_HANDLE;
   VkSampler m_linear_sampler = VK_NULL_HANDLE;
 
-  std::map<SamplerState, VkSampler> m_sampler_cache;
+  std::unordered_map<SamplerState::StorageType, VkSampler> m_sampler_cache;
 
   // Dummy image for samplers that are unbound
   std::unique_ptr<Texture2D> m_dummy_texture;
 
   // Render pass cache
-  using RenderPassCacheKey = std::tuple<VkFormat, VkFormat, u32, VkAttachmentLoadOp>;
+  using RenderPassCacheKey =
+      std::tuple<VkFormat, VkFormat, u32, VkAttachmentLoadOp, VkAttachmentLoadOp>;
   std::map<RenderPassCacheKey, VkRenderPass> m_render_pass_cache;
 };
 
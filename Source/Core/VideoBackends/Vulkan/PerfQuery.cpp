@@ -159,6 +159,11 @@ void PerfQuery::FlushResults()
     BlockingPartialFlush();
 }
 
+void PerfQuery::PollResults()
+{
+  NonBlockingPartialFlush();
+}
+
 bool PerfQuery::IsFlushed() const
 {
   return m_query_count == 0;
@@ -24,8 +24,8 @@ VulkanPostProcessing::~VulkanPostProcessing()
 {
   if (m_default_fragment_shader != VK_NULL_HANDLE)
     vkDestroyShaderModule(g_vulkan_context->GetDevice(), m_default_fragment_shader, nullptr);
-  if (m_fragment_shader != VK_NULL_HANDLE)
-    vkDestroyShaderModule(g_vulkan_context->GetDevice(), m_fragment_shader, nullptr);
+  for (const auto& it : m_fragment_shaders)
+    vkDestroyShaderModule(g_vulkan_context->GetDevice(), it.second, nullptr);
 }
 
 bool VulkanPostProcessing::Initialize(const Texture2D* font_texture)
@@ -234,17 +234,7 @@ bool VulkanPostProcessing::CompileDefaultShader()
 
 bool VulkanPostProcessing::RecompileShader()
 {
-  // As a driver can return the same new module pointer when destroying a shader and re-compiling,
-  // we need to wipe out the pipeline cache, otherwise we risk using old pipelines with old shaders.
-  // We can't just clear a single pipeline, because we don't know which render pass is going to be
-  // used here either.
-  if (m_fragment_shader != VK_NULL_HANDLE)
-  {
-    g_command_buffer_mgr->WaitForGPUIdle();
-    g_shader_cache->ClearPipelineCache();
-    vkDestroyShaderModule(g_vulkan_context->GetDevice(), m_fragment_shader, nullptr);
-    m_fragment_shader = VK_NULL_HANDLE;
-  }
+  m_fragment_shader = VK_NULL_HANDLE;
 
   // If post-processing is disabled, just use the default shader.
   // This way we don't need to allocate uniforms.
@@ -255,6 +245,13 @@ bool VulkanPostProcessing::RecompileShader()
   std::string main_code = m_config.LoadShader();
   std::string options_code = GetGLSLUniformBlock();
   std::string code = options_code + POSTPROCESSING_SHADER_HEADER + main_code;
+  auto iter = m_fragment_shaders.find(code);
+  if (iter != m_fragment_shaders.end())
+  {
+    m_fragment_shader = iter->second;
+    return true;
+  }
+
   m_fragment_shader = Util::CompileAndCreateFragmentShader(code);
   if (m_fragment_shader == VK_NULL_HANDLE)
   {
@@ -263,6 +260,7 @@ bool VulkanPostProcessing::RecompileShader()
     return false;
   }
 
+  m_fragment_shaders.emplace(std::move(code), m_fragment_shader);
   return true;
 }
 
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 
 #include "VideoBackends/Vulkan/VulkanContext.h"
 
@@ -39,6 +40,10 @@ private:
 
   const Texture2D* m_font_texture = nullptr;
   VkShaderModule m_fragment_shader = VK_NULL_HANDLE;
+
+  // Modules are kept until shutdown, keyed by their source. Since a module is never destroyed
+  // while in use, switching shaders needs neither a GPU idle wait nor a pipeline cache reset.
+  std::unordered_map<std::string, VkShaderModule> m_fragment_shaders;
   VkShaderModule m_default_fragment_shader = VK_NULL_HANDLE;
 };
 
@@ -579,10 +579,11 @@ void Renderer::ClearScreen(const EFBRectangle& rc, bool color_enable, bool alpha
   clear_depth_value.depthStencil.depth = (1.0f - (static_cast<float>(z & 0xFFFFFF) / 16777216.0f));
 
   // If we're not in a render pass (start of the frame), we can use a clear render pass
-  // to discard the data, rather than loading and then clearing.
+  // to discard the data, rather than loading and then clearing. When only color or only depth
+  // is cleared, the other attachment is loaded by the same pass.
   bool use_clear_attachments = (color_enable && alpha_enable) || z_enable;
-  bool use_clear_render_pass =
-      !StateTracker::GetInstance()->InRenderPass() && color_enable && alpha_enable && z_enable;
+  bool use_clear_render_pass = !StateTracker::GetInstance()->InRenderPass() &&
+                               use_clear_attachments && color_enable == alpha_enable;
 
   // The NVIDIA Vulkan driver causes the GPU to lock up, or throw exceptions if MSAA is enabled,
   // a non-full clear rect is specified, and a clear loadop or vkCmdClearAttachments is used.
@@ -601,9 +602,16 @@ void Renderer::ClearScreen(const EFBRectangle& rc, bool color_enable, bool alpha
   // Fastest path: Use a render pass to clear the buffers.
   if (use_clear_render_pass)
   {
+    FramebufferManager* framebuffer_mgr = FramebufferManager::GetInstance();
+    VkRenderPass render_pass = framebuffer_mgr->GetEFBClearRenderPass();
+    if (!z_enable)
+      render_pass = framebuffer_mgr->GetEFBClearColorRenderPass();
+    else if (!color_enable)
+      render_pass = framebuffer_mgr->GetEFBClearDepthRenderPass();
+
     const std::array<VkClearValue, 2> clear_values = {{clear_color_value, clear_depth_value}};
-    StateTracker::GetInstance()->BeginClearRenderPass(target_vk_rc, clear_values.data(),
-                                                      static_cast<u32>(clear_values.size()));
+    StateTracker::GetInstance()->BeginClearRenderPass(
+        target_vk_rc, clear_values.data(), static_cast<u32>(clear_values.size()), render_pass);
     return;
   }
 
@@ -720,6 +728,7 @@ void Renderer::SwapImpl(AbstractTexture* texture, const EFBRectangle& xfb_region
   // In other words, the last frame has been submitted (otherwise the next call would
   // be a race, as the image may not have been consumed yet).
   g_command_buffer_mgr->PrepareToSubmitCommandBuffer();
+  const u64 frame_fence_counter = g_command_buffer_mgr->GetCurrentFenceCounter();
 
   // Draw to the screen if we have a swap chain.
   if (m_swap_chain)
@@ -748,6 +757,14 @@ void Renderer::SwapImpl(AbstractTexture* texture, const EFBRectangle& xfb_region
   // Prep for the next frame (get command buffer ready) before doing anything else.
   BeginFrame();
 
+  // In low latency mode, don't let the CPU run ahead of the GPU. Waiting here, after the next
+  // command buffer has been activated, leaves the worker thread free to present.
+  if (g_ActiveConfig.bLowLatencyPresent)
+  {
+    g_command_buffer_mgr->WaitForWorkerThreadIdle();
+    g_command_buffer_mgr->WaitForFenceCounter(frame_fence_counter);
+  }
+
   // Restore the EFB color texture to color attachment ready for rendering the next frame.
   FramebufferManager::GetInstance()->GetEFBColorTexture()->TransitionToLayout(
       g_command_buffer_mgr->GetCurrentCommandBuffer(), VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
@@ -758,6 +775,9 @@ void Renderer::SwapImpl(AbstractTexture* texture, const EFBRectangle& xfb_region
 
   // Clean up stale textures.
   TextureCache::GetInstance()->Cleanup(frameCount);
+
+  // Merge the pipelines compiled during the frame into the main pipeline cache.
+  g_shader_cache->MergePipelineCachesIfIdle();
 }
 
 void Renderer::DrawScreen(VKTexture* xfb_texture, const EFBRectangle& xfb_region)
@@ -895,7 +915,8 @@ void Renderer::CheckForSurfaceChange()
         SwapChain::CreateVulkanSurface(g_vulkan_context->GetVulkanInstance(), m_surface_handle);
     if (surface != VK_NULL_HANDLE)
     {
-      m_swap_chain = SwapChain::Create(m_surface_handle, surface, g_ActiveConfig.IsVSync());
+      m_swap_chain = SwapChain::Create(m_surface_handle, surface, g_ActiveConfig.IsVSync(),
+                                       g_ActiveConfig.bLowLatencyPresent);
       if (!m_swap_chain)
         PanicAlert("Failed to create swap chain.");
     }
@@ -982,6 +1003,12 @@ void Renderer::CheckForConfigChanges()
     m_swap_chain->SetVSync(g_ActiveConfig.IsVSync());
   }
 
+  if (m_swap_chain && g_ActiveConfig.bLowLatencyPresent != m_swap_chain->IsLowLatencyEnabled())
+  {
+    g_command_buffer_mgr->WaitForGPUIdle();
+    m_swap_chain->SetLowLatency(g_ActiveConfig.bLowLatencyPresent);
+  }
+
   // For quad-buffered stereo we need to change the layer count, so recreate the swap chain.
   if (m_swap_chain &&
       (g_ActiveConfig.stereo_mode == StereoMode::QuadBuffer) != m_swap_chain->IsStereoEnabled())
@@ -1165,6 +1192,10 @@ void Renderer::ResetSamplerStates()
 
   // Invalidate all sampler objects (some will be unused now).
   g_object_cache->ClearSamplerCache();
+
+  // Descriptor sets written earlier may refer to the destroyed samplers, and new samplers can get
+  // the same handles, so don't reuse any of them.
+  StateTracker::GetInstance()->InvalidateDescriptorSets();
 }
 
 void Renderer::SetInterlacingMode()
@@ -12,6 +12,7 @@
 #include "Common/Assert.h"
 #include "Common/CommonFuncs.h"
 #include "Common/LinearDiskCache.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 
 #include "Core/ConfigManager.h"
@@ -23,6 +24,7 @@
 #include "VideoBackends/Vulkan/Util.h"
 #include "VideoBackends/Vulkan/VertexFormat.h"
 #include "VideoBackends/Vulkan/VulkanContext.h"
+#include "VideoCommon/ShaderGenCommon.h"
 #include "VideoCommon/Statistics.h"
 
 namespace Vulkan
@@ -41,8 +43,13 @@ ShaderCache::~ShaderCache()
 
 bool ShaderCache::Initialize()
 {
+  // Set up the compiler once, rather than on the first compile of whichever thread gets there.
+  if (!g_vulkan_context->SupportsNVGLSLExtension() && !ShaderCompiler::InitializeGlslang())
+    return false;
+
   if (g_ActiveConfig.bShaderCache)
   {
+    LoadSPIRVCache();
     if (!LoadPipelineCache())
       return false;
   }
@@ -62,6 +69,7 @@ void ShaderCache::Shutdown()
 {
   if (g_ActiveConfig.bShaderCache && m_pipeline_cache != VK_NULL_HANDLE)
     SavePipelineCache();
+  CloseSPIRVCache();
 }
 
 static bool IsStripPrimitiveTopology(VkPrimitiveTopology topology)
@@ -363,8 +371,11 @@ VkPipeline ShaderCache::CreatePipeline(const PipelineInfo& info)
   };
 
   VkPipeline pipeline;
-  VkResult res = vkCreateGraphicsPipelines(g_vulkan_context->GetDevice(), m_pipeline_cache, 1,
+  VkPipelineCache pipeline_cache = AcquirePipelineCache();
+  VkResult res = vkCreateGraphicsPipelines(g_vulkan_context->GetDevice(), pipeline_cache, 1,
                                            &pipeline_info, nullptr, &pipeline);
+  ReleasePipelineCache(pipeline_cache);
+  m_pipelines_created++;
   if (res != VK_SUCCESS)
   {
     LOG_VULKAN_ERROR(res, "vkCreateGraphicsPipelines failed: ");
@@ -458,6 +469,44 @@ public:
   void Read(const u32& key, const u8* value, u32 value_size) override {}
 };
 
+class SPIRVCacheReadCallback : public LinearDiskCacheReader<u64, ShaderCompiler::SPIRVCodeType>
+{
+public:
+  SPIRVCacheReadCallback(std::unordered_map<u64, ShaderCompiler::SPIRVCodeVector>* cache)
+      : m_cache(cache)
+  {
+  }
+  void Read(const u64& key, const ShaderCompiler::SPIRVCodeType* value, u32 value_size) override
+  {
+    m_cache->emplace(key, ShaderCompiler::SPIRVCodeVector(value, value + value_size));
+  }
+
+private:
+  std::unordered_map<u64, ShaderCompiler::SPIRVCodeVector>* m_cache;
+};
+
+static bool GetPipelineCacheData(VkPipelineCache cache, std::vector<u8>* data)
+{
+  size_t data_size;
+  VkResult res = vkGetPipelineCacheData(g_vulkan_context->GetDevice(), cache, &data_size, nullptr);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkGetPipelineCacheData failed: ");
+    return false;
+  }
+
+  data->resize(data_size);
+  res = vkGetPipelineCacheData(g_vulkan_context->GetDevice(), cache, &data_size, data->data());
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkGetPipelineCacheData failed: ");
+    return false;
+  }
+
+  data->resize(data_size);
+  return true;
+}
+
 bool ShaderCache::CreatePipelineCache()
 {
   // Vulkan pipeline caches can be shared between games for shader compile time reduction.
@@ -586,30 +635,120 @@ bool ShaderCache::ValidatePipelineCache(const u8* data, size_t data_length)
 void ShaderCache::DestroyPipelineCache()
 {
   ClearPipelineCache();
+
+  {
+    std::lock_guard<std::mutex> guard(m_pipeline_cache_partitions_lock);
+    for (VkPipelineCache partition : m_pipeline_cache_partitions)
+      vkDestroyPipelineCache(g_vulkan_context->GetDevice(), partition, nullptr);
+    m_pipeline_cache_partitions.clear();
+    m_free_pipeline_cache_partitions.clear();
+  }
+
   vkDestroyPipelineCache(g_vulkan_context->GetDevice(), m_pipeline_cache, nullptr);
   m_pipeline_cache = VK_NULL_HANDLE;
 }
 
-void ShaderCache::SavePipelineCache()
+VkPipelineCache ShaderCache::AcquirePipelineCache()
 {
-  size_t data_size;
-  VkResult res =
-      vkGetPipelineCacheData(g_vulkan_context->GetDevice(), m_pipeline_cache, &data_size, nullptr);
+  std::lock_guard<std::mutex> guard(m_pipeline_cache_partitions_lock);
+  if (!m_free_pipeline_cache_partitions.empty())
+  {
+    VkPipelineCache partition = m_free_pipeline_cache_partitions.back();
+    m_free_pipeline_cache_partitions.pop_back();
+    return partition;
+  }
+
+  // New partitions start with the contents of the main cache, so that pipelines which were loaded
+  // from disk or merged from other partitions can still be found.
+  std::vector<u8> data;
+  if (!GetPipelineCacheData(m_pipeline_cache, &data))
+    data.clear();
+
+  VkPipelineCacheCreateInfo info = {
+      VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,  // VkStructureType            sType
+      nullptr,                                       // const void*                pNext
+      0,                                             // VkPipelineCacheCreateFlags flags
+      data.size(),                                   // size_t                     initialDataSize
+      data.data()                                    // const void*                pInitialData
+  };
+
+  // The main cache can't be used directly, as it is written to when merging, so create the
+  // pipeline without a cache if this fails.
+  VkPipelineCache partition;
+  VkResult res = vkCreatePipelineCache(g_vulkan_context->GetDevice(), &info, nullptr, &partition);
   if (res != VK_SUCCESS)
   {
-    LOG_VULKAN_ERROR(res, "vkGetPipelineCacheData failed: ");
-    return;
+    LOG_VULKAN_ERROR(res, "vkCreatePipelineCache failed: ");
+    return VK_NULL_HANDLE;
   }
 
-  std::vector<u8> data(data_size);
-  res = vkGetPipelineCacheData(g_vulkan_context->GetDevice(), m_pipeline_cache, &data_size,
-                               data.data());
+  m_pipeline_cache_partitions.push_back(partition);
+  return partition;
+}
+
+void ShaderCache::ReleasePipelineCache(VkPipelineCache cache)
+{
+  if (cache == VK_NULL_HANDLE)
+    return;
+
+  std::lock_guard<std::mutex> guard(m_pipeline_cache_partitions_lock);
+  m_free_pipeline_cache_partitions.push_back(cache);
+}
+
+void ShaderCache::MergePipelineCaches()
+{
+  std::lock_guard<std::mutex> guard(m_pipeline_cache_partitions_lock);
+  if (m_pipeline_cache_partitions.empty())
+    return;
+
+  // Only the destination cache has to be externally synchronized, so partitions which are
+  // currently in use by other threads can be merged too.
+  VkResult res = vkMergePipelineCaches(g_vulkan_context->GetDevice(), m_pipeline_cache,
+                                       static_cast<u32>(m_pipeline_cache_partitions.size()),
+                                       m_pipeline_cache_partitions.data());
   if (res != VK_SUCCESS)
   {
-    LOG_VULKAN_ERROR(res, "vkGetPipelineCacheData failed: ");
+    LOG_VULKAN_ERROR(res, "vkMergePipelineCaches failed: ");
+    return;
+  }
+
+  // Destroy the partitions which aren't in use, rather than merging their contents again next
+  // time. They are re-created from the main cache when needed.
+  for (VkPipelineCache partition : m_free_pipeline_cache_partitions)
+  {
+    vkDestroyPipelineCache(g_vulkan_context->GetDevice(), partition, nullptr);
+    m_pipeline_cache_partitions.erase(std::find(m_pipeline_cache_partitions.begin(),
+                                                m_pipeline_cache_partitions.end(), partition));
+  }
+  m_free_pipeline_cache_partitions.clear();
+}
+
+void ShaderCache::MergePipelineCachesIfIdle()
+{
+  // Merging while a burst of pipelines is being compiled would stall the compiler threads, so
+  // wait for a frame in which no pipelines were created.
+  const u32 pipelines_created = m_pipelines_created.load();
+  if (pipelines_created != m_pipelines_created_last_frame)
+  {
+    m_pipelines_created_last_frame = pipelines_created;
     return;
   }
 
+  if (pipelines_created == m_pipelines_created_last_merge)
+    return;
+
+  MergePipelineCaches();
+  m_pipelines_created_last_merge = pipelines_created;
+}
+
+void ShaderCache::SavePipelineCache()
+{
+  MergePipelineCaches();
+
+  std::vector<u8> data;
+  if (!GetPipelineCacheData(m_pipeline_cache, &data))
+    return;
+
   // Delete the old cache and re-create.
   File::Delete(m_pipeline_cache_filename);
 
@@ -623,6 +762,72 @@ void ShaderCache::SavePipelineCache()
   disk_cache.Close();
 }
 
+void ShaderCache::LoadSPIRVCache()
+{
+  const std::string filename = GetDiskShaderCacheFileName(APIType::Vulkan, "SPIRV", false, false);
+
+  std::lock_guard<std::mutex> guard(m_spirv_cache_lock);
+  SPIRVCacheReadCallback callback(&m_spirv_cache);
+  const u32 count = m_spirv_disk_cache.OpenAndRead(filename, callback);
+  INFO_LOG(VIDEO, "Loaded %u cached utility shaders from %s", count, filename.c_str());
+}
+
+void ShaderCache::CloseSPIRVCache()
+{
+  std::lock_guard<std::mutex> guard(m_spirv_cache_lock);
+  m_spirv_disk_cache.Sync();
+  m_spirv_disk_cache.Close();
+}
+
+bool ShaderCache::CompileUtilityShader(ShaderCompiler::SPIRVCodeVector* out_code,
+                                       ShaderStage stage, const std::string& source_code)
+{
+  // The stage picks the header the source is compiled with, and NV_glsl_shader "SPIR-V" is just
+  // the GLSL source, so both go into the key.
+  const u64 seed = static_cast<u64>(stage) * 2 + g_vulkan_context->SupportsNVGLSLExtension();
+  const u64 key = XXH64(source_code.data(), source_code.size(), seed);
+  {
+    std::lock_guard<std::mutex> guard(m_spirv_cache_lock);
+    auto iter = m_spirv_cache.find(key);
+    if (iter != m_spirv_cache.end())
+    {
+      *out_code = iter->second;
+      return true;
+    }
+  }
+
+  // Compile without holding the lock, so that other threads aren't held up by this shader.
+  bool result;
+  switch (stage)
+  {
+  case ShaderStage::Vertex:
+    result = ShaderCompiler::CompileVertexShader(out_code, source_code.c_str(), source_code.size());
+    break;
+  case ShaderStage::Geometry:
+    result =
+        ShaderCompiler::CompileGeometryShader(out_code, source_code.c_str(), source_code.size());
+    break;
+  case ShaderStage::Pixel:
+    result =
+        ShaderCompiler::CompileFragmentShader(out_code, source_code.c_str(), source_code.size());
+    break;
+  case ShaderStage::Compute:
+    result =
+        ShaderCompiler::CompileComputeShader(out_code, source_code.c_str(), source_code.size());
+    break;
+  default:
+    result = false;
+    break;
+  }
+  if (!result)
+    return false;
+
+  std::lock_guard<std::mutex> guard(m_spirv_cache_lock);
+  if (m_spirv_cache.emplace(key, *out_code).second && g_ActiveConfig.bShaderCache)
+    m_spirv_disk_cache.Append(key, out_code->data(), static_cast<u32>(out_code->size()));
+  return true;
+}
+
 void ShaderCache::RecompileSharedShaders()
 {
   DestroySharedShaders();
@@ -634,11 +839,17 @@ void ShaderCache::ReloadPipelineCache()
 {
   SavePipelineCache();
   DestroyPipelineCache();
+  CloseSPIRVCache();
 
   if (g_ActiveConfig.bShaderCache)
+  {
+    LoadSPIRVCache();
     LoadPipelineCache();
+  }
   else
+  {
     CreatePipelineCache();
+  }
 }
 
 std::string ShaderCache::GetUtilityShaderHeader() const
@@ -5,12 +5,15 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/LinearDiskCache.h"
@@ -19,6 +22,7 @@
 #include "VideoBackends/Vulkan/ObjectCache.h"
 #include "VideoBackends/Vulkan/ShaderCompiler.h"
 
+#include "VideoCommon/AbstractShader.h"
 #include "VideoCommon/RenderState.h"
 
 namespace Vulkan
@@ -105,12 +109,21 @@ public:
   // Saves the pipeline cache to disk. Call when shutting down.
   void SavePipelineCache();
 
+  // Merges the per-thread pipeline caches into the main cache, if no pipelines have been created
+  // since the last call. Call once per frame.
+  void MergePipelineCachesIfIdle();
+
   // Recompile shared shaders, call when stereo mode changes.
   void RecompileSharedShaders();
 
   // Reload pipeline cache. This will destroy all pipelines.
   void ReloadPipelineCache();
 
+  // Compiles one of the backend's own shaders, or returns the SPIR-V of an earlier compile of the
+  // same source. Shaders from the shader generators are cached by UID in VideoCommon instead.
+  bool CompileUtilityShader(ShaderCompiler::SPIRVCodeVector* out_code, ShaderStage stage,
+                            const std::string& source_code);
+
   // Shared shader accessors
   VkShaderModule GetScreenQuadVertexShader() const { return m_screen_quad_vertex_shader; }
   VkShaderModule GetPassthroughVertexShader() const { return m_passthrough_vertex_shader; }
@@ -122,6 +135,11 @@ private:
   bool LoadPipelineCache();
   bool ValidatePipelineCache(const u8* data, size_t data_length);
   void DestroyPipelineCache();
+  VkPipelineCache AcquirePipelineCache();
+  void ReleasePipelineCache(VkPipelineCache cache);
+  void MergePipelineCaches();
+  void LoadSPIRVCache();
+  void CloseSPIRVCache();
   bool CompileSharedShaders();
   void DestroySharedShaders();
 
@@ -131,6 +149,21 @@ private:
   VkPipelineCache m_pipeline_cache = VK_NULL_HANDLE;
   std::string m_pipeline_cache_filename;
 
+  // Pipelines are created with one of several partitions of the pipeline cache, each used by a
+  // single thread at a time, so that compiler threads don't contend on the main cache's lock.
+  // The partitions are merged into the main cache at idle points, and before it is saved.
+  std::vector<VkPipelineCache> m_pipeline_cache_partitions;
+  std::vector<VkPipelineCache> m_free_pipeline_cache_partitions;
+  std::mutex m_pipeline_cache_partitions_lock;
+  std::atomic<u32> m_pipelines_created{0};
+  u32 m_pipelines_created_last_frame = 0;
+  u32 m_pipelines_created_last_merge = 0;
+
+  // SPIR-V of the utility shaders, keyed by a hash of their source
+  std::unordered_map<u64, ShaderCompiler::SPIRVCodeVector> m_spirv_cache;
+  LinearDiskCache<u64, ShaderCompiler::SPIRVCodeType> m_spirv_disk_cache;
+  std::mutex m_spirv_cache_lock;
+
   // Utility/shared shaders
   VkShaderModule m_screen_quad_vertex_shader = VK_NULL_HANDLE;
   VkShaderModule m_passthrough_vertex_shader = VK_NULL_HANDLE;
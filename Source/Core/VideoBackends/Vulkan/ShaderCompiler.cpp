@@ -28,9 +28,6 @@ namespace Vulkan
 {
 namespace ShaderCompiler
 {
-// Registers itself for cleanup via atexit
-bool InitializeGlslang();
-
 // Resource limits used when compiling shaders
 static const TBuiltInResource* GetCompilerResourceLimits();
 
@@ -264,20 +261,19 @@ void CopyGLSLToSPVVector(SPIRVCodeVector* out_code, const char* stage_filename,
 
 bool InitializeGlslang()
 {
-  static bool glslang_initialized = false;
-  if (glslang_initialized)
-    return true;
-
-  if (!glslang::InitializeProcess())
-  {
-    PanicAlert("Failed to initialize glslang shader compiler");
-    return false;
-  }
-
-  std::atexit([]() { glslang::FinalizeProcess(); });
+  // Shaders are compiled on several threads, so this is done exactly once. The cleanup is
+  // registered via atexit.
+  static const bool glslang_initialized = [] {
+    if (!glslang::InitializeProcess())
+    {
+      PanicAlert("Failed to initialize glslang shader compiler");
+      return false;
+    }
 
-  glslang_initialized = true;
-  return true;
+    std::atexit([]() { glslang::FinalizeProcess(); });
+    return true;
+  }();
+  return glslang_initialized;
 }
 
 const TBuiltInResource* GetCompilerResourceLimits()
@@ -17,6 +17,10 @@ namespace ShaderCompiler
 using SPIRVCodeType = u32;
 using SPIRVCodeVector = std::vector<SPIRVCodeType>;
 
+// Initializes glslang for the process, if it hasn't been already. Safe to call from any thread,
+// the compile functions call it as well.
+bool InitializeGlslang();
+
 // Compile a vertex shader to SPIR-V.
 bool CompileVertexShader(SPIRVCodeVector* out_code, const char* source_code,
                          size_t source_code_length);
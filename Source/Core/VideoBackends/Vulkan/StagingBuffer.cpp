@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <cstring>
 
+#include "Common/Align.h"
 #include "Common/Assert.h"
 
 #include "VideoBackends/Vulkan/CommandBufferManager.h"
@@ -14,9 +15,10 @@
 
 namespace Vulkan
 {
-StagingBuffer::StagingBuffer(STAGING_BUFFER_TYPE type, VkBuffer buffer, VkDeviceMemory memory,
-                             VkDeviceSize size, bool coherent)
-    : m_type(type), m_buffer(buffer), m_memory(memory), m_size(size), m_coherent(coherent)
+StagingBuffer::StagingBuffer(STAGING_BUFFER_TYPE type, VkBuffer buffer,
+                             const MemoryAllocator::Allocation& allocation, VkDeviceSize size,
+                             bool coherent)
+    : m_type(type), m_buffer(buffer), m_allocation(allocation), m_size(size), m_coherent(coherent)
 {
 }
 
@@ -26,7 +28,7 @@ StagingBuffer::~StagingBuffer()
   if (m_map_pointer)
     Unmap();
 
-  g_command_buffer_mgr->DeferDeviceMemoryDestruction(m_memory);
+  g_command_buffer_mgr->DeferAllocationDestruction(m_allocation);
   g_command_buffer_mgr->DeferBufferDestruction(m_buffer);
 }
 
@@ -41,16 +43,7 @@ bool StagingBuffer::Map(VkDeviceSize offset, VkDeviceSize size)
   ASSERT(!m_map_pointer);
   ASSERT(m_map_offset + m_map_size <= m_size);
 
-  void* map_pointer;
-  VkResult res = vkMapMemory(g_vulkan_context->GetDevice(), m_memory, m_map_offset, m_map_size, 0,
-                             &map_pointer);
-  if (res != VK_SUCCESS)
-  {
-    LOG_VULKAN_ERROR(res, "vkMapMemory failed: ");
-    return false;
-  }
-
-  m_map_pointer = reinterpret_cast<char*>(map_pointer);
+  m_map_pointer = m_allocation.map_pointer + m_map_offset;
   return true;
 }
 
@@ -58,7 +51,6 @@ void StagingBuffer::Unmap()
 {
   ASSERT(m_map_pointer);
 
-  vkUnmapMemory(g_vulkan_context->GetDevice(), m_memory);
   m_map_pointer = nullptr;
   m_map_offset = 0;
   m_map_size = 0;
@@ -70,8 +62,7 @@ void StagingBuffer::FlushCPUCache(VkDeviceSize offset, VkDeviceSize size)
   if (m_coherent)
     return;
 
-  VkMappedMemoryRange range = {VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, nullptr, m_memory,
-                               offset - m_map_offset, size};
+  VkMappedMemoryRange range = GetMappedMemoryRange(offset, size);
   vkFlushMappedMemoryRanges(g_vulkan_context->GetDevice(), 1, &range);
 }
 
@@ -119,8 +110,7 @@ void StagingBuffer::InvalidateCPUCache(VkDeviceSize offset, VkDeviceSize size)
   if (m_coherent)
     return;
 
-  VkMappedMemoryRange range = {VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, nullptr, m_memory,
-                               offset - m_map_offset, size};
+  VkMappedMemoryRange range = GetMappedMemoryRange(offset, size);
   vkInvalidateMappedMemoryRanges(g_vulkan_context->GetDevice(), 1, &range);
 }
 
@@ -145,9 +135,23 @@ void StagingBuffer::Write(VkDeviceSize offset, const void* data, size_t size,
     FlushCPUCache(offset, size);
 }
 
+VkMappedMemoryRange StagingBuffer::GetMappedMemoryRange(VkDeviceSize offset,
+                                                       VkDeviceSize size) const
+{
+  // The allocator aligns non-coherent allocations to whole atoms, so the expanded range never
+  // touches the memory of another allocation.
+  const VkDeviceSize atom_size = g_vulkan_context->GetDeviceLimits().nonCoherentAtomSize;
+  const VkDeviceSize end = size == VK_WHOLE_SIZE ? m_size : offset + size;
+  const VkDeviceSize start = Common::AlignDown(m_allocation.offset + offset, atom_size);
+  return {VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, nullptr, m_allocation.memory, start,
+          std::min(Common::AlignUp(m_allocation.offset + end, atom_size),
+                   m_allocation.offset + m_allocation.size) -
+              start};
+}
+
 bool StagingBuffer::AllocateBuffer(STAGING_BUFFER_TYPE type, VkDeviceSize size,
                                    VkBufferUsageFlags usage, VkBuffer* out_buffer,
-                                   VkDeviceMemory* out_memory, bool* out_coherent)
+                                   MemoryAllocator::Allocation* out_allocation, bool* out_coherent)
 {
   VkBufferCreateInfo buffer_create_info = {
       VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,  // VkStructureType        sType
@@ -176,26 +180,20 @@ bool StagingBuffer::AllocateBuffer(STAGING_BUFFER_TYPE type, VkDeviceSize size,
   else
     type_index = g_vulkan_context->GetReadbackMemoryType(requirements.memoryTypeBits, out_coherent);
 
-  VkMemoryAllocateInfo memory_allocate_info = {
-      VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,  // VkStructureType    sType
-      nullptr,                                 // const void*        pNext
-      requirements.size,                       // VkDeviceSize       allocationSize
-      type_index                               // uint32_t           memoryTypeIndex
-  };
-  res = vkAllocateMemory(g_vulkan_context->GetDevice(), &memory_allocate_info, nullptr, out_memory);
-  if (res != VK_SUCCESS)
+  if (!g_memory_allocator->Allocate(requirements, type_index,
+                                    MemoryAllocator::ResourceType::Linear, out_allocation))
   {
-    LOG_VULKAN_ERROR(res, "vkAllocateMemory failed: ");
     vkDestroyBuffer(g_vulkan_context->GetDevice(), *out_buffer, nullptr);
     return false;
   }
 
-  res = vkBindBufferMemory(g_vulkan_context->GetDevice(), *out_buffer, *out_memory, 0);
+  res = vkBindBufferMemory(g_vulkan_context->GetDevice(), *out_buffer, out_allocation->memory,
+                           out_allocation->offset);
   if (res != VK_SUCCESS)
   {
     LOG_VULKAN_ERROR(res, "vkBindBufferMemory failed: ");
     vkDestroyBuffer(g_vulkan_context->GetDevice(), *out_buffer, nullptr);
-    vkFreeMemory(g_vulkan_context->GetDevice(), *out_memory, nullptr);
+    g_memory_allocator->Free(*out_allocation);
     return false;
   }
 
@@ -206,12 +204,12 @@ std::unique_ptr<StagingBuffer> StagingBuffer::Create(STAGING_BUFFER_TYPE type, V
                                                      VkBufferUsageFlags usage)
 {
   VkBuffer buffer;
-  VkDeviceMemory memory;
+  MemoryAllocator::Allocation allocation;
   bool coherent;
-  if (!AllocateBuffer(type, size, usage, &buffer, &memory, &coherent))
+  if (!AllocateBuffer(type, size, usage, &buffer, &allocation, &coherent))
     return nullptr;
 
-  return std::make_unique<StagingBuffer>(type, buffer, memory, size, coherent);
+  return std::make_unique<StagingBuffer>(type, buffer, allocation, size, coherent);
 }
 
 }  // namespace Vulkan
@@ -8,14 +8,15 @@
 #include <memory>
 
 #include "VideoBackends/Vulkan/Constants.h"
+#include "VideoBackends/Vulkan/MemoryAllocator.h"
 
 namespace Vulkan
 {
 class StagingBuffer
 {
 public:
-  StagingBuffer(STAGING_BUFFER_TYPE type, VkBuffer buffer, VkDeviceMemory memory, VkDeviceSize size,
-                bool coherent);
+  StagingBuffer(STAGING_BUFFER_TYPE type, VkBuffer buffer,
+                const MemoryAllocator::Allocation& allocation, VkDeviceSize size, bool coherent);
   virtual ~StagingBuffer();
 
   STAGING_BUFFER_TYPE GetType() const { return m_type; }
@@ -26,6 +27,7 @@ public:
   char* GetMapPointer() { return m_map_pointer; }
   VkDeviceSize GetMapOffset() const { return m_map_offset; }
   VkDeviceSize GetMapSize() const { return m_map_size; }
+  // The backing memory is persistently mapped, so mapping only selects the accessible range.
   bool Map(VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE);
   void Unmap();
 
@@ -61,12 +63,16 @@ public:
 
   // Allocates the resources needed to create a staging buffer.
   static bool AllocateBuffer(STAGING_BUFFER_TYPE type, VkDeviceSize size, VkBufferUsageFlags usage,
-                             VkBuffer* out_buffer, VkDeviceMemory* out_memory, bool* out_coherent);
+                             VkBuffer* out_buffer, MemoryAllocator::Allocation* out_allocation,
+                             bool* out_coherent);
 
 protected:
+  // Converts a range of the buffer to a range of the underlying memory, expanded to whole atoms.
+  VkMappedMemoryRange GetMappedMemoryRange(VkDeviceSize offset, VkDeviceSize size) const;
+
   STAGING_BUFFER_TYPE m_type;
   VkBuffer m_buffer;
-  VkDeviceMemory m_memory;
+  MemoryAllocator::Allocation m_allocation;
   VkDeviceSize m_size;
   bool m_coherent;
 
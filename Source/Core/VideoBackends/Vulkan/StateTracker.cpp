@@ -4,7 +4,9 @@
 
 #include "VideoBackends/Vulkan/StateTracker.h"
 
+#include <algorithm>
 #include <cstring>
+#include <functional>
 
 #include "Common/Align.h"
 #include "Common/Assert.h"
@@ -346,6 +348,7 @@ void StateTracker::UnbindTexture(VkImageView view)
 void StateTracker::InvalidateDescriptorSets()
 {
   m_descriptor_sets.fill(VK_NULL_HANDLE);
+  m_sampler_descriptor_sets.clear();
   m_dirty_flags |= DIRTY_FLAG_ALL_DESCRIPTOR_SETS;
 }
 
@@ -369,6 +372,7 @@ void StateTracker::BeginRenderPass()
     return;
 
   m_current_render_pass = m_load_render_pass;
+  m_in_clear_render_pass = false;
   m_framebuffer_render_area = m_framebuffer_size;
 
   VkRenderPassBeginInfo begin_info = {VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
@@ -390,14 +394,22 @@ void StateTracker::EndRenderPass()
 
   vkCmdEndRenderPass(g_command_buffer_mgr->GetCurrentCommandBuffer());
   m_current_render_pass = VK_NULL_HANDLE;
+  m_in_clear_render_pass = false;
 }
 
 void StateTracker::BeginClearRenderPass(const VkRect2D& area, const VkClearValue* clear_values,
                                         u32 num_clear_values)
+{
+  BeginClearRenderPass(area, clear_values, num_clear_values, m_clear_render_pass);
+}
+
+void StateTracker::BeginClearRenderPass(const VkRect2D& area, const VkClearValue* clear_values,
+                                        u32 num_clear_values, VkRenderPass render_pass)
 {
   ASSERT(!InRenderPass());
 
-  m_current_render_pass = m_clear_render_pass;
+  m_current_render_pass = render_pass;
+  m_in_clear_render_pass = true;
   m_framebuffer_render_area = area;
 
   VkRenderPassBeginInfo begin_info = {VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
@@ -437,7 +449,7 @@ bool StateTracker::Bind(bool rebind_all /*= false*/)
     return false;
 
   // Check the render area if we were in a clear pass.
-  if (m_current_render_pass == m_clear_render_pass && !IsViewportWithinRenderArea())
+  if (m_in_clear_render_pass && !IsViewportWithinRenderArea())
     EndRenderPass();
 
   // Get a new descriptor set if any parts have changed
@@ -611,7 +623,7 @@ bool StateTracker::IsViewportWithinRenderArea() const
 
 void StateTracker::EndClearRenderPass()
 {
-  if (m_current_render_pass != m_clear_render_pass)
+  if (!m_in_clear_render_pass)
     return;
 
   // End clear render pass. Bind() will call BeginRenderPass() which
@@ -660,25 +672,38 @@ bool StateTracker::UpdateDescriptorSet()
   if (m_dirty_flags & DIRTY_FLAG_PS_SAMPLERS ||
       m_descriptor_sets[DESCRIPTOR_SET_BIND_POINT_PIXEL_SHADER_SAMPLERS] == VK_NULL_HANDLE)
   {
-    VkDescriptorSetLayout layout =
-        g_object_cache->GetDescriptorSetLayout(DESCRIPTOR_SET_LAYOUT_PIXEL_SHADER_SAMPLERS);
-    VkDescriptorSet set = g_command_buffer_mgr->AllocateDescriptorSet(layout);
-    if (set == VK_NULL_HANDLE)
-      return false;
+    VkDescriptorSet set;
+    auto iter = m_sampler_descriptor_sets.find(m_bindings.ps_samplers);
+    if (iter != m_sampler_descriptor_sets.end())
+    {
+      set = iter->second;
+    }
+    else
+    {
+      VkDescriptorSetLayout layout =
+          g_object_cache->GetDescriptorSetLayout(DESCRIPTOR_SET_LAYOUT_PIXEL_SHADER_SAMPLERS);
+      set = g_command_buffer_mgr->AllocateDescriptorSet(layout);
+      if (set == VK_NULL_HANDLE)
+        return false;
 
-    writes[num_writes++] = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-                            nullptr,
-                            set,
-                            0,
-                            0,
-                            static_cast<u32>(NUM_PIXEL_SHADER_SAMPLERS),
-                            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                            m_bindings.ps_samplers.data(),
-                            nullptr,
-                            nullptr};
+      writes[num_writes++] = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                              nullptr,
+                              set,
+                              0,
+                              0,
+                              static_cast<u32>(NUM_PIXEL_SHADER_SAMPLERS),
+                              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                              m_bindings.ps_samplers.data(),
+                              nullptr,
+                              nullptr};
+      m_sampler_descriptor_sets.emplace(m_bindings.ps_samplers, set);
+    }
 
-    m_descriptor_sets[DESCRIPTOR_SET_BIND_POINT_PIXEL_SHADER_SAMPLERS] = set;
-    m_dirty_flags |= DIRTY_FLAG_DESCRIPTOR_SET_BINDING;
+    if (m_descriptor_sets[DESCRIPTOR_SET_BIND_POINT_PIXEL_SHADER_SAMPLERS] != set)
+    {
+      m_descriptor_sets[DESCRIPTOR_SET_BIND_POINT_PIXEL_SHADER_SAMPLERS] = set;
+      m_dirty_flags |= DIRTY_FLAG_DESCRIPTOR_SET_BINDING;
+    }
   }
 
   if (g_vulkan_context->SupportsBoundingBox() &&
@@ -713,4 +738,25 @@ bool StateTracker::UpdateDescriptorSet()
   return true;
 }
 
+std::size_t StateTracker::SamplerBindingsHash::operator()(const SamplerBindings& key) const
+{
+  std::size_t hash = 0;
+  for (const VkDescriptorImageInfo& info : key)
+  {
+    hash = hash * 31 + std::hash<VkSampler>()(info.sampler);
+    hash = hash * 31 + std::hash<VkImageView>()(info.imageView);
+  }
+  return hash;
+}
+
+bool StateTracker::SamplerBindingsEqual::operator()(const SamplerBindings& lhs,
+                                                    const SamplerBindings& rhs) const
+{
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(),
+                    [](const VkDescriptorImageInfo& a, const VkDescriptorImageInfo& b) {
+                      return a.sampler == b.sampler && a.imageView == b.imageView &&
+                             a.imageLayout == b.imageLayout;
+                    });
+}
+
 }  // namespace Vulkan
@@ -7,6 +7,7 @@
 #include <array>
 #include <cstddef>
 #include <memory>
+#include <unordered_map>
 
 #include "Common/CommonTypes.h"
 #include "VideoBackends/Vulkan/Constants.h"
@@ -74,6 +75,9 @@ public:
   // Ends the current render pass if it was a clear render pass.
   void BeginClearRenderPass(const VkRect2D& area, const VkClearValue* clear_values,
                             u32 num_clear_values);
+  // Begins a pass which only clears some of the attachments, and loads the others.
+  void BeginClearRenderPass(const VkRect2D& area, const VkClearValue* clear_values,
+                            u32 num_clear_values, VkRenderPass render_pass);
   void EndClearRenderPass();
 
   void SetViewport(const VkViewport& viewport);
@@ -132,6 +136,16 @@ private:
 
   bool UpdateDescriptorSet();
 
+  using SamplerBindings = std::array<VkDescriptorImageInfo, NUM_PIXEL_SHADER_SAMPLERS>;
+  struct SamplerBindingsHash
+  {
+    std::size_t operator()(const SamplerBindings& key) const;
+  };
+  struct SamplerBindingsEqual
+  {
+    bool operator()(const SamplerBindings& lhs, const SamplerBindings& rhs) const;
+  };
+
   // Allocates storage in the uniform buffer of the specified size. If this storage cannot be
   // allocated immediately, the current command buffer will be submitted and all stage's
   // constants will be re-uploaded. false will be returned in this case, otherwise true.
@@ -166,6 +180,11 @@ private:
   size_t m_uniform_buffer_reserve_size = 0;
   u32 m_num_active_descriptor_sets = 0;
 
+  // Sampler descriptor sets written for the current command buffer, so that switching back to
+  // textures that were bound before doesn't need a new set. Cleared along with the descriptor pool.
+  std::unordered_map<SamplerBindings, VkDescriptorSet, SamplerBindingsHash, SamplerBindingsEqual>
+      m_sampler_descriptor_sets;
+
   // rasterization
   VkViewport m_viewport = {0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f};
   VkRect2D m_scissor = {{0, 0}, {1, 1}};
@@ -177,6 +196,7 @@ private:
   VkRenderPass m_load_render_pass = VK_NULL_HANDLE;
   VkRenderPass m_clear_render_pass = VK_NULL_HANDLE;
   VkRenderPass m_current_render_pass = VK_NULL_HANDLE;
+  bool m_in_clear_render_pass = false;
   VkRect2D m_framebuffer_size = {};
   VkRect2D m_framebuffer_render_area = {};
 
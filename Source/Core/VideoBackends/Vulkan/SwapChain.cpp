@@ -25,8 +25,9 @@
 
 namespace Vulkan
 {
-SwapChain::SwapChain(void* native_handle, VkSurfaceKHR surface, bool vsync)
-    : m_native_handle(native_handle), m_surface(surface), m_vsync_enabled(vsync)
+SwapChain::SwapChain(void* native_handle, VkSurfaceKHR surface, bool vsync, bool low_latency)
+    : m_native_handle(native_handle), m_surface(surface), m_vsync_enabled(vsync),
+      m_low_latency_enabled(low_latency)
 {
 }
 
@@ -127,10 +128,11 @@ VkSurfaceKHR SwapChain::CreateVulkanSurface(VkInstance instance, void* hwnd)
 #endif
 }
 
-std::unique_ptr<SwapChain> SwapChain::Create(void* native_handle, VkSurfaceKHR surface, bool vsync)
+std::unique_ptr<SwapChain> SwapChain::Create(void* native_handle, VkSurfaceKHR surface, bool vsync,
+                                             bool low_latency)
 {
   std::unique_ptr<SwapChain> swap_chain =
-      std::make_unique<SwapChain>(native_handle, surface, vsync);
+      std::make_unique<SwapChain>(native_handle, surface, vsync, low_latency);
 
   if (!swap_chain->CreateSwapChain() || !swap_chain->CreateRenderPass() ||
       !swap_chain->SetupSwapChainImages())
@@ -198,6 +200,14 @@ bool SwapChain::SelectPresentMode()
     return it != present_modes.end();
   };
 
+  // In low latency mode, mailbox still avoids tearing, but always presents the newest frame
+  // instead of queueing frames behind vblank.
+  if (m_vsync_enabled && m_low_latency_enabled && CheckForMode(VK_PRESENT_MODE_MAILBOX_KHR))
+  {
+    m_present_mode = VK_PRESENT_MODE_MAILBOX_KHR;
+    return true;
+  }
+
   // If vsync is enabled, use VK_PRESENT_MODE_FIFO_KHR.
   // This check should not fail with conforming drivers, as the FIFO present mode is mandated by
   // the specification (VK_KHR_swapchain). In case it isn't though, fall through to any other mode.
@@ -251,7 +261,10 @@ bool SwapChain::CreateSwapChain()
     return false;
 
   // Select number of images in swap chain, we prefer one buffer in the background to work on
-  uint32_t image_count = surface_capabilities.minImageCount + 1;
+  // In low latency mode with FIFO presentation, every extra image is another frame of latency.
+  uint32_t image_count = surface_capabilities.minImageCount;
+  if (!m_low_latency_enabled || m_present_mode != VK_PRESENT_MODE_FIFO_KHR)
+    image_count++;
 
   // maxImageCount can be zero, in which case there isn't an upper limit on the number of buffers.
   if (surface_capabilities.maxImageCount > 0)
@@ -458,6 +471,15 @@ bool SwapChain::SetVSync(bool enabled)
   return RecreateSwapChain();
 }
 
+bool SwapChain::SetLowLatency(bool enabled)
+{
+  if (m_low_latency_enabled == enabled)
+    return true;
+
+  m_low_latency_enabled = enabled;
+  return RecreateSwapChain();
+}
+
 bool SwapChain::RecreateSurface(void* native_handle)
 {
   // Destroy the old swap chain, images, and surface.
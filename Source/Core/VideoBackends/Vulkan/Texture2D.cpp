@@ -13,9 +13,9 @@ namespace Vulkan
 {
 Texture2D::Texture2D(u32 width, u32 height, u32 levels, u32 layers, VkFormat format,
                      VkSampleCountFlagBits samples, VkImageViewType view_type, VkImage image,
-                     VkDeviceMemory device_memory, VkImageView view)
+                     const MemoryAllocator::Allocation& allocation, VkImageView view)
     : m_width(width), m_height(height), m_levels(levels), m_layers(layers), m_format(format),
-      m_samples(samples), m_view_type(view_type), m_image(image), m_device_memory(device_memory),
+      m_samples(samples), m_view_type(view_type), m_image(image), m_allocation(allocation),
       m_view(view)
 {
 }
@@ -25,10 +25,10 @@ Texture2D::~Texture2D()
   g_command_buffer_mgr->DeferImageViewDestruction(m_view);
 
   // If we don't have device memory allocated, the image is not owned by us (e.g. swapchain)
-  if (m_device_memory != VK_NULL_HANDLE)
+  if (m_allocation.memory != VK_NULL_HANDLE)
   {
     g_command_buffer_mgr->DeferImageDestruction(m_image);
-    g_command_buffer_mgr->DeferDeviceMemoryDestruction(m_device_memory);
+    g_command_buffer_mgr->DeferAllocationDestruction(m_allocation);
   }
 }
 
@@ -65,26 +65,26 @@ std::unique_ptr<Texture2D> Texture2D::Create(u32 width, u32 height, u32 levels,
   VkMemoryRequirements memory_requirements;
   vkGetImageMemoryRequirements(g_vulkan_context->GetDevice(), image, &memory_requirements);
 
-  VkMemoryAllocateInfo memory_info = {
-      VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, nullptr, memory_requirements.size,
-      g_vulkan_context->GetMemoryType(memory_requirements.memoryTypeBits,
-                                      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)};
+  const u32 memory_type = g_vulkan_context->GetMemoryType(memory_requirements.memoryTypeBits,
+                                                          VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+  const MemoryAllocator::ResourceType resource_type = tiling == VK_IMAGE_TILING_OPTIMAL ?
+                                                          MemoryAllocator::ResourceType::Optimal :
+                                                          MemoryAllocator::ResourceType::Linear;
 
-  VkDeviceMemory device_memory;
-  res = vkAllocateMemory(g_vulkan_context->GetDevice(), &memory_info, nullptr, &device_memory);
-  if (res != VK_SUCCESS)
+  MemoryAllocator::Allocation allocation;
+  if (!g_memory_allocator->Allocate(memory_requirements, memory_type, resource_type, &allocation))
   {
-    LOG_VULKAN_ERROR(res, "vkAllocateMemory failed: ");
     vkDestroyImage(g_vulkan_context->GetDevice(), image, nullptr);
     return nullptr;
   }
 
-  res = vkBindImageMemory(g_vulkan_context->GetDevice(), image, device_memory, 0);
+  res = vkBindImageMemory(g_vulkan_context->GetDevice(), image, allocation.memory,
+                          allocation.offset);
   if (res != VK_SUCCESS)
   {
     LOG_VULKAN_ERROR(res, "vkBindImageMemory failed: ");
     vkDestroyImage(g_vulkan_context->GetDevice(), image, nullptr);
-    vkFreeMemory(g_vulkan_context->GetDevice(), device_memory, nullptr);
+    g_memory_allocator->Free(allocation);
     return nullptr;
   }
 
@@ -107,12 +107,12 @@ std::unique_ptr<Texture2D> Texture2D::Create(u32 width, u32 height, u32 levels,
   {
     LOG_VULKAN_ERROR(res, "vkCreateImageView failed: ");
     vkDestroyImage(g_vulkan_context->GetDevice(), image, nullptr);
-    vkFreeMemory(g_vulkan_context->GetDevice(), device_memory, nullptr);
+    g_memory_allocator->Free(allocation);
     return nullptr;
   }
 
   return std::make_unique<Texture2D>(width, height, levels, layers, format, samples, view_type,
-                                     image, device_memory, view);
+                                     image, allocation, view);
 }
 
 std::unique_ptr<Texture2D> Texture2D::CreateFromExistingImage(u32 width, u32 height, u32 levels,
@@ -136,7 +136,7 @@ std::unique_ptr<Texture2D> Texture2D::CreateFromExistingImage(u32 width, u32 hei
        0, levels, 0, layers}};
 
   // Memory is managed by the owner of the image.
-  VkDeviceMemory memory = VK_NULL_HANDLE;
+  MemoryAllocator::Allocation allocation;
   VkImageView view = VK_NULL_HANDLE;
   VkResult res = vkCreateImageView(g_vulkan_context->GetDevice(), &view_info, nullptr, &view);
   if (res != VK_SUCCESS)
@@ -146,7 +146,7 @@ std::unique_ptr<Texture2D> Texture2D::CreateFromExistingImage(u32 width, u32 hei
   }
 
   return std::make_unique<Texture2D>(width, height, levels, layers, format, samples, view_type,
-                                     existing_image, memory, view);
+                                     existing_image, allocation, view);
 }
 
 void Texture2D::OverrideImageLayout(VkImageLayout new_layout)
@@ -273,9 +273,8 @@ void TextureConverter::EncodeTextureToMemory(
   draw.EndRenderPass();
 
   MathUtil::Rectangle<int> copy_rect(0, 0, render_width, render_height);
-  m_encoding_readback_texture->CopyFromTexture(m_encoding_render_texture.get(), copy_rect, 0, 0,
-                                               copy_rect);
-  m_encoding_readback_texture->ReadTexels(copy_rect, dest_ptr, memory_stride);
+  g_texture_cache->WriteEFBCopyToRAM(dest_ptr, memory_stride, m_encoding_render_texture.get(),
+                                     copy_rect);
 }
 
 bool TextureConverter::SupportsTextureDecoding(TextureFormat format, TLUTFormat palette_format)
@@ -614,10 +613,7 @@ bool TextureConverter::CreateEncodingTexture()
                        ENCODING_TEXTURE_FORMAT, true);
 
   m_encoding_render_texture = g_renderer->CreateTexture(config);
-  m_encoding_readback_texture =
-      g_renderer->CreateStagingTexture(StagingTextureType::Readback, config);
-
-  return m_encoding_render_texture && m_encoding_readback_texture;
+  return m_encoding_render_texture != nullptr;
 }
 
 bool TextureConverter::CreateDecodingTexture()
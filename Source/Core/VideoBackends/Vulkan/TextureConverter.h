@@ -17,7 +17,6 @@
 #include "VideoCommon/VideoCommon.h"
 
 class AbstractTexture;
-class AbstractStagingTexture;
 
 namespace Vulkan
 {
@@ -100,7 +99,6 @@ private:
   // Texture encoding - RGBA8->GX format in memory
   std::map<EFBCopyParams, VkShaderModule> m_encoding_shaders;
   std::unique_ptr<AbstractTexture> m_encoding_render_texture;
-  std::unique_ptr<AbstractStagingTexture> m_encoding_readback_texture;
 
   // Texture decoding - GX format in memory->RGBA8
   struct TextureDecodingPipeline
@@ -270,40 +270,33 @@ VkShaderModule CreateShaderModule(const u32* spv, size_t spv_word_count)
   return module;
 }
 
-VkShaderModule CompileAndCreateVertexShader(const std::string& source_code)
+static VkShaderModule CompileAndCreateShader(ShaderStage stage, const std::string& source_code)
 {
   ShaderCompiler::SPIRVCodeVector code;
-  if (!ShaderCompiler::CompileVertexShader(&code, source_code.c_str(), source_code.length()))
+  if (!g_shader_cache->CompileUtilityShader(&code, stage, source_code))
     return VK_NULL_HANDLE;
 
   return CreateShaderModule(code.data(), code.size());
 }
 
-VkShaderModule CompileAndCreateGeometryShader(const std::string& source_code)
+VkShaderModule CompileAndCreateVertexShader(const std::string& source_code)
 {
-  ShaderCompiler::SPIRVCodeVector code;
-  if (!ShaderCompiler::CompileGeometryShader(&code, source_code.c_str(), source_code.length()))
-    return VK_NULL_HANDLE;
+  return CompileAndCreateShader(ShaderStage::Vertex, source_code);
+}
 
-  return CreateShaderModule(code.data(), code.size());
+VkShaderModule CompileAndCreateGeometryShader(const std::string& source_code)
+{
+  return CompileAndCreateShader(ShaderStage::Geometry, source_code);
 }
 
 VkShaderModule CompileAndCreateFragmentShader(const std::string& source_code)
 {
-  ShaderCompiler::SPIRVCodeVector code;
-  if (!ShaderCompiler::CompileFragmentShader(&code, source_code.c_str(), source_code.length()))
-    return VK_NULL_HANDLE;
-
-  return CreateShaderModule(code.data(), code.size());
+  return CompileAndCreateShader(ShaderStage::Pixel, source_code);
 }
 
 VkShaderModule CompileAndCreateComputeShader(const std::string& source_code)
 {
-  ShaderCompiler::SPIRVCodeVector code;
-  if (!ShaderCompiler::CompileComputeShader(&code, source_code.c_str(), source_code.length()))
-    return VK_NULL_HANDLE;
-
-  return CreateShaderModule(code.data(), code.size());
+  return CompileAndCreateShader(ShaderStage::Compute, source_code);
 }
 
 }  // namespace Util
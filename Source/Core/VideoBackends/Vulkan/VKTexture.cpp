@@ -382,16 +382,16 @@ std::unique_ptr<VKStagingTexture> VKStagingTexture::Create(StagingTextureType ty
   }
 
   VkBuffer buffer;
-  VkDeviceMemory memory;
+  MemoryAllocator::Allocation allocation;
   bool coherent;
-  if (!StagingBuffer::AllocateBuffer(buffer_type, buffer_size, buffer_usage, &buffer, &memory,
+  if (!StagingBuffer::AllocateBuffer(buffer_type, buffer_size, buffer_usage, &buffer, &allocation,
                                      &coherent))
   {
     return nullptr;
   }
 
   std::unique_ptr<StagingBuffer> staging_buffer =
-      std::make_unique<StagingBuffer>(buffer_type, buffer, memory, buffer_size, coherent);
+      std::make_unique<StagingBuffer>(buffer_type, buffer, allocation, buffer_size, coherent);
   std::unique_ptr<VKStagingTexture> staging_tex = std::unique_ptr<VKStagingTexture>(
       new VKStagingTexture(type, config, std::move(staging_buffer)));
 
@@ -423,13 +423,8 @@ void VKStagingTexture::CopyFromTexture(Texture2D* src, const MathUtil::Rectangle
                                        u32 src_layer, u32 src_level,
                                        const MathUtil::Rectangle<int>& dst_rect)
 {
-  if (m_needs_flush)
-  {
-    // Drop copy before reusing it.
-    g_command_buffer_mgr->RemoveFencePointCallback(this);
-    m_flush_fence = VK_NULL_HANDLE;
-    m_needs_flush = false;
-  }
+  // Drop any pending copy before reusing it.
+  m_needs_flush = false;
 
   VkImageLayout old_layout = src->GetLayout();
   src->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(),
@@ -456,17 +451,7 @@ void VKStagingTexture::CopyFromTexture(Texture2D* src, const MathUtil::Rectangle
   src->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(), old_layout);
 
   m_needs_flush = true;
-  g_command_buffer_mgr->AddFencePointCallback(this,
-                                              [this](VkCommandBuffer buf, VkFence fence) {
-                                                ASSERT(m_needs_flush);
-                                                m_flush_fence = fence;
-                                              },
-                                              [this](VkFence fence) {
-                                                m_flush_fence = VK_NULL_HANDLE;
-                                                m_needs_flush = false;
-                                                g_command_buffer_mgr->RemoveFencePointCallback(
-                                                    this);
-                                              });
+  m_flush_fence_counter = g_command_buffer_mgr->GetCurrentFenceCounter();
 }
 
 void VKStagingTexture::CopyToTexture(const MathUtil::Rectangle<int>& src_rect, AbstractTexture* dst,
@@ -481,13 +466,8 @@ void VKStagingTexture::CopyToTexture(const MathUtil::Rectangle<int>& src_rect, A
   ASSERT(dst_rect.left >= 0 && static_cast<u32>(dst_rect.right) <= dst->GetConfig().width &&
          dst_rect.top >= 0 && static_cast<u32>(dst_rect.bottom) <= dst->GetConfig().height);
 
-  if (m_needs_flush)
-  {
-    // Drop copy before reusing it.
-    g_command_buffer_mgr->RemoveFencePointCallback(this);
-    m_flush_fence = VK_NULL_HANDLE;
-    m_needs_flush = false;
-  }
+  // Drop any pending copy before reusing it.
+  m_needs_flush = false;
 
   // Flush caches before copying.
   m_staging_buffer->FlushCPUCache();
@@ -516,17 +496,7 @@ void VKStagingTexture::CopyToTexture(const MathUtil::Rectangle<int>& src_rect, A
   dst_tex->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(), old_layout);
 
   m_needs_flush = true;
-  g_command_buffer_mgr->AddFencePointCallback(this,
-                                              [this](VkCommandBuffer buf, VkFence fence) {
-                                                ASSERT(m_needs_flush);
-                                                m_flush_fence = fence;
-                                              },
-                                              [this](VkFence fence) {
-                                                m_flush_fence = VK_NULL_HANDLE;
-                                                m_needs_flush = false;
-                                                g_command_buffer_mgr->RemoveFencePointCallback(
-                                                    this);
-                                              });
+  m_flush_fence_counter = g_command_buffer_mgr->GetCurrentFenceCounter();
 }
 
 bool VKStagingTexture::Map()
@@ -545,19 +515,16 @@ void VKStagingTexture::Flush()
   if (!m_needs_flush)
     return;
 
-  // Either of the below two calls will cause the callback to fire.
-  g_command_buffer_mgr->RemoveFencePointCallback(this);
-  if (m_flush_fence != VK_NULL_HANDLE)
+  if (m_flush_fence_counter == g_command_buffer_mgr->GetCurrentFenceCounter())
   {
-    // WaitForFence should fire the callback.
-    g_command_buffer_mgr->WaitForFence(m_flush_fence);
-    m_flush_fence = VK_NULL_HANDLE;
+    // The copy is in the current command buffer, so it must be executed to populate the staging
+    // texture.
+    Util::ExecuteCurrentCommandsAndRestoreState(false, true);
   }
   else
   {
-    // We don't have a fence, and are pending. That means the readback is in the current
-    // command buffer, and must execute it to populate the staging texture.
-    Util::ExecuteCurrentCommandsAndRestoreState(false, true);
+    // Only wait for the submission containing the copy, later ones can still be in flight.
+    g_command_buffer_mgr->WaitForFenceCounter(m_flush_fence_counter);
   }
   m_needs_flush = false;
 
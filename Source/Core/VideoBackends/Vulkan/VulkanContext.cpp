@@ -249,6 +249,8 @@ void VulkanContext::PopulateBackendInfo(VideoConfig* config)
   config->backend_info.bSupportsLogicOp = false;             // Dependent on features.
   config->backend_info.bSupportsCopyToVram = true;           // Assumed support.
   config->backend_info.bSupportsFramebufferFetch = false;
+  config->backend_info.bSupportsVSLayerOutput = false;
+  config->backend_info.MaxPointSize = 0;
 }
 
 void VulkanContext::PopulateBackendInfoAdapters(VideoConfig* config, const GPUList& gpu_list)
@@ -531,6 +533,18 @@ bool VulkanContext::CreateDevice(VkSurfaceKHR surface, bool enable_validation_la
     return false;
   }
 
+  // Texture decoding compute shaders run on the graphics queue, as their results are sampled by
+  // draws in the same command buffer. Note dedicated compute families, for diagnosing drivers.
+  for (uint32_t i = 0; i < queue_family_count; i++)
+  {
+    const VkQueueFlags flags = queue_family_properties[i].queueFlags;
+    if ((flags & VK_QUEUE_COMPUTE_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT))
+    {
+      INFO_LOG(VIDEO, "Vulkan: Queue family %u is compute-only (%u queues)", i,
+               queue_family_properties[i].queueCount);
+    }
+  }
+
   VkDeviceCreateInfo device_info = {};
   device_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
   device_info.pNext = nullptr;
@@ -10,6 +10,7 @@
 #include "VideoBackends/Vulkan/CommandBufferManager.h"
 #include "VideoBackends/Vulkan/Constants.h"
 #include "VideoBackends/Vulkan/FramebufferManager.h"
+#include "VideoBackends/Vulkan/MemoryAllocator.h"
 #include "VideoBackends/Vulkan/ObjectCache.h"
 #include "VideoBackends/Vulkan/PerfQuery.h"
 #include "VideoBackends/Vulkan/Renderer.h"
@@ -186,6 +187,9 @@ bool VideoBackend::Initialize(void* window_handle)
   // With the backend information populated, we can now initialize videocommon.
   InitializeShared();
 
+  // The allocator must outlive the command buffer manager, which releases allocations.
+  g_memory_allocator = std::make_unique<MemoryAllocator>();
+
   // Create command buffers. We do this separately because the other classes depend on it.
   g_command_buffer_mgr = std::make_unique<CommandBufferManager>(g_Config.bBackendMultithreading);
   if (!g_command_buffer_mgr->Initialize())
@@ -209,7 +213,8 @@ bool VideoBackend::Initialize(void* window_handle)
   std::unique_ptr<SwapChain> swap_chain;
   if (surface != VK_NULL_HANDLE)
   {
-    swap_chain = SwapChain::Create(window_handle, surface, g_Config.IsVSync());
+    swap_chain =
+        SwapChain::Create(window_handle, surface, g_Config.IsVSync(), g_Config.bLowLatencyPresent);
     if (!swap_chain)
     {
       PanicAlert("Failed to create Vulkan swap chain.");
@@ -267,6 +272,7 @@ void VideoBackend::Shutdown()
   g_shader_cache.reset();
   g_object_cache.reset();
   g_command_buffer_mgr.reset();
+  g_memory_allocator.reset();
   g_vulkan_context.reset();
   ShutdownShared();
   UnloadVulkanLibrary();
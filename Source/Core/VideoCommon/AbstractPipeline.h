@@ -92,4 +92,8 @@ class AbstractPipeline
 public:
   AbstractPipeline() = default;
   virtual ~AbstractPipeline() = default;
+
+  // Returns false while the driver is still compiling the pipeline in the background. Using it
+  // before then is valid, but waits for the compile to finish.
+  virtual bool IsReady() const { return true; }
 };
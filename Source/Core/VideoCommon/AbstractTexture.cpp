@@ -16,6 +16,18 @@ AbstractTexture::AbstractTexture(const TextureConfig& c) : m_config(c)
 }
 
 bool AbstractTexture::Save(const std::string& filename, unsigned int level)
+{
+  std::vector<u8> data;
+  if (!ReadLevel(level, &data))
+    return false;
+
+  const u32 level_width = std::max(1u, m_config.width >> level);
+  const u32 level_height = std::max(1u, m_config.height >> level);
+  return TextureToPng(data.data(), static_cast<int>(level_width * 4), filename, level_width,
+                      level_height);
+}
+
+bool AbstractTexture::ReadLevel(unsigned int level, std::vector<u8>* data)
 {
   // We can't dump compressed textures currently (it would mean drawing them to a RGBA8
   // framebuffer, and saving that). TextureCache does not call Save for custom textures
@@ -40,13 +52,13 @@ bool AbstractTexture::Save(const std::string& filename, unsigned int level)
   readback_texture->CopyFromTexture(this, 0, level);
   readback_texture->Flush();
 
-  // Map it so we can encode it to the file.
+  // Map it so we can copy the texels out.
   if (!readback_texture->Map())
     return false;
 
-  return TextureToPng(reinterpret_cast<const u8*>(readback_texture->GetMappedPointer()),
-                      static_cast<int>(readback_texture->GetMappedStride()), filename, level_width,
-                      level_height);
+  data->resize(static_cast<size_t>(level_width) * level_height * 4);
+  readback_texture->ReadTexels(readback_texture_config.GetRect(), data->data(), level_width * 4);
+  return true;
 }
 
 bool AbstractTexture::IsCompressedFormat(AbstractTextureFormat format)
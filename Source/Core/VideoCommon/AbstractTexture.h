@@ -6,6 +6,7 @@
 
 #include <cstddef>
 #include <string>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/MathUtil.h"
@@ -37,6 +38,8 @@ public:
   AbstractTextureFormat GetFormat() const { return m_config.format; }
   bool IsMultisampled() const { return m_config.IsMultisampled(); }
   bool Save(const std::string& filename, unsigned int level);
+  // Reads a level back as RGBA8, with rows of width * 4 bytes. This waits for the GPU.
+  bool ReadLevel(unsigned int level, std::vector<u8>* data);
 
   static bool IsCompressedFormat(AbstractTextureFormat format);
   static bool IsDepthFormat(AbstractTextureFormat format);
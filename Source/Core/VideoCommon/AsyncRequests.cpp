@@ -5,8 +5,11 @@
 #include <mutex>
 
 #include "VideoCommon/AsyncRequests.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
+#include "VideoCommon/BPFunctions.h"
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/RenderBase.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoCommon.h"
 
@@ -46,6 +49,9 @@ void AsyncRequests::PullEventsInternal()
       } while (!m_queue.empty() && m_queue.front().type == first_event.type);
 
       lock.unlock();
+      if (t == EFBAccessType::PokeColor)
+        BPFunctions::ResolvePixelFormatChange();
+      g_renderer->IncrementEFBGeneration();
       g_renderer->PokeEFB(t, m_merged_efb_pokes.data(), m_merged_efb_pokes.size());
       lock.lock();
       continue;
@@ -113,6 +119,8 @@ void AsyncRequests::HandleEvent(const AsyncRequests::Event& e)
   case Event::EFB_POKE_COLOR:
   {
     EfbPokeData poke = {e.efb_poke.x, e.efb_poke.y, e.efb_poke.data};
+    BPFunctions::ResolvePixelFormatChange();
+    g_renderer->IncrementEFBGeneration();
     g_renderer->PokeEFB(EFBAccessType::PokeColor, &poke, 1);
   }
   break;
@@ -120,16 +128,20 @@ void AsyncRequests::HandleEvent(const AsyncRequests::Event& e)
   case Event::EFB_POKE_Z:
   {
     EfbPokeData poke = {e.efb_poke.x, e.efb_poke.y, e.efb_poke.data};
+    g_renderer->IncrementEFBGeneration();
     g_renderer->PokeEFB(EFBAccessType::PokeZ, &poke, 1);
   }
   break;
 
   case Event::EFB_PEEK_COLOR:
+    INCSTAT(stats.thisFrame.numEFBPeeks);
+    BPFunctions::ResolvePixelFormatChange();
     *e.efb_peek.data =
         g_renderer->AccessEFB(EFBAccessType::PeekColor, e.efb_peek.x, e.efb_peek.y, 0);
     break;
 
   case Event::EFB_PEEK_Z:
+    INCSTAT(stats.thisFrame.numEFBPeeks);
     *e.efb_peek.data = g_renderer->AccessEFB(EFBAccessType::PeekZ, e.efb_peek.x, e.efb_peek.y, 0);
     break;
 
@@ -145,6 +157,14 @@ void AsyncRequests::HandleEvent(const AsyncRequests::Event& e)
   case Event::PERF_QUERY:
     g_perf_query->FlushResults();
     break;
+
+  case Event::PERF_QUERY_POLL:
+    g_perf_query->PollResults();
+    break;
+
+  case Event::FIFO_PLAYER_FRAME:
+    FifoPlayer::GetInstance().DecodeFrame();
+    break;
   }
 }
 
@@ -28,6 +28,8 @@ public:
       SWAP_EVENT,
       BBOX_READ,
       PERF_QUERY,
+      PERF_QUERY_POLL,
+      FIFO_PLAYER_FRAME,
     } type;
     u64 time;
 
@@ -64,6 +66,10 @@ public:
       struct
       {
       } perf_query;
+
+      struct
+      {
+      } fifo_player_frame;
     };
   };
 
@@ -36,6 +36,18 @@ void AsyncShaderCompiler::QueueWorkItem(WorkItemPtr item, u32 priority)
   }
 }
 
+void AsyncShaderCompiler::UpdatePendingWorkPriorities()
+{
+  std::lock_guard<std::mutex> guard(m_pending_work_lock);
+  std::multimap<u32, WorkItemPtr> pending_work;
+  for (auto& it : m_pending_work)
+  {
+    const u32 priority = it.second->GetPriority(it.first);
+    pending_work.emplace(priority, std::move(it.second));
+  }
+  m_pending_work.swap(pending_work);
+}
+
 void AsyncShaderCompiler::RetrieveWorkItems()
 {
   std::deque<WorkItemPtr> completed_work;
@@ -30,6 +30,10 @@ public:
     virtual ~WorkItem() = default;
     virtual bool Compile() = 0;
     virtual void Retrieve() = 0;
+
+    // Returns the priority this item should be compiled with, given the priority it is currently
+    // queued with. Called on the main thread by UpdatePendingWorkPriorities().
+    virtual u32 GetPriority(u32 queued_priority) const { return queued_priority; }
   };
 
   using WorkItemPtr = std::unique_ptr<WorkItem>;
@@ -46,6 +50,8 @@ public:
   // Queues a new work item to the compiler threads. The lower the priority, the sooner
   // this work item will be compiled, relative to the other work items.
   void QueueWorkItem(WorkItemPtr item, u32 priority);
+  // Re-sorts the pending work items, using the priorities returned by GetPriority().
+  void UpdatePendingWorkPriorities();
   void RetrieveWorkItems();
   bool HasPendingWork();
   bool HasCompletedWork();
@@ -182,11 +182,28 @@ void ClearScreen(const EFBRectangle& rc)
       color = RGBA8ToRGB565ToRGBA8(color);
       z = Z24ToZ16ToZ24(z);
     }
+    // A clear of all the color data leaves nothing in the previous format to reinterpret
+    const bool clears_all_color =
+        colorEnable && (alphaEnable || pixel_format != PEControl::RGBA6_Z24) && rc.left <= 0 &&
+        rc.top <= 0 && rc.right >= EFB_WIDTH && rc.bottom >= EFB_HEIGHT;
+    if (clears_all_color && g_ActiveConfig.bEFBEmulateFormatChanges)
+      g_renderer->StorePixelFormat(pixel_format);
+    else if (colorEnable || alphaEnable)
+      ResolvePixelFormatChange();
+
+    g_renderer->IncrementEFBGeneration();
     g_renderer->ClearScreen(rc, colorEnable, alphaEnable, zEnable, color, z);
   }
 }
 
 void OnPixelFormatChange()
+{
+  // The EFB data isn't reinterpreted until it is used, see ResolvePixelFormatChange
+  DEBUG_LOG(VIDEO, "pixelfmt: pixel=%d, zc=%d", static_cast<int>(bpmem.zcontrol.pixel_format),
+            static_cast<int>(bpmem.zcontrol.zformat));
+}
+
+void ResolvePixelFormatChange()
 {
   int convtype = -1;
 
@@ -250,12 +267,10 @@ void OnPixelFormatChange()
     goto skip;
   }
 
+  g_renderer->IncrementEFBGeneration();
   g_renderer->ReinterpretPixelData(convtype);
 
 skip:
-  DEBUG_LOG(VIDEO, "pixelfmt: pixel=%d, zc=%d", static_cast<int>(new_format),
-            static_cast<int>(bpmem.zcontrol.zformat));
-
   g_renderer->StorePixelFormat(new_format);
 }
 
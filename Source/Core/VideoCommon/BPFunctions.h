@@ -22,5 +22,8 @@ void SetDepthMode();
 void SetBlendMode();
 void ClearScreen(const EFBRectangle& rc);
 void OnPixelFormatChange();
+// Reinterprets the EFB color data if it was last written in a different pixel format. Called
+// before the data is used, as games often switch formats without drawing in between.
+void ResolvePixelFormatChange();
 void SetInterlacingMode(const BPCmd& bp);
 }
@@ -173,10 +173,13 @@ static void BPWritten(const BPCmd& bp)
   // End();)
   // Triggers an interrupt on the PPC side so that the game knows when the GPU has finished drawing.
   // Tokens are similar.
+  // The CPU reads the results of EFB copies once it has been signaled, so deferred copies have to
+  // be in RAM first.
   case BPMEM_SETDRAWDONE:
     switch (bp.newvalue & 0xFF)
     {
     case 0x02:
+      g_texture_cache->FlushEFBCopies();
       if (!Fifo::UseDeterministicGPUThread())
         PixelEngine::SetFinish();  // may generate interrupt
       DEBUG_LOG(VIDEO, "GXSetDrawDone SetPEFinish (value: 0x%02X)", (bp.newvalue & 0xFFFF));
@@ -188,11 +191,13 @@ static void BPWritten(const BPCmd& bp)
     }
     return;
   case BPMEM_PE_TOKEN_ID:  // Pixel Engine Token ID
+    g_texture_cache->FlushEFBCopies();
     if (!Fifo::UseDeterministicGPUThread())
       PixelEngine::SetToken(static_cast<u16>(bp.newvalue & 0xFFFF), false);
     DEBUG_LOG(VIDEO, "SetPEToken 0x%04x", (bp.newvalue & 0xFFFF));
     return;
   case BPMEM_PE_TOKEN_INT_ID:  // Pixel Engine Interrupt Token ID
+    g_texture_cache->FlushEFBCopies();
     if (!Fifo::UseDeterministicGPUThread())
       PixelEngine::SetToken(static_cast<u16>(bp.newvalue & 0xFFFF), true);
     DEBUG_LOG(VIDEO, "SetPEToken + INT 0x%04x", (bp.newvalue & 0xFFFF));
@@ -232,6 +237,8 @@ static void BPWritten(const BPCmd& bp)
       static constexpr CopyFilterCoefficients::Values filter_coefficients = {
           {0, 0, 21, 22, 21, 0, 0}};
       bool is_depth_copy = bpmem.zcontrol.pixel_format == PEControl::Z24;
+      if (!is_depth_copy)
+        ResolvePixelFormatChange();
       g_texture_cache->CopyRenderTargetToTexture(
           destAddr, PE_copy.tp_realFormat(), srcRect.GetWidth(), srcRect.GetHeight(), destStride,
           is_depth_copy, srcRect, !!PE_copy.intensity_fmt, !!PE_copy.half_scale, 1.0f, 1.0f,
@@ -263,6 +270,8 @@ static void BPWritten(const BPCmd& bp)
                 bpmem.copyTexSrcWH.x + 1, destStride, height, yScale);
 
       bool is_depth_copy = bpmem.zcontrol.pixel_format == PEControl::Z24;
+      if (!is_depth_copy)
+        ResolvePixelFormatChange();
       g_texture_cache->CopyRenderTargetToTexture(
           destAddr, EFBCopyFormat::XFB, srcRect.GetWidth(), height, destStride, is_depth_copy,
           srcRect, false, false, yScale, s_gammaLUT[PE_copy.gamma], bpmem.triggerEFBCopy.clamp_top,
@@ -306,6 +315,7 @@ static void BPWritten(const BPCmd& bp)
     if (!SConfig::GetInstance().bWii)
       addr = addr & 0x01FFFFFF;
 
+    g_texture_cache->FlushEFBCopies();
     Memory::CopyFromEmu(texMem + tlutTMemAddr, addr, tlutXferCount);
 
     if (g_bRecordFifoData)
@@ -496,6 +506,8 @@ static void BPWritten(const BPCmd& bp)
       // NOTE: libogc's implementation of GX_PreloadEntireTexture seems flawed, so it's not
       // necessarily a good reference for RE'ing this feature.
 
+      g_texture_cache->FlushEFBCopies();
+
       BPS_TmemConfig& tmem_cfg = bpmem.tmem_config;
       u32 src_addr = tmem_cfg.preload_addr << 5;  // TODO: Should we add mask here on GC?
       u32 bytes_read = 0;
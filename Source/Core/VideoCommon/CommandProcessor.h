@@ -23,11 +23,14 @@ struct SCPFifoStruct
   u32 CPLoWatermark;
   volatile u32 CPReadWriteDistance;
   volatile u32 CPWritePointer;
-  volatile u32 CPReadPointer;
   volatile u32 CPBreakpoint;
+
+  // Moved by the GPU thread for every command it reads. Kept on a cache line of their own, so that
+  // this doesn't keep invalidating the line the CPU thread updates for every gather pipe burst.
+  alignas(64) volatile u32 CPReadPointer;
   volatile u32 SafeCPReadPointer;
 
-  volatile u32 bFF_GPLinkEnable;
+  alignas(64) volatile u32 bFF_GPLinkEnable;
   volatile u32 bFF_GPReadEnable;
   volatile u32 bFF_BPEnable;
   volatile u32 bFF_BPInt;
@@ -157,7 +160,9 @@ void RegisterMMIO(MMIO::Mapping* mmio, u32 base);
 
 void SetCPStatusFromGPU();
 void SetCPStatusFromCPU();
-void GatherPipeBursted();
+// Publishes num_bursts gather pipe bursts, which have already been written to memory, to the GPU
+// at once.
+void GatherPipeBursted(u32 num_bursts = 1);
 void UpdateInterrupts(u64 userdata);
 void UpdateInterruptsFromVideoBackend(u64 userdata);
 
@@ -89,4 +89,5 @@ struct GeometryShaderConstants
   float4 stereoparams;
   float4 lineptparams;
   int4 texoffset;
+  float4 efbscale;
 };
@@ -43,7 +43,9 @@ void FPSCounter::Update()
   if (m_time_since_update >= FPS_REFRESH_INTERVAL)
   {
     m_fps = m_frame_counter / (m_time_since_update / 1000000.0);
+    m_present_latency = m_present_latency_sum / (m_frame_counter * 1000.0f);
     m_frame_counter = 0;
+    m_present_latency_sum = 0;
     m_time_since_update = 0;
   }
 }
@@ -17,13 +17,21 @@ public:
   // Called when a frame is rendered (updated every second).
   void Update();
 
+  // Called with the time spent presenting a frame, before Update() is called for it.
+  void UpdatePresentLatency(u64 latency_us) { m_present_latency_sum += latency_us; }
+
   float GetFPS() const { return m_fps; }
 
+  // Returns the average present latency in milliseconds.
+  float GetPresentLatency() const { return m_present_latency; }
+
 private:
   u64 m_last_time = 0;
   u64 m_time_since_update = 0;
   u32 m_frame_counter = 0;
   float m_fps = 0;
+  u64 m_present_latency_sum = 0;
+  float m_present_latency = 0;
   std::ofstream m_bench_file;
 
   void LogRenderTimeToFile(u64 val);
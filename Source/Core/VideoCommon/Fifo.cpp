@@ -15,6 +15,7 @@
 #include "Common/FPURoundMode.h"
 #include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/Profiler.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
@@ -34,6 +35,10 @@ namespace Fifo
 {
 static constexpr u32 FIFO_SIZE = 2 * 1024 * 1024;
 static constexpr int GPU_TIME_SLOT_SIZE = 1000;
+// In normal mode, the pending data of a partial command is decoded in place in emulated memory,
+// behind CPReadPointer, for up to this many bytes. The CPU could overwrite larger amounts before
+// the command is complete, so they are copied to s_video_buffer.
+static constexpr size_t MAX_DIRECT_PENDING_SIZE = 4096;
 
 static Common::BlockingLoop s_gpu_mainloop;
 
@@ -56,6 +61,7 @@ static u8* s_video_buffer_read_ptr;
 static std::atomic<u8*> s_video_buffer_write_ptr;
 static std::atomic<u8*> s_video_buffer_seen_ptr;
 static u8* s_video_buffer_pp_read_ptr;
+static bool s_reading_directly;
 // The read_ptr is always owned by the GPU thread.  In normal mode, so is the
 // write_ptr, despite it being atomic.  In deterministic GPU thread mode,
 // things get a bit more complicated:
@@ -67,13 +73,30 @@ static u8* s_video_buffer_pp_read_ptr;
 // FIFO.  Maybe someday it will be under the lock.  For now, because RunGpuLoop
 // polls, it's just atomic.
 // - The pp_read_ptr is the CPU preprocessing version of the read_ptr.
+//
+// In normal mode, read_ptr and write_ptr point into emulated memory instead of s_video_buffer
+// while s_reading_directly is set, so that the FIFO data doesn't need to be copied.
 
 static std::atomic<int> s_sync_ticks;
 static bool s_syncing_suspended;
 static Common::Event s_sync_wakeup_event;
 
+// Moves the data which is still to be decoded from emulated memory to s_video_buffer
+static void StopReadingDirectly()
+{
+  if (!s_reading_directly)
+    return;
+
+  const size_t pending = s_video_buffer_write_ptr - s_video_buffer_read_ptr;
+  memcpy(s_video_buffer, s_video_buffer_read_ptr, pending);
+  s_video_buffer_read_ptr = s_video_buffer;
+  s_video_buffer_write_ptr = s_video_buffer + pending;
+  s_reading_directly = false;
+}
+
 void DoState(PointerWrap& p)
 {
+  StopReadingDirectly();
   p.DoArray(s_video_buffer, FIFO_SIZE);
   u8* write_ptr = s_video_buffer_write_ptr;
   p.DoPointer(write_ptr, s_video_buffer);
@@ -225,6 +248,22 @@ void* PopFifoAuxBuffer(size_t size)
 static void ReadDataFromFifo(u32 readPtr)
 {
   size_t len = 32;
+
+  // Decode in place if the new data directly follows the pending data, which happens unless the
+  // FIFO wrapped around. FIFOs are 32 byte aligned, so the whole chunk is in the same RAM bank.
+  u8* const src = Memory::GetPointer(readPtr);
+  const size_t pending = s_video_buffer_write_ptr - s_video_buffer_read_ptr;
+  if (src && pending < MAX_DIRECT_PENDING_SIZE &&
+      (pending == 0 || (s_reading_directly && src == s_video_buffer_write_ptr)))
+  {
+    if (pending == 0)
+      s_video_buffer_read_ptr = src;
+    s_video_buffer_write_ptr = src + len;
+    s_reading_directly = true;
+    return;
+  }
+  StopReadingDirectly();
+
   if (len > (size_t)(s_video_buffer + FIFO_SIZE - s_video_buffer_write_ptr))
   {
     size_t existing_len = s_video_buffer_write_ptr - s_video_buffer_read_ptr;
@@ -280,6 +319,7 @@ static void ReadDataFromFifoOnCPU(u32 readPtr)
 
 void ResetVideoBuffer()
 {
+  s_reading_directly = false;
   s_video_buffer_read_ptr = s_video_buffer;
   s_video_buffer_write_ptr = s_video_buffer;
   s_video_buffer_seen_ptr = s_video_buffer;
@@ -303,6 +343,8 @@ void RunGpuLoop()
         if (!s_emu_running_state.IsSet())
           return;
 
+        PROFILE("Fifo::RunGpuLoop");
+
         if (s_use_deterministic_gpu_thread)
         {
           AsyncRequests::GetInstance()->PullEvents();
@@ -516,6 +558,7 @@ void UpdateWantDeterminism(bool want)
     s_use_deterministic_gpu_thread = gpu_thread;
     if (gpu_thread)
     {
+      StopReadingDirectly();
       // These haven't been updated in non-deterministic mode.
       s_video_buffer_seen_ptr = s_video_buffer_pp_read_ptr = s_video_buffer_read_ptr;
       CopyPreprocessCPStateFromMain();
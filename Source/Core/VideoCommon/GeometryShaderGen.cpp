@@ -8,8 +8,10 @@
 #include <cstring>
 
 #include "Common/CommonTypes.h"
+#include "VideoCommon/BPMemory.h"
 #include "VideoCommon/DriverDetails.h"
 #include "VideoCommon/LightingShaderGen.h"
+#include "VideoCommon/RenderBase.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
@@ -20,17 +22,49 @@ constexpr std::array<const char*, 4> primitives_d3d = {{"point", "line", "triang
 
 bool geometry_shader_uid_data::IsPassthrough() const
 {
-  const bool stereo = g_ActiveConfig.stereo_mode != StereoMode::Off;
+  // Vertex shaders can place triangles on both layers themselves
+  const bool stereo =
+      g_ActiveConfig.stereo_mode != StereoMode::Off && !g_ActiveConfig.UseVertexShaderStereo();
   const bool wireframe = g_ActiveConfig.bWireFrame;
   return primitive_type >= static_cast<u32>(PrimitiveType::Triangles) && !stereo && !wireframe;
 }
 
+// Points can be drawn natively when the vertex shader sets their size and nothing else needs a
+// geometry shader: no wireframe, no stereo expansion, and no texture coordinate offsets.
+static bool CanUseNativePoints()
+{
+  if (g_ActiveConfig.backend_info.MaxPointSize == 0 || g_ActiveConfig.bWireFrame)
+    return false;
+  if (g_ActiveConfig.stereo_mode != StereoMode::Off && !g_ActiveConfig.UseVertexShaderStereo())
+    return false;
+
+  // Zero-sized points aren't drawn, but native points are always at least one pixel
+  const u32 point_size = bpmem.lineptwidth.pointsize;
+  const float scaled_point_size = point_size / 6.0f * g_renderer->EFBToScaledXf(1.0f);
+  if (point_size == 0 || scaled_point_size > g_ActiveConfig.backend_info.MaxPointSize)
+    return false;
+
+  if (bpmem.lineptwidth.pointoff != 0)
+  {
+    for (u32 i = 0; i < xfmem.numTexGen.numTexGens; i++)
+    {
+      if (bpmem.texcoords[i].s.point_offset)
+        return false;
+    }
+  }
+  return true;
+}
+
 GeometryShaderUid GetGeometryShaderUid(PrimitiveType primitive_type)
 {
   ShaderUid<geometry_shader_uid_data> out;
   geometry_shader_uid_data* uid_data = out.GetUidData<geometry_shader_uid_data>();
   memset(uid_data, 0, sizeof(geometry_shader_uid_data));
 
+  // Natively drawn points don't need a geometry shader, just like triangles
+  if (primitive_type == PrimitiveType::Points && CanUseNativePoints())
+    primitive_type = PrimitiveType::Triangles;
+
   uid_data->primitive_type = static_cast<u32>(primitive_type);
   uid_data->numTexGens = xfmem.numTexGen.numTexGens;
 
@@ -56,6 +90,9 @@ ShaderCode GenerateGeometryShaderCode(APIType ApiType, const ShaderHostConfig& h
   const bool msaa = host_config.msaa;
   const bool ssaa = host_config.ssaa;
   const bool stereo = host_config.stereo;
+  // The vertex shader has already picked the eye, and the primitive is drawn once for each
+  const bool vs_stereo = stereo && host_config.backend_vs_layer_output;
+  const bool duplicate_for_stereo = stereo && !vs_stereo;
   const PrimitiveType primitive_type = static_cast<PrimitiveType>(uid_data->primitive_type);
   const unsigned primitive_type_index = static_cast<unsigned>(uid_data->primitive_type);
   const unsigned vertex_in = std::min(static_cast<unsigned>(primitive_type_index) + 1, 3u);
@@ -70,7 +107,7 @@ ShaderCode GenerateGeometryShaderCode(APIType ApiType, const ShaderHostConfig& h
     if (host_config.backend_gs_instancing)
     {
       out.Write("layout(%s, invocations = %d) in;\n", primitives_ogl[primitive_type_index],
-                stereo ? 2 : 1);
+                duplicate_for_stereo ? 2 : 1);
       out.Write("layout(%s_strip, max_vertices = %d) out;\n", wireframe ? "line" : "triangle",
                 vertex_out);
     }
@@ -78,7 +115,7 @@ ShaderCode GenerateGeometryShaderCode(APIType ApiType, const ShaderHostConfig& h
     {
       out.Write("layout(%s) in;\n", primitives_ogl[primitive_type_index]);
       out.Write("layout(%s_strip, max_vertices = %d) out;\n", wireframe ? "line" : "triangle",
-                stereo ? vertex_out * 2 : vertex_out);
+                duplicate_for_stereo ? vertex_out * 2 : vertex_out);
     }
   }
 
@@ -90,10 +127,7 @@ ShaderCode GenerateGeometryShaderCode(APIType ApiType, const ShaderHostConfig& h
   else
     out.Write("cbuffer GSBlock {\n");
 
-  out.Write("\tfloat4 " I_STEREOPARAMS ";\n"
-            "\tfloat4 " I_LINEPTPARAMS ";\n"
-            "\tint4 " I_TEXOFFSET ";\n"
-            "};\n");
+  out.Write("%s};\n", s_geometry_shader_uniforms);
 
   out.Write("struct VS_OUTPUT {\n");
   GenerateVSOutputMembers<ShaderCode>(out, ApiType, uid_data->numTexGens, pixel_lighting, "");
@@ -107,6 +141,8 @@ ShaderCode GenerateGeometryShaderCode(APIType ApiType, const ShaderHostConfig& h
     out.Write("VARYING_LOCATION(0) in VertexData {\n");
     GenerateVSOutputMembers<ShaderCode>(out, ApiType, uid_data->numTexGens, pixel_lighting,
                                         GetInterpolationQualifier(msaa, ssaa, true, true));
+    if (vs_stereo)
+      out.Write("\tflat int layer;\n");
     out.Write("} vs[%d];\n", vertex_in);
 
     out.Write("VARYING_LOCATION(0) out VertexData {\n");
@@ -200,7 +236,9 @@ ShaderCode GenerateGeometryShaderCode(APIType ApiType, const ShaderHostConfig& h
   {
     // If the GPU supports invocation we don't need a for loop and can simply use the
     // invocation identifier to determine which layer we're rendering.
-    if (host_config.backend_gs_instancing)
+    if (vs_stereo)
+      out.Write("\tint eye = vs[0].layer;\n");
+    else if (host_config.backend_gs_instancing)
       out.Write("\tint eye = InstanceID;\n");
     else
       out.Write("\tfor (int eye = 0; eye < 2; ++eye) {\n");
@@ -236,7 +274,10 @@ ShaderCode GenerateGeometryShaderCode(APIType ApiType, const ShaderHostConfig& h
     out.Write("\tps.layer = eye;\n");
     if (ApiType == APIType::OpenGL || ApiType == APIType::Vulkan)
       out.Write("\tgl_Layer = eye;\n");
+  }
 
+  if (duplicate_for_stereo)
+  {
     // For stereoscopy add a small horizontal offset in Normalized Device Coordinates proportional
     // to the depth of the vertex. We retrieve the depth value from the w-component of the projected
     // vertex which contains the negated z-component of the original vertex.
@@ -309,7 +350,7 @@ ShaderCode GenerateGeometryShaderCode(APIType ApiType, const ShaderHostConfig& h
 
   EndPrimitive(out, host_config, uid_data, ApiType, wireframe, pixel_lighting);
 
-  if (stereo && !host_config.backend_gs_instancing)
+  if (duplicate_for_stereo && !host_config.backend_gs_instancing)
     out.Write("\t}\n");
 
   out.Write("}\n");
@@ -8,6 +8,7 @@
 #include "Common/CommonTypes.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/GeometryShaderManager.h"
+#include "VideoCommon/RenderBase.h"
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
 
@@ -72,6 +73,14 @@ void GeometryShaderManager::SetConstants()
 
     dirty = true;
   }
+
+  // Vertex shaders which size points themselves need them in target pixels
+  const float efb_scale = g_renderer->EFBToScaledXf(1.0f);
+  if (constants.efbscale[0] != efb_scale)
+  {
+    constants.efbscale[0] = efb_scale;
+    dirty = true;
+  }
 }
 
 void GeometryShaderManager::SetViewportChanged()
@@ -0,0 +1,307 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/HiresTexturePack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Common/Align.h"
+#include "Common/File.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+#include "VideoCommon/HiresTextures.h"
+
+namespace
+{
+#pragma pack(push, 1)
+struct Header
+{
+  u32 magic;
+  u32 version;
+  u32 texture_count;
+  u32 index_size;
+};
+
+struct LevelHeader
+{
+  u32 format;
+  u32 width;
+  u32 height;
+  u32 row_length;
+  u64 offset;
+  u64 size;
+};
+#pragma pack(pop)
+
+bool IsSupportedFormat(AbstractTextureFormat format)
+{
+  switch (format)
+  {
+  case AbstractTextureFormat::RGBA8:
+  case AbstractTextureFormat::DXT1:
+  case AbstractTextureFormat::DXT3:
+  case AbstractTextureFormat::DXT5:
+  case AbstractTextureFormat::BPTC:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Bounds-checked reader for the index.
+class IndexReader
+{
+public:
+  IndexReader(const u8* data, size_t size) : m_data(data), m_size(size) {}
+
+  template <typename T>
+  bool Read(T* value)
+  {
+    if (m_size - m_position < sizeof(T))
+      return false;
+
+    std::memcpy(value, m_data + m_position, sizeof(T));
+    m_position += sizeof(T);
+    return true;
+  }
+
+  bool ReadString(std::string* value, size_t length)
+  {
+    if (m_size - m_position < length)
+      return false;
+
+    value->assign(reinterpret_cast<const char*>(m_data + m_position), length);
+    m_position += length;
+    return true;
+  }
+
+private:
+  const u8* m_data;
+  size_t m_size;
+  size_t m_position = 0;
+};
+}  // Anonymous namespace
+
+HiresTexturePack::~HiresTexturePack()
+{
+  Unmap();
+}
+
+std::shared_ptr<HiresTexturePack> HiresTexturePack::Open(const std::string& path)
+{
+  // Can't use make_shared due to private constructor.
+  std::shared_ptr<HiresTexturePack> pack(new HiresTexturePack());
+  if (!pack->Map(path))
+  {
+    ERROR_LOG(VIDEO, "Failed to map texture pack %s", path.c_str());
+    return nullptr;
+  }
+
+  if (!pack->ParseIndex())
+  {
+    ERROR_LOG(VIDEO, "Texture pack %s is invalid", path.c_str());
+    return nullptr;
+  }
+
+  return pack;
+}
+
+bool HiresTexturePack::Map(const std::string& path)
+{
+#ifdef _WIN32
+  m_file_handle = CreateFile(UTF8ToTStr(path).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                             OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (m_file_handle == INVALID_HANDLE_VALUE)
+  {
+    m_file_handle = nullptr;
+    return false;
+  }
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(m_file_handle, &size) || size.QuadPart == 0)
+    return false;
+
+  m_mapping_handle = CreateFileMapping(m_file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!m_mapping_handle)
+    return false;
+
+  m_data = static_cast<const u8*>(MapViewOfFile(m_mapping_handle, FILE_MAP_READ, 0, 0, 0));
+  if (!m_data)
+    return false;
+
+  m_size = static_cast<size_t>(size.QuadPart);
+#else
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd == -1)
+    return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0)
+  {
+    close(fd);
+    return false;
+  }
+
+  void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  // The mapping stays valid after closing the file.
+  close(fd);
+  if (data == MAP_FAILED)
+    return false;
+
+  m_data = static_cast<const u8*>(data);
+  m_size = static_cast<size_t>(st.st_size);
+#endif
+
+  return true;
+}
+
+void HiresTexturePack::Unmap()
+{
+#ifdef _WIN32
+  if (m_data)
+    UnmapViewOfFile(m_data);
+  if (m_mapping_handle)
+    CloseHandle(m_mapping_handle);
+  if (m_file_handle)
+    CloseHandle(m_file_handle);
+  m_file_handle = nullptr;
+  m_mapping_handle = nullptr;
+#else
+  if (m_data)
+    munmap(const_cast<u8*>(m_data), m_size);
+#endif
+
+  m_data = nullptr;
+  m_size = 0;
+}
+
+bool HiresTexturePack::ParseIndex()
+{
+  IndexReader reader(m_data, m_size);
+
+  Header header;
+  if (!reader.Read(&header) || header.magic != MAGIC || header.version != VERSION)
+    return false;
+
+  for (u32 i = 0; i < header.texture_count; i++)
+  {
+    u16 name_length;
+    std::string name;
+    u8 has_arbitrary_mipmaps;
+    u8 level_count;
+    if (!reader.Read(&name_length) || !reader.ReadString(&name, name_length) ||
+        !reader.Read(&has_arbitrary_mipmaps) || !reader.Read(&level_count) || level_count == 0)
+    {
+      return false;
+    }
+
+    Texture texture;
+    texture.has_arbitrary_mipmaps = has_arbitrary_mipmaps != 0;
+    for (u8 level_index = 0; level_index < level_count; level_index++)
+    {
+      LevelHeader level_header;
+      if (!reader.Read(&level_header))
+        return false;
+
+      const AbstractTextureFormat format = static_cast<AbstractTextureFormat>(level_header.format);
+      if (!IsSupportedFormat(format) || level_header.offset > m_size ||
+          level_header.size > m_size - level_header.offset)
+      {
+        return false;
+      }
+
+      texture.levels.push_back({format, level_header.width, level_header.height,
+                                level_header.row_length, m_data + level_header.offset,
+                                static_cast<size_t>(level_header.size)});
+    }
+
+    m_textures.emplace(std::move(name), std::move(texture));
+  }
+
+  return true;
+}
+
+bool HiresTexturePack::Write(
+    const std::string& path,
+    const std::vector<std::pair<std::string, std::shared_ptr<HiresTexture>>>& textures)
+{
+  // Lay out the index first, so that the data offsets are known before writing it.
+  size_t index_size = 0;
+  for (const auto& texture : textures)
+  {
+    const std::vector<HiresTexture::Level>& levels = texture.second->m_levels;
+    if (texture.first.size() > std::numeric_limits<u16>::max() ||
+        levels.size() > std::numeric_limits<u8>::max() ||
+        !std::all_of(levels.begin(), levels.end(),
+                     [](const HiresTexture::Level& l) { return IsSupportedFormat(l.format); }))
+    {
+      ERROR_LOG(VIDEO, "Custom texture %s can't be stored in a texture pack",
+                texture.first.c_str());
+      return false;
+    }
+
+    index_size +=
+        sizeof(u16) + texture.first.size() + 2 * sizeof(u8) + levels.size() * sizeof(LevelHeader);
+  }
+
+  File::IOFile file(path, "wb");
+  if (!file)
+    return false;
+
+  const Header header = {MAGIC, VERSION, static_cast<u32>(textures.size()),
+                         static_cast<u32>(index_size)};
+  if (!file.WriteArray(&header, 1))
+    return false;
+
+  u64 offset = Common::AlignUp(sizeof(Header) + index_size, DATA_ALIGNMENT);
+  for (const auto& texture : textures)
+  {
+    const u16 name_length = static_cast<u16>(texture.first.size());
+    const u8 has_arbitrary_mipmaps = texture.second->HasArbitraryMipmaps();
+    const u8 level_count = static_cast<u8>(texture.second->m_levels.size());
+    if (!file.WriteArray(&name_length, 1) || !file.WriteBytes(texture.first.data(), name_length) ||
+        !file.WriteArray(&has_arbitrary_mipmaps, 1) || !file.WriteArray(&level_count, 1))
+    {
+      return false;
+    }
+
+    for (const HiresTexture::Level& level : texture.second->m_levels)
+    {
+      const LevelHeader level_header = {static_cast<u32>(level.format), level.width, level.height,
+                                        level.row_length, offset, level.GetSize()};
+      if (!file.WriteArray(&level_header, 1))
+        return false;
+
+      offset = Common::AlignUp(offset + level.GetSize(), DATA_ALIGNMENT);
+    }
+  }
+
+  static const u8 padding[DATA_ALIGNMENT] = {};
+  for (const auto& texture : textures)
+  {
+    for (const HiresTexture::Level& level : texture.second->m_levels)
+    {
+      const u64 position = file.Tell();
+      const size_t padding_size = Common::AlignUp(position, DATA_ALIGNMENT) - position;
+      if (!file.WriteBytes(padding, padding_size) ||
+          !file.WriteBytes(level.GetData(), level.GetSize()))
+      {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
@@ -0,0 +1,72 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/TextureConfig.h"
+
+class HiresTexture;
+
+// A texture pack bundles the custom textures of a game into a single file, with every mip level
+// stored in its upload format (RGBA8 or BC1/BC2/BC3/BC7). Packs are memory-mapped, so levels can
+// be handed to the backend directly without being read or decoded first.
+//
+// Layout (little-endian):
+//   Header, then for each texture: u16 name length, name, u8 has_arbitrary_mipmaps,
+//   u8 level count, and a LevelHeader per level. The level data follows the index, with each
+//   level aligned to DATA_ALIGNMENT bytes.
+class HiresTexturePack
+{
+public:
+  static constexpr u32 MAGIC = 0x31505444;  // "DTP1"
+  static constexpr u32 VERSION = 1;
+  static constexpr size_t DATA_ALIGNMENT = 64;
+
+  struct Level
+  {
+    AbstractTextureFormat format;
+    u32 width;
+    u32 height;
+    u32 row_length;
+    const u8* data;
+    size_t size;
+  };
+
+  struct Texture
+  {
+    bool has_arbitrary_mipmaps;
+    std::vector<Level> levels;
+  };
+
+  ~HiresTexturePack();
+
+  static std::shared_ptr<HiresTexturePack> Open(const std::string& path);
+  static bool
+  Write(const std::string& path,
+        const std::vector<std::pair<std::string, std::shared_ptr<HiresTexture>>>& textures);
+
+  const std::unordered_map<std::string, Texture>& GetTextures() const { return m_textures; }
+
+private:
+  HiresTexturePack() = default;
+
+  bool Map(const std::string& path);
+  void Unmap();
+  bool ParseIndex();
+
+  std::unordered_map<std::string, Texture> m_textures;
+  const u8* m_data = nullptr;
+  size_t m_size = 0;
+#ifdef _WIN32
+  void* m_file_handle = nullptr;
+  void* m_mapping_handle = nullptr;
+#endif
+};
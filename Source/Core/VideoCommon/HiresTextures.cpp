@@ -5,13 +5,17 @@
 #include "VideoCommon/HiresTextures.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cctype>
 #include <cinttypes>
 #include <cstring>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <xxhash.h>
@@ -28,8 +32,10 @@
 #include "Common/Swap.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
+#include "VideoCommon/HiresTexturePack.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -37,6 +43,7 @@ struct DiskTexture
 {
   std::string path;
   bool has_arbitrary_mipmaps;
+  std::shared_ptr<HiresTexturePack> pack;  // set if the texture is stored in a texture pack
 };
 
 static std::unordered_map<std::string, DiskTexture> s_textureMap;
@@ -46,32 +53,63 @@ static Common::Flag s_textureCacheAbortLoading;
 
 static std::thread s_prefetcher;
 
+// Streaming: textures are loaded on demand by s_streamer and kept in an LRU list until they
+// exceed the memory budget. Failed loads are remembered as null entries so they aren't retried.
+// Everything except the generation counter is guarded by s_textureCacheMutex.
+struct StreamedTexture
+{
+  std::shared_ptr<HiresTexture> texture;
+  size_t size;
+  std::list<std::string>::iterator lru_position;
+};
+static std::unordered_map<std::string, StreamedTexture> s_streamed_textures;
+static std::list<std::string> s_streamed_lru;
+static std::unordered_set<std::string> s_streaming_requests;
+static size_t s_streamed_size = 0;
+static size_t s_streaming_budget = 0;
+static std::atomic<u32> s_streaming_generation{0};
+static std::unique_ptr<Common::WorkQueueThread<std::string>> s_streamer;
+
 static const std::string s_format_prefix = "tex1_";
+static const std::string s_pack_extension = ".dtp";
 
 void HiresTexture::Init()
 {
   Update();
 }
 
-void HiresTexture::Shutdown()
+static void ClearStreamedTextures()
 {
+  s_streamed_textures.clear();
+  s_streamed_lru.clear();
+  s_streaming_requests.clear();
+  s_streamed_size = 0;
+}
+
+static void StopLoading()
+{
+  s_textureCacheAbortLoading.Set();
+
   if (s_prefetcher.joinable())
-  {
-    s_textureCacheAbortLoading.Set();
     s_prefetcher.join();
-  }
+
+  // Any requests still queued are skipped by StreamTexture.
+  s_streamer.reset();
+}
+
+void HiresTexture::Shutdown()
+{
+  StopLoading();
 
   s_textureMap.clear();
   s_textureCache.clear();
+  ClearStreamedTextures();
 }
 
 void HiresTexture::Update()
 {
-  if (s_prefetcher.joinable())
-  {
-    s_textureCacheAbortLoading.Set();
-    s_prefetcher.join();
-  }
+  StopLoading();
+  ClearStreamedTextures();
 
   if (!g_ActiveConfig.bHiresTextures)
   {
@@ -86,48 +124,146 @@ void HiresTexture::Update()
   }
 
   const std::string& game_id = SConfig::GetInstance().GetGameID();
-  const std::string texture_directory = GetTextureDirectory(game_id);
-  const std::vector<std::string> extensions{".png", ".dds"};
+  ScanTextureDirectory(GetTextureDirectory(game_id), true);
+
+  if (g_ActiveConfig.bCacheHiresTextures)
+  {
+    // remove cached but deleted textures
+    auto iter = s_textureCache.begin();
+    while (iter != s_textureCache.end())
+    {
+      if (s_textureMap.find(iter->first) == s_textureMap.end())
+      {
+        iter = s_textureCache.erase(iter);
+      }
+      else
+      {
+        iter++;
+      }
+    }
+
+    s_textureCacheAbortLoading.Clear();
+    s_prefetcher = std::thread(Prefetch);
+  }
+  else if (g_ActiveConfig.bStreamHiresTextures)
+  {
+    s_streaming_budget = size_t(std::max(g_ActiveConfig.iHiresTextureStreamingBudget, 0)) << 20;
+    s_textureCacheAbortLoading.Clear();
+    s_streamer = std::make_unique<Common::WorkQueueThread<std::string>>(StreamTexture);
+  }
+}
+
+void HiresTexture::StreamTexture(const std::string& base_filename)
+{
+  if (s_textureCacheAbortLoading.IsSet())
+    return;
+
+  std::shared_ptr<HiresTexture> texture = Load(base_filename, 0, 0);
+
+  size_t size = 0;
+  if (texture)
+  {
+    for (const Level& l : texture->m_levels)
+      size += l.data.size();
+  }
+
+  {
+    std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+    s_streaming_requests.erase(base_filename);
+    s_streamed_lru.push_front(base_filename);
+    s_streamed_textures[base_filename] = {std::move(texture), size, s_streamed_lru.begin()};
+    s_streamed_size += size;
+    EvictStreamedTextures();
+  }
+
+  s_streaming_generation++;
+}
+
+void HiresTexture::EvictStreamedTextures()
+{
+  // The most recently used texture is always kept, even if it alone exceeds the budget.
+  while (s_streamed_size > s_streaming_budget && s_streamed_lru.size() > 1)
+  {
+    auto iter = s_streamed_textures.find(s_streamed_lru.back());
+    s_streamed_size -= iter->second.size;
+    s_streamed_textures.erase(iter);
+    s_streamed_lru.pop_back();
+  }
+}
+
+u32 HiresTexture::GetStreamingGeneration()
+{
+  return s_streaming_generation.load();
+}
+
+void HiresTexture::ScanTextureDirectory(const std::string& texture_directory, bool load_packs)
+{
+  std::vector<std::string> extensions{".png", ".dds"};
+  if (load_packs)
+    extensions.push_back(s_pack_extension);
 
   const std::vector<std::string> texture_paths =
       Common::DoFileSearch({texture_directory}, extensions, /*recursive*/ true);
 
-  const std::string code = game_id + "_";
-
   for (auto& path : texture_paths)
   {
     std::string filename;
-    SplitPath(path, nullptr, &filename, nullptr);
+    std::string extension;
+    SplitPath(path, nullptr, &filename, &extension);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
 
-    if (filename.substr(0, s_format_prefix.length()) == s_format_prefix)
+    if (extension == s_pack_extension)
+    {
+      // Loose files take precedence over packed textures, so packs can be patched without
+      // rebuilding them.
+      std::shared_ptr<HiresTexturePack> pack = HiresTexturePack::Open(path);
+      if (!pack)
+        continue;
+
+      for (const auto& texture : pack->GetTextures())
+        s_textureMap.emplace(texture.first,
+                             DiskTexture{path, texture.second.has_arbitrary_mipmaps, pack});
+    }
+    else if (filename.substr(0, s_format_prefix.length()) == s_format_prefix)
     {
       const size_t arb_index = filename.rfind("_arb");
       const bool has_arbitrary_mipmaps = arb_index != std::string::npos;
       if (has_arbitrary_mipmaps)
         filename.erase(arb_index, 4);
-      s_textureMap[filename] = {path, has_arbitrary_mipmaps};
+      s_textureMap[filename] = {path, has_arbitrary_mipmaps, nullptr};
     }
   }
+}
 
-  if (g_ActiveConfig.bCacheHiresTextures)
+bool HiresTexture::BuildTexturePack(const std::string& texture_directory,
+                                    const std::string& pack_path)
+{
+  s_textureMap.clear();
+  ScanTextureDirectory(texture_directory, false);
+
+  std::vector<std::pair<std::string, std::shared_ptr<HiresTexture>>> textures;
+  for (const auto& entry : s_textureMap)
   {
-    // remove cached but deleted textures
-    auto iter = s_textureCache.begin();
-    while (iter != s_textureCache.end())
+    const std::string& base_filename = entry.first;
+    if (base_filename.find("_mip") != std::string::npos)
+      continue;
+
+    std::shared_ptr<HiresTexture> texture = Load(base_filename, 0, 0);
+    if (!texture)
     {
-      if (s_textureMap.find(iter->first) == s_textureMap.end())
-      {
-        iter = s_textureCache.erase(iter);
-      }
-      else
-      {
-        iter++;
-      }
+      s_textureMap.clear();
+      return false;
     }
 
-    s_textureCacheAbortLoading.Clear();
-    s_prefetcher = std::thread(Prefetch);
+    textures.emplace_back(base_filename, std::move(texture));
   }
+  s_textureMap.clear();
+
+  // Sort by name, so that building the same textures always produces the same pack.
+  std::sort(textures.begin(), textures.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  return HiresTexturePack::Write(pack_path, textures);
 }
 
 void HiresTexture::Prefetch()
@@ -282,13 +418,33 @@ u32 HiresTexture::CalculateMipCount(u32 width, u32 height)
 std::shared_ptr<HiresTexture> HiresTexture::Search(const u8* texture, size_t texture_size,
                                                    const u8* tlut, size_t tlut_size, u32 width,
                                                    u32 height, TextureFormat format,
-                                                   bool has_mipmaps)
+                                                   bool has_mipmaps, bool* is_loading)
 {
   std::string base_filename =
       GenBaseName(texture, texture_size, tlut, tlut_size, width, height, format, has_mipmaps);
 
   std::lock_guard<std::mutex> lk(s_textureCacheMutex);
 
+  if (s_streamer)
+  {
+    if (base_filename.empty())
+      return nullptr;
+
+    auto streamed_iter = s_streamed_textures.find(base_filename);
+    if (streamed_iter != s_streamed_textures.end())
+    {
+      s_streamed_lru.splice(s_streamed_lru.begin(), s_streamed_lru,
+                            streamed_iter->second.lru_position);
+      return streamed_iter->second.texture;
+    }
+
+    if (s_streaming_requests.insert(base_filename).second)
+      s_streamer->EmplaceItem(base_filename);
+    if (is_loading)
+      *is_loading = true;
+    return nullptr;
+  }
+
   auto iter = s_textureCache.find(base_filename);
   if (iter != s_textureCache.end())
   {
@@ -319,37 +475,70 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
   std::unique_ptr<HiresTexture> ret = std::unique_ptr<HiresTexture>(new HiresTexture());
   const DiskTexture& first_mip_file = filename_iter->second;
   ret->m_has_arbitrary_mipmaps = first_mip_file.has_arbitrary_mipmaps;
-  LoadDDSTexture(ret.get(), first_mip_file.path);
 
-  // Load remaining mip levels, or from the start if it's not a DDS texture.
-  for (u32 mip_level = static_cast<u32>(ret->m_levels.size());; mip_level++)
+  if (first_mip_file.pack)
   {
-    std::string filename = base_filename;
-    if (mip_level != 0)
-      filename += StringFromFormat("_mip%u", mip_level);
-
-    filename_iter = s_textureMap.find(filename);
-    if (filename_iter == s_textureMap.end())
-      break;
-
-    // Try loading DDS textures first, that way we maintain compression of DXT formats.
-    // TODO: Reduce the number of open() calls here. We could use one fd.
-    Level level;
-    if (!LoadDDSTexture(level, filename_iter->second.path, mip_level))
+    // Packed textures already contain all of their mip levels in the upload format.
+    const HiresTexturePack::Texture& packed = first_mip_file.pack->GetTextures().at(base_filename);
+    for (const HiresTexturePack::Level& packed_level : packed.levels)
     {
-      File::IOFile file;
-      file.Open(filename_iter->second.path, "rb");
-      std::vector<u8> buffer(file.GetSize());
-      file.ReadBytes(buffer.data(), file.GetSize());
-
-      if (!LoadTexture(level, buffer))
+      const bool is_s3tc = packed_level.format == AbstractTextureFormat::DXT1 ||
+                           packed_level.format == AbstractTextureFormat::DXT3 ||
+                           packed_level.format == AbstractTextureFormat::DXT5;
+      if ((is_s3tc && !g_ActiveConfig.backend_info.bSupportsST3CTextures) ||
+          (packed_level.format == AbstractTextureFormat::BPTC &&
+           !g_ActiveConfig.backend_info.bSupportsBPTCTextures))
       {
-        ERROR_LOG(VIDEO, "Custom texture %s failed to load", filename.c_str());
-        break;
+        ERROR_LOG(VIDEO, "Custom texture %s uses a format which the backend doesn't support.",
+                  base_filename.c_str());
+        return nullptr;
       }
+
+      Level level;
+      level.format = packed_level.format;
+      level.width = packed_level.width;
+      level.height = packed_level.height;
+      level.row_length = packed_level.row_length;
+      level.mapped_data = packed_level.data;
+      level.mapped_size = packed_level.size;
+      ret->m_levels.push_back(std::move(level));
     }
+    ret->m_pack = first_mip_file.pack;
+  }
+  else
+  {
+    LoadDDSTexture(ret.get(), first_mip_file.path);
+
+    // Load remaining mip levels, or from the start if it's not a DDS texture.
+    for (u32 mip_level = static_cast<u32>(ret->m_levels.size());; mip_level++)
+    {
+      std::string filename = base_filename;
+      if (mip_level != 0)
+        filename += StringFromFormat("_mip%u", mip_level);
+
+      filename_iter = s_textureMap.find(filename);
+      if (filename_iter == s_textureMap.end())
+        break;
 
-    ret->m_levels.push_back(std::move(level));
+      // Try loading DDS textures first, that way we maintain compression of DXT formats.
+      // TODO: Reduce the number of open() calls here. We could use one fd.
+      Level level;
+      if (!LoadDDSTexture(level, filename_iter->second.path, mip_level))
+      {
+        File::IOFile file;
+        file.Open(filename_iter->second.path, "rb");
+        std::vector<u8> buffer(file.GetSize());
+        file.ReadBytes(buffer.data(), file.GetSize());
+
+        if (!LoadTexture(level, buffer))
+        {
+          ERROR_LOG(VIDEO, "Custom texture %s failed to load", filename.c_str());
+          break;
+        }
+      }
+
+      ret->m_levels.push_back(std::move(level));
+    }
   }
 
   // If we failed to load any mip levels, we can't use this texture at all.
@@ -12,6 +12,7 @@
 #include "VideoCommon/TextureConfig.h"
 
 enum class TextureFormat;
+class HiresTexturePack;
 
 class HiresTexture
 {
@@ -20,9 +21,14 @@ public:
   static void Update();
   static void Shutdown();
 
+  // When streaming is enabled, textures which are not resident yet are queued for loading in the
+  // background and nullptr is returned with is_loading set. GetStreamingGeneration() changes once
+  // any of them has finished loading.
   static std::shared_ptr<HiresTexture> Search(const u8* texture, size_t texture_size,
                                               const u8* tlut, size_t tlut_size, u32 width,
-                                              u32 height, TextureFormat format, bool has_mipmaps);
+                                              u32 height, TextureFormat format, bool has_mipmaps,
+                                              bool* is_loading = nullptr);
+  static u32 GetStreamingGeneration();
 
   static std::string GenBaseName(const u8* texture, size_t texture_size, const u8* tlut,
                                  size_t tlut_size, u32 width, u32 height, TextureFormat format,
@@ -30,6 +36,9 @@ public:
 
   static u32 CalculateMipCount(u32 width, u32 height);
 
+  // Packs every custom texture in texture_directory into a single texture pack.
+  static bool BuildTexturePack(const std::string& texture_directory, const std::string& pack_path);
+
   ~HiresTexture();
 
   AbstractTextureFormat GetFormat() const;
@@ -42,6 +51,13 @@ public:
     u32 width = 0;
     u32 height = 0;
     u32 row_length = 0;
+
+    // Levels loaded from a texture pack point into the mapped file instead of owning their data.
+    const u8* mapped_data = nullptr;
+    size_t mapped_size = 0;
+
+    const u8* GetData() const { return mapped_data ? mapped_data : data.data(); }
+    size_t GetSize() const { return mapped_data ? mapped_size : data.size(); }
   };
   std::vector<Level> m_levels;
 
@@ -52,9 +68,13 @@ private:
   static bool LoadDDSTexture(Level& level, const std::string& filename, u32 mip_level);
   static bool LoadTexture(Level& level, const std::vector<u8>& buffer);
   static void Prefetch();
+  static void StreamTexture(const std::string& base_filename);
+  static void EvictStreamedTextures();
 
   static std::string GetTextureDirectory(const std::string& game_id);
+  static void ScanTextureDirectory(const std::string& texture_directory, bool load_packs);
 
   HiresTexture() {}
   bool m_has_arbitrary_mipmaps;
+  std::shared_ptr<HiresTexturePack> m_pack;
 };
@@ -33,9 +33,10 @@ TextureToPng
 Inputs:
 data      : This is an array of RGBA with 8 bits per channel. 4 bytes for each pixel.
 row_stride: Determines the amount of bytes per row of pixels.
+compression_level: zlib compression level, 0 stores the image uncompressed.
 */
 bool TextureToPng(const u8* data, int row_stride, const std::string& filename, int width,
-                  int height, bool saveAlpha)
+                  int height, bool saveAlpha, int compression_level)
 {
   if (!data)
     return false;
@@ -90,6 +91,11 @@ bool TextureToPng(const u8* data, int row_stride, const std::string& filename, i
 
   png_init_io(png_ptr, fp.GetHandle());
 
+  png_set_compression_level(png_ptr, compression_level);
+  // Filtering only helps compression, and costs as much as fast compression does.
+  if (compression_level == 0)
+    png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_NONE);
+
   // Write header (8 bit color depth)
   png_set_IHDR(png_ptr, info_ptr, width, height, 8, PNG_COLOR_TYPE_RGB_ALPHA, PNG_INTERLACE_NONE,
                PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
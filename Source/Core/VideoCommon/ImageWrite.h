@@ -8,5 +8,6 @@
 #include "Common/CommonTypes.h"
 
 bool SaveData(const std::string& filename, const std::string& data);
+// A compression_level of -1 uses the zlib default.
 bool TextureToPng(const u8* data, int row_stride, const std::string& filename, int width,
-                  int height, bool saveAlpha = true);
+                  int height, bool saveAlpha = true, int compression_level = -1);
@@ -4,8 +4,10 @@
 
 #include <cstddef>
 
+#include "Common/Assert.h"
 #include "Common/Common.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/Logging/Log.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/OpcodeDecoding.h"
@@ -22,25 +24,27 @@ static u16* (*primitive_table[8])(u16*, u32, u32);
 
 void IndexGenerator::Init()
 {
+  // Block sizes are chosen so that each block is a whole number of primitives and its indices
+  // fill whole 128-bit vectors.
   if (g_Config.backend_info.bSupportsPrimitiveRestart)
   {
-    primitive_table[OpcodeDecoder::GX_DRAW_QUADS] = AddQuads<true>;
+    primitive_table[OpcodeDecoder::GX_DRAW_QUADS] = AddBlocks<AddQuads<true>, 32, 40>;
     primitive_table[OpcodeDecoder::GX_DRAW_QUADS_2] = AddQuads_nonstandard<true>;
-    primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLES] = AddList<true>;
+    primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLES] = AddBlocks<AddList<true>, 6, 8>;
     primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP] = AddStrip<true>;
     primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLE_FAN] = AddFan<true>;
   }
   else
   {
-    primitive_table[OpcodeDecoder::GX_DRAW_QUADS] = AddQuads<false>;
+    primitive_table[OpcodeDecoder::GX_DRAW_QUADS] = AddBlocks<AddQuads<false>, 16, 24>;
     primitive_table[OpcodeDecoder::GX_DRAW_QUADS_2] = AddQuads_nonstandard<false>;
-    primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLES] = AddList<false>;
+    primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLES] = AddBlocks<AddList<false>, 24, 24>;
     primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP] = AddStrip<false>;
     primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLE_FAN] = AddFan<false>;
   }
-  primitive_table[OpcodeDecoder::GX_DRAW_LINES] = &AddLineList;
+  primitive_table[OpcodeDecoder::GX_DRAW_LINES] = AddBlocks<AddLineList, 8, 8>;
   primitive_table[OpcodeDecoder::GX_DRAW_LINE_STRIP] = &AddLineStrip;
-  primitive_table[OpcodeDecoder::GX_DRAW_POINTS] = &AddPoints;
+  primitive_table[OpcodeDecoder::GX_DRAW_POINTS] = AddBlocks<AddPoints, 8, 8>;
 }
 
 void IndexGenerator::Start(u16* Indexptr)
@@ -242,6 +246,52 @@ u16* IndexGenerator::AddPoints(u16* Iptr, u32 numVerts, u32 index)
   return Iptr;
 }
 
+template <u16* (*Generate)(u16*, u32, u32), u32 block_verts, u32 block_indices>
+u16* IndexGenerator::AddBlocks(u16* Iptr, u32 numVerts, u32 index)
+{
+  static_assert(block_indices % 8 == 0, "Blocks must fill whole vectors");
+
+  // The indices of a block starting at index 0. Adding the index of a block gives its indices,
+  // except for the primitive restart indices, which have all bits set and are ORed back in.
+  struct Pattern
+  {
+    Pattern()
+    {
+      const u16* end = Generate(indices, block_verts, 0);
+      ASSERT(end == indices + block_indices);
+      for (u32 i = 0; i < block_indices; i++)
+        restart[i] = indices[i] == s_primitive_restart ? s_primitive_restart : 0;
+    }
+
+    alignas(16) u16 indices[block_indices];
+    alignas(16) u16 restart[block_indices];
+  };
+  static const Pattern pattern;
+
+  const u32 blocks = numVerts / block_verts;
+  for (u32 block = 0; block < blocks; block++)
+  {
+#ifdef _M_X86
+    const __m128i block_index = _mm_set1_epi16(static_cast<s16>(index));
+    for (u32 i = 0; i < block_indices; i += 8)
+    {
+      const __m128i indices =
+          _mm_add_epi16(_mm_load_si128(reinterpret_cast<const __m128i*>(&pattern.indices[i])),
+                        block_index);
+      const __m128i restart = _mm_load_si128(reinterpret_cast<const __m128i*>(&pattern.restart[i]));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(Iptr + i), _mm_or_si128(indices, restart));
+    }
+#else
+    for (u32 i = 0; i < block_indices; i++)
+      Iptr[i] = static_cast<u16>(pattern.indices[i] + index) | pattern.restart[i];
+#endif
+    Iptr += block_indices;
+    index += block_verts;
+  }
+
+  return Generate(Iptr, numVerts - blocks * block_verts, index);
+}
+
 u32 IndexGenerator::GetRemainingIndices()
 {
   u32 max_index = 65534;  // -1 is reserved for primitive restart (ogl + dx11)
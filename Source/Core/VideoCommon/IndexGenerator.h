@@ -43,6 +43,11 @@ private:
   // Points
   static u16* AddPoints(u16* Iptr, u32 numVerts, u32 index);
 
+  // Writes the indices of whole blocks of block_verts vertices from a precomputed pattern, and
+  // leaves the remaining vertices to Generate.
+  template <u16* (*Generate)(u16*, u32, u32), u32 block_verts, u32 block_indices>
+  static u16* AddBlocks(u16* Iptr, u32 numVerts, u32 index);
+
   template <bool pr>
   static u16* WriteTriangle(u16* Iptr, u32 index1, u32 index2, u32 index3);
 
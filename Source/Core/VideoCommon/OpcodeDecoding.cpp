@@ -15,9 +15,16 @@
 // when they are called. The reason is that the vertex format affects the sizes of the vertices.
 
 #include "VideoCommon/OpcodeDecoding.h"
+
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
 #include "Common/CommonTypes.h"
+#include "Common/Hash.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/Profiler.h"
 #include "Core/FifoPlayer/FifoRecorder.h"
 #include "Core/HW/Memmap.h"
 #include "VideoCommon/BPMemory.h"
@@ -36,6 +43,137 @@ namespace OpcodeDecoder
 {
 static bool s_bFifoErrorSeen = false;
 
+// As noted above, a display list can only be decoded for the vertex format it was called with.
+// Display lists are recorded into a list of commands while they are interpreted, which is then
+// replayed when the same data is called again with the same vertex format.
+struct DisplayListCommand
+{
+  enum Type : u8
+  {
+    CP,
+    XF,
+    INDEXED_XF,
+    BP,
+    DRAW,
+  };
+
+  Type type;
+  u8 sub_cmd;       // CP register, indexed XF array or draw command byte
+  u16 count;        // number of vertices
+  u32 value;        // register value or XF command
+  u32 data_offset;  // offset of the XF data or vertices in the display list
+};
+
+struct CachedDisplayList
+{
+  u32 size;
+  u64 hash;
+  TVtxDesc vtx_desc;
+  VAT vtx_attr[8];
+  u32 cycles;
+  bool valid;
+  std::vector<DisplayListCommand> commands;
+};
+
+static std::unordered_map<u32, CachedDisplayList> s_display_list_cache;
+static CachedDisplayList* s_recording_display_list = nullptr;
+static const u8* s_recording_start = nullptr;
+constexpr size_t DISPLAY_LIST_CACHE_MAX_ENTRIES = 8192;
+
+static void RecordCommand(DisplayListCommand::Type type, u8 sub_cmd, u16 count, u32 value,
+                          const u8* data)
+{
+  if (s_recording_display_list)
+  {
+    const u32 data_offset = data ? static_cast<u32>(data - s_recording_start) : 0;
+    s_recording_display_list->commands.push_back({type, sub_cmd, count, value, data_offset});
+  }
+}
+
+static void ReplayDisplayList(const CachedDisplayList& dl, const u8* start_address)
+{
+  const u8* end_address = start_address + dl.size;
+  for (const DisplayListCommand& command : dl.commands)
+  {
+    switch (command.type)
+    {
+    case DisplayListCommand::CP:
+      LoadCPReg(command.sub_cmd, command.value, false);
+      INCSTAT(stats.thisFrame.numCPLoads);
+      break;
+
+    case DisplayListCommand::XF:
+      LoadXFReg(((command.value >> 16) & 15) + 1, command.value & 0xFFFF,
+                DataReader(const_cast<u8*>(start_address + command.data_offset),
+                           const_cast<u8*>(end_address)));
+      INCSTAT(stats.thisFrame.numXFLoads);
+      break;
+
+    case DisplayListCommand::INDEXED_XF:
+      LoadIndexedXF(command.value, command.sub_cmd);
+      break;
+
+    case DisplayListCommand::BP:
+      LoadBPReg(command.value);
+      INCSTAT(stats.thisFrame.numBPLoads);
+      break;
+
+    case DisplayListCommand::DRAW:
+      VertexLoaderManager::RunVertices(
+          command.sub_cmd & GX_VAT_MASK,
+          (command.sub_cmd & GX_PRIMITIVE_MASK) >> GX_PRIMITIVE_SHIFT, command.count,
+          DataReader(const_cast<u8*>(start_address + command.data_offset),
+                     const_cast<u8*>(end_address)),
+          false, true);
+      break;
+    }
+  }
+}
+
+static bool MatchesVertexFormat(const CachedDisplayList& dl)
+{
+  return dl.vtx_desc.Hex == g_main_cp_state.vtx_desc.Hex &&
+         std::memcmp(dl.vtx_attr, g_main_cp_state.vtx_attr, sizeof(dl.vtx_attr)) == 0;
+}
+
+static u32 RunCachedDisplayList(u32 address, u8* start_address, u32 size)
+{
+  const u64 hash = Common::GetHash64(start_address, size, 0);
+  auto iter = s_display_list_cache.find(address);
+  if (iter != s_display_list_cache.end() && iter->second.valid && iter->second.size == size &&
+      iter->second.hash == hash && MatchesVertexFormat(iter->second))
+  {
+    ReplayDisplayList(iter->second, start_address);
+    return iter->second.cycles;
+  }
+
+  if (iter == s_display_list_cache.end())
+  {
+    if (s_display_list_cache.size() >= DISPLAY_LIST_CACHE_MAX_ENTRIES)
+      s_display_list_cache.clear();
+    iter = s_display_list_cache.emplace(address, CachedDisplayList{}).first;
+  }
+
+  CachedDisplayList& dl = iter->second;
+  dl.size = size;
+  dl.hash = hash;
+  dl.vtx_desc = g_main_cp_state.vtx_desc;
+  std::memcpy(dl.vtx_attr, g_main_cp_state.vtx_attr, sizeof(dl.vtx_attr));
+  dl.valid = true;
+  dl.commands.clear();
+
+  s_recording_display_list = &dl;
+  s_recording_start = start_address;
+  u32 cycles = 0;
+  const u8* end = Run(DataReader(start_address, start_address + size), &cycles, true);
+  s_recording_display_list = nullptr;
+
+  // Truncated display lists can't be replayed, as Run stops at the incomplete command.
+  dl.cycles = cycles;
+  dl.valid &= end == start_address + size;
+  return cycles;
+}
+
 static u32 InterpretDisplayList(u32 address, u32 size)
 {
   u8* startAddress;
@@ -53,7 +191,11 @@ static u32 InterpretDisplayList(u32 address, u32 size)
     // temporarily swap dl and non-dl (small "hack" for the stats)
     Statistics::SwapDL();
 
-    Run(DataReader(startAddress, startAddress + size), &cycles, true);
+    // The FIFO recorder needs to see every command.
+    if (g_bRecordFifoData)
+      Run(DataReader(startAddress, startAddress + size), &cycles, true);
+    else
+      cycles = RunCachedDisplayList(address, startAddress, size);
     INCSTAT(stats.thisFrame.numDListsCalled);
 
     // un-swap
@@ -78,11 +220,14 @@ static void InterpretDisplayListPreprocess(u32 address, u32 size)
 void Init()
 {
   s_bFifoErrorSeen = false;
+  s_display_list_cache.clear();
 }
 
 template <bool is_preprocess>
 u8* Run(DataReader src, u32* cycles, bool in_display_list)
 {
+  PROFILE(is_preprocess ? "OpcodeDecoder::Preprocess" : "OpcodeDecoder::Run");
+
   u32 totalCycles = 0;
   u8* opcodeStart;
   while (true)
@@ -114,7 +259,10 @@ u8* Run(DataReader src, u32* cycles, bool in_display_list)
       u32 value = src.Read<u32>();
       LoadCPReg(sub_cmd, value, is_preprocess);
       if (!is_preprocess)
+      {
+        RecordCommand(DisplayListCommand::CP, sub_cmd, 0, value, nullptr);
         INCSTAT(stats.thisFrame.numCPLoads);
+      }
     }
     break;
 
@@ -130,6 +278,7 @@ u8* Run(DataReader src, u32* cycles, bool in_display_list)
       if (!is_preprocess)
       {
         u32 xf_address = Cmd2 & 0xFFFF;
+        RecordCommand(DisplayListCommand::XF, 0, 0, Cmd2, src.GetPointer());
         LoadXFReg(transfer_size, xf_address, src);
 
         INCSTAT(stats.thisFrame.numXFLoads);
@@ -155,9 +304,15 @@ u8* Run(DataReader src, u32* cycles, bool in_display_list)
         goto end;
       totalCycles += 6;
       if (is_preprocess)
+      {
         PreprocessIndexedXF(src.Read<u32>(), refarray);
+      }
       else
-        LoadIndexedXF(src.Read<u32>(), refarray);
+      {
+        u32 value = src.Read<u32>();
+        RecordCommand(DisplayListCommand::INDEXED_XF, refarray, 0, value, nullptr);
+        LoadIndexedXF(value, refarray);
+      }
       break;
 
     case GX_CMD_CALL_DL:
@@ -207,6 +362,7 @@ u8* Run(DataReader src, u32* cycles, bool in_display_list)
         }
         else
         {
+          RecordCommand(DisplayListCommand::BP, 0, 0, bp_cmd, nullptr);
           LoadBPReg(bp_cmd);
           INCSTAT(stats.thisFrame.numBPLoads);
         }
@@ -221,9 +377,12 @@ u8* Run(DataReader src, u32* cycles, bool in_display_list)
         if (src.size() < 2)
           goto end;
         u16 num_vertices = src.Read<u16>();
+        if (!is_preprocess)
+          RecordCommand(DisplayListCommand::DRAW, cmd_byte, num_vertices, 0, src.GetPointer());
         int bytes = VertexLoaderManager::RunVertices(
             cmd_byte & GX_VAT_MASK,  // Vertex loader index (0 - 7)
-            (cmd_byte & GX_PRIMITIVE_MASK) >> GX_PRIMITIVE_SHIFT, num_vertices, src, is_preprocess);
+            (cmd_byte & GX_PRIMITIVE_MASK) >> GX_PRIMITIVE_SHIFT, num_vertices, src, is_preprocess,
+            in_display_list);
 
         if (bytes < 0)
           goto end;
@@ -241,6 +400,10 @@ u8* Run(DataReader src, u32* cycles, bool in_display_list)
                   opcodeStart, is_preprocess ? "yes" : "no");
         s_bFifoErrorSeen = true;
         totalCycles += 1;
+
+        // Keep reporting the error instead of replaying around it.
+        if (!is_preprocess && s_recording_display_list)
+          s_recording_display_list->valid = false;
       }
       break;
     }
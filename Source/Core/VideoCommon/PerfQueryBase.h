@@ -47,6 +47,9 @@ public:
   // Request the value of any pending queries - causes a pipeline flush and thus should be used
   // carefully!
   virtual void FlushResults() {}
+  // Collect the results of the queries which the host GPU has already finished, and get the others
+  // going, without waiting for them
+  virtual void PollResults() {}
   // True if there are no further pending query results
   // NOTE: Called from CPU thread
   virtual bool IsFlushed() const { return true; }
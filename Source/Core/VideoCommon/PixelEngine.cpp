@@ -226,8 +226,15 @@ void RegisterMMIO(MMIO::Mapping* mmio, u32 base)
                    UpdateInterrupts();
                  }));
 
-  // Token register, readonly.
-  mmio->Register(base | PE_TOKEN_REG, MMIO::DirectRead<u16>(&s_token), MMIO::InvalidWrite<u16>());
+  // Token register, readonly. In dual core mode, the GPU thread can update it directly.
+  mmio->Register(base | PE_TOKEN_REG,
+                 SConfig::GetInstance().bCPUThread ?
+                     MMIO::ComplexRead<u16>([](u32) {
+                       std::lock_guard<std::mutex> lk(s_token_finish_mutex);
+                       return s_token;
+                     }) :
+                     MMIO::DirectRead<u16>(&s_token),
+                 MMIO::InvalidWrite<u16>());
 
   // BBOX registers, readonly and need to update a flag.
   for (int i = 0; i < 4; ++i)
@@ -303,6 +310,16 @@ void SetToken(const u16 token, const bool interrupt)
   s_token_pending = token;
   s_token_interrupt_pending |= interrupt;
 
+  // Games which poll the token register don't need to wait until the CPU thread handles an event,
+  // unless the token must become visible at a deterministic time. Tokens without an interrupt
+  // don't need an event at all then.
+  if (SConfig::GetInstance().bCPUThread && !Fifo::UseDeterministicGPUThread())
+  {
+    s_token = token;
+    if (!s_token_interrupt_pending)
+      return;
+  }
+
   RaiseEvent();
 }
 
@@ -319,6 +336,12 @@ void SetFinish()
   RaiseEvent();
 }
 
+bool IsEventPending()
+{
+  std::lock_guard<std::mutex> lk(s_token_finish_mutex);
+  return s_event_raised;
+}
+
 UPEAlphaReadReg GetAlphaReadMode()
 {
   return m_AlphaRead;
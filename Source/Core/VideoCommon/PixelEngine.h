@@ -64,6 +64,8 @@ void RegisterMMIO(MMIO::Mapping* mmio, u32 base);
 // gfx backend support
 void SetToken(const u16 token, const bool interrupt);
 void SetFinish();
+// Whether a token or finish event has been raised that the CPU thread hasn't handled yet
+bool IsEventPending();
 UPEAlphaReadReg GetAlphaReadMode();
 
 }  // end of namespace PixelEngine
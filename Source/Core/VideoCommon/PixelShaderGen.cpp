@@ -348,6 +348,22 @@ void ClearUnusedPixelShaderUidBits(APIType ApiType, const ShaderHostConfig& host
   // uint output when logic op is not supported (i.e. driver/device does not support D3D11.1).
   if (ApiType != APIType::D3D || !host_config.backend_logic_op)
     uid_data->uint_output = 0;
+
+  // The remaining bits don't affect the generated code in some states, so clear them to let
+  // these UIDs share a single shader.
+  if (uid_data->fog_fsel == 0)
+  {
+    uid_data->fog_proj = 0;
+    uid_data->fog_RangeBaseEnabled = 0;
+  }
+
+  // Z textures are only applied when the result is written to the depth buffer or used for fog.
+  if (!uid_data->per_pixel_depth)
+  {
+    uid_data->early_ztest = 0;
+    if (uid_data->fog_fsel == 0)
+      uid_data->ztex_op = ZTEXTURE_DISABLE;
+  }
 }
 
 void WritePixelShaderCommonHeader(ShaderCode& out, APIType ApiType, u32 num_texgens,
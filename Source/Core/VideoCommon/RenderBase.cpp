@@ -14,6 +14,7 @@
 
 #include "VideoCommon/RenderBase.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <cmath>
 #include <memory>
@@ -38,9 +39,16 @@
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/FifoPlayer/FifoRecorder.h"
+#include "Core/HW/SystemTimers.h"
 #include "Core/HW/VideoInterface.h"
+#include "Core/HW/WiimoteReal/WiimoteReal.h"
 #include "Core/Host.h"
 #include "Core/Movie.h"
+#ifdef USE_SHARED_MEMORY_EXPORT
+#include "Core/SharedMemoryExport.h"
+#endif
+
+#include "InputCommon/GCAdapter.h"
 
 #include "VideoCommon/AVIDump.h"
 #include "VideoCommon/AbstractFramebuffer.h"
@@ -98,6 +106,14 @@ void Renderer::Shutdown()
   // First stop any framedumping, which might need to dump the last xfb frame. This process
   // can require additional graphics sub-systems so it needs to be done first
   ShutdownFrameDumping();
+
+  // Keep the counters of the last frames the statistics were shown for, to compare runs
+  if (g_ActiveConfig.bOverlayStats)
+  {
+    const std::string path = File::GetUserPath(D_DUMP_IDX) + "Statistics.json";
+    if (File::WriteStringToFile(Statistics::HistoryToJSON(), path))
+      NOTICE_LOG(VIDEO, "Wrote the statistics of the last frames to %s", path.c_str());
+  }
 }
 
 void Renderer::RenderToXFB(u32 xfbAddr, const EFBRectangle& sourceRc, u32 fbStride, u32 fbHeight,
@@ -139,6 +155,12 @@ std::tuple<int, int> Renderer::CalculateTargetScale(int x, int y) const
   return std::make_tuple(x * static_cast<int>(m_efb_scale), y * static_cast<int>(m_efb_scale));
 }
 
+// Dynamic resolution measures the emulation speed over intervals of this length.
+static constexpr u64 DYNAMIC_RESOLUTION_INTERVAL_US = 2000000;
+// Intervals at full speed before the scale is raised again, doubling after every drop.
+static constexpr u32 DYNAMIC_RESOLUTION_MIN_RAISE_INTERVALS = 2;
+static constexpr u32 DYNAMIC_RESOLUTION_MAX_RAISE_INTERVALS = 32;
+
 // return true if target size changed
 bool Renderer::CalculateTargetSize()
 {
@@ -152,6 +174,8 @@ bool Renderer::CalculateTargetSize()
   else
   {
     m_efb_scale = g_ActiveConfig.iEFBScale;
+    if (m_dynamic_efb_scale != 0)
+      m_efb_scale = std::min(m_efb_scale, m_dynamic_efb_scale);
   }
 
   const u32 max_size = g_ActiveConfig.backend_info.MaxTextureSize;
@@ -167,6 +191,7 @@ bool Renderer::CalculateTargetSize()
     m_target_width = new_efb_width;
     m_target_height = new_efb_height;
     PixelShaderManager::SetEfbScaleChanged(EFBToScaledXf(1), EFBToScaledYf(1));
+    IncrementEFBGeneration();
     return true;
   }
   return false;
@@ -248,6 +273,69 @@ bool Renderer::CheckForHostConfigChanges()
   return true;
 }
 
+void Renderer::UpdateDynamicResolution(u64 ticks)
+{
+  if (!g_ActiveConfig.bDynamicResolution || g_ActiveConfig.iEFBScale <= 1)
+  {
+    m_dynamic_efb_scale = 0;
+    m_dynamic_resolution_time = 0;
+    return;
+  }
+
+  const u64 time = Common::Timer::GetTimeUs();
+  const u64 elapsed = time - m_dynamic_resolution_time;
+  if (m_dynamic_resolution_time != 0 && elapsed < DYNAMIC_RESOLUTION_INTERVAL_US)
+    return;
+
+  // Start a new interval without judging the last one if it is the first, or if it was stretched
+  // by the emulation being paused.
+  const u64 elapsed_ticks = ticks - m_dynamic_resolution_ticks;
+  const bool valid_interval =
+      m_dynamic_resolution_time != 0 && elapsed < DYNAMIC_RESOLUTION_INTERVAL_US * 2;
+  m_dynamic_resolution_time = time;
+  m_dynamic_resolution_ticks = ticks;
+  if (!valid_interval)
+    return;
+
+  const unsigned int max_scale = static_cast<unsigned int>(g_ActiveConfig.iEFBScale);
+  unsigned int scale = m_dynamic_efb_scale != 0 ? m_dynamic_efb_scale : max_scale;
+  if (m_dynamic_resolution_raise_intervals == 0)
+    m_dynamic_resolution_raise_intervals = DYNAMIC_RESOLUTION_MIN_RAISE_INTERVALS;
+
+  const float emulation_speed = SConfig::GetInstance().m_EmulationSpeed;
+  const float target_speed = emulation_speed > 0.0f ? emulation_speed : 1.0f;
+  const float speed = static_cast<float>(elapsed_ticks) * 1000000.0f /
+                      (static_cast<float>(SystemTimers::GetTicksPerSecond()) * elapsed);
+  if (speed < target_speed * 0.95f)
+  {
+    m_dynamic_resolution_full_speed_intervals = 0;
+    if (scale > 1)
+    {
+      scale--;
+      m_dynamic_resolution_raise_intervals = std::min(m_dynamic_resolution_raise_intervals * 2,
+                                                      DYNAMIC_RESOLUTION_MAX_RAISE_INTERVALS);
+    }
+  }
+  else if (speed >= target_speed * 0.99f)
+  {
+    if (scale < max_scale &&
+        ++m_dynamic_resolution_full_speed_intervals >= m_dynamic_resolution_raise_intervals)
+    {
+      scale++;
+      m_dynamic_resolution_full_speed_intervals = 0;
+    }
+  }
+  else
+  {
+    m_dynamic_resolution_full_speed_intervals = 0;
+  }
+
+  if (scale != (m_dynamic_efb_scale != 0 ? m_dynamic_efb_scale : max_scale))
+    INFO_LOG(VIDEO, "Dynamic resolution: %ux native at %.0f%% speed", scale, speed * 100.0f);
+
+  m_dynamic_efb_scale = scale < max_scale ? scale : 0;
+}
+
 // Create On-Screen-Messages
 void Renderer::DrawDebugText()
 {
@@ -256,7 +344,11 @@ void Renderer::DrawDebugText()
   if (g_ActiveConfig.bShowFPS || SConfig::GetInstance().m_ShowFrameCount)
   {
     if (g_ActiveConfig.bShowFPS)
+    {
       final_cyan += StringFromFormat("FPS: %.2f", m_fps_counter.GetFPS());
+      if (g_ActiveConfig.bLowLatencyPresent)
+        final_cyan += StringFromFormat(" (%.2f ms present)", m_fps_counter.GetPresentLatency());
+    }
 
     if (g_ActiveConfig.bShowFPS && SConfig::GetInstance().m_ShowFrameCount)
       final_cyan += " - ";
@@ -281,6 +373,8 @@ void Renderer::DrawDebugText()
   if (SConfig::GetInstance().m_ShowInputDisplay)
   {
     final_cyan += Movie::GetInputDisplay();
+    final_cyan += WiimoteReal::GetReportLatencyDisplay();
+    final_cyan += GCAdapter::GetReportLatencyDisplay();
     final_yellow += "\n";
   }
 
@@ -373,6 +467,7 @@ void Renderer::DrawDebugText()
     }
   }
 
+  Common::Profiler::SetEnabled(g_ActiveConfig.bOverlayTimings);
   final_cyan += Common::Profiler::ToString();
 
   if (g_ActiveConfig.bOverlayStats)
@@ -411,6 +506,11 @@ bool Renderer::IsHeadless() const
   return !m_surface_handle;
 }
 
+bool Renderer::ShouldSkipPresent() const
+{
+  return IsHeadless() || Movie::IsVerifyingPlayback();
+}
+
 void Renderer::ChangeSurface(void* new_surface_handle)
 {
   std::lock_guard<std::mutex> lock(m_swap_mutex);
@@ -682,8 +782,11 @@ void Renderer::Swap(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight, const
 
       // TODO: merge more generic parts into VideoCommon
       {
+        PROFILE("Renderer::SwapImpl");
         std::lock_guard<std::mutex> guard(m_swap_mutex);
+        const u64 present_start = Common::Timer::GetTimeUs();
         g_renderer->SwapImpl(xfb_entry->texture.get(), xfb_rect, ticks);
+        m_fps_counter.UpdatePresentLatency(Common::Timer::GetTimeUs() - present_start);
       }
 
       // Update the window size based on the frame that was just rendered.
@@ -691,8 +794,9 @@ void Renderer::Swap(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight, const
       SetWindowSize(texture_config.width, texture_config.height);
 
       m_fps_counter.Update();
+      UpdateDynamicResolution(ticks);
 
-      if (IsFrameDumping())
+      if (IsFrameDumping() || IsFrameExporting())
         DumpCurrentFrame();
 
       frameCount++;
@@ -730,6 +834,15 @@ bool Renderer::IsFrameDumping()
   return false;
 }
 
+bool Renderer::IsFrameExporting()
+{
+#ifdef USE_SHARED_MEMORY_EXPORT
+  return SharedMemoryExport::IsActive();
+#else
+  return false;
+#endif
+}
+
 void Renderer::DumpCurrentFrame()
 {
   // Scale/render to frame dump texture.
@@ -784,11 +897,13 @@ void Renderer::RenderFrameDump()
 
 void Renderer::QueueFrameDumpReadback()
 {
-  // Index 0 was just sent to AVI dump. Swap with the second texture.
-  if (m_frame_dump_readback_textures[0])
-    std::swap(m_frame_dump_readback_textures[0], m_frame_dump_readback_textures[1]);
+  // The current texture was just sent to AVI dump. Move on to the one the oldest frame, which has
+  // been encoded by now, was read back to.
+  m_frame_dump_readback_index =
+      (m_frame_dump_readback_index + 1) % m_frame_dump_readback_textures.size();
 
-  std::unique_ptr<AbstractStagingTexture>& rbtex = m_frame_dump_readback_textures[0];
+  std::unique_ptr<AbstractStagingTexture>& rbtex =
+      m_frame_dump_readback_textures[m_frame_dump_readback_index];
   if (!rbtex || rbtex->GetConfig() != m_frame_dump_render_texture->GetConfig())
   {
     rbtex = CreateStagingTexture(StagingTextureType::Readback,
@@ -797,6 +912,7 @@ void Renderer::QueueFrameDumpReadback()
 
   m_last_frame_state = AVIDump::FetchState(m_last_xfb_ticks);
   m_last_frame_exported = true;
+  m_last_frame_dumped = IsFrameDumping();
   rbtex->CopyFromTexture(m_frame_dump_render_texture.get(), 0, 0);
 }
 
@@ -805,17 +921,21 @@ void Renderer::FlushFrameDump()
   if (!m_last_frame_exported)
     return;
 
-  // Ensure the previously-queued frame was encoded.
-  FinishFrameData();
-
   // Queue encoding of the last frame dumped.
-  std::unique_ptr<AbstractStagingTexture>& rbtex = m_frame_dump_readback_textures[0];
+  std::unique_ptr<AbstractStagingTexture>& rbtex =
+      m_frame_dump_readback_textures[m_frame_dump_readback_index];
   rbtex->Flush();
   if (rbtex->Map())
   {
-    DumpFrameData(reinterpret_cast<u8*>(rbtex->GetMappedPointer()), rbtex->GetConfig().width,
-                  rbtex->GetConfig().height, static_cast<int>(rbtex->GetMappedStride()),
-                  m_last_frame_state);
+    const u8* data = reinterpret_cast<u8*>(rbtex->GetMappedPointer());
+    const int width = rbtex->GetConfig().width;
+    const int height = rbtex->GetConfig().height;
+    const int stride = static_cast<int>(rbtex->GetMappedStride());
+#ifdef USE_SHARED_MEMORY_EXPORT
+    SharedMemoryExport::ExportFrame(data, width, height, stride);
+#endif
+    if (m_last_frame_dumped)
+      DumpFrameData(data, width, height, stride, m_last_frame_state);
     rbtex->Unmap();
   }
 
@@ -849,8 +969,6 @@ void Renderer::ShutdownFrameDumping()
 
 void Renderer::DumpFrameData(const u8* data, int w, int h, int stride, const AVIDump::Frame& state)
 {
-  m_frame_dump_config = FrameDumpConfig{data, w, h, stride, state};
-
   if (!m_frame_dump_thread_running.IsSet())
   {
     if (m_frame_dump_thread.joinable())
@@ -859,18 +977,20 @@ void Renderer::DumpFrameData(const u8* data, int w, int h, int stride, const AVI
     m_frame_dump_thread = std::thread(&Renderer::RunFrameDumps, this);
   }
 
+  // Wait for the encoder to catch up if it is too far behind.
+  while (m_frame_dump_queue.Size() >= MAX_QUEUED_FRAME_DUMPS)
+    m_frame_dump_done.Wait();
+
+  m_frame_dump_queue.Push(FrameDumpConfig{data, w, h, stride, state});
+
   // Wake worker thread up.
   m_frame_dump_start.Set();
-  m_frame_dump_frame_running = true;
 }
 
 void Renderer::FinishFrameData()
 {
-  if (!m_frame_dump_frame_running)
-    return;
-
-  m_frame_dump_done.Wait();
-  m_frame_dump_frame_running = false;
+  while (m_frame_dump_queue.Size() != 0)
+    m_frame_dump_done.Wait();
 }
 
 void Renderer::RunFrameDumps()
@@ -895,54 +1015,60 @@ void Renderer::RunFrameDumps()
     if (!m_frame_dump_thread_running.IsSet())
       break;
 
-    auto config = m_frame_dump_config;
-
-    // Save screenshot
-    if (m_screenshot_request.TestAndClear())
+    // The frame stays in the queue until it is encoded, so that its readback texture isn't reused.
+    while (m_frame_dump_queue.Size() != 0)
     {
-      std::lock_guard<std::mutex> lk(m_screenshot_lock);
+      const FrameDumpConfig& config = m_frame_dump_queue.Front();
 
-      if (TextureToPng(config.data, config.stride, m_screenshot_name, config.width, config.height,
-                       false))
-        OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
-
-      // Reset settings
-      m_screenshot_name.clear();
-      m_screenshot_completed.Set();
-    }
-
-    if (SConfig::GetInstance().m_DumpFrames)
-    {
-      if (!frame_dump_started)
+      // Save screenshot
+      if (m_screenshot_request.TestAndClear())
       {
-        if (dump_to_avi)
-          frame_dump_started = StartFrameDumpToAVI(config);
-        else
-          frame_dump_started = StartFrameDumpToImage(config);
+        std::lock_guard<std::mutex> lk(m_screenshot_lock);
 
-        // Stop frame dumping if we fail to start.
-        if (!frame_dump_started)
-          SConfig::GetInstance().m_DumpFrames = false;
+        if (TextureToPng(config.data, config.stride, m_screenshot_name, config.width, config.height,
+                         false, g_ActiveConfig.iPNGCompressionLevel))
+          OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
+
+        // Reset settings
+        m_screenshot_name.clear();
+        m_screenshot_completed.Set();
       }
 
-      // If we failed to start frame dumping, don't write a frame.
-      if (frame_dump_started)
+      if (SConfig::GetInstance().m_DumpFrames)
       {
-        if (dump_to_avi)
-          DumpFrameToAVI(config);
-        else
-          DumpFrameToImage(config);
+        if (!frame_dump_started)
+        {
+          if (dump_to_avi)
+            frame_dump_started = StartFrameDumpToAVI(config);
+          else
+            frame_dump_started = StartFrameDumpToImage(config);
+
+          // Stop frame dumping if we fail to start.
+          if (!frame_dump_started)
+            SConfig::GetInstance().m_DumpFrames = false;
+        }
+
+        // If we failed to start frame dumping, don't write a frame.
+        if (frame_dump_started)
+        {
+          if (dump_to_avi)
+            DumpFrameToAVI(config);
+          else
+            DumpFrameToImage(config);
+        }
       }
-    }
 
-    m_frame_dump_done.Set();
+      m_frame_dump_queue.Pop();
+      m_frame_dump_done.Set();
+    }
   }
 
   if (frame_dump_started)
   {
-    // No additional cleanup is needed when dumping to images.
     if (dump_to_avi)
       StopFrameDumpToAVI();
+    else
+      StopFrameDumpToImage();
   }
 }
 
@@ -1002,16 +1128,50 @@ bool Renderer::StartFrameDumpToImage(const FrameDumpConfig& config)
     }
   }
 
+  m_frame_dump_image_threads.clear();
+  const u32 num_threads = std::max(std::thread::hardware_concurrency() / 2, 1u);
+  for (u32 i = 0; i < num_threads; i++)
+  {
+    m_frame_dump_image_threads.push_back(
+        std::make_unique<Common::WorkQueueThread<std::function<void()>>>(
+            [](std::function<void()> job) { job(); }));
+  }
+
   return true;
 }
 
 void Renderer::DumpFrameToImage(const FrameDumpConfig& config)
 {
-  std::string filename = GetFrameDumpNextImageFileName();
-  TextureToPng(config.data, config.stride, filename, config.width, config.height, false);
+  // Don't drop frames if the threads fall behind, wait for them instead.
+  while (m_frame_dump_images_pending.load() >= MAX_PENDING_FRAME_DUMP_IMAGES)
+    m_frame_dump_image_done.Wait();
+
+  // The readback texture is reused once the frame has been dumped, so compress a copy of it.
+  auto data = std::make_shared<std::vector<u8>>(
+      config.data, config.data + static_cast<size_t>(config.stride) * config.height);
+  const std::string filename = GetFrameDumpNextImageFileName();
+  const int width = config.width;
+  const int height = config.height;
+  const int stride = config.stride;
+  const int compression_level = g_ActiveConfig.iPNGCompressionLevel;
+  m_frame_dump_images_pending++;
+  m_frame_dump_image_threads[m_frame_dump_image_counter % m_frame_dump_image_threads.size()]
+      ->EmplaceItem([this, data, filename, width, height, stride, compression_level] {
+        TextureToPng(data->data(), stride, filename, width, height, false, compression_level);
+        m_frame_dump_images_pending--;
+        m_frame_dump_image_done.Set();
+      });
   m_frame_dump_image_counter++;
 }
 
+void Renderer::StopFrameDumpToImage()
+{
+  while (m_frame_dump_images_pending.load() != 0)
+    m_frame_dump_image_done.Wait();
+
+  m_frame_dump_image_threads.clear();
+}
+
 bool Renderer::UseVertexDepthRange() const
 {
   // We can't compute the depth range in the vertex shader if we don't support depth clamp.
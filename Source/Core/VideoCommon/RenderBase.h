@@ -15,7 +15,9 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <condition_variable>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -27,6 +29,8 @@
 #include "Common/Event.h"
 #include "Common/Flag.h"
 #include "Common/MathUtil.h"
+#include "Common/SPSCQueue.h"
+#include "Common/WorkQueueThread.h"
 #include "VideoCommon/AVIDump.h"
 #include "VideoCommon/AsyncShaderCompiler.h"
 #include "VideoCommon/BPMemory.h"
@@ -135,6 +139,8 @@ public:
   const TargetRectangle& GetTargetRectangle() const { return m_target_rectangle; }
   float CalculateDrawAspectRatio() const;
   bool IsHeadless() const;
+  // Presenting is skipped when headless, and while verifying movie playback
+  bool ShouldSkipPresent() const;
 
   std::tuple<float, float> ScaleToDisplayAspectRatio(int width, int height) const;
   void UpdateDrawRectangle();
@@ -178,6 +184,11 @@ public:
 
   PEControl::PixelFormat GetPrevPixelFormat() const { return m_prev_efb_format; }
   void StorePixelFormat(PEControl::PixelFormat new_format) { m_prev_efb_format = new_format; }
+
+  // Changes whenever the contents of the EFB may have changed, so two copies made with the same
+  // parameters and generation are identical.
+  u64 GetEFBGeneration() const { return m_efb_generation; }
+  void IncrementEFBGeneration() { m_efb_generation++; }
   PostProcessingShaderImplementation* GetPostProcessor() const { return m_post_processor.get(); }
   // Final surface changing
   // This is called when the surface is resized (WX) or the window changes (Android).
@@ -205,6 +216,10 @@ protected:
   std::tuple<int, int> CalculateTargetScale(int x, int y) const;
   bool CalculateTargetSize();
 
+  // Adjusts the dynamic EFB scale to the emulation speed. The new scale takes effect the next time
+  // the backend calls CalculateTargetSize.
+  void UpdateDynamicResolution(u64 ticks);
+
   bool CheckForHostConfigChanges();
 
   void CheckFifoRecording();
@@ -250,8 +265,16 @@ private:
   std::tuple<int, int> CalculateOutputDimensions(int width, int height);
 
   PEControl::PixelFormat m_prev_efb_format = PEControl::INVALID_FMT;
+  u64 m_efb_generation = 0;
   unsigned int m_efb_scale = 1;
 
+  // Upper limit for the EFB scale when dynamic resolution is enabled. Zero when it is unlimited.
+  unsigned int m_dynamic_efb_scale = 0;
+  u64 m_dynamic_resolution_time = 0;
+  u64 m_dynamic_resolution_ticks = 0;
+  u32 m_dynamic_resolution_full_speed_intervals = 0;
+  u32 m_dynamic_resolution_raise_intervals = 0;
+
   // These will be set on the first call to SetWindowSize.
   int m_last_window_request_width = 0;
   int m_last_window_request_height = 0;
@@ -262,7 +285,15 @@ private:
   Common::Event m_frame_dump_done;
   Common::Flag m_frame_dump_thread_running;
   u32 m_frame_dump_image_counter = 0;
-  bool m_frame_dump_frame_running = false;
+
+  // Dumped images are compressed in parallel, as compressing a PNG is much slower than rendering
+  // a frame. Further images wait for one of the first MAX_PENDING_FRAME_DUMP_IMAGES to be written.
+  static constexpr u32 MAX_PENDING_FRAME_DUMP_IMAGES = 16;
+  std::vector<std::unique_ptr<Common::WorkQueueThread<std::function<void()>>>>
+      m_frame_dump_image_threads;
+  std::atomic<u32> m_frame_dump_images_pending{0};
+  Common::Event m_frame_dump_image_done;
+
   struct FrameDumpConfig
   {
     const u8* data;
@@ -270,13 +301,23 @@ private:
     int height;
     int stride;
     AVIDump::Frame state;
-  } m_frame_dump_config;
+  };
+
+  // Frames handed to the frame dumping thread which haven't been encoded yet. The GPU thread only
+  // waits for the encoder once this many frames are queued, so a slow frame doesn't stall it.
+  static constexpr u32 MAX_QUEUED_FRAME_DUMPS = 4;
+  Common::SPSCQueue<FrameDumpConfig> m_frame_dump_queue;
 
   // Texture used for screenshot/frame dumping
   std::unique_ptr<AbstractTexture> m_frame_dump_render_texture;
-  std::array<std::unique_ptr<AbstractStagingTexture>, 2> m_frame_dump_readback_textures;
+  // Each queued frame still reads from its readback texture, plus one for the frame in flight.
+  std::array<std::unique_ptr<AbstractStagingTexture>, MAX_QUEUED_FRAME_DUMPS + 1>
+      m_frame_dump_readback_textures;
+  size_t m_frame_dump_readback_index = 0;
   AVIDump::Frame m_last_frame_state;
   bool m_last_frame_exported = false;
+  // Whether the last frame read back also goes to the frame dump, not just to shared memory
+  bool m_last_frame_dumped = false;
 
   // Tracking of XFB textures so we don't render duplicate frames.
   AbstractTexture* m_last_xfb_texture = nullptr;
@@ -298,9 +339,12 @@ private:
   std::string GetFrameDumpNextImageFileName() const;
   bool StartFrameDumpToImage(const FrameDumpConfig& config);
   void DumpFrameToImage(const FrameDumpConfig& config);
+  void StopFrameDumpToImage();
   void ShutdownFrameDumping();
 
   bool IsFrameDumping();
+  // Whether frames are read back for other processes (see SharedMemoryExport)
+  bool IsFrameExporting();
 
   // Asynchronously encodes the current staging texture to the frame dump.
   void DumpCurrentFrame();
@@ -311,13 +355,14 @@ private:
   // Queues the current frame for readback, which will be written to AVI next frame.
   void QueueFrameDumpReadback();
 
-  // Asynchronously encodes the specified pointer of frame data to the frame dump.
+  // Asynchronously encodes the specified pointer of frame data to the frame dump. Only blocks if
+  // MAX_QUEUED_FRAME_DUMPS frames are already waiting to be encoded.
   void DumpFrameData(const u8* data, int w, int h, int stride, const AVIDump::Frame& state);
 
   // Ensures all rendered frames are queued for encoding.
   void FlushFrameDump();
 
-  // Ensures all encoded frames have been written to the output file.
+  // Ensures all queued frames have been written to the output file.
   void FinishFrameData();
 };
 
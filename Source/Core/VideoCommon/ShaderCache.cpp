@@ -4,8 +4,12 @@
 
 #include "VideoCommon/ShaderCache.h"
 
+#include <algorithm>
+
 #include "Common/Assert.h"
+#include "Common/CommonPaths.h"
 #include "Common/FileUtil.h"
+#include "Common/MathUtil.h"
 #include "Common/MsgHandler.h"
 #include "Core/ConfigManager.h"
 #include "Core/Host.h"
@@ -17,6 +21,9 @@
 
 std::unique_ptr<VideoCommon::ShaderCache> g_shader_cache;
 
+constexpr u32 PIPELINE_UID_CACHE_MAGIC = 0x44495550;  // PUID
+constexpr size_t PIPELINE_UID_CACHE_HEADER_SIZE = sizeof(u32) + sizeof(u32);
+
 namespace VideoCommon
 {
 ShaderCache::ShaderCache() = default;
@@ -38,6 +45,7 @@ bool ShaderCache::Initialize()
     LoadShaderCaches();
     LoadPipelineUIDCache();
   }
+  LoadSharedPipelineUIDList();
 
   // Queue ubershader precompiling if required.
   if (g_ActiveConfig.UsingUberShaders())
@@ -88,6 +96,12 @@ void ShaderCache::Reload()
 void ShaderCache::RetrieveAsyncShaders()
 {
   m_async_shader_compiler->RetrieveWorkItems();
+
+  if (m_pending_priorities_changed)
+  {
+    m_async_shader_compiler->UpdatePendingWorkPriorities();
+    m_pending_priorities_changed = false;
+  }
 }
 
 void ShaderCache::Shutdown()
@@ -121,11 +135,25 @@ std::optional<const AbstractPipeline*> ShaderCache::GetPipelineForUidAsync(const
   auto it = m_gx_pipeline_cache.find(uid);
   if (it != m_gx_pipeline_cache.end())
   {
-    // .second is the pending flag, i.e. compiling in the background.
-    if (!it->second.second)
+    // .second is the pending flag, i.e. compiling in the background. With some drivers, the
+    // pipeline also isn't ready until the driver's own background compile has finished.
+    const auto IsReady = [&it] {
+      return !it->second.second && (!it->second.first || it->second.first->IsReady());
+    };
+    if (IsReady())
       return it->second.first.get();
-    else
-      return {};
+
+    // Pick up work which has completed since the last draw, so that the specialized pipeline
+    // replaces the ubershader mid-frame, rather than at the start of the next frame.
+    if (m_async_shader_compiler->HasCompletedWork())
+    {
+      m_async_shader_compiler->RetrieveWorkItems();
+      if (IsReady())
+        return it->second.first.get();
+    }
+
+    CountPendingPipelineDraw(uid);
+    return {};
   }
 
   AppendGXPipelineUID(uid);
@@ -146,6 +174,39 @@ const AbstractPipeline* ShaderCache::GetUberPipelineForUid(const GXUberPipelineU
   return InsertGXUberPipeline(uid, std::move(pipeline));
 }
 
+void ShaderCache::CountPendingPipelineDraw(const GXPipelineUid& uid)
+{
+  // The priority only changes when the draw count reaches a power of two.
+  const u32 draws = ++m_pending_pipeline_draws[uid];
+  if ((draws & (draws - 1)) != 0)
+    return;
+
+  // Move the stages of the pipeline ahead too, as the pipeline can't be compiled without them.
+  const u32 priority = GetPipelineCompilePriority(uid, COMPILE_PRIORITY_ONDEMAND_PIPELINE);
+  auto vs_it = m_vs_cache.shader_map.find(uid.vs_uid);
+  if (vs_it != m_vs_cache.shader_map.end() && vs_it->second.pending)
+    vs_it->second.priority = std::min(vs_it->second.priority, priority);
+
+  PixelShaderUid ps_uid = uid.ps_uid;
+  ClearUnusedPixelShaderUidBits(m_api_type, m_host_config, &ps_uid);
+  auto ps_it = m_ps_cache.shader_map.find(ps_uid);
+  if (ps_it != m_ps_cache.shader_map.end() && ps_it->second.pending)
+    ps_it->second.priority = std::min(ps_it->second.priority, priority);
+
+  m_pending_priorities_changed = true;
+}
+
+u32 ShaderCache::GetPipelineCompilePriority(const GXPipelineUid& uid, u32 priority) const
+{
+  auto it = m_pending_pipeline_draws.find(uid);
+  if (it == m_pending_pipeline_draws.end())
+    return priority;
+
+  const u32 hot_priority =
+      COMPILE_PRIORITY_ONDEMAND_PIPELINE - 1 - static_cast<u32>(IntLog2(it->second));
+  return std::min(priority, hot_priority);
+}
+
 void ShaderCache::WaitForAsyncCompiler()
 {
   while (m_async_shader_compiler->HasPendingWork() || m_async_shader_compiler->HasCompletedWork())
@@ -271,12 +332,14 @@ void ShaderCache::InvalidateCachedPipelines()
     it.second.first.reset();
     it.second.second = false;
   }
+  m_pending_pipeline_draws.clear();
 }
 
 void ShaderCache::ClearPipelineCaches()
 {
   m_gx_pipeline_cache.clear();
   m_gx_uber_pipeline_cache.clear();
+  m_pending_pipeline_draws.clear();
 }
 
 std::unique_ptr<AbstractShader> ShaderCache::CompileVertexShader(const VertexShaderUid& uid) const
@@ -325,6 +388,7 @@ const AbstractShader* ShaderCache::InsertVertexShader(const VertexShaderUid& uid
     }
     INCSTAT(stats.numVertexShadersCreated);
     INCSTAT(stats.numVertexShadersAlive);
+    INCSTAT(stats.thisFrame.numShadersCompiled);
     entry.shader = std::move(shader);
   }
 
@@ -347,6 +411,7 @@ const AbstractShader* ShaderCache::InsertVertexUberShader(const UberShader::Vert
     }
     INCSTAT(stats.numVertexShadersCreated);
     INCSTAT(stats.numVertexShadersAlive);
+    INCSTAT(stats.thisFrame.numShadersCompiled);
     entry.shader = std::move(shader);
   }
 
@@ -369,6 +434,7 @@ const AbstractShader* ShaderCache::InsertPixelShader(const PixelShaderUid& uid,
     }
     INCSTAT(stats.numPixelShadersCreated);
     INCSTAT(stats.numPixelShadersAlive);
+    INCSTAT(stats.thisFrame.numShadersCompiled);
     entry.shader = std::move(shader);
   }
 
@@ -391,6 +457,7 @@ const AbstractShader* ShaderCache::InsertPixelUberShader(const UberShader::Pixel
     }
     INCSTAT(stats.numPixelShadersCreated);
     INCSTAT(stats.numPixelShadersAlive);
+    INCSTAT(stats.thisFrame.numShadersCompiled);
     entry.shader = std::move(shader);
   }
 
@@ -414,6 +481,7 @@ const AbstractShader* ShaderCache::CreateGeometryShader(const GeometryShaderUid&
       if (!binary.empty())
         m_gs_cache.disk_cache.Append(uid, binary.data(), static_cast<u32>(binary.size()));
     }
+    INCSTAT(stats.thisFrame.numShadersCompiled);
     entry.shader = std::move(shader);
   }
 
@@ -532,6 +600,7 @@ const AbstractPipeline* ShaderCache::InsertGXPipeline(const GXPipelineUid& confi
   if (!entry.first && pipeline)
     entry.first = std::move(pipeline);
 
+  m_pending_pipeline_draws.erase(config);
   return entry.first.get();
 }
 
@@ -547,55 +616,51 @@ ShaderCache::InsertGXUberPipeline(const GXUberPipelineUid& config,
   return entry.first.get();
 }
 
+bool ShaderCache::ReadPipelineUIDFile(File::IOFile& file)
+{
+  // Validate the version before reading entries.
+  u32 existing_magic;
+  u32 existing_version;
+  if (!file.ReadBytes(&existing_magic, sizeof(existing_magic)) ||
+      !file.ReadBytes(&existing_version, sizeof(existing_version)) ||
+      existing_magic != PIPELINE_UID_CACHE_MAGIC || existing_version != GX_PIPELINE_UID_VERSION)
+  {
+    return false;
+  }
+
+  // Ensure the expected size matches the actual size of the file. If it doesn't, it means
+  // the cache file may be corrupted, and we should not proceed with loading potentially
+  // garbage or invalid UIDs.
+  const u64 file_size = file.GetSize();
+  const size_t uid_count = static_cast<size_t>(file_size - PIPELINE_UID_CACHE_HEADER_SIZE) /
+                           sizeof(SerializedGXPipelineUid);
+  const size_t expected_size =
+      uid_count * sizeof(SerializedGXPipelineUid) + PIPELINE_UID_CACHE_HEADER_SIZE;
+  if (file_size != expected_size)
+    return false;
+
+  for (size_t i = 0; i < uid_count; i++)
+  {
+    SerializedGXPipelineUid serialized_uid;
+    if (!file.ReadBytes(&serialized_uid, sizeof(serialized_uid)))
+      return false;
+
+    // This just adds the pipeline to the map, it is compiled later.
+    AddSerializedGXPipelineUID(serialized_uid);
+  }
+
+  // The file may be opened for reading and writing, so we must seek to the end before writing.
+  return file.Seek(expected_size, SEEK_SET);
+}
+
 void ShaderCache::LoadPipelineUIDCache()
 {
-  constexpr u32 CACHE_FILE_MAGIC = 0x44495550;  // PUID
-  constexpr size_t CACHE_HEADER_SIZE = sizeof(u32) + sizeof(u32);
   std::string filename =
       File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID() + ".uidcache";
   if (m_gx_pipeline_uid_cache_file.Open(filename, "rb+"))
   {
-    // If an existing case exists, validate the version before reading entries.
-    u32 existing_magic;
-    u32 existing_version;
-    bool uid_file_valid = false;
-    if (m_gx_pipeline_uid_cache_file.ReadBytes(&existing_magic, sizeof(existing_magic)) &&
-        m_gx_pipeline_uid_cache_file.ReadBytes(&existing_version, sizeof(existing_version)) &&
-        existing_magic == CACHE_FILE_MAGIC && existing_version == GX_PIPELINE_UID_VERSION)
-    {
-      // Ensure the expected size matches the actual size of the file. If it doesn't, it means
-      // the cache file may be corrupted, and we should not proceed with loading potentially
-      // garbage or invalid UIDs.
-      const u64 file_size = m_gx_pipeline_uid_cache_file.GetSize();
-      const size_t uid_count =
-          static_cast<size_t>(file_size - CACHE_HEADER_SIZE) / sizeof(SerializedGXPipelineUid);
-      const size_t expected_size = uid_count * sizeof(SerializedGXPipelineUid) + CACHE_HEADER_SIZE;
-      uid_file_valid = file_size == expected_size;
-      if (uid_file_valid)
-      {
-        for (size_t i = 0; i < uid_count; i++)
-        {
-          SerializedGXPipelineUid serialized_uid;
-          if (m_gx_pipeline_uid_cache_file.ReadBytes(&serialized_uid, sizeof(serialized_uid)))
-          {
-            // This just adds the pipeline to the map, it is compiled later.
-            AddSerializedGXPipelineUID(serialized_uid);
-          }
-          else
-          {
-            uid_file_valid = false;
-            break;
-          }
-        }
-      }
-
-      // We open the file for reading and writing, so we must seek to the end before writing.
-      if (uid_file_valid)
-        uid_file_valid = m_gx_pipeline_uid_cache_file.Seek(expected_size, SEEK_SET);
-    }
-
     // If the file is invalid, close it. We re-open and truncate it below.
-    if (!uid_file_valid)
+    if (!ReadPipelineUIDFile(m_gx_pipeline_uid_cache_file))
       m_gx_pipeline_uid_cache_file.Close();
   }
 
@@ -605,7 +670,8 @@ void ShaderCache::LoadPipelineUIDCache()
     if (m_gx_pipeline_uid_cache_file.Open(filename, "wb"))
     {
       // Write the version identifier.
-      m_gx_pipeline_uid_cache_file.WriteBytes(&CACHE_FILE_MAGIC, sizeof(GX_PIPELINE_UID_VERSION));
+      m_gx_pipeline_uid_cache_file.WriteBytes(&PIPELINE_UID_CACHE_MAGIC,
+                                              sizeof(PIPELINE_UID_CACHE_MAGIC));
       m_gx_pipeline_uid_cache_file.WriteBytes(&GX_PIPELINE_UID_VERSION,
                                               sizeof(GX_PIPELINE_UID_VERSION));
 
@@ -621,6 +687,35 @@ void ShaderCache::LoadPipelineUIDCache()
            static_cast<unsigned>(m_gx_pipeline_cache.size()), filename.c_str());
 }
 
+void ShaderCache::LoadSharedPipelineUIDList()
+{
+  // Pipeline UID lists don't contain any host-specific data, so a game's .uidcache file can be
+  // shared with other users. Placing it in Load/PipelineUIDs/ makes all of its pipelines get
+  // precompiled at boot, even before they have been encountered on this host.
+  const std::string& game_id = SConfig::GetInstance().GetGameID();
+  const std::string directory = File::GetUserPath(D_LOAD_IDX) + PIPELINE_UID_LISTS_DIR DIR_SEP;
+  for (const std::string& filename :
+       {directory + game_id + ".uidcache", directory + game_id.substr(0, 3) + ".uidcache"})
+  {
+    File::IOFile file(filename, "rb");
+    if (!file)
+      continue;
+
+    const size_t previous_count = m_gx_pipeline_cache.size();
+    if (ReadPipelineUIDFile(file))
+    {
+      INFO_LOG(VIDEO, "Read %u new pipeline UIDs from %s",
+               static_cast<unsigned>(m_gx_pipeline_cache.size() - previous_count),
+               filename.c_str());
+    }
+    else
+    {
+      WARN_LOG(VIDEO, "Pipeline UID list %s is invalid or from another version", filename.c_str());
+    }
+    return;
+  }
+}
+
 void ShaderCache::ClosePipelineUIDCache()
 {
   // This is left as a method in case we need to append extra data to the file in the future.
@@ -687,13 +782,23 @@ void ShaderCache::QueueVertexShaderCompile(const VertexShaderUid& uid, u32 prior
 
     void Retrieve() override { shader_cache->InsertVertexShader(uid, std::move(shader)); }
 
+    u32 GetPriority(u32 queued_priority) const override
+    {
+      auto it = shader_cache->m_vs_cache.shader_map.find(uid);
+      if (it == shader_cache->m_vs_cache.shader_map.end())
+        return queued_priority;
+      return it->second.priority;
+    }
+
   private:
     ShaderCache* shader_cache;
     std::unique_ptr<AbstractShader> shader;
     VertexShaderUid uid;
   };
 
-  m_vs_cache.shader_map[uid].pending = true;
+  auto& entry = m_vs_cache.shader_map[uid];
+  entry.pending = true;
+  entry.priority = priority;
   auto wi = m_async_shader_compiler->CreateWorkItem<VertexShaderWorkItem>(this, uid);
   m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
 }
@@ -745,13 +850,23 @@ void ShaderCache::QueuePixelShaderCompile(const PixelShaderUid& uid, u32 priorit
 
     void Retrieve() override { shader_cache->InsertPixelShader(uid, std::move(shader)); }
 
+    u32 GetPriority(u32 queued_priority) const override
+    {
+      auto it = shader_cache->m_ps_cache.shader_map.find(uid);
+      if (it == shader_cache->m_ps_cache.shader_map.end())
+        return queued_priority;
+      return it->second.priority;
+    }
+
   private:
     ShaderCache* shader_cache;
     std::unique_ptr<AbstractShader> shader;
     PixelShaderUid uid;
   };
 
-  m_ps_cache.shader_map[uid].pending = true;
+  auto& entry = m_ps_cache.shader_map[uid];
+  entry.pending = true;
+  entry.priority = priority;
   auto wi = m_async_shader_compiler->CreateWorkItem<PixelShaderWorkItem>(this, uid);
   m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
 }
@@ -837,10 +952,16 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
         // Re-queue for next frame.
         auto wi = shader_cache->m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(
             shader_cache, uid, priority);
-        shader_cache->m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
+        shader_cache->m_async_shader_compiler->QueueWorkItem(
+            std::move(wi), shader_cache->GetPipelineCompilePriority(uid, priority));
       }
     }
 
+    u32 GetPriority(u32 queued_priority) const override
+    {
+      return shader_cache->GetPipelineCompilePriority(uid, queued_priority);
+    }
+
   private:
     ShaderCache* shader_cache;
     std::unique_ptr<AbstractPipeline> pipeline;
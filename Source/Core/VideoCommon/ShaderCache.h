@@ -68,6 +68,8 @@ private:
   void LoadShaderCaches();
   void ClearShaderCaches();
   void LoadPipelineUIDCache();
+  void LoadSharedPipelineUIDList();
+  bool ReadPipelineUIDFile(File::IOFile& file);
   void ClosePipelineUIDCache();
   void CompileMissingPipelines();
   void InvalidateCachedPipelines();
@@ -106,6 +108,8 @@ private:
                                                std::unique_ptr<AbstractPipeline> pipeline);
   void AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid);
   void AppendGXPipelineUID(const GXPipelineUid& config);
+  void CountPendingPipelineDraw(const GXPipelineUid& uid);
+  u32 GetPipelineCompilePriority(const GXPipelineUid& uid, u32 priority) const;
 
   // ASync Compiler Methods
   void QueueVertexShaderCompile(const VertexShaderUid& uid, u32 priority);
@@ -118,7 +122,8 @@ private:
   // Priorities for compiling. The lower the value, the sooner the pipeline is compiled.
   // The shader cache is compiled last, as it is the least likely to be required. On demand
   // shaders are always compiled before pending ubershaders, as we want to use the ubershader
-  // for as few frames as possible, otherwise we risk framerate drops.
+  // for as few frames as possible, otherwise we risk framerate drops. Pipelines which are drawn
+  // while they are compiling are moved ahead of these, the more draws the sooner.
   enum : u32
   {
     COMPILE_PRIORITY_ONDEMAND_PIPELINE = 100,
@@ -140,6 +145,7 @@ private:
     {
       std::unique_ptr<AbstractShader> shader;
       bool pending;
+      u32 priority;
     };
     std::map<Uid, Shader> shader_map;
     LinearDiskCache<Uid, u8> disk_cache;
@@ -154,6 +160,10 @@ private:
   std::map<GXPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>> m_gx_pipeline_cache;
   std::map<GXUberPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>>
       m_gx_uber_pipeline_cache;
+  // Number of draws made with each pending pipeline, which are used to compile the pipelines
+  // which are drawn most first. Changes are applied to the compile queue once per frame.
+  std::map<GXPipelineUid, u32> m_pending_pipeline_draws;
+  bool m_pending_priorities_changed = false;
   File::IOFile m_gx_pipeline_uid_cache_file;
 };
 
@@ -34,6 +34,8 @@ ShaderHostConfig ShaderHostConfig::GetCurrent()
       g_ActiveConfig.backend_info.bSupportsDynamicSamplerIndexing;
   bits.backend_shader_framebuffer_fetch = g_ActiveConfig.backend_info.bSupportsFramebufferFetch;
   bits.backend_logic_op = g_ActiveConfig.backend_info.bSupportsLogicOp;
+  bits.backend_vs_layer_output = g_ActiveConfig.backend_info.bSupportsVSLayerOutput;
+  bits.backend_vs_point_size = g_ActiveConfig.backend_info.MaxPointSize > 0;
   return bits;
 }
 
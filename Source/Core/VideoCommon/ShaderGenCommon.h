@@ -117,9 +117,18 @@ public:
       __attribute__((format(printf, 2, 3)))
 #endif
   {
+    // Most writes are short, so format them on the stack and append them to the buffer directly,
+    // instead of allocating a temporary string for each one.
+    char formatted[1024];
     va_list arglist;
+    va_list arglist_copy;
     va_start(arglist, fmt);
-    m_buffer += StringFromFormatV(fmt, arglist);
+    va_copy(arglist_copy, arglist);
+    if (CharArrayFromFormatV(formatted, sizeof(formatted), fmt, arglist))
+      m_buffer += formatted;
+    else
+      m_buffer += StringFromFormatV(fmt, arglist_copy);
+    va_end(arglist_copy);
     va_end(arglist);
   }
 
@@ -181,7 +190,9 @@ union ShaderHostConfig
     u32 backend_dynamic_sampler_indexing : 1;
     u32 backend_shader_framebuffer_fetch : 1;
     u32 backend_logic_op : 1;
-    u32 pad : 10;
+    u32 backend_vs_layer_output : 1;
+    u32 backend_vs_point_size : 1;
+    u32 pad : 8;
   };
 
   static ShaderHostConfig GetCurrent();
@@ -321,6 +332,12 @@ inline const char* GetInterpolationQualifier(bool msaa, bool ssaa,
 #define I_STEREOPARAMS "cstereo"
 #define I_LINEPTPARAMS "clinept"
 #define I_TEXOFFSET "ctexoffset"
+#define I_EFBSCALE "cefbscale"
+
+static const char s_geometry_shader_uniforms[] = "\tfloat4 " I_STEREOPARAMS ";\n"
+                                                 "\tfloat4 " I_LINEPTPARAMS ";\n"
+                                                 "\tint4 " I_TEXOFFSET ";\n"
+                                                 "\tfloat4 " I_EFBSCALE ";\n";
 
 static const char s_shader_uniforms[] = "\tuint    components;\n"
                                         "\tuint    xfmem_dualTexInfo;\n"
@@ -2,6 +2,8 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <cinttypes>
 #include <cstring>
 #include <string>
 #include <utility>
@@ -13,8 +15,75 @@
 
 Statistics stats;
 
+// The per-frame counters written by HistoryToJSON
+static const std::pair<const char*, int Statistics::ThisFrame::*> s_frame_counters[] = {
+    {"bp_loads", &Statistics::ThisFrame::numBPLoads},
+    {"cp_loads", &Statistics::ThisFrame::numCPLoads},
+    {"xf_loads", &Statistics::ThisFrame::numXFLoads},
+    {"bp_loads_in_dl", &Statistics::ThisFrame::numBPLoadsInDL},
+    {"cp_loads_in_dl", &Statistics::ThisFrame::numCPLoadsInDL},
+    {"xf_loads_in_dl", &Statistics::ThisFrame::numXFLoadsInDL},
+    {"primitives", &Statistics::ThisFrame::numPrims},
+    {"primitives_in_dl", &Statistics::ThisFrame::numDLPrims},
+    {"shader_changes", &Statistics::ThisFrame::numShaderChanges},
+    {"primitive_joins", &Statistics::ThisFrame::numPrimitiveJoins},
+    {"draws_culled", &Statistics::ThisFrame::numDrawsCulled},
+    {"draw_calls", &Statistics::ThisFrame::numDrawCalls},
+    {"flushes", &Statistics::ThisFrame::numFlushes},
+    {"pipeline_changes", &Statistics::ThisFrame::numPipelineChanges},
+    {"display_lists", &Statistics::ThisFrame::numDListsCalled},
+    {"vertex_bytes", &Statistics::ThisFrame::bytesVertexStreamed},
+    {"index_bytes", &Statistics::ThisFrame::bytesIndexStreamed},
+    {"uniform_bytes", &Statistics::ThisFrame::bytesUniformStreamed},
+    {"texture_uploads", &Statistics::ThisFrame::numTextureUploads},
+    {"texture_upload_bytes", &Statistics::ThisFrame::bytesTextureUploaded},
+    {"shader_compiles", &Statistics::ThisFrame::numShadersCompiled},
+    {"efb_copies", &Statistics::ThisFrame::numEFBCopies},
+    {"efb_copies_to_ram", &Statistics::ThisFrame::numEFBCopiesToRAM},
+    {"efb_peeks", &Statistics::ThisFrame::numEFBPeeks},
+};
+
+Statistics::Totals Statistics::Totals::Since(const Totals& earlier) const
+{
+  Totals counts;
+  counts.numPrims = numPrims - earlier.numPrims;
+  counts.numDrawCalls = numDrawCalls - earlier.numDrawCalls;
+  counts.numStateLoads = numStateLoads - earlier.numStateLoads;
+  counts.numShaderChanges = numShaderChanges - earlier.numShaderChanges;
+  counts.numFlushes = numFlushes - earlier.numFlushes;
+  counts.numPipelineChanges = numPipelineChanges - earlier.numPipelineChanges;
+  counts.numTextureUploads = numTextureUploads - earlier.numTextureUploads;
+  counts.bytesTextureUploaded = bytesTextureUploaded - earlier.bytesTextureUploaded;
+  counts.numShadersCompiled = numShadersCompiled - earlier.numShadersCompiled;
+  counts.numEFBCopies = numEFBCopies - earlier.numEFBCopies;
+  counts.numEFBReadbacks = numEFBReadbacks - earlier.numEFBReadbacks;
+  return counts;
+}
+
+Statistics::Totals Statistics::GetTotals() const
+{
+  Totals totals = totalsBeforeThisFrame;
+  totals.numPrims += thisFrame.numPrims + thisFrame.numDLPrims;
+  totals.numDrawCalls += thisFrame.numDrawCalls;
+  totals.numStateLoads += thisFrame.numBPLoads + thisFrame.numCPLoads + thisFrame.numXFLoads +
+                          thisFrame.numBPLoadsInDL + thisFrame.numCPLoadsInDL +
+                          thisFrame.numXFLoadsInDL;
+  totals.numShaderChanges += thisFrame.numShaderChanges;
+  totals.numFlushes += thisFrame.numFlushes;
+  totals.numPipelineChanges += thisFrame.numPipelineChanges;
+  totals.numTextureUploads += thisFrame.numTextureUploads;
+  totals.bytesTextureUploaded += thisFrame.bytesTextureUploaded;
+  totals.numShadersCompiled += thisFrame.numShadersCompiled;
+  totals.numEFBCopies += thisFrame.numEFBCopies;
+  totals.numEFBReadbacks += thisFrame.numEFBCopiesToRAM + thisFrame.numEFBPeeks;
+  return totals;
+}
+
 void Statistics::ResetFrame()
 {
+  totalsBeforeThisFrame = GetTotals();
+  frameHistory[numFramesRecorded % HISTORY_SIZE] = thisFrame;
+  numFramesRecorded++;
   memset(&thisFrame, 0, sizeof(ThisFrame));
 }
 
@@ -54,7 +123,10 @@ std::string Statistics::ToString()
   str += StringFromFormat("shaders changes: %i\n", stats.thisFrame.numShaderChanges);
   str += StringFromFormat("dlists called: %i\n", stats.thisFrame.numDListsCalled);
   str += StringFromFormat("Primitive joins: %i\n", stats.thisFrame.numPrimitiveJoins);
+  str += StringFromFormat("Draws culled on CPU: %i\n", stats.thisFrame.numDrawsCulled);
   str += StringFromFormat("Draw calls: %i\n", stats.thisFrame.numDrawCalls);
+  str += StringFromFormat("Flushes: %i\n", stats.thisFrame.numFlushes);
+  str += StringFromFormat("Pipeline changes: %i\n", stats.thisFrame.numPipelineChanges);
   str += StringFromFormat("Primitives: %i\n", stats.thisFrame.numPrims);
   str += StringFromFormat("Primitives (DL): %i\n", stats.thisFrame.numDLPrims);
   str += StringFromFormat("XF loads: %i\n", stats.thisFrame.numXFLoads);
@@ -66,6 +138,12 @@ std::string Statistics::ToString()
   str += StringFromFormat("Vertex streamed: %i kB\n", stats.thisFrame.bytesVertexStreamed / 1024);
   str += StringFromFormat("Index streamed: %i kB\n", stats.thisFrame.bytesIndexStreamed / 1024);
   str += StringFromFormat("Uniform streamed: %i kB\n", stats.thisFrame.bytesUniformStreamed / 1024);
+  str += StringFromFormat("Texture uploads: %i (%i kB)\n", stats.thisFrame.numTextureUploads,
+                          stats.thisFrame.bytesTextureUploaded / 1024);
+  str += StringFromFormat("Shaders compiled: %i\n", stats.thisFrame.numShadersCompiled);
+  str += StringFromFormat("EFB copies: %i (%i to RAM)\n", stats.thisFrame.numEFBCopies,
+                          stats.thisFrame.numEFBCopiesToRAM);
+  str += StringFromFormat("EFB peeks: %i\n", stats.thisFrame.numEFBPeeks);
   str += StringFromFormat("Vertex Loaders: %i\n", stats.numVertexLoaders);
 
   std::string vertex_list = VertexLoaderManager::VertexLoadersToString();
@@ -83,6 +161,24 @@ std::string Statistics::ToString()
   return str;
 }
 
+std::string Statistics::HistoryToJSON()
+{
+  const u64 first_frame =
+      stats.numFramesRecorded - std::min<u64>(stats.numFramesRecorded, HISTORY_SIZE);
+
+  std::string json = "{\"frames\": [";
+  for (u64 frame = first_frame; frame < stats.numFramesRecorded; frame++)
+  {
+    const ThisFrame& counters = stats.frameHistory[frame % HISTORY_SIZE];
+    json += StringFromFormat("%s\n  {\"frame\": %" PRIu64, frame == first_frame ? "" : ",", frame);
+    for (const auto& counter : s_frame_counters)
+      json += StringFromFormat(", \"%s\": %i", counter.first, counters.*counter.second);
+    json += "}";
+  }
+  json += "\n]}\n";
+  return json;
+}
+
 // Is this really needed?
 std::string Statistics::ToStringProj()
 {
@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include <array>
 #include <string>
 
+#include "Common/CommonTypes.h"
+
 struct Statistics
 {
   int numPixelShadersCreated;
@@ -43,7 +46,10 @@ struct Statistics
     int numShaderChanges;
 
     int numPrimitiveJoins;
+    int numDrawsCulled;
     int numDrawCalls;
+    int numFlushes;
+    int numPipelineChanges;
 
     int numDListsCalled;
 
@@ -51,6 +57,13 @@ struct Statistics
     int bytesIndexStreamed;
     int bytesUniformStreamed;
 
+    int numTextureUploads;
+    int bytesTextureUploaded;
+    int numShadersCompiled;
+    int numEFBCopies;
+    int numEFBCopiesToRAM;
+    int numEFBPeeks;
+
     int numTrianglesClipped;
     int numTrianglesIn;
     int numTrianglesRejected;
@@ -63,11 +76,42 @@ struct Statistics
     int tevPixelsOut;
   };
   ThisFrame thisFrame;
+
+  // A few counters summed over all frames, which unlike thisFrame can be sampled at any point
+  struct Totals
+  {
+    u64 numPrims;
+    u64 numDrawCalls;
+    u64 numStateLoads;
+    u64 numShaderChanges;
+    u64 numFlushes;
+    u64 numPipelineChanges;
+    u64 numTextureUploads;
+    u64 bytesTextureUploaded;
+    u64 numShadersCompiled;
+    u64 numEFBCopies;
+    // EFB copies to RAM and EFB peeks, which both wait for the GPU
+    u64 numEFBReadbacks;
+
+    // The counts between an earlier sample and this one
+    Totals Since(const Totals& earlier) const;
+  };
+  Totals totalsBeforeThisFrame;
+  Totals GetTotals() const;
+
+  // The counters of the most recent frames, recorded by ResetFrame. Frame i of the history is in
+  // frameHistory[i % HISTORY_SIZE].
+  static constexpr u32 HISTORY_SIZE = 256;
+  std::array<ThisFrame, HISTORY_SIZE> frameHistory;
+  u64 numFramesRecorded;
+
   void ResetFrame();
   static void SwapDL();
 
   static std::string ToString();
   static std::string ToStringProj();
+  // The recorded frames of the history, oldest first, as {"frames": [{"frame": n, ...}, ...]}
+  static std::string HistoryToJSON();
 };
 
 extern Statistics stats;
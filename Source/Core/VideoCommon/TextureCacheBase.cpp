@@ -7,7 +7,9 @@
 #include <cstring>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 #if defined(_M_X86) || defined(_M_X86_64)
 #include <pmmintrin.h>
 #endif
@@ -20,17 +22,20 @@
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
 #include "Common/MemoryUtil.h"
+#include "Common/Profiler.h"
 #include "Common/StringUtil.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/FifoPlayer/FifoPlayer.h"
 #include "Core/FifoPlayer/FifoRecorder.h"
 #include "Core/HW/Memmap.h"
+#include "VideoCommon/AbstractStagingTexture.h"
 
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/Debugger.h"
 #include "VideoCommon/FramebufferManagerBase.h"
 #include "VideoCommon/HiresTextures.h"
+#include "VideoCommon/ImageWrite.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/SamplerCommon.h"
 #include "VideoCommon/Statistics.h"
@@ -69,6 +74,80 @@ void TextureCacheBase::CheckTempSize(size_t required_size)
   temp = static_cast<u8*>(Common::AllocateAlignedMemory(temp_size, 16));
 }
 
+const u8* TextureCacheBase::InterleaveRGBA8FromTmem(const u8* src_ar, const u8* src_gb, u32 size)
+{
+  // In main memory, each 4x4 block is 32 bytes of AR followed by 32 bytes of GB. Tmem keeps
+  // the two halves in separate banks.
+  constexpr u32 BLOCK_SIZE = 64;
+  constexpr u32 HALF_BLOCK_SIZE = BLOCK_SIZE / 2;
+
+  CheckTempSize(size);
+  for (u32 offset = 0; offset < size; offset += BLOCK_SIZE)
+  {
+    std::memcpy(temp + offset, src_ar + offset / 2, HALF_BLOCK_SIZE);
+    std::memcpy(temp + offset + HALF_BLOCK_SIZE, src_gb + offset / 2, HALF_BLOCK_SIZE);
+  }
+  return temp;
+}
+
+void TextureCacheBase::ResizeDecodingThreads(u32 num_threads)
+{
+  m_decoding_threads.clear();
+  for (u32 i = 0; i < num_threads; ++i)
+  {
+    m_decoding_threads.push_back(std::make_unique<Common::WorkQueueThread<std::function<void()>>>(
+        [](std::function<void()> job) { job(); }));
+  }
+}
+
+void TextureCacheBase::DecodeTexture(u8* dst, const u8* src, u32 width, u32 height,
+                                     TextureFormat format, const u8* tlut, TLUTFormat tlut_format)
+{
+  // Below this many texels per band, waking up the threads costs more than it saves.
+  constexpr u32 MIN_TEXELS_PER_JOB = 128 * 128;
+
+  // Bands must start on a block row. The format overlay is drawn over the whole texture, so it
+  // can only be done by TexDecoder_Decode.
+  const u32 block_height = TexDecoder_GetBlockHeightInTexels(format);
+  const u32 num_block_rows = height / block_height;
+  const u32 num_jobs =
+      std::min({static_cast<u32>(m_decoding_threads.size()) + 1,
+                width * height / MIN_TEXELS_PER_JOB, num_block_rows});
+  if (num_jobs <= 1 || height % block_height != 0 || backup_config.texfmt_overlay)
+  {
+    TexDecoder_Decode(dst, src, width, height, format, tlut, tlut_format);
+    return;
+  }
+
+  // Every block row has the same size, both encoded and decoded.
+  const u32 rows_per_job = (num_block_rows + num_jobs - 1) / num_jobs;
+  const size_t src_row_size = TexDecoder_GetTextureSizeInBytes(width, block_height, format);
+  const size_t dst_row_size = width * block_height * sizeof(u32);
+  const auto decode_band = [=](u32 first_row, u32 last_row) {
+    _TexDecoder_DecodeImpl(reinterpret_cast<u32*>(dst + first_row * dst_row_size),
+                           src + first_row * src_row_size, width,
+                           (last_row - first_row) * block_height, format, tlut, tlut_format);
+  };
+
+  const u32 num_queued_jobs = (num_block_rows + rows_per_job - 1) / rows_per_job - 1;
+
+  m_decoding_jobs_pending.store(num_queued_jobs);
+  for (u32 job = 1; job <= num_queued_jobs; ++job)
+  {
+    const u32 first = job * rows_per_job;
+    const u32 last = std::min(first + rows_per_job, num_block_rows);
+    m_decoding_threads[job - 1]->EmplaceItem([this, decode_band, first, last] {
+      decode_band(first, last);
+      if (m_decoding_jobs_pending.fetch_sub(1) == 1)
+        m_decoding_jobs_done.Set();
+    });
+  }
+
+  decode_band(0, rows_per_job);
+  if (num_queued_jobs != 0)
+    m_decoding_jobs_done.Wait();
+}
+
 TextureCacheBase::TextureCacheBase()
 {
   SetBackupConfig(g_ActiveConfig);
@@ -78,6 +157,7 @@ TextureCacheBase::TextureCacheBase()
 
   TexDecoder_SetTexFmtOverlayOptions(backup_config.texfmt_overlay,
                                      backup_config.texfmt_overlay_center);
+  ResizeDecodingThreads(backup_config.texture_decoding_threads);
 
   HiresTexture::Init();
 
@@ -100,12 +180,43 @@ void TextureCacheBase::Invalidate()
   }
   textures_by_address.clear();
   textures_by_hash.clear();
+  m_largest_texture_size = 0;
+  m_last_vram_copy_entry = nullptr;
 
   texture_pool.clear();
+
+  // Pending copies are dropped rather than written, as guest memory may have been replaced by a
+  // savestate since they were made.
+  m_pending_efb_copies.clear();
+  m_efb_copy_staging_texture_pool.clear();
+}
+
+void TextureCacheBase::InvalidateCopies()
+{
+  InvalidateAllBindPoints();
+  for (size_t i = 0; i < bound_textures.size(); ++i)
+  {
+    bound_textures[i] = nullptr;
+  }
+
+  for (auto iter = textures_by_address.begin(); iter != textures_by_address.end();)
+  {
+    if (iter->second->IsCopy())
+      iter = InvalidateTexture(iter);
+    else
+      ++iter;
+  }
+  m_last_vram_copy_entry = nullptr;
+
+  // As in Invalidate(), pending copies must not overwrite the memory of the loaded state.
+  m_pending_efb_copies.clear();
 }
 
 TextureCacheBase::~TextureCacheBase()
 {
+  // Finishes writing the queued texture dumps.
+  m_texture_dump_threads.clear();
+
   HiresTexture::Shutdown();
   Invalidate();
   Common::FreeAlignedMemory(temp);
@@ -115,7 +226,9 @@ TextureCacheBase::~TextureCacheBase()
 void TextureCacheBase::OnConfigChanged(VideoConfig& config)
 {
   if (config.bHiresTextures != backup_config.hires_textures ||
-      config.bCacheHiresTextures != backup_config.cache_hires_textures)
+      config.bCacheHiresTextures != backup_config.cache_hires_textures ||
+      config.bStreamHiresTextures != backup_config.stream_hires_textures ||
+      config.iHiresTextureStreamingBudget != backup_config.hires_texture_streaming_budget)
   {
     HiresTexture::Update();
   }
@@ -125,15 +238,20 @@ void TextureCacheBase::OnConfigChanged(VideoConfig& config)
       config.bTexFmtOverlayEnable != backup_config.texfmt_overlay ||
       config.bTexFmtOverlayCenter != backup_config.texfmt_overlay_center ||
       config.bHiresTextures != backup_config.hires_textures ||
+      config.bStreamHiresTextures != backup_config.stream_hires_textures ||
       config.bEnableGPUTextureDecoding != backup_config.gpu_texture_decoding ||
       config.bDisableCopyToVRAM != backup_config.disable_vram_copies)
   {
+    FlushEFBCopies();
     Invalidate();
 
     TexDecoder_SetTexFmtOverlayOptions(g_ActiveConfig.bTexFmtOverlayEnable,
                                        g_ActiveConfig.bTexFmtOverlayCenter);
   }
 
+  if (config.GetTextureDecodingThreads() != backup_config.texture_decoding_threads)
+    ResizeDecodingThreads(config.GetTextureDecodingThreads());
+
   if ((config.stereo_mode != StereoMode::Off) != backup_config.stereo_3d ||
       config.bStereoEFBMonoDepth != backup_config.efb_mono_depth)
   {
@@ -147,11 +265,20 @@ void TextureCacheBase::OnConfigChanged(VideoConfig& config)
 
 void TextureCacheBase::Cleanup(int _frameCount)
 {
+  // Don't let copies wait on the GPU for longer than a frame.
+  FlushEFBCopies();
+
+  // Once streamed custom textures have finished loading, drop the entries which were waiting for
+  // them so the next lookup picks them up. Entries still waiting are simply queued again.
+  const u32 custom_tex_generation = HiresTexture::GetStreamingGeneration();
+  const bool custom_tex_loaded = custom_tex_generation != last_custom_tex_generation;
+  last_custom_tex_generation = custom_tex_generation;
+
   TexAddrCache::iterator iter = textures_by_address.begin();
   TexAddrCache::iterator tcend = textures_by_address.end();
   while (iter != tcend)
   {
-    if (iter->second->tmem_only)
+    if (iter->second->tmem_only || (custom_tex_loaded && iter->second->waiting_for_custom_tex))
     {
       iter = InvalidateTexture(iter);
     }
@@ -189,6 +316,10 @@ void TextureCacheBase::Cleanup(int _frameCount)
     }
   }
 
+  m_largest_texture_size = 0;
+  for (const auto& entry : textures_by_address)
+    m_largest_texture_size = std::max(m_largest_texture_size, entry.second->size_in_bytes);
+
   TexPool::iterator iter2 = texture_pool.begin();
   TexPool::iterator tcend2 = texture_pool.end();
   while (iter2 != tcend2)
@@ -206,6 +337,49 @@ void TextureCacheBase::Cleanup(int _frameCount)
       ++iter2;
     }
   }
+
+  EnforceMemoryBudget(_frameCount);
+}
+
+void TextureCacheBase::EnforceMemoryBudget(int frame_count)
+{
+  if (g_ActiveConfig.iTextureCacheBudget <= 0)
+    return;
+
+  const size_t budget = static_cast<size_t>(g_ActiveConfig.iTextureCacheBudget) * 1024 * 1024;
+  size_t used = 0;
+  for (const auto& entry : textures_by_address)
+    used += entry.second->texture->GetConfig().GetMemorySize();
+  for (const auto& entry : texture_pool)
+    used += entry.second.texture->GetConfig().GetMemorySize();
+  if (used <= budget)
+    return;
+
+  // The pool only saves allocations, so it is emptied before any cached texture is dropped.
+  // Textures freed below return to it, which is why it is emptied once more at the end.
+  for (const auto& entry : texture_pool)
+    used -= entry.second.texture->GetConfig().GetMemorySize();
+  texture_pool.clear();
+
+  // EFB copies only exist on the host GPU, so like in Cleanup, they aren't evicted by age
+  std::vector<TexAddrCache::iterator> candidates;
+  for (auto iter = textures_by_address.begin(); iter != textures_by_address.end(); ++iter)
+  {
+    if (!iter->second->IsCopy() && iter->second->frameCount < frame_count)
+      candidates.push_back(iter);
+  }
+  std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+    return a->second->frameCount < b->second->frameCount;
+  });
+
+  for (TexAddrCache::iterator iter : candidates)
+  {
+    if (used <= budget)
+      break;
+    used -= iter->second->texture->GetConfig().GetMemorySize();
+    InvalidateTexture(iter);
+  }
+  texture_pool.clear();
 }
 
 bool TextureCacheBase::TCacheEntry::OverlapsMemoryRange(u32 range_address, u32 range_size) const
@@ -226,10 +400,13 @@ void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
   backup_config.texfmt_overlay_center = config.bTexFmtOverlayCenter;
   backup_config.hires_textures = config.bHiresTextures;
   backup_config.cache_hires_textures = config.bCacheHiresTextures;
+  backup_config.stream_hires_textures = config.bStreamHiresTextures;
+  backup_config.hires_texture_streaming_budget = config.iHiresTextureStreamingBudget;
   backup_config.stereo_3d = config.stereo_mode != StereoMode::Off;
   backup_config.efb_mono_depth = config.bStereoEFBMonoDepth;
   backup_config.gpu_texture_decoding = config.bEnableGPUTextureDecoding;
   backup_config.disable_vram_copies = config.bDisableCopyToVRAM;
+  backup_config.texture_decoding_threads = config.GetTextureDecodingThreads();
 }
 
 TextureCacheBase::TCacheEntry*
@@ -443,15 +620,16 @@ TextureCacheBase::DoPartialTextureUpdates(TCacheEntry* entry_to_update, u8* pale
   return entry_to_update;
 }
 
+static u32 CalculateLevelSize(u32 level_0_size, u32 level)
+{
+  return std::max(level_0_size >> level, 1u);
+}
+
 void TextureCacheBase::DumpTexture(TCacheEntry* entry, std::string basename, unsigned int level,
                                    bool is_arbitrary)
 {
   std::string szDir = File::GetUserPath(D_DUMPTEXTURES_IDX) + SConfig::GetInstance().GetGameID();
 
-  // make sure that the directory exists
-  if (!File::IsDirectory(szDir))
-    File::CreateDir(szDir);
-
   if (is_arbitrary)
   {
     basename += "_arb";
@@ -464,13 +642,43 @@ void TextureCacheBase::DumpTexture(TCacheEntry* entry, std::string basename, uns
 
   std::string filename = szDir + "/" + basename + ".png";
 
-  if (!File::Exists(filename))
-    entry->texture->Save(filename, level);
-}
+  if (!m_dumped_textures.insert(filename).second || File::Exists(filename))
+    return;
 
-static u32 CalculateLevelSize(u32 level_0_size, u32 level)
-{
-  return std::max(level_0_size >> level, 1u);
+  // make sure that the directory exists
+  if (!File::IsDirectory(szDir))
+    File::CreateDir(szDir);
+
+  auto data = std::make_shared<std::vector<u8>>();
+  if (!entry->texture->ReadLevel(level, data.get()))
+    return;
+
+  // Don't drop dumps if the threads fall behind, wait for them instead.
+  while (m_texture_dumps_pending.load() >= MAX_PENDING_TEXTURE_DUMPS)
+    m_texture_dump_done.Wait();
+
+  if (m_texture_dump_threads.empty())
+  {
+    const u32 num_threads = std::max(std::thread::hardware_concurrency() / 2, 1u);
+    for (u32 i = 0; i < num_threads; i++)
+    {
+      m_texture_dump_threads.push_back(
+          std::make_unique<Common::WorkQueueThread<std::function<void()>>>(
+              [](std::function<void()> job) { job(); }));
+    }
+  }
+
+  const int width = static_cast<int>(CalculateLevelSize(entry->texture->GetWidth(), level));
+  const int height = static_cast<int>(CalculateLevelSize(entry->texture->GetHeight(), level));
+  const int compression_level = g_ActiveConfig.iPNGCompressionLevel;
+  m_texture_dumps_pending++;
+  m_texture_dump_threads[m_texture_dump_counter % m_texture_dump_threads.size()]->EmplaceItem(
+      [this, data, filename, width, height, compression_level] {
+        TextureToPng(data->data(), width * 4, filename, width, height, true, compression_level);
+        m_texture_dumps_pending--;
+        m_texture_dump_done.Set();
+      });
+  m_texture_dump_counter++;
 }
 
 void TextureCacheBase::BindTextures()
@@ -628,6 +836,8 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
     return bound_textures[stage];
   }
 
+  PROFILE("TextureCacheBase::Load");
+
   const FourTexUnits& tex = bpmem.tex[stage >> 2];
   const u32 id = stage & 3;
   const u32 address = (tex.texImage3[id].image_base /* & 0x1FFFFF*/) << 5;
@@ -731,8 +941,16 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
     FifoRecorder::GetInstance().UseMemory(address, texture_size + additional_mips_size,
                                           MemoryUpdate::TEXTURE_MAP);
 
+  if (!from_tmem && HasPendingEFBCopies(address, texture_size + additional_mips_size))
+    FlushEFBCopies();
+
   // TODO: This doesn't hash GB tiles for preloaded RGBA8 textures (instead, it's hashing more data
   // from the low tmem bank than it should)
+  // TODO: Rehashing could be skipped for textures whose memory hasn't been written since the last
+  // hash, but there is no write tracking to tell. Guest RAM is written through the fastmem views
+  // by JIT code, as well as directly through Memory::GetPointer by DMA, IOS and EFB copies, and
+  // page protection would have to cover every one of those views without breaking fastmem's own
+  // fault handling.
   base_hash = Common::GetHash64(src_data, texture_size, textureCacheSafetyColorSampleSize);
   u32 palette_size = 0;
   if (isPaletteTexture)
@@ -790,6 +1008,7 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
   TexAddrCache::iterator oldest_entry = iter;
   int temp_frameCount = 0x7fffffff;
   TexAddrCache::iterator unconverted_copy = textures_by_address.end();
+  bool palette_changed = false;
 
   while (iter != iter_range.second)
   {
@@ -847,6 +1066,9 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
 
         return entry;
       }
+
+      if (isPaletteTexture && !entry->IsEfbCopy() && entry->base_hash == base_hash)
+        palette_changed = true;
     }
 
     // Find the texture which hasn't been used for the longest time. Count paletted
@@ -900,6 +1122,36 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
     }
   }
 
+  // Games which animate paletted textures by cycling their palettes would otherwise have the whole
+  // texture decoded again for every palette. Once a second palette shows up for the same texture,
+  // its indices are loaded as an intensity texture of the same bit depth, which is the format EFB
+  // copies to paletted textures have, and each palette is applied to that on the GPU.
+  if (palette_changed && g_Config.backend_info.bSupportsPaletteConversion &&
+      (texformat == TextureFormat::C4 || texformat == TextureFormat::C8) && tex_levels == 1 &&
+      !g_ActiveConfig.bHiresTextures && !g_ActiveConfig.bDumpTextures)
+  {
+    const TextureFormat index_format =
+        texformat == TextureFormat::C4 ? TextureFormat::I4 : TextureFormat::I8;
+    TCacheEntry* index_entry =
+        GetTexture(address, width, height, index_format, textureCacheSafetyColorSampleSize,
+                   tlutaddr, tlutfmt, use_mipmaps, tex_levels, from_tmem, tmem_address_even,
+                   tmem_address_odd);
+    if (index_entry)
+    {
+      index_entry->frameCount = FRAMECOUNT_INVALID;
+      TCacheEntry* decoded_entry = ApplyPaletteToEntry(index_entry, &texMem[tlutaddr], tlutfmt);
+      if (decoded_entry)
+      {
+        decoded_entry->SetGeneralParameters(address, texture_size, full_format, false);
+        decoded_entry->SetHashes(base_hash, full_hash);
+        return decoded_entry;
+      }
+    }
+
+    // The lookup of the index texture may have removed oldest_entry, and made room already
+    temp_frameCount = 0x7fffffff;
+  }
+
   // If at least one entry was not used for the same frame, overwrite the oldest one
   if (temp_frameCount != 0x7fffffff)
   {
@@ -908,10 +1160,11 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
   }
 
   std::shared_ptr<HiresTexture> hires_tex;
+  bool hires_tex_loading = false;
   if (g_ActiveConfig.bHiresTextures)
   {
     hires_tex = HiresTexture::Search(src_data, texture_size, &texMem[tlutaddr], palette_size, width,
-                                     height, texformat, use_mipmaps);
+                                     height, texformat, use_mipmaps, &hires_tex_loading);
 
     if (hires_tex)
     {
@@ -930,13 +1183,9 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
   const u32 texLevels = hires_tex ? (u32)hires_tex->m_levels.size() : tex_levels;
 
   // We can decode on the GPU if it is a supported format and the flag is enabled.
-  // Currently we don't decode RGBA8 textures from Tmem, as that would require copying from both
-  // banks, and if we're doing an copy we may as well just do the whole thing on the CPU, since
-  // there's no conversion between formats. In the future this could be extended with a separate
-  // shader, however.
+  // RGBA8 textures from Tmem have their two banks interleaved first.
   bool decode_on_gpu = !hires_tex && g_ActiveConfig.UseGPUTextureDecoding() &&
-                       g_texture_cache->SupportsGPUTextureDecode(texformat, tlutfmt) &&
-                       !(from_tmem && texformat == TextureFormat::RGBA8);
+                       g_texture_cache->SupportsGPUTextureDecode(texformat, tlutfmt);
 
   // create the entry/texture
   TextureConfig config;
@@ -957,8 +1206,8 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
   if (hires_tex)
   {
     const auto& level = hires_tex->m_levels[0];
-    entry->texture->Load(0, level.width, level.height, level.row_length, level.data.data(),
-                         level.data.size());
+    entry->texture->Load(0, level.width, level.height, level.row_length, level.GetData(),
+                         level.GetSize());
   }
 
   // Initialized to null because only software loading uses this buffer
@@ -968,8 +1217,12 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
   {
     if (decode_on_gpu)
     {
+      const u8* gpu_src_data = src_data;
+      if (texformat == TextureFormat::RGBA8 && from_tmem)
+        gpu_src_data = InterleaveRGBA8FromTmem(src_data, &texMem[tmem_address_odd], texture_size);
+
       u32 row_stride = bytes_per_block * (expandedWidth / bsw);
-      g_texture_cache->DecodeTextureOnGPU(entry, 0, src_data, texture_size, texformat, width,
+      g_texture_cache->DecodeTextureOnGPU(entry, 0, gpu_src_data, texture_size, texformat, width,
                                           height, expandedWidth, expandedHeight, row_stride, tlut,
                                           tlutfmt);
     }
@@ -997,8 +1250,8 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
       dst_buffer = temp;
       if (!(texformat == TextureFormat::RGBA8 && from_tmem))
       {
-        TexDecoder_Decode(dst_buffer, src_data, expandedWidth, expandedHeight, texformat, tlut,
-                          tlutfmt);
+        DecodeTexture(dst_buffer, src_data, expandedWidth, expandedHeight, texformat, tlut,
+                      tlutfmt);
       }
       else
       {
@@ -1023,9 +1276,11 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
   }
 
   entry->SetGeneralParameters(address, texture_size, full_format, false);
+  m_largest_texture_size = std::max(m_largest_texture_size, texture_size);
   entry->SetDimensions(nativeW, nativeH, tex_levels);
   entry->SetHashes(base_hash, full_hash);
   entry->is_custom_tex = hires_tex != nullptr;
+  entry->waiting_for_custom_tex = hires_tex_loading;
   entry->memory_stride = entry->BytesPerRow();
   entry->SetNotCopy();
 
@@ -1042,7 +1297,7 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
     {
       const auto& level = hires_tex->m_levels[level_index];
       entry->texture->Load(level_index, level.width, level.height, level.row_length,
-                           level.data.data(), level.data.size());
+                           level.GetData(), level.GetSize());
     }
   }
   else
@@ -1080,8 +1335,8 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
       {
         // No need to call CheckTempSize here, as the whole buffer is preallocated at the beginning
         size_t decoded_mip_size = expanded_mip_width * sizeof(u32) * expanded_mip_height;
-        TexDecoder_Decode(dst_buffer, mip_src_data, expanded_mip_width, expanded_mip_height,
-                          texformat, tlut, tlutfmt);
+        DecodeTexture(dst_buffer, mip_src_data, expanded_mip_width, expanded_mip_height, texformat,
+                      tlut, tlutfmt);
         entry->texture->Load(level, mip_width, mip_height, expanded_mip_width, dst_buffer,
                              decoded_mip_size);
 
@@ -1106,6 +1361,8 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
   }
 
   INCSTAT(stats.numTexturesUploaded);
+  INCSTAT(stats.thisFrame.numTextureUploads);
+  ADDSTAT(stats.thisFrame.bytesTextureUploaded, texture_size + additional_mips_size);
   SETSTAT(stats.numTexturesAlive, textures_by_address.size());
 
   entry = DoPartialTextureUpdates(iter->second, &texMem[tlutaddr], tlutfmt);
@@ -1223,6 +1480,9 @@ std::optional<TextureLookupInformation> TextureCacheBase::ComputeTextureInformat
   tex_info.full_format = TextureAndTLUTFormat(tex_format, tlut_format);
   tex_info.tlut_address = tlut_address;
 
+  if (!from_tmem && HasPendingEFBCopies(tex_info.address, tex_info.total_bytes))
+    FlushEFBCopies();
+
   // TODO: This doesn't hash GB tiles for preloaded RGBA8 textures (instead, it's hashing more data
   // from the low tmem bank than it should)
   tex_info.base_hash = Common::GetHash64(tex_info.src_data, tex_info.total_bytes,
@@ -1438,6 +1698,7 @@ TextureCacheBase::CreateNormalTexture(const TextureLookupInformation& tex_info)
   }
 
   entry->SetGeneralParameters(tex_info.address, tex_info.total_bytes, tex_info.full_format, false);
+  m_largest_texture_size = std::max(m_largest_texture_size, tex_info.total_bytes);
   entry->SetDimensions(tex_info.native_width, tex_info.native_height, tex_info.computed_levels);
   entry->SetHashes(tex_info.base_hash, tex_info.full_hash);
   entry->is_custom_tex = false;
@@ -1445,6 +1706,8 @@ TextureCacheBase::CreateNormalTexture(const TextureLookupInformation& tex_info)
   entry->SetNotCopy();
 
   INCSTAT(stats.numTexturesUploaded);
+  INCSTAT(stats.thisFrame.numTextureUploads);
+  ADDSTAT(stats.thisFrame.bytesTextureUploaded, tex_info.total_bytes);
   SETSTAT(stats.numTexturesAlive, textures_by_address.size());
 
   return entry;
@@ -1454,14 +1717,10 @@ void TextureCacheBase::LoadTextureFromMemory(TCacheEntry* entry_to_update,
                                              const TextureLookupInformation& tex_info)
 {
   // We can decode on the GPU if it is a supported format and the flag is enabled.
-  // Currently we don't decode RGBA8 textures from Tmem, as that would require copying from both
-  // banks, and if we're doing an copy we may as well just do the whole thing on the CPU, since
-  // there's no conversion between formats. In the future this could be extended with a separate
-  // shader, however.
+  // RGBA8 textures from Tmem have their two banks interleaved first.
   bool decode_on_gpu = g_ActiveConfig.UseGPUTextureDecoding() &&
                        g_texture_cache->SupportsGPUTextureDecode(tex_info.full_format.texfmt,
-                                                                 tex_info.full_format.tlutfmt) &&
-                       !(tex_info.from_tmem && tex_info.full_format.texfmt == TextureFormat::RGBA8);
+                                                                 tex_info.full_format.tlutfmt);
 
   LoadTextureLevelZeroFromMemory(entry_to_update, tex_info, decode_on_gpu);
 }
@@ -1474,9 +1733,16 @@ void TextureCacheBase::LoadTextureLevelZeroFromMemory(TCacheEntry* entry_to_upda
 
   if (decode_on_gpu)
   {
+    const u8* src_data = tex_info.src_data;
+    if (tex_info.full_format.texfmt == TextureFormat::RGBA8 && tex_info.from_tmem)
+    {
+      src_data = InterleaveRGBA8FromTmem(src_data, &texMem[tex_info.tmem_address_odd],
+                                         tex_info.total_bytes);
+    }
+
     u32 row_stride = tex_info.bytes_per_block * (tex_info.expanded_width / tex_info.block_width);
     g_texture_cache->DecodeTextureOnGPU(
-        entry_to_update, 0, tex_info.src_data, tex_info.total_bytes, tex_info.full_format.texfmt,
+        entry_to_update, 0, src_data, tex_info.total_bytes, tex_info.full_format.texfmt,
         tex_info.native_width, tex_info.native_height, tex_info.expanded_width,
         tex_info.expanded_height, row_stride, tlut, tex_info.full_format.tlutfmt);
   }
@@ -1486,8 +1752,8 @@ void TextureCacheBase::LoadTextureLevelZeroFromMemory(TCacheEntry* entry_to_upda
     CheckTempSize(decoded_texture_size);
     if (!(tex_info.full_format.texfmt == TextureFormat::RGBA8 && tex_info.from_tmem))
     {
-      TexDecoder_Decode(temp, tex_info.src_data, tex_info.expanded_width, tex_info.expanded_height,
-                        tex_info.full_format.texfmt, tlut, tex_info.full_format.tlutfmt);
+      DecodeTexture(temp, tex_info.src_data, tex_info.expanded_width, tex_info.expanded_height,
+                    tex_info.full_format.texfmt, tlut, tex_info.full_format.tlutfmt);
     }
     else
     {
@@ -1617,6 +1883,8 @@ void TextureCacheBase::CopyRenderTargetToTexture(
     return;
   }
 
+  INCSTAT(stats.thisFrame.numEFBCopies);
+
   // tex_w and tex_h are the native size of the texture in the GC memory.
   // The size scaled_* represents the emulated texture. Those differ
   // because of upscaling and because of yscaling of XFB copies.
@@ -1660,17 +1928,66 @@ void TextureCacheBase::CopyRenderTargetToTexture(
   const u32 bytes_per_row = num_blocks_x * bytes_per_block;
   const u32 covered_range = num_blocks_y * dstStride;
 
+  // A repeat of the last VRAM-only copy from an unchanged EFB produces the same texture. If it
+  // goes to the same memory, keep the existing entry, as long as the guest hasn't touched its
+  // memory since.
+  const bool reusable_copy =
+      copy_to_vram && !copy_to_ram && dstStride >= bytes_per_row && !g_bRecordFifoData;
+  EFBCopyKey copy_key = {};
+  bool repeated_copy = false;
+  if (reusable_copy)
+  {
+    copy_key = {dstFormat,
+                tex_w,
+                tex_h,
+                scaled_tex_w,
+                scaled_tex_h,
+                srcRect,
+                bpmem.zcontrol.pixel_format,
+                is_depth_copy,
+                isIntensity,
+                scaleByHalf,
+                y_scale,
+                gamma,
+                clamp_top,
+                clamp_bottom,
+                filter_coefficients,
+                g_renderer->GetEFBGeneration()};
+    repeated_copy = m_last_vram_copy_entry && !m_last_vram_copy_entry->tmem_only &&
+                    m_last_vram_copy == copy_key;
+    if (repeated_copy && m_last_vram_copy_entry->addr == dstAddr &&
+        m_last_vram_copy_entry->memory_stride == dstStride &&
+        m_last_vram_copy_entry->hash == m_last_vram_copy_entry->CalculateHash())
+    {
+      return;
+    }
+  }
+
   if (copy_to_ram)
   {
     CopyFilterCoefficientArray coefficients = GetRAMCopyFilterCoefficients(filter_coefficients);
     PEControl::PixelFormat srcFormat = bpmem.zcontrol.pixel_format;
     EFBCopyParams format(srcFormat, dstFormat, is_depth_copy, isIntensity,
                          NeedsCopyFilterInShader(coefficients));
+    const size_t num_pending_copies = m_pending_efb_copies.size();
+    INCSTAT(stats.thisFrame.numEFBCopiesToRAM);
     CopyEFB(dst, format, tex_w, bytes_per_row, num_blocks_y, dstStride, srcRect, scaleByHalf,
             y_scale, gamma, clamp_top, clamp_bottom, coefficients);
+
+    // Record the guest memory covered by any readback the backend deferred, so that reading it
+    // waits for the copy.
+    for (size_t i = num_pending_copies; i < m_pending_efb_copies.size(); i++)
+    {
+      m_pending_efb_copies[i].address = dstAddr;
+      m_pending_efb_copies[i].size = covered_range;
+    }
   }
   else
   {
+    // An earlier copy to this memory must not land on top of the one made here.
+    if (HasPendingEFBCopies(dstAddr, covered_range))
+      FlushEFBCopies();
+
     if (is_xfb_copy)
     {
       UninitializeXFBMemory(dst, dstStride, bytes_per_row, num_blocks_y);
@@ -1799,9 +2116,23 @@ void TextureCacheBase::CopyRenderTargetToTexture(
       entry->may_have_overlapping_textures = false;
       entry->is_custom_tex = false;
 
-      CopyEFBToCacheEntry(entry, is_depth_copy, srcRect, scaleByHalf, dstFormat, isIntensity, gamma,
-                          clamp_top, clamp_bottom,
-                          GetVRAMCopyFilterCoefficients(filter_coefficients));
+      // The previous copy may have been overwritten by this one, and invalidated above.
+      if (repeated_copy && m_last_vram_copy_entry &&
+          m_last_vram_copy_entry->texture->GetConfig() == config)
+      {
+        const TCacheEntry* source = m_last_vram_copy_entry;
+        for (u32 layer = 0; layer < config.layers; layer++)
+        {
+          entry->texture->CopyRectangleFromTexture(source->texture.get(), config.GetRect(), layer,
+                                                   0, config.GetRect(), layer, 0);
+        }
+      }
+      else
+      {
+        CopyEFBToCacheEntry(entry, is_depth_copy, srcRect, scaleByHalf, dstFormat, isIntensity,
+                            gamma, clamp_top, clamp_bottom,
+                            GetVRAMCopyFilterCoefficients(filter_coefficients));
+      }
 
       u64 hash = entry->CalculateHash();
       entry->SetHashes(hash, hash);
@@ -1825,10 +2156,105 @@ void TextureCacheBase::CopyRenderTargetToTexture(
       }
 
       textures_by_address.emplace(dstAddr, entry);
+      m_largest_texture_size = std::max(m_largest_texture_size, entry->size_in_bytes);
+
+      if (reusable_copy)
+      {
+        m_last_vram_copy = copy_key;
+        m_last_vram_copy_entry = entry;
+      }
     }
   }
 }
 
+void TextureCacheBase::WriteEFBCopyToRAM(u8* dst, u32 dst_stride,
+                                         const AbstractTexture* src_texture,
+                                         const MathUtil::Rectangle<int>& src_rect)
+{
+  const TextureConfig config(src_rect.GetWidth(), src_rect.GetHeight(), 1, 1, 1,
+                             src_texture->GetConfig().format, false);
+  std::unique_ptr<AbstractStagingTexture> staging_texture = AllocateEFBCopyStagingTexture(config);
+  if (!staging_texture)
+  {
+    ERROR_LOG(VIDEO, "Failed to allocate a %ux%u staging texture for an EFB copy", config.width,
+              config.height);
+    return;
+  }
+
+  staging_texture->CopyFromTexture(src_texture, src_rect, 0, 0, config.GetRect());
+  if (g_ActiveConfig.bDeferEFBCopies)
+  {
+    // The address is filled in by CopyRenderTargetToTexture once the backend returns.
+    m_pending_efb_copies.push_back({0, 0, dst, dst_stride, std::move(staging_texture)});
+    return;
+  }
+
+  staging_texture->ReadTexels(config.GetRect(), dst, dst_stride);
+  ReleaseEFBCopyStagingTexture(std::move(staging_texture));
+}
+
+void TextureCacheBase::FlushEFBCopies()
+{
+  if (m_pending_efb_copies.empty())
+    return;
+
+  // Copies are written in the order they were made, so later copies to the same memory win. Only
+  // the first readback has to wait for the GPU.
+  for (PendingEFBCopy& copy : m_pending_efb_copies)
+  {
+    const TextureConfig& config = copy.staging_texture->GetConfig();
+    copy.staging_texture->ReadTexels(config.GetRect(), copy.dst, copy.dst_stride);
+    ReleaseEFBCopyStagingTexture(std::move(copy.staging_texture));
+  }
+
+  // Entries created from these copies were hashed before the data reached guest memory, so the
+  // hashes have to be updated, or the entries would look modified by the CPU on their next use.
+  for (const PendingEFBCopy& copy : m_pending_efb_copies)
+  {
+    auto iter = FindOverlappingTextures(copy.address, copy.size);
+    for (; iter.first != iter.second; ++iter.first)
+    {
+      TCacheEntry* entry = iter.first->second;
+      if ((entry->IsEfbCopy() && entry->addr == copy.address) || entry->is_xfb_copy)
+      {
+        const u64 hash = entry->CalculateHash();
+        entry->SetHashes(hash, hash);
+      }
+    }
+  }
+
+  m_pending_efb_copies.clear();
+}
+
+bool TextureCacheBase::HasPendingEFBCopies(u32 address, u32 size) const
+{
+  return std::any_of(m_pending_efb_copies.begin(), m_pending_efb_copies.end(),
+                     [address, size](const PendingEFBCopy& copy) {
+                       return copy.address < address + size && address < copy.address + copy.size;
+                     });
+}
+
+std::unique_ptr<AbstractStagingTexture>
+TextureCacheBase::AllocateEFBCopyStagingTexture(const TextureConfig& config)
+{
+  auto iter = std::find_if(m_efb_copy_staging_texture_pool.begin(),
+                           m_efb_copy_staging_texture_pool.end(),
+                           [&config](const std::unique_ptr<AbstractStagingTexture>& texture) {
+                             return texture->GetConfig() == config;
+                           });
+  if (iter == m_efb_copy_staging_texture_pool.end())
+    return g_renderer->CreateStagingTexture(StagingTextureType::Readback, config);
+
+  std::unique_ptr<AbstractStagingTexture> texture = std::move(*iter);
+  m_efb_copy_staging_texture_pool.erase(iter);
+  return texture;
+}
+
+void TextureCacheBase::ReleaseEFBCopyStagingTexture(std::unique_ptr<AbstractStagingTexture> texture)
+{
+  m_efb_copy_staging_texture_pool.push_back(std::move(texture));
+}
+
 void TextureCacheBase::UninitializeXFBMemory(u8* dst, u32 stride, u32 bytes_per_row,
                                              u32 num_blocks_y)
 {
@@ -1942,13 +2368,12 @@ std::pair<TextureCacheBase::TexAddrCache::iterator, TextureCacheBase::TexAddrCac
 TextureCacheBase::FindOverlappingTextures(u32 addr, u32 size_in_bytes)
 {
   // We index by the starting address only, so there is no way to query all textures
-  // which end after the given addr. But the GC textures have a limited size, so we
-  // look for all textures which have a start address bigger than addr minus the maximal
-  // texture size. But this yields false-positives which must be checked later on.
-
-  // 1024 x 1024 texel times 8 nibbles per texel
-  constexpr u32 max_texture_size = 1024 * 1024 * 4;
-  u32 lower_addr = addr > max_texture_size ? addr - max_texture_size : 0;
+  // which end after the given addr. But no texture in the cache is larger than
+  // m_largest_texture_size, so we look for all textures which have a start address bigger than
+  // addr minus that size. But this yields false-positives which must be checked later on.
+  // Real textures are far smaller than the 4 MiB a 1024x1024 RGBA8 texture takes up, so this
+  // keeps the range from covering most of the cache.
+  u32 lower_addr = addr > m_largest_texture_size ? addr - m_largest_texture_size : 0;
   auto begin = textures_by_address.lower_bound(lower_addr);
   auto end = textures_by_address.upper_bound(addr + size_in_bytes);
 
@@ -1962,6 +2387,8 @@ TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter)
     return textures_by_address.end();
 
   TCacheEntry* entry = iter->second;
+  if (entry == m_last_vram_copy_entry)
+    m_last_vram_copy_entry = nullptr;
 
   if (entry->textures_by_hash_iter != textures_by_hash.end())
   {
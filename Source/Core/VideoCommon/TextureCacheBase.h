@@ -5,7 +5,9 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <bitset>
+#include <functional>
 #include <map>
 #include <memory>
 #include <optional>
@@ -13,14 +15,18 @@
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/WorkQueueThread.h"
 #include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/TextureConfig.h"
 #include "VideoCommon/TextureDecoder.h"
 #include "VideoCommon/VideoCommon.h"
 
+class AbstractStagingTexture;
 struct VideoConfig;
 
 struct TextureAndTLUTFormat
@@ -123,6 +129,7 @@ public:
     u32 memory_stride;
     bool is_efb_copy;
     bool is_custom_tex;
+    bool waiting_for_custom_tex = false;  // the custom texture is still being streamed in
     bool may_have_overlapping_textures = true;
     bool tmem_only = false;           // indicates that this texture only exists in the tmem cache
     bool has_arbitrary_mips = false;  // indicates that the mips in this texture are arbitrary
@@ -215,6 +222,20 @@ public:
   void Cleanup(int _frameCount);
 
   void Invalidate();
+  // Used after loading a savestate. Textures decoded from guest memory are kept, since their hash
+  // is compared against memory whenever they're used, but copies are dropped since they only
+  // exist on the host GPU and most likely don't match the loaded state.
+  void InvalidateCopies();
+
+  // Writes the EFB copies to RAM which are still waiting on the GPU. Must be called before guest
+  // memory written by an EFB copy is read by anything other than the texture cache.
+  void FlushEFBCopies();
+
+  // Reads the encoded EFB copy in src_rect of src_texture back to guest memory at dst. If EFB
+  // copies are deferred, this only queues the GPU-side copy, and the data reaches guest memory
+  // when it is next needed.
+  void WriteEFBCopyToRAM(u8* dst, u32 dst_stride, const AbstractTexture* src_texture,
+                         const MathUtil::Rectangle<int>& src_rect);
 
   virtual void CopyEFB(u8* dst, const EFBCopyParams& params, u32 native_width, u32 bytes_per_row,
                        u32 num_blocks_y, u32 memory_stride, const EFBRectangle& src_rect,
@@ -302,6 +323,49 @@ private:
   using TexHashCache = std::multimap<u64, TCacheEntry*>;
   using TexPool = std::unordered_multimap<TextureConfig, TexPoolEntry>;
 
+  // An EFB copy to RAM which has been encoded on the GPU, but not yet read back.
+  struct PendingEFBCopy
+  {
+    u32 address;
+    u32 size;
+    u8* dst;
+    u32 dst_stride;
+    std::unique_ptr<AbstractStagingTexture> staging_texture;
+  };
+
+  // The parameters which determine the texture produced by an EFB copy made only to VRAM.
+  // Copies with equal keys produce identical textures, wherever in memory they are placed.
+  struct EFBCopyKey
+  {
+    EFBCopyFormat dst_format;
+    u32 width;
+    u32 height;
+    u32 scaled_width;
+    u32 scaled_height;
+    EFBRectangle src_rect;
+    PEControl::PixelFormat src_format;
+    bool is_depth_copy;
+    bool is_intensity;
+    bool scale_by_half;
+    float y_scale;
+    float gamma;
+    bool clamp_top;
+    bool clamp_bottom;
+    CopyFilterCoefficients::Values filter_coefficients;
+    u64 efb_generation;
+
+    bool operator==(const EFBCopyKey& rhs) const
+    {
+      return std::tie(dst_format, width, height, scaled_width, scaled_height, src_rect, src_format,
+                      is_depth_copy, is_intensity, scale_by_half, y_scale, gamma, clamp_top,
+                      clamp_bottom, filter_coefficients, efb_generation) ==
+             std::tie(rhs.dst_format, rhs.width, rhs.height, rhs.scaled_width, rhs.scaled_height,
+                      rhs.src_rect, rhs.src_format, rhs.is_depth_copy, rhs.is_intensity,
+                      rhs.scale_by_half, rhs.y_scale, rhs.gamma, rhs.clamp_top, rhs.clamp_bottom,
+                      rhs.filter_coefficients, rhs.efb_generation);
+    }
+  };
+
   void SetBackupConfig(const VideoConfig& config);
 
   TCacheEntry* ApplyPaletteToEntry(TCacheEntry* entry, u8* palette, TLUTFormat tlutfmt);
@@ -312,11 +376,25 @@ private:
   void DumpTexture(TCacheEntry* entry, std::string basename, unsigned int level, bool is_arbitrary);
   void CheckTempSize(size_t required_size);
 
+  // Same as TexDecoder_Decode, but large textures are split into bands of block rows that are
+  // decoded on the texture decoding threads as well as the calling thread.
+  void DecodeTexture(u8* dst, const u8* src, u32 width, u32 height, TextureFormat format,
+                     const u8* tlut, TLUTFormat tlut_format);
+  void ResizeDecodingThreads(u32 num_threads);
+
+  // Returns the RGBA8 texture in the main memory layout, built in temp from the two Tmem banks.
+  const u8* InterleaveRGBA8FromTmem(const u8* src_ar, const u8* src_gb, u32 size);
+
   TCacheEntry* AllocateCacheEntry(const TextureConfig& config);
   std::unique_ptr<AbstractTexture> AllocateTexture(const TextureConfig& config);
   TexPool::iterator FindMatchingTextureFromPool(const TextureConfig& config);
   TexAddrCache::iterator GetTexCacheIter(TCacheEntry* entry);
 
+  std::unique_ptr<AbstractStagingTexture>
+  AllocateEFBCopyStagingTexture(const TextureConfig& config);
+  void ReleaseEFBCopyStagingTexture(std::unique_ptr<AbstractStagingTexture> texture);
+  bool HasPendingEFBCopies(u32 address, u32 size) const;
+
   // Return all possible overlapping textures. As addr+size of the textures is not
   // indexed, this may return false positives.
   std::pair<TexAddrCache::iterator, TexAddrCache::iterator>
@@ -331,6 +409,10 @@ private:
   // Removes and unlinks texture from texture cache and returns it to the pool
   TexAddrCache::iterator InvalidateTexture(TexAddrCache::iterator t_iter);
 
+  // Frees the least recently used textures while the cache uses more host memory than the
+  // configured budget. Textures used in the current frame and EFB copies are kept.
+  void EnforceMemoryBudget(int frame_count);
+
   void UninitializeXFBMemory(u8* dst, u32 stride, u32 bytes_per_row, u32 num_blocks_y);
 
   // Precomputing the coefficients for the previous, current, and next lines for the copy filter.
@@ -343,6 +425,37 @@ private:
   TexHashCache textures_by_hash;
   TexPool texture_pool;
   u64 last_entry_id = 0;
+  // An upper bound for size_in_bytes of the entries in textures_by_address, which limits how far
+  // back FindOverlappingTextures has to look. It is raised when entries are added, and brought back
+  // down to the actual largest size by Cleanup.
+  u32 m_largest_texture_size = 0;
+
+  std::vector<PendingEFBCopy> m_pending_efb_copies;
+
+  // Games often repeat an EFB copy without drawing in between, e.g. an XFB copy once per field,
+  // or the same source for several bloom or shadow textures. The last VRAM-only copy is
+  // remembered, so that a repeat to the same memory reuses its entry, and a repeat elsewhere is
+  // copied from its texture instead of the EFB.
+  EFBCopyKey m_last_vram_copy = {};
+  TCacheEntry* m_last_vram_copy_entry = nullptr;
+  std::vector<std::unique_ptr<AbstractStagingTexture>> m_efb_copy_staging_texture_pool;
+  u32 last_custom_tex_generation = 0;
+
+  std::vector<std::unique_ptr<Common::WorkQueueThread<std::function<void()>>>> m_decoding_threads;
+  std::atomic<u32> m_decoding_jobs_pending{0};
+  Common::Event m_decoding_jobs_done;
+
+  // Dumped textures are read back on the GPU thread, but compressed and written by these threads,
+  // which are only started once dumping begins. Further dumps wait for one of the first
+  // MAX_PENDING_TEXTURE_DUMPS to be written. File names which have been dumped or found on disk
+  // already are remembered, so that the disk isn't checked for every texture load.
+  static constexpr u32 MAX_PENDING_TEXTURE_DUMPS = 64;
+  std::unordered_set<std::string> m_dumped_textures;
+  std::atomic<u32> m_texture_dumps_pending{0};
+  Common::Event m_texture_dump_done;
+  u32 m_texture_dump_counter = 0;
+  std::vector<std::unique_ptr<Common::WorkQueueThread<std::function<void()>>>>
+      m_texture_dump_threads;
 
   // Backup configuration values
   struct BackupConfig
@@ -352,11 +465,14 @@ private:
     bool texfmt_overlay_center;
     bool hires_textures;
     bool cache_hires_textures;
+    bool stream_hires_textures;
+    int hires_texture_streaming_budget;
     bool copy_cache_enable;
     bool stereo_3d;
     bool efb_mono_depth;
     bool gpu_texture_decoding;
     bool disable_vram_copies;
+    u32 texture_decoding_threads;
   };
   BackupConfig backup_config = {};
 };
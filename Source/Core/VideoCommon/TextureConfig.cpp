@@ -39,6 +39,20 @@ size_t TextureConfig::GetMipStride(u32 level) const
   return AbstractTexture::CalculateStrideForFormat(format, std::max(width >> level, 1u));
 }
 
+size_t TextureConfig::GetMemorySize() const
+{
+  const bool compressed = AbstractTexture::IsCompressedFormat(format);
+  size_t size = 0;
+  for (u32 level = 0; level < levels; level++)
+  {
+    // Compressed formats have one row of 4x4 blocks per mip stride
+    const u32 level_height = std::max(height >> level, 1u);
+    const u32 rows = compressed ? std::max(level_height / 4, 1u) : level_height;
+    size += GetMipStride(level) * rows;
+  }
+  return size * layers * samples;
+}
+
 bool TextureConfig::IsMultisampled() const
 {
   return samples > 1;
@@ -49,6 +49,8 @@ struct TextureConfig
   MathUtil::Rectangle<int> GetMipRect(u32 level) const;
   size_t GetStride() const;
   size_t GetMipStride(u32 level) const;
+  // Total size of all levels, layers and samples, for budgeting texture memory
+  size_t GetMemorySize() const;
   bool IsMultisampled() const;
 
   u32 width = 0;
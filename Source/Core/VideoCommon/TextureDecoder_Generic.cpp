@@ -4,6 +4,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
 
 #include "Common/CPUDetect.h"
 #include "Common/CommonTypes.h"
@@ -142,6 +146,25 @@ static inline void DecodeBytes_RGBA8(u32* dst, const u16* src, const u16* src2)
 #endif
 }
 
+#ifdef _M_ARM_64
+static inline void DecodeBlock_RGBA8(u32* dst, const u8* src, int pitch)
+{
+  // The first 32 bytes hold the AR pairs of the 4x4 texels, the last 32 bytes their GB pairs
+  const uint8x16x2_t ar = vld2q_u8(src);
+  const uint8x16x2_t gb = vld2q_u8(src + 32);
+  const uint8x16x2_t rg = vzipq_u8(ar.val[1], gb.val[0]);
+  const uint8x16x2_t ba = vzipq_u8(gb.val[1], ar.val[0]);
+  const uint16x8x2_t rows01 =
+      vzipq_u16(vreinterpretq_u16_u8(rg.val[0]), vreinterpretq_u16_u8(ba.val[0]));
+  const uint16x8x2_t rows23 =
+      vzipq_u16(vreinterpretq_u16_u8(rg.val[1]), vreinterpretq_u16_u8(ba.val[1]));
+  vst1q_u32(dst, vreinterpretq_u32_u16(rows01.val[0]));
+  vst1q_u32(dst + pitch, vreinterpretq_u32_u16(rows01.val[1]));
+  vst1q_u32(dst + 2 * pitch, vreinterpretq_u32_u16(rows23.val[0]));
+  vst1q_u32(dst + 3 * pitch, vreinterpretq_u32_u16(rows23.val[1]));
+}
+#endif
+
 static void DecodeDXTBlock(u32* dst, const DXTBlock* src, int pitch)
 {
   // S3TC Decoder (Note: GCN decodes differently from PC so we can't use native support)
@@ -172,6 +195,32 @@ static void DecodeDXTBlock(u32* dst, const DXTBlock* src, int pitch)
     colors[3] = MakeRGBA((red1 + red2) / 2, (green1 + green2) / 2, (blue1 + blue2) / 2, 0);
   }
 
+#ifdef _M_ARM_64
+  // Extract the 2-bit indices of all 16 texels at once, with the first texel of each line in its
+  // top bits, and turn them into byte offsets into the color table.
+  // The same pattern also picks out the offsets of the first line's texels for each of their bytes.
+  static const u8 quarter_of_lane[16] = {0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3};
+  static const s8 texel_shift[16] = {-6, -4, -2, 0, -6, -4, -2, 0,
+                                     -6, -4, -2, 0, -6, -4, -2, 0};
+  static const u8 byte_in_color[16] = {0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3};
+
+  u32 lines;
+  std::memcpy(&lines, src->lines, sizeof(lines));
+  const uint8x16_t all_lines = vreinterpretq_u8_u32(vdupq_n_u32(lines));
+  uint8x16_t offsets = vqtbl1q_u8(all_lines, vld1q_u8(quarter_of_lane));
+  offsets = vandq_u8(vshlq_u8(offsets, vld1q_s8(texel_shift)), vdupq_n_u8(3));
+  offsets = vshlq_n_u8(offsets, 2);
+
+  const uint8x16_t table = vreinterpretq_u8_s32(vld1q_s32(colors));
+  uint8x16_t texels = vld1q_u8(quarter_of_lane);
+  for (int y = 0; y < 4; y++)
+  {
+    const uint8x16_t bytes = vaddq_u8(vqtbl1q_u8(offsets, texels), vld1q_u8(byte_in_color));
+    vst1q_u32(dst, vreinterpretq_u32_u8(vqtbl1q_u8(table, bytes)));
+    texels = vaddq_u8(texels, vdupq_n_u8(4));
+    dst += pitch;
+  }
+#else
   for (int y = 0; y < 4; y++)
   {
     int val = src->lines[y];
@@ -182,6 +231,7 @@ static void DecodeDXTBlock(u32* dst, const DXTBlock* src, int pitch)
     }
     dst += pitch;
   }
+#endif
 }
 
 // JSD 01/06/11:
@@ -227,6 +277,21 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
   break;
   case TextureFormat::I8:  // speed critical
   {
+#ifdef _M_ARM_64
+    for (int y = 0; y < height; y += 4)
+      for (int x = 0; x < width; x += 8)
+        for (int iy = 0; iy < 4; ++iy, src += 8)
+        {
+          // Repeat each intensity in all four channels
+          const uint8x8_t i = vld1_u8(src);
+          const uint8x8x2_t ii = vzip_u8(i, i);
+          const uint8x16_t ii_q = vcombine_u8(ii.val[0], ii.val[1]);
+          const uint8x16x2_t iiii = vzipq_u8(ii_q, ii_q);
+          u32* newdst = dst + (y + iy) * width + x;
+          vst1q_u8(reinterpret_cast<u8*>(newdst), iiii.val[0]);
+          vst1q_u8(reinterpret_cast<u8*>(newdst + 4), iiii.val[1]);
+        }
+#else
     // Reference C implementation
     for (int y = 0; y < height; y += 4)
       for (int x = 0; x < width; x += 8)
@@ -253,6 +318,7 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
           srcval = newsrc[0];
           newdst[0] = srcval | (srcval << 8) | (srcval << 16) | (srcval << 24);
         }
+#endif
   }
   break;
   case TextureFormat::C8:
@@ -316,6 +382,11 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
   break;
   case TextureFormat::RGBA8:  // speed critical
   {
+#ifdef _M_ARM_64
+    for (int y = 0; y < height; y += 4)
+      for (int x = 0; x < width; x += 4, src += 64)
+        DecodeBlock_RGBA8(dst + y * width + x, src, width);
+#else
     // Reference C implementation.
     for (int y = 0; y < height; y += 4)
       for (int x = 0; x < width; x += 4)
@@ -325,6 +396,7 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
                             (u16*)src + 4 * iy + 16);
         src += 64;
       }
+#endif
   }
   break;
   case TextureFormat::CMPR:  // speed critical
@@ -30,6 +30,8 @@ ShaderCode GenVertexShader(APIType ApiType, const ShaderHostConfig& host_config,
   const bool ssaa = host_config.ssaa;
   const bool per_pixel_lighting = host_config.per_pixel_lighting;
   const bool vertex_rounding = host_config.vertex_rounding;
+  const bool vs_stereo = host_config.stereo && host_config.backend_vs_layer_output;
+  const bool vs_point_size = ApiType == APIType::OpenGL && host_config.backend_vs_point_size;
   const u32 numTexgen = uid_data->num_texgens;
   ShaderCode out;
 
@@ -44,6 +46,10 @@ ShaderCode GenVertexShader(APIType ApiType, const ShaderHostConfig& host_config,
   out.Write(s_shader_uniforms);
   out.Write("};\n");
 
+  // The stereo and point size parameters are the ones the geometry shaders use
+  if (vs_stereo || vs_point_size)
+    out.Write("UBO_BINDING(std140, 3) uniform GSBlock {\n%s};\n", s_geometry_shader_uniforms);
+
   out.Write("struct VS_OUTPUT {\n");
   GenerateVSOutputMembers(out, ApiType, numTexgen, per_pixel_lighting, "");
   out.Write("};\n\n");
@@ -69,6 +75,8 @@ ShaderCode GenVertexShader(APIType ApiType, const ShaderHostConfig& host_config,
       out.Write("VARYING_LOCATION(0) out VertexData {\n");
       GenerateVSOutputMembers(out, ApiType, numTexgen, per_pixel_lighting,
                               GetInterpolationQualifier(msaa, ssaa, true, false));
+      if (vs_stereo)
+        out.Write("\tflat int layer;\n");
       out.Write("} vs;\n");
     }
     else
@@ -265,11 +273,22 @@ ShaderCode GenVertexShader(APIType ApiType, const ShaderHostConfig& host_config,
     out.Write("}\n");
   }
 
+  if (vs_stereo)
+  {
+    // Each primitive is drawn twice, as one instance for each eye. The horizontal offset is the
+    // same as the one geometry shaders add in stereo mode.
+    out.Write("int eye = gl_InstanceID;\n");
+    out.Write("o.pos.x += ((eye == 0) ? " I_STEREOPARAMS ".x : " I_STEREOPARAMS ".y) * (o.pos.w - "
+              I_STEREOPARAMS ".z);\n");
+  }
+
   if (ApiType == APIType::OpenGL || ApiType == APIType::Vulkan)
   {
     if (host_config.backend_geometry_shaders || ApiType == APIType::Vulkan)
     {
       AssignVSOutputMembers(out, "vs", "o", numTexgen, per_pixel_lighting);
+      if (vs_stereo)
+        out.Write("vs.layer = eye;\ngl_Layer = eye;\n");
     }
     else
     {
@@ -298,6 +317,10 @@ ShaderCode GenVertexShader(APIType ApiType, const ShaderHostConfig& host_config,
       out.Write("gl_Position = float4(o.pos.x, -o.pos.y, o.pos.z, o.pos.w);\n");
     else
       out.Write("gl_Position = o.pos;\n");
+
+    // Points are sized here instead of being expanded to quads by a geometry shader
+    if (vs_point_size)
+      out.Write("gl_PointSize = " I_LINEPTPARAMS ".w * " I_EFBSCALE ".x;\n");
   }
   else  // D3D
   {
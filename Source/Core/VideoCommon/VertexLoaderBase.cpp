@@ -11,6 +11,7 @@
 #include <string>
 #include <vector>
 
+#include "Common/BitSet.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
@@ -18,6 +19,8 @@
 
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/VertexLoader.h"
+#include "VideoCommon/VertexLoader_Position.h"
+#include "VideoCommon/VertexLoader_TextCoord.h"
 
 #ifdef _M_X86_64
 #include "VideoCommon/VertexLoaderX64.h"
@@ -72,6 +75,79 @@ void VertexLoaderBase::SetVAT(const VAT& vat)
   m_VtxAttr.texCoord[7].Frac = vat.g2.Tex7Frac;
 };
 
+u32 VertexLoaderBase::GetVertexSize(const TVtxDesc& vtx_desc, const VAT& vtx_attr)
+{
+  // Position and texture matrix indices are a byte each.
+  u32 size = Common::CountSetBits(static_cast<u32>(vtx_desc.Hex & 0x1FF));
+
+  size += VertexLoader_Position::GetSize(vtx_desc.Position, vtx_attr.g0.PosFormat,
+                                         vtx_attr.g0.PosElements);
+
+  // The table of VertexLoader_Normal is only filled in by VertexLoader_Normal::Init, and the
+  // JIT vertex loaders don't need it, so the size of normals is worked out here.
+  if (vtx_desc.Normal == DIRECT)
+  {
+    static constexpr std::array<u32, 8> component_sizes = {1, 1, 2, 2, 4, 0, 0, 0};
+    const u32 num_normals = vtx_attr.g0.NormalElements ? 3 : 1;
+    size += num_normals * 3 * component_sizes[vtx_attr.g0.NormalFormat];
+  }
+  else if (vtx_desc.Normal != NOT_PRESENT)
+  {
+    const u32 index_size = vtx_desc.Normal == INDEX16 ? 2 : 1;
+    const bool three_indices = vtx_attr.g0.NormalElements && vtx_attr.g0.NormalIndex3;
+    size += index_size * (three_indices ? 3 : 1);
+  }
+
+  const u64 col_desc[2] = {vtx_desc.Color0, vtx_desc.Color1};
+  const u32 col_comp[2] = {vtx_attr.g0.Color0Comp, vtx_attr.g0.Color1Comp};
+  for (int i = 0; i < 2; i++)
+  {
+    switch (col_desc[i])
+    {
+    case DIRECT:
+      switch (col_comp[i])
+      {
+      case FORMAT_16B_565:
+      case FORMAT_16B_4444:
+        size += 2;
+        break;
+      case FORMAT_24B_888:
+      case FORMAT_24B_6666:
+        size += 3;
+        break;
+      case FORMAT_32B_888x:
+      case FORMAT_32B_8888:
+        size += 4;
+        break;
+      }
+      break;
+    case INDEX8:
+      size += 1;
+      break;
+    case INDEX16:
+      size += 2;
+      break;
+    }
+  }
+
+  const u32 tc_elements[8] = {vtx_attr.g0.Tex0CoordElements, vtx_attr.g1.Tex1CoordElements,
+                              vtx_attr.g1.Tex2CoordElements, vtx_attr.g1.Tex3CoordElements,
+                              vtx_attr.g1.Tex4CoordElements, vtx_attr.g2.Tex5CoordElements,
+                              vtx_attr.g2.Tex6CoordElements, vtx_attr.g2.Tex7CoordElements};
+  const u32 tc_format[8] = {vtx_attr.g0.Tex0CoordFormat, vtx_attr.g1.Tex1CoordFormat,
+                            vtx_attr.g1.Tex2CoordFormat, vtx_attr.g1.Tex3CoordFormat,
+                            vtx_attr.g1.Tex4CoordFormat, vtx_attr.g2.Tex5CoordFormat,
+                            vtx_attr.g2.Tex6CoordFormat, vtx_attr.g2.Tex7CoordFormat};
+  u64 tc_desc = vtx_desc.Hex >> 17;
+  for (int i = 0; i < 8; i++)
+  {
+    size += VertexLoader_TextCoord::GetSize(tc_desc & 3, tc_format[i], tc_elements[i]);
+    tc_desc >>= 2;
+  }
+
+  return size;
+}
+
 std::string VertexLoaderBase::ToString() const
 {
   std::string dest;
@@ -62,6 +62,8 @@ class VertexLoaderBase
 public:
   static std::unique_ptr<VertexLoaderBase> CreateVertexLoader(const TVtxDesc& vtx_desc,
                                                               const VAT& vtx_attr);
+  // Size of a raw GC vertex in the given format, computed without creating a loader for it.
+  static u32 GetVertexSize(const TVtxDesc& vtx_desc, const VAT& vtx_attr);
   virtual ~VertexLoaderBase() {}
   virtual int RunVertices(DataReader src, DataReader dst, int count) = 0;
 
@@ -3,6 +3,9 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -13,6 +16,8 @@
 #include "Common/Assert.h"
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+#include "Common/Profiler.h"
 #include "Core/HW/Memmap.h"
 
 #include "VideoCommon/BPMemory.h"
@@ -22,8 +27,12 @@
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
+#include "VideoCommon/VertexLoader_Normal.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VertexShaderManager.h"
+#include "VideoCommon/VideoCommon.h"
+#include "VideoCommon/VideoConfig.h"
+#include "VideoCommon/XFMemory.h"
 
 namespace VertexLoaderManager
 {
@@ -44,18 +53,44 @@ static VertexLoaderMap s_vertex_loader_map;
 
 u8* cached_arraybases[12];
 
+// Display lists are often drawn again every frame with the same data, so we keep the converted
+// vertices of their draws around. Only draws without indexed attributes are cached, as their
+// output depends on nothing but the source data and the vertex loader. An entry is created with
+// no data the first time a draw is seen and only filled in when it is seen again.
+struct CachedVertices
+{
+  const VertexLoaderBase* loader;
+  int count;
+  std::vector<u8> data;
+  float position_cache[3][4];
+  u32 position_matrix_index[4];
+};
+static std::unordered_map<u64, CachedVertices> s_vertex_cache;
+static size_t s_vertex_cache_size = 0;
+constexpr size_t VERTEX_CACHE_MAX_SIZE = 32 * 1024 * 1024;
+// Smaller draws are decoded about as fast as they are hashed.
+constexpr int VERTEX_CACHE_MIN_VERTICES = 64;
+
+static void ClearVertexCache()
+{
+  s_vertex_cache.clear();
+  s_vertex_cache_size = 0;
+}
+
 void Init()
 {
   MarkAllDirty();
+  // Needed for the vertex sizes computed during preprocessing, before any loader has been created.
+  VertexLoader_Normal::Init();
   for (auto& map_entry : g_main_cp_state.vertex_loaders)
     map_entry = nullptr;
-  for (auto& map_entry : g_preprocess_cp_state.vertex_loaders)
-    map_entry = nullptr;
   SETSTAT(stats.numVertexLoaders, 0);
 }
 
 void Clear()
 {
+  ClearVertexCache();
+
   std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
   s_vertex_loader_map.clear();
   s_native_vertex_map.clear();
@@ -195,17 +230,32 @@ NativeVertexFormat* GetUberVertexFormat(const PortableVertexDeclaration& decl)
   return GetOrCreateMatchingFormat(new_decl);
 }
 
-static VertexLoaderBase* RefreshLoader(int vtx_attr_group, bool preprocess = false)
+// The preprocessing pass of the deterministic GPU thread only has to know where each draw ends, so
+// it tracks vertex sizes instead of creating (and compiling) loaders on the CPU thread.
+static std::array<u32, 8> s_preprocess_vertex_sizes;
+
+static u32 GetPreprocessVertexSize(int vtx_attr_group)
 {
-  CPState* state = preprocess ? &g_preprocess_cp_state : &g_main_cp_state;
+  CPState* state = &g_preprocess_cp_state;
+  if (state->attr_dirty[vtx_attr_group])
+  {
+    s_preprocess_vertex_sizes[vtx_attr_group] =
+        VertexLoaderBase::GetVertexSize(state->vtx_desc, state->vtx_attr[vtx_attr_group]);
+    state->attr_dirty[vtx_attr_group] = false;
+  }
+
+  return s_preprocess_vertex_sizes[vtx_attr_group];
+}
+
+static VertexLoaderBase* RefreshLoader(int vtx_attr_group)
+{
+  CPState* state = &g_main_cp_state;
   state->last_id = vtx_attr_group;
 
   VertexLoaderBase* loader;
   if (state->attr_dirty[vtx_attr_group])
   {
-    // We are not allowed to create a native vertex format on preprocessing as this is on the wrong
-    // thread
-    bool check_for_native_format = !preprocess;
+    bool check_for_native_format = true;
 
     VertexLoaderUID uid(state->vtx_desc, state->vtx_attr[vtx_attr_group]);
     std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
@@ -242,26 +292,118 @@ static VertexLoaderBase* RefreshLoader(int vtx_attr_group, bool preprocess = fal
   }
 
   // Lookup pointers for any vertex arrays.
-  if (!preprocess)
-    UpdateVertexArrayPointers();
+  UpdateVertexArrayPointers();
 
   return loader;
 }
 
-int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bool is_preprocess)
+static bool HasIndexedAttributes(const TVtxDesc& vtx_desc)
+{
+  // The upper bit of each Position..Tex7Coord field is set for indexed attributes.
+  return ((vtx_desc.Hex >> 9) & 0xAAAAAA) != 0;
+}
+
+// Whether the emulated GPU would clip or scissor away all of the triangles of a draw, going by the
+// positions of its converted vertices. Since the regions tested are convex, it's enough for all
+// vertices to be outside one edge of the same region.
+static bool IsDrawOffscreen(const u8* vertices, int count, const PortableVertexDeclaration& decl)
+{
+  // The hacks which show more of the scene than the emulated GPU would can't be culled for
+  if (g_ActiveConfig.bWidescreenHack || g_ActiveConfig.bFreeLook ||
+      g_ActiveConfig.stereo_mode != StereoMode::Off ||
+      (xfmem.projection.type == GX_PERSPECTIVE &&
+       (g_ActiveConfig.fAspectRatioHackW != 1.0f || g_ActiveConfig.fAspectRatioHackH != 1.0f)))
+  {
+    return false;
+  }
+
+  const float* projection = xfmem.projection.rawProjection;
+  const bool perspective = xfmem.projection.type == GX_PERSPECTIVE;
+
+  // The scissor rectangle relative to the viewport origin, both including the offset of 342
+  const int xoff = bpmem.scissorOffset.x * 2;
+  const int yoff = bpmem.scissorOffset.y * 2;
+  const float scissor_left = std::max<int>(bpmem.scissorTL.x, xoff) - xfmem.viewport.xOrig;
+  const float scissor_top = std::max<int>(bpmem.scissorTL.y, yoff) - xfmem.viewport.yOrig;
+  const float scissor_right =
+      std::min<int>(bpmem.scissorBR.x + 1, xoff + EFB_WIDTH) - xfmem.viewport.xOrig;
+  const float scissor_bottom =
+      std::min<int>(bpmem.scissorBR.y + 1, yoff + EFB_HEIGHT) - xfmem.viewport.yOrig;
+
+  // Each bit is an edge which all vertices so far are outside of
+  u32 outside_all = 0xff;
+  u32 matrix_index = g_main_cp_state.matrix_index_a.PosNormalMtxIdx;
+  for (int i = 0; i < count && outside_all != 0; i++)
+  {
+    const u8* vertex = vertices + i * decl.stride;
+    if (decl.posmtx.enable)
+      matrix_index = vertex[decl.posmtx.offset];
+
+    float position[3] = {};
+    std::memcpy(position, vertex + decl.position.offset, decl.position.components * sizeof(float));
+
+    const float* matrix = &xfmem.posMatrices[matrix_index * 4];
+    float view[3];
+    for (int row = 0; row < 3; row++)
+    {
+      view[row] = matrix[row * 4] * position[0] + matrix[row * 4 + 1] * position[1] +
+                  matrix[row * 4 + 2] * position[2] + matrix[row * 4 + 3];
+    }
+
+    float x, y, w;
+    if (perspective)
+    {
+      x = projection[0] * view[0] + projection[1] * view[2];
+      y = projection[2] * view[1] + projection[3] * view[2];
+      w = -view[2];
+    }
+    else
+    {
+      x = projection[0] * view[0] + projection[1];
+      y = projection[2] * view[1] + projection[3];
+      w = 1.0f;
+    }
+
+    // Leave a margin for the pixel center offsets added in the vertex shader
+    const float margin = std::abs(w) * (1.0f / 1024.0f);
+    u32 outside = (x < -w - margin ? 0x01 : 0) | (x > w + margin ? 0x02 : 0) |
+                  (y < -w - margin ? 0x04 : 0) | (y > w + margin ? 0x08 : 0);
+
+    // Only vertices in front of the viewer can be mapped to the screen
+    if (w > 0.0f)
+    {
+      const float screen_x = x / w * xfmem.viewport.wd;
+      const float screen_y = y / w * xfmem.viewport.ht;
+      outside |= (screen_x < scissor_left - 1.0f ? 0x10 : 0) |
+                 (screen_x > scissor_right + 1.0f ? 0x20 : 0) |
+                 (screen_y < scissor_top - 1.0f ? 0x40 : 0) |
+                 (screen_y > scissor_bottom + 1.0f ? 0x80 : 0);
+    }
+    outside_all &= outside;
+  }
+  return outside_all != 0;
+}
+
+int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bool is_preprocess,
+                bool in_display_list)
 {
   if (!count)
     return 0;
 
-  VertexLoaderBase* loader = RefreshLoader(vtx_attr_group, is_preprocess);
+  if (is_preprocess)
+  {
+    const int size = count * static_cast<int>(GetPreprocessVertexSize(vtx_attr_group));
+    return (int)src.size() < size ? -1 : size;
+  }
+
+  PROFILE("VertexLoaderManager::RunVertices");
+
+  VertexLoaderBase* loader = RefreshLoader(vtx_attr_group);
 
   int size = count * loader->m_VertexSize;
   if ((int)src.size() < size)
     return -1;
 
-  if (is_preprocess)
-    return size;
-
   // If the native vertex format changed, force a flush.
   if (loader->m_native_vertex_format != s_current_vtx_fmt ||
       loader->m_native_components != g_current_components)
@@ -273,14 +415,86 @@ int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bo
   VertexShaderManager::SetVertexFormat(loader->m_native_components);
 
   // if cull mode is CULL_ALL, tell VertexManager to skip triangles and quads.
-  // They still need to go through vertex loading, because we need to calculate a zfreeze refrence
-  // slope.
+  // Their last vertices still need to go through vertex loading, because we need to calculate a
+  // zfreeze refrence slope.
   bool cullall = (bpmem.genMode.cullmode == GenMode::CULL_ALL && primitive < 5);
 
   DataReader dst = g_vertex_manager->PrepareForAdditionalData(
       primitive, count, loader->m_native_vtx_decl.stride, cullall);
 
-  count = loader->RunVertices(src, dst, count);
+  // Culled vertices are never drawn, and the zfreeze slope only uses the last triangle. The
+  // loaders track that by the number of vertices left, so loading just the last three leaves the
+  // same state behind. The buffer still advances by the whole draw, as the slope calculation
+  // checks that it holds a triangle.
+  if (cullall)
+  {
+    const int loaded = std::min(count, 3);
+    src.Skip((count - loaded) * loader->m_VertexSize);
+    loader->RunVertices(src, dst, loaded);
+    g_vertex_manager->FlushData(count, loader->m_native_vtx_decl.stride);
+
+    ADDSTAT(stats.thisFrame.numPrims, count);
+    INCSTAT(stats.thisFrame.numPrimitiveJoins);
+    return size;
+  }
+
+  CachedVertices* cached = nullptr;
+  if (in_display_list && count >= VERTEX_CACHE_MIN_VERTICES &&
+      !HasIndexedAttributes(g_main_cp_state.vtx_desc))
+  {
+    const u64 hash =
+        Common::GetHash64(src.GetPointer(), size, 0) ^ reinterpret_cast<uintptr_t>(loader);
+    auto iter = s_vertex_cache.find(hash);
+    if (iter == s_vertex_cache.end())
+    {
+      s_vertex_cache.emplace(hash, CachedVertices{loader, count, {}, {}, {}});
+      s_vertex_cache_size += sizeof(CachedVertices);
+    }
+    else if (iter->second.loader == loader && iter->second.count == count)
+    {
+      cached = &iter->second;
+    }
+  }
+
+  const size_t output_size = static_cast<size_t>(count) * loader->m_native_vtx_decl.stride;
+  if (cached && !cached->data.empty())
+  {
+    // Restore the zfreeze state the vertex loader would have left behind.
+    std::memcpy(dst.GetPointer(), cached->data.data(), cached->data.size());
+    std::memcpy(position_cache, cached->position_cache, sizeof(position_cache));
+    std::memcpy(position_matrix_index, cached->position_matrix_index,
+                sizeof(position_matrix_index));
+  }
+  else
+  {
+    count = loader->RunVertices(src, dst, count);
+
+    // Entries are cheap to rebuild, so start over once the cache is full instead of tracking
+    // their age.
+    if (cached && s_vertex_cache_size + output_size > VERTEX_CACHE_MAX_SIZE)
+    {
+      ClearVertexCache();
+    }
+    else if (cached)
+    {
+      cached->data.assign(dst.GetPointer(), dst.GetPointer() + output_size);
+      std::memcpy(cached->position_cache, position_cache, sizeof(position_cache));
+      std::memcpy(cached->position_matrix_index, position_matrix_index,
+                  sizeof(position_matrix_index));
+      s_vertex_cache_size += output_size;
+    }
+  }
+
+  // Triangles the GPU would clip or scissor away entirely don't need to be drawn. Unlike lines and
+  // points, they have no width in screen space which could reach back into view. The vertices
+  // were still loaded for the zfreeze reference slope.
+  if (primitive < 5 && !bpmem.genMode.zfreeze &&
+      IsDrawOffscreen(dst.GetPointer(), count, loader->m_native_vtx_decl))
+  {
+    INCSTAT(stats.thisFrame.numDrawsCulled);
+    ADDSTAT(stats.thisFrame.numPrims, count);
+    return size;
+  }
 
   IndexGenerator::AddIndices(primitive, count);
 
@@ -314,42 +528,68 @@ void LoadCPReg(u32 sub_cmd, u32 value, bool is_preprocess)
       VertexShaderManager::SetTexMatrixChangedB(value);
     break;
 
+  // Rewriting a register with its current value doesn't require the loaders to be looked up
+  // again, which games do frequently.
   case 0x50:
-    state->vtx_desc.Hex &= ~0x1FFFF;  // keep the Upper bits
-    state->vtx_desc.Hex |= value;
-    state->attr_dirty = BitSet32::AllTrue(8);
-    state->bases_dirty = true;
+  {
+    // keep the Upper bits
+    const u64 vtx_desc = (state->vtx_desc.Hex & ~0x1FFFF) | value;
+    if (state->vtx_desc.Hex != vtx_desc)
+    {
+      state->vtx_desc.Hex = vtx_desc;
+      state->attr_dirty = BitSet32::AllTrue(8);
+      state->bases_dirty = true;
+    }
     break;
+  }
 
   case 0x60:
-    state->vtx_desc.Hex &= 0x1FFFF;  // keep the lower 17Bits
-    state->vtx_desc.Hex |= (u64)value << 17;
-    state->attr_dirty = BitSet32::AllTrue(8);
-    state->bases_dirty = true;
+  {
+    // keep the lower 17Bits
+    const u64 vtx_desc = (state->vtx_desc.Hex & 0x1FFFF) | ((u64)value << 17);
+    if (state->vtx_desc.Hex != vtx_desc)
+    {
+      state->vtx_desc.Hex = vtx_desc;
+      state->attr_dirty = BitSet32::AllTrue(8);
+      state->bases_dirty = true;
+    }
     break;
+  }
 
   case 0x70:
     ASSERT((sub_cmd & 0x0F) < 8);
-    state->vtx_attr[sub_cmd & 7].g0.Hex = value;
-    state->attr_dirty[sub_cmd & 7] = true;
+    if (state->vtx_attr[sub_cmd & 7].g0.Hex != value)
+    {
+      state->vtx_attr[sub_cmd & 7].g0.Hex = value;
+      state->attr_dirty[sub_cmd & 7] = true;
+    }
     break;
 
   case 0x80:
     ASSERT((sub_cmd & 0x0F) < 8);
-    state->vtx_attr[sub_cmd & 7].g1.Hex = value;
-    state->attr_dirty[sub_cmd & 7] = true;
+    if (state->vtx_attr[sub_cmd & 7].g1.Hex != value)
+    {
+      state->vtx_attr[sub_cmd & 7].g1.Hex = value;
+      state->attr_dirty[sub_cmd & 7] = true;
+    }
     break;
 
   case 0x90:
     ASSERT((sub_cmd & 0x0F) < 8);
-    state->vtx_attr[sub_cmd & 7].g2.Hex = value;
-    state->attr_dirty[sub_cmd & 7] = true;
+    if (state->vtx_attr[sub_cmd & 7].g2.Hex != value)
+    {
+      state->vtx_attr[sub_cmd & 7].g2.Hex = value;
+      state->attr_dirty[sub_cmd & 7] = true;
+    }
     break;
 
   // Pointers to vertex arrays in GC RAM
   case 0xA0:
-    state->array_bases[sub_cmd & 0xF] = value;
-    state->bases_dirty = true;
+    if (state->array_bases[sub_cmd & 0xF] != value)
+    {
+      state->array_bases[sub_cmd & 0xF] = value;
+      state->bases_dirty = true;
+    }
     break;
 
   case 0xB0:
@@ -55,6 +55,23 @@ VertexLoaderX64::VertexLoaderX64(const TVtxDesc& vtx_desc, const VAT& vtx_att)
   JitRegister::Register(region, GetCodePtr(), name.c_str());
 }
 
+OpArg VertexLoaderX64::GetConstant(const void* ptr)
+{
+  for (const auto& constant : m_constants)
+  {
+    if (constant.first == ptr)
+      return R(constant.second);
+  }
+
+  // XMM0 and XMM1 are used for the vertex data itself.
+  const X64Reg reg = static_cast<X64Reg>(XMM2 + m_constants.size());
+  if (reg > XMM15)
+    return MPIC(ptr);
+
+  m_constants.emplace_back(ptr, reg);
+  return R(reg);
+}
+
 OpArg VertexLoaderX64::GetVertexAddr(int array, u64 attribute)
 {
   OpArg data = MDisp(src_reg, m_src_ofs);
@@ -139,7 +156,7 @@ int VertexLoaderX64::ReadVertex(OpArg data, u64 attribute, int format, int count
     else
       MOVD_xmm(coords, data);
 
-    PSHUFB(coords, MPIC(&shuffle_lut[format][count_in - 1]));
+    PSHUFB(coords, GetConstant(&shuffle_lut[format][count_in - 1]));
 
     // Sign-extend.
     if (format == FORMAT_BYTE)
@@ -236,7 +253,7 @@ int VertexLoaderX64::ReadVertex(OpArg data, u64 attribute, int format, int count
     CVTDQ2PS(coords, R(coords));
 
     if (dequantize && scaling_exponent)
-      MULPS(coords, MPIC(&scale_factors[scaling_exponent]));
+      MULPS(coords, GetConstant(&scale_factors[scaling_exponent]));
   }
 
   switch (count_out)
@@ -386,24 +403,8 @@ void VertexLoaderX64::ReadColor(OpArg data, u64 attribute, int format)
 
 void VertexLoaderX64::GenerateVertexLoader()
 {
-  BitSet32 regs = {src_reg,  dst_reg,   scratch1,    scratch2,
-                   scratch3, count_reg, skipped_reg, base_reg};
-  regs &= ABI_ALL_CALLEE_SAVED;
-  ABI_PushRegistersAndAdjustStack(regs, 0);
-
-  // Backup count since we're going to count it down.
-  PUSH(32, R(ABI_PARAM3));
-
-  // ABI_PARAM3 is one of the lower registers, so free it for scratch2.
-  MOV(32, R(count_reg), R(ABI_PARAM3));
-
-  MOV(64, R(base_reg), R(ABI_PARAM4));
-
-  if (m_VtxDesc.Position & MASK_INDEXED)
-    XOR(32, R(skipped_reg), R(skipped_reg));
-
-  // TODO: load constants into registers outside the main loop
-
+  // The loop is generated first, so we know which constants it needs. The entry point that saves
+  // registers and loads those constants is emitted after it and jumps back to the loop.
   const u8* loop_start = GetCodePtr();
 
   if (m_VtxDesc.PosMatIdx)
@@ -532,6 +533,12 @@ void VertexLoaderX64::GenerateVertexLoader()
   SUB(32, R(count_reg), Imm8(1));
   J_CC(CC_NZ, loop_start);
 
+  BitSet32 regs = {src_reg,  dst_reg,   scratch1,    scratch2,
+                   scratch3, count_reg, skipped_reg, base_reg};
+  for (const auto& constant : m_constants)
+    regs[constant.second + 16] = true;
+  regs &= ABI_ALL_CALLEE_SAVED;
+
   // Get the original count.
   POP(32, R(ABI_RETURN));
 
@@ -551,6 +558,25 @@ void VertexLoaderX64::GenerateVertexLoader()
     RET();
   }
 
+  m_entry = GetCodePtr();
+  ABI_PushRegistersAndAdjustStack(regs, 0);
+
+  // Backup count since we're going to count it down.
+  PUSH(32, R(ABI_PARAM3));
+
+  // ABI_PARAM3 is one of the lower registers, so free it for scratch2.
+  MOV(32, R(count_reg), R(ABI_PARAM3));
+
+  MOV(64, R(base_reg), R(ABI_PARAM4));
+
+  if (m_VtxDesc.Position & MASK_INDEXED)
+    XOR(32, R(skipped_reg), R(skipped_reg));
+
+  for (const auto& constant : m_constants)
+    MOVAPS(constant.second, MPIC(constant.first));
+
+  JMP(loop_start, true);
+
   m_VertexSize = m_src_ofs;
   m_native_vtx_decl.stride = m_dst_ofs;
 }
@@ -558,6 +584,6 @@ void VertexLoaderX64::GenerateVertexLoader()
 int VertexLoaderX64::RunVertices(DataReader src, DataReader dst, int count)
 {
   m_numLoadedVertices += count;
-  return ((int (*)(u8*, u8*, int, const void*))region)(src.GetPointer(), dst.GetPointer(), count,
-                                                       memory_base_ptr);
+  return ((int (*)(u8*, u8*, int, const void*))m_entry)(src.GetPointer(), dst.GetPointer(),
+                                                        count, memory_base_ptr);
 }
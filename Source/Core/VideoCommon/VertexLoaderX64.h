@@ -2,6 +2,9 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <utility>
+#include <vector>
+
 #include "Common/CommonTypes.h"
 #include "Common/x64Emitter.h"
 #include "VideoCommon/VertexLoaderBase.h"
@@ -20,6 +23,10 @@ private:
   u32 m_src_ofs = 0;
   u32 m_dst_ofs = 0;
   Gen::FixupBranch m_skip_vertex;
+  const u8* m_entry = nullptr;
+  // Constants used in the loop, and the registers they are loaded into before entering it.
+  std::vector<std::pair<const void*, Gen::X64Reg>> m_constants;
+  Gen::OpArg GetConstant(const void* ptr);
   Gen::OpArg GetVertexAddr(int array, u64 attribute);
   int ReadVertex(Gen::OpArg data, u64 attribute, int format, int count_in, int count_out,
                  bool dequantize, u8 scaling_exponent, AttributeFormat* native_format);
@@ -13,9 +13,11 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
+#include "Common/Profiler.h"
 
 #include "Core/ConfigManager.h"
 
+#include "VideoCommon/BPFunctions.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/Debugger.h"
@@ -27,6 +29,7 @@
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/SamplerCommon.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexShaderManager.h"
@@ -274,6 +277,12 @@ void VertexManagerBase::Flush()
   if (m_is_flushed)
     return;
 
+  PROFILE("VertexManagerBase::Flush");
+  INCSTAT(stats.thisFrame.numFlushes);
+
+  // Assume the EFB is modified by any batch of primitives.
+  g_renderer->IncrementEFBGeneration();
+
   // loading a state will invalidate BP, so check for it
   g_video_backend->CheckInvalidState();
 
@@ -384,9 +393,16 @@ void VertexManagerBase::Flush()
 
   if (!m_cull_all)
   {
+    // Draws which leave the color data alone don't need it in the current format
+    if (bpmem.blendmode.colorupdate || bpmem.blendmode.alphaupdate)
+      BPFunctions::ResolvePixelFormatChange();
+
     // Update the pipeline, or compile one if needed.
+    const AbstractPipeline* previous_pipeline = m_current_pipeline_object;
     UpdatePipelineConfig();
     UpdatePipelineObject();
+    if (m_current_pipeline_object != previous_pipeline)
+      INCSTAT(stats.thisFrame.numPipelineChanges);
 
     // set the rest of the global constants
     GeometryShaderManager::SetConstants();
@@ -482,6 +498,8 @@ void VertexManagerBase::CalculateZSlope(NativeVertexFormat* format)
 
 void VertexManagerBase::UpdatePipelineConfig()
 {
+  PROFILE("VertexManagerBase::UpdatePipelineConfig");
+
   NativeVertexFormat* vertex_format = VertexLoaderManager::GetCurrentVertexFormat();
   if (vertex_format != m_current_pipeline_config.vertex_format)
   {
@@ -597,9 +615,11 @@ void VertexManagerBase::UpdatePipelineObject()
 
     if (g_ActiveConfig.iShaderCompilationMode == ShaderCompilationMode::AsynchronousUberShaders)
     {
-      // Specialized shaders not ready, use the ubershaders.
+      // Specialized shaders not ready, use the ubershaders. Check again next draw, so that the
+      // specialized pipeline is used as soon as it has compiled.
       m_current_pipeline_object =
           g_shader_cache->GetUberPipelineForUid(m_current_uber_pipeline_config);
+      m_pipeline_config_changed = true;
     }
     else
     {
@@ -85,6 +85,8 @@ ShaderCode GenerateVertexShaderCode(APIType api_type, const ShaderHostConfig& ho
   const bool msaa = host_config.msaa;
   const bool ssaa = host_config.ssaa;
   const bool vertex_rounding = host_config.vertex_rounding;
+  const bool vs_stereo = host_config.stereo && host_config.backend_vs_layer_output;
+  const bool vs_point_size = api_type == APIType::OpenGL && host_config.backend_vs_point_size;
 
   out.Write("%s", s_lighting_struct);
 
@@ -97,6 +99,10 @@ ShaderCode GenerateVertexShaderCode(APIType api_type, const ShaderHostConfig& ho
   out.Write(s_shader_uniforms);
   out.Write("};\n");
 
+  // The stereo and point size parameters are the ones the geometry shaders use
+  if (vs_stereo || vs_point_size)
+    out.Write("UBO_BINDING(std140, 3) uniform GSBlock {\n%s};\n", s_geometry_shader_uniforms);
+
   out.Write("struct VS_OUTPUT {\n");
   GenerateVSOutputMembers(out, api_type, uid_data->numTexGens, per_pixel_lighting, "");
   out.Write("};\n");
@@ -134,6 +140,8 @@ ShaderCode GenerateVertexShaderCode(APIType api_type, const ShaderHostConfig& ho
       out.Write("VARYING_LOCATION(0) out VertexData {\n");
       GenerateVSOutputMembers(out, api_type, uid_data->numTexGens, per_pixel_lighting,
                               GetInterpolationQualifier(msaa, ssaa, true, false));
+      if (vs_stereo)
+        out.Write("\tflat int layer;\n");
       out.Write("} vs;\n");
     }
     else
@@ -483,11 +491,22 @@ ShaderCode GenerateVertexShaderCode(APIType api_type, const ShaderHostConfig& ho
     out.Write("}\n");
   }
 
+  if (vs_stereo)
+  {
+    // Each primitive is drawn twice, as one instance for each eye. The horizontal offset is the
+    // same as the one geometry shaders add in stereo mode.
+    out.Write("int eye = gl_InstanceID;\n");
+    out.Write("o.pos.x += ((eye == 0) ? " I_STEREOPARAMS ".x : " I_STEREOPARAMS ".y) * (o.pos.w - "
+              I_STEREOPARAMS ".z);\n");
+  }
+
   if (api_type == APIType::OpenGL || api_type == APIType::Vulkan)
   {
     if (host_config.backend_geometry_shaders || api_type == APIType::Vulkan)
     {
       AssignVSOutputMembers(out, "vs", "o", uid_data->numTexGens, per_pixel_lighting);
+      if (vs_stereo)
+        out.Write("vs.layer = eye;\ngl_Layer = eye;\n");
     }
     else
     {
@@ -516,6 +535,10 @@ ShaderCode GenerateVertexShaderCode(APIType api_type, const ShaderHostConfig& ho
       out.Write("gl_Position = float4(o.pos.x, -o.pos.y, o.pos.z, o.pos.w);\n");
     else
       out.Write("gl_Position = o.pos;\n");
+
+    // Points are sized here instead of being expanded to quads by a geometry shader
+    if (vs_point_size)
+      out.Write("gl_PointSize = " I_LINEPTPARAMS ".w * " I_EFBSCALE ".x;\n");
   }
   else  // D3D
   {
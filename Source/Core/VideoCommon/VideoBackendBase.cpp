@@ -5,6 +5,7 @@
 #include "VideoCommon/VideoBackendBase.h"
 
 #include <algorithm>
+#include <array>
 #include <cstring>
 #include <memory>
 #include <string>
@@ -48,6 +49,8 @@
 std::vector<std::unique_ptr<VideoBackendBase>> g_available_video_backends;
 VideoBackendBase* g_video_backend = nullptr;
 static VideoBackendBase* s_default_backend = nullptr;
+// The results of the last perf queries which were read once all of them had finished
+static std::array<u32, PQ_NUM_MEMBERS> s_last_query_results;
 
 #ifdef _WIN32
 #include <windows.h>
@@ -134,10 +137,26 @@ u32 VideoBackendBase::Video_GetQueryResult(PerfQueryType type)
     return 0;
   }
 
-  Fifo::SyncGPU(Fifo::SyncGPUReason::PerfQuery);
-
   AsyncRequests::Event e;
   e.time = 0;
+
+  if (g_ActiveConfig.bPerfQueriesNonBlocking)
+  {
+    // Neither the GPU thread nor the host GPU is waited for. Until the pending queries are in,
+    // the counters only hold part of the result, so the last complete one is used as an estimate.
+    if (g_perf_query->IsFlushed())
+    {
+      s_last_query_results[type] = g_perf_query->GetQueryResult(type);
+      return s_last_query_results[type];
+    }
+
+    e.type = AsyncRequests::Event::PERF_QUERY_POLL;
+    AsyncRequests::GetInstance()->PushEvent(e, false);
+    return std::max(g_perf_query->GetQueryResult(type), s_last_query_results[type]);
+  }
+
+  Fifo::SyncGPU(Fifo::SyncGPUReason::PerfQuery);
+
   e.type = AsyncRequests::Event::PERF_QUERY;
 
   if (!g_perf_query->IsFlushed())
@@ -264,7 +283,7 @@ void VideoBackendBase::CheckInvalidState()
     m_invalid = false;
 
     BPReload();
-    g_texture_cache->Invalidate();
+    g_texture_cache->InvalidateCopies();
   }
 }
 
@@ -60,6 +60,7 @@ struct VideoConfig final
 
   // General
   bool bVSync;
+  bool bLowLatencyPresent;
   bool bWidescreenHack;
   AspectMode aspect_mode;
   bool bCrop;  // Aspect ratio controls.
@@ -69,6 +70,7 @@ struct VideoConfig final
   u32 iMultisamples;
   bool bSSAA;
   int iEFBScale;
+  bool bDynamicResolution;
   bool bForceFiltering;
   int iMaxAnisotropy;
   std::string sPostProcessingShader;
@@ -81,6 +83,7 @@ struct VideoConfig final
   bool bShowNetPlayMessages;
   bool bOverlayStats;
   bool bOverlayProjStats;
+  bool bOverlayTimings;
   bool bTexFmtOverlayEnable;
   bool bTexFmtOverlayCenter;
   bool bLogRenderTimeToFile;
@@ -93,6 +96,9 @@ struct VideoConfig final
   bool bDumpTextures;
   bool bHiresTextures;
   bool bCacheHiresTextures;
+  bool bStreamHiresTextures;
+  int iHiresTextureStreamingBudget;  // in MiB
+  int iTextureCacheBudget;           // in MiB, 0 for no limit
   bool bDumpEFBTarget;
   bool bDumpXFBTarget;
   bool bDumpFramesAsImages;
@@ -106,16 +112,21 @@ struct VideoConfig final
   bool bBorderlessFullscreen;
   bool bEnableGPUTextureDecoding;
   int iBitrateKbps;
+  int iPNGCompressionLevel;  // 0 (uncompressed, fastest) to 9, for image and texture dumps
 
   // Hacks
   bool bEFBAccessEnable;
   bool bPerfQueriesEnable;
+  // Approximate the results instead of waiting for the host GPU, for games which only use them as
+  // hints
+  bool bPerfQueriesNonBlocking;
   bool bBBoxEnable;
   bool bBBoxPreferStencilImplementation;  // OpenGL-only, to see how slow it is compared to SSBOs
   bool bForceProgressive;
 
   bool bEFBEmulateFormatChanges;
   bool bSkipEFBCopyToRam;
+  bool bDeferEFBCopies;
   bool bSkipXFBCopyToRam;
   bool bDisableCopyToVRAM;
   bool bImmediateXFB;
@@ -169,6 +180,16 @@ struct VideoConfig final
   int iShaderCompilerThreads;
   int iShaderPrecompilerThreads;
 
+  // Number of extra threads that large textures are decoded on, in addition to the GPU thread.
+  // 0 decodes on the GPU thread only.
+  // -1 uses an automatic number based on the CPU threads.
+  int iTextureDecodingThreads;
+
+  // Number of extra threads that the software renderer rasterizes large triangles on.
+  // 0 rasterizes on the GPU thread only.
+  // -1 uses an automatic number based on the CPU threads.
+  int iSWRasterizerThreads;
+
   // Static config per API
   // TODO: Move this out of VideoConfig
   struct
@@ -182,6 +203,8 @@ struct VideoConfig final
     std::string AdapterName;  // for OpenGL
 
     u32 MaxTextureSize;
+    // Largest point size vertex shaders can set, or 0 if points need geometry shaders
+    u32 MaxPointSize;
 
     bool bSupportsExclusiveFullscreen;
     bool bSupportsDualSourceBlend;
@@ -194,6 +217,7 @@ struct VideoConfig final
     bool bSupportsBindingLayout;  // Needed by ShaderGen, so must stay in VideoCommon
     bool bSupportsBBox;
     bool bSupportsGSInstancing;  // Needed by GeometryShaderGen, so must stay in VideoCommon
+    bool bSupportsVSLayerOutput;  // Needed by VertexShaderGen, so must stay in VideoCommon
     bool bSupportsPostProcessing;
     bool bSupportsPaletteConversion;
     bool bSupportsClipControl;  // Needed by VertexShaderGen, so must stay in VideoCommon
@@ -230,9 +254,17 @@ struct VideoConfig final
     return backend_info.bSupportsGPUTextureDecoding && bEnableGPUTextureDecoding;
   }
   bool UseVertexRounding() const { return bVertexRounding && iEFBScale != 1; }
+  // Each primitive is drawn once per eye with instancing, and the vertex shader selects the layer,
+  // so only lines and points still need a geometry shader in stereo mode
+  bool UseVertexShaderStereo() const
+  {
+    return stereo_mode != StereoMode::Off && backend_info.bSupportsVSLayerOutput;
+  }
   bool UsingUberShaders() const;
   u32 GetShaderCompilerThreads() const;
   u32 GetShaderPrecompilerThreads() const;
+  u32 GetTextureDecodingThreads() const;
+  u32 GetSWRasterizerThreads() const;
 };
 
 extern VideoConfig g_Config;
@@ -2,6 +2,8 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
@@ -17,6 +19,19 @@
 #include "VideoCommon/VertexShaderManager.h"
 #include "VideoCommon/XFMemory.h"
 
+// Returns true if any of the count values at data_index in src differ from the current contents of
+// XF memory at address. Games often rewrite state with identical values, which needn't flush.
+static bool XFDataChanged(u32 address, u32 count, const DataReader& src, u32 data_index)
+{
+  const u32* current = reinterpret_cast<const u32*>(&xfmem) + address;
+  for (u32 i = 0; i < count; i++)
+  {
+    if (current[i] != src.Peek<u32>((data_index + i) * sizeof(u32)))
+      return true;
+  }
+  return false;
+}
+
 static void XFMemWritten(u32 transferSize, u32 baseAddress)
 {
   g_vertex_manager->Flush();
@@ -55,8 +70,10 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
 
     case XFMEM_SETNUMCHAN:
       if (xfmem.numChan.numColorChans != (newValue & 3))
+      {
         g_vertex_manager->Flush();
-      VertexShaderManager::SetLightingConfigChanged();
+        VertexShaderManager::SetLightingConfigChanged();
+      }
       break;
 
     case XFMEM_SETCHAN0_AMBCOLOR:  // Channel Ambient Color
@@ -89,13 +106,18 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETCHAN1_ALPHA:
       if (((u32*)&xfmem)[address] != (newValue & 0x7fff))
         g_vertex_manager->Flush();
-      VertexShaderManager::SetLightingConfigChanged();
+      // The shader constants hold the whole register, so only rewriting the same value can skip
+      // rebuilding them
+      if (((u32*)&xfmem)[address] != newValue)
+        VertexShaderManager::SetLightingConfigChanged();
       break;
 
     case XFMEM_DUALTEX:
       if (xfmem.dualTexTrans.enabled != (newValue & 1))
+      {
         g_vertex_manager->Flush();
-      VertexShaderManager::SetTexMatrixInfoChanged(-1);
+        VertexShaderManager::SetTexMatrixInfoChanged(-1);
+      }
       break;
 
     case XFMEM_SETMATRIXINDA:
@@ -111,10 +133,14 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETVIEWPORT + 3:
     case XFMEM_SETVIEWPORT + 4:
     case XFMEM_SETVIEWPORT + 5:
-      g_vertex_manager->Flush();
-      VertexShaderManager::SetViewportChanged();
-      PixelShaderManager::SetViewportChanged();
-      GeometryShaderManager::SetViewportChanged();
+      if (XFDataChanged(address, std::min<u32>(XFMEM_SETVIEWPORT + 6 - address, transferSize), src,
+                        dataIndex))
+      {
+        g_vertex_manager->Flush();
+        VertexShaderManager::SetViewportChanged();
+        PixelShaderManager::SetViewportChanged();
+        GeometryShaderManager::SetViewportChanged();
+      }
 
       nextAddress = XFMEM_SETVIEWPORT + 6;
       break;
@@ -126,9 +152,13 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETPROJECTION + 4:
     case XFMEM_SETPROJECTION + 5:
     case XFMEM_SETPROJECTION + 6:
-      g_vertex_manager->Flush();
-      VertexShaderManager::SetProjectionChanged();
-      GeometryShaderManager::SetProjectionChanged();
+      if (XFDataChanged(address, std::min<u32>(XFMEM_SETPROJECTION + 7 - address, transferSize),
+                        src, dataIndex))
+      {
+        g_vertex_manager->Flush();
+        VertexShaderManager::SetProjectionChanged();
+        GeometryShaderManager::SetProjectionChanged();
+      }
 
       nextAddress = XFMEM_SETPROJECTION + 7;
       break;
@@ -146,8 +176,12 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETTEXMTXINFO + 5:
     case XFMEM_SETTEXMTXINFO + 6:
     case XFMEM_SETTEXMTXINFO + 7:
-      g_vertex_manager->Flush();
-      VertexShaderManager::SetTexMatrixInfoChanged(address - XFMEM_SETTEXMTXINFO);
+      if (XFDataChanged(address, std::min<u32>(XFMEM_SETTEXMTXINFO + 8 - address, transferSize),
+                        src, dataIndex))
+      {
+        g_vertex_manager->Flush();
+        VertexShaderManager::SetTexMatrixInfoChanged(address - XFMEM_SETTEXMTXINFO);
+      }
 
       nextAddress = XFMEM_SETTEXMTXINFO + 8;
       break;
@@ -160,8 +194,12 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETPOSMTXINFO + 5:
     case XFMEM_SETPOSMTXINFO + 6:
     case XFMEM_SETPOSMTXINFO + 7:
-      g_vertex_manager->Flush();
-      VertexShaderManager::SetTexMatrixInfoChanged(address - XFMEM_SETPOSMTXINFO);
+      if (XFDataChanged(address, std::min<u32>(XFMEM_SETPOSMTXINFO + 8 - address, transferSize),
+                        src, dataIndex))
+      {
+        g_vertex_manager->Flush();
+        VertexShaderManager::SetTexMatrixInfoChanged(address - XFMEM_SETPOSMTXINFO);
+      }
 
       nextAddress = XFMEM_SETPOSMTXINFO + 8;
       break;
@@ -235,7 +273,8 @@ void LoadXFReg(u32 transferSize, u32 baseAddress, DataReader src)
       transferSize = 0;
     }
 
-    XFMemWritten(xfMemTransferSize, xfMemBase);
+    if (XFDataChanged(xfMemBase, xfMemTransferSize, src, 0))
+      XFMemWritten(xfMemTransferSize, xfMemBase);
     for (u32 i = 0; i < xfMemTransferSize; i++)
     {
       ((u32*)&xfmem)[xfMemBase + i] = src.Read<u32>();
@@ -0,0 +1,38 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Builds a texture pack (.dtp) from a directory of loose custom textures, so that it can be
+// memory-mapped by HiresTexture instead of loading and decoding thousands of files.
+
+#include <cstdio>
+#include <cstring>
+
+#include "VideoCommon/HiresTextures.h"
+#include "VideoCommon/VideoConfig.h"
+
+int main(int argc, const char* argv[])
+{
+  if (argc != 3 || !strcmp(argv[1], "--help") || !strcmp(argv[1], "-?"))
+  {
+    printf("USAGE: TexturePackTool <TEXTURE DIRECTORY> <OUTPUT FILE>\n");
+    printf("Packs all custom textures (.png and .dds, including mipmaps) in the directory into a\n"
+           "single texture pack. DDS textures keep their compressed format; PNG textures are\n"
+           "stored as RGBA8. Place the pack in the game's texture directory to use it.\n");
+    return argc == 1 ? 0 : 1;
+  }
+
+  // The pack is built for any backend, so let the DDS loader accept all compressed formats.
+  // Backends that don't support a format will skip those textures when loading the pack.
+  g_ActiveConfig.backend_info.bSupportsST3CTextures = true;
+  g_ActiveConfig.backend_info.bSupportsBPTCTextures = true;
+
+  if (!HiresTexture::BuildTexturePack(argv[1], argv[2]))
+  {
+    fprintf(stderr, "Failed to build texture pack %s from %s\n", argv[2], argv[1]);
+    return 1;
+  }
+
+  printf("Texture pack %s built successfully!\n", argv[2]);
+  return 0;
+}
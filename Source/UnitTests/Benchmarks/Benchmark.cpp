@@ -0,0 +1,229 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// dolphin-benchmarks [--list] [--filter=<substring>] [--repetitions=<count>]
+//                    [--min-time=<ms>] [--baseline=<results.csv>] [--threshold=<percent>]
+//
+// Runs the selected benchmarks and prints one CSV line per benchmark to stdout. The output of a
+// previous run can be passed as --baseline, in which case the exit code is 1 if the median time
+// of any benchmark got worse by more than the threshold (5% by default).
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
+#include "Common/StringUtil.h"
+#include "Core/ConfigManager.h"
+#include "UICommon/UICommon.h"
+
+namespace Benchmark
+{
+namespace
+{
+struct Entry
+{
+  std::string name;
+  u64 bytes_per_iteration;
+  Setup setup;
+};
+
+struct Options
+{
+  bool list = false;
+  std::string filter;
+  int repetitions = 5;
+  int min_time_ms = 100;
+  std::string baseline;
+  double threshold = 5.0;
+};
+
+struct Result
+{
+  u64 iterations;
+  double median_ns;
+  double min_ns;
+  double max_ns;
+};
+
+std::vector<Entry>& Entries()
+{
+  static std::vector<Entry> entries;
+  return entries;
+}
+
+volatile u64 s_sink;
+
+double TimeIterations(const Function& function, u64 iterations)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (u64 i = 0; i < iterations; i++)
+    function();
+  const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+Result Run(const Function& function, const Options& options)
+{
+  // Warm up the caches and pick the iteration count from the first run
+  const double target_ns = options.min_time_ms * 1e6;
+  const double first_ns = std::max(TimeIterations(function, 1), 1.0);
+  const u64 iterations = std::max<u64>(1, static_cast<u64>(target_ns / first_ns));
+
+  std::vector<double> per_iteration_ns;
+  for (int i = 0; i < options.repetitions; i++)
+    per_iteration_ns.push_back(TimeIterations(function, iterations) / iterations);
+  std::sort(per_iteration_ns.begin(), per_iteration_ns.end());
+
+  return {iterations, per_iteration_ns[per_iteration_ns.size() / 2], per_iteration_ns.front(),
+          per_iteration_ns.back()};
+}
+
+// Returns the median time of each benchmark of a previous run
+std::map<std::string, double> LoadBaseline(const std::string& path)
+{
+  std::map<std::string, double> baseline;
+  std::ifstream file;
+  File::OpenFStream(file, path, std::ios_base::in);
+  std::string line;
+  while (std::getline(file, line))
+  {
+    const std::vector<std::string> fields = SplitString(line, ',');
+    if (fields.size() >= 3 && fields[0] != "name")
+      baseline[fields[0]] = std::strtod(fields[2].c_str(), nullptr);
+  }
+  return baseline;
+}
+
+bool ParseOptions(int argc, char** argv, Options* options)
+{
+  for (int i = 1; i < argc; i++)
+  {
+    const std::string arg = argv[i];
+    const size_t equals = arg.find('=');
+    const std::string key = arg.substr(0, equals);
+    const std::string value = equals == std::string::npos ? "" : arg.substr(equals + 1);
+
+    if (key == "--list")
+      options->list = true;
+    else if (key == "--filter")
+      options->filter = value;
+    else if (key == "--repetitions" && TryParse(value, &options->repetitions))
+      options->repetitions = std::max(options->repetitions, 1);
+    else if (key == "--min-time" && TryParse(value, &options->min_time_ms))
+      options->min_time_ms = std::max(options->min_time_ms, 1);
+    else if (key == "--baseline")
+      options->baseline = value;
+    else if (key != "--threshold" || !TryParse(value, &options->threshold))
+      return false;
+  }
+  return true;
+}
+
+int RunBenchmarks(const Options& options)
+{
+  std::vector<const Entry*> selected;
+  for (const Entry& entry : Entries())
+  {
+    if (entry.name.find(options.filter) != std::string::npos)
+      selected.push_back(&entry);
+  }
+  std::sort(selected.begin(), selected.end(),
+            [](const Entry* a, const Entry* b) { return a->name < b->name; });
+
+  if (options.list)
+  {
+    for (const Entry* entry : selected)
+      std::printf("%s\n", entry->name.c_str());
+    return 0;
+  }
+
+  const std::map<std::string, double> baseline =
+      options.baseline.empty() ? std::map<std::string, double>() : LoadBaseline(options.baseline);
+  int regressions = 0;
+
+  std::printf("name,iterations,median_ns,min_ns,max_ns,mb_per_s\n");
+  for (const Entry* entry : selected)
+  {
+    const Result result = Run(entry->setup(), options);
+    const double mb_per_s = entry->bytes_per_iteration * 1e3 / result.median_ns;
+    std::printf("%s,%" PRIu64 ",%.1f,%.1f,%.1f,%.1f\n", entry->name.c_str(), result.iterations,
+                result.median_ns, result.min_ns, result.max_ns, mb_per_s);
+    std::fflush(stdout);
+
+    const auto base = baseline.find(entry->name);
+    if (base != baseline.end() && base->second > 0)
+    {
+      const double change = (result.median_ns - base->second) * 100.0 / base->second;
+      if (change > options.threshold)
+      {
+        std::fprintf(stderr, "Regression: %s is %.1f%% slower\n", entry->name.c_str(), change);
+        regressions++;
+      }
+    }
+  }
+  return regressions ? 1 : 0;
+}
+}  // Anonymous namespace
+
+void Register(std::string name, u64 bytes_per_iteration, Setup setup)
+{
+  Entries().push_back({std::move(name), bytes_per_iteration, std::move(setup)});
+}
+
+std::vector<u8> MakeInput(size_t size)
+{
+  std::vector<u8> data(size);
+  u32 state = 0x12345678;
+  for (u8& byte : data)
+  {
+    state = state * 1664525 + 1013904223;
+    byte = static_cast<u8>(state >> 24);
+  }
+  return data;
+}
+
+void Consume(u64 value)
+{
+  s_sink = s_sink + value;
+}
+}  // namespace Benchmark
+
+int main(int argc, char** argv)
+{
+  Benchmark::Options options;
+  if (!Benchmark::ParseOptions(argc, argv, &options))
+  {
+    std::fprintf(stderr, "Usage: %s [--list] [--filter=<substring>] [--repetitions=<count>] "
+                         "[--min-time=<ms>] [--baseline=<results.csv>] [--threshold=<percent>]\n",
+                 argv[0]);
+    return 2;
+  }
+
+  // Keep the benchmarks away from the user's configuration
+  const std::string user_directory = File::CreateTempDir();
+  UICommon::SetUserDirectory(user_directory);
+  Config::Init();
+  SConfig::Init();
+  Common::SetHash64Function();
+
+  const int result = Benchmark::RunBenchmarks(options);
+
+  SConfig::Shutdown();
+  Config::Shutdown();
+  File::DeleteDirRecursively(user_directory);
+  return result;
+}
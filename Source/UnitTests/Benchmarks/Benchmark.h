@@ -0,0 +1,39 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// A minimal microbenchmark harness for dolphin-benchmarks. Each benchmark is a function which is
+// run repeatedly; the runner picks the iteration count, repeats the measurement and prints the
+// results as CSV.
+namespace Benchmark
+{
+using Function = std::function<void()>;
+// Prepares the data of a benchmark and returns the function to time. It is only called if the
+// benchmark is selected, so expensive setups don't slow down filtered runs.
+using Setup = std::function<Function()>;
+
+// bytes_per_iteration is the amount of input data each iteration processes, for the throughput
+// column, or 0 if that isn't meaningful.
+void Register(std::string name, u64 bytes_per_iteration, Setup setup);
+
+// Registers benchmarks at static initialization time, from each benchmark file
+struct Registrar
+{
+  explicit Registrar(void (*register_benchmarks)()) { register_benchmarks(); }
+};
+
+// Returns varied but reproducible data, as input for the benchmarks
+std::vector<u8> MakeInput(size_t size);
+
+// Keeps the compiler from optimizing away results which are otherwise unused
+void Consume(u64 value);
+}  // namespace Benchmark
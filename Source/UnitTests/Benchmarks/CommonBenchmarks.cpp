@@ -0,0 +1,34 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+
+#include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+
+namespace
+{
+void RegisterBenchmarks()
+{
+  // Typical texture sizes, hashed fully and with the default number of safe texture cache samples
+  for (u32 size : {4096u, 65536u, 1048576u})
+  {
+    for (u32 samples : {0u, 128u})
+    {
+      const std::string name = "GetHash64/" + std::to_string(size / 1024) + "KiB" +
+                               (samples ? "/" + std::to_string(samples) + "Samples" : "");
+      Benchmark::Register(name, samples ? 0 : size, [=] {
+        auto data = std::make_shared<std::vector<u8>>(Benchmark::MakeInput(size));
+        return [=] { Benchmark::Consume(Common::GetHash64(data->data(), size, samples)); };
+      });
+    }
+  }
+}
+
+Benchmark::Registrar s_registrar(RegisterBenchmarks);
+}  // Anonymous namespace
@@ -0,0 +1,102 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <memory>
+
+#include "Benchmark.h"
+
+#include "Common/CommonTypes.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
+#include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PowerPC.h"
+
+namespace
+{
+constexpr u32 CODE_ADDRESS = 0x00010000;
+constexpr u32 BLOCK_COUNT = 16;
+constexpr u32 BLOCK_SIZE = 33 * sizeof(u32);
+
+// A mix of integer, load/store and floating point instructions, ending with a blr
+constexpr u32 BLOCK_BODY[] = {
+    0x38630001,  // addi r3, r3, 1
+    0x5464103A,  // rlwinm r4, r3, 2, 0, 29
+    0x80A10008,  // lwz r5, 8(r1)
+    0x90A1000C,  // stw r5, 12(r1)
+    0x7CC42A14,  // add r6, r4, r5
+    0xFC21102A,  // fadd f1, f1, f2
+    0xFC6100B2,  // fmul f3, f1, f2
+    0x2C030064,  // cmpwi r3, 100
+};
+
+// Runs a CPU core in real mode on the current thread, with the blocks in MEM1
+class CPUEnvironment final
+{
+public:
+  explicit CPUEnvironment(PowerPC::CPUCore core)
+  {
+    Core::DeclareAsCPUThread();
+    Memory::Init();
+    PowerPC::Init(core);
+    CoreTiming::Init();
+    MSR.FP = 1;
+
+    for (u32 block = 0; block < BLOCK_COUNT; block++)
+    {
+      u32 address = CODE_ADDRESS + block * BLOCK_SIZE;
+      for (int i = 0; i < 4; i++)
+      {
+        for (u32 instruction : BLOCK_BODY)
+        {
+          Memory::Write_U32(instruction, address);
+          address += sizeof(u32);
+        }
+      }
+      Memory::Write_U32(0x4E800020, address);  // blr
+    }
+  }
+  ~CPUEnvironment()
+  {
+    CoreTiming::Shutdown();
+    PowerPC::Shutdown();
+    Memory::Shutdown();
+    Core::UndeclareAsCPUThread();
+  }
+};
+
+void RegisterBenchmarks()
+{
+  Benchmark::Register("Interpreter/RunBlocks", 0, [] {
+    auto environment = std::make_shared<CPUEnvironment>(PowerPC::CORE_INTERPRETER);
+    return [environment] {
+      // Each iteration runs as many instructions as the blocks contain. As the blr at the end of
+      // a block returns to the first one, that one is run repeatedly.
+      PC = CODE_ADDRESS;
+      LR = CODE_ADDRESS;
+      for (u32 i = 0; i < BLOCK_COUNT * BLOCK_SIZE / sizeof(u32); i++)
+        Interpreter::getInstance()->SingleStepInner();
+    };
+  });
+
+#ifdef _M_X86_64
+  Benchmark::Register("Jit64/CompileBlocks", 0, [] {
+    auto environment = std::make_shared<CPUEnvironment>(PowerPC::CORE_JIT64);
+    return [environment] {
+      // Each iteration destroys and recompiles all of the blocks
+      for (u32 block = 0; block < BLOCK_COUNT; block++)
+      {
+        const u32 address = CODE_ADDRESS + block * BLOCK_SIZE;
+        JitInterface::InvalidateICache(address, BLOCK_SIZE, true);
+        g_jit->Jit(address);
+      }
+    };
+  });
+#endif
+}
+
+Benchmark::Registrar s_registrar(RegisterBenchmarks);
+}  // Anonymous namespace
@@ -0,0 +1,88 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "DiscIO/Blob.h"
+
+namespace
+{
+constexpr u64 IMAGE_SIZE = 32 * 1024 * 1024;
+constexpr u64 SEQUENTIAL_READ_SIZE = 128 * 1024;
+constexpr u64 RANDOM_READ_SIZE = 2048;
+constexpr int RANDOM_READ_COUNT = 256;
+
+// A GCZ image in a temporary directory, which is deleted with it
+class CompressedImage final
+{
+public:
+  CompressedImage() : m_directory(File::CreateTempDir())
+  {
+    // Discs mix well compressible data, such as padding, with already compressed data
+    std::vector<u8> data = Benchmark::MakeInput(IMAGE_SIZE);
+    for (u64 offset = 0; offset < IMAGE_SIZE; offset += 2 * 16384)
+      std::memset(&data[offset], 0, 16384);
+
+    const std::string raw_path = m_directory + "/image.iso";
+    const std::string gcz_path = m_directory + "/image.gcz";
+    File::IOFile(raw_path, "wb").WriteBytes(data.data(), data.size());
+    DiscIO::CompressFileToBlob(raw_path, gcz_path, 0, 16384,
+                               [](const std::string&, float, void*) { return true; });
+    File::Delete(raw_path);
+    m_reader = DiscIO::CreateBlobReader(gcz_path);
+  }
+  ~CompressedImage()
+  {
+    m_reader.reset();
+    File::DeleteDirRecursively(m_directory);
+  }
+
+  DiscIO::BlobReader* GetReader() const { return m_reader.get(); }
+
+private:
+  std::string m_directory;
+  std::unique_ptr<DiscIO::BlobReader> m_reader;
+};
+
+void RegisterBenchmarks()
+{
+  Benchmark::Register("CompressedBlobReader/Sequential", IMAGE_SIZE, [] {
+    auto image = std::make_shared<CompressedImage>();
+    auto buffer = std::make_shared<std::vector<u8>>(SEQUENTIAL_READ_SIZE);
+    return [=] {
+      for (u64 offset = 0; offset < IMAGE_SIZE; offset += SEQUENTIAL_READ_SIZE)
+        image->GetReader()->Read(offset, SEQUENTIAL_READ_SIZE, buffer->data());
+      Benchmark::Consume((*buffer)[0]);
+    };
+  });
+
+  Benchmark::Register(
+      "CompressedBlobReader/Random", RANDOM_READ_SIZE * RANDOM_READ_COUNT, [] {
+        auto image = std::make_shared<CompressedImage>();
+        auto buffer = std::make_shared<std::vector<u8>>(RANDOM_READ_SIZE);
+        return [=] {
+          // The same reproducible offsets each iteration, spread over the whole image
+          u32 state = 1;
+          for (int i = 0; i < RANDOM_READ_COUNT; i++)
+          {
+            state = state * 1664525 + 1013904223;
+            const u64 offset = (state % (IMAGE_SIZE / RANDOM_READ_SIZE)) * RANDOM_READ_SIZE;
+            image->GetReader()->Read(offset, RANDOM_READ_SIZE, buffer->data());
+          }
+          Benchmark::Consume((*buffer)[0]);
+        };
+      });
+}
+
+Benchmark::Registrar s_registrar(RegisterBenchmarks);
+}  // Anonymous namespace
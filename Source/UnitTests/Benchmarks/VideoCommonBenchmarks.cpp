@@ -0,0 +1,184 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.h"
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/DataReader.h"
+#include "VideoCommon/IndexGenerator.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/VertexLoaderBase.h"
+#include "VideoCommon/VertexLoaderManager.h"
+
+namespace
+{
+using Benchmark::MakeInput;
+
+void RegisterTextureDecoderBenchmarks()
+{
+  constexpr int WIDTH = 512;
+  constexpr int HEIGHT = 512;
+
+  static const std::pair<TextureFormat, const char*> formats[] = {
+      {TextureFormat::I4, "I4"},         {TextureFormat::I8, "I8"},
+      {TextureFormat::IA4, "IA4"},       {TextureFormat::IA8, "IA8"},
+      {TextureFormat::RGB565, "RGB565"}, {TextureFormat::RGB5A3, "RGB5A3"},
+      {TextureFormat::RGBA8, "RGBA8"},   {TextureFormat::C4, "C4"},
+      {TextureFormat::C8, "C8"},         {TextureFormat::C14X2, "C14X2"},
+      {TextureFormat::CMPR, "CMPR"}};
+
+  for (const auto& format : formats)
+  {
+    const TextureFormat texformat = format.first;
+    const int size = TexDecoder_GetTextureSizeInBytes(WIDTH, HEIGHT, texformat);
+    Benchmark::Register(std::string("TexDecoder_Decode/") + format.second, size, [=] {
+      auto src = std::make_shared<std::vector<u8>>(MakeInput(size));
+      auto tlut = std::make_shared<std::vector<u8>>(MakeInput(16384 * 2));
+      auto dst = std::make_shared<std::vector<u8>>(WIDTH * HEIGHT * 4);
+      return [=] {
+        TexDecoder_Decode(dst->data(), src->data(), WIDTH, HEIGHT, texformat, tlut->data(),
+                          TLUTFormat::RGB5A3);
+      };
+    });
+  }
+}
+
+struct VertexLayout
+{
+  const char* name;
+  void (*configure)(TVtxDesc* desc, VAT* vat);
+};
+
+void RegisterVertexLoaderBenchmarks()
+{
+  constexpr int VERTEX_COUNT = 4096;
+
+  static const VertexLayout layouts[] = {
+      {"PositionFloat",
+       [](TVtxDesc* desc, VAT* vat) {
+         desc->Position = DIRECT;
+         vat->g0.PosElements = 1;
+         vat->g0.PosFormat = FORMAT_FLOAT;
+       }},
+      {"PositionShortIndexed16",
+       [](TVtxDesc* desc, VAT* vat) {
+         desc->Position = INDEX16;
+         vat->g0.PosElements = 1;
+         vat->g0.PosFormat = FORMAT_SHORT;
+         vat->g0.PosFrac = 8;
+       }},
+      {"PositionNormalColorTexCoord",
+       [](TVtxDesc* desc, VAT* vat) {
+         desc->Position = DIRECT;
+         desc->Normal = DIRECT;
+         desc->Color0 = DIRECT;
+         desc->Tex0Coord = DIRECT;
+         vat->g0.PosElements = 1;
+         vat->g0.PosFormat = FORMAT_FLOAT;
+         vat->g0.NormalFormat = FORMAT_FLOAT;
+         vat->g0.Color0Elements = 1;
+         vat->g0.Color0Comp = FORMAT_32B_8888;
+         vat->g0.Tex0CoordElements = 1;
+         vat->g0.Tex0CoordFormat = FORMAT_FLOAT;
+       }},
+      {"SkinnedIndexed8",
+       [](TVtxDesc* desc, VAT* vat) {
+         desc->PosMatIdx = 1;
+         desc->Tex0MatIdx = 1;
+         desc->Position = INDEX8;
+         desc->Normal = INDEX8;
+         desc->Color0 = INDEX8;
+         desc->Tex0Coord = INDEX8;
+         desc->Tex1Coord = INDEX8;
+         vat->g0.PosElements = 1;
+         vat->g0.PosFormat = FORMAT_SHORT;
+         vat->g0.PosFrac = 6;
+         vat->g0.NormalFormat = FORMAT_BYTE;
+         vat->g0.Color0Elements = 1;
+         vat->g0.Color0Comp = FORMAT_24B_888;
+         vat->g0.Tex0CoordElements = 1;
+         vat->g0.Tex0CoordFormat = FORMAT_USHORT;
+         vat->g0.Tex0Frac = 10;
+         vat->g1.Tex1CoordElements = 1;
+         vat->g1.Tex1CoordFormat = FORMAT_USHORT;
+         vat->g1.Tex1Frac = 10;
+       }},
+  };
+
+  for (const VertexLayout& layout : layouts)
+  {
+    TVtxDesc desc;
+    VAT vat;
+    std::memset(&desc, 0, sizeof(desc));
+    std::memset(&vat, 0, sizeof(vat));
+    layout.configure(&desc, &vat);
+    vat.g0.ByteDequant = true;
+
+    const u32 input_size = VertexLoaderBase::GetVertexSize(desc, vat) * VERTEX_COUNT;
+    Benchmark::Register(std::string("VertexLoader/") + layout.name, input_size, [=] {
+      std::shared_ptr<VertexLoaderBase> loader = VertexLoaderBase::CreateVertexLoader(desc, vat);
+      auto input = std::make_shared<std::vector<u8>>(MakeInput(input_size));
+      // The arrays are big enough for any 16 bit index and stride
+      auto arrays = std::make_shared<std::vector<u8>>(MakeInput(0x10000 * 16));
+      auto output = std::make_shared<std::vector<u8>>(loader->m_native_vtx_decl.stride *
+                                                      VERTEX_COUNT);
+      for (int i = 0; i < 12; i++)
+      {
+        VertexLoaderManager::cached_arraybases[i] = arrays->data();
+        g_main_cp_state.array_strides[i] = 16;
+      }
+
+      return [=] {
+        DataReader src(input->data(), input->data() + input->size());
+        DataReader dst(output->data(), output->data() + output->size());
+        Benchmark::Consume(loader->RunVertices(src, dst, VERTEX_COUNT));
+      };
+    });
+  }
+}
+
+void RegisterIndexGeneratorBenchmarks()
+{
+  constexpr u32 VERTEX_COUNT = 0x8000;
+
+  static const std::pair<int, const char*> primitives[] = {
+      {OpcodeDecoder::GX_DRAW_QUADS, "Quads"},
+      {OpcodeDecoder::GX_DRAW_TRIANGLES, "Triangles"},
+      {OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP, "TriangleStrip"},
+      {OpcodeDecoder::GX_DRAW_TRIANGLE_FAN, "TriangleFan"},
+      {OpcodeDecoder::GX_DRAW_LINES, "Lines"}};
+
+  for (const auto& primitive : primitives)
+  {
+    const int type = primitive.first;
+    Benchmark::Register(std::string("IndexGenerator/") + primitive.second, 0, [=] {
+      IndexGenerator::Init();
+      // Quads and fans emit up to 6 indices per vertex with primitive restart
+      auto buffer = std::make_shared<std::vector<u16>>(VERTEX_COUNT * 6);
+      return [=] {
+        IndexGenerator::Start(buffer->data());
+        IndexGenerator::AddIndices(type, VERTEX_COUNT);
+        Benchmark::Consume(IndexGenerator::GetIndexLen());
+      };
+    });
+  }
+}
+
+void RegisterBenchmarks()
+{
+  RegisterTextureDecoderBenchmarks();
+  RegisterVertexLoaderBenchmarks();
+  RegisterIndexGeneratorBenchmarks();
+}
+
+Benchmark::Registrar s_registrar(RegisterBenchmarks);
+}  // Anonymous namespace
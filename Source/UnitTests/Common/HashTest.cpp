@@ -0,0 +1,62 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+
+class HashTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    Common::SetHash64Function();
+    m_data.resize(4096 + 13);
+    std::iota(m_data.begin(), m_data.end(), u8(0));
+  }
+
+  u64 Hash(u32 samples = 0) const
+  {
+    return Common::GetHash64(m_data.data(), static_cast<u32>(m_data.size()), samples);
+  }
+
+  std::vector<u8> m_data;
+};
+
+TEST_F(HashTest, SameDataSameHash)
+{
+  const u64 hash = Hash();
+  EXPECT_EQ(hash, Hash());
+  EXPECT_EQ(Hash(128), Hash(128));
+}
+
+TEST_F(HashTest, FullHashSeesEveryByte)
+{
+  const u64 hash = Hash();
+  for (size_t i = 0; i < m_data.size(); ++i)
+  {
+    m_data[i] ^= 0x10;
+    EXPECT_NE(hash, Hash()) << "Changing byte " << i << " didn't change the hash";
+    m_data[i] ^= 0x10;
+  }
+}
+
+TEST_F(HashTest, FullHashSeesReorderedBlocks)
+{
+  const u64 hash = Hash();
+  std::swap_ranges(m_data.begin(), m_data.begin() + 64, m_data.begin() + 64);
+  EXPECT_NE(hash, Hash());
+}
+
+TEST_F(HashTest, LengthChangesHash)
+{
+  const u64 hash = Hash();
+  m_data.push_back(0);
+  EXPECT_NE(hash, Hash());
+}
@@ -7,6 +7,8 @@
 #include <array>
 #include <bitset>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
@@ -347,3 +349,55 @@ TEST(CoreTiming, Overclocking)
   SConfig::GetInstance().m_OCFactor = 1.0;
   AdvanceAndCheck(4, MAX_SLICE_LENGTH);
 }
+
+namespace ManyEventsTest
+{
+static std::vector<std::pair<s64, u64>> s_fired;
+
+static void RecordCallback(u64 userdata, s64 lateness)
+{
+  s_fired.emplace_back(static_cast<s64>(CoreTiming::GetTicks()) - lateness, userdata);
+}
+}
+
+// Enough events to fill several levels of the queue, with plenty of ties and a removal.
+TEST(CoreTiming, ManyEvents)
+{
+  using namespace ManyEventsTest;
+
+  ScopeInit guard;
+
+  CoreTiming::EventType* cb_keep = CoreTiming::RegisterEvent("callbackKeep", RecordCallback);
+  CoreTiming::EventType* cb_remove = CoreTiming::RegisterEvent("callbackRemove", RecordCallback);
+
+  // Enter slice 0
+  CoreTiming::Advance();
+
+  s_fired.clear();
+  u32 seed = 12345;
+  for (u64 i = 0; i < 200; ++i)
+  {
+    seed = seed * 1103515245 + 12345;
+    CoreTiming::ScheduleEvent((seed >> 16) % 5000, i % 5 == 0 ? cb_remove : cb_keep, i);
+  }
+  CoreTiming::RemoveEvent(cb_remove);
+
+  for (int slices = 0; slices < 1000 && s_fired.size() < 160; ++slices)
+  {
+    PowerPC::ppcState.downcount = 0;
+    CoreTiming::Advance();
+  }
+
+  ASSERT_EQ(160u, s_fired.size());
+  for (size_t i = 0; i < s_fired.size(); ++i)
+  {
+    EXPECT_NE(0u, s_fired[i].second % 5);
+    if (i == 0)
+      continue;
+
+    // Events at the same time must run in the order they were scheduled.
+    EXPECT_LE(s_fired[i - 1].first, s_fired[i].first);
+    if (s_fired[i - 1].first == s_fired[i].first)
+      EXPECT_LT(s_fired[i - 1].second, s_fired[i].second);
+  }
+}
@@ -325,3 +325,47 @@ TEST_F(FileSystemTest, ReadDirectoryOnFile)
   ASSERT_FALSE(result.Succeeded());
   EXPECT_EQ(result.Error(), ResultCode::Invalid);
 }
+
+TEST_F(FileSystemTest, ReadDirectoryAfterChanges)
+{
+  using Listing = std::vector<std::string>;
+  ASSERT_EQ(m_fs->CreateDirectory(Uid{0}, Gid{0}, "/tmp/d", 0, modes), ResultCode::Success);
+  EXPECT_EQ(*m_fs->ReadDirectory(Uid{0}, Gid{0}, "/tmp/d"), Listing{});
+
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/tmp/d/f1", 0, modes), ResultCode::Success);
+  EXPECT_EQ(*m_fs->ReadDirectory(Uid{0}, Gid{0}, "/tmp/d"), Listing{"f1"});
+
+  ASSERT_EQ(m_fs->Rename(Uid{0}, Gid{0}, "/tmp/d/f1", "/tmp/d/f2"), ResultCode::Success);
+  EXPECT_EQ(*m_fs->ReadDirectory(Uid{0}, Gid{0}, "/tmp/d"), Listing{"f2"});
+
+  ASSERT_EQ(m_fs->Delete(Uid{0}, Gid{0}, "/tmp/d/f2"), ResultCode::Success);
+  EXPECT_EQ(*m_fs->ReadDirectory(Uid{0}, Gid{0}, "/tmp/d"), Listing{});
+  EXPECT_EQ(m_fs->GetMetadata(Uid{0}, Gid{0}, "/tmp/d/f2").Error(), ResultCode::NotFound);
+}
+
+// Small writes are coalesced, which must not be visible to the emulated software.
+TEST_F(FileSystemTest, SmallWrites)
+{
+  std::vector<u8> test_data(100);
+  for (size_t i = 0; i < test_data.size(); ++i)
+    test_data[i] = static_cast<u8>(i);
+
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/shared2/f", 0, modes), ResultCode::Success);
+  for (size_t i = 0; i < test_data.size(); i += 10)
+  {
+    const Result<FileHandle> file = m_fs->OpenFile(Uid{0}, Gid{0}, "/shared2/f", Mode::Write);
+    ASSERT_TRUE(file.Succeeded());
+    ASSERT_TRUE(file->Seek(static_cast<u32>(i), SeekMode::Set).Succeeded());
+    ASSERT_TRUE(file->Write(&test_data[i], 10).Succeeded());
+    EXPECT_EQ(m_fs->GetMetadata(Uid{0}, Gid{0}, "/shared2/f")->size, i + 10);
+  }
+  EXPECT_EQ(m_fs->GetDirectoryStats("/shared2")->used_inodes, 2u);
+
+  // The data must have been written by the time the file system is gone.
+  m_fs = IOS::HLE::Kernel{}.GetFS();
+  const Result<FileHandle> file = m_fs->OpenFile(Uid{0}, Gid{0}, "/shared2/f", Mode::Read);
+  ASSERT_TRUE(file.Succeeded());
+  std::vector<u8> read_buffer(test_data.size());
+  ASSERT_TRUE(file->Read(read_buffer.data(), read_buffer.size()).Succeeded());
+  EXPECT_EQ(test_data, read_buffer);
+}
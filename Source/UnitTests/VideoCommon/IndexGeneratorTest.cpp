@@ -0,0 +1,108 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/IndexGenerator.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace
+{
+constexpr u16 RESTART = 0xFFFF;
+
+void AddTriangle(std::vector<u16>* out, bool pr, u32 a, u32 b, u32 c)
+{
+  out->insert(out->end(), {u16(a), u16(b), u16(c)});
+  if (pr)
+    out->push_back(RESTART);
+}
+
+std::vector<u16> ReferenceIndices(int primitive, bool pr, u32 num_verts, u32 index)
+{
+  std::vector<u16> out;
+  switch (primitive)
+  {
+  case OpcodeDecoder::GX_DRAW_QUADS:
+  {
+    u32 i = 3;
+    for (; i < num_verts; i += 4)
+    {
+      const u32 q = index + i - 3;
+      if (pr)
+      {
+        out.insert(out.end(), {u16(q + 1), u16(q + 2), u16(q), u16(q + 3), RESTART});
+      }
+      else
+      {
+        AddTriangle(&out, pr, q, q + 1, q + 2);
+        AddTriangle(&out, pr, q, q + 2, q + 3);
+      }
+    }
+    if (i == num_verts)
+      AddTriangle(&out, pr, index + num_verts - 3, index + num_verts - 2, index + num_verts - 1);
+    break;
+  }
+  case OpcodeDecoder::GX_DRAW_TRIANGLES:
+    for (u32 i = 2; i < num_verts; i += 3)
+      AddTriangle(&out, pr, index + i - 2, index + i - 1, index + i);
+    break;
+  case OpcodeDecoder::GX_DRAW_LINES:
+    for (u32 i = 1; i < num_verts; i += 2)
+      out.insert(out.end(), {u16(index + i - 1), u16(index + i)});
+    break;
+  case OpcodeDecoder::GX_DRAW_POINTS:
+    for (u32 i = 0; i < num_verts; i++)
+      out.push_back(u16(index + i));
+    break;
+  }
+  return out;
+}
+
+void CheckPrimitive(int primitive, bool pr)
+{
+  g_Config.backend_info.bSupportsPrimitiveRestart = pr;
+  IndexGenerator::Init();
+
+  std::vector<u16> buffer(65536 * 2);
+  for (u32 first : {0u, 1u, 5u, 37u})
+  {
+    for (u32 num_verts = 0; num_verts < 100; num_verts++)
+    {
+      IndexGenerator::Start(buffer.data());
+      IndexGenerator::AddIndices(primitive, first);
+      const u32 start = IndexGenerator::GetIndexLen();
+      IndexGenerator::AddIndices(primitive, num_verts);
+      const u32 length = IndexGenerator::GetIndexLen() - start;
+
+      const std::vector<u16> expected = ReferenceIndices(primitive, pr, num_verts, first);
+      ASSERT_EQ(expected.size(), length) << num_verts << " vertices after " << first;
+      EXPECT_TRUE(std::equal(expected.begin(), expected.end(), buffer.begin() + start))
+          << num_verts << " vertices after " << first;
+    }
+  }
+}
+}  // namespace
+
+TEST(IndexGenerator, Quads)
+{
+  CheckPrimitive(OpcodeDecoder::GX_DRAW_QUADS, false);
+  CheckPrimitive(OpcodeDecoder::GX_DRAW_QUADS, true);
+}
+
+TEST(IndexGenerator, Triangles)
+{
+  CheckPrimitive(OpcodeDecoder::GX_DRAW_TRIANGLES, false);
+  CheckPrimitive(OpcodeDecoder::GX_DRAW_TRIANGLES, true);
+}
+
+TEST(IndexGenerator, LinesAndPoints)
+{
+  CheckPrimitive(OpcodeDecoder::GX_DRAW_LINES, false);
+  CheckPrimitive(OpcodeDecoder::GX_DRAW_POINTS, false);
+}
@@ -63,6 +63,7 @@ protected:
     m_loader = VertexLoaderBase::CreateVertexLoader(m_vtx_desc, m_vtx_attr);
     ASSERT_EQ((int)input_size, m_loader->m_VertexSize);
     ASSERT_EQ((int)output_size, m_loader->m_native_vtx_decl.stride);
+    ASSERT_EQ((u32)input_size, VertexLoaderBase::GetVertexSize(m_vtx_desc, m_vtx_attr));
   }
 
   template <typename T>
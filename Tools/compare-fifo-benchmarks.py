@@ -0,0 +1,89 @@
+#! /usr/bin/env python
+
+"""
+compare-fifo-benchmarks.py <baseline.csv> <candidate.csv> [--frames]
+
+Compares two sets of FIFO player benchmark results, as written by
+dolphin-emu-nogui --fifo_benchmark. Each frame's time is the median over all
+of the measured loops, which filters out most of the noise of a single run.
+
+Prints the change in total and per-frame time and, with --frames, the frames
+whose time changed the most. Also warns if the draw call counts differ, since
+that means the two runs didn't do the same work.
+"""
+
+from __future__ import print_function
+
+import csv
+import sys
+
+
+def median(values):
+    values = sorted(values)
+    middle = len(values) // 2
+    if len(values) % 2:
+        return values[middle]
+    return (values[middle - 1] + values[middle]) / 2.0
+
+
+def percentile(values, fraction):
+    values = sorted(values)
+    return values[min(len(values) - 1, int(len(values) * fraction))]
+
+
+def load(path):
+    '''Returns {frame: (median frame time in us, draw calls)}.'''
+    times = {}
+    draw_calls = {}
+    with open(path) as f:
+        for row in csv.DictReader(f):
+            frame = int(row['frame'])
+            times.setdefault(frame, []).append(int(row['frame_time_us']))
+            draw_calls[frame] = int(row['draw_calls'])
+    return {frame: (median(t), draw_calls[frame]) for frame, t in times.items()}
+
+
+def describe(name, baseline, candidate):
+    change = (candidate - baseline) * 100.0 / baseline if baseline else 0.0
+    print('%-24s %12.1f %12.1f %+8.2f%%' % (name, baseline, candidate, change))
+
+
+def main():
+    args = [a for a in sys.argv[1:] if not a.startswith('--')]
+    if len(args) != 2:
+        print(__doc__.strip(), file=sys.stderr)
+        return 1
+
+    baseline = load(args[0])
+    candidate = load(args[1])
+    frames = sorted(set(baseline) & set(candidate))
+    if not frames:
+        print('The results have no frames in common', file=sys.stderr)
+        return 1
+
+    mismatched = [f for f in frames if baseline[f][1] != candidate[f][1]]
+    if mismatched:
+        print('Warning: %d frames have different draw call counts, first: %d'
+              % (len(mismatched), mismatched[0]), file=sys.stderr)
+
+    base_times = [baseline[f][0] for f in frames]
+    cand_times = [candidate[f][0] for f in frames]
+    print('%-24s %12s %12s %9s' % ('', 'Baseline', 'Candidate', 'Change'))
+    describe('Total time (us)', sum(base_times), sum(cand_times))
+    describe('Median frame (us)', median(base_times), median(cand_times))
+    describe('95th percentile (us)', percentile(base_times, 0.95),
+             percentile(cand_times, 0.95))
+    describe('Worst frame (us)', max(base_times), max(cand_times))
+
+    if '--frames' in sys.argv:
+        print()
+        print('Frames with the largest changes:')
+        by_change = sorted(frames, key=lambda f: abs(candidate[f][0] - baseline[f][0]),
+                           reverse=True)
+        for f in by_change[:20]:
+            describe('Frame %d' % f, baseline[f][0], candidate[f][0])
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())